@@ -0,0 +1,630 @@
+#ifndef MYTINYSTL_ALGO_H_
+#define MYTINYSTL_ALGO_H_
+
+// 这个头文件包含了 mystl 的一系列算法
+// 包括 for_each, find, transform, 二分查找族, sort, stable_sort 等
+
+#include <cstddef>
+
+#include "algobase.h"
+#include "heap_algo.h"
+#include "memory.h"
+#include "iterator.h"
+
+namespace mystl
+{
+
+// for_each
+// 使用一个函数对象 f 对[first, last)区间内的每个元素执行一个 operator() 操作，但不能改变元素内容
+// f() 可返回一个值，但该值会被忽略
+template <class InputIter, class Function>
+MYSTL_CONSTEXPR20 Function for_each(InputIter first, InputIter last, Function f)
+{
+	for (; first != last; ++first)
+		f(*first);
+	return f;
+}
+
+// find
+// 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
+template <class InputIter, class T>
+MYSTL_CONSTEXPR20 InputIter find(InputIter first, InputIter last, const T& value)
+{
+	while (first != last && *first != value)
+		++first;
+	return first;
+}
+
+// find_if
+// 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
+template <class InputIter, class UnaryPredicate>
+MYSTL_CONSTEXPR20 InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred)
+{
+	while (first != last && !unary_pred(*first))
+		++first;
+	return first;
+}
+
+// find_if_not
+// 在[first, last)区间内找到第一个令一元操作 unary_pred 为 false 的元素并返回指向该元素的迭代器
+template <class InputIter, class UnaryPredicate>
+MYSTL_CONSTEXPR20 InputIter find_if_not(InputIter first, InputIter last, UnaryPredicate unary_pred)
+{
+	while (first != last && unary_pred(*first))
+		++first;
+	return first;
+}
+
+// transform
+// 第一个版本以函数对象 unary_op 作用于[first, last)中的每个元素并将结果保存至 result 中
+// 第二个版本以函数对象 binary_op 作用于两个序列[first1, last1)、[first2, last2)的相同位置
+template <class InputIter, class OutputIter, class UnaryOperation>
+MYSTL_CONSTEXPR20 OutputIter transform(InputIter first, InputIter last, OutputIter result, UnaryOperation unary_op)
+{
+	for (; first != last; ++first, ++result)
+		*result = unary_op(*first);
+	return result;
+}
+
+template <class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+MYSTL_CONSTEXPR20 OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                       OutputIter result, BinaryOperation binary_op)
+{
+	for (; first1 != last1; ++first1, ++first2, ++result)
+		*result = binary_op(*first1, *first2);
+	return result;
+}
+
+/*****************************************************************************************/
+// 二分查找族: lower_bound / upper_bound / equal_range / binary_search
+// 前向迭代器使用经典的二分查找
+// 随机访问迭代器使用无分支版本: 每轮只根据比较结果选择保留哪一半(编译为 cmov), 循环次数只取决于区间长度,
+// 消除了分支预测失败; 对连续迭代器还会预取下一轮可能访问的两个中点, 隐藏大表上的内存延迟
+/*****************************************************************************************/
+
+// 预取 it 所指的缓存行, 只对连续迭代器(原生指针或能解包为原生指针的迭代器)生效
+template <class T>
+MYSTL_CONSTEXPR20 void search_prefetch_address(T* ptr) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	if (!mystl::is_constant_evaluated())
+		__builtin_prefetch(static_cast<const void*>(ptr));
+#else
+	(void)ptr;
+#endif
+}
+
+template <class Iter>
+MYSTL_CONSTEXPR20 void search_prefetch_dispatch(Iter, m_false_type) noexcept
+{
+}
+
+template <class Iter>
+MYSTL_CONSTEXPR20 void search_prefetch_dispatch(Iter it, m_true_type) noexcept
+{
+	mystl::search_prefetch_address(mystl::unwrap_iter(it));
+}
+
+template <class Iter>
+MYSTL_CONSTEXPR20 void search_prefetch(Iter it) noexcept
+{
+	mystl::search_prefetch_dispatch(it, m_bool_constant<is_contiguous_iterator<Iter>::value>());
+}
+
+// lower_bound
+// 在[first, last)中查找第一个不小于 value 的元素，并返回指向它的迭代器，若没有则返回 last
+
+// lbound_dispatch 的 forward_iterator_tag 版本
+template <class ForwardIter, class T, class Compared>
+MYSTL_CONSTEXPR20 ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last, const T& value, Compared comp,
+                                              forward_iterator_tag)
+{
+	auto len = mystl::distance(first, last);
+	while (len > 0)
+	{
+		auto half = len >> 1;
+		auto middle = first;
+		mystl::advance(middle, half);
+		if (comp(*middle, value))
+		{
+			first = middle;
+			++first;
+			len = len - half - 1;
+		}
+		else
+		{
+			len = half;
+		}
+	}
+	return first;
+}
+
+// lbound_dispatch 的 random_access_iterator_tag 版本, 无分支
+// 不变式: 结果位于 [first, first + len] 内
+template <class RandomIter, class T, class Compared>
+MYSTL_CONSTEXPR20 RandomIter lbound_dispatch(RandomIter first, RandomIter last, const T& value, Compared comp,
+                                             random_access_iterator_tag)
+{
+	auto len = last - first;
+	if (len == 0)
+		return first;
+	while (len > 1)
+	{
+		const auto half = len >> 1;
+		const auto next_half = (len - half) >> 1;
+		mystl::search_prefetch(first + next_half);
+		mystl::search_prefetch(first + (half + next_half));
+		first += comp(first[half], value) ? half : 0;
+		len -= half;
+	}
+	return first + (comp(*first, value) ? 1 : 0);
+}
+
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value)
+{
+	return mystl::lbound_dispatch(first, last, value,
+	                              [](const typename iterator_traits<ForwardIter>::value_type& lhs,
+	                                 const T& rhs) { return lhs < rhs; },
+	                              iterator_category(first));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ForwardIter, class T, class Compared>
+MYSTL_CONSTEXPR20 ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp)
+{
+	return mystl::lbound_dispatch(first, last, value, comp, iterator_category(first));
+}
+
+// upper_bound
+// 在[first, last)中查找第一个大于 value 的元素，并返回指向它的迭代器，若没有则返回 last
+
+// ubound_dispatch 的 forward_iterator_tag 版本
+template <class ForwardIter, class T, class Compared>
+MYSTL_CONSTEXPR20 ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last, const T& value, Compared comp,
+                                              forward_iterator_tag)
+{
+	auto len = mystl::distance(first, last);
+	while (len > 0)
+	{
+		auto half = len >> 1;
+		auto middle = first;
+		mystl::advance(middle, half);
+		if (comp(value, *middle))
+		{
+			len = half;
+		}
+		else
+		{
+			first = middle;
+			++first;
+			len = len - half - 1;
+		}
+	}
+	return first;
+}
+
+// ubound_dispatch 的 random_access_iterator_tag 版本, 无分支
+template <class RandomIter, class T, class Compared>
+MYSTL_CONSTEXPR20 RandomIter ubound_dispatch(RandomIter first, RandomIter last, const T& value, Compared comp,
+                                             random_access_iterator_tag)
+{
+	auto len = last - first;
+	if (len == 0)
+		return first;
+	while (len > 1)
+	{
+		const auto half = len >> 1;
+		const auto next_half = (len - half) >> 1;
+		mystl::search_prefetch(first + next_half);
+		mystl::search_prefetch(first + (half + next_half));
+		first += comp(value, first[half]) ? 0 : half;
+		len -= half;
+	}
+	return first + (comp(value, *first) ? 0 : 1);
+}
+
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value)
+{
+	return mystl::ubound_dispatch(first, last, value,
+	                              [](const T& lhs,
+	                                 const typename iterator_traits<ForwardIter>::value_type& rhs)
+	                              { return lhs < rhs; },
+	                              iterator_category(first));
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ForwardIter, class T, class Compared>
+MYSTL_CONSTEXPR20 ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp)
+{
+	return mystl::ubound_dispatch(first, last, value, comp, iterator_category(first));
+}
+
+// equal_range
+// 查找[first,last)区间中与 value 相等的元素所形成的区间，返回一对迭代器指向区间首尾
+// 先求 lower_bound, 再只在其后的部分求 upper_bound
+template <class ForwardIter, class T, class Compared>
+MYSTL_CONSTEXPR20 mystl::pair<ForwardIter, ForwardIter>
+equal_range(ForwardIter first, ForwardIter last, const T& value, Compared comp)
+{
+	auto lo = mystl::lower_bound(first, last, value, comp);
+	auto hi = mystl::upper_bound(lo, last, value, comp);
+	return mystl::pair<ForwardIter, ForwardIter>(lo, hi);
+}
+
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 mystl::pair<ForwardIter, ForwardIter>
+equal_range(ForwardIter first, ForwardIter last, const T& value)
+{
+	auto lo = mystl::lower_bound(first, last, value);
+	auto hi = mystl::upper_bound(lo, last, value);
+	return mystl::pair<ForwardIter, ForwardIter>(lo, hi);
+}
+
+// binary_search
+// 二分查找，如果在[first, last)内有等同于 value 的元素，返回 true，否则返回 false
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 bool binary_search(ForwardIter first, ForwardIter last, const T& value)
+{
+	auto i = mystl::lower_bound(first, last, value);
+	return i != last && !(value < *i);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ForwardIter, class T, class Compared>
+MYSTL_CONSTEXPR20 bool binary_search(ForwardIter first, ForwardIter last, const T& value, Compared comp)
+{
+	auto i = mystl::lower_bound(first, last, value, comp);
+	return i != last && !comp(value, *i);
+}
+
+// reverse
+// 将[first, last)区间内的元素反转
+template <class BidirectionalIter>
+MYSTL_CONSTEXPR20 void reverse(BidirectionalIter first, BidirectionalIter last)
+{
+	while (first != last && first != --last)
+	{
+		mystl::iter_swap(first, last);
+		++first;
+	}
+}
+
+// rotate
+// 将[first, middle)内的元素和 [middle, last)内的元素互换，可以交换两个长度不同的区间
+// 返回交换后 middle 的位置
+template <class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last)
+{
+	if (first == middle)
+		return last;
+	if (middle == last)
+		return first;
+	// 三次反转实现旋转，要求双向迭代器，这里用逐段交换以支持前向迭代器
+	ForwardIter next = middle;
+	ForwardIter result = last;
+	bool result_set = false;
+	while (first != next)
+	{
+		mystl::iter_swap(first++, next++);
+		if (next == last)
+		{
+			if (!result_set)
+			{
+				result = first;
+				result_set = true;
+			}
+			next = middle;
+		}
+		else if (first == middle)
+		{
+			middle = next;
+		}
+	}
+	return result;
+}
+
+/*****************************************************************************************/
+// sort
+// 将[first, last)内的元素以递增的方式排序
+// 采用内省式排序(introsort)：快速排序为主，递归过深时转为堆排序，小区间最后统一做插入排序
+/*****************************************************************************************/
+
+constexpr static size_t kSmallSectionSize = 16;  // 小型区间的大小，在这个大小内采用插入排序
+
+// 用于控制分割恶化的情况, 求 lg(n)
+template <class Size>
+MYSTL_CONSTEXPR20 Size slg2(Size n)
+{
+	Size k = 0;
+	for (; n > 1; n >>= 1)
+		++k;
+	return k;
+}
+
+// 三点中值, 返回三个值中大小居中的那一个
+template <class T, class Compared>
+MYSTL_CONSTEXPR20 const T& median(const T& left, const T& mid, const T& right, Compared comp)
+{
+	if (comp(left, mid))
+	{
+		if (comp(mid, right))
+			return mid;
+		else if (comp(left, right))
+			return right;
+		else
+			return left;
+	}
+	else if (comp(left, right))
+	{
+		return left;
+	}
+	else if (comp(mid, right))
+	{
+		return right;
+	}
+	return mid;
+}
+
+// 分割函数 unchecked_partition
+// pivot 为值的拷贝, 两端迭代器相向而行, 不做越界检查(三点中值保证了哨兵的存在)
+template <class RandomIter, class T, class Compared>
+MYSTL_CONSTEXPR20 RandomIter unchecked_partition(RandomIter first, RandomIter last, const T& pivot, Compared comp)
+{
+	while (true)
+	{
+		while (comp(*first, pivot))
+			++first;
+		--last;
+		while (comp(pivot, *last))
+			--last;
+		if (!(first < last))
+			return first;
+		mystl::iter_swap(first, last);
+		++first;
+	}
+}
+
+// 内省式排序，先进行 introsort，当分割行为有恶化倾向时，改用 heap sort
+// 区间小于 kSmallSectionSize 时直接返回，留给最后的插入排序
+template <class RandomIter, class Size, class Compared>
+MYSTL_CONSTEXPR20 void intro_sort(RandomIter first, RandomIter last, Size depth_limit, Compared comp)
+{
+	while (static_cast<size_t>(last - first) > kSmallSectionSize)
+	{
+		if (depth_limit == 0)
+		{
+			// 到达最大分割深度限制
+			mystl::make_heap(first, last, comp);
+			mystl::sort_heap(first, last, comp);
+			return;
+		}
+		--depth_limit;
+		auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1), comp);
+		auto cut = mystl::unchecked_partition(first, last, mid, comp);
+		mystl::intro_sort(cut, last, depth_limit, comp);
+		last = cut;
+	}
+}
+
+// 插入排序辅助函数 unchecked_linear_insert
+// 左侧一定存在不大于 value 的元素, 因此无需检查边界
+template <class RandomIter, class T, class Compared>
+MYSTL_CONSTEXPR20 void unchecked_linear_insert(RandomIter last, T value, Compared comp)
+{
+	auto next = last;
+	--next;
+	while (comp(value, *next))
+	{
+		*last = mystl::move(*next);
+		last = next;
+		--next;
+	}
+	*last = mystl::move(value);
+}
+
+// 插入排序函数 unchecked_insertion_sort
+template <class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void unchecked_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+{
+	for (auto i = first; i != last; ++i)
+	{
+		mystl::unchecked_linear_insert(i, mystl::move(*i), comp);
+	}
+}
+
+// 插入排序函数 insertion_sort
+template <class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void insertion_sort(RandomIter first, RandomIter last, Compared comp)
+{
+	if (first == last)
+		return;
+	for (auto i = first + 1; i != last; ++i)
+	{
+		auto value = mystl::move(*i);
+		if (comp(value, *first))
+		{
+			mystl::move_backward(first, i, i + 1);
+			*first = mystl::move(value);
+		}
+		else
+		{
+			mystl::unchecked_linear_insert(i, mystl::move(value), comp);
+		}
+	}
+}
+
+// 最终插入排序函数 final_insertion_sort
+// 前 kSmallSectionSize 个元素做带边界检查的插入排序, 其余部分已保证左侧有哨兵
+template <class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void final_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+{
+	if (static_cast<size_t>(last - first) > kSmallSectionSize)
+	{
+		mystl::insertion_sort(first, first + kSmallSectionSize, comp);
+		mystl::unchecked_insertion_sort(first + kSmallSectionSize, last, comp);
+	}
+	else
+	{
+		mystl::insertion_sort(first, last, comp);
+	}
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void sort(RandomIter first, RandomIter last, Compared comp)
+{
+	if (first != last)
+	{
+		// 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
+		mystl::intro_sort(first, last, slg2(last - first) * 2, comp);
+		mystl::final_insertion_sort(first, last, comp);
+	}
+}
+
+// 默认使用 operator< 比较
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void sort(RandomIter first, RandomIter last)
+{
+	using value_type = typename iterator_traits<RandomIter>::value_type;
+	mystl::sort(first, last, [](const value_type& lhs, const value_type& rhs) { return lhs < rhs; });
+}
+
+/*****************************************************************************************/
+// stable_sort
+// 稳定排序: 相等元素保持原有的相对次序
+// 能申请到缓冲区时做带缓冲区的归并排序, 否则退化为原地归并(借助 rotate)
+/*****************************************************************************************/
+
+// 借助缓冲区合并 [first, middle) 与 [middle, last)
+// 前半段被移动构造进缓冲区, 合并完成后析构缓冲区内的对象
+template <class RandomIter, class T, class Compared>
+MYSTL_CONSTEXPR20 void merge_with_buffer(RandomIter first, RandomIter middle, RandomIter last,
+                                         T* buffer, Compared comp)
+{
+	T* buf_end = mystl::uninitialized_move(first, middle, buffer);
+	T* buf = buffer;
+	auto out = first;
+	while (buf != buf_end && middle != last)
+	{
+		// 只有后半段严格小于前半段时才取后半段, 以保证稳定
+		if (comp(*middle, *buf))
+		{
+			*out = mystl::move(*middle);
+			++middle;
+		}
+		else
+		{
+			*out = mystl::move(*buf);
+			++buf;
+		}
+		++out;
+	}
+	mystl::move(buf, buf_end, out);
+	mystl::destroy(buffer, buf_end);
+}
+
+// 没有缓冲区时的原地合并, 时间复杂度 O(n log n)
+template <class BidirectionalIter, class Distance, class Compared>
+MYSTL_CONSTEXPR20 void merge_without_buffer(BidirectionalIter first, BidirectionalIter middle,
+                                            BidirectionalIter last, Distance len1, Distance len2,
+                                            Compared comp)
+{
+	if (len1 == 0 || len2 == 0)
+		return;
+	if (len1 + len2 == 2)
+	{
+		if (comp(*middle, *first))
+			mystl::iter_swap(middle, first);
+		return;
+	}
+	auto first_cut = first;
+	auto second_cut = middle;
+	Distance len11 = 0;
+	Distance len22 = 0;
+	if (len1 > len2)
+	{
+		len11 = len1 >> 1;
+		mystl::advance(first_cut, len11);
+		second_cut = mystl::lower_bound(middle, last, *first_cut, comp);
+		len22 = mystl::distance(middle, second_cut);
+	}
+	else
+	{
+		len22 = len2 >> 1;
+		mystl::advance(second_cut, len22);
+		first_cut = mystl::upper_bound(first, middle, *second_cut, comp);
+		len11 = mystl::distance(first, first_cut);
+	}
+	auto new_middle = mystl::rotate(first_cut, middle, second_cut);
+	mystl::merge_without_buffer(first, first_cut, new_middle, len11, len22, comp);
+	mystl::merge_without_buffer(new_middle, second_cut, last, len1 - len11, len2 - len22, comp);
+}
+
+// 带缓冲区的归并排序, 小区间先用插入排序
+template <class RandomIter, class T, class Compared>
+MYSTL_CONSTEXPR20 void merge_sort_with_buffer(RandomIter first, RandomIter last, T* buffer, Compared comp)
+{
+	if (static_cast<size_t>(last - first) <= kSmallSectionSize)
+	{
+		mystl::insertion_sort(first, last, comp);
+		return;
+	}
+	auto middle = first + (last - first) / 2;
+	mystl::merge_sort_with_buffer(first, middle, buffer, comp);
+	mystl::merge_sort_with_buffer(middle, last, buffer, comp);
+	// 两段本身已经有序时无需合并
+	if (comp(*middle, *(middle - 1)))
+		mystl::merge_with_buffer(first, middle, last, buffer, comp);
+}
+
+// 无缓冲区的归并排序
+template <class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void merge_sort_without_buffer(RandomIter first, RandomIter last, Compared comp)
+{
+	if (static_cast<size_t>(last - first) <= kSmallSectionSize)
+	{
+		mystl::insertion_sort(first, last, comp);
+		return;
+	}
+	auto middle = first + (last - first) / 2;
+	mystl::merge_sort_without_buffer(first, middle, comp);
+	mystl::merge_sort_without_buffer(middle, last, comp);
+	mystl::merge_without_buffer(first, middle, last, middle - first, last - middle, comp);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void stable_sort(RandomIter first, RandomIter last, Compared comp)
+{
+	using value_type = typename iterator_traits<RandomIter>::value_type;
+	const auto len = last - first;
+	if (len < 2)
+		return;
+	// 常量求值中不能申请临时缓冲区, 使用不需要缓冲区的版本
+	if (mystl::is_constant_evaluated())
+	{
+		mystl::merge_sort_without_buffer(first, last, comp);
+		return;
+	}
+	// 合并时只有前半段进入缓冲区, 所以一半长度就足够
+	auto buf = mystl::get_temporary_buffer<value_type>((len + 1) / 2);
+	if (buf.first != nullptr && buf.second >= (len + 1) / 2)
+		mystl::merge_sort_with_buffer(first, last, buf.first, comp);
+	else
+		mystl::merge_sort_without_buffer(first, last, comp);
+	mystl::release_temporary_buffer(buf.first);
+}
+
+// 默认使用 operator< 比较
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void stable_sort(RandomIter first, RandomIter last)
+{
+	using value_type = typename iterator_traits<RandomIter>::value_type;
+	mystl::stable_sort(first, last,
+	                   [](const value_type& lhs, const value_type& rhs) { return lhs < rhs; });
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_ALGO_H_
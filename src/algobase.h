@@ -3,6 +3,14 @@
 
 // 这个头文件包含了 mystl 的基本算法
 
+// notes:
+//
+// copy, copy_backward, move, move_backward, fill, fill_n 先用 unwrap_iter 解包迭代器(见 iterator.h),
+// 所以类类型的连续迭代器、reverse_iterator<reverse_iterator<T*>> 等也能命中原生指针上的 memmove / memset 版本
+// 两端都是 reverse_iterator 时, 正向复制等价于对底层迭代器反向复制, 转交给另一个方向的版本
+// 从一对 move_iterator 复制时转交给底层迭代器上的 move / move_backward
+// C++20 起这些算法是 constexpr 的, 常量求值时(is_constant_evaluated)不走 mem* 版本, 改为逐个赋值
+
 #include <cstring>
 
 #include "iterator.h"
@@ -29,35 +37,35 @@ namespace mystl
 
 // 取二者中的较大值，语义相等时保证返回第一个参数
 template <class T>
-const T& max(const T& lhs, const T& rhs)
+MYSTL_CONSTEXPR20 const T& max(const T& lhs, const T& rhs)
 {
 	return lhs < rhs ? rhs : lhs;
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class T, class Compare>
-const T& max(const T& lhs, const T& rhs, Compare comp)
+MYSTL_CONSTEXPR20 const T& max(const T& lhs, const T& rhs, Compare comp)
 {
 	return comp(lhs, rhs) ? rhs : lhs;
 }
 
 // 取二者中的较小值, 语义相等时保证返回第一个参数
 template <class T>
-const T& min(const T& lhs, const T& rhs)
+MYSTL_CONSTEXPR20 const T& min(const T& lhs, const T& rhs)
 {
 	return rhs < lhs ? rhs : lhs;
 }
 
 // 重载版本使用函数对象 comp 代替比较操作, 用以支持自定义的比较操作
 template <class T, class Compare>
-const T& min(const T& lhs, const T& rhs, Compare comp)
+MYSTL_CONSTEXPR20 const T& min(const T& lhs, const T& rhs, Compare comp)
 {
 	return comp(rhs, lhs) ? rhs : lhs;
 }
 
 // iter_swap 将两个迭代器所指对象对调
 template <class FIter1, class FIter2>
-void iter_swap(FIter1 lhs, FIter2 rhs)
+MYSTL_CONSTEXPR20 void iter_swap(FIter1 lhs, FIter2 rhs)
 {
 	mystl::swap(*lhs, *rhs);
 }
@@ -66,8 +74,8 @@ void iter_swap(FIter1 lhs, FIter2 rhs)
 
 // input_iterator_tag 版本, 中间层辅助函数
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result,
-                              mystl::input_iterator_tag)
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result,
+                                                mystl::input_iterator_tag)
 {
 	for (; first != last; ++first, ++result)
 		*result = *first;
@@ -76,8 +84,8 @@ OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result
 
 // ramdom_access_iterator_tag 版本, 中间层辅助函数
 template <class RandomIter, class OutputIter>
-OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter result,
-                              mystl::random_access_iterator_tag)
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter result,
+                                                mystl::random_access_iterator_tag)
 {
 	for (auto n = last - first; n > 0; --n, ++first, ++result)
 		*result = *first;
@@ -86,12 +94,469 @@ OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter resu
 
 // 萃取迭代器特性后进行拷贝
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result)
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result)
 {
 	return unchecked_copy_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
+// 源与目标都是原生指针且元素类型相同(忽略 const)时,直接 memmove 整块内存
+template <class Tp, class Up>
+MYSTL_CONSTEXPR20 typename std::enable_if<
+	std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+	std::is_trivially_copy_assignable<Up>::value,
+	Up*>::type
+unchecked_copy(Tp* first, Tp* last, Up* result)
+{
+	// 常量求值中不能使用 memmove, 退回逐个赋值的版本
+	if (mystl::is_constant_evaluated())
+		return unchecked_copy_cat(first, last, result, mystl::random_access_iterator_tag());
+	const auto n = static_cast<size_t>(last - first);
+	if (n != 0)
+		std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(Up));
+	return result + n;
+}
+
+template <class InputIter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter copy(InputIter first, InputIter last, OutputIter result)
+{
+	return mystl::rewrap_iter(result, unchecked_copy(mystl::unwrap_iter(first), mystl::unwrap_iter(last),
+	                                                 mystl::unwrap_iter(result)));
+}
+
+// copy_backward
+// 将 [first, last)区间内的元素拷贝到 [result - (last - first), result)内
+
+// bidirectional_iterator_tag 版本
+template <class BidirectionalIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,
+                                                                 BidirectionalIter2 result,
+                                                                 mystl::bidirectional_iterator_tag)
+{
+	while (first != last)
+		*--result = *--last;
+	return result;
+}
+
+// random_access_iterator_tag 版本
+template <class RandomIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward_cat(RandomIter1 first, RandomIter1 last,
+                                                                 BidirectionalIter2 result,
+                                                                 mystl::random_access_iterator_tag)
+{
+	for (auto n = last - first; n > 0; --n)
+		*--result = *--last;
+	return result;
+}
+
+template <class BidirectionalIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                                                             BidirectionalIter2 result)
+{
+	return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
+}
+
+// 为 trivially_copy_assignable 类型提供特化版本
+template <class Tp, class Up>
+MYSTL_CONSTEXPR20 typename std::enable_if<
+	std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+	std::is_trivially_copy_assignable<Up>::value,
+	Up*>::type
+unchecked_copy_backward(Tp* first, Tp* last, Up* result)
+{
+	if (mystl::is_constant_evaluated())
+		return unchecked_copy_backward_cat(first, last, result, mystl::random_access_iterator_tag());
+	const auto n = static_cast<size_t>(last - first);
+	if (n != 0)
+	{
+		result -= n;
+		std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(Up));
+	}
+	return result;
+}
+
+template <class BidirectionalIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 copy_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                                                   BidirectionalIter2 result)
+{
+	return mystl::rewrap_iter(result, unchecked_copy_backward(mystl::unwrap_iter(first), mystl::unwrap_iter(last),
+	                                                          mystl::unwrap_iter(result)));
+}
+
+// copy_if
+// 把[first, last)内满足一元操作 unary_pred 的元素拷贝到以 result 为起始的位置上
+template <class InputIter, class OutputIter, class UnaryPredicate>
+MYSTL_CONSTEXPR20 OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred)
+{
+	for (; first != last; ++first)
+	{
+		if (unary_pred(*first))
+			*result++ = *first;
+	}
+	return result;
+}
+
+// copy_n
+// 把 [first, first + n)区间上的元素拷贝到 [result, result + n)上
+// 返回一个 pair 分别指向拷贝结束的尾部
+template <class InputIter, class Size, class OutputIter>
+MYSTL_CONSTEXPR20 mystl::pair<InputIter, OutputIter>
+unchecked_copy_n(InputIter first, Size n, OutputIter result, mystl::input_iterator_tag)
+{
+	for (; n > 0; --n, ++first, ++result)
+		*result = *first;
+	return mystl::pair<InputIter, OutputIter>(first, result);
+}
+
+// 随机访问迭代器可以直接算出尾部,转交给 copy 以便命中 memmove 版本
+template <class RandomIter, class Size, class OutputIter>
+MYSTL_CONSTEXPR20 mystl::pair<RandomIter, OutputIter>
+unchecked_copy_n(RandomIter first, Size n, OutputIter result, mystl::random_access_iterator_tag)
+{
+	auto last = first + n;
+	return mystl::pair<RandomIter, OutputIter>(last, mystl::copy(first, last, result));
+}
+
+template <class InputIter, class Size, class OutputIter>
+MYSTL_CONSTEXPR20 mystl::pair<InputIter, OutputIter>
+copy_n(InputIter first, Size n, OutputIter result)
+{
+	return unchecked_copy_n(first, n, result, iterator_category(first));
+}
+
+// move
+// 把 [first, last)区间内的元素移动到 [result, result + (last - first))内
+
+// input_iterator_tag 版本
+template <class InputIter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result,
+                                                mystl::input_iterator_tag)
+{
+	for (; first != last; ++first, ++result)
+		*result = mystl::move(*first);
+	return result;
+}
+
+// ramdom_access_iterator_tag 版本
+template <class RandomIter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter result,
+                                                mystl::random_access_iterator_tag)
+{
+	for (auto n = last - first; n > 0; --n, ++first, ++result)
+		*result = mystl::move(*first);
+	return result;
+}
+
+template <class InputIter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result)
+{
+	return unchecked_move_cat(first, last, result, iterator_category(first));
+}
+
+// 为 trivially_copy_assignable 类型提供特化版本
+template <class Tp, class Up>
+MYSTL_CONSTEXPR20 typename std::enable_if<
+	std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+	std::is_trivially_move_assignable<Up>::value,
+	Up*>::type
+unchecked_move(Tp* first, Tp* last, Up* result)
+{
+	if (mystl::is_constant_evaluated())
+		return unchecked_move_cat(first, last, result, mystl::random_access_iterator_tag());
+	const size_t n = static_cast<size_t>(last - first);
+	if (n != 0)
+		std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(Up));
+	return result + n;
+}
+
+template <class InputIter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter move(InputIter first, InputIter last, OutputIter result)
+{
+	return mystl::rewrap_iter(result, unchecked_move(mystl::unwrap_iter(first), mystl::unwrap_iter(last),
+	                                                 mystl::unwrap_iter(result)));
+}
+
+// move_backward
+// 将 [first, last)区间内的元素移动到 [result - (last - first), result)内
+
+// bidirectional_iterator_tag 版本
+template <class BidirectionalIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,
+                                                                 BidirectionalIter2 result,
+                                                                 mystl::bidirectional_iterator_tag)
+{
+	while (first != last)
+		*--result = mystl::move(*--last);
+	return result;
+}
+
+// random_access_iterator_tag 版本
+template <class RandomIter1, class RandomIter2>
+MYSTL_CONSTEXPR20 RandomIter2 unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last,
+                                                          RandomIter2 result, mystl::random_access_iterator_tag)
+{
+	for (auto n = last - first; n > 0; --n)
+		*--result = mystl::move(*--last);
+	return result;
+}
+
+template <class BidirectionalIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                                                             BidirectionalIter2 result)
+{
+	return unchecked_move_backward_cat(first, last, result, iterator_category(first));
+}
+
+// 为 trivially_copy_assignable 类型提供特化版本
+template <class Tp, class Up>
+MYSTL_CONSTEXPR20 typename std::enable_if<
+	std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+	std::is_trivially_move_assignable<Up>::value,
+	Up*>::type
+unchecked_move_backward(Tp* first, Tp* last, Up* result)
+{
+	if (mystl::is_constant_evaluated())
+		return unchecked_move_backward_cat(first, last, result, mystl::random_access_iterator_tag());
+	const size_t n = static_cast<size_t>(last - first);
+	if (n != 0)
+	{
+		result -= n;
+		std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(Up));
+	}
+	return result;
+}
+
+template <class BidirectionalIter1, class BidirectionalIter2>
+MYSTL_CONSTEXPR20 BidirectionalIter2 move_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                                                   BidirectionalIter2 result)
+{
+	return mystl::rewrap_iter(result, unchecked_move_backward(mystl::unwrap_iter(first), mystl::unwrap_iter(last),
+	                                                          mystl::unwrap_iter(result)));
+}
+
+// 两端都是反向迭代器时, 转交给底层迭代器上另一个方向的版本
+template <class Iter1, class Iter2>
+MYSTL_CONSTEXPR20 mystl::reverse_iterator<Iter2>
+unchecked_copy(mystl::reverse_iterator<Iter1> first, mystl::reverse_iterator<Iter1> last,
+               mystl::reverse_iterator<Iter2> result)
+{
+	return mystl::reverse_iterator<Iter2>(mystl::copy_backward(last.base(), first.base(), result.base()));
+}
+
+template <class Iter1, class Iter2>
+MYSTL_CONSTEXPR20 mystl::reverse_iterator<Iter2>
+unchecked_copy_backward(mystl::reverse_iterator<Iter1> first, mystl::reverse_iterator<Iter1> last,
+                        mystl::reverse_iterator<Iter2> result)
+{
+	return mystl::reverse_iterator<Iter2>(mystl::copy(last.base(), first.base(), result.base()));
+}
+
+template <class Iter1, class Iter2>
+MYSTL_CONSTEXPR20 mystl::reverse_iterator<Iter2>
+unchecked_move(mystl::reverse_iterator<Iter1> first, mystl::reverse_iterator<Iter1> last,
+               mystl::reverse_iterator<Iter2> result)
+{
+	return mystl::reverse_iterator<Iter2>(mystl::move_backward(last.base(), first.base(), result.base()));
+}
+
+template <class Iter1, class Iter2>
+MYSTL_CONSTEXPR20 mystl::reverse_iterator<Iter2>
+unchecked_move_backward(mystl::reverse_iterator<Iter1> first, mystl::reverse_iterator<Iter1> last,
+                        mystl::reverse_iterator<Iter2> result)
+{
+	return mystl::reverse_iterator<Iter2>(mystl::move(last.base(), first.base(), result.base()));
+}
+
+// 从 move_iterator 复制即为从底层迭代器移动
+template <class Iter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy(mystl::move_iterator<Iter> first, mystl::move_iterator<Iter> last,
+                                            OutputIter result)
+{
+	return mystl::move(first.base(), last.base(), result);
+}
+
+template <class Iter, class OutputIter>
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy_backward(mystl::move_iterator<Iter> first, mystl::move_iterator<Iter> last,
+                                                     OutputIter result)
+{
+	return mystl::move_backward(first.base(), last.base(), result);
+}
+
+// equal
+// 比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
+template <class InputIter1, class InputIter2>
+MYSTL_CONSTEXPR20 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+{
+	for (; first1 != last1; ++first1, ++first2)
+	{
+		if (*first1 != *first2)
+			return false;
+	}
+	return true;
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class InputIter1, class InputIter2, class Compared>
+MYSTL_CONSTEXPR20 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp)
+{
+	for (; first1 != last1; ++first1, ++first2)
+	{
+		if (!comp(*first1, *first2))
+			return false;
+	}
+	return true;
+}
+
+// fill_n
+// 从 first 位置开始填充 n 个值
+template <class OutputIter, class Size, class T>
+MYSTL_CONSTEXPR20 OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value)
+{
+	for (; n > 0; --n, ++first)
+		*first = value;
+	return first;
+}
+
+// 为 one-byte 类型提供特化版本,直接 memset
+template <class Tp, class Size, class Up>
+MYSTL_CONSTEXPR20 typename std::enable_if<
+	std::is_integral<Tp>::value && sizeof(Tp) == 1 &&
+	!std::is_same<Tp, bool>::value &&
+	std::is_integral<Up>::value && sizeof(Up) == 1,
+	Tp*>::type
+unchecked_fill_n(Tp* first, Size n, Up value)
+{
+	if (mystl::is_constant_evaluated())
+	{
+		for (; n > 0; --n, ++first)
+			*first = static_cast<Tp>(value);
+		return first;
+	}
+	if (n > 0)
+		std::memset(first, (unsigned char)value, (size_t)(n));
+	return first + n;
+}
+
+template <class OutputIter, class Size, class T>
+MYSTL_CONSTEXPR20 OutputIter fill_n(OutputIter first, Size n, const T& value)
+{
+	return mystl::rewrap_iter(first, unchecked_fill_n(mystl::unwrap_iter(first), n, value));
+}
+
+// fill
+// 为 [first, last)区间内的所有元素填充新值
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 void fill_cat(ForwardIter first, ForwardIter last, const T& value,
+                                mystl::forward_iterator_tag)
+{
+	for (; first != last; ++first)
+		*first = value;
+}
+
+template <class RandomIter, class T>
+MYSTL_CONSTEXPR20 void fill_cat(RandomIter first, RandomIter last, const T& value,
+                                mystl::random_access_iterator_tag)
+{
+	mystl::fill_n(first, last - first, value);
+}
+
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 void unchecked_fill(ForwardIter first, ForwardIter last, const T& value)
+{
+	fill_cat(first, last, value, iterator_category(first));
+}
+
+template <class ForwardIter, class T>
+MYSTL_CONSTEXPR20 void fill(ForwardIter first, ForwardIter last, const T& value)
+{
+	unchecked_fill(mystl::unwrap_iter(first), mystl::unwrap_iter(last), value);
+}
+
+// 反向迭代器区间与底层迭代器区间包含相同的元素
+template <class Iter, class T>
+MYSTL_CONSTEXPR20 void unchecked_fill(mystl::reverse_iterator<Iter> first, mystl::reverse_iterator<Iter> last, const T& value)
+{
+	mystl::fill(last.base(), first.base(), value);
+}
+
+// lexicographical_compare
+// 以字典序排列对两个序列进行比较,第一序列小于第二序列时返回 true
+template <class InputIter1, class InputIter2>
+MYSTL_CONSTEXPR20 bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
+                                               InputIter2 first2, InputIter2 last2)
+{
+	for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+	{
+		if (*first1 < *first2)
+			return true;
+		if (*first2 < *first1)
+			return false;
+	}
+	return first1 == last1 && first2 != last2;
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class InputIter1, class InputIter2, class Compred>
+MYSTL_CONSTEXPR20 bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
+                                               InputIter2 first2, InputIter2 last2, Compred comp)
+{
+	for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+	{
+		if (comp(*first1, *first2))
+			return true;
+		if (comp(*first2, *first1))
+			return false;
+	}
+	return first1 == last1 && first2 != last2;
+}
+
+// 针对 const unsigned char* 的特化版本,交给 memcmp
+MYSTL_CONSTEXPR20 inline bool lexicographical_compare(const unsigned char* first1, const unsigned char* last1,
+                                                      const unsigned char* first2, const unsigned char* last2)
+{
+	const auto len1 = last1 - first1;
+	const auto len2 = last2 - first2;
+	if (mystl::is_constant_evaluated())
+	{
+		for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+		{
+			if (*first1 != *first2)
+				return *first1 < *first2;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+	// 先比较相同长度的部分
+	const auto result = std::memcmp(first1, first2, mystl::min(len1, len2));
+	// 若相等，长度较长的比较大
+	return result != 0 ? result < 0 : len1 < len2;
+}
+
+// mismatch
+// 平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
+template <class InputIter1, class InputIter2>
+MYSTL_CONSTEXPR20 mystl::pair<InputIter1, InputIter2>
+mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+{
+	while (first1 != last1 && *first1 == *first2)
+	{
+		++first1;
+		++first2;
+	}
+	return mystl::pair<InputIter1, InputIter2>(first1, first2);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class InputIter1, class InputIter2, class Compred>
+MYSTL_CONSTEXPR20 mystl::pair<InputIter1, InputIter2>
+mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp)
+{
+	while (first1 != last1 && comp(*first1, *first2))
+	{
+		++first1;
+		++first2;
+	}
+	return mystl::pair<InputIter1, InputIter2>(first1, first2);
+}
 
 } // namespace mystl
 #endif // !MYTINYSTL_ALGOBASE_H_
@@ -4,6 +4,7 @@
 // 这个头文件包含一个模板类 allocator，用于管理内存的分配、释放，对象的构造、析构
 
 #include <memory.h>
+#include <new>
 
 #include "construct.h"
 #include "util.h"
@@ -30,6 +31,8 @@ public:
 	static T* allocate();
 	// 分配一整片内存给多个对象
 	static T* allocate(size_type n);
+	// 分配失败时返回 nullptr 而不抛出异常, 供容器的 try_* 接口使用, 要求 n > 0
+	static T* try_allocate(size_type n) noexcept;
 
 	// 释放一块内存
 	static void deallocate(T* ptr);
@@ -68,6 +71,14 @@ T* allocator<T>::allocate(size_type n)
 	return static_cast<T*>(::operator new(n * sizeof(T)));
 }
 
+template <class T>
+T* allocator<T>::try_allocate(size_type n) noexcept
+{
+	if (n > static_cast<size_type>(-1) / sizeof(T))
+		return nullptr;
+	return static_cast<T*>(::operator new(n * sizeof(T), std::nothrow));
+}
+
 template <class T>
 void allocator<T>::deallocate(T* ptr)
 {
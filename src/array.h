@@ -0,0 +1,213 @@
+#ifndef MYTINYSTL_ARRAY_H_
+#define MYTINYSTL_ARRAY_H_
+
+// 这个头文件包含一个模板类 array
+// array : 固定大小的数组
+
+// notes:
+//
+// array 是聚合类型, 用花括号初始化: mystl::array<int, 3> a = {{ 1, 2, 3 }};
+// 只读的成员函数是 constexpr 的, 修改元素的成员函数从 C++14 起是 constexpr 的,
+// fill / swap / 比较运算符依赖 algobase.h 中的算法, 从 C++20 起是 constexpr 的
+// 所以可以在编译期用 mystl::sort 等算法生成一个 array, 作为放在只读数据段中的查找表
+// 异常保证：
+// 除 at() 越界时抛出 std::out_of_range 外, 其余函数不抛出异常(元素的赋值、交换抛出的异常照常传播)
+
+#include <cstddef>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "tuple.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 模板类: array
+// 模板参数 T 代表元素类型, N 代表元素个数
+template <class T, size_t N>
+struct array
+{
+	// array 的嵌套型别定义
+	typedef T                                        value_type;
+	typedef T*                                       pointer;
+	typedef const T*                                 const_pointer;
+	typedef T&                                       reference;
+	typedef const T&                                 const_reference;
+	typedef size_t                                   size_type;
+	typedef ptrdiff_t                                difference_type;
+
+	typedef value_type*                              iterator;
+	typedef const value_type*                        const_iterator;
+	typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+	// 为了保持聚合类型, 数据成员是公有的; N == 0 时仍保留一个元素, 但 size() 为 0
+	value_type elems_[N == 0 ? 1 : N];
+
+	// 迭代器相关操作
+	MYSTL_CONSTEXPR14 iterator     begin()         noexcept { return elems_; }
+	constexpr const_iterator       begin()   const noexcept { return elems_; }
+	MYSTL_CONSTEXPR14 iterator     end()           noexcept { return elems_ + N; }
+	constexpr const_iterator       end()     const noexcept { return elems_ + N; }
+
+	MYSTL_CONSTEXPR20 reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+	MYSTL_CONSTEXPR20 reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+	constexpr const_iterator                 cbegin()  const noexcept { return begin(); }
+	constexpr const_iterator                 cend()    const noexcept { return end(); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator crend()   const noexcept { return rend(); }
+
+	// 容量相关操作
+	constexpr bool      empty()    const noexcept { return N == 0; }
+	constexpr size_type size()     const noexcept { return N; }
+	constexpr size_type max_size() const noexcept { return N; }
+
+	// 访问元素相关操作
+	MYSTL_CONSTEXPR14 reference operator[](size_type n)
+	{
+		MYSTL_DEBUG(n < N);
+		return elems_[n];
+	}
+	constexpr const_reference operator[](size_type n) const
+	{
+		return elems_[n];
+	}
+	MYSTL_CONSTEXPR14 reference at(size_type n)
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < N), "array<T, N>::at() subscript out of range");
+		return elems_[n];
+	}
+	MYSTL_CONSTEXPR14 const_reference at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < N), "array<T, N>::at() subscript out of range");
+		return elems_[n];
+	}
+
+	MYSTL_CONSTEXPR14 reference front()
+	{
+		MYSTL_DEBUG(N != 0);
+		return elems_[0];
+	}
+	constexpr const_reference front() const
+	{
+		return elems_[0];
+	}
+	MYSTL_CONSTEXPR14 reference back()
+	{
+		MYSTL_DEBUG(N != 0);
+		return elems_[N == 0 ? 0 : N - 1];
+	}
+	constexpr const_reference back() const
+	{
+		return elems_[N == 0 ? 0 : N - 1];
+	}
+
+	MYSTL_CONSTEXPR14 pointer data()       noexcept { return elems_; }
+	constexpr const_pointer   data() const noexcept { return elems_; }
+
+	// 修改容器相关操作
+	MYSTL_CONSTEXPR20 void fill(const value_type& value)
+	{
+		mystl::fill_n(elems_, N, value);
+	}
+
+	MYSTL_CONSTEXPR20 void swap(array& rhs)
+	{
+		mystl::swap_range(elems_, elems_ + N, rhs.elems_);
+	}
+};
+
+/*****************************************************************************************/
+// get / tuple_size / tuple_element
+/*****************************************************************************************/
+
+template <class T, size_t N>
+struct tuple_size<array<T, N>> : m_integral_constant<size_t, N> {};
+
+template <size_t I, class T, size_t N>
+struct tuple_element<I, array<T, N>>
+{
+	static_assert(I < N, "array index out of range");
+	typedef T type;
+};
+
+template <size_t I, class T, size_t N>
+MYSTL_CONSTEXPR14 T& get(array<T, N>& a) noexcept
+{
+	static_assert(I < N, "array index out of range");
+	return a.elems_[I];
+}
+
+template <size_t I, class T, size_t N>
+constexpr const T& get(const array<T, N>& a) noexcept
+{
+	static_assert(I < N, "array index out of range");
+	return a.elems_[I];
+}
+
+template <size_t I, class T, size_t N>
+MYSTL_CONSTEXPR14 T&& get(array<T, N>&& a) noexcept
+{
+	static_assert(I < N, "array index out of range");
+	return mystl::move(a.elems_[I]);
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+/*****************************************************************************************/
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator==(const array<T, N>& lhs, const array<T, N>& rhs)
+{
+	return mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator<(const array<T, N>& lhs, const array<T, N>& rhs)
+{
+	return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator>(const array<T, N>& lhs, const array<T, N>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator<=(const array<T, N>& lhs, const array<T, N>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator>=(const array<T, N>& lhs, const array<T, N>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 void swap(array<T, N>& lhs, array<T, N>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+// 元素可以按字节转移时, array 也可以
+template <class T, size_t N>
+struct is_trivially_relocatable<array<T, N>> : is_trivially_relocatable<T> {};
+
+} // namespace mystl
+#endif // !MYTINYSTL_ARRAY_H_
@@ -0,0 +1,1308 @@
+#ifndef MYTINYSTL_BASIC_STRING_H_
+#define MYTINYSTL_BASIC_STRING_H_
+
+// 这个头文件包含一个模板类 basic_string
+// 用于表示字符串类型
+// 内部定义有 string, wstring, u16string, u32string 类型
+
+// notes:
+//
+// 短字符串优化(SSO): basic_string 对象本身占 3 个指针大小(64 位下 24 字节), 两种存储方式共用这块空间:
+//   * 短串: 字符直接存放在对象内, 最多 sizeof(long_rep) / sizeof(CharT) - 1 个字符(char 为 23 个),
+//           最后一个字符位置存放 "剩余容量", 串满时它恰好为 0, 兼作结尾的空字符
+//   * 长串: 存放 { 指针, 长度, 容量 }, 容量字段的最高位(对象最后一个字节的最高位)为 1 表示长串
+// 所以不超过 23 个字符的 string 不申请内存, 复制、移动也只是复制 24 个字节
+//
+// 长串的增长策略与 vector 相同(get_new_cap): 扩展为原容量的 1.5 倍与所需大小中的较大者
+// 查找函数都转交给 string_detail(见 string_view.h), char 使用 SSE2 / SSE4.2 加速
+// resize_and_overwrite(n, op) 扩展空间后不做填充, 由 op 直接写入内容并返回最终长度
+// 可隐式转换为 basic_string_view, 接受字符串的函数都有接受 basic_string_view 的版本
+// try_reserve / try_push_back 在分配失败时返回 errc 而不抛出异常
+//
+// 异常保证：
+// mystl::basic_string<CharT> 满足基本异常保证，对以下函数做强异常安全保证：
+//   * reserve
+//   * push_back
+//   * append
+//   * insert
+//   * replace
+
+#include <initializer_list>
+#include <iostream>
+
+#include "iterator.h"
+#include "memory.h"
+#include "fuctional.h"
+#include "string_view.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类 basic_string
+// 参数一代表字符类型，参数二代表萃取字符类型的方式，缺省使用 mystl::char_traits
+template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+class basic_string
+{
+	static_assert(std::is_trivial<CharType>::value, "basic_string requires a trivial character type");
+
+public:
+	typedef CharTraits                               traits_type;
+	typedef CharTraits                               char_traits;
+
+	typedef mystl::allocator<CharType>               allocator_type;
+	typedef mystl::allocator<CharType>               data_allocator;
+
+	typedef typename allocator_type::value_type      value_type;
+	typedef typename allocator_type::pointer         pointer;
+	typedef typename allocator_type::const_pointer   const_pointer;
+	typedef typename allocator_type::reference       reference;
+	typedef typename allocator_type::const_reference const_reference;
+	typedef typename allocator_type::size_type       size_type;
+	typedef typename allocator_type::difference_type difference_type;
+
+	typedef value_type*                              iterator;
+	typedef const value_type*                        const_iterator;
+	typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+	typedef basic_string_view<CharType, CharTraits>  view_type;
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+	// 长串的表示
+	struct long_rep
+	{
+		pointer   data;     // 字符串起始位置
+		size_type size;     // 字符串长度
+		size_type cap_word; // 容量, 含长串标记(见 encode_cap)
+	};
+
+	// 短串最多容纳的字符数, 最后一个位置留给剩余容量 / 结尾的空字符
+	static constexpr size_type kSmallCap = sizeof(long_rep) / sizeof(value_type) - 1;
+
+	union rep
+	{
+		long_rep   l;
+		value_type s[kSmallCap + 1];
+	};
+
+	static_assert(sizeof(rep) == sizeof(long_rep), "short and long representations must overlap exactly");
+	static_assert(kSmallCap >= 1, "character type too large for the short representation");
+
+	rep rep_;
+
+	// 是否为指向本字符串的迭代器类型
+	template <class Iter>
+	struct is_position
+		: m_bool_constant<std::is_same<Iter, iterator>::value ||
+		                  std::is_same<Iter, const_iterator>::value> {};
+
+public:
+	// 构造、复制、移动、析构函数
+
+	basic_string() noexcept
+	{ set_small_size(0); }
+
+	basic_string(size_type n, value_type ch)
+	{ init_fill(n, ch); }
+
+	basic_string(const basic_string& other, size_type pos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > other.size(), "basic_string<Char, Traits>'s pos out of range");
+		init_from(other.data() + pos, other.size() - pos);
+	}
+
+	basic_string(const basic_string& other, size_type pos, size_type count)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > other.size(), "basic_string<Char, Traits>'s pos out of range");
+		init_from(other.data() + pos, mystl::min(count, other.size() - pos));
+	}
+
+	basic_string(const_pointer str)
+	{ init_from(str, char_traits::length(str)); }
+
+	basic_string(const_pointer str, size_type count)
+	{ init_from(str, count); }
+
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	basic_string(Iter first, Iter last)
+	{ copy_init(first, last, iterator_category(first)); }
+
+	basic_string(std::initializer_list<value_type> ilist)
+	{ init_from(ilist.begin(), ilist.size()); }
+
+	explicit basic_string(view_type v)
+	{ init_from(v.data(), v.size()); }
+
+	basic_string(view_type v, size_type pos, size_type count)
+	{
+		v = v.substr(pos, count);
+		init_from(v.data(), v.size());
+	}
+
+	basic_string(const basic_string& rhs)
+	{
+		if (rhs.is_long())
+			init_from(rhs.rep_.l.data, rhs.rep_.l.size);
+		else
+			rep_ = rhs.rep_;
+	}
+
+	basic_string(basic_string&& rhs) noexcept
+		:rep_(rhs.rep_)
+	{
+		rhs.set_small_size(0);
+	}
+
+	basic_string& operator=(const basic_string& rhs);
+	basic_string& operator=(basic_string&& rhs) noexcept;
+
+	basic_string& operator=(const_pointer str)
+	{ return assign(str, char_traits::length(str)); }
+	basic_string& operator=(value_type ch)
+	{ return assign(static_cast<size_type>(1), ch); }
+	basic_string& operator=(std::initializer_list<value_type> ilist)
+	{ return assign(ilist.begin(), ilist.size()); }
+	basic_string& operator=(view_type v)
+	{ return assign(v.data(), v.size()); }
+
+	~basic_string()
+	{ destroy_buffer(); }
+
+public:
+	// 迭代器相关操作
+	iterator               begin()         noexcept
+	{ return get_pointer(); }
+	const_iterator         begin()   const noexcept
+	{ return get_pointer(); }
+	iterator               end()           noexcept
+	{ return get_pointer() + size(); }
+	const_iterator         end()     const noexcept
+	{ return get_pointer() + size(); }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept
+	{ return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept
+	{ return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return begin(); }
+	const_iterator         cend()    const noexcept
+	{ return end(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关操作
+	bool      empty()    const noexcept
+	{ return size() == 0; }
+
+	size_type size()     const noexcept
+	{ return is_long() ? rep_.l.size : small_size(); }
+	size_type length()   const noexcept
+	{ return size(); }
+	size_type capacity() const noexcept
+	{ return is_long() ? decode_cap(rep_.l.cap_word) : kSmallCap; }
+	size_type max_size() const noexcept
+	{ return (static_cast<size_type>(-1) >> 8) / sizeof(value_type) - 1; }
+
+	void      reserve(size_type n);
+	void      shrink_to_fit();
+
+	// 分配失败时不抛出异常的版本, 返回 errc::ok, errc::length_error(超过 max_size) 或 errc::bad_alloc,
+	// 失败时字符串保持不变
+	errc      try_reserve(size_type n) noexcept;
+
+	// 访问元素相关操作
+	reference       operator[](size_type n)
+	{
+		MYSTL_DEBUG(n <= size());
+		return get_pointer()[n];
+	}
+	const_reference operator[](size_type n) const
+	{
+		MYSTL_DEBUG(n <= size());
+		return get_pointer()[n];
+	}
+
+	reference       at(size_type n)
+	{
+		THROW_OUT_OF_RANGE_IF(n >= size(), "basic_string<Char, Traits>::at() subscript out of range");
+		return (*this)[n];
+	}
+	const_reference at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(n >= size(), "basic_string<Char, Traits>::at() subscript out of range");
+		return (*this)[n];
+	}
+
+	reference       front()
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+	const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+
+	reference       back()
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end() - 1);
+	}
+	const_reference back()  const
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end() - 1);
+	}
+
+	pointer         data()        noexcept
+	{ return get_pointer(); }
+	const_pointer   data()  const noexcept
+	{ return get_pointer(); }
+	const_pointer   c_str() const noexcept
+	{ return get_pointer(); }
+
+	operator view_type() const noexcept
+	{ return view_type(data(), size()); }
+
+	// 添加删除相关操作
+
+	// assign
+	basic_string& assign(size_type count, value_type ch)
+	{ return replace_fill(0, size(), count, ch); }
+	basic_string& assign(const basic_string& str)
+	{ return *this = str; }
+	basic_string& assign(basic_string&& str) noexcept
+	{ return *this = mystl::move(str); }
+	basic_string& assign(const basic_string& str, size_type pos, size_type count = npos)
+	{ return assign(view_type(str).substr(pos, count)); }
+	basic_string& assign(const_pointer str, size_type count)
+	{ return replace_impl(0, size(), str, count); }
+	basic_string& assign(const_pointer str)
+	{ return assign(str, char_traits::length(str)); }
+	basic_string& assign(view_type v)
+	{ return assign(v.data(), v.size()); }
+	basic_string& assign(view_type v, size_type pos, size_type count = npos)
+	{ return assign(v.substr(pos, count)); }
+	basic_string& assign(std::initializer_list<value_type> ilist)
+	{ return assign(ilist.begin(), ilist.size()); }
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	basic_string& assign(Iter first, Iter last)
+	{ return replace(begin(), end(), first, last); }
+
+	// insert
+	basic_string& insert(size_type pos, size_type count, value_type ch)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::insert's pos out of range");
+		return replace_fill(pos, 0, count, ch);
+	}
+	basic_string& insert(size_type pos, const_pointer str)
+	{ return insert(pos, str, char_traits::length(str)); }
+	basic_string& insert(size_type pos, const_pointer str, size_type count)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::insert's pos out of range");
+		return replace_impl(pos, 0, str, count);
+	}
+	basic_string& insert(size_type pos, const basic_string& str)
+	{ return insert(pos, str.data(), str.size()); }
+	basic_string& insert(size_type pos, const basic_string& str, size_type pos2, size_type count = npos)
+	{ return insert(pos, view_type(str).substr(pos2, count)); }
+	basic_string& insert(size_type pos, view_type v)
+	{ return insert(pos, v.data(), v.size()); }
+	basic_string& insert(size_type pos, view_type v, size_type pos2, size_type count = npos)
+	{ return insert(pos, v.substr(pos2, count)); }
+
+	iterator insert(const_iterator pos, value_type ch)
+	{
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		replace_fill(n, 0, 1, ch);
+		return begin() + n;
+	}
+	// 迭代器版本写成模板, 否则 insert(0, n, ch) 中的 0 也能转换为指针而产生二义性
+	template <class Iter, typename std::enable_if<
+		is_position<Iter>::value, int>::type = 0>
+	iterator insert(Iter pos, size_type count, value_type ch)
+	{
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		replace_fill(n, 0, count, ch);
+		return begin() + n;
+	}
+	iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+	{
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		replace_impl(n, 0, ilist.begin(), ilist.size());
+		return begin() + n;
+	}
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	iterator insert(const_iterator pos, Iter first, Iter last)
+	{
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		replace(pos, pos, first, last);
+		return begin() + n;
+	}
+
+	// erase / clear
+	basic_string& erase(size_type pos = 0, size_type count = npos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::erase's pos out of range");
+		erase_impl(pos, mystl::min(count, size() - pos));
+		return *this;
+	}
+	template <class Iter, typename std::enable_if<
+		is_position<Iter>::value, int>::type = 0>
+	iterator erase(Iter pos)
+	{
+		MYSTL_DEBUG(pos != cend());
+		const size_type n = static_cast<size_type>(pos - cbegin());
+		erase_impl(n, 1);
+		return begin() + n;
+	}
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		const size_type n = static_cast<size_type>(first - cbegin());
+		erase_impl(n, static_cast<size_type>(last - first));
+		return begin() + n;
+	}
+
+	void clear() noexcept
+	{ set_size(0); }
+
+	// push_back / pop_back
+	void push_back(value_type ch)
+	{
+		const size_type sz = size();
+		if (sz == capacity())
+			grow_by(1, sz);
+		pointer p = get_pointer();
+		p[sz] = ch;
+		set_size(sz + 1);
+	}
+
+	errc try_push_back(value_type ch) noexcept
+	{
+		const size_type sz = size();
+		if (sz == capacity())
+		{
+			if (sz == max_size())
+				return errc::length_error;
+			const errc e = try_reserve(get_new_cap(1));
+			if (e != errc::ok)
+				return e;
+		}
+		pointer p = get_pointer();
+		p[sz] = ch;
+		set_size(sz + 1);
+		return errc::ok;
+	}
+
+	void pop_back()
+	{
+		MYSTL_DEBUG(!empty());
+		set_size(size() - 1);
+	}
+
+	// append
+	basic_string& append(size_type count, value_type ch)
+	{ return replace_fill(size(), 0, count, ch); }
+	basic_string& append(const basic_string& str)
+	{ return append(str.data(), str.size()); }
+	basic_string& append(const basic_string& str, size_type pos, size_type count = npos)
+	{ return append(view_type(str).substr(pos, count)); }
+	basic_string& append(const_pointer str, size_type count);
+	basic_string& append(const_pointer str)
+	{ return append(str, char_traits::length(str)); }
+	basic_string& append(view_type v)
+	{ return append(v.data(), v.size()); }
+	basic_string& append(view_type v, size_type pos, size_type count = npos)
+	{ return append(v.substr(pos, count)); }
+	basic_string& append(std::initializer_list<value_type> ilist)
+	{ return append(ilist.begin(), ilist.size()); }
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	basic_string& append(Iter first, Iter last)
+	{ return replace(end(), end(), first, last); }
+
+	// operator+=
+	basic_string& operator+=(const basic_string& str)
+	{ return append(str.data(), str.size()); }
+	basic_string& operator+=(value_type ch)
+	{
+		push_back(ch);
+		return *this;
+	}
+	basic_string& operator+=(const_pointer str)
+	{ return append(str, char_traits::length(str)); }
+	basic_string& operator+=(std::initializer_list<value_type> ilist)
+	{ return append(ilist.begin(), ilist.size()); }
+	basic_string& operator+=(view_type v)
+	{ return append(v.data(), v.size()); }
+
+	// replace
+	basic_string& replace(size_type pos, size_type count, const basic_string& str)
+	{ return replace(pos, count, str.data(), str.size()); }
+	basic_string& replace(const_iterator first, const_iterator last, const basic_string& str)
+	{ return replace(first, last, str.data(), str.size()); }
+	basic_string& replace(size_type pos, size_type count, const basic_string& str,
+	                      size_type pos2, size_type count2 = npos)
+	{ return replace(pos, count, view_type(str).substr(pos2, count2)); }
+
+	basic_string& replace(size_type pos, size_type count, const_pointer str, size_type count2)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::replace's pos out of range");
+		return replace_impl(pos, mystl::min(count, size() - pos), str, count2);
+	}
+	basic_string& replace(const_iterator first, const_iterator last, const_pointer str, size_type count2)
+	{
+		return replace_impl(static_cast<size_type>(first - cbegin()),
+		                    static_cast<size_type>(last - first), str, count2);
+	}
+	basic_string& replace(size_type pos, size_type count, const_pointer str)
+	{ return replace(pos, count, str, char_traits::length(str)); }
+	basic_string& replace(const_iterator first, const_iterator last, const_pointer str)
+	{ return replace(first, last, str, char_traits::length(str)); }
+
+	basic_string& replace(size_type pos, size_type count, size_type count2, value_type ch)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::replace's pos out of range");
+		return replace_fill(pos, mystl::min(count, size() - pos), count2, ch);
+	}
+	basic_string& replace(const_iterator first, const_iterator last, size_type count2, value_type ch)
+	{
+		return replace_fill(static_cast<size_type>(first - cbegin()),
+		                    static_cast<size_type>(last - first), count2, ch);
+	}
+
+	basic_string& replace(size_type pos, size_type count, view_type v)
+	{ return replace(pos, count, v.data(), v.size()); }
+	basic_string& replace(const_iterator first, const_iterator last, view_type v)
+	{ return replace(first, last, v.data(), v.size()); }
+	basic_string& replace(size_type pos, size_type count, view_type v,
+	                      size_type pos2, size_type count2 = npos)
+	{ return replace(pos, count, v.substr(pos2, count2)); }
+
+	basic_string& replace(const_iterator first, const_iterator last, std::initializer_list<value_type> ilist)
+	{ return replace(first, last, ilist.begin(), ilist.size()); }
+
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	basic_string& replace(const_iterator first, const_iterator last, Iter first2, Iter last2)
+	{
+		// 区间可能来自本字符串, 先复制出来
+		const basic_string tmp(first2, last2);
+		return replace(first, last, tmp.data(), tmp.size());
+	}
+
+	// resize
+	void resize(size_type count)
+	{ resize(count, value_type()); }
+	void resize(size_type count, value_type ch)
+	{
+		const size_type sz = size();
+		if (count > sz)
+			append(count - sz, ch);
+		else
+			set_size(count);
+	}
+
+	// 把容量扩展到至少 count, 不填充新增部分, 由 op(data(), count) 写入内容并返回最终长度(不超过 count)
+	template <class Operation>
+	void resize_and_overwrite(size_type count, Operation op);
+
+	// 复制到 dst, 不添加结尾的空字符
+	size_type copy(pointer dst, size_type count, size_type pos = 0) const
+	{ return view_type(*this).copy(dst, count, pos); }
+
+	basic_string substr(size_type pos = 0, size_type count = npos) const
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "basic_string<Char, Traits>::substr's pos out of range");
+		return basic_string(data() + pos, mystl::min(count, size() - pos));
+	}
+
+	void swap(basic_string& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			const rep tmp = rep_;
+			rep_ = rhs.rep_;
+			rhs.rep_ = tmp;
+		}
+	}
+
+	// compare
+	int compare(const basic_string& str) const noexcept
+	{ return view_type(*this).compare(view_type(str)); }
+	int compare(size_type pos1, size_type count1, const basic_string& str) const
+	{ return view_type(*this).compare(pos1, count1, view_type(str)); }
+	int compare(size_type pos1, size_type count1, const basic_string& str,
+	            size_type pos2, size_type count2 = npos) const
+	{ return view_type(*this).compare(pos1, count1, view_type(str), pos2, count2); }
+	int compare(const_pointer str) const
+	{ return view_type(*this).compare(str); }
+	int compare(size_type pos1, size_type count1, const_pointer str) const
+	{ return view_type(*this).compare(pos1, count1, str); }
+	int compare(size_type pos1, size_type count1, const_pointer str, size_type count2) const
+	{ return view_type(*this).compare(pos1, count1, str, count2); }
+	int compare(view_type v) const noexcept
+	{ return view_type(*this).compare(v); }
+	int compare(size_type pos1, size_type count1, view_type v) const
+	{ return view_type(*this).compare(pos1, count1, v); }
+	int compare(size_type pos1, size_type count1, view_type v,
+	            size_type pos2, size_type count2 = npos) const
+	{ return view_type(*this).compare(pos1, count1, v, pos2, count2); }
+
+	// starts_with / ends_with / contains
+	bool starts_with(view_type v) const noexcept
+	{ return view_type(*this).starts_with(v); }
+	bool starts_with(value_type ch) const noexcept
+	{ return view_type(*this).starts_with(ch); }
+	bool starts_with(const_pointer str) const
+	{ return view_type(*this).starts_with(str); }
+
+	bool ends_with(view_type v) const noexcept
+	{ return view_type(*this).ends_with(v); }
+	bool ends_with(value_type ch) const noexcept
+	{ return view_type(*this).ends_with(ch); }
+	bool ends_with(const_pointer str) const
+	{ return view_type(*this).ends_with(str); }
+
+	bool contains(view_type v) const noexcept
+	{ return view_type(*this).contains(v); }
+	bool contains(value_type ch) const noexcept
+	{ return view_type(*this).contains(ch); }
+	bool contains(const_pointer str) const
+	{ return view_type(*this).contains(str); }
+
+	// find
+	size_type find(const basic_string& str, size_type pos = 0) const noexcept
+	{ return view_type(*this).find(view_type(str), pos); }
+	size_type find(const_pointer str, size_type pos, size_type count) const noexcept
+	{ return view_type(*this).find(str, pos, count); }
+	size_type find(const_pointer str, size_type pos = 0) const
+	{ return view_type(*this).find(str, pos); }
+	size_type find(value_type ch, size_type pos = 0) const noexcept
+	{ return view_type(*this).find(ch, pos); }
+	size_type find(view_type v, size_type pos = 0) const noexcept
+	{ return view_type(*this).find(v, pos); }
+
+	// rfind
+	size_type rfind(const basic_string& str, size_type pos = npos) const noexcept
+	{ return view_type(*this).rfind(view_type(str), pos); }
+	size_type rfind(const_pointer str, size_type pos, size_type count) const noexcept
+	{ return view_type(*this).rfind(str, pos, count); }
+	size_type rfind(const_pointer str, size_type pos = npos) const
+	{ return view_type(*this).rfind(str, pos); }
+	size_type rfind(value_type ch, size_type pos = npos) const noexcept
+	{ return view_type(*this).rfind(ch, pos); }
+	size_type rfind(view_type v, size_type pos = npos) const noexcept
+	{ return view_type(*this).rfind(v, pos); }
+
+	// find_first_of
+	size_type find_first_of(const basic_string& str, size_type pos = 0) const noexcept
+	{ return view_type(*this).find_first_of(view_type(str), pos); }
+	size_type find_first_of(const_pointer str, size_type pos, size_type count) const noexcept
+	{ return view_type(*this).find_first_of(str, pos, count); }
+	size_type find_first_of(const_pointer str, size_type pos = 0) const
+	{ return view_type(*this).find_first_of(str, pos); }
+	size_type find_first_of(value_type ch, size_type pos = 0) const noexcept
+	{ return view_type(*this).find_first_of(ch, pos); }
+	size_type find_first_of(view_type v, size_type pos = 0) const noexcept
+	{ return view_type(*this).find_first_of(v, pos); }
+
+	// find_first_not_of
+	size_type find_first_not_of(const basic_string& str, size_type pos = 0) const noexcept
+	{ return view_type(*this).find_first_not_of(view_type(str), pos); }
+	size_type find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept
+	{ return view_type(*this).find_first_not_of(str, pos, count); }
+	size_type find_first_not_of(const_pointer str, size_type pos = 0) const
+	{ return view_type(*this).find_first_not_of(str, pos); }
+	size_type find_first_not_of(value_type ch, size_type pos = 0) const noexcept
+	{ return view_type(*this).find_first_not_of(ch, pos); }
+	size_type find_first_not_of(view_type v, size_type pos = 0) const noexcept
+	{ return view_type(*this).find_first_not_of(v, pos); }
+
+	// find_last_of
+	size_type find_last_of(const basic_string& str, size_type pos = npos) const noexcept
+	{ return view_type(*this).find_last_of(view_type(str), pos); }
+	size_type find_last_of(const_pointer str, size_type pos, size_type count) const noexcept
+	{ return view_type(*this).find_last_of(str, pos, count); }
+	size_type find_last_of(const_pointer str, size_type pos = npos) const
+	{ return view_type(*this).find_last_of(str, pos); }
+	size_type find_last_of(value_type ch, size_type pos = npos) const noexcept
+	{ return view_type(*this).find_last_of(ch, pos); }
+	size_type find_last_of(view_type v, size_type pos = npos) const noexcept
+	{ return view_type(*this).find_last_of(v, pos); }
+
+	// find_last_not_of
+	size_type find_last_not_of(const basic_string& str, size_type pos = npos) const noexcept
+	{ return view_type(*this).find_last_not_of(view_type(str), pos); }
+	size_type find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept
+	{ return view_type(*this).find_last_not_of(str, pos, count); }
+	size_type find_last_not_of(const_pointer str, size_type pos = npos) const
+	{ return view_type(*this).find_last_not_of(str, pos); }
+	size_type find_last_not_of(value_type ch, size_type pos = npos) const noexcept
+	{ return view_type(*this).find_last_not_of(ch, pos); }
+	size_type find_last_not_of(view_type v, size_type pos = npos) const noexcept
+	{ return view_type(*this).find_last_not_of(v, pos); }
+
+private:
+	// helper functions
+
+	// 表示方式相关
+
+	// 长串标记放在容量字段中, 并且位于对象的最后一个字节的最高位
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	static size_type encode_cap(size_type cap) noexcept
+	{ return (cap << 8) | 0x80; }
+	static size_type decode_cap(size_type word) noexcept
+	{ return word >> 8; }
+#else
+	static constexpr size_type kLongFlag = static_cast<size_type>(1) << (sizeof(size_type) * 8 - 1);
+	static size_type encode_cap(size_type cap) noexcept
+	{ return cap | kLongFlag; }
+	static size_type decode_cap(size_type word) noexcept
+	{ return word & ~kLongFlag; }
+#endif
+
+	bool is_long() const noexcept
+	{ return (reinterpret_cast<const unsigned char*>(&rep_)[sizeof(rep) - 1] & 0x80) != 0; }
+
+	size_type small_size() const noexcept
+	{ return kSmallCap - static_cast<size_type>(rep_.s[kSmallCap]); }
+
+	void set_small_size(size_type n) noexcept
+	{
+		rep_.s[n] = value_type();
+		rep_.s[kSmallCap] = static_cast<value_type>(kSmallCap - n);
+	}
+
+	void set_long(pointer p, size_type n, size_type cap) noexcept
+	{
+		rep_.l.data = p;
+		rep_.l.size = n;
+		rep_.l.cap_word = encode_cap(cap);
+		p[n] = value_type();
+	}
+
+	pointer       get_pointer()       noexcept
+	{ return is_long() ? rep_.l.data : rep_.s; }
+	const_pointer get_pointer() const noexcept
+	{ return is_long() ? rep_.l.data : rep_.s; }
+
+	// 修改长度并写入结尾的空字符, 不检查容量
+	void set_size(size_type n) noexcept
+	{
+		if (is_long())
+		{
+			rep_.l.size = n;
+			rep_.l.data[n] = value_type();
+		}
+		else
+		{
+			set_small_size(n);
+		}
+	}
+
+	// 申请可容纳 cap 个字符(另加结尾的空字符)的空间
+	static pointer allocate_buffer(size_type cap)
+	{ return data_allocator::allocate(cap + 1); }
+
+	void destroy_buffer() noexcept
+	{
+		if (is_long())
+			data_allocator::deallocate(rep_.l.data, decode_cap(rep_.l.cap_word) + 1);
+	}
+
+	// 初始化
+	void init_from(const_pointer str, size_type n);
+	void init_fill(size_type n, value_type ch);
+	template <class Iter>
+	void copy_init(Iter first, Iter last, mystl::input_iterator_tag);
+	template <class Iter>
+	void copy_init(Iter first, Iter last, mystl::forward_iterator_tag);
+
+	// 容量
+	size_type get_new_cap(size_type add_size) const;
+	void      reallocate(size_type new_cap);
+	void      grow_by(size_type add_size, size_type keep);
+
+	// 修改
+	basic_string& replace_impl(size_type pos, size_type n1, const_pointer str, size_type n2);
+	basic_string& replace_fill(size_type pos, size_type n1, size_type n2, value_type ch);
+	void          erase_impl(size_type pos, size_type n) noexcept;
+};
+
+template <class CharType, class CharTraits>
+constexpr typename basic_string<CharType, CharTraits>::size_type basic_string<CharType, CharTraits>::npos;
+
+template <class CharType, class CharTraits>
+constexpr typename basic_string<CharType, CharTraits>::size_type basic_string<CharType, CharTraits>::kSmallCap;
+
+#if !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+template <class CharType, class CharTraits>
+constexpr typename basic_string<CharType, CharTraits>::size_type basic_string<CharType, CharTraits>::kLongFlag;
+#endif
+
+/*****************************************************************************************/
+
+// 复制赋值操作符
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>&
+basic_string<CharType, CharTraits>::operator=(const basic_string& rhs)
+{
+	if (this != &rhs)
+	{
+		if (!is_long() && !rhs.is_long())
+			rep_ = rhs.rep_;
+		else
+			assign(rhs.data(), rhs.size());
+	}
+	return *this;
+}
+
+// 移动赋值操作符
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>&
+basic_string<CharType, CharTraits>::operator=(basic_string&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		destroy_buffer();
+		rep_ = rhs.rep_;
+		rhs.set_small_size(0);
+	}
+	return *this;
+}
+
+// 预留空间, 只增不减
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::reserve(size_type n)
+{
+	if (n > capacity())
+	{
+		THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size()"
+		                      "in basic_string<Char,Traits>::reserve(n)");
+		reallocate(n);
+	}
+}
+
+template <class CharType, class CharTraits>
+errc basic_string<CharType, CharTraits>::try_reserve(size_type n) noexcept
+{
+	if (n <= capacity())
+		return errc::ok;
+	if (n > max_size())
+		return errc::length_error;
+	pointer p = data_allocator::try_allocate(n + 1);
+	if (p == nullptr)
+		return errc::bad_alloc;
+	const size_type sz = size();
+	char_traits::copy(p, get_pointer(), sz);
+	destroy_buffer();
+	set_long(p, sz, n);
+	return errc::ok;
+}
+
+// 减少不用的空间, 能放进对象内时回到短串
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::shrink_to_fit()
+{
+	if (!is_long())
+		return;
+	const size_type sz = rep_.l.size;
+	if (sz <= kSmallCap)
+	{
+		pointer old = rep_.l.data;
+		const size_type old_cap = decode_cap(rep_.l.cap_word);
+		char_traits::copy(rep_.s, old, sz);
+		set_small_size(sz);
+		data_allocator::deallocate(old, old_cap + 1);
+	}
+	else if (sz < decode_cap(rep_.l.cap_word))
+	{
+		reallocate(sz);
+	}
+}
+
+// 在末尾添加 [str, str + count)
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>&
+basic_string<CharType, CharTraits>::append(const_pointer str, size_type count)
+{
+	const size_type sz = size();
+	if (count <= capacity() - sz)
+	{
+		// str 可能指向本字符串, 用 move
+		pointer p = get_pointer();
+		char_traits::move(p + sz, str, count);
+		set_size(sz + count);
+		return *this;
+	}
+	return replace_impl(sz, 0, str, count);
+}
+
+// 扩展空间后由 op 写入内容
+template <class CharType, class CharTraits>
+template <class Operation>
+void basic_string<CharType, CharTraits>::resize_and_overwrite(size_type count, Operation op)
+{
+	if (count > capacity())
+		grow_by(count - capacity(), size());
+	// 扩展后判断一次长短串并直接写入; 短串时 n 不超过 kSmallCap, 显式限制使编译器也能确认下标不越界
+	const bool long_rep = is_long();
+	const size_type n = static_cast<size_type>(mystl::move(op)(get_pointer(), count));
+	MYSTL_DEBUG(n <= count);
+	if (long_rep)
+	{
+		rep_.l.size = n;
+		rep_.l.data[n] = value_type();
+	}
+	else
+	{
+		MYSTL_DEBUG(n <= kSmallCap);
+		set_small_size(n <= kSmallCap ? n : kSmallCap);
+	}
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 用 [str, str + n) 初始化
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::init_from(const_pointer str, size_type n)
+{
+	if (n <= kSmallCap)
+	{
+		char_traits::copy(rep_.s, str, n);
+		set_small_size(n);
+		return;
+	}
+	THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+	pointer p = allocate_buffer(n);
+	char_traits::copy(p, str, n);
+	set_long(p, n, n);
+}
+
+// 用 n 个 ch 初始化
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::init_fill(size_type n, value_type ch)
+{
+	if (n <= kSmallCap)
+	{
+		char_traits::fill(rep_.s, ch, n);
+		set_small_size(n);
+		return;
+	}
+	THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+	pointer p = allocate_buffer(n);
+	char_traits::fill(p, ch, n);
+	set_long(p, n, n);
+}
+
+// 输入迭代器只能逐个添加
+template <class CharType, class CharTraits>
+template <class Iter>
+void basic_string<CharType, CharTraits>::
+copy_init(Iter first, Iter last, mystl::input_iterator_tag)
+{
+	set_small_size(0);
+	MYSTL_TRY
+	{
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+	MYSTL_CATCH_ALL
+	{
+		destroy_buffer();
+		MYSTL_RETHROW;
+	}
+}
+
+// 前向迭代器先算出长度, 只申请一次
+template <class CharType, class CharTraits>
+template <class Iter>
+void basic_string<CharType, CharTraits>::
+copy_init(Iter first, Iter last, mystl::forward_iterator_tag)
+{
+	const size_type n = static_cast<size_type>(mystl::distance(first, last));
+	pointer p = rep_.s;
+	if (n > kSmallCap)
+	{
+		THROW_LENGTH_ERROR_IF(n > max_size(), "basic_string<Char, Traits>'s size too big");
+		p = allocate_buffer(n);
+	}
+	for (pointer cur = p; first != last; ++first, ++cur)
+		*cur = *first;
+	if (n > kSmallCap)
+		set_long(p, n, n);
+	else
+		set_small_size(n);
+}
+
+// 与 vector 相同的增长策略
+template <class CharType, class CharTraits>
+typename basic_string<CharType, CharTraits>::size_type
+basic_string<CharType, CharTraits>::get_new_cap(size_type add_size) const
+{
+	const auto old_size = capacity();
+	THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
+	                      "basic_string<Char,Traits>'s size too big");
+	if (old_size > max_size() - old_size / 2)
+	{
+		return old_size + add_size > max_size() - 16
+			? old_size + add_size : old_size + add_size + 16;
+	}
+	return mystl::max(old_size + old_size / 2, old_size + add_size);
+}
+
+// 重新申请容量为 new_cap 的空间, 保留原有内容, 要求 new_cap > kSmallCap 且不小于当前长度
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::reallocate(size_type new_cap)
+{
+	const size_type sz = size();
+	MYSTL_DEBUG(new_cap >= sz && new_cap > kSmallCap);
+	pointer p = allocate_buffer(new_cap);
+	char_traits::copy(p, get_pointer(), sz);
+	destroy_buffer();
+	set_long(p, sz, new_cap);
+}
+
+// 容量至少增加 add_size, 只保留前 keep 个字符
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::grow_by(size_type add_size, size_type keep)
+{
+	const size_type new_cap = get_new_cap(add_size);
+	pointer p = allocate_buffer(new_cap);
+	char_traits::copy(p, get_pointer(), keep);
+	destroy_buffer();
+	set_long(p, keep, new_cap);
+}
+
+// 把 [pos, pos + n1) 替换为 [str, str + n2), str 可以指向本字符串
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>&
+basic_string<CharType, CharTraits>::
+replace_impl(size_type pos, size_type n1, const_pointer str, size_type n2)
+{
+	const size_type sz = size();
+	MYSTL_DEBUG(pos + n1 <= sz);
+	const size_type cap = capacity();
+	if (n2 > n1 && n2 - n1 > cap - sz)
+	{
+		// 空间不足: 先在新空间中拼好, 再释放旧空间, 所以 str 在复制时仍然有效
+		const size_type new_size = sz - n1 + n2;
+		THROW_LENGTH_ERROR_IF(n2 - n1 > max_size() - sz, "basic_string<Char, Traits>'s size too big");
+		const size_type new_cap = get_new_cap(new_size - cap);
+		pointer p = allocate_buffer(new_cap);
+		const_pointer old = get_pointer();
+		char_traits::copy(p, old, pos);
+		char_traits::copy(p + pos, str, n2);
+		char_traits::copy(p + pos + n2, old + pos + n1, sz - pos - n1);
+		destroy_buffer();
+		set_long(p, new_size, new_cap);
+		return *this;
+	}
+	// 原地替换
+	pointer p = get_pointer();
+	if (n1 != n2)
+	{
+		const size_type n_move = sz - pos - n1;
+		if (n_move != 0)
+		{
+			if (n1 > n2)
+			{
+				// 变短: 先写入新内容, 再前移尾部
+				char_traits::move(p + pos, str, n2);
+				char_traits::move(p + pos + n2, p + pos + n1, n_move);
+				set_size(sz - n1 + n2);
+				return *this;
+			}
+			// 变长: 尾部后移之后 str 若落在尾部中, 也要随之调整
+			if (p + pos < str && str < p + sz)
+			{
+				if (p + pos + n1 <= str)
+				{
+					str += n2 - n1;
+				}
+				else
+				{
+					// str 跨越被替换的部分与尾部: 前 n1 个字符先就地写入
+					char_traits::move(p + pos, str, n1);
+					pos += n1;
+					str += n2;
+					n2 -= n1;
+					n1 = 0;
+				}
+			}
+			char_traits::move(p + pos + n2, p + pos + n1, n_move);
+		}
+	}
+	char_traits::move(p + pos, str, n2);
+	set_size(sz - n1 + n2);
+	return *this;
+}
+
+// 把 [pos, pos + n1) 替换为 n2 个 ch
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>&
+basic_string<CharType, CharTraits>::
+replace_fill(size_type pos, size_type n1, size_type n2, value_type ch)
+{
+	const size_type sz = size();
+	MYSTL_DEBUG(pos + n1 <= sz);
+	const size_type cap = capacity();
+	if (n2 > n1 && n2 - n1 > cap - sz)
+	{
+		const size_type new_size = sz - n1 + n2;
+		THROW_LENGTH_ERROR_IF(n2 - n1 > max_size() - sz, "basic_string<Char, Traits>'s size too big");
+		const size_type new_cap = get_new_cap(new_size - cap);
+		pointer p = allocate_buffer(new_cap);
+		const_pointer old = get_pointer();
+		char_traits::copy(p, old, pos);
+		char_traits::fill(p + pos, ch, n2);
+		char_traits::copy(p + pos + n2, old + pos + n1, sz - pos - n1);
+		destroy_buffer();
+		set_long(p, new_size, new_cap);
+		return *this;
+	}
+	pointer p = get_pointer();
+	if (n1 != n2)
+		char_traits::move(p + pos + n2, p + pos + n1, sz - pos - n1);
+	char_traits::fill(p + pos, ch, n2);
+	set_size(sz - n1 + n2);
+	return *this;
+}
+
+// 删除 [pos, pos + n)
+template <class CharType, class CharTraits>
+void basic_string<CharType, CharTraits>::erase_impl(size_type pos, size_type n) noexcept
+{
+	const size_type sz = size();
+	MYSTL_DEBUG(pos + n <= sz);
+	if (n == 0)
+		return;
+	pointer p = get_pointer();
+	char_traits::move(p + pos, p + pos + n, sz - pos - n);
+	set_size(sz - n);
+}
+
+/*****************************************************************************************/
+// 重载全局操作符
+
+// 重载 operator+
+// 左侧是右值时直接在其上追加, 省去一次复制
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(const basic_string<CharType, CharTraits>& lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	basic_string<CharType, CharTraits> tmp;
+	tmp.reserve(lhs.size() + rhs.size());
+	tmp.append(lhs).append(rhs);
+	return tmp;
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	const size_t n = CharTraits::length(lhs);
+	basic_string<CharType, CharTraits> tmp;
+	tmp.reserve(n + rhs.size());
+	tmp.append(lhs, n).append(rhs);
+	return tmp;
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(CharType ch, const basic_string<CharType, CharTraits>& rhs)
+{
+	basic_string<CharType, CharTraits> tmp;
+	tmp.reserve(1 + rhs.size());
+	tmp.push_back(ch);
+	tmp.append(rhs);
+	return tmp;
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+	const size_t n = CharTraits::length(rhs);
+	basic_string<CharType, CharTraits> tmp;
+	tmp.reserve(lhs.size() + n);
+	tmp.append(lhs).append(rhs, n);
+	return tmp;
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(const basic_string<CharType, CharTraits>& lhs, CharType ch)
+{
+	basic_string<CharType, CharTraits> tmp;
+	tmp.reserve(lhs.size() + 1);
+	tmp.append(lhs);
+	tmp.push_back(ch);
+	return tmp;
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(basic_string<CharType, CharTraits>&& lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+	return mystl::move(lhs.append(rhs));
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(const basic_string<CharType, CharTraits>& lhs, basic_string<CharType, CharTraits>&& rhs)
+{
+	return mystl::move(rhs.insert(0, lhs));
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(basic_string<CharType, CharTraits>&& lhs, basic_string<CharType, CharTraits>&& rhs)
+{
+	return mystl::move(lhs.append(rhs));
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(const CharType* lhs, basic_string<CharType, CharTraits>&& rhs)
+{
+	return mystl::move(rhs.insert(0, lhs));
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(CharType ch, basic_string<CharType, CharTraits>&& rhs)
+{
+	rhs.insert(rhs.begin(), ch);
+	return mystl::move(rhs);
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(basic_string<CharType, CharTraits>&& lhs, const CharType* rhs)
+{
+	return mystl::move(lhs.append(rhs));
+}
+
+template <class CharType, class CharTraits>
+basic_string<CharType, CharTraits>
+operator+(basic_string<CharType, CharTraits>&& lhs, CharType ch)
+{
+	lhs.push_back(ch);
+	return mystl::move(lhs);
+}
+
+// 重载比较操作符
+// 另一侧可以是 basic_string, const CharType* 或 basic_string_view, 都转为视图比较
+
+#define MYSTL_STRING_COMPARE_OP(OP)                                                           \
+template <class CharType, class CharTraits>                                                   \
+bool operator OP(const basic_string<CharType, CharTraits>& lhs,                               \
+                 const basic_string<CharType, CharTraits>& rhs) noexcept                      \
+{                                                                                             \
+	return basic_string_view<CharType, CharTraits>(lhs) OP                                    \
+		basic_string_view<CharType, CharTraits>(rhs);                                         \
+}                                                                                             \
+template <class CharType, class CharTraits>                                                   \
+bool operator OP(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)          \
+{                                                                                             \
+	return basic_string_view<CharType, CharTraits>(lhs) OP                                    \
+		basic_string_view<CharType, CharTraits>(rhs);                                         \
+}                                                                                             \
+template <class CharType, class CharTraits>                                                   \
+bool operator OP(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)          \
+{                                                                                             \
+	return basic_string_view<CharType, CharTraits>(lhs) OP                                    \
+		basic_string_view<CharType, CharTraits>(rhs);                                         \
+}                                                                                             \
+template <class CharType, class CharTraits>                                                   \
+bool operator OP(const basic_string<CharType, CharTraits>& lhs,                               \
+                 basic_string_view<CharType, CharTraits> rhs) noexcept                        \
+{                                                                                             \
+	return basic_string_view<CharType, CharTraits>(lhs) OP rhs;                               \
+}                                                                                             \
+template <class CharType, class CharTraits>                                                   \
+bool operator OP(basic_string_view<CharType, CharTraits> lhs,                                 \
+                 const basic_string<CharType, CharTraits>& rhs) noexcept                      \
+{                                                                                             \
+	return lhs OP basic_string_view<CharType, CharTraits>(rhs);                               \
+}
+
+MYSTL_STRING_COMPARE_OP(==)
+MYSTL_STRING_COMPARE_OP(!=)
+MYSTL_STRING_COMPARE_OP(<)
+MYSTL_STRING_COMPARE_OP(>)
+MYSTL_STRING_COMPARE_OP(<=)
+MYSTL_STRING_COMPARE_OP(>=)
+
+#undef MYSTL_STRING_COMPARE_OP
+
+// 重载 mystl 的 swap
+template <class CharType, class CharTraits>
+void swap(basic_string<CharType, CharTraits>& lhs,
+          basic_string<CharType, CharTraits>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 短串存放在对象内而不是用指针指向自身, 长串只持有堆上的指针, 都可以按字节转移
+template <class CharType, class CharTraits>
+struct is_trivially_relocatable<basic_string<CharType, CharTraits>> : m_true_type {};
+
+// 重载 operator>> / operator<<
+template <class CharType, class CharTraits>
+std::basic_istream<CharType>& operator>>(std::basic_istream<CharType>& is,
+                                         basic_string<CharType, CharTraits>& str)
+{
+	std::basic_string<CharType> tmp;
+	is >> tmp;
+	str.assign(tmp.data(), tmp.size());
+	return is;
+}
+
+template <class CharType, class CharTraits>
+std::basic_ostream<CharType>& operator<<(std::basic_ostream<CharType>& os,
+                                         const basic_string<CharType, CharTraits>& str)
+{
+	return os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+// 特化 mystl::hash
+// 与 basic_string_view 的哈希值相同, 定义了 is_transparent, 配合 equal_to<void> 可以用视图或 C 字符串查找
+template <class CharType, class CharTraits>
+struct hash<basic_string<CharType, CharTraits>>
+{
+	typedef void is_avalanching;
+	typedef void is_transparent;
+
+	size_t operator()(basic_string_view<CharType, CharTraits> v) const noexcept
+	{
+		return static_cast<size_t>(mystl::hash_bytes(v.data(), v.size() * sizeof(CharType)));
+	}
+};
+
+typedef mystl::basic_string<char>      string;
+typedef mystl::basic_string<wchar_t>   wstring;
+typedef mystl::basic_string<char16_t>  u16string;
+typedef mystl::basic_string<char32_t>  u32string;
+
+} // namespace mystl
+#endif // !MYTINYSTL_BASIC_STRING_H_
@@ -0,0 +1,1109 @@
+#ifndef MYTINYSTL_BITSET_H_
+#define MYTINYSTL_BITSET_H_
+
+// 这个头文件包含两个模板类 bitset 和 dynamic_bitset
+// bitset         : 位数在编译时确定的位集合
+// dynamic_bitset : 位数可以在运行时改变的位集合, 代替 mystl 不提供的 vector<bool>
+
+// notes:
+//
+// 两者都把位压缩存放在整数块(block)中, 第 i 位位于第 i / B 块的第 i % B 位(B 为块的位数),
+// 最后一块中超出 size() 的位始终为 0, 所以 count, ==, find_* 等可以直接按块处理
+// 按块进行的操作(bitset_detail):
+//   * & | ^ 与差集: 数据量不小于 kAvx2MinBytes 且 CPU 支持 AVX2 时每次处理 128 字节, 否则逐块处理
+//   * count: AVX2 使用 vpshufb 查表统计(Muła 算法), 否则使用 popcnt 指令; 都在运行时选择(见 cpu_features.h)
+//   * find_first / find_next: 跳过全 0 的块, 再用 tzcnt 取块中最低位的 1
+//   * 移位: 以块为单位整体移动, 再补上块内的位移
+//
+// 异常保证：
+// test, set(pos), reset(pos), flip(pos) 在 pos 越界时抛出 std::out_of_range, operator[] 不检查
+// mystl::dynamic_bitset<Block> 的 resize, push_back 满足强异常安全保证
+
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_features.h"
+#include "basic_string.h"
+#include "fuctional.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include "util.h"
+
+#if defined(__AVX2__) || defined(MYSTL_HAS_TARGET_DISPATCH)
+#include <immintrin.h>
+#define MYSTL_BITSET_AVX2 1
+#endif
+
+namespace mystl
+{
+
+namespace bitset_detail
+{
+
+// 不小于此字节数时才使用 AVX2
+constexpr size_t kAvx2MinBytes = 256;
+
+template <class Block>
+struct block_traits
+{
+	static_assert(std::is_unsigned<Block>::value && !std::is_same<Block, bool>::value,
+	              "bitset block must be an unsigned integer type");
+
+	static constexpr size_t bits = sizeof(Block) * 8;
+	static constexpr Block  ones = static_cast<Block>(~static_cast<Block>(0));
+};
+
+template <class Block>
+constexpr size_t block_traits<Block>::bits;
+template <class Block>
+constexpr Block block_traits<Block>::ones;
+
+// 块中 1 的个数
+template <class Block>
+inline unsigned popcount(Block x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return sizeof(Block) <= sizeof(unsigned)
+		? static_cast<unsigned>(__builtin_popcount(static_cast<unsigned>(x)))
+		: static_cast<unsigned>(__builtin_popcountll(static_cast<unsigned long long>(x)));
+#else
+	unsigned r = 0;
+	for (; x != 0; x &= static_cast<Block>(x - 1))
+		++r;
+	return r;
+#endif
+}
+
+// 块中最低位 1 的位置, 要求 x 不为 0
+template <class Block>
+inline unsigned ctz(Block x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return sizeof(Block) <= sizeof(unsigned)
+		? static_cast<unsigned>(__builtin_ctz(static_cast<unsigned>(x)))
+		: static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(x)));
+#else
+	unsigned r = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+// 数据量为 bytes 时是否使用 AVX2
+inline bool use_avx2(size_t bytes) noexcept
+{
+#if defined(__AVX2__)
+	return bytes >= kAvx2MinBytes;
+#elif defined(MYSTL_HAS_TARGET_DISPATCH)
+	return bytes >= kAvx2MinBytes && get_cpu_features().avx2;
+#else
+	(void)bytes;
+	return false;
+#endif
+}
+
+// 按块运算, 每种运算同时提供标量与 AVX2 两个版本
+
+struct and_op
+{
+	template <class Block>
+	static Block apply(Block a, Block b) noexcept { return static_cast<Block>(a & b); }
+#if defined(MYSTL_BITSET_AVX2)
+	MYSTL_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_and_si256(a, b); }
+#endif
+};
+
+struct or_op
+{
+	template <class Block>
+	static Block apply(Block a, Block b) noexcept { return static_cast<Block>(a | b); }
+#if defined(MYSTL_BITSET_AVX2)
+	MYSTL_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct xor_op
+{
+	template <class Block>
+	static Block apply(Block a, Block b) noexcept { return static_cast<Block>(a ^ b); }
+#if defined(MYSTL_BITSET_AVX2)
+	MYSTL_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_xor_si256(a, b); }
+#endif
+};
+
+// a & ~b
+struct andnot_op
+{
+	template <class Block>
+	static Block apply(Block a, Block b) noexcept { return static_cast<Block>(a & ~b); }
+#if defined(MYSTL_BITSET_AVX2)
+	MYSTL_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_andnot_si256(b, a); }
+#endif
+};
+
+#if defined(MYSTL_BITSET_AVX2)
+
+// dst[i] = Op(dst[i], src[i]), 每次处理 4 个 32 字节的向量
+template <class Op, class Block>
+MYSTL_TARGET_AVX2 void apply_avx2(Block* dst, const Block* src, size_t n) noexcept
+{
+	unsigned char* d = reinterpret_cast<unsigned char*>(dst);
+	const unsigned char* s = reinterpret_cast<const unsigned char*>(src);
+	const size_t bytes = n * sizeof(Block);
+	size_t i = 0;
+	for (; i + 128 <= bytes; i += 128)
+	{
+		const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+		const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + 32));
+		const __m256i a2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + 64));
+		const __m256i a3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + 96));
+		const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+		const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 32));
+		const __m256i b2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 64));
+		const __m256i b3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 96));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), Op::apply(a0, b0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 32), Op::apply(a1, b1));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 64), Op::apply(a2, b2));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 96), Op::apply(a3, b3));
+	}
+	for (; i + 32 <= bytes; i += 32)
+	{
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), Op::apply(a, b));
+	}
+	for (size_t k = i / sizeof(Block); k < n; ++k)
+		dst[k] = Op::apply(dst[k], src[k]);
+}
+
+// 统计 [p, p + bytes) 中 32 字节整数倍部分的 1 的个数, 对每个半字节查表, 再用 vpsadbw 累加
+MYSTL_TARGET_AVX2 inline size_t popcount_avx2(const unsigned char* p, size_t bytes) noexcept
+{
+	const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	                                        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low_mask = _mm256_set1_epi8(0x0f);
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc = zero;
+	for (size_t i = 0; i + 32 <= bytes; i += 32)
+	{
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		const __m256i lo = _mm256_and_si256(v, low_mask);
+		const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+		const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+		acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, zero));
+	}
+	return static_cast<size_t>(_mm256_extract_epi64(acc, 0)) + static_cast<size_t>(_mm256_extract_epi64(acc, 1)) +
+	       static_cast<size_t>(_mm256_extract_epi64(acc, 2)) + static_cast<size_t>(_mm256_extract_epi64(acc, 3));
+}
+
+#endif // MYSTL_BITSET_AVX2
+
+#if defined(MYSTL_HAS_TARGET_DISPATCH) && !defined(__POPCNT__)
+// 编译时未开启 popcnt 时, 单独为这个函数开启
+template <class Block>
+MYSTL_TARGET_POPCNT size_t count_popcnt(const Block* p, size_t n) noexcept
+{
+	size_t r = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		r += sizeof(Block) <= sizeof(unsigned)
+			? static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(p[i])))
+			: static_cast<size_t>(__builtin_popcountll(static_cast<unsigned long long>(p[i])));
+	}
+	return r;
+}
+#endif
+
+// dst[i] = Op(dst[i], src[i]), i < n
+template <class Op, class Block>
+void apply(Block* dst, const Block* src, size_t n) noexcept
+{
+#if defined(MYSTL_BITSET_AVX2)
+	if (use_avx2(n * sizeof(Block)))
+	{
+		apply_avx2<Op>(dst, src, n);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = Op::apply(dst[i], src[i]);
+}
+
+// 取反前 n 块
+template <class Block>
+void flip_all(Block* dst, size_t n) noexcept
+{
+	for (size_t i = 0; i < n; ++i)
+		dst[i] = static_cast<Block>(~dst[i]);
+}
+
+// 前 n 块中 1 的个数
+template <class Block>
+size_t count(const Block* p, size_t n) noexcept
+{
+	size_t r = 0;
+	size_t i = 0;
+#if defined(MYSTL_BITSET_AVX2)
+	const size_t bytes = n * sizeof(Block);
+	if (use_avx2(bytes))
+	{
+		const size_t done = bytes & ~static_cast<size_t>(31);
+		r = popcount_avx2(reinterpret_cast<const unsigned char*>(p), done);
+		i = done / sizeof(Block);
+	}
+#endif
+#if defined(MYSTL_HAS_TARGET_DISPATCH) && !defined(__POPCNT__)
+	if (get_cpu_features().popcnt)
+		return r + count_popcnt(p + i, n - i);
+#endif
+	for (; i < n; ++i)
+		r += popcount(p[i]);
+	return r;
+}
+
+// 两段块是否相同
+template <class Block>
+bool equal(const Block* a, const Block* b, size_t n) noexcept
+{
+	return n == 0 || std::memcmp(a, b, n * sizeof(Block)) == 0;
+}
+
+// 是否存在 i 使 a[i] & b[i] 不为 0
+template <class Block>
+bool intersects(const Block* a, const Block* b, size_t n) noexcept
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		if ((a[i] & b[i]) != 0)
+			return true;
+	}
+	return false;
+}
+
+// a 中的 1 是否都在 b 中
+template <class Block>
+bool is_subset_of(const Block* a, const Block* b, size_t n) noexcept
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		if ((a[i] & ~b[i]) != 0)
+			return false;
+	}
+	return true;
+}
+
+// 从第 pos 位开始找第一个 1, 找不到时返回 npos
+template <class Block>
+size_t find_from(const Block* w, size_t nblocks, size_t pos) noexcept
+{
+	typedef block_traits<Block> traits;
+	size_t i = pos / traits::bits;
+	if (i >= nblocks)
+		return static_cast<size_t>(-1);
+	Block x = static_cast<Block>(w[i] & static_cast<Block>(traits::ones << (pos % traits::bits)));
+	while (x == 0)
+	{
+		if (++i == nblocks)
+			return static_cast<size_t>(-1);
+		x = w[i];
+	}
+	return i * traits::bits + ctz(x);
+}
+
+// 整体向高位移动 n 位, 移出的位丢弃, 低位补 0
+template <class Block>
+void shift_left(Block* w, size_t nblocks, size_t n) noexcept
+{
+	typedef block_traits<Block> traits;
+	const size_t shift_blocks = n / traits::bits;
+	const size_t shift_bits = n % traits::bits;
+	if (shift_blocks >= nblocks)
+	{
+		for (size_t i = 0; i < nblocks; ++i)
+			w[i] = 0;
+		return;
+	}
+	if (shift_bits == 0)
+	{
+		for (size_t i = nblocks - 1; i >= shift_blocks && i != static_cast<size_t>(-1); --i)
+			w[i] = w[i - shift_blocks];
+	}
+	else
+	{
+		for (size_t i = nblocks - 1; i > shift_blocks; --i)
+		{
+			w[i] = static_cast<Block>((w[i - shift_blocks] << shift_bits) |
+			                          (w[i - shift_blocks - 1] >> (traits::bits - shift_bits)));
+		}
+		w[shift_blocks] = static_cast<Block>(w[0] << shift_bits);
+	}
+	for (size_t i = 0; i < shift_blocks; ++i)
+		w[i] = 0;
+}
+
+// 整体向低位移动 n 位, 移出的位丢弃, 高位补 0
+template <class Block>
+void shift_right(Block* w, size_t nblocks, size_t n) noexcept
+{
+	typedef block_traits<Block> traits;
+	const size_t shift_blocks = n / traits::bits;
+	const size_t shift_bits = n % traits::bits;
+	if (shift_blocks >= nblocks)
+	{
+		for (size_t i = 0; i < nblocks; ++i)
+			w[i] = 0;
+		return;
+	}
+	const size_t last = nblocks - shift_blocks - 1;
+	if (shift_bits == 0)
+	{
+		for (size_t i = 0; i <= last; ++i)
+			w[i] = w[i + shift_blocks];
+	}
+	else
+	{
+		for (size_t i = 0; i < last; ++i)
+		{
+			w[i] = static_cast<Block>((w[i + shift_blocks] >> shift_bits) |
+			                          (w[i + shift_blocks + 1] << (traits::bits - shift_bits)));
+		}
+		w[last] = static_cast<Block>(w[nblocks - 1] >> shift_bits);
+	}
+	for (size_t i = last + 1; i < nblocks; ++i)
+		w[i] = 0;
+}
+
+// 把 [first, last) 位设为 value
+template <class Block>
+void set_range(Block* w, size_t first, size_t last, bool value) noexcept
+{
+	typedef block_traits<Block> traits;
+	if (first >= last)
+		return;
+	size_t fb = first / traits::bits;
+	const size_t lb = (last - 1) / traits::bits;
+	const Block head = static_cast<Block>(traits::ones << (first % traits::bits));
+	const Block tail = static_cast<Block>(traits::ones >> (traits::bits - 1 - (last - 1) % traits::bits));
+	if (fb == lb)
+	{
+		const Block m = static_cast<Block>(head & tail);
+		w[fb] = value ? static_cast<Block>(w[fb] | m) : static_cast<Block>(w[fb] & ~m);
+		return;
+	}
+	w[fb] = value ? static_cast<Block>(w[fb] | head) : static_cast<Block>(w[fb] & ~head);
+	for (++fb; fb < lb; ++fb)
+		w[fb] = value ? traits::ones : Block(0);
+	w[lb] = value ? static_cast<Block>(w[lb] | tail) : static_cast<Block>(w[lb] & ~tail);
+}
+
+// 最后一块中有效位的掩码
+template <class Block>
+Block last_block_mask(size_t nbits) noexcept
+{
+	typedef block_traits<Block> traits;
+	const size_t r = nbits % traits::bits;
+	return r == 0 ? traits::ones : static_cast<Block>(traits::ones >> (traits::bits - r));
+}
+
+// 单个位的引用, 用于 operator[]
+template <class Block>
+class bit_reference
+{
+private:
+	Block* block_;
+	Block  mask_;
+
+public:
+	bit_reference(Block* block, size_t bit) noexcept
+		:block_(block), mask_(static_cast<Block>(Block(1) << bit))
+	{
+	}
+
+	bit_reference(const bit_reference&) = default;
+
+	bit_reference& operator=(bool value) noexcept
+	{
+		if (value)
+			*block_ = static_cast<Block>(*block_ | mask_);
+		else
+			*block_ = static_cast<Block>(*block_ & ~mask_);
+		return *this;
+	}
+
+	bit_reference& operator=(const bit_reference& rhs) noexcept
+	{
+		return *this = static_cast<bool>(rhs);
+	}
+
+	operator bool() const noexcept { return (*block_ & mask_) != 0; }
+	bool operator~() const noexcept { return (*block_ & mask_) == 0; }
+
+	bit_reference& flip() noexcept
+	{
+		*block_ = static_cast<Block>(*block_ ^ mask_);
+		return *this;
+	}
+};
+
+} // namespace bitset_detail
+
+/*****************************************************************************************/
+// bitset
+// 模板参数 N 代表位数
+/*****************************************************************************************/
+
+template <size_t N>
+class bitset
+{
+public:
+	typedef uint64_t                                block_type;
+	typedef size_t                                  size_type;
+	typedef bitset_detail::bit_reference<block_type> reference;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+	static constexpr size_type kBlockBits = 64;
+	static constexpr size_type kBlocks = N == 0 ? 1 : (N + kBlockBits - 1) / kBlockBits;
+
+private:
+	block_type w_[kBlocks];
+
+public:
+	// 构造函数
+	bitset() noexcept
+	{
+		reset();
+	}
+
+	bitset(unsigned long long value) noexcept
+	{
+		reset();
+		w_[0] = static_cast<block_type>(value);
+		trim();
+	}
+
+	// 访问元素相关操作
+	bool operator[](size_type pos) const noexcept
+	{
+		MYSTL_DEBUG(pos < N);
+		return (w_[pos / kBlockBits] >> (pos % kBlockBits)) & 1;
+	}
+
+	reference operator[](size_type pos) noexcept
+	{
+		MYSTL_DEBUG(pos < N);
+		return reference(w_ + pos / kBlockBits, pos % kBlockBits);
+	}
+
+	bool test(size_type pos) const
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N>::test's pos out of range");
+		return (*this)[pos];
+	}
+
+	// 容量相关操作
+	constexpr size_type size() const noexcept { return N; }
+
+	size_type count() const noexcept { return bitset_detail::count(w_, kBlocks); }
+
+	bool all() const noexcept
+	{
+		for (size_type i = 0; i + 1 < kBlocks; ++i)
+		{
+			if (w_[i] != bitset_detail::block_traits<block_type>::ones)
+				return false;
+		}
+		return N == 0 || w_[kBlocks - 1] == bitset_detail::last_block_mask<block_type>(N);
+	}
+
+	bool any() const noexcept
+	{
+		for (size_type i = 0; i < kBlocks; ++i)
+		{
+			if (w_[i] != 0)
+				return true;
+		}
+		return false;
+	}
+
+	bool none() const noexcept { return !any(); }
+
+	// 查找: 第一个 1, pos 之后的第一个 1, 不存在时返回 npos
+	size_type find_first() const noexcept
+	{ return bitset_detail::find_from(w_, kBlocks, 0); }
+	size_type find_next(size_type pos) const noexcept
+	{ return pos + 1 >= N ? npos : bitset_detail::find_from(w_, kBlocks, pos + 1); }
+
+	// 修改相关操作
+	bitset& set() noexcept
+	{
+		for (size_type i = 0; i < kBlocks; ++i)
+			w_[i] = bitset_detail::block_traits<block_type>::ones;
+		trim();
+		return *this;
+	}
+
+	bitset& set(size_type pos, bool value = true)
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N>::set's pos out of range");
+		(*this)[pos] = value;
+		return *this;
+	}
+
+	bitset& reset() noexcept
+	{
+		for (size_type i = 0; i < kBlocks; ++i)
+			w_[i] = 0;
+		return *this;
+	}
+
+	bitset& reset(size_type pos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N>::reset's pos out of range");
+		(*this)[pos] = false;
+		return *this;
+	}
+
+	bitset& flip() noexcept
+	{
+		bitset_detail::flip_all(w_, kBlocks);
+		trim();
+		return *this;
+	}
+
+	bitset& flip(size_type pos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= N, "bitset<N>::flip's pos out of range");
+		(*this)[pos].flip();
+		return *this;
+	}
+
+	// 位运算
+	bitset& operator&=(const bitset& rhs) noexcept
+	{
+		bitset_detail::apply<bitset_detail::and_op>(w_, rhs.w_, kBlocks);
+		return *this;
+	}
+
+	bitset& operator|=(const bitset& rhs) noexcept
+	{
+		bitset_detail::apply<bitset_detail::or_op>(w_, rhs.w_, kBlocks);
+		return *this;
+	}
+
+	bitset& operator^=(const bitset& rhs) noexcept
+	{
+		bitset_detail::apply<bitset_detail::xor_op>(w_, rhs.w_, kBlocks);
+		return *this;
+	}
+
+	// 差集: *this & ~rhs
+	bitset& operator-=(const bitset& rhs) noexcept
+	{
+		bitset_detail::apply<bitset_detail::andnot_op>(w_, rhs.w_, kBlocks);
+		return *this;
+	}
+
+	bitset& operator<<=(size_type n) noexcept
+	{
+		bitset_detail::shift_left(w_, kBlocks, n);
+		trim();
+		return *this;
+	}
+
+	bitset& operator>>=(size_type n) noexcept
+	{
+		bitset_detail::shift_right(w_, kBlocks, n);
+		return *this;
+	}
+
+	bitset operator~() const noexcept
+	{
+		bitset tmp(*this);
+		return tmp.flip();
+	}
+
+	bitset operator<<(size_type n) const noexcept
+	{
+		bitset tmp(*this);
+		return tmp <<= n;
+	}
+
+	bitset operator>>(size_type n) const noexcept
+	{
+		bitset tmp(*this);
+		return tmp >>= n;
+	}
+
+	bool operator==(const bitset& rhs) const noexcept
+	{ return bitset_detail::equal(w_, rhs.w_, kBlocks); }
+	bool operator!=(const bitset& rhs) const noexcept
+	{ return !(*this == rhs); }
+
+	bool intersects(const bitset& rhs) const noexcept
+	{ return bitset_detail::intersects(w_, rhs.w_, kBlocks); }
+	bool is_subset_of(const bitset& rhs) const noexcept
+	{ return bitset_detail::is_subset_of(w_, rhs.w_, kBlocks); }
+
+	// 转换
+	unsigned long long to_ullong() const
+	{
+		for (size_type i = 1; i < kBlocks; ++i)
+		{
+			THROW_RUNTIME_ERROR_IF(w_[i] != 0, "bitset<N>::to_ullong overflow");
+		}
+		return static_cast<unsigned long long>(w_[0]);
+	}
+
+	unsigned long to_ulong() const
+	{
+		const unsigned long long v = to_ullong();
+		THROW_RUNTIME_ERROR_IF(v > static_cast<unsigned long>(-1), "bitset<N>::to_ulong overflow");
+		return static_cast<unsigned long>(v);
+	}
+
+	// 高位在前
+	mystl::string to_string(char zero = '0', char one = '1') const
+	{
+		mystl::string s(N, zero);
+		for (size_type i = find_first(); i != npos; i = find_next(i))
+			s[N - 1 - i] = one;
+		return s;
+	}
+
+	const block_type* data() const noexcept { return w_; }
+	constexpr size_type num_blocks() const noexcept { return kBlocks; }
+
+private:
+	// 清除超出 N 的位
+	void trim() noexcept
+	{
+		w_[kBlocks - 1] &= N == 0 ? block_type(0) : bitset_detail::last_block_mask<block_type>(N);
+	}
+};
+
+template <size_t N>
+constexpr typename bitset<N>::size_type bitset<N>::npos;
+template <size_t N>
+constexpr typename bitset<N>::size_type bitset<N>::kBlockBits;
+template <size_t N>
+constexpr typename bitset<N>::size_type bitset<N>::kBlocks;
+
+template <size_t N>
+bitset<N> operator&(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+{
+	bitset<N> tmp(lhs);
+	return tmp &= rhs;
+}
+
+template <size_t N>
+bitset<N> operator|(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+{
+	bitset<N> tmp(lhs);
+	return tmp |= rhs;
+}
+
+template <size_t N>
+bitset<N> operator^(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+{
+	bitset<N> tmp(lhs);
+	return tmp ^= rhs;
+}
+
+template <size_t N>
+bitset<N> operator-(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+{
+	bitset<N> tmp(lhs);
+	return tmp -= rhs;
+}
+
+template <size_t N>
+struct hash<bitset<N>>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(const bitset<N>& b) const noexcept
+	{
+		return static_cast<size_t>(mystl::hash_bytes(b.data(), b.num_blocks() * sizeof(uint64_t)));
+	}
+};
+
+/*****************************************************************************************/
+// dynamic_bitset
+// 模板参数 Block 代表存放位的无符号整数类型
+/*****************************************************************************************/
+
+template <class Block = uint64_t>
+class dynamic_bitset
+{
+	typedef bitset_detail::block_traits<Block> traits;
+
+public:
+	typedef Block                               block_type;
+	typedef size_t                              size_type;
+	typedef bitset_detail::bit_reference<Block> reference;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+	static constexpr size_type kBlockBits = traits::bits;
+
+private:
+	mystl::vector<Block> blocks_;
+	size_type            size_;   // 位数
+
+public:
+	// 构造、复制、移动、析构函数
+	dynamic_bitset() noexcept
+		:size_(0)
+	{
+	}
+
+	explicit dynamic_bitset(size_type n, bool value = false)
+		:blocks_(blocks_for(n), value ? traits::ones : Block(0)), size_(n)
+	{
+		trim();
+	}
+
+	dynamic_bitset(const dynamic_bitset&) = default;
+	dynamic_bitset& operator=(const dynamic_bitset&) = default;
+
+	dynamic_bitset(dynamic_bitset&& rhs) noexcept
+		:blocks_(mystl::move(rhs.blocks_)), size_(rhs.size_)
+	{
+		rhs.size_ = 0;
+	}
+
+	dynamic_bitset& operator=(dynamic_bitset&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			blocks_ = mystl::move(rhs.blocks_);
+			size_ = rhs.size_;
+			rhs.size_ = 0;
+		}
+		return *this;
+	}
+
+	// 访问元素相关操作
+	bool operator[](size_type pos) const noexcept
+	{
+		MYSTL_DEBUG(pos < size_);
+		return (blocks_[pos / kBlockBits] >> (pos % kBlockBits)) & 1;
+	}
+
+	reference operator[](size_type pos) noexcept
+	{
+		MYSTL_DEBUG(pos < size_);
+		return reference(blocks_.data() + pos / kBlockBits, pos % kBlockBits);
+	}
+
+	bool test(size_type pos) const
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset<Block>::test's pos out of range");
+		return (*this)[pos];
+	}
+
+	// 容量相关操作
+	size_type size()       const noexcept { return size_; }
+	bool      empty()      const noexcept { return size_ == 0; }
+	size_type num_blocks() const noexcept { return blocks_.size(); }
+	size_type capacity()   const noexcept { return blocks_.capacity() * kBlockBits; }
+
+	void reserve(size_type n)
+	{ blocks_.reserve(blocks_for(n)); }
+
+	void shrink_to_fit()
+	{ blocks_.shrink_to_fit(); }
+
+	size_type count() const noexcept
+	{ return bitset_detail::count(blocks_.data(), blocks_.size()); }
+
+	bool all() const noexcept
+	{
+		const size_type nb = blocks_.size();
+		for (size_type i = 0; i + 1 < nb; ++i)
+		{
+			if (blocks_[i] != traits::ones)
+				return false;
+		}
+		return nb == 0 || blocks_[nb - 1] == bitset_detail::last_block_mask<Block>(size_);
+	}
+
+	bool any() const noexcept
+	{
+		for (size_type i = 0; i < blocks_.size(); ++i)
+		{
+			if (blocks_[i] != 0)
+				return true;
+		}
+		return false;
+	}
+
+	bool none() const noexcept { return !any(); }
+
+	// 查找: 第一个 1, pos 之后的第一个 1, 不存在时返回 npos
+	size_type find_first() const noexcept
+	{ return bitset_detail::find_from(blocks_.data(), blocks_.size(), 0); }
+	size_type find_next(size_type pos) const noexcept
+	{ return pos + 1 >= size_ ? npos : bitset_detail::find_from(blocks_.data(), blocks_.size(), pos + 1); }
+
+	// 修改容器相关操作
+	void resize(size_type n, bool value = false);
+
+	void push_back(bool value)
+	{
+		if (size_ % kBlockBits == 0)
+			blocks_.push_back(Block(0));
+		++size_;
+		(*this)[size_ - 1] = value;
+	}
+
+	void pop_back() noexcept
+	{
+		MYSTL_DEBUG(size_ != 0);
+		--size_;
+		if (size_ % kBlockBits == 0)
+			blocks_.pop_back();
+		else
+			trim();
+	}
+
+	void clear() noexcept
+	{
+		blocks_.clear();
+		size_ = 0;
+	}
+
+	dynamic_bitset& set() noexcept
+	{
+		for (size_type i = 0; i < blocks_.size(); ++i)
+			blocks_[i] = traits::ones;
+		trim();
+		return *this;
+	}
+
+	dynamic_bitset& set(size_type pos, bool value = true)
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset<Block>::set's pos out of range");
+		(*this)[pos] = value;
+		return *this;
+	}
+
+	// 把 [pos, pos + len) 位设为 value
+	dynamic_bitset& set(size_type pos, size_type len, bool value)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size_ || len > size_ - pos,
+		                      "dynamic_bitset<Block>::set's range out of range");
+		bitset_detail::set_range(blocks_.data(), pos, pos + len, value);
+		return *this;
+	}
+
+	dynamic_bitset& reset() noexcept
+	{
+		for (size_type i = 0; i < blocks_.size(); ++i)
+			blocks_[i] = 0;
+		return *this;
+	}
+
+	dynamic_bitset& reset(size_type pos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset<Block>::reset's pos out of range");
+		(*this)[pos] = false;
+		return *this;
+	}
+
+	dynamic_bitset& flip() noexcept
+	{
+		bitset_detail::flip_all(blocks_.data(), blocks_.size());
+		trim();
+		return *this;
+	}
+
+	dynamic_bitset& flip(size_type pos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset<Block>::flip's pos out of range");
+		(*this)[pos].flip();
+		return *this;
+	}
+
+	// 位运算, 要求两者位数相同
+	dynamic_bitset& operator&=(const dynamic_bitset& rhs) noexcept
+	{
+		MYSTL_DEBUG(size_ == rhs.size_);
+		bitset_detail::apply<bitset_detail::and_op>(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+		return *this;
+	}
+
+	dynamic_bitset& operator|=(const dynamic_bitset& rhs) noexcept
+	{
+		MYSTL_DEBUG(size_ == rhs.size_);
+		bitset_detail::apply<bitset_detail::or_op>(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+		return *this;
+	}
+
+	dynamic_bitset& operator^=(const dynamic_bitset& rhs) noexcept
+	{
+		MYSTL_DEBUG(size_ == rhs.size_);
+		bitset_detail::apply<bitset_detail::xor_op>(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+		return *this;
+	}
+
+	// 差集: *this & ~rhs
+	dynamic_bitset& operator-=(const dynamic_bitset& rhs) noexcept
+	{
+		MYSTL_DEBUG(size_ == rhs.size_);
+		bitset_detail::apply<bitset_detail::andnot_op>(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+		return *this;
+	}
+
+	dynamic_bitset& operator<<=(size_type n) noexcept
+	{
+		bitset_detail::shift_left(blocks_.data(), blocks_.size(), n);
+		trim();
+		return *this;
+	}
+
+	dynamic_bitset& operator>>=(size_type n) noexcept
+	{
+		bitset_detail::shift_right(blocks_.data(), blocks_.size(), n);
+		return *this;
+	}
+
+	dynamic_bitset operator~() const
+	{
+		dynamic_bitset tmp(*this);
+		return mystl::move(tmp.flip());
+	}
+
+	dynamic_bitset operator<<(size_type n) const
+	{
+		dynamic_bitset tmp(*this);
+		tmp <<= n;
+		return tmp;
+	}
+
+	dynamic_bitset operator>>(size_type n) const
+	{
+		dynamic_bitset tmp(*this);
+		tmp >>= n;
+		return tmp;
+	}
+
+	bool operator==(const dynamic_bitset& rhs) const noexcept
+	{
+		return size_ == rhs.size_ &&
+		       bitset_detail::equal(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+	}
+	bool operator!=(const dynamic_bitset& rhs) const noexcept
+	{ return !(*this == rhs); }
+
+	bool intersects(const dynamic_bitset& rhs) const noexcept
+	{
+		MYSTL_DEBUG(size_ == rhs.size_);
+		return bitset_detail::intersects(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+	}
+
+	bool is_subset_of(const dynamic_bitset& rhs) const noexcept
+	{
+		MYSTL_DEBUG(size_ == rhs.size_);
+		return bitset_detail::is_subset_of(blocks_.data(), rhs.blocks_.data(), blocks_.size());
+	}
+
+	// 高位在前
+	mystl::string to_string(char zero = '0', char one = '1') const
+	{
+		mystl::string s(size_, zero);
+		for (size_type i = find_first(); i != npos; i = find_next(i))
+			s[size_ - 1 - i] = one;
+		return s;
+	}
+
+	Block*       data()       noexcept { return blocks_.data(); }
+	const Block* data() const noexcept { return blocks_.data(); }
+
+	void swap(dynamic_bitset& rhs) noexcept
+	{
+		blocks_.swap(rhs.blocks_);
+		mystl::swap(size_, rhs.size_);
+	}
+
+private:
+	static size_type blocks_for(size_type n) noexcept
+	{ return (n + kBlockBits - 1) / kBlockBits; }
+
+	// 清除超出 size_ 的位
+	void trim() noexcept
+	{
+		if (size_ % kBlockBits != 0)
+			blocks_.back() &= bitset_detail::last_block_mask<Block>(size_);
+	}
+};
+
+template <class Block>
+constexpr typename dynamic_bitset<Block>::size_type dynamic_bitset<Block>::npos;
+template <class Block>
+constexpr typename dynamic_bitset<Block>::size_type dynamic_bitset<Block>::kBlockBits;
+
+// 改变位数, 新增的位为 value
+template <class Block>
+void dynamic_bitset<Block>::resize(size_type n, bool value)
+{
+	const size_type old = size_;
+	blocks_.resize(blocks_for(n), value ? traits::ones : Block(0));
+	size_ = n;
+	if (value && n > old)
+		bitset_detail::set_range(blocks_.data(), old, mystl::min(n, blocks_for(old) * kBlockBits), true);
+	trim();
+}
+
+template <class Block>
+dynamic_bitset<Block> operator&(const dynamic_bitset<Block>& lhs, const dynamic_bitset<Block>& rhs)
+{
+	dynamic_bitset<Block> tmp(lhs);
+	tmp &= rhs;
+	return tmp;
+}
+
+template <class Block>
+dynamic_bitset<Block> operator|(const dynamic_bitset<Block>& lhs, const dynamic_bitset<Block>& rhs)
+{
+	dynamic_bitset<Block> tmp(lhs);
+	tmp |= rhs;
+	return tmp;
+}
+
+template <class Block>
+dynamic_bitset<Block> operator^(const dynamic_bitset<Block>& lhs, const dynamic_bitset<Block>& rhs)
+{
+	dynamic_bitset<Block> tmp(lhs);
+	tmp ^= rhs;
+	return tmp;
+}
+
+template <class Block>
+dynamic_bitset<Block> operator-(const dynamic_bitset<Block>& lhs, const dynamic_bitset<Block>& rhs)
+{
+	dynamic_bitset<Block> tmp(lhs);
+	tmp -= rhs;
+	return tmp;
+}
+
+// 重载 mystl 的 swap
+template <class Block>
+void swap(dynamic_bitset<Block>& lhs, dynamic_bitset<Block>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+template <class Block>
+struct hash<dynamic_bitset<Block>>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(const dynamic_bitset<Block>& b) const noexcept
+	{
+		return static_cast<size_t>(mystl::hash_bytes(b.data(), b.num_blocks() * sizeof(Block), b.size()));
+	}
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_BITSET_H_
@@ -0,0 +1,1317 @@
+#ifndef MYTINYSTL_BTREE_H_
+#define MYTINYSTL_BTREE_H_
+
+// 这个头文件包含一个模板类 btree
+// btree : B 树, 用作 btree_map / btree_set 等有序关联容器的底层机制
+
+// notes:
+//
+// 与红黑树相比, B 树每个节点存放多个元素, 节点大小约为 MYSTL_BTREE_NODE_BYTES 字节(若干个缓存行):
+//   * 节点内的键连续存放(映射值存放在同一节点的另一个数组中), 查找时每层只访问一个节点,
+//     树高约为红黑树的 1/4 到 1/5, 指针追逐少得多
+//   * 算术类型的键配合 less / greater 在节点内做无分支的线性计数(编译器可自动向量化),
+//     其余类型在节点内做无分支的二分查找
+//   * 所有节点从容器自己的 node_pool 中分配, 节点按缓存行对齐并且集中在少数几块内存中
+//   * 绝大多数元素位于叶子节点, 遍历时在叶子内部只是下标加一, 接近数组遍历的速度
+//   * 有序输入(区间构造、insert_range 中追加到末尾的部分)总是插入到最右叶子的末尾, 节点分裂时
+//     偏向保留满节点, 相当于自底向上的批量构建, 每个元素均摊 O(1)
+//
+// 元素在节点之间移动时使用移动构造, 要求键与映射值的移动构造不抛出异常
+// 插入与删除会使所有迭代器失效(元素可能被移动到别的节点)
+
+#include <cstdint>
+#include <new>
+
+#include "node_pool.h"
+#include "algo.h"
+#include "vector.h"
+#include "fuctional.h"
+#include "iterator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "type_traits.h"
+#include "tuple.h"
+
+namespace mystl
+{
+
+// 节点的目标大小, 包含节点头部
+#ifndef MYSTL_BTREE_NODE_BYTES
+#define MYSTL_BTREE_NODE_BYTES 256
+#endif // !MYSTL_BTREE_NODE_BYTES
+
+/*****************************************************************************************/
+// 节点
+// 叶子节点: 父指针、在父节点中的下标、元素个数, 以及键数组与映射值数组(btree_set 没有映射值)
+// 内部节点: 在叶子节点之后多出 kSlots + 1 个孩子指针
+/*****************************************************************************************/
+
+// 映射值数组, 第 i 个映射值与第 i 个键对应
+template <class T, size_t N>
+struct btree_value_array
+{
+	alignas(T) unsigned char value_buf[N * sizeof(T)];
+
+	T*       values()       noexcept { return reinterpret_cast<T*>(value_buf); }
+	const T* values() const noexcept { return reinterpret_cast<const T*>(value_buf); }
+
+	template <class ...Args>
+	void construct_value(size_t i, Args&& ...args)
+	{ mystl::construct(values() + i, mystl::forward<Args>(args)...); }
+
+	void destroy_value(size_t i) noexcept
+	{ mystl::destroy(values() + i); }
+
+	void transfer_value(size_t i, btree_value_array& src, size_t j) noexcept
+	{
+		mystl::construct(values() + i, mystl::move(src.values()[j]));
+		mystl::destroy(src.values() + j);
+	}
+};
+
+// btree_set 没有映射值, 作为空基类不占空间
+template <size_t N>
+struct btree_value_array<void, N>
+{
+	void construct_value(size_t) noexcept {}
+	void destroy_value(size_t) noexcept {}
+	void transfer_value(size_t, btree_value_array&, size_t) noexcept {}
+};
+
+template <class T>
+struct btree_value_size : mystl::m_integral_constant<size_t, sizeof(T)> {};
+
+template <>
+struct btree_value_size<void> : mystl::m_integral_constant<size_t, 0> {};
+
+// 每个节点的元素个数: 节点大小接近 MYSTL_BTREE_NODE_BYTES, 至少为 4 个
+template <class Key, class T>
+struct btree_node_slots
+{
+	static constexpr size_t kHeaderBytes = sizeof(void*) + 8;
+	static constexpr size_t kFit = (MYSTL_BTREE_NODE_BYTES - kHeaderBytes)
+		/ (sizeof(Key) + btree_value_size<T>::value);
+	static constexpr size_t value = kFit < 4 ? 4 : (kFit > 255 ? 255 : kFit);
+};
+
+template <class Key, class T, size_t N>
+struct btree_node : public btree_value_array<T, N>
+{
+	static constexpr size_t kSlots = N;
+
+	btree_node* parent;    // 父节点, 根节点为 nullptr
+	uint16_t    position;  // 在父节点孩子数组中的下标
+	uint16_t    count;     // 元素个数
+	bool        leaf;      // 是否为叶子节点
+	alignas(Key) unsigned char key_buf[N * sizeof(Key)];
+
+	Key*       keys()       noexcept { return reinterpret_cast<Key*>(key_buf); }
+	const Key* keys() const noexcept { return reinterpret_cast<const Key*>(key_buf); }
+
+	// 第 i 个孩子, 只能对内部节点调用
+	btree_node*& child(size_t i) noexcept;
+
+	// 在第 i 个位置构造元素, 映射值构造失败时析构已构造的键
+	template <class K, class ...Args>
+	void construct_slot(size_t i, K&& key, Args&& ...args)
+	{
+		mystl::construct(keys() + i, mystl::forward<K>(key));
+		MYSTL_TRY
+		{
+			this->construct_value(i, mystl::forward<Args>(args)...);
+		}
+		MYSTL_CATCH_ALL
+		{
+			mystl::destroy(keys() + i);
+			MYSTL_RETHROW;
+		}
+	}
+
+	void destroy_slot(size_t i) noexcept
+	{
+		mystl::destroy(keys() + i);
+		this->destroy_value(i);
+	}
+
+	// 把 src 的第 j 个元素移动到本节点的第 i 个位置, 并析构 src 中的元素
+	void transfer(size_t i, btree_node* src, size_t j) noexcept
+	{
+		mystl::construct(keys() + i, mystl::move(src->keys()[j]));
+		mystl::destroy(src->keys() + j);
+		this->transfer_value(i, *src, j);
+	}
+};
+
+template <class Key, class T, size_t N>
+constexpr size_t btree_node<Key, T, N>::kSlots;
+
+template <class Key, class T, size_t N>
+struct btree_internal_node : public btree_node<Key, T, N>
+{
+	btree_node<Key, T, N>* children[N + 1];
+};
+
+template <class Key, class T, size_t N>
+btree_node<Key, T, N>*& btree_node<Key, T, N>::child(size_t i) noexcept
+{
+	return static_cast<btree_internal_node<Key, T, N>*>(this)->children[i];
+}
+
+/*****************************************************************************************/
+// 节点内查找
+// 返回节点中第一个不小于(lower) / 大于(upper) key 的元素下标
+/*****************************************************************************************/
+
+// 节点内做线性计数的条件: 算术类型的键, 配合 mystl 的 less / greater
+template <class Key, class Compare>
+struct btree_linear_search
+	: mystl::m_bool_constant<std::is_arithmetic<Key>::value &&
+	                         (std::is_same<Compare, mystl::less<Key>>::value ||
+	                          std::is_same<Compare, mystl::greater<Key>>::value ||
+	                          std::is_same<Compare, mystl::less<void>>::value)>
+{
+};
+
+template <class Key, class Compare, bool Linear = btree_linear_search<Key, Compare>::value>
+struct btree_node_search
+{
+	template <class K>
+	static size_t lower(const Key* keys, size_t n, const K& key, const Compare& comp)
+	{
+		return static_cast<size_t>(mystl::lower_bound(keys, keys + n, key, comp) - keys);
+	}
+
+	template <class K>
+	static size_t upper(const Key* keys, size_t n, const K& key, const Compare& comp)
+	{
+		return static_cast<size_t>(mystl::upper_bound(keys, keys + n, key, comp) - keys);
+	}
+};
+
+// 节点中的键有序, 小于 key 的键的个数就是 lower_bound 的下标
+// 循环体没有分支, 整个节点只有几个缓存行, 比二分查找的依赖链更短
+template <class Key, class Compare>
+struct btree_node_search<Key, Compare, true>
+{
+	template <class K>
+	static size_t lower(const Key* keys, size_t n, const K& key, const Compare& comp)
+	{
+		size_t r = 0;
+		for (size_t i = 0; i < n; ++i)
+			r += comp(keys[i], key) ? 1 : 0;
+		return r;
+	}
+
+	template <class K>
+	static size_t upper(const Key* keys, size_t n, const K& key, const Compare& comp)
+	{
+		size_t r = 0;
+		for (size_t i = 0; i < n; ++i)
+			r += comp(key, keys[i]) ? 0 : 1;
+		return r;
+	}
+};
+
+/*****************************************************************************************/
+// 存放策略
+// btree_set_params : 元素即键值, 迭代器解引用得到 const Key&
+// btree_map_params : 键与映射值分开存放, 迭代器解引用得到 mystl::pair<const Key&, T&> 代理对象
+/*****************************************************************************************/
+
+template <class Key, class Compare, bool Multi>
+struct btree_set_params
+{
+	typedef Key     key_type;
+	typedef void    mapped_type;
+	typedef Key     value_type;
+	typedef Compare key_compare;
+
+	static constexpr bool kIsMap = false;
+	static constexpr bool kMulti = Multi;
+
+	template <class Node, bool IsConst>
+	struct reference_traits
+	{
+		typedef const Key& reference;
+		typedef const Key* pointer;
+
+		static reference get(Node* node, int i)   { return node->keys()[i]; }
+		static pointer   arrow(Node* node, int i) { return node->keys() + i; }
+	};
+};
+
+template <class Key, class T, class Compare, bool Multi>
+struct btree_map_params
+{
+	typedef Key                 key_type;
+	typedef T                   mapped_type;
+	typedef mystl::pair<Key, T> value_type;
+	typedef Compare             key_compare;
+
+	static constexpr bool kIsMap = true;
+	static constexpr bool kMulti = Multi;
+
+	template <class Node, bool IsConst>
+	struct reference_traits
+	{
+		typedef typename std::conditional<IsConst, const T, T>::type mapped_cv;
+		typedef mystl::pair<const Key&, mapped_cv&>                 reference;
+		typedef mystl::arrow_proxy<reference>                       pointer;
+
+		static reference get(Node* node, int i)   { return reference(node->keys()[i], node->values()[i]); }
+		static pointer   arrow(Node* node, int i) { return pointer{ get(node, i) }; }
+	};
+};
+
+template <class Key, class Compare, bool Multi>
+constexpr bool btree_set_params<Key, Compare, Multi>::kIsMap;
+template <class Key, class Compare, bool Multi>
+constexpr bool btree_set_params<Key, Compare, Multi>::kMulti;
+template <class Key, class T, class Compare, bool Multi>
+constexpr bool btree_map_params<Key, T, Compare, Multi>::kIsMap;
+template <class Key, class T, class Compare, bool Multi>
+constexpr bool btree_map_params<Key, T, Compare, Multi>::kMulti;
+
+/*****************************************************************************************/
+// btree 的迭代器
+// 由节点与节点内的下标组成, end() 为最右叶子的 (node, count)
+// 在叶子内部前进只是下标加一; 到达叶子末尾时沿父指针向上, 内部节点的后继是右侧子树最左叶子的第一个元素
+/*****************************************************************************************/
+
+template <class Params>
+class btree;
+
+template <class Params, bool IsConst>
+class btree_iterator
+{
+	template <class, bool> friend class btree_iterator;
+	template <class> friend class btree;
+
+public:
+	typedef typename Params::key_type                                      key_type;
+	typedef btree_node<key_type, typename Params::mapped_type,
+		btree_node_slots<key_type, typename Params::mapped_type>::value>   node_type;
+	typedef typename Params::template reference_traits<node_type, IsConst> ref_traits;
+
+	typedef bidirectional_iterator_tag                                     iterator_category;
+	typedef typename Params::value_type                                    value_type;
+	typedef ptrdiff_t                                                      difference_type;
+	typedef typename ref_traits::reference                                 reference;
+	typedef typename ref_traits::pointer                                   pointer;
+
+	typedef btree_iterator                                                 self;
+
+private:
+	node_type* node_;      // 所在节点
+	int        position_;  // 节点内的下标
+
+	btree_iterator(node_type* node, int position) noexcept
+		:node_(node), position_(position)
+	{
+	}
+
+public:
+	btree_iterator() noexcept
+		:node_(nullptr), position_(0)
+	{
+	}
+
+	// 允许从 iterator 转换为 const_iterator
+	template <bool OtherConst, typename std::enable_if<
+		IsConst && !OtherConst, int>::type = 0>
+	btree_iterator(const btree_iterator<Params, OtherConst>& rhs) noexcept
+		:node_(rhs.node_), position_(rhs.position_)
+	{
+	}
+
+	reference operator*()  const { return ref_traits::get(node_, position_); }
+	pointer   operator->() const { return ref_traits::arrow(node_, position_); }
+
+	self& operator++()
+	{
+		increment();
+		return *this;
+	}
+	self operator++(int)
+	{
+		self tmp = *this;
+		increment();
+		return tmp;
+	}
+	self& operator--()
+	{
+		decrement();
+		return *this;
+	}
+	self operator--(int)
+	{
+		self tmp = *this;
+		decrement();
+		return tmp;
+	}
+
+	friend bool operator==(const self& lhs, const self& rhs)
+	{ return lhs.node_ == rhs.node_ && lhs.position_ == rhs.position_; }
+	friend bool operator!=(const self& lhs, const self& rhs)
+	{ return !(lhs == rhs); }
+
+private:
+	void increment()
+	{
+		if (node_->leaf && ++position_ < static_cast<int>(node_->count))
+			return;
+		increment_slow();
+	}
+
+	void increment_slow()
+	{
+		if (node_->leaf)
+		{
+			// 叶子已经走完, 向上找到第一个还有后续元素的祖先; 找不到说明已到末尾, 停在 end()
+			const self save = *this;
+			while (position_ == static_cast<int>(node_->count) && node_->parent != nullptr)
+			{
+				position_ = node_->position;
+				node_ = node_->parent;
+			}
+			if (position_ == static_cast<int>(node_->count))
+				*this = save;
+		}
+		else
+		{
+			node_ = node_->child(static_cast<size_t>(position_) + 1);
+			while (!node_->leaf)
+				node_ = node_->child(0);
+			position_ = 0;
+		}
+	}
+
+	void decrement()
+	{
+		if (node_->leaf && --position_ >= 0)
+			return;
+		decrement_slow();
+	}
+
+	void decrement_slow()
+	{
+		if (node_->leaf)
+		{
+			const self save = *this;
+			while (position_ < 0 && node_->parent != nullptr)
+			{
+				position_ = static_cast<int>(node_->position) - 1;
+				node_ = node_->parent;
+			}
+			if (position_ < 0)
+				*this = save;
+		}
+		else
+		{
+			node_ = node_->child(static_cast<size_t>(position_));
+			while (!node_->leaf)
+				node_ = node_->child(node_->count);
+			position_ = static_cast<int>(node_->count) - 1;
+		}
+	}
+};
+
+/*****************************************************************************************/
+// 模板类 btree
+// 参数 Params 为存放策略, 决定元素的类型、比较方式以及是否允许重复的键
+/*****************************************************************************************/
+
+template <class Params>
+class btree
+{
+public:
+	typedef typename Params::key_type                  key_type;
+	typedef typename Params::mapped_type               mapped_type;
+	typedef typename Params::value_type                value_type;
+	typedef typename Params::key_compare               key_compare;
+
+	typedef size_t                                     size_type;
+	typedef ptrdiff_t                                  difference_type;
+
+	typedef btree_iterator<Params, false>              iterator;
+	typedef btree_iterator<Params, true>               const_iterator;
+	typedef mystl::reverse_iterator<iterator>          reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>    const_reverse_iterator;
+
+	typedef typename iterator::reference               reference;
+	typedef typename const_iterator::reference         const_reference;
+	typedef typename iterator::pointer                 pointer;
+	typedef typename const_iterator::pointer           const_pointer;
+
+	template <class K>
+	using key_arg = typename transparent_key_arg<
+		mystl::has_is_transparent<key_compare>::value>::template type<K, key_type>;
+
+	typedef typename iterator::node_type               node_type;
+	typedef btree_internal_node<key_type, mapped_type, node_type::kSlots> internal_node_type;
+
+	static constexpr size_t kNodeSlots = node_type::kSlots;
+	// 删除后元素个数少于 kMinSlots 的节点会向兄弟借元素或与兄弟合并
+	static constexpr size_t kMinSlots = kNodeSlots / 2;
+
+private:
+	typedef btree_node_search<key_type, key_compare>   node_search;
+	typedef mystl::m_bool_constant<Params::kIsMap>     is_map;
+
+	node_type*   root_;       // 根节点
+	node_type*   leftmost_;   // 最左叶子, begin() 所在
+	node_type*   rightmost_;  // 最右叶子, end() 所在
+	compressed_pair<size_type, key_compare> size_comp_;  // 元素个数与键值比较函数, 空的比较函数不占空间
+
+	node_pool<node_type, MYSTL_CACHE_LINE_SIZE>          leaf_pool_;
+	node_pool<internal_node_type, MYSTL_CACHE_LINE_SIZE> internal_pool_;
+
+public:
+	// 构造、复制、移动、析构函数
+	explicit btree(const key_compare& comp = key_compare())
+		:root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_comp_(0, comp)
+	{
+	}
+
+	btree(const btree& rhs)
+		:root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_comp_(0, rhs.comp_ref())
+	{
+		MYSTL_TRY
+		{
+			for (auto it = rhs.begin(); it != rhs.end(); ++it)
+				append_value(*it, is_map());
+		}
+		MYSTL_CATCH_ALL
+		{
+			clear();
+			MYSTL_RETHROW;
+		}
+	}
+
+	btree(btree&& rhs) noexcept
+		:root_(rhs.root_), leftmost_(rhs.leftmost_), rightmost_(rhs.rightmost_),
+		 size_comp_(rhs.size_comp_),
+		 leaf_pool_(mystl::move(rhs.leaf_pool_)), internal_pool_(mystl::move(rhs.internal_pool_))
+	{
+		rhs.reset();
+	}
+
+	btree& operator=(const btree& rhs)
+	{
+		if (this != &rhs)
+		{
+			btree tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	btree& operator=(btree&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			clear();
+			root_ = rhs.root_;
+			leftmost_ = rhs.leftmost_;
+			rightmost_ = rhs.rightmost_;
+			size_comp_ = rhs.size_comp_;
+			leaf_pool_ = mystl::move(rhs.leaf_pool_);
+			internal_pool_ = mystl::move(rhs.internal_pool_);
+			rhs.reset();
+		}
+		return *this;
+	}
+
+	~btree()
+	{
+		clear();
+	}
+
+	// 迭代器相关
+
+	iterator               begin()         noexcept
+	{ return iterator(leftmost_, 0); }
+	const_iterator         begin()   const noexcept
+	{ return const_iterator(leftmost_, 0); }
+	iterator               end()           noexcept
+	{ return iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count); }
+	const_iterator         end()     const noexcept
+	{ return const_iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count); }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept
+	{ return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept
+	{ return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return begin(); }
+	const_iterator         cend()    const noexcept
+	{ return end(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return size_ref() == 0; }
+	size_type size()     const noexcept { return size_ref(); }
+	size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(value_type); }
+
+	// 树高, 空树为 0
+	size_type height() const noexcept
+	{
+		size_type h = 0;
+		for (node_type* n = root_; n != nullptr; n = n->leaf ? nullptr : n->child(0))
+			++h;
+		return h;
+	}
+
+	// 修改容器操作
+
+	// emplace
+	// 先构造出 value_type, 再把键与映射值移动进节点
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		value_type tmp(mystl::forward<Args>(args)...);
+		return insert_value(mystl::move(tmp), is_map());
+	}
+
+	// hint 恰好是正确的插入位置时省去一次从根开始的查找
+	template <class ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{
+		value_type tmp(mystl::forward<Args>(args)...);
+		return insert_value_hint(hint, mystl::move(tmp), is_map());
+	}
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{ return insert_value(value, is_map()); }
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{ return insert_value(mystl::move(value), is_map()); }
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{ return insert_value_hint(hint, value, is_map()); }
+	iterator insert(const_iterator hint, value_type&& value)
+	{ return insert_value_hint(hint, mystl::move(value), is_map()); }
+
+	// 以键与映射值的构造参数插入, 对不允许重复的树, 键已存在时 args 不会被移动
+	template <class K, class ...Args>
+	mystl::pair<iterator, bool> emplace_key(K&& key, Args&& ...args)
+	{
+		if (root_ == nullptr)
+			create_root();
+		if (Params::kMulti)
+		{
+			auto pos = leaf_position_upper(key);
+			return mystl::pair<iterator, bool>(
+				insert_at(pos, mystl::forward<K>(key), mystl::forward<Args>(args)...), true);
+		}
+		node_type* n = root_;
+		for (;;)
+		{
+			const size_t i = node_search::lower(n->keys(), n->count, key, comp_ref());
+			if (i < n->count && !comp_ref()(key, n->keys()[i]))
+				return mystl::pair<iterator, bool>(iterator(n, static_cast<int>(i)), false);
+			if (n->leaf)
+				return mystl::pair<iterator, bool>(
+					insert_at(iterator(n, static_cast<int>(i)), mystl::forward<K>(key),
+					          mystl::forward<Args>(args)...), true);
+			n = n->child(i);
+		}
+	}
+
+	// insert_range
+	// 输入先复制并稳定排序; 空树或新元素全部位于末尾之后时逐个追加到最右叶子, 其余逐个插入
+	template <class InputIterator>
+	void insert_range(InputIterator first, InputIterator last)
+	{
+		mystl::vector<value_type> items(first, last);
+		for (size_type i = 1; i < items.size(); ++i)
+		{
+			if (comp_ref()(key_of(items[i], is_map()), key_of(items[i - 1], is_map())))
+			{
+				mystl::stable_sort(items.begin(), items.end(),
+				                   [this](const value_type& lhs, const value_type& rhs)
+				                   { return comp_ref()(key_of(lhs, is_map()), key_of(rhs, is_map())); });
+				break;
+			}
+		}
+		auto it = items.begin();
+		for (; it != items.end(); ++it)
+		{
+			if (!can_append(key_of(*it, is_map())))
+				break;
+			append_value(mystl::move(*it), is_map());
+		}
+		for (; it != items.end(); ++it)
+			insert_value(mystl::move(*it), is_map());
+	}
+
+	// 输入已经有序时直接追加到最右叶子, 不再排序
+	template <class InputIterator>
+	void insert_sorted(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			if (can_append(key_of(*first, is_map())))
+				append_value(*first, is_map());
+			else
+				insert_value(*first, is_map());
+		}
+	}
+
+	// erase
+	// 返回被删除元素的下一个位置
+	iterator erase(const_iterator pos)
+	{
+		node_type* n = pos.node_;
+		int i = pos.position_;
+		const bool internal_delete = !n->leaf;
+		n->destroy_slot(static_cast<size_t>(i));
+		if (internal_delete)
+		{
+			// 用左子树中最大的元素(位于叶子中)填补, 问题转化为删除叶子中的元素
+			node_type* leaf = n->child(static_cast<size_t>(i));
+			while (!leaf->leaf)
+				leaf = leaf->child(leaf->count);
+			n->transfer(static_cast<size_t>(i), leaf, leaf->count - 1u);
+			n = leaf;
+			i = static_cast<int>(leaf->count) - 1;
+		}
+		for (size_t j = static_cast<size_t>(i) + 1; j < n->count; ++j)
+			n->transfer(j - 1, n, j);
+		--n->count;
+		--size_ref();
+
+		iterator res(n, i);
+		rebalance_after_erase(n, res);
+		if (size_ref() == 0)
+			return end();
+		// res 位于叶子末尾时, 向上找到它的后继
+		if (res.position_ == static_cast<int>(res.node_->count))
+		{
+			res.increment_slow();
+			if (res.position_ == static_cast<int>(res.node_->count))
+				return end();
+		}
+		if (internal_delete)
+			++res;
+		return res;
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		// 删除会使迭代器失效, 因此先求出个数
+		if (first == begin() && last == end())
+		{
+			clear();
+			return end();
+		}
+		auto n = distance_of(first, last);
+		iterator it(first.node_, first.position_);
+		for (; n > 0; --n)
+			it = erase(it);
+		return it;
+	}
+
+	template <class K = key_type>
+	size_type erase_key(const key_arg<K>& key)
+	{
+		if (!Params::kMulti)
+		{
+			auto it = find<K>(key);
+			if (it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+		auto range = equal_range<K>(key);
+		const auto n = distance_of(range.first, range.second);
+		erase(range.first, range.second);
+		return n;
+	}
+
+	void clear() noexcept
+	{
+		if (root_ != nullptr && !(std::is_trivially_destructible<key_type>::value &&
+		                          is_trivially_destructible_value(is_map())))
+			destroy_subtree(root_);
+		leaf_pool_.release();
+		internal_pool_.release();
+		root_ = leftmost_ = rightmost_ = nullptr;
+		size_ref() = 0;
+	}
+
+	void swap(btree& rhs) noexcept
+	{
+		mystl::swap(root_, rhs.root_);
+		mystl::swap(leftmost_, rhs.leftmost_);
+		mystl::swap(rightmost_, rhs.rightmost_);
+		size_comp_.swap(rhs.size_comp_);
+		leaf_pool_.swap(rhs.leaf_pool_);
+		internal_pool_.swap(rhs.internal_pool_);
+	}
+
+	// 查找相关
+
+	template <class K = key_type>
+	iterator       find(const key_arg<K>& key)
+	{ return find_impl(key); }
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{ return const_cast<btree*>(this)->find_impl(key); }
+
+	template <class K = key_type>
+	iterator       lower_bound(const key_arg<K>& key)
+	{ return lower_bound_impl(key); }
+	template <class K = key_type>
+	const_iterator lower_bound(const key_arg<K>& key) const
+	{ return const_cast<btree*>(this)->lower_bound_impl(key); }
+
+	template <class K = key_type>
+	iterator       upper_bound(const key_arg<K>& key)
+	{ return upper_bound_impl(key); }
+	template <class K = key_type>
+	const_iterator upper_bound(const key_arg<K>& key) const
+	{ return const_cast<btree*>(this)->upper_bound_impl(key); }
+
+	template <class K = key_type>
+	mystl::pair<iterator, iterator> equal_range(const key_arg<K>& key)
+	{ return equal_range_impl(key); }
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{
+		auto range = const_cast<btree*>(this)->equal_range_impl(key);
+		return mystl::pair<const_iterator, const_iterator>(range.first, range.second);
+	}
+
+	template <class K = key_type>
+	size_type count(const key_arg<K>& key) const
+	{
+		if (!Params::kMulti)
+			return find<K>(key) == end() ? 0 : 1;
+		auto range = equal_range<K>(key);
+		return distance_of(range.first, range.second);
+	}
+
+	template <class K = key_type>
+	bool contains(const key_arg<K>& key) const
+	{ return find<K>(key) != end(); }
+
+	key_compare key_comp() const { return comp_ref(); }
+
+private:
+	// helper functions
+
+	size_type&         size_ref() noexcept       { return size_comp_.first(); }
+	const size_type&   size_ref() const noexcept { return size_comp_.first(); }
+	key_compare&       comp_ref() noexcept       { return size_comp_.second(); }
+	const key_compare& comp_ref() const noexcept { return size_comp_.second(); }
+
+	void reset() noexcept
+	{
+		root_ = leftmost_ = rightmost_ = nullptr;
+		size_ref() = 0;
+	}
+
+	static const key_type& key_of(const value_type& value, mystl::m_false_type) noexcept
+	{ return value; }
+	static const key_type& key_of(const value_type& value, mystl::m_true_type) noexcept
+	{ return value.first; }
+
+	static constexpr bool is_trivially_destructible_value(mystl::m_false_type) noexcept
+	{ return true; }
+	static constexpr bool is_trivially_destructible_value(mystl::m_true_type) noexcept
+	{ return std::is_trivially_destructible<mapped_type>::value; }
+
+	template <class It>
+	static size_type distance_of(It first, It last)
+	{
+		size_type n = 0;
+		for (; first != last; ++first)
+			++n;
+		return n;
+	}
+
+	// 节点的分配与释放
+
+	node_type* new_leaf_node(node_type* parent)
+	{
+		node_type* n = ::new (static_cast<void*>(leaf_pool_.allocate())) node_type;
+		n->parent = parent;
+		n->position = 0;
+		n->count = 0;
+		n->leaf = true;
+		return n;
+	}
+
+	node_type* new_internal_node(node_type* parent)
+	{
+		internal_node_type* n = ::new (static_cast<void*>(internal_pool_.allocate())) internal_node_type;
+		n->parent = parent;
+		n->position = 0;
+		n->count = 0;
+		n->leaf = false;
+		return n;
+	}
+
+	void delete_node(node_type* n) noexcept
+	{
+		if (n->leaf)
+			leaf_pool_.deallocate(n);
+		else
+			internal_pool_.deallocate(static_cast<internal_node_type*>(n));
+	}
+
+	void create_root()
+	{
+		root_ = leftmost_ = rightmost_ = new_leaf_node(nullptr);
+	}
+
+	void destroy_subtree(node_type* n) noexcept
+	{
+		for (size_t i = 0; i < n->count; ++i)
+			n->destroy_slot(i);
+		if (!n->leaf)
+		{
+			for (size_t i = 0; i <= n->count; ++i)
+				destroy_subtree(n->child(i));
+		}
+	}
+
+	// 插入相关
+
+	template <class V>
+	mystl::pair<iterator, bool> insert_value(V&& value, mystl::m_false_type)
+	{ return emplace_key(mystl::forward<V>(value)); }
+
+	template <class V>
+	mystl::pair<iterator, bool> insert_value(V&& value, mystl::m_true_type)
+	{ return emplace_key(mystl::forward<V>(value).first, mystl::forward<V>(value).second); }
+
+	template <class V>
+	void append_value(V&& value, mystl::m_false_type)
+	{ append_back(mystl::forward<V>(value)); }
+
+	template <class V>
+	void append_value(V&& value, mystl::m_true_type)
+	{ append_back(mystl::forward<V>(value).first, mystl::forward<V>(value).second); }
+
+	template <class V>
+	iterator insert_value_hint(const_iterator hint, V&& value, mystl::m_false_type)
+	{ return insert_hint(hint, mystl::forward<V>(value)); }
+
+	template <class V>
+	iterator insert_value_hint(const_iterator hint, V&& value, mystl::m_true_type)
+	{ return insert_hint(hint, mystl::forward<V>(value).first, mystl::forward<V>(value).second); }
+
+	// key 能否直接追加到末尾
+	bool can_append(const key_type& key) const
+	{
+		if (root_ == nullptr)
+			return true;
+		const key_type& back = rightmost_->keys()[rightmost_->count - 1u];
+		return Params::kMulti ? !comp_ref()(key, back) : comp_ref()(back, key);
+	}
+
+	// 追加到最右叶子的末尾, 调用者保证 key 不小于已有的所有键
+	template <class K, class ...Args>
+	void append_back(K&& key, Args&& ...args)
+	{
+		if (root_ == nullptr)
+			create_root();
+		insert_at(iterator(rightmost_, rightmost_->count),
+		          mystl::forward<K>(key), mystl::forward<Args>(args)...);
+	}
+
+	// key 恰好可以放在 hint 之前(介于 hint 的前驱与 hint 之间)时直接插入到 hint 之前的叶子位置,
+	// 多重键的树允许与两侧相等, 相等的键插入在 hint 之前; 否则退化为普通插入
+	template <class K, class ...Args>
+	iterator insert_hint(const_iterator hint, K&& key, Args&& ...args)
+	{
+		if (root_ != nullptr && hint_fits(hint, key))
+			return insert_at(leaf_position_before(hint), mystl::forward<K>(key), mystl::forward<Args>(args)...);
+		return emplace_key(mystl::forward<K>(key), mystl::forward<Args>(args)...).first;
+	}
+
+	template <class K>
+	bool hint_fits(const_iterator hint, const K& key) const
+	{
+		if (hint != end())
+		{
+			const key_type& next = key_at(hint);
+			if (Params::kMulti ? comp_ref()(next, key) : !comp_ref()(key, next))
+				return false;
+		}
+		if (hint != begin())
+		{
+			const_iterator prev = hint;
+			--prev;
+			const key_type& before = key_at(prev);
+			if (Params::kMulti ? comp_ref()(key, before) : !comp_ref()(before, key))
+				return false;
+		}
+		return true;
+	}
+
+	// 紧挨在 hint 之前的叶子位置: hint 在叶子中时就是 hint 本身,
+	// 在内部节点中时是其左子树最右叶子的末尾(即 hint 的前驱之后)
+	iterator leaf_position_before(const_iterator hint) noexcept
+	{
+		node_type* n = hint.node_;
+		if (n->leaf)
+			return iterator(n, hint.position_);
+		n = n->child(static_cast<size_t>(hint.position_));
+		while (!n->leaf)
+			n = n->child(n->count);
+		return iterator(n, n->count);
+	}
+
+	// 在叶子位置 pos 插入元素, 叶子已满时先分裂
+	template <class K, class ...Args>
+	iterator insert_at(iterator pos, K&& key, Args&& ...args)
+	{
+		node_type* n = pos.node_;
+		int i = pos.position_;
+		if (n->count == kNodeSlots)
+			split_node(n, i);
+		for (size_t j = n->count; j > static_cast<size_t>(i); --j)
+			n->transfer(j, n, j - 1);
+		MYSTL_TRY
+		{
+			n->construct_slot(static_cast<size_t>(i), mystl::forward<K>(key), mystl::forward<Args>(args)...);
+		}
+		MYSTL_CATCH_ALL
+		{
+			for (size_t j = static_cast<size_t>(i); j < n->count; ++j)
+				n->transfer(j, n, j + 1);
+			MYSTL_RETHROW;
+		}
+		++n->count;
+		++size_ref();
+		return iterator(n, i);
+	}
+
+	// 分裂满节点 n, 中间的元素上移到父节点, (n, i) 更新为待插入位置所在的节点与下标
+	// 父节点也满时先递归分裂父节点; n 为根节点时先创建新的根
+	// 在末尾(或开头)插入时偏向保留满节点, 使有序插入得到的树几乎所有节点都是满的
+	void split_node(node_type*& n, int& i)
+	{
+		if (n == root_)
+		{
+			node_type* r = new_internal_node(nullptr);
+			r->child(0) = n;
+			n->parent = r;
+			n->position = 0;
+			root_ = r;
+		}
+		else if (n->parent->count == kNodeSlots)
+		{
+			node_type* p = n->parent;
+			int pi = n->position;
+			split_node(p, pi);
+		}
+		node_type* parent = n->parent;
+		const size_t count = n->count;
+		const size_t mid = static_cast<size_t>(i) == count ? count - 1
+			: (i == 0 ? 0 : count / 2);
+		node_type* right = n->leaf ? new_leaf_node(parent) : new_internal_node(parent);
+
+		// 在父节点的 position 处腾出位置, 放入中间元素与新的右兄弟
+		const size_t pos = n->position;
+		for (size_t j = parent->count; j > pos; --j)
+			parent->transfer(j, parent, j - 1);
+		for (size_t j = parent->count + 1u; j > pos + 1; --j)
+		{
+			parent->child(j) = parent->child(j - 1);
+			parent->child(j)->position = static_cast<uint16_t>(j);
+		}
+		parent->transfer(pos, n, mid);
+		parent->child(pos + 1) = right;
+		right->position = static_cast<uint16_t>(pos + 1);
+		++parent->count;
+
+		// 中间元素之后的部分移动到右兄弟
+		for (size_t j = mid + 1; j < count; ++j)
+			right->transfer(j - mid - 1, n, j);
+		if (!n->leaf)
+		{
+			for (size_t j = mid + 1; j <= count; ++j)
+			{
+				node_type* c = n->child(j);
+				right->child(j - mid - 1) = c;
+				c->parent = right;
+				c->position = static_cast<uint16_t>(j - mid - 1);
+			}
+		}
+		right->count = static_cast<uint16_t>(count - mid - 1);
+		n->count = static_cast<uint16_t>(mid);
+		if (n == rightmost_)
+			rightmost_ = right;
+
+		if (static_cast<size_t>(i) > mid)
+		{
+			i -= static_cast<int>(mid + 1);
+			n = right;
+		}
+	}
+
+	// 删除相关
+
+	// 叶子 n 中刚删除了一个元素, 自底向上修复元素过少的节点, 同时更新 res 使其仍指向原来的位置
+	void rebalance_after_erase(node_type* n, iterator& res)
+	{
+		while (n != root_ && n->count < kMinSlots)
+		{
+			node_type* parent = n->parent;
+			const size_t pos = n->position;
+			node_type* left = pos > 0 ? parent->child(pos - 1) : nullptr;
+			node_type* right = pos < parent->count ? parent->child(pos + 1) : nullptr;
+			if (left != nullptr && left->count > kMinSlots)
+			{
+				rotate_right(left, n, parent, pos - 1);
+				if (res.node_ == n)
+					++res.position_;
+				return;
+			}
+			if (right != nullptr && right->count > kMinSlots)
+			{
+				rotate_left(n, right, parent, pos);
+				return;
+			}
+			if (left != nullptr)
+			{
+				if (res.node_ == n)
+				{
+					res.node_ = left;
+					res.position_ += static_cast<int>(left->count) + 1;
+				}
+				merge_nodes(left, n, parent, pos - 1);
+			}
+			else
+			{
+				merge_nodes(n, right, parent, pos);
+			}
+			n = parent;
+		}
+		if (root_->count == 0)
+		{
+			node_type* old = root_;
+			if (root_->leaf)
+			{
+				root_ = leftmost_ = rightmost_ = nullptr;
+			}
+			else
+			{
+				root_ = root_->child(0);
+				root_->parent = nullptr;
+				root_->position = 0;
+			}
+			delete_node(old);
+		}
+	}
+
+	// 从左兄弟借一个元素: 父节点的分隔元素下移到 n 的开头, 左兄弟的最后一个元素上移
+	void rotate_right(node_type* left, node_type* n, node_type* parent, size_t k)
+	{
+		for (size_t j = n->count; j > 0; --j)
+			n->transfer(j, n, j - 1);
+		if (!n->leaf)
+		{
+			for (size_t j = n->count + 1u; j > 0; --j)
+			{
+				n->child(j) = n->child(j - 1);
+				n->child(j)->position = static_cast<uint16_t>(j);
+			}
+		}
+		n->transfer(0, parent, k);
+		parent->transfer(k, left, left->count - 1u);
+		if (!n->leaf)
+		{
+			node_type* c = left->child(left->count);
+			n->child(0) = c;
+			c->parent = n;
+			c->position = 0;
+		}
+		--left->count;
+		++n->count;
+	}
+
+	// 从右兄弟借一个元素: 父节点的分隔元素下移到 n 的末尾, 右兄弟的第一个元素上移
+	void rotate_left(node_type* n, node_type* right, node_type* parent, size_t k)
+	{
+		n->transfer(n->count, parent, k);
+		parent->transfer(k, right, 0);
+		if (!n->leaf)
+		{
+			node_type* c = right->child(0);
+			n->child(n->count + 1u) = c;
+			c->parent = n;
+			c->position = static_cast<uint16_t>(n->count + 1u);
+		}
+		for (size_t j = 1; j < right->count; ++j)
+			right->transfer(j - 1, right, j);
+		if (!right->leaf)
+		{
+			for (size_t j = 1; j <= right->count; ++j)
+			{
+				right->child(j - 1) = right->child(j);
+				right->child(j - 1)->position = static_cast<uint16_t>(j - 1);
+			}
+		}
+		--right->count;
+		++n->count;
+	}
+
+	// 把父节点的第 k 个元素与 right 的全部内容合并到 left 的末尾, 释放 right
+	void merge_nodes(node_type* left, node_type* right, node_type* parent, size_t k)
+	{
+		const size_t lc = left->count;
+		left->transfer(lc, parent, k);
+		for (size_t j = 0; j < right->count; ++j)
+			left->transfer(lc + 1 + j, right, j);
+		if (!left->leaf)
+		{
+			for (size_t j = 0; j <= right->count; ++j)
+			{
+				node_type* c = right->child(j);
+				left->child(lc + 1 + j) = c;
+				c->parent = left;
+				c->position = static_cast<uint16_t>(lc + 1 + j);
+			}
+		}
+		left->count = static_cast<uint16_t>(lc + 1 + right->count);
+
+		for (size_t j = k + 1; j < parent->count; ++j)
+			parent->transfer(j - 1, parent, j);
+		for (size_t j = k + 2; j <= parent->count; ++j)
+		{
+			parent->child(j - 1) = parent->child(j);
+			parent->child(j - 1)->position = static_cast<uint16_t>(j - 1);
+		}
+		--parent->count;
+
+		if (right == rightmost_)
+			rightmost_ = left;
+		delete_node(right);
+	}
+
+	// 查找相关
+
+	// 多重键的插入位置: 每层取第一个大于 key 的位置, 最终落在叶子上
+	template <class K>
+	iterator leaf_position_upper(const K& key)
+	{
+		node_type* n = root_;
+		for (;;)
+		{
+			const size_t i = node_search::upper(n->keys(), n->count, key, comp_ref());
+			if (n->leaf)
+				return iterator(n, static_cast<int>(i));
+			n = n->child(i);
+		}
+	}
+
+	template <class K>
+	iterator lower_bound_impl(const K& key)
+	{
+		iterator res = end();
+		for (node_type* n = root_; n != nullptr; )
+		{
+			const size_t i = node_search::lower(n->keys(), n->count, key, comp_ref());
+			if (i < n->count)
+				res = iterator(n, static_cast<int>(i));
+			if (n->leaf)
+				break;
+			n = n->child(i);
+		}
+		return res;
+	}
+
+	template <class K>
+	iterator upper_bound_impl(const K& key)
+	{
+		iterator res = end();
+		for (node_type* n = root_; n != nullptr; )
+		{
+			const size_t i = node_search::upper(n->keys(), n->count, key, comp_ref());
+			if (i < n->count)
+				res = iterator(n, static_cast<int>(i));
+			if (n->leaf)
+				break;
+			n = n->child(i);
+		}
+		return res;
+	}
+
+	// 键唯一时在内部节点中找到即可返回
+	template <class K>
+	iterator find_impl(const K& key)
+	{
+		if (Params::kMulti)
+		{
+			auto it = lower_bound_impl(key);
+			return (it == end() || comp_ref()(key, key_at(it))) ? end() : it;
+		}
+		for (node_type* n = root_; n != nullptr; )
+		{
+			const size_t i = node_search::lower(n->keys(), n->count, key, comp_ref());
+			if (i < n->count && !comp_ref()(key, n->keys()[i]))
+				return iterator(n, static_cast<int>(i));
+			if (n->leaf)
+				break;
+			n = n->child(i);
+		}
+		return end();
+	}
+
+	template <class K>
+	mystl::pair<iterator, iterator> equal_range_impl(const K& key)
+	{
+		auto lo = lower_bound_impl(key);
+		if (Params::kMulti)
+			return mystl::pair<iterator, iterator>(lo, upper_bound_impl(key));
+		auto hi = lo;
+		if (lo != end() && !comp_ref()(key, key_at(lo)))
+			++hi;
+		return mystl::pair<iterator, iterator>(lo, hi);
+	}
+
+	static const key_type& key_at(const_iterator it) noexcept
+	{ return it.node_->keys()[it.position_]; }
+
+public:
+	friend bool operator==(const btree& lhs, const btree& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return false;
+		for (auto i = lhs.begin(), j = rhs.begin(); i != lhs.end(); ++i, ++j)
+		{
+			if (!(*i == *j))
+				return false;
+		}
+		return true;
+	}
+	friend bool operator<(const btree& lhs, const btree& rhs)
+	{
+		auto i = lhs.begin(), j = rhs.begin();
+		for (; i != lhs.end() && j != rhs.end(); ++i, ++j)
+		{
+			if (*i < *j)
+				return true;
+			if (*j < *i)
+				return false;
+		}
+		return i == lhs.end() && j != rhs.end();
+	}
+};
+
+template <class Params>
+constexpr size_t btree<Params>::kNodeSlots;
+template <class Params>
+constexpr size_t btree<Params>::kMinSlots;
+
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_H_
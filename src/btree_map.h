@@ -0,0 +1,406 @@
+#ifndef MYTINYSTL_BTREE_MAP_H_
+#define MYTINYSTL_BTREE_MAP_H_
+
+// 这个头文件包含两个模板类 btree_map 和 btree_multimap
+// btree_map      : 用法与 map 相同, 元素按键有序存放在 B 树中
+// btree_multimap : 与 btree_map 相同, 但允许键值重复
+
+// notes:
+//
+// 键与映射值在节点中分开存放, 迭代器解引用得到 mystl::pair<const Key&, T&> 代理对象,
+// operator-> 返回持有该代理的临时对象, 因此 it->first / it->second 的写法照常可用
+// 与 std::map 不同, 插入与删除会使所有迭代器与指向元素的引用失效
+//
+// 异常保证：
+// mystl::btree_map<Key, T> / mystl::btree_multimap<Key, T> 满足基本异常保证，
+// 对以下等函数做强异常安全保证：
+//   * emplace
+//   * try_emplace
+//   * insert(单个元素)
+
+#include <initializer_list>
+
+#include "btree.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类 basic_btree_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值比较方式，参数四代表是否允许键值重复
+// 通常通过下面的 btree_map 与 btree_multimap 使用
+template <class Key, class T, class Compare, bool Multi>
+class basic_btree_map
+{
+private:
+	// 使用 btree 作为底层机制
+	typedef btree<btree_map_params<Key, T, Compare, Multi>> base_type;
+	base_type tree_;
+
+public:
+	// 使用 btree 的型别
+	typedef typename base_type::key_type                key_type;
+	typedef typename base_type::mapped_type             mapped_type;
+	typedef typename base_type::value_type              value_type;
+	typedef typename base_type::key_compare             key_compare;
+
+	typedef typename base_type::size_type               size_type;
+	typedef typename base_type::difference_type         difference_type;
+	typedef typename base_type::pointer                 pointer;
+	typedef typename base_type::const_pointer           const_pointer;
+	typedef typename base_type::reference               reference;
+	typedef typename base_type::const_reference         const_reference;
+
+	typedef typename base_type::iterator                iterator;
+	typedef typename base_type::const_iterator          const_iterator;
+	typedef typename base_type::reverse_iterator        reverse_iterator;
+	typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+	template <class K>
+	using key_arg = typename base_type::template key_arg<K>;
+
+	// 以键比较 value_type
+	class value_compare
+	{
+		friend class basic_btree_map;
+	private:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+	public:
+		template <class P1, class P2>
+		bool operator()(const P1& lhs, const P2& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	};
+
+public:
+	// 构造、复制、移动、析构函数
+	basic_btree_map()
+		:tree_()
+	{
+	}
+
+	explicit basic_btree_map(const key_compare& comp)
+		:tree_(comp)
+	{
+	}
+
+	// 区间构造: 输入可以无序, 排序后自底向上批量构建
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_btree_map(InputIterator first, InputIterator last,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_range(first, last);
+	}
+
+	basic_btree_map(std::initializer_list<value_type> ilist,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_range(ilist.begin(), ilist.end());
+	}
+
+	// 输入已经有序, 直接追加, 不再排序
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_btree_map(sorted_unique_t, InputIterator first, InputIterator last,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_sorted(first, last);
+	}
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_btree_map(sorted_equivalent_t, InputIterator first, InputIterator last,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_sorted(first, last);
+	}
+
+	basic_btree_map(const basic_btree_map& rhs)
+		:tree_(rhs.tree_)
+	{
+	}
+	basic_btree_map(basic_btree_map&& rhs) noexcept
+		:tree_(mystl::move(rhs.tree_))
+	{
+	}
+
+	basic_btree_map& operator=(const basic_btree_map& rhs)
+	{
+		tree_ = rhs.tree_;
+		return *this;
+	}
+	basic_btree_map& operator=(basic_btree_map&& rhs) noexcept
+	{
+		tree_ = mystl::move(rhs.tree_);
+		return *this;
+	}
+
+	basic_btree_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		tree_.clear();
+		tree_.insert_range(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	~basic_btree_map() = default;
+
+	// 迭代器相关
+
+	iterator               begin()         noexcept
+	{ return tree_.begin(); }
+	const_iterator         begin()   const noexcept
+	{ return tree_.begin(); }
+	iterator               end()           noexcept
+	{ return tree_.end(); }
+	const_iterator         end()     const noexcept
+	{ return tree_.end(); }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return tree_.rbegin(); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return tree_.rbegin(); }
+	reverse_iterator       rend()          noexcept
+	{ return tree_.rend(); }
+	const_reverse_iterator rend()    const noexcept
+	{ return tree_.rend(); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return tree_.cbegin(); }
+	const_iterator         cend()    const noexcept
+	{ return tree_.cend(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return tree_.empty(); }
+	size_type size()     const noexcept { return tree_.size(); }
+	size_type max_size() const noexcept { return tree_.max_size(); }
+
+	// 访问元素相关
+
+	mapped_type& at(const key_type& key)
+	{
+		auto it = tree_.find(key);
+		THROW_OUT_OF_RANGE_IF(it == tree_.end(), "btree_map<Key, T> no such element exists");
+		return it->second;
+	}
+	const mapped_type& at(const key_type& key) const
+	{
+		auto it = tree_.find(key);
+		THROW_OUT_OF_RANGE_IF(it == tree_.end(), "btree_map<Key, T> no such element exists");
+		return it->second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		static_assert(!Multi, "btree_multimap<Key, T> has no operator[]");
+		return tree_.emplace_key(key).first->second;
+	}
+	mapped_type& operator[](key_type&& key)
+	{
+		static_assert(!Multi, "btree_multimap<Key, T> has no operator[]");
+		return tree_.emplace_key(mystl::move(key)).first->second;
+	}
+
+	// 修改容器操作
+
+	// emplace / emplace_hint
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{ return tree_.emplace(mystl::forward<Args>(args)...); }
+
+	template <class ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{ return tree_.emplace_hint(hint, mystl::forward<Args>(args)...); }
+
+	// try_emplace
+	// 键不存在时才构造映射值, 键存在时 args 不会被移动
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+	{
+		static_assert(!Multi, "btree_multimap<Key, T> has no try_emplace");
+		return tree_.emplace_key(key, mystl::forward<Args>(args)...);
+	}
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+	{
+		static_assert(!Multi, "btree_multimap<Key, T> has no try_emplace");
+		return tree_.emplace_key(mystl::move(key), mystl::forward<Args>(args)...);
+	}
+
+	// insert
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{ return tree_.insert(value); }
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{ return tree_.insert(mystl::move(value)); }
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{ return tree_.insert(hint, value); }
+	iterator insert(const_iterator hint, value_type&& value)
+	{ return tree_.insert(hint, mystl::move(value)); }
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	void insert(InputIterator first, InputIterator last)
+	{ tree_.insert_range(first, last); }
+
+	void insert(std::initializer_list<value_type> ilist)
+	{ tree_.insert_range(ilist.begin(), ilist.end()); }
+
+	// insert_range
+	// 输入排序后, 位于已有元素之后的部分直接追加到最右叶子
+	template <class InputIterator>
+	void insert_range(InputIterator first, InputIterator last)
+	{ tree_.insert_range(first, last); }
+
+	template <class InputIterator>
+	void insert(sorted_unique_t, InputIterator first, InputIterator last)
+	{ tree_.insert_sorted(first, last); }
+
+	template <class InputIterator>
+	void insert(sorted_equivalent_t, InputIterator first, InputIterator last)
+	{ tree_.insert_sorted(first, last); }
+
+	// insert_or_assign
+	// 键存在时对映射值赋值, 否则插入
+
+	template <class M>
+	mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+	{
+		auto result = try_emplace(key, mystl::forward<M>(obj));
+		if (!result.second)
+			result.first->second = mystl::forward<M>(obj);
+		return result;
+	}
+
+	template <class M>
+	mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+	{
+		auto result = try_emplace(mystl::move(key), mystl::forward<M>(obj));
+		if (!result.second)
+			result.first->second = mystl::forward<M>(obj);
+		return result;
+	}
+
+	// erase / clear
+
+	iterator  erase(iterator pos)
+	{ return tree_.erase(pos); }
+	iterator  erase(const_iterator pos)
+	{ return tree_.erase(pos); }
+	iterator  erase(const_iterator first, const_iterator last)
+	{ return tree_.erase(first, last); }
+
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{ return tree_.template erase_key<K>(key); }
+
+	void      clear() noexcept
+	{ tree_.clear(); }
+
+	void      swap(basic_btree_map& rhs) noexcept
+	{ tree_.swap(rhs.tree_); }
+
+	// 查找相关
+
+	template <class K = key_type>
+	size_type      count(const key_arg<K>& key) const
+	{ return tree_.template count<K>(key); }
+
+	template <class K = key_type>
+	bool           contains(const key_arg<K>& key) const
+	{ return tree_.template contains<K>(key); }
+
+	template <class K = key_type>
+	iterator       find(const key_arg<K>& key)
+	{ return tree_.template find<K>(key); }
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{ return tree_.template find<K>(key); }
+
+	template <class K = key_type>
+	iterator       lower_bound(const key_arg<K>& key)
+	{ return tree_.template lower_bound<K>(key); }
+	template <class K = key_type>
+	const_iterator lower_bound(const key_arg<K>& key) const
+	{ return tree_.template lower_bound<K>(key); }
+
+	template <class K = key_type>
+	iterator       upper_bound(const key_arg<K>& key)
+	{ return tree_.template upper_bound<K>(key); }
+	template <class K = key_type>
+	const_iterator upper_bound(const key_arg<K>& key) const
+	{ return tree_.template upper_bound<K>(key); }
+
+	template <class K = key_type>
+	mystl::pair<iterator, iterator> equal_range(const key_arg<K>& key)
+	{ return tree_.template equal_range<K>(key); }
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{ return tree_.template equal_range<K>(key); }
+
+	// 观察者
+
+	key_compare   key_comp()   const { return tree_.key_comp(); }
+	value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+public:
+	friend bool operator==(const basic_btree_map& lhs, const basic_btree_map& rhs)
+	{
+		return lhs.tree_ == rhs.tree_;
+	}
+	friend bool operator!=(const basic_btree_map& lhs, const basic_btree_map& rhs)
+	{
+		return !(lhs == rhs);
+	}
+	friend bool operator<(const basic_btree_map& lhs, const basic_btree_map& rhs)
+	{
+		return lhs.tree_ < rhs.tree_;
+	}
+	friend bool operator>(const basic_btree_map& lhs, const basic_btree_map& rhs)
+	{
+		return rhs < lhs;
+	}
+	friend bool operator<=(const basic_btree_map& lhs, const basic_btree_map& rhs)
+	{
+		return !(rhs < lhs);
+	}
+	friend bool operator>=(const basic_btree_map& lhs, const basic_btree_map& rhs)
+	{
+		return !(lhs < rhs);
+	}
+};
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare, bool Multi>
+void swap(basic_btree_map<Key, T, Compare, Multi>& lhs,
+          basic_btree_map<Key, T, Compare, Multi>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 模板类 btree_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+using btree_map = basic_btree_map<Key, T, Compare, false>;
+
+// 模板类 btree_multimap，键值允许重复
+template <class Key, class T, class Compare = mystl::less<Key>>
+using btree_multimap = basic_btree_map<Key, T, Compare, true>;
+
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_MAP_H_
@@ -0,0 +1,310 @@
+#ifndef MYTINYSTL_BTREE_SET_H_
+#define MYTINYSTL_BTREE_SET_H_
+
+// 这个头文件包含两个模板类 btree_set 和 btree_multiset
+// btree_set      : 用法与 set 相同, 元素有序存放在 B 树中
+// btree_multiset : 与 btree_set 相同, 但允许键值重复
+
+// notes:
+//
+// 与 std::set 不同, 插入与删除会使所有迭代器与指向元素的引用失效
+//
+// 异常保证：
+// mystl::btree_set<Key> / mystl::btree_multiset<Key> 满足基本异常保证，
+// 对以下等函数做强异常安全保证：
+//   * emplace
+//   * insert(单个元素)
+
+#include <initializer_list>
+
+#include "btree.h"
+
+namespace mystl
+{
+
+// 模板类 basic_btree_set
+// 参数一代表键值类型，参数二代表键值比较方式，参数三代表是否允许键值重复
+// 通常通过下面的 btree_set 与 btree_multiset 使用
+template <class Key, class Compare, bool Multi>
+class basic_btree_set
+{
+private:
+	// 使用 btree 作为底层机制
+	typedef btree<btree_set_params<Key, Compare, Multi>> base_type;
+	base_type tree_;
+
+public:
+	// 使用 btree 的型别
+	typedef typename base_type::key_type                key_type;
+	typedef typename base_type::value_type              value_type;
+	typedef typename base_type::key_compare             key_compare;
+	typedef typename base_type::key_compare             value_compare;
+
+	typedef typename base_type::size_type               size_type;
+	typedef typename base_type::difference_type         difference_type;
+	typedef typename base_type::pointer                 pointer;
+	typedef typename base_type::const_pointer           const_pointer;
+	typedef typename base_type::reference               reference;
+	typedef typename base_type::const_reference         const_reference;
+
+	// 元素即键值, 不允许通过迭代器修改
+	typedef typename base_type::const_iterator          iterator;
+	typedef typename base_type::const_iterator          const_iterator;
+	typedef typename base_type::const_reverse_iterator  reverse_iterator;
+	typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+	template <class K>
+	using key_arg = typename base_type::template key_arg<K>;
+
+public:
+	// 构造、复制、移动、析构函数
+	basic_btree_set()
+		:tree_()
+	{
+	}
+
+	explicit basic_btree_set(const key_compare& comp)
+		:tree_(comp)
+	{
+	}
+
+	// 区间构造: 输入可以无序, 排序后自底向上批量构建
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_btree_set(InputIterator first, InputIterator last,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_range(first, last);
+	}
+
+	basic_btree_set(std::initializer_list<value_type> ilist,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_range(ilist.begin(), ilist.end());
+	}
+
+	// 输入已经有序, 直接追加, 不再排序
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_btree_set(sorted_unique_t, InputIterator first, InputIterator last,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_sorted(first, last);
+	}
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_btree_set(sorted_equivalent_t, InputIterator first, InputIterator last,
+	                const key_compare& comp = key_compare())
+		:tree_(comp)
+	{
+		tree_.insert_sorted(first, last);
+	}
+
+	basic_btree_set(const basic_btree_set& rhs)
+		:tree_(rhs.tree_)
+	{
+	}
+	basic_btree_set(basic_btree_set&& rhs) noexcept
+		:tree_(mystl::move(rhs.tree_))
+	{
+	}
+
+	basic_btree_set& operator=(const basic_btree_set& rhs)
+	{
+		tree_ = rhs.tree_;
+		return *this;
+	}
+	basic_btree_set& operator=(basic_btree_set&& rhs) noexcept
+	{
+		tree_ = mystl::move(rhs.tree_);
+		return *this;
+	}
+
+	basic_btree_set& operator=(std::initializer_list<value_type> ilist)
+	{
+		tree_.clear();
+		tree_.insert_range(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	~basic_btree_set() = default;
+
+	// 迭代器相关
+
+	iterator               begin()   const noexcept
+	{ return tree_.begin(); }
+	iterator               end()     const noexcept
+	{ return tree_.end(); }
+	reverse_iterator       rbegin()  const noexcept
+	{ return tree_.rbegin(); }
+	reverse_iterator       rend()    const noexcept
+	{ return tree_.rend(); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return tree_.cbegin(); }
+	const_iterator         cend()    const noexcept
+	{ return tree_.cend(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return tree_.empty(); }
+	size_type size()     const noexcept { return tree_.size(); }
+	size_type max_size() const noexcept { return tree_.max_size(); }
+
+	// 修改容器操作
+
+	// emplace / emplace_hint
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		auto result = tree_.emplace(mystl::forward<Args>(args)...);
+		return mystl::pair<iterator, bool>(result.first, result.second);
+	}
+
+	template <class ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{ return tree_.emplace_hint(hint, mystl::forward<Args>(args)...); }
+
+	// insert
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{
+		auto result = tree_.insert(value);
+		return mystl::pair<iterator, bool>(result.first, result.second);
+	}
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{
+		auto result = tree_.insert(mystl::move(value));
+		return mystl::pair<iterator, bool>(result.first, result.second);
+	}
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{ return tree_.insert(hint, value); }
+	iterator insert(const_iterator hint, value_type&& value)
+	{ return tree_.insert(hint, mystl::move(value)); }
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	void insert(InputIterator first, InputIterator last)
+	{ tree_.insert_range(first, last); }
+
+	void insert(std::initializer_list<value_type> ilist)
+	{ tree_.insert_range(ilist.begin(), ilist.end()); }
+
+	// insert_range
+	// 输入排序后, 位于已有元素之后的部分直接追加到最右叶子
+	template <class InputIterator>
+	void insert_range(InputIterator first, InputIterator last)
+	{ tree_.insert_range(first, last); }
+
+	template <class InputIterator>
+	void insert(sorted_unique_t, InputIterator first, InputIterator last)
+	{ tree_.insert_sorted(first, last); }
+
+	template <class InputIterator>
+	void insert(sorted_equivalent_t, InputIterator first, InputIterator last)
+	{ tree_.insert_sorted(first, last); }
+
+	// erase / clear
+
+	iterator  erase(const_iterator pos)
+	{ return tree_.erase(pos); }
+	iterator  erase(const_iterator first, const_iterator last)
+	{ return tree_.erase(first, last); }
+
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{ return tree_.template erase_key<K>(key); }
+
+	void      clear() noexcept
+	{ tree_.clear(); }
+
+	void      swap(basic_btree_set& rhs) noexcept
+	{ tree_.swap(rhs.tree_); }
+
+	// 查找相关
+
+	template <class K = key_type>
+	size_type      count(const key_arg<K>& key) const
+	{ return tree_.template count<K>(key); }
+
+	template <class K = key_type>
+	bool           contains(const key_arg<K>& key) const
+	{ return tree_.template contains<K>(key); }
+
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{ return tree_.template find<K>(key); }
+
+	template <class K = key_type>
+	const_iterator lower_bound(const key_arg<K>& key) const
+	{ return tree_.template lower_bound<K>(key); }
+
+	template <class K = key_type>
+	const_iterator upper_bound(const key_arg<K>& key) const
+	{ return tree_.template upper_bound<K>(key); }
+
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{ return tree_.template equal_range<K>(key); }
+
+	// 观察者
+
+	key_compare   key_comp()   const { return tree_.key_comp(); }
+	value_compare value_comp() const { return tree_.key_comp(); }
+
+public:
+	friend bool operator==(const basic_btree_set& lhs, const basic_btree_set& rhs)
+	{
+		return lhs.tree_ == rhs.tree_;
+	}
+	friend bool operator!=(const basic_btree_set& lhs, const basic_btree_set& rhs)
+	{
+		return !(lhs == rhs);
+	}
+	friend bool operator<(const basic_btree_set& lhs, const basic_btree_set& rhs)
+	{
+		return lhs.tree_ < rhs.tree_;
+	}
+	friend bool operator>(const basic_btree_set& lhs, const basic_btree_set& rhs)
+	{
+		return rhs < lhs;
+	}
+	friend bool operator<=(const basic_btree_set& lhs, const basic_btree_set& rhs)
+	{
+		return !(rhs < lhs);
+	}
+	friend bool operator>=(const basic_btree_set& lhs, const basic_btree_set& rhs)
+	{
+		return !(lhs < rhs);
+	}
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Compare, bool Multi>
+void swap(basic_btree_set<Key, Compare, Multi>& lhs,
+          basic_btree_set<Key, Compare, Multi>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 模板类 btree_set，键值不允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less
+template <class Key, class Compare = mystl::less<Key>>
+using btree_set = basic_btree_set<Key, Compare, false>;
+
+// 模板类 btree_multiset，键值允许重复
+template <class Key, class Compare = mystl::less<Key>>
+using btree_multiset = basic_btree_set<Key, Compare, true>;
+
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_SET_H_
@@ -8,11 +8,17 @@
 // 主要围绕构造的对象能否进行平凡构造以及平凡析构编写
 // _one后缀的函数用于单个构造和析构
 // _cat后缀的函数作为辅助函数,被对应函数调用(例如 destroy 被 destroy_one 调用), 依据其构造或析构是否是平凡的而决定具体的函数调用策略
+// C++20 起这些函数都是 constexpr 的: 常量求值中不能使用 placement new, 改用 std::construct_at
 
 #include <new>
 
 #include "type_traits.h"
 #include "iterator.h"
+#include "util.h"
+
+#if defined(MYSTL_HAS_CONSTEXPR20)
+#include <memory>  // std::construct_at
+#endif
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -26,22 +32,43 @@ namespace mystl
 
 // 无参
 template <class Ty>
-void construct(Ty* ptr)
+MYSTL_CONSTEXPR20 void construct(Ty* ptr)
 {
+#if defined(MYSTL_HAS_CONSTEXPR20)
+	if (mystl::is_constant_evaluated())
+	{
+		std::construct_at(ptr);
+		return;
+	}
+#endif
 	::new (static_cast<void*>(ptr)) Ty();
 }
 
 // 单参
 template <class Ty1, class Ty2>
-void construct(Ty1* ptr, const Ty2& value)
+MYSTL_CONSTEXPR20 void construct(Ty1* ptr, const Ty2& value)
 {
+#if defined(MYSTL_HAS_CONSTEXPR20)
+	if (mystl::is_constant_evaluated())
+	{
+		std::construct_at(ptr, value);
+		return;
+	}
+#endif
 	::new (static_cast<void*>(ptr)) Ty1(value);
 }
 
 // 多参
 template <class Ty, class... Args>
-void construct(Ty* ptr, Args&&... args)
+MYSTL_CONSTEXPR20 void construct(Ty* ptr, Args&&... args)
 {
+#if defined(MYSTL_HAS_CONSTEXPR20)
+	if (mystl::is_constant_evaluated())
+	{
+		std::construct_at(ptr, mystl::forward<Args>(args)...);
+		return;
+	}
+#endif
 	::new (static_cast<void*>(ptr)) Ty(mystl::forward<Args>(args)...);
 }
 
@@ -50,11 +77,11 @@ void construct(Ty* ptr, Args&&... args)
 // 针对单个对象的析构,第二个参数将在后面的函数中使用,用以配合类型系统,实现SFINAE.
 // 可平凡析构则调用该函数
 template <class Ty>
-void destroy_one(Ty*, std::true_type) {}
+MYSTL_CONSTEXPR20 void destroy_one(Ty*, std::true_type) {}
 
 // 不可平凡析构则调用该函数
 template <class Ty>
-void destroy_one(Ty* pointer, std::false_type)
+MYSTL_CONSTEXPR20 void destroy_one(Ty* pointer, std::false_type)
 {
 	if (pointer != nullptr)
 	{
@@ -65,25 +92,25 @@ void destroy_one(Ty* pointer, std::false_type)
 // 中间层,为下面的destroy服务.
 // 配合类型系统实现SFINAE,判断传入的Forward具体调用平凡析构或是非平凡析构.
 template <class ForwardIter>
-void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
+MYSTL_CONSTEXPR20 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
 
 template <class ForwardIter>
-void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
+MYSTL_CONSTEXPR20 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
 {
 	for (; first != last; ++first)
-		destroy(&*first);
+		mystl::destroy_one(&*first, std::false_type{});
 }
 
 // 单个对象的析构
 template <class Ty>
-void destroy(Ty* pointer)
+MYSTL_CONSTEXPR20 void destroy(Ty* pointer)
 {
 	destroy_one(pointer, std::is_trivially_destructible<Ty>{});
 }
 
 // 多个对象(一段范围)的析构
 template <class ForwardIter>
-void destroy(ForwardIter first, ForwardIter last)
+MYSTL_CONSTEXPR20 void destroy(ForwardIter first, ForwardIter last)
 {
 	destroy_cat(first, last, std::is_trivially_destructible<
 		        typename iterator_traits<ForwardIter>::value_type> {});
@@ -0,0 +1,1007 @@
+#ifndef MYTINYSTL_CORD_H_
+#define MYTINYSTL_CORD_H_
+
+// 这个头文件包含一个类 cord
+// cord : 由共享的只读字符块组成的字符串(rope), 适合拼接、插入很大的文本
+
+// notes:
+//
+// cord 的内容存放在一棵二叉树中:
+//   * 叶节点是 flat(自带一块字符缓冲区) 或 substring(引用某个 flat 的一段)
+//   * 内部节点是 concat, 只记录左右子树与总长度
+//   * 所有节点带原子引用计数, 复制 cord 或取子串只增加计数, 不复制字符; 节点一旦共享便不再修改,
+//     修改操作沿路径复制出新节点(路径复制), 其余子树继续共享
+// 树按 AVL 的规则保持平衡(左右子树高度差不超过 1), 高度为 O(log n), 所以:
+//   * 拼接两个 cord(append(cord) / prepend / operator+) 为 O(log n)
+//   * substr, insert, erase 为 O(log n) 次节点操作, 加上不超过一个小块的复制
+//   * operator[] 为 O(log n)
+// append 字符串时, 若最右侧的 flat 及其路径都只被本 cord 持有且还有剩余空间, 直接写入, 不新建节点;
+// 大段内容切分为不超过 kMaxFlatLength 的 flat, 并直接建成平衡的子树
+// chunks() 按顺序给出各个叶节点的内容(string_view), 可以直接填入 writev 的 iovec 数组;
+// 只有调用 flatten() 时才会把内容复制到一整块连续内存中
+// 修改 cord 之后, 之前得到的 chunk_iterator 与 string_view 都可能失效
+//
+// 不同线程可以同时读取共享节点的 cord(包括彼此的副本), 同一个 cord 对象的修改需要外部同步
+//
+// 异常保证：
+// mystl::cord 满足基本异常保证, 对以下函数做强异常安全保证：
+//   * append
+//   * prepend
+//   * insert
+//   * erase
+//   * substr
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "allocator.h"
+#include "basic_string.h"
+#include "string_view.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+namespace cord_detail
+{
+
+enum rep_kind : unsigned char
+{
+	kFlat,
+	kSubstring,
+	kConcat
+};
+
+// 所有节点的公共部分
+struct rep
+{
+	std::atomic<size_t> refs;
+	size_t              length;
+	unsigned char       kind;
+	unsigned char       height;  // 叶节点为 0
+};
+
+// 字符直接跟在节点之后
+struct flat_rep : rep
+{
+	size_t capacity;
+
+	char*       data()       noexcept { return reinterpret_cast<char*>(this + 1); }
+	const char* data() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+};
+
+struct substring_rep : rep
+{
+	size_t    start;
+	flat_rep* child;
+};
+
+struct concat_rep : rep
+{
+	rep* left;
+	rep* right;
+};
+
+typedef mystl::allocator<unsigned char> byte_allocator;
+
+// 一个 flat 最多存放的字符数, 节点连同字符约占 4KB
+constexpr size_t kMaxFlatLength = 4096 - sizeof(flat_rep);
+// append 新建 flat 时至少预留的容量, 便于之后的 append 直接写入
+constexpr size_t kMinAppendCapacity = 256;
+// 不超过此长度的子串、相邻小叶节点直接复制为新的 flat, 避免留下很多细碎的节点
+constexpr size_t kMaxCopyLength = 128;
+// 树的最大高度: AVL 树高度不超过 1.44 * log2(叶节点数)
+constexpr size_t kMaxHeight = 96;
+
+inline rep* ref(rep* r) noexcept
+{
+	if (r != nullptr)
+		r->refs.fetch_add(1, std::memory_order_relaxed);
+	return r;
+}
+
+inline void unref(rep* r) noexcept
+{
+	while (r != nullptr && r->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		rep* next = nullptr;
+		switch (r->kind)
+		{
+		case kFlat:
+		{
+			flat_rep* f = static_cast<flat_rep*>(r);
+			const size_t bytes = sizeof(flat_rep) + f->capacity;
+			f->~flat_rep();
+			byte_allocator::deallocate(reinterpret_cast<unsigned char*>(f), bytes);
+			break;
+		}
+		case kSubstring:
+		{
+			substring_rep* s = static_cast<substring_rep*>(r);
+			next = s->child;
+			s->~substring_rep();
+			byte_allocator::deallocate(reinterpret_cast<unsigned char*>(s), sizeof(substring_rep));
+			break;
+		}
+		default:
+		{
+			concat_rep* c = static_cast<concat_rep*>(r);
+			unref(c->left);
+			next = c->right;
+			c->~concat_rep();
+			byte_allocator::deallocate(reinterpret_cast<unsigned char*>(c), sizeof(concat_rep));
+			break;
+		}
+		}
+		r = next;
+	}
+}
+
+// 只被一个持有者引用时才能原地修改
+inline bool is_unique(const rep* r) noexcept
+{
+	return r->refs.load(std::memory_order_acquire) == 1;
+}
+
+inline flat_rep* new_flat(size_t capacity)
+{
+	void* p = byte_allocator::allocate(sizeof(flat_rep) + capacity);
+	flat_rep* f = ::new (p) flat_rep;
+	f->refs.store(1, std::memory_order_relaxed);
+	f->length = 0;
+	f->kind = kFlat;
+	f->height = 0;
+	f->capacity = capacity;
+	return f;
+}
+
+inline flat_rep* new_flat(const char* s, size_t n, size_t capacity)
+{
+	flat_rep* f = new_flat(capacity);
+	std::memcpy(f->data(), s, n);
+	f->length = n;
+	return f;
+}
+
+// 拼接左右子树, 不检查平衡, 接管两者的引用
+inline rep* new_concat(rep* left, rep* right)
+{
+	void* p = nullptr;
+	MYSTL_TRY
+	{
+		p = byte_allocator::allocate(sizeof(concat_rep));
+	}
+	MYSTL_CATCH_ALL
+	{
+		unref(left);
+		unref(right);
+		MYSTL_RETHROW;
+	}
+	concat_rep* c = ::new (p) concat_rep;
+	c->refs.store(1, std::memory_order_relaxed);
+	c->length = left->length + right->length;
+	c->kind = kConcat;
+	c->height = static_cast<unsigned char>(mystl::max(left->height, right->height) + 1);
+	c->left = left;
+	c->right = right;
+	return c;
+}
+
+// 叶节点的字符
+inline const char* leaf_data(const rep* r) noexcept
+{
+	if (r->kind == kFlat)
+		return static_cast<const flat_rep*>(r)->data();
+	const substring_rep* s = static_cast<const substring_rep*>(r);
+	return s->child->data() + s->start;
+}
+
+// 拼接 left 与 right, 失败时另外释放 other1 与 other2
+inline rep* new_concat_or_release(rep* left, rep* right, rep* other1, rep* other2 = nullptr)
+{
+	MYSTL_TRY
+	{
+		return new_concat(left, right);
+	}
+	MYSTL_CATCH_ALL
+	{
+		unref(other1);
+		unref(other2);
+		MYSTL_RETHROW;
+	}
+}
+
+// 取 flat 的一段, 接管 f 的引用; 较短时复制, 否则引用原 flat
+inline rep* new_substring(flat_rep* f, size_t start, size_t n)
+{
+	if (n <= kMaxCopyLength)
+	{
+		rep* r = nullptr;
+		MYSTL_TRY
+		{
+			r = new_flat(f->data() + start, n, n);
+		}
+		MYSTL_CATCH_ALL
+		{
+			unref(f);
+			MYSTL_RETHROW;
+		}
+		unref(f);
+		return r;
+	}
+	void* p = nullptr;
+	MYSTL_TRY
+	{
+		p = byte_allocator::allocate(sizeof(substring_rep));
+	}
+	MYSTL_CATCH_ALL
+	{
+		unref(f);
+		MYSTL_RETHROW;
+	}
+	substring_rep* s = ::new (p) substring_rep;
+	s->refs.store(1, std::memory_order_relaxed);
+	s->length = n;
+	s->kind = kSubstring;
+	s->height = 0;
+	s->start = start;
+	s->child = f;
+	return s;
+}
+
+// 拼接左右子树并恢复平衡, 要求两者高度差不超过 2, 接管两者的引用
+inline rep* balance(rep* a, rep* b)
+{
+	if (a->height > b->height + 1)
+	{
+		concat_rep* ca = static_cast<concat_rep*>(a);
+		rep* a1 = ref(ca->left);
+		rep* a2 = ref(ca->right);
+		unref(a);
+		if (a1->height >= a2->height)
+		{
+			// 单旋转
+			rep* right = new_concat_or_release(a2, b, a1);
+			return new_concat(a1, right);
+		}
+		// 双旋转
+		concat_rep* c2 = static_cast<concat_rep*>(a2);
+		rep* a21 = ref(c2->left);
+		rep* a22 = ref(c2->right);
+		unref(a2);
+		rep* right = new_concat_or_release(a22, b, a1, a21);
+		rep* left = new_concat_or_release(a1, a21, right);
+		return new_concat(left, right);
+	}
+	if (b->height > a->height + 1)
+	{
+		concat_rep* cb = static_cast<concat_rep*>(b);
+		rep* b1 = ref(cb->left);
+		rep* b2 = ref(cb->right);
+		unref(b);
+		if (b2->height >= b1->height)
+		{
+			rep* left = new_concat_or_release(a, b1, b2);
+			return new_concat(left, b2);
+		}
+		concat_rep* c1 = static_cast<concat_rep*>(b1);
+		rep* b11 = ref(c1->left);
+		rep* b12 = ref(c1->right);
+		unref(b1);
+		rep* left = new_concat_or_release(a, b11, b12, b2);
+		rep* right = new_concat_or_release(b12, b2, left);
+		return new_concat(left, right);
+	}
+	return new_concat(a, b);
+}
+
+// 拼接任意两棵树(AVL join), 代价为 O(|高度差| + 1), 接管两者的引用
+inline rep* join(rep* a, rep* b)
+{
+	if (a == nullptr)
+		return b;
+	if (b == nullptr)
+		return a;
+	// 两个小叶节点合并为一个 flat
+	if (a->height == 0 && b->height == 0 && a->length + b->length <= kMaxCopyLength)
+	{
+		flat_rep* f = nullptr;
+		MYSTL_TRY
+		{
+			f = new_flat(a->length + b->length);
+		}
+		MYSTL_CATCH_ALL
+		{
+			unref(a);
+			unref(b);
+			MYSTL_RETHROW;
+		}
+		std::memcpy(f->data(), leaf_data(a), a->length);
+		std::memcpy(f->data() + a->length, leaf_data(b), b->length);
+		f->length = a->length + b->length;
+		unref(a);
+		unref(b);
+		return f;
+	}
+	if (a->height > b->height + 1)
+	{
+		concat_rep* ca = static_cast<concat_rep*>(a);
+		rep* a1 = ref(ca->left);
+		rep* a2 = ref(ca->right);
+		unref(a);
+		rep* right = nullptr;
+		MYSTL_TRY
+		{
+			right = join(a2, b);
+		}
+		MYSTL_CATCH_ALL
+		{
+			unref(a1);
+			MYSTL_RETHROW;
+		}
+		return balance(a1, right);
+	}
+	if (b->height > a->height + 1)
+	{
+		concat_rep* cb = static_cast<concat_rep*>(b);
+		rep* b1 = ref(cb->left);
+		rep* b2 = ref(cb->right);
+		unref(b);
+		rep* left = nullptr;
+		MYSTL_TRY
+		{
+			left = join(a, b1);
+		}
+		MYSTL_CATCH_ALL
+		{
+			unref(b2);
+			MYSTL_RETHROW;
+		}
+		return balance(left, b2);
+	}
+	return new_concat(a, b);
+}
+
+// [pos, pos + n) 部分, 返回新的引用, 不改变 r 的引用计数
+inline rep* subtree(rep* r, size_t pos, size_t n)
+{
+	if (n == 0)
+		return nullptr;
+	if (pos == 0 && n == r->length)
+		return ref(r);
+	switch (r->kind)
+	{
+	case kFlat:
+		return new_substring(static_cast<flat_rep*>(ref(r)), pos, n);
+	case kSubstring:
+	{
+		substring_rep* s = static_cast<substring_rep*>(r);
+		return new_substring(static_cast<flat_rep*>(ref(s->child)), s->start + pos, n);
+	}
+	default:
+	{
+		concat_rep* c = static_cast<concat_rep*>(r);
+		const size_t left_len = c->left->length;
+		if (pos + n <= left_len)
+			return subtree(c->left, pos, n);
+		if (pos >= left_len)
+			return subtree(c->right, pos - left_len, n);
+		rep* a = subtree(c->left, pos, left_len - pos);
+		rep* b = nullptr;
+		MYSTL_TRY
+		{
+			b = subtree(c->right, 0, n - (left_len - pos));
+		}
+		MYSTL_CATCH_ALL
+		{
+			unref(a);
+			MYSTL_RETHROW;
+		}
+		return join(a, b);
+	}
+	}
+}
+
+// 用 [s, s + n) 建一棵平衡的树, 每个 flat 不超过 kMaxFlatLength; 最后一块至少预留 min_capacity 的容量
+inline rep* build(const char* s, size_t n, size_t min_capacity)
+{
+	if (n <= kMaxFlatLength)
+		return new_flat(s, n, mystl::max(n, min_capacity));
+	const size_t chunks = (n + kMaxFlatLength - 1) / kMaxFlatLength;
+	const size_t left_len = (chunks / 2) * kMaxFlatLength;
+	rep* left = build(s, left_len, 0);
+	rep* right = nullptr;
+	MYSTL_TRY
+	{
+		right = build(s + left_len, n - left_len, min_capacity);
+	}
+	MYSTL_CATCH_ALL
+	{
+		unref(left);
+		MYSTL_RETHROW;
+	}
+	return new_concat(left, right);
+}
+
+} // namespace cord_detail
+
+/*****************************************************************************************/
+// cord
+/*****************************************************************************************/
+
+class cord
+{
+public:
+	typedef char      value_type;
+	typedef size_t    size_type;
+	typedef ptrdiff_t difference_type;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+	// 按顺序遍历各个叶节点的内容
+	class chunk_iterator : public mystl::iterator<mystl::input_iterator_tag, string_view,
+	                                              ptrdiff_t, const string_view*, const string_view&>
+	{
+	private:
+		// 尚未访问的右子树
+		const cord_detail::rep* stack_[cord_detail::kMaxHeight];
+		size_t                  depth_;
+		string_view             chunk_;
+
+		friend class cord;
+
+		explicit chunk_iterator(const cord_detail::rep* root) noexcept
+			:depth_(0)
+		{
+			if (root != nullptr)
+				descend(root);
+		}
+
+		// 走到 r 最左侧的叶节点, 沿途记下右子树
+		void descend(const cord_detail::rep* r) noexcept
+		{
+			while (r->kind == cord_detail::kConcat)
+			{
+				const cord_detail::concat_rep* c = static_cast<const cord_detail::concat_rep*>(r);
+				MYSTL_DEBUG(depth_ < cord_detail::kMaxHeight);
+				stack_[depth_++] = c->right;
+				r = c->left;
+			}
+			chunk_ = string_view(cord_detail::leaf_data(r), r->length);
+		}
+
+	public:
+		chunk_iterator() noexcept
+			:depth_(0)
+		{
+		}
+
+		const string_view& operator*()  const noexcept { return chunk_; }
+		const string_view* operator->() const noexcept { return &chunk_; }
+
+		chunk_iterator& operator++() noexcept
+		{
+			if (depth_ == 0)
+				chunk_ = string_view();
+			else
+				descend(stack_[--depth_]);
+			return *this;
+		}
+
+		chunk_iterator operator++(int) noexcept
+		{
+			chunk_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		// 结束时 chunk_ 为空, 叶节点的内容都不为空
+		bool operator==(const chunk_iterator& rhs) const noexcept
+		{ return chunk_.data() == rhs.chunk_.data() && chunk_.size() == rhs.chunk_.size(); }
+		bool operator!=(const chunk_iterator& rhs) const noexcept
+		{ return !(*this == rhs); }
+	};
+
+	// chunks() 的返回值, 用于范围 for
+	class chunk_range
+	{
+	private:
+		const cord_detail::rep* root_;
+
+	public:
+		explicit chunk_range(const cord_detail::rep* root) noexcept
+			:root_(root)
+		{
+		}
+
+		chunk_iterator begin() const noexcept { return chunk_iterator(root_); }
+		chunk_iterator end()   const noexcept { return chunk_iterator(); }
+	};
+
+private:
+	cord_detail::rep* root_;  // 为空时表示空字符串
+
+public:
+	// 构造、复制、移动、析构函数
+	cord() noexcept
+		:root_(nullptr)
+	{
+	}
+
+	explicit cord(string_view s)
+		:root_(nullptr)
+	{
+		if (!s.empty())
+			root_ = cord_detail::build(s.data(), s.size(), 0);
+	}
+
+	explicit cord(const char* s)
+		:cord(string_view(s))
+	{
+	}
+
+	cord(const cord& rhs) noexcept
+		:root_(cord_detail::ref(rhs.root_))
+	{
+	}
+
+	cord(cord&& rhs) noexcept
+		:root_(rhs.root_)
+	{
+		rhs.root_ = nullptr;
+	}
+
+	cord& operator=(const cord& rhs) noexcept
+	{
+		cord_detail::rep* old = root_;
+		root_ = cord_detail::ref(rhs.root_);
+		cord_detail::unref(old);
+		return *this;
+	}
+
+	cord& operator=(cord&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			cord_detail::unref(root_);
+			root_ = rhs.root_;
+			rhs.root_ = nullptr;
+		}
+		return *this;
+	}
+
+	cord& operator=(string_view s)
+	{
+		cord tmp(s);
+		swap(tmp);
+		return *this;
+	}
+
+	~cord()
+	{ cord_detail::unref(root_); }
+
+public:
+	// 容量相关操作
+	size_type size()   const noexcept { return root_ == nullptr ? 0 : root_->length; }
+	size_type length() const noexcept { return size(); }
+	bool      empty()  const noexcept { return root_ == nullptr; }
+
+	// 访问元素相关操作, O(log n)
+	char operator[](size_type n) const noexcept
+	{
+		MYSTL_DEBUG(n < size());
+		const cord_detail::rep* r = root_;
+		while (r->kind == cord_detail::kConcat)
+		{
+			const cord_detail::concat_rep* c = static_cast<const cord_detail::concat_rep*>(r);
+			if (n < c->left->length)
+			{
+				r = c->left;
+			}
+			else
+			{
+				n -= c->left->length;
+				r = c->right;
+			}
+		}
+		return cord_detail::leaf_data(r)[n];
+	}
+
+	char at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(n >= size(), "cord::at() subscript out of range");
+		return (*this)[n];
+	}
+
+	// 按顺序访问各个块
+	chunk_range    chunks()      const noexcept { return chunk_range(root_); }
+	chunk_iterator chunk_begin() const noexcept { return chunk_iterator(root_); }
+	chunk_iterator chunk_end()   const noexcept { return chunk_iterator(); }
+
+	// 对每个块调用 f(string_view)
+	template <class Function>
+	void for_each_chunk(Function f) const
+	{
+		for (chunk_iterator it = chunk_begin(); it != chunk_end(); ++it)
+			f(*it);
+	}
+
+	// 内容只有一块时返回它, 否则返回空视图, 不复制
+	string_view try_flat() const noexcept
+	{
+		if (root_ == nullptr || root_->kind == cord_detail::kConcat)
+			return string_view();
+		return string_view(cord_detail::leaf_data(root_), root_->length);
+	}
+
+	// 把内容合并为一整块并返回, 之后的 try_flat / flatten 不再复制
+	string_view flatten();
+
+	// 复制 [pos, pos + count) 到 dst, 返回复制的字符数
+	size_type copy(char* dst, size_type count, size_type pos = 0) const;
+
+	mystl::string to_string() const
+	{
+		mystl::string s;
+		s.resize_and_overwrite(size(), [this](char* p, size_t n) { return copy(p, n); });
+		return s;
+	}
+
+	// 修改容器相关操作
+
+	void clear() noexcept
+	{
+		cord_detail::unref(root_);
+		root_ = nullptr;
+	}
+
+	cord& append(string_view s);
+	cord& append(const cord& rhs)
+	{
+		reset(cord_detail::join(cord_detail::ref(root_), cord_detail::ref(rhs.root_)));
+		return *this;
+	}
+	cord& append(cord&& rhs)
+	{
+		reset(cord_detail::join(cord_detail::ref(root_), cord_detail::ref(rhs.root_)));
+		rhs.clear();
+		return *this;
+	}
+
+	cord& prepend(string_view s)
+	{
+		if (!s.empty())
+		{
+			cord_detail::rep* head = cord_detail::build(s.data(), s.size(), 0);
+			reset(cord_detail::join(head, cord_detail::ref(root_)));
+		}
+		return *this;
+	}
+	cord& prepend(const cord& rhs)
+	{
+		reset(cord_detail::join(cord_detail::ref(rhs.root_), cord_detail::ref(root_)));
+		return *this;
+	}
+
+	cord& operator+=(string_view s)   { return append(s); }
+	cord& operator+=(const cord& rhs) { return append(rhs); }
+	cord& operator+=(cord&& rhs)      { return append(mystl::move(rhs)); }
+
+	cord& insert(size_type pos, string_view s)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "cord::insert's pos out of range");
+		if (s.empty())
+			return *this;
+		return splice(pos, 0, cord_detail::build(s.data(), s.size(), 0));
+	}
+	cord& insert(size_type pos, const cord& rhs)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "cord::insert's pos out of range");
+		return splice(pos, 0, cord_detail::ref(rhs.root_));
+	}
+
+	cord& erase(size_type pos, size_type count = npos)
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "cord::erase's pos out of range");
+		return splice(pos, mystl::min(count, size() - pos), nullptr);
+	}
+
+	cord substr(size_type pos, size_type count = npos) const
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size(), "cord::substr's pos out of range");
+		cord r;
+		if (root_ != nullptr)
+			r.root_ = cord_detail::subtree(root_, pos, mystl::min(count, size() - pos));
+		return r;
+	}
+
+	void swap(cord& rhs) noexcept
+	{ mystl::swap(root_, rhs.root_); }
+
+	// 比较
+	int compare(string_view s) const noexcept;
+	int compare(const cord& rhs) const noexcept;
+
+private:
+	// helper functions
+
+	// 替换根节点(接管 r 的引用)
+	// 修改操作先在 root_ 的额外引用上构造新树, 成功后再替换, 失败时 root_ 保持不变
+	void reset(cord_detail::rep* r) noexcept
+	{
+		cord_detail::unref(root_);
+		root_ = r;
+	}
+
+	// 把 [pos, pos + n) 替换为 mid(接管其引用)
+	cord& splice(size_type pos, size_type n, cord_detail::rep* mid);
+	// 尝试把 s 的开头写入最右侧 flat 的剩余空间, 返回写入的字符数
+	size_type append_in_place(string_view s) noexcept;
+	// 撤销 append_in_place 写入的 n 个字符
+	void      undo_append_in_place(size_type n) noexcept;
+};
+
+constexpr cord::size_type cord::npos;
+
+/*****************************************************************************************/
+
+inline string_view cord::flatten()
+{
+	if (root_ == nullptr)
+		return string_view();
+	if (root_->kind != cord_detail::kConcat)
+		return try_flat();
+	const size_type n = root_->length;
+	cord_detail::flat_rep* f = cord_detail::new_flat(n);
+	copy(f->data(), n);
+	f->length = n;
+	reset(f);
+	return string_view(f->data(), n);
+}
+
+inline cord::size_type cord::copy(char* dst, size_type count, size_type pos) const
+{
+	THROW_OUT_OF_RANGE_IF(pos > size(), "cord::copy's pos out of range");
+	const size_type n = mystl::min(count, size() - pos);
+	size_type done = 0;
+	for (chunk_iterator it = chunk_begin(); it != chunk_end() && done < n; ++it)
+	{
+		string_view c = *it;
+		if (pos >= c.size())
+		{
+			pos -= c.size();
+			continue;
+		}
+		c.remove_prefix(pos);
+		pos = 0;
+		const size_type k = mystl::min(c.size(), n - done);
+		std::memcpy(dst + done, c.data(), k);
+		done += k;
+	}
+	return n;
+}
+
+inline cord& cord::append(string_view s)
+{
+	if (s.empty())
+		return *this;
+	const size_type k = root_ == nullptr ? 0 : append_in_place(s);
+	s.remove_prefix(k);
+	if (s.empty())
+		return *this;
+	cord_detail::rep* r = nullptr;
+	MYSTL_TRY
+	{
+		cord_detail::rep* tail = cord_detail::build(s.data(), s.size(), cord_detail::kMinAppendCapacity);
+		r = cord_detail::join(cord_detail::ref(root_), tail);
+	}
+	MYSTL_CATCH_ALL
+	{
+		undo_append_in_place(k);
+		MYSTL_RETHROW;
+	}
+	reset(r);
+	return *this;
+}
+
+inline cord::size_type cord::append_in_place(string_view s) noexcept
+{
+	cord_detail::rep* path[cord_detail::kMaxHeight];
+	size_t depth = 0;
+	cord_detail::rep* r = root_;
+	while (r->kind == cord_detail::kConcat)
+	{
+		if (!cord_detail::is_unique(r))
+			return 0;
+		path[depth++] = r;
+		r = static_cast<cord_detail::concat_rep*>(r)->right;
+	}
+	if (r->kind != cord_detail::kFlat || !cord_detail::is_unique(r))
+		return 0;
+	cord_detail::flat_rep* f = static_cast<cord_detail::flat_rep*>(r);
+	const size_type k = mystl::min(f->capacity - f->length, s.size());
+	if (k == 0)
+		return 0;
+	std::memcpy(f->data() + f->length, s.data(), k);
+	f->length += k;
+	for (size_t i = 0; i < depth; ++i)
+		path[i]->length += k;
+	return k;
+}
+
+inline void cord::undo_append_in_place(size_type n) noexcept
+{
+	if (n == 0)
+		return;
+	cord_detail::rep* r = root_;
+	for (;;)
+	{
+		r->length -= n;
+		if (r->kind != cord_detail::kConcat)
+			break;
+		r = static_cast<cord_detail::concat_rep*>(r)->right;
+	}
+}
+
+inline cord& cord::splice(size_type pos, size_type n, cord_detail::rep* mid)
+{
+	const size_type sz = size();
+	cord_detail::rep* left = nullptr;
+	cord_detail::rep* right = nullptr;
+	MYSTL_TRY
+	{
+		left = root_ == nullptr ? nullptr : cord_detail::subtree(root_, 0, pos);
+		right = root_ == nullptr ? nullptr : cord_detail::subtree(root_, pos + n, sz - pos - n);
+	}
+	MYSTL_CATCH_ALL
+	{
+		cord_detail::unref(left);
+		cord_detail::unref(mid);
+		MYSTL_RETHROW;
+	}
+	cord_detail::rep* r = nullptr;
+	MYSTL_TRY
+	{
+		r = cord_detail::join(left, mid);
+	}
+	MYSTL_CATCH_ALL
+	{
+		cord_detail::unref(right);
+		MYSTL_RETHROW;
+	}
+	reset(cord_detail::join(r, right));
+	return *this;
+}
+
+inline int cord::compare(string_view s) const noexcept
+{
+	size_type pos = 0;
+	for (chunk_iterator it = chunk_begin(); it != chunk_end(); ++it)
+	{
+		const string_view c = *it;
+		const size_type k = mystl::min(c.size(), s.size() - pos);
+		const int r = char_traits<char>::compare(c.data(), s.data() + pos, k);
+		if (r != 0)
+			return r;
+		if (k < c.size())
+			return 1;
+		pos += k;
+	}
+	return pos < s.size() ? -1 : 0;
+}
+
+inline int cord::compare(const cord& rhs) const noexcept
+{
+	if (root_ == rhs.root_)
+		return 0;
+	chunk_iterator a = chunk_begin(), b = rhs.chunk_begin();
+	const chunk_iterator end;
+	string_view ca = a == end ? string_view() : *a;
+	string_view cb = b == end ? string_view() : *b;
+	for (;;)
+	{
+		if (ca.empty())
+		{
+			if (a != end && ++a != end)
+			{
+				ca = *a;
+				continue;
+			}
+			break;
+		}
+		if (cb.empty())
+		{
+			if (b != end && ++b != end)
+			{
+				cb = *b;
+				continue;
+			}
+			break;
+		}
+		const size_type k = mystl::min(ca.size(), cb.size());
+		const int r = char_traits<char>::compare(ca.data(), cb.data(), k);
+		if (r != 0)
+			return r;
+		ca.remove_prefix(k);
+		cb.remove_prefix(k);
+	}
+	const size_type la = size(), lb = rhs.size();
+	return la < lb ? -1 : (la > lb ? 1 : 0);
+}
+
+// 重载比较操作符
+inline bool operator==(const cord& lhs, const cord& rhs) noexcept
+{
+	return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+inline bool operator==(const cord& lhs, string_view rhs) noexcept
+{
+	return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+inline bool operator==(string_view lhs, const cord& rhs) noexcept
+{
+	return rhs == lhs;
+}
+
+inline bool operator!=(const cord& lhs, const cord& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+inline bool operator!=(const cord& lhs, string_view rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+inline bool operator!=(string_view lhs, const cord& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+inline bool operator<(const cord& lhs, const cord& rhs) noexcept
+{
+	return lhs.compare(rhs) < 0;
+}
+
+inline bool operator>(const cord& lhs, const cord& rhs) noexcept
+{
+	return rhs < lhs;
+}
+
+inline bool operator<=(const cord& lhs, const cord& rhs) noexcept
+{
+	return !(rhs < lhs);
+}
+
+inline bool operator>=(const cord& lhs, const cord& rhs) noexcept
+{
+	return !(lhs < rhs);
+}
+
+// 重载 operator+
+inline cord operator+(const cord& lhs, const cord& rhs)
+{
+	cord tmp(lhs);
+	tmp.append(rhs);
+	return tmp;
+}
+
+inline cord operator+(cord&& lhs, const cord& rhs)
+{
+	lhs.append(rhs);
+	return mystl::move(lhs);
+}
+
+// 重载 mystl 的 swap
+inline void swap(cord& lhs, cord& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_CORD_H_
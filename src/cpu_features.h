@@ -0,0 +1,91 @@
+#ifndef MYTINYSTL_CPU_FEATURES_H_
+#define MYTINYSTL_CPU_FEATURES_H_
+
+// 这个头文件包含运行时的 CPU 特性检测, 以及选择指令集所用的宏
+// cpu_features     : 当前 CPU 支持的指令集扩展
+// get_cpu_features : 第一次调用时检测, 之后直接返回结果
+
+// notes:
+//
+// 需要较新指令集(AVX2 等)的函数有两种用法:
+//   * 编译时已开启(如 -mavx2, 此时定义了 __AVX2__): 直接使用, 不必检测
+//   * 编译时未开启: 用 MYSTL_TARGET_AVX2 等宏单独为该函数开启指令集, 调用前用 get_cpu_features() 检测,
+//     这样同一份程序在老 CPU 上仍能运行
+// 只有 x86 上的 GCC / Clang 支持按函数开启指令集(MYSTL_HAS_TARGET_DISPATCH), 其余情况只使用编译时开启的指令集
+// 定义 MYSTL_NO_RUNTIME_DISPATCH 可以关闭运行时选择
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace mystl
+{
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MYSTL_ARCH_X86 1
+#endif
+
+#if defined(MYSTL_ARCH_X86) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(MYSTL_NO_RUNTIME_DISPATCH)
+#define MYSTL_HAS_TARGET_DISPATCH 1
+#define MYSTL_TARGET_POPCNT __attribute__((target("popcnt")))
+#define MYSTL_TARGET_AVX2   __attribute__((target("avx2")))
+#else
+#define MYSTL_TARGET_POPCNT
+#define MYSTL_TARGET_AVX2
+#endif
+
+// 当前 CPU 支持的指令集扩展
+struct cpu_features
+{
+	bool sse42  = false;
+	bool popcnt = false;
+	bool bmi1   = false;
+	bool bmi2   = false;
+	bool avx2   = false;
+};
+
+namespace cpu_detail
+{
+
+inline cpu_features detect() noexcept
+{
+	cpu_features f;
+#if defined(MYSTL_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+	__builtin_cpu_init();
+	f.sse42  = __builtin_cpu_supports("sse4.2") != 0;
+	f.popcnt = __builtin_cpu_supports("popcnt") != 0;
+	f.bmi1   = __builtin_cpu_supports("bmi") != 0;
+	f.bmi2   = __builtin_cpu_supports("bmi2") != 0;
+	f.avx2   = __builtin_cpu_supports("avx2") != 0;
+#elif defined(MYSTL_ARCH_X86) && defined(_MSC_VER)
+	int regs[4] = {};
+	__cpuid(regs, 0);
+	const int max_leaf = regs[0];
+	__cpuid(regs, 1);
+	f.sse42  = (regs[2] & (1 << 20)) != 0;
+	f.popcnt = (regs[2] & (1 << 23)) != 0;
+	// AVX2 还要求操作系统保存 YMM 寄存器(OSXSAVE 且 XCR0 的第 1, 2 位)
+	const bool os_ymm = (regs[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+	if (max_leaf >= 7)
+	{
+		__cpuidex(regs, 7, 0);
+		f.bmi1 = (regs[1] & (1 << 3)) != 0;
+		f.bmi2 = (regs[1] & (1 << 8)) != 0;
+		f.avx2 = os_ymm && (regs[1] & (1 << 5)) != 0;
+	}
+#endif
+	return f;
+}
+
+} // namespace cpu_detail
+
+// 第一次调用时检测, 结果保存在局部静态变量中, 可以在多个线程中同时调用
+inline const cpu_features& get_cpu_features() noexcept
+{
+	static const cpu_features features = cpu_detail::detect();
+	return features;
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_CPU_FEATURES_H_
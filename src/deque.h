@@ -0,0 +1,1150 @@
+#ifndef MYTINYSTL_DEQUE_H_
+#define MYTINYSTL_DEQUE_H_
+
+// 这个头文件包含一个模板类 deque
+// deque: 双端队列
+
+// notes:
+//
+// 元素存放在若干个大小固定的块(block)中, 由一个中控器(map)按顺序记录各个块的地址:
+//   * 块的大小(元素个数)是模板参数, 缺省约为 4 KiB, 两端插入删除都不会移动已有元素
+//   * 迭代器在块内前进只是指针加一, 到达块末尾时才经由中控器跳到下一个块
+//   * 一端需要新的块而中控器在这一端已无空位时, 若中控器总体空位足够, 就把已用部分平移到中间,
+//     只有已用部分超过一半时才重新分配更大的中控器
+//   * 因 pop 而空出来的块不立即释放, 最多缓存 kMaxSpareBlocks 个, 之后 push 需要新块时优先复用,
+//     因此稳定状态下(例如作为先进先出的工作队列)反复 push_back / pop_front 不会再申请内存;
+//     shrink_to_fit 会释放缓存的块
+//
+// 异常保证：
+// mystl::deque<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_back
+//   * emplace
+//   * push_front
+//   * push_back
+//   * insert
+
+#include <initializer_list>
+
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+#include "algo.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 缺省的块大小: 约 4 KiB 的元素, 元素很大时至少 16 个
+template <class T>
+struct deque_block_size
+{
+	static constexpr size_t value = sizeof(T) <= 256 ? 4096 / sizeof(T) : 16;
+};
+
+template <class T>
+constexpr size_t deque_block_size<T>::value;
+
+// deque 的迭代器设计
+template <class T, class Ref, class Ptr, size_t BlockSize>
+struct deque_iterator : public iterator<random_access_iterator_tag, T>
+{
+	typedef deque_iterator<T, T&, T*, BlockSize>             iterator;
+	typedef deque_iterator<T, const T&, const T*, BlockSize> const_iterator;
+	typedef deque_iterator                                   self;
+
+	typedef T            value_type;
+	typedef Ptr          pointer;
+	typedef Ref          reference;
+	typedef size_t       size_type;
+	typedef ptrdiff_t    difference_type;
+	typedef T*           value_pointer;
+	typedef T**          map_pointer;
+
+	static constexpr size_type buffer_size = BlockSize;
+
+	// 迭代器所含成员数据
+	value_pointer cur;    // 指向所在块的当前元素
+	value_pointer first;  // 指向所在块的头部
+	value_pointer last;   // 指向所在块的尾部
+	map_pointer   node;   // 所在块在中控器中的位置
+
+	// 构造、复制、移动函数
+	deque_iterator() noexcept
+		:cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
+
+	deque_iterator(value_pointer v, map_pointer n)
+		:cur(v), first(*n), last(*n + buffer_size), node(n) {}
+
+	deque_iterator(const iterator& rhs)
+		:cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node)
+	{
+	}
+	deque_iterator(const const_iterator& rhs)
+		:cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node)
+	{
+	}
+
+	self& operator=(const iterator& rhs)
+	{
+		if (this != &rhs)
+		{
+			cur = rhs.cur;
+			first = rhs.first;
+			last = rhs.last;
+			node = rhs.node;
+		}
+		return *this;
+	}
+
+	// 转到另一个块
+	void set_node(map_pointer new_node)
+	{
+		node = new_node;
+		first = *new_node;
+		last = first + buffer_size;
+	}
+
+	// 重载运算符
+	reference operator*()  const { return *cur; }
+	pointer   operator->() const { return cur; }
+
+	difference_type operator-(const self& x) const
+	{
+		return static_cast<difference_type>(buffer_size) * (node - x.node)
+			+ (cur - first) - (x.cur - x.first);
+	}
+
+	// 块内前进只是指针加一
+	self& operator++()
+	{
+		++cur;
+		if (cur == last)
+		{
+			set_node(node + 1);
+			cur = first;
+		}
+		return *this;
+	}
+	self operator++(int)
+	{
+		self tmp = *this;
+		++*this;
+		return tmp;
+	}
+
+	self& operator--()
+	{
+		if (cur == first)
+		{
+			set_node(node - 1);
+			cur = last;
+		}
+		--cur;
+		return *this;
+	}
+	self operator--(int)
+	{
+		self tmp = *this;
+		--*this;
+		return tmp;
+	}
+
+	self& operator+=(difference_type n)
+	{
+		const auto offset = n + (cur - first);
+		if (offset >= 0 && offset < static_cast<difference_type>(buffer_size))
+		{ // 仍在当前块内
+			cur += n;
+		}
+		else
+		{ // 要跳到其他的块
+			const auto node_offset = offset > 0
+				? offset / static_cast<difference_type>(buffer_size)
+				: -static_cast<difference_type>((-offset - 1) / buffer_size) - 1;
+			set_node(node + node_offset);
+			cur = first + (offset - node_offset * static_cast<difference_type>(buffer_size));
+		}
+		return *this;
+	}
+	self operator+(difference_type n) const
+	{
+		self tmp = *this;
+		return tmp += n;
+	}
+	self& operator-=(difference_type n)
+	{
+		return *this += -n;
+	}
+	self operator-(difference_type n) const
+	{
+		self tmp = *this;
+		return tmp -= n;
+	}
+
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	// 重载比较操作符
+	bool operator==(const self& rhs) const { return cur == rhs.cur; }
+	bool operator< (const self& rhs) const
+	{ return node == rhs.node ? (cur < rhs.cur) : (node < rhs.node); }
+	bool operator!=(const self& rhs) const { return !(*this == rhs); }
+	bool operator> (const self& rhs) const { return rhs < *this; }
+	bool operator<=(const self& rhs) const { return !(rhs < *this); }
+	bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+template <class T, class Ref, class Ptr, size_t BlockSize>
+constexpr size_t deque_iterator<T, Ref, Ptr, BlockSize>::buffer_size;
+
+// 模板类 deque
+// 模板参数一代表数据类型，参数二代表每个块的元素个数
+template <class T, size_t BlockSize = deque_block_size<T>::value>
+class deque
+{
+	static_assert(BlockSize > 0, "deque block size must be positive");
+
+public:
+	// deque 的型别定义
+	typedef mystl::allocator<T>                      allocator_type;
+	typedef mystl::allocator<T>                      data_allocator;
+	typedef mystl::allocator<T*>                     map_allocator;
+
+	typedef typename allocator_type::value_type      value_type;
+	typedef typename allocator_type::pointer         pointer;
+	typedef typename allocator_type::const_pointer   const_pointer;
+	typedef typename allocator_type::reference       reference;
+	typedef typename allocator_type::const_reference const_reference;
+	typedef typename allocator_type::size_type       size_type;
+	typedef typename allocator_type::difference_type difference_type;
+	typedef pointer*                                 map_pointer;
+	typedef const_pointer*                           const_map_pointer;
+
+	typedef deque_iterator<T, T&, T*, BlockSize>             iterator;
+	typedef deque_iterator<T, const T&, const T*, BlockSize> const_iterator;
+	typedef mystl::reverse_iterator<iterator>                reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>          const_reverse_iterator;
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	static constexpr size_type buffer_size = BlockSize;
+	// 缓存的空闲块的最大个数
+	static constexpr size_type kMaxSpareBlocks = 4;
+	// 中控器的初始大小
+	static constexpr size_type kMapInitSize = 8;
+
+private:
+	// 用以下数据来表现一个 deque
+	iterator    begin_;     // 指向第一个节点
+	iterator    end_;       // 指向最后一个结点的下一个位置
+	map_pointer map_;       // 指向一块 map，map 中的每个元素都是一个指针，指向一个块
+	size_type   map_size_;  // map 内指针的数目
+
+	pointer     spare_[kMaxSpareBlocks];  // 缓存的空闲块
+	size_type   spare_count_;             // 缓存的空闲块个数
+
+public:
+	// 构造、复制、移动、析构函数
+
+	deque()
+	{ map_init(0); }
+
+	explicit deque(size_type n)
+	{ fill_init(n, value_type()); }
+
+	deque(size_type n, const value_type& value)
+	{ fill_init(n, value); }
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	deque(IIter first, IIter last)
+	{ copy_init(first, last, iterator_category(first)); }
+
+	deque(std::initializer_list<value_type> ilist)
+	{
+		copy_init(ilist.begin(), ilist.end(), mystl::forward_iterator_tag());
+	}
+
+	deque(const deque& rhs)
+	{
+		copy_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag());
+	}
+	deque(deque&& rhs) noexcept
+		:begin_(rhs.begin_),
+		 end_(rhs.end_),
+		 map_(rhs.map_),
+		 map_size_(rhs.map_size_),
+		 spare_count_(rhs.spare_count_)
+	{
+		for (size_type i = 0; i < spare_count_; ++i)
+			spare_[i] = rhs.spare_[i];
+		rhs.begin_ = iterator();
+		rhs.end_ = iterator();
+		rhs.map_ = nullptr;
+		rhs.map_size_ = 0;
+		rhs.spare_count_ = 0;
+	}
+
+	deque& operator=(const deque& rhs);
+	deque& operator=(deque&& rhs);
+
+	deque& operator=(std::initializer_list<value_type> ilist)
+	{
+		deque tmp(ilist);
+		swap(tmp);
+		return *this;
+	}
+
+	~deque()
+	{
+		if (map_ != nullptr)
+		{
+			clear();
+			put_block(*begin_.node);
+			release_spare_blocks();
+			map_allocator::deallocate(map_, map_size_);
+			map_ = nullptr;
+		}
+	}
+
+public:
+	// 迭代器相关操作
+
+	iterator               begin()         noexcept
+	{ return begin_; }
+	const_iterator         begin()   const noexcept
+	{ return begin_; }
+	iterator               end()           noexcept
+	{ return end_; }
+	const_iterator         end()     const noexcept
+	{ return end_; }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept
+	{ return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept
+	{ return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return begin(); }
+	const_iterator         cend()    const noexcept
+	{ return end(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关操作
+
+	bool      empty()    const noexcept { return begin() == end(); }
+	size_type size()     const noexcept { return end_ - begin_; }
+	size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(value_type); }
+	void      resize(size_type new_size) { resize(new_size, value_type()); }
+	void      resize(size_type new_size, const value_type& value);
+	void      shrink_to_fit() noexcept;
+
+	// 访问元素相关操作
+	reference       operator[](size_type n)
+	{
+		MYSTL_DEBUG(n < size());
+		return begin_[n];
+	}
+	const_reference operator[](size_type n) const
+	{
+		MYSTL_DEBUG(n < size());
+		return begin_[n];
+	}
+
+	reference       at(size_type n)
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size()), "deque<T>::at() subscript out of range");
+		return (*this)[n];
+	}
+	const_reference at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size()), "deque<T>::at() subscript out of range");
+		return (*this)[n];
+	}
+
+	reference       front()
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+	const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+	reference       back()
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end() - 1);
+	}
+	const_reference back() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end() - 1);
+	}
+
+	// 修改容器相关操作
+
+	// assign
+
+	void     assign(size_type n, const value_type& value)
+	{ fill_assign(n, value); }
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	void     assign(IIter first, IIter last)
+	{ copy_assign(first, last, iterator_category(first)); }
+
+	void     assign(std::initializer_list<value_type> ilist)
+	{ copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{}); }
+
+	// emplace_front / emplace_back / emplace
+
+	template <class ...Args>
+	void     emplace_front(Args&& ...args);
+	template <class ...Args>
+	void     emplace_back(Args&& ...args);
+	template <class ...Args>
+	iterator emplace(iterator pos, Args&& ...args);
+
+	// push_front / push_back
+
+	void     push_front(const value_type& value)
+	{ emplace_front(value); }
+	void     push_back(const value_type& value)
+	{ emplace_back(value); }
+
+	void     push_front(value_type&& value) { emplace_front(mystl::move(value)); }
+	void     push_back(value_type&& value)  { emplace_back(mystl::move(value)); }
+
+	// pop_back / pop_front
+
+	void     pop_front();
+	void     pop_back();
+
+	// insert
+
+	iterator insert(iterator position, const value_type& value)
+	{ return emplace(position, value); }
+	iterator insert(iterator position, value_type&& value)
+	{ return emplace(position, mystl::move(value)); }
+	void     insert(iterator position, size_type n, const value_type& value);
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	void     insert(iterator position, IIter first, IIter last)
+	{ insert_dispatch(position, first, last, iterator_category(first)); }
+
+	void     insert(iterator position, std::initializer_list<value_type> ilist)
+	{ insert_dispatch(position, ilist.begin(), ilist.end(), mystl::forward_iterator_tag()); }
+
+	// erase /clear
+
+	iterator erase(iterator position);
+	iterator erase(iterator first, iterator last);
+	void     clear();
+
+	// swap
+
+	void     swap(deque& rhs) noexcept;
+
+private:
+	// helper functions
+
+	// 块的申请与释放, 优先使用缓存的空闲块
+	pointer  get_block();
+	void     put_block(pointer block) noexcept;
+	void     release_spare_blocks() noexcept;
+
+	// 中控器
+	void     map_init(size_type nelem);
+	void     reserve_map_at_back(size_type n = 1);
+	void     reserve_map_at_front(size_type n = 1);
+	void     reallocate_map(size_type nodes_to_add, bool add_at_front);
+
+	// initialize
+	void     fill_init(size_type n, const value_type& value);
+	template <class IIter>
+	void     copy_init(IIter first, IIter last, input_iterator_tag);
+	template <class FIter>
+	void     copy_init(FIter first, FIter last, forward_iterator_tag);
+
+	// assign
+	void     fill_assign(size_type n, const value_type& value);
+	template <class IIter>
+	void     copy_assign(IIter first, IIter last, input_iterator_tag);
+	template <class FIter>
+	void     copy_assign(FIter first, FIter last, forward_iterator_tag);
+
+	// insert
+	template <class IIter>
+	void     insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag);
+	template <class FIter>
+	void     insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag);
+	template <class FIter>
+	void     insert_front_rotate(iterator position, FIter first, size_type n);
+	template <class FIter>
+	void     insert_back_rotate(iterator position, FIter first, size_type n);
+};
+
+template <class T, size_t BlockSize>
+constexpr typename deque<T, BlockSize>::size_type deque<T, BlockSize>::buffer_size;
+template <class T, size_t BlockSize>
+constexpr typename deque<T, BlockSize>::size_type deque<T, BlockSize>::kMaxSpareBlocks;
+template <class T, size_t BlockSize>
+constexpr typename deque<T, BlockSize>::size_type deque<T, BlockSize>::kMapInitSize;
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <class T, size_t BlockSize>
+deque<T, BlockSize>& deque<T, BlockSize>::operator=(const deque& rhs)
+{
+	if (map_ == nullptr)
+	{ // 被移动过的 deque 没有中控器
+		deque tmp(rhs);
+		swap(tmp);
+	}
+	else if (this != &rhs)
+	{
+		const auto len = size();
+		if (len >= rhs.size())
+		{
+			erase(mystl::copy(rhs.begin_, rhs.end_, begin_), end_);
+		}
+		else
+		{
+			iterator mid = rhs.begin() + static_cast<difference_type>(len);
+			mystl::copy(rhs.begin_, mid, begin_);
+			insert(end_, mid, rhs.end_);
+		}
+	}
+	return *this;
+}
+
+// 移动赋值运算符
+template <class T, size_t BlockSize>
+deque<T, BlockSize>& deque<T, BlockSize>::operator=(deque&& rhs)
+{
+	deque tmp(mystl::move(rhs));
+	swap(tmp);
+	return *this;
+}
+
+// 重置容器大小
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::resize(size_type new_size, const value_type& value)
+{
+	const auto len = size();
+	if (new_size < len)
+	{
+		erase(begin_ + new_size, end_);
+	}
+	else
+	{
+		insert(end_, new_size - len, value);
+	}
+}
+
+// 减小容器容量: 释放缓存的空闲块
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::shrink_to_fit() noexcept
+{
+	release_spare_blocks();
+}
+
+// 在头部就地构建元素
+template <class T, size_t BlockSize>
+template <class ...Args>
+void deque<T, BlockSize>::emplace_front(Args&& ...args)
+{
+	if (begin_.cur != begin_.first)
+	{
+		data_allocator::construct(begin_.cur - 1, mystl::forward<Args>(args)...);
+		--begin_.cur;
+	}
+	else
+	{
+		reserve_map_at_front(1);
+		*(begin_.node - 1) = get_block();
+		MYSTL_TRY
+		{
+			data_allocator::construct(*(begin_.node - 1) + (buffer_size - 1),
+			                          mystl::forward<Args>(args)...);
+		}
+		MYSTL_CATCH_ALL
+		{
+			put_block(*(begin_.node - 1));
+			MYSTL_RETHROW;
+		}
+		begin_.set_node(begin_.node - 1);
+		begin_.cur = begin_.last - 1;
+	}
+}
+
+// 在尾部就地构建元素
+// end_ 总是指向一个已分配的块, 当前块只剩最后一个位置时先准备好下一个块
+template <class T, size_t BlockSize>
+template <class ...Args>
+void deque<T, BlockSize>::emplace_back(Args&& ...args)
+{
+	if (end_.cur != end_.last - 1)
+	{
+		data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+		++end_.cur;
+	}
+	else
+	{
+		reserve_map_at_back(1);
+		*(end_.node + 1) = get_block();
+		MYSTL_TRY
+		{
+			data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+		}
+		MYSTL_CATCH_ALL
+		{
+			put_block(*(end_.node + 1));
+			MYSTL_RETHROW;
+		}
+		end_.set_node(end_.node + 1);
+		end_.cur = end_.first;
+	}
+}
+
+// 在 pos 位置就地构建元素, 移动元素较少的那一侧
+template <class T, size_t BlockSize>
+template <class ...Args>
+typename deque<T, BlockSize>::iterator
+deque<T, BlockSize>::emplace(iterator pos, Args&& ...args)
+{
+	if (pos.cur == begin_.cur)
+	{
+		emplace_front(mystl::forward<Args>(args)...);
+		return begin_;
+	}
+	if (pos.cur == end_.cur)
+	{
+		emplace_back(mystl::forward<Args>(args)...);
+		return end_ - 1;
+	}
+	value_type tmp(mystl::forward<Args>(args)...);
+	const difference_type index = pos - begin_;
+	if (static_cast<size_type>(index) < size() / 2)
+	{
+		emplace_front(mystl::move(front()));
+		pos = begin_ + index;
+		iterator front1 = begin_ + 1;
+		mystl::move(front1 + 1, pos + 1, front1);
+	}
+	else
+	{
+		emplace_back(mystl::move(back()));
+		pos = begin_ + index;
+		iterator back1 = end_ - 1;
+		mystl::move_backward(pos, back1 - 1, back1);
+	}
+	*pos = mystl::move(tmp);
+	return pos;
+}
+
+// 删除头部元素, 块空出来时放入缓存
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::pop_front()
+{
+	MYSTL_DEBUG(!empty());
+	data_allocator::destroy(begin_.cur);
+	if (begin_.cur != begin_.last - 1)
+	{
+		++begin_.cur;
+	}
+	else
+	{
+		put_block(begin_.first);
+		begin_.set_node(begin_.node + 1);
+		begin_.cur = begin_.first;
+	}
+}
+
+// 删除尾部元素
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::pop_back()
+{
+	MYSTL_DEBUG(!empty());
+	if (end_.cur != end_.first)
+	{
+		--end_.cur;
+	}
+	else
+	{
+		put_block(end_.first);
+		end_.set_node(end_.node - 1);
+		end_.cur = end_.last - 1;
+	}
+	data_allocator::destroy(end_.cur);
+}
+
+// 在 position 处插入 n 个元素
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::insert(iterator position, size_type n, const value_type& value)
+{
+	const difference_type index = position - begin_;
+	size_type done = 0;
+	MYSTL_TRY
+	{
+		for (; done < n; ++done)
+			emplace_back(value);
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (; done > 0; --done)
+			pop_back();
+		MYSTL_RETHROW;
+	}
+	mystl::rotate(begin_ + index, end_ - static_cast<difference_type>(n), end_);
+}
+
+// 删除 position 处的元素, 移动元素较少的那一侧
+template <class T, size_t BlockSize>
+typename deque<T, BlockSize>::iterator
+deque<T, BlockSize>::erase(iterator position)
+{
+	iterator next = position;
+	++next;
+	const difference_type index = position - begin_;
+	if (static_cast<size_type>(index) < size() / 2)
+	{
+		mystl::move_backward(begin_, position, next);
+		pop_front();
+	}
+	else
+	{
+		mystl::move(next, end_, position);
+		pop_back();
+	}
+	return begin_ + index;
+}
+
+// 删除 [first, last) 上的元素
+template <class T, size_t BlockSize>
+typename deque<T, BlockSize>::iterator
+deque<T, BlockSize>::erase(iterator first, iterator last)
+{
+	if (first == last)
+		return first;
+	if (first == begin_ && last == end_)
+	{
+		clear();
+		return end_;
+	}
+	const difference_type len = last - first;
+	const difference_type elems_before = first - begin_;
+	if (elems_before < static_cast<difference_type>((size() - len) / 2))
+	{
+		mystl::move_backward(begin_, first, last);
+		for (difference_type i = 0; i < len; ++i)
+			pop_front();
+	}
+	else
+	{
+		mystl::move(last, end_, first);
+		for (difference_type i = 0; i < len; ++i)
+			pop_back();
+	}
+	return begin_ + elems_before;
+}
+
+// 清空 deque, 只保留 begin_ 所在的块, 其余的块放入缓存
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::clear()
+{
+	for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur)
+	{
+		data_allocator::destroy(*cur, *cur + buffer_size);
+		put_block(*cur);
+	}
+	if (begin_.node != end_.node)
+	{ // 有两个以上的块
+		mystl::destroy(begin_.cur, begin_.last);
+		mystl::destroy(end_.first, end_.cur);
+		put_block(end_.first);
+	}
+	else
+	{
+		mystl::destroy(begin_.cur, end_.cur);
+	}
+	end_ = begin_;
+}
+
+// 交换两个 deque
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::swap(deque& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		mystl::swap(begin_, rhs.begin_);
+		mystl::swap(end_, rhs.end_);
+		mystl::swap(map_, rhs.map_);
+		mystl::swap(map_size_, rhs.map_size_);
+		for (size_type i = 0; i < kMaxSpareBlocks; ++i)
+			mystl::swap(spare_[i], rhs.spare_[i]);
+		mystl::swap(spare_count_, rhs.spare_count_);
+	}
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 申请一个块, 有缓存的空闲块时直接复用
+template <class T, size_t BlockSize>
+typename deque<T, BlockSize>::pointer
+deque<T, BlockSize>::get_block()
+{
+	if (spare_count_ > 0)
+		return spare_[--spare_count_];
+	return data_allocator::allocate(buffer_size);
+}
+
+// 归还一个块, 缓存未满时留作下次使用
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::put_block(pointer block) noexcept
+{
+	if (spare_count_ < kMaxSpareBlocks)
+		spare_[spare_count_++] = block;
+	else
+		data_allocator::deallocate(block, buffer_size);
+}
+
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::release_spare_blocks() noexcept
+{
+	for (; spare_count_ > 0; --spare_count_)
+		data_allocator::deallocate(spare_[spare_count_ - 1], buffer_size);
+}
+
+// map_init 函数: 为 nelem 个元素准备中控器与块, 已用的块位于中控器中间
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::map_init(size_type nelem)
+{
+	spare_count_ = 0;
+	const size_type nnode = nelem / buffer_size + 1;  // 需要分配的块的个数
+	map_size_ = mystl::max(kMapInitSize, nnode + 2);
+	map_ = map_allocator::allocate(map_size_);
+
+	// 让 nstart 和 nfinish 都指向 map_ 最中央的区域，方便向头尾扩充
+	map_pointer nstart = map_ + (map_size_ - nnode) / 2;
+	map_pointer nfinish = nstart + nnode - 1;
+	map_pointer cur = nstart;
+	MYSTL_TRY
+	{
+		for (; cur <= nfinish; ++cur)
+			*cur = data_allocator::allocate(buffer_size);
+	}
+	MYSTL_CATCH_ALL
+	{
+		while (cur != nstart)
+		{
+			--cur;
+			data_allocator::deallocate(*cur, buffer_size);
+		}
+		map_allocator::deallocate(map_, map_size_);
+		map_ = nullptr;
+		map_size_ = 0;
+		MYSTL_RETHROW;
+	}
+	begin_.set_node(nstart);
+	end_.set_node(nfinish);
+	begin_.cur = begin_.first;
+	end_.cur = end_.first + (nelem % buffer_size);
+}
+
+// 保证中控器尾部至少还有 n 个空位
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::reserve_map_at_back(size_type n)
+{
+	if (n + 1 > map_size_ - static_cast<size_type>(end_.node - map_))
+		reallocate_map(n, false);
+}
+
+// 保证中控器头部至少还有 n 个空位
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::reserve_map_at_front(size_type n)
+{
+	if (n > static_cast<size_type>(begin_.node - map_))
+		reallocate_map(n, true);
+}
+
+// 中控器一端没有空位时调用
+// 已用部分不超过中控器的一半时, 只把已用部分平移到中间(不申请内存), 否则换一个更大的中控器
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::reallocate_map(size_type nodes_to_add, bool add_at_front)
+{
+	const size_type old_num_nodes = static_cast<size_type>(end_.node - begin_.node) + 1;
+	const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+	map_pointer new_start;
+	if (map_size_ > 2 * new_num_nodes)
+	{
+		new_start = map_ + (map_size_ - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+		if (new_start < begin_.node)
+			mystl::copy(begin_.node, end_.node + 1, new_start);
+		else
+			mystl::copy_backward(begin_.node, end_.node + 1, new_start + old_num_nodes);
+	}
+	else
+	{
+		const size_type new_map_size = map_size_ + mystl::max(map_size_, nodes_to_add) + 2;
+		map_pointer new_map = map_allocator::allocate(new_map_size);
+		new_start = new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+		mystl::copy(begin_.node, end_.node + 1, new_start);
+		map_allocator::deallocate(map_, map_size_);
+		map_ = new_map;
+		map_size_ = new_map_size;
+	}
+	// 块本身没有移动, 只需更新迭代器中的 node
+	begin_.node = new_start;
+	end_.node = new_start + old_num_nodes - 1;
+}
+
+// fill_init 函数
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::fill_init(size_type n, const value_type& value)
+{
+	map_init(n);
+	MYSTL_TRY
+	{
+		mystl::uninitialized_fill(begin_, end_, value);
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (map_pointer cur = begin_.node; cur <= end_.node; ++cur)
+			data_allocator::deallocate(*cur, buffer_size);
+		map_allocator::deallocate(map_, map_size_);
+		map_ = nullptr;
+		MYSTL_RETHROW;
+	}
+}
+
+// copy_init 函数
+template <class T, size_t BlockSize>
+template <class IIter>
+void deque<T, BlockSize>::copy_init(IIter first, IIter last, input_iterator_tag)
+{
+	map_init(0);
+	MYSTL_TRY
+	{
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+	MYSTL_CATCH_ALL
+	{
+		this->~deque();
+		MYSTL_RETHROW;
+	}
+}
+
+template <class T, size_t BlockSize>
+template <class FIter>
+void deque<T, BlockSize>::copy_init(FIter first, FIter last, forward_iterator_tag)
+{
+	const size_type n = mystl::distance(first, last);
+	map_init(n);
+	MYSTL_TRY
+	{
+		mystl::uninitialized_copy(first, last, begin_);
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (map_pointer cur = begin_.node; cur <= end_.node; ++cur)
+			data_allocator::deallocate(*cur, buffer_size);
+		map_allocator::deallocate(map_, map_size_);
+		map_ = nullptr;
+		MYSTL_RETHROW;
+	}
+}
+
+// fill_assign 函数
+template <class T, size_t BlockSize>
+void deque<T, BlockSize>::fill_assign(size_type n, const value_type& value)
+{
+	if (n > size())
+	{
+		mystl::fill(begin(), end(), value);
+		insert(end(), n - size(), value);
+	}
+	else
+	{
+		erase(begin() + n, end());
+		mystl::fill(begin(), end(), value);
+	}
+}
+
+// copy_assign 函数
+template <class T, size_t BlockSize>
+template <class IIter>
+void deque<T, BlockSize>::copy_assign(IIter first, IIter last, input_iterator_tag)
+{
+	auto first1 = begin();
+	auto last1 = end();
+	for (; first != last && first1 != last1; ++first, ++first1)
+		*first1 = *first;
+	if (first1 != last1)
+		erase(first1, last1);
+	else
+		insert_dispatch(end_, first, last, input_iterator_tag{});
+}
+
+template <class T, size_t BlockSize>
+template <class FIter>
+void deque<T, BlockSize>::copy_assign(FIter first, FIter last, forward_iterator_tag)
+{
+	const size_type len1 = size();
+	const size_type len2 = mystl::distance(first, last);
+	if (len1 < len2)
+	{
+		auto next = first;
+		mystl::advance(next, len1);
+		mystl::copy(first, next, begin_);
+		insert_dispatch(end_, next, last, forward_iterator_tag{});
+	}
+	else
+	{
+		erase(mystl::copy(first, last, begin_), end_);
+	}
+}
+
+// insert_dispatch 函数
+// 新元素先追加到离 position 较近的一端, 再旋转到位, 只移动较少的一侧
+template <class T, size_t BlockSize>
+template <class IIter>
+void deque<T, BlockSize>::insert_dispatch(iterator position, IIter first, IIter last,
+                                          input_iterator_tag)
+{
+	const difference_type index = position - begin_;
+	size_type n = 0;
+	MYSTL_TRY
+	{
+		for (; first != last; ++first, ++n)
+			emplace_back(*first);
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (; n > 0; --n)
+			pop_back();
+		MYSTL_RETHROW;
+	}
+	mystl::rotate(begin_ + index, end_ - static_cast<difference_type>(n), end_);
+}
+
+template <class T, size_t BlockSize>
+template <class FIter>
+void deque<T, BlockSize>::insert_dispatch(iterator position, FIter first, FIter last,
+                                          forward_iterator_tag)
+{
+	if (first == last)
+		return;
+	const size_type n = mystl::distance(first, last);
+	const size_type elems_before = static_cast<size_type>(position - begin_);
+	if (elems_before < size() / 2)
+		insert_front_rotate(position, first, n);
+	else
+		insert_back_rotate(position, first, n);
+}
+
+// 新元素从头部逆序插入, 翻转为正序后旋转到 position 之前
+template <class T, size_t BlockSize>
+template <class FIter>
+void deque<T, BlockSize>::insert_front_rotate(iterator position, FIter first, size_type n)
+{
+	const difference_type index = position - begin_;
+	size_type done = 0;
+	MYSTL_TRY
+	{
+		for (; done < n; ++done, ++first)
+			emplace_front(*first);
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (; done > 0; --done)
+			pop_front();
+		MYSTL_RETHROW;
+	}
+	const iterator mid = begin_ + static_cast<difference_type>(n);
+	mystl::reverse(begin_, mid);
+	mystl::rotate(begin_, mid, mid + index);
+}
+
+// 新元素追加到尾部, 再旋转到 position 处
+template <class T, size_t BlockSize>
+template <class FIter>
+void deque<T, BlockSize>::insert_back_rotate(iterator position, FIter first, size_type n)
+{
+	const difference_type index = position - begin_;
+	size_type done = 0;
+	MYSTL_TRY
+	{
+		for (; done < n; ++done, ++first)
+			emplace_back(*first);
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (; done > 0; --done)
+			pop_back();
+		MYSTL_RETHROW;
+	}
+	mystl::rotate(begin_ + index, end_ - static_cast<difference_type>(n), end_);
+}
+
+// 重载比较操作符
+template <class T, size_t BlockSize>
+bool operator==(const deque<T, BlockSize>& lhs, const deque<T, BlockSize>& rhs)
+{
+	return lhs.size() == rhs.size() &&
+		mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t BlockSize>
+bool operator<(const deque<T, BlockSize>& lhs, const deque<T, BlockSize>& rhs)
+{
+	return mystl::lexicographical_compare(
+		lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t BlockSize>
+bool operator!=(const deque<T, BlockSize>& lhs, const deque<T, BlockSize>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T, size_t BlockSize>
+bool operator>(const deque<T, BlockSize>& lhs, const deque<T, BlockSize>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T, size_t BlockSize>
+bool operator<=(const deque<T, BlockSize>& lhs, const deque<T, BlockSize>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T, size_t BlockSize>
+bool operator>=(const deque<T, BlockSize>& lhs, const deque<T, BlockSize>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, size_t BlockSize>
+void swap(deque<T, BlockSize>& lhs, deque<T, BlockSize>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_DEQUE_H_
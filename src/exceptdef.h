@@ -1,9 +1,33 @@
 #ifndef MYTINYSTL_EXCEPTDEF_H_
 #define MYTINYSTL_EXCEPTDEF_H_
 
+// 这个头文件包含 mystl 报告错误所用的宏与函数, 以及无异常模式(MYSTL_NO_EXCEPTIONS)的支持
+
+// notes:
+//
+// 编译器关闭了异常(如 -fno-exceptions)时自动定义 MYSTL_NO_EXCEPTIONS, 进入无异常模式:
+//   * THROW_* 宏不再抛出异常, 而是调用 set_error_handler 设置的处理函数, 之后调用 std::abort
+//   * 容器内部的 try / catch 写作 MYSTL_TRY / MYSTL_CATCH_ALL / MYSTL_RETHROW, 在无异常模式下
+//     catch 块不会执行, 因为此时元素的构造、赋值不会抛出异常
+// 需要在分配失败时继续运行的代码使用容器的 try_* 接口(如 vector::try_reserve), 它们以 errc 返回结果,
+// 分配内存使用 nothrow 版本的 operator new, 两种模式下都不会因为分配失败而抛出异常或终止
+
 #include <stdexcept>
 
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// 无异常模式只由编译器的设置决定: 开启异常时仍定义 MYSTL_NO_EXCEPTIONS 会让 MYSTL_CATCH_ALL 中的清理代码
+// 全部失效, 而元素的构造函数照样可能抛出异常, 所以视为错误
+#if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#ifndef MYSTL_NO_EXCEPTIONS
+#define MYSTL_NO_EXCEPTIONS 1
+#endif
+#elif defined(MYSTL_NO_EXCEPTIONS)
+#error "MYSTL_NO_EXCEPTIONS requires exceptions to be disabled (e.g. -fno-exceptions)"
+#endif
 
 namespace mystl
 {
@@ -15,19 +39,95 @@ namespace mystl
 #define MYSTL_DEBUG(expr) \
   assert(expr)
 
+// 代替 try / catch (...) / throw;, 在无异常模式下 catch 块成为不会执行的 else 分支
+#if defined(MYSTL_NO_EXCEPTIONS)
+#define MYSTL_TRY       if (true)
+#define MYSTL_CATCH_ALL else
+#define MYSTL_RETHROW   ((void)0)
+#else
+#define MYSTL_TRY       try
+#define MYSTL_CATCH_ALL catch (...)
+#define MYSTL_RETHROW   throw
+#endif
+
+// 报告错误的函数只在出错时调用, 不内联以减小调用处的代码
+#if defined(__GNUC__) || defined(__clang__)
+#define MYSTL_COLD __attribute__((noinline, cold))
+#else
+#define MYSTL_COLD
+#endif
+
+// 错误类别, 也是 try_* 接口的返回值
+enum class errc
+{
+	ok = 0,
+	length_error,       // 长度超过 max_size
+	out_of_range,       // 下标越界
+	runtime_error,      // 其他运行时错误
+	bad_alloc,          // 内存分配失败
+	bad_function_call   // 调用空的 function
+};
+
+// 无异常模式下的错误处理函数, 不应返回; 返回后程序以 std::abort 终止
+typedef void (*error_handler)(errc code, const char* what);
+
+namespace except_detail
+{
+
+inline error_handler& handler_slot() noexcept
+{
+	static error_handler handler = nullptr;
+	return handler;
+}
+
+} // namespace except_detail
+
+// 设置无异常模式下的错误处理函数, 返回原来的处理函数, 应在启动其他线程前设置
+inline error_handler set_error_handler(error_handler handler) noexcept
+{
+	error_handler old = except_detail::handler_slot();
+	except_detail::handler_slot() = handler;
+	return old;
+}
+
+inline error_handler get_error_handler() noexcept
+{
+	return except_detail::handler_slot();
+}
+
+// 报告错误: 有异常时抛出对应的标准异常, 无异常模式下调用错误处理函数后终止
+// std::bad_function_call 由 fuctional.h 自己抛出, 这里不必包含 <functional>
+[[noreturn]] MYSTL_COLD inline void report_error(errc code, const char* what)
+{
+#if !defined(MYSTL_NO_EXCEPTIONS)
+	switch (code)
+	{
+	case errc::length_error:      throw std::length_error(what);
+	case errc::out_of_range:      throw std::out_of_range(what);
+	case errc::bad_alloc:         throw std::bad_alloc();
+	default:                      throw std::runtime_error(what);
+	}
+#else
+	error_handler handler = except_detail::handler_slot();
+	if (handler != nullptr)
+		handler(code, what);
+	std::fprintf(stderr, "mystl: %s\n", what);
+	std::abort();
+#endif
+}
+
 // 如果 expr 为真，则抛出一个 std::length_error 异常，异常信息为 what
 #define THROW_LENGTH_ERROR_IF(expr, what) \
-  if ((expr)) throw std::length_error(what)
+  if ((expr)) mystl::report_error(mystl::errc::length_error, what)
 
 // 如果 expr 为真，则抛出一个 std::out_of_range 异常，异常信息为 what
 #define THROW_OUT_OF_RANGE_IF(expr, what) \
-  if ((expr)) throw std::out_of_range(what)
+  if ((expr)) mystl::report_error(mystl::errc::out_of_range, what)
 
 // 如果 expr 为真，则抛出一个 std::runtime_error 异常，异常信息为 what
 #define THROW_RUNTIME_ERROR_IF(expr, what) \
-  if ((expr)) throw std::runtime_error(what)
+  if ((expr)) mystl::report_error(mystl::errc::runtime_error, what)
 
 } // namepsace mystl
 
 #endif // !MYTINYSTL_EXCEPTDEF_H_
-
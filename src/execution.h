@@ -0,0 +1,178 @@
+#ifndef MYTINYSTL_EXECUTION_H_
+#define MYTINYSTL_EXECUTION_H_
+
+// 这个头文件包含执行策略 seq / par / par_unseq，以及并行算法向线程池分派任务的辅助函数
+// 并行版本的算法位于 parallel_algo.h，任务由 thread_pool.h 中的默认线程池调度
+
+#include <cstddef>
+
+#include "type_traits.h"
+#include "thread_pool.h"
+
+namespace mystl
+{
+
+// 并行算法切分任务时每块的默认元素个数
+// 元素少于两块时直接退化为串行执行，避免调度开销超过收益
+#ifndef MYSTL_PARALLEL_GRAIN_SIZE
+#define MYSTL_PARALLEL_GRAIN_SIZE 4096
+#endif // !MYSTL_PARALLEL_GRAIN_SIZE
+
+namespace execution
+{
+
+// 三种执行策略
+// grain_size 表示每个任务块至少处理的元素个数, 为 0 时使用 MYSTL_PARALLEL_GRAIN_SIZE
+// 可以通过 par.with_grain(n) 得到一个指定块大小的策略对象, 用于调整并行的盈亏平衡点
+
+// 串行执行
+struct sequenced_policy
+{
+};
+
+// 并行执行
+struct parallel_policy
+{
+	size_t grain_size;
+
+	constexpr parallel_policy with_grain(size_t n) const noexcept
+	{
+		return parallel_policy{ n };
+	}
+};
+
+// 并行且允许向量化执行，在 mystl 中与 parallel_policy 采用相同的调度方式
+struct parallel_unsequenced_policy
+{
+	size_t grain_size;
+
+	constexpr parallel_unsequenced_policy with_grain(size_t n) const noexcept
+	{
+		return parallel_unsequenced_policy{ n };
+	}
+};
+
+constexpr sequenced_policy            seq{};
+constexpr parallel_policy             par{ 0 };
+constexpr parallel_unsequenced_policy par_unseq{ 0 };
+
+} // namespace execution
+
+// is_execution_policy
+// 判断一个类型是否为执行策略，用于把并行重载与普通重载区分开
+template <class T>
+struct is_execution_policy : mystl::m_false_type {};
+
+template <>
+struct is_execution_policy<execution::sequenced_policy> : mystl::m_true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_policy> : mystl::m_true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_unsequenced_policy> : mystl::m_true_type {};
+
+// 判断一个执行策略是否允许并行
+template <class T>
+struct is_parallel_policy : mystl::m_false_type {};
+
+template <>
+struct is_parallel_policy<execution::parallel_policy> : mystl::m_true_type {};
+
+template <>
+struct is_parallel_policy<execution::parallel_unsequenced_policy> : mystl::m_true_type {};
+
+// 用于并行重载的返回值，只有第一个参数为执行策略时才启用该重载
+template <class ExecutionPolicy, class T>
+using enable_if_execution_policy = typename std::enable_if<
+	is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T>::type;
+
+// 取出执行策略的块大小
+inline size_t policy_grain_size(const execution::sequenced_policy&) noexcept
+{
+	return MYSTL_PARALLEL_GRAIN_SIZE;
+}
+
+inline size_t policy_grain_size(const execution::parallel_policy& policy) noexcept
+{
+	return policy.grain_size == 0 ? MYSTL_PARALLEL_GRAIN_SIZE : policy.grain_size;
+}
+
+inline size_t policy_grain_size(const execution::parallel_unsequenced_policy& policy) noexcept
+{
+	return policy.grain_size == 0 ? MYSTL_PARALLEL_GRAIN_SIZE : policy.grain_size;
+}
+
+// 参与并行计算的线程数(包括调用者)
+inline size_t parallel_concurrency() noexcept
+{
+	return thread_pool::default_pool().concurrency();
+}
+
+// 在默认线程池上执行 f(0) ... f(count - 1)，返回时全部执行完毕
+// 等待期间调用者线程也会执行任务, 因此在任务内部再次发起并行调用是安全的
+// 与标准库一致，元素访问函数抛出异常时调用 std::terminate
+template <class Function>
+void parallel_run(size_t count, Function& f) noexcept
+{
+	if (count == 0)
+		return;
+	if (count == 1)
+	{
+		f(static_cast<size_t>(0));
+		return;
+	}
+	thread_pool::default_pool().parallel_for(0, count, 1, [&f](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			f(i);
+	});
+}
+
+// parallel_chunks
+// 把 [0, n) 按块大小切分，对每块调用 f(begin, end, chunk_index)，返回块数
+// 块数不超过线程数的 4 倍，以兼顾负载均衡与调度开销
+template <class Function>
+size_t parallel_chunks(size_t n, size_t grain, Function f)
+{
+	if (grain == 0)
+		grain = 1;
+	size_t chunks = n / grain;
+	const size_t max_chunks = mystl::parallel_concurrency() * 4;
+	if (chunks > max_chunks)
+		chunks = max_chunks;
+	if (chunks < 2)
+	{
+		if (n != 0)
+			f(static_cast<size_t>(0), n, static_cast<size_t>(0));
+		return n != 0 ? 1 : 0;
+	}
+	const size_t step = n / chunks;
+	const size_t extra = n % chunks;
+	auto body = [&](size_t i)
+	{
+		// 前 extra 块各多分一个元素
+		const size_t begin = i * step + (i < extra ? i : extra);
+		const size_t end = begin + step + (i < extra ? 1 : 0);
+		f(begin, end, i);
+	};
+	mystl::parallel_run(chunks, body);
+	return chunks;
+}
+
+// 计算 parallel_chunks 对 n 个元素会切出多少块，用于提前准备每块的中间结果
+inline size_t parallel_chunk_count(size_t n, size_t grain) noexcept
+{
+	if (grain == 0)
+		grain = 1;
+	size_t chunks = n / grain;
+	const size_t max_chunks = mystl::parallel_concurrency() * 4;
+	if (chunks > max_chunks)
+		chunks = max_chunks;
+	if (chunks < 2)
+		return n != 0 ? 1 : 0;
+	return chunks;
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_EXECUTION_H_
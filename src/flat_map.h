@@ -0,0 +1,849 @@
+#ifndef MYTINYSTL_FLAT_MAP_H_
+#define MYTINYSTL_FLAT_MAP_H_
+
+// 这个头文件包含两个模板类 flat_map 和 flat_multimap
+// flat_map      : 用法与 map 相同, 键与值分别以有序数组的形式存放在两个 mystl::vector 中
+// flat_multimap : 与 flat_map 相同, 但允许键值重复
+
+// notes:
+//
+// 键与值分开存放: 查找时只访问键数组, 同一缓存行能容纳更多的键, 值再大也不会拖慢二分查找
+// 迭代器把两个数组"拉链"在一起, 解引用得到 mystl::pair<const Key&, T&> 代理对象,
+// 而不是真正的 value_type 引用, 所以 operator-> 返回一个持有该代理的临时对象
+// 单个元素的插入与删除为 O(n), 批量数据请使用区间构造函数或 insert_range
+//
+// 异常保证：
+// 单个元素的 insert / emplace / try_emplace 做强异常安全保证, 其余函数满足基本异常保证
+// insert_range 在合并过程中抛出异常时容器会被清空
+
+#include <initializer_list>
+
+#include "flat_set.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// flat_map 的迭代器
+// 同时持有键数组与值数组中对应位置的指针, 两者总是一起移动
+/*****************************************************************************************/
+
+template <class Key, class T, bool IsConst>
+class flat_map_iterator
+{
+	template <class, class, bool> friend class flat_map_iterator;
+	template <class, class, class, bool> friend class basic_flat_map;
+
+public:
+	typedef typename std::conditional<IsConst, const T, T>::type mapped_cv;
+
+	typedef random_access_iterator_tag              iterator_category;
+	typedef mystl::pair<Key, T>                     value_type;
+	typedef ptrdiff_t                               difference_type;
+	typedef mystl::pair<const Key&, mapped_cv&>     reference;
+	typedef mystl::arrow_proxy<reference>               pointer;
+
+	typedef flat_map_iterator                       self;
+
+private:
+	const Key* key_;  // 指向键数组中的当前位置
+	mapped_cv* val_;  // 指向值数组中的当前位置
+
+	flat_map_iterator(const Key* key, mapped_cv* val) noexcept
+		:key_(key), val_(val)
+	{
+	}
+
+public:
+	flat_map_iterator() noexcept
+		:key_(nullptr), val_(nullptr)
+	{
+	}
+
+	// 允许从 iterator 转换为 const_iterator
+	template <bool OtherConst, typename std::enable_if<
+		IsConst && !OtherConst, int>::type = 0>
+	flat_map_iterator(const flat_map_iterator<Key, T, OtherConst>& rhs) noexcept
+		:key_(rhs.key_), val_(rhs.val_)
+	{
+	}
+
+	reference operator*()  const { return reference(*key_, *val_); }
+	pointer   operator->() const { return pointer{ reference(*key_, *val_) }; }
+	reference operator[](difference_type n) const { return reference(key_[n], val_[n]); }
+
+	const Key& key()   const { return *key_; }
+	mapped_cv& value() const { return *val_; }
+
+	self& operator++()
+	{
+		++key_;
+		++val_;
+		return *this;
+	}
+	self operator++(int)
+	{
+		self tmp = *this;
+		++*this;
+		return tmp;
+	}
+	self& operator--()
+	{
+		--key_;
+		--val_;
+		return *this;
+	}
+	self operator--(int)
+	{
+		self tmp = *this;
+		--*this;
+		return tmp;
+	}
+
+	self& operator+=(difference_type n)
+	{
+		key_ += n;
+		val_ += n;
+		return *this;
+	}
+	self& operator-=(difference_type n)
+	{
+		return *this += -n;
+	}
+
+	friend self operator+(self it, difference_type n)  { return it += n; }
+	friend self operator+(difference_type n, self it)  { return it += n; }
+	friend self operator-(self it, difference_type n)  { return it -= n; }
+	friend difference_type operator-(const self& lhs, const self& rhs)
+	{ return lhs.key_ - rhs.key_; }
+
+	friend bool operator==(const self& lhs, const self& rhs) { return lhs.key_ == rhs.key_; }
+	friend bool operator!=(const self& lhs, const self& rhs) { return lhs.key_ != rhs.key_; }
+	friend bool operator< (const self& lhs, const self& rhs) { return lhs.key_ <  rhs.key_; }
+	friend bool operator> (const self& lhs, const self& rhs) { return lhs.key_ >  rhs.key_; }
+	friend bool operator<=(const self& lhs, const self& rhs) { return lhs.key_ <= rhs.key_; }
+	friend bool operator>=(const self& lhs, const self& rhs) { return lhs.key_ >= rhs.key_; }
+};
+
+// 模板类 basic_flat_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值比较方式，参数四代表键值是否唯一
+// 通常通过下面的 flat_map 与 flat_multimap 使用
+template <class Key, class T, class Compare, bool Unique>
+class basic_flat_map
+{
+public:
+	typedef mystl::vector<Key>                               key_container_type;
+	typedef mystl::vector<T>                                 mapped_container_type;
+
+	typedef Key                                              key_type;
+	typedef T                                                mapped_type;
+	typedef mystl::pair<Key, T>                              value_type;
+	typedef Compare                                          key_compare;
+
+	typedef size_t                                           size_type;
+	typedef ptrdiff_t                                        difference_type;
+
+	typedef flat_map_iterator<Key, T, false>                 iterator;
+	typedef flat_map_iterator<Key, T, true>                  const_iterator;
+	typedef mystl::reverse_iterator<iterator>                reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>          const_reverse_iterator;
+
+	typedef typename iterator::reference                     reference;
+	typedef typename const_iterator::reference               const_reference;
+	typedef typename iterator::pointer                       pointer;
+	typedef typename const_iterator::pointer                 const_pointer;
+
+	template <class K>
+	using key_arg = typename transparent_key_arg<mystl::has_is_transparent<Compare>::value>::template type<K, key_type>;
+
+	// 以键比较 value_type
+	class value_compare
+	{
+		friend class basic_flat_map;
+	private:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+	public:
+		template <class P1, class P2>
+		bool operator()(const P1& lhs, const P2& rhs) const
+		{
+			return comp(lhs.first, rhs.first);
+		}
+	};
+
+private:
+	key_container_type    keys_;    // 有序的键数组
+	compressed_pair<mapped_container_type, key_compare> values_comp_;  // 与 keys_ 一一对应的值数组与键值比较函数
+
+	mapped_container_type&       values_ref() noexcept       { return values_comp_.first(); }
+	const mapped_container_type& values_ref() const noexcept { return values_comp_.first(); }
+	key_compare&                 comp_ref() noexcept         { return values_comp_.second(); }
+	const key_compare&           comp_ref() const noexcept   { return values_comp_.second(); }
+
+public:
+	// 构造、复制、移动、析构函数
+	basic_flat_map()
+		:keys_(), values_comp_()
+	{
+	}
+
+	explicit basic_flat_map(const key_compare& comp)
+		:keys_(), values_comp_(mapped_container_type(), comp)
+	{
+	}
+
+	// 区间构造: 输入可以无序, 排序去重后拆分到两个数组
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_flat_map(InputIterator first, InputIterator last,
+	               const key_compare& comp = key_compare())
+		:keys_(), values_comp_(mapped_container_type(), comp)
+	{
+		mystl::vector<value_type> items(first, last);
+		sort_items(items);
+		split_items(items);
+	}
+
+	basic_flat_map(std::initializer_list<value_type> ilist,
+	               const key_compare& comp = key_compare())
+		:basic_flat_map(ilist.begin(), ilist.end(), comp)
+	{
+	}
+
+	// 直接接管两个等长的数组, 数组可以无序
+	basic_flat_map(key_container_type keys, mapped_container_type values,
+	               const key_compare& comp = key_compare())
+		:keys_(), values_comp_(mapped_container_type(), comp)
+	{
+		THROW_LENGTH_ERROR_IF(keys.size() != values.size(),
+		                      "flat_map<Key, T>'s key and value containers differ in size");
+		if (is_sorted_keys(keys))
+		{
+			keys_ = mystl::move(keys);
+			values_ref() = mystl::move(values);
+			if (Unique)
+				unique_sorted();
+			return;
+		}
+		mystl::vector<value_type> items;
+		items.reserve(keys.size());
+		for (size_type i = 0; i < keys.size(); ++i)
+			items.emplace_back(mystl::move(keys[i]), mystl::move(values[i]));
+		sort_items(items);
+		split_items(items);
+	}
+
+	// 输入已经有序(并且 flat_map 要求无重复), 不再排序
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_flat_map(sorted_unique_t, InputIterator first, InputIterator last,
+	               const key_compare& comp = key_compare())
+		:keys_(), values_comp_(mapped_container_type(), comp)
+	{
+		for (; first != last; ++first)
+			push_back_item(*first);
+	}
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_flat_map(sorted_equivalent_t, InputIterator first, InputIterator last,
+	               const key_compare& comp = key_compare())
+		:keys_(), values_comp_(mapped_container_type(), comp)
+	{
+		for (; first != last; ++first)
+			push_back_item(*first);
+	}
+
+	basic_flat_map(const basic_flat_map& rhs)
+		:keys_(rhs.keys_), values_comp_(rhs.values_comp_)
+	{
+	}
+	basic_flat_map(basic_flat_map&& rhs) noexcept
+		:keys_(mystl::move(rhs.keys_)), values_comp_(mystl::move(rhs.values_ref()), rhs.comp_ref())
+	{
+	}
+
+	basic_flat_map& operator=(const basic_flat_map& rhs)
+	{
+		if (this != &rhs)
+		{
+			basic_flat_map tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+	basic_flat_map& operator=(basic_flat_map&& rhs) noexcept
+	{
+		keys_ = mystl::move(rhs.keys_);
+		values_ref() = mystl::move(rhs.values_ref());
+		comp_ref() = rhs.comp_ref();
+		return *this;
+	}
+
+	basic_flat_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		basic_flat_map tmp(ilist, comp_ref());
+		swap(tmp);
+		return *this;
+	}
+
+	~basic_flat_map() = default;
+
+	// 迭代器相关
+
+	iterator               begin()         noexcept
+	{ return iterator(keys_.data(), values_ref().data()); }
+	const_iterator         begin()   const noexcept
+	{ return const_iterator(keys_.data(), values_ref().data()); }
+	iterator               end()           noexcept
+	{ return begin() + static_cast<difference_type>(size()); }
+	const_iterator         end()     const noexcept
+	{ return begin() + static_cast<difference_type>(size()); }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept
+	{ return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept
+	{ return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return begin(); }
+	const_iterator         cend()    const noexcept
+	{ return end(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return keys_.empty(); }
+	size_type size()     const noexcept { return keys_.size(); }
+	size_type max_size() const noexcept { return keys_.max_size(); }
+
+	void      reserve(size_type n)
+	{
+		keys_.reserve(n);
+		values_ref().reserve(n);
+	}
+	void      shrink_to_fit()
+	{
+		keys_.shrink_to_fit();
+		values_ref().shrink_to_fit();
+	}
+
+	// 底层的键数组与值数组, 只读
+	const key_container_type&    keys()   const noexcept { return keys_; }
+	const mapped_container_type& values() const noexcept { return values_ref(); }
+
+	// 访问元素相关
+
+	mapped_type& at(const key_type& key)
+	{
+		auto it = find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "flat_map<Key, T> no such element exists");
+		return it.value();
+	}
+	const mapped_type& at(const key_type& key) const
+	{
+		auto it = find(key);
+		THROW_OUT_OF_RANGE_IF(it == end(), "flat_map<Key, T> no such element exists");
+		return it.value();
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		static_assert(Unique, "flat_multimap<Key, T> has no operator[]");
+		return try_emplace(key).first.value();
+	}
+	mapped_type& operator[](key_type&& key)
+	{
+		static_assert(Unique, "flat_multimap<Key, T> has no operator[]");
+		return try_emplace(mystl::move(key)).first.value();
+	}
+
+	// 修改容器操作
+
+	// emplace / emplace_hint
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		value_type tmp(mystl::forward<Args>(args)...);
+		return insert_value(mystl::move(tmp.first), mystl::move(tmp.second));
+	}
+
+	template <class ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{
+		value_type tmp(mystl::forward<Args>(args)...);
+		return insert_value_hint(hint, mystl::move(tmp.first), mystl::move(tmp.second));
+	}
+
+	// try_emplace
+	// 键不存在时才构造值, 键存在时 args 不会被移动
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+	{
+		static_assert(Unique, "flat_multimap<Key, T> has no try_emplace");
+		return try_emplace_key(key, mystl::forward<Args>(args)...);
+	}
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+	{
+		static_assert(Unique, "flat_multimap<Key, T> has no try_emplace");
+		return try_emplace_key(mystl::move(key), mystl::forward<Args>(args)...);
+	}
+
+	// insert
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{ return insert_value(value.first, value.second); }
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{ return insert_value(mystl::move(value.first), mystl::move(value.second)); }
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{ return insert_value_hint(hint, value.first, value.second); }
+	iterator insert(const_iterator hint, value_type&& value)
+	{ return insert_value_hint(hint, mystl::move(value.first), mystl::move(value.second)); }
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	void insert(InputIterator first, InputIterator last)
+	{ insert_range(first, last); }
+
+	void insert(std::initializer_list<value_type> ilist)
+	{ insert_range(ilist.begin(), ilist.end()); }
+
+	// insert_range
+	// 先把新元素排序去重, 再与已有元素线性合并, 时间复杂度 O(n + m log m)
+	// 新元素全部大于已有元素时直接追加到末尾
+	template <class InputIterator>
+	void insert_range(InputIterator first, InputIterator last)
+	{
+		mystl::vector<value_type> items(first, last);
+		sort_items(items);
+		merge_items(items);
+	}
+
+	// 输入已经有序(并且无重复), 跳过排序
+	template <class InputIterator>
+	void insert(sorted_unique_t, InputIterator first, InputIterator last)
+	{
+		mystl::vector<value_type> items(first, last);
+		merge_items(items);
+	}
+
+	template <class InputIterator>
+	void insert(sorted_equivalent_t, InputIterator first, InputIterator last)
+	{
+		mystl::vector<value_type> items(first, last);
+		merge_items(items);
+	}
+
+	// insert_or_assign
+	// 键存在时对映射值赋值, 否则插入
+
+	template <class M>
+	mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+	{
+		auto result = try_emplace(key, mystl::forward<M>(obj));
+		if (!result.second)
+			result.first.value() = mystl::forward<M>(obj);
+		return result;
+	}
+
+	template <class M>
+	mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+	{
+		auto result = try_emplace(mystl::move(key), mystl::forward<M>(obj));
+		if (!result.second)
+			result.first.value() = mystl::forward<M>(obj);
+		return result;
+	}
+
+	// erase / clear
+
+	iterator  erase(iterator pos)
+	{ return erase(const_iterator(pos)); }
+	iterator  erase(const_iterator pos)
+	{ return erase(pos, pos + 1); }
+
+	iterator  erase(const_iterator first, const_iterator last)
+	{
+		const auto i = index_of(first);
+		const auto j = index_of(last);
+		keys_.erase(keys_.begin() + i, keys_.begin() + j);
+		values_ref().erase(values_ref().begin() + i, values_ref().begin() + j);
+		return begin() + i;
+	}
+
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{
+		auto range = equal_range<K>(key);
+		const auto n = static_cast<size_type>(range.second - range.first);
+		if (n == 0)
+			return 0;
+		erase(const_iterator(range.first), const_iterator(range.second));
+		return n;
+	}
+
+	void      clear() noexcept
+	{
+		keys_.clear();
+		values_ref().clear();
+	}
+
+	void      swap(basic_flat_map& rhs) noexcept
+	{
+		keys_.swap(rhs.keys_);
+		values_comp_.swap(rhs.values_comp_);
+	}
+
+	// 查找相关
+
+	template <class K = key_type>
+	iterator       find(const key_arg<K>& key)
+	{ return begin() + find_index<K>(key); }
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{ return begin() + find_index<K>(key); }
+
+	template <class K = key_type>
+	size_type      count(const key_arg<K>& key) const
+	{
+		if (Unique)
+			return find<K>(key) == end() ? 0 : 1;
+		auto range = equal_range<K>(key);
+		return static_cast<size_type>(range.second - range.first);
+	}
+
+	template <class K = key_type>
+	bool           contains(const key_arg<K>& key) const
+	{ return find<K>(key) != end(); }
+
+	template <class K = key_type>
+	iterator       lower_bound(const key_arg<K>& key)
+	{ return begin() + lower_index<K>(key); }
+	template <class K = key_type>
+	const_iterator lower_bound(const key_arg<K>& key) const
+	{ return begin() + lower_index<K>(key); }
+
+	template <class K = key_type>
+	iterator       upper_bound(const key_arg<K>& key)
+	{ return begin() + upper_index<K>(key); }
+	template <class K = key_type>
+	const_iterator upper_bound(const key_arg<K>& key) const
+	{ return begin() + upper_index<K>(key); }
+
+	template <class K = key_type>
+	mystl::pair<iterator, iterator> equal_range(const key_arg<K>& key)
+	{
+		auto range = equal_index<K>(key);
+		return mystl::pair<iterator, iterator>(begin() + range.first, begin() + range.second);
+	}
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{
+		auto range = equal_index<K>(key);
+		return mystl::pair<const_iterator, const_iterator>(begin() + range.first,
+		                                                   begin() + range.second);
+	}
+
+	// 观察者
+
+	key_compare   key_comp()   const { return comp_ref(); }
+	value_compare value_comp() const { return value_compare(comp_ref()); }
+
+private:
+	// helper functions
+
+	difference_type index_of(const_iterator it) const noexcept
+	{ return it.key_ - keys_.data(); }
+
+	// 查找只在键数组上进行, 对原生指针走无分支的二分查找
+	template <class K>
+	difference_type lower_index(const K& key) const
+	{
+		return mystl::lower_bound(keys_.begin(), keys_.end(), key, comp_ref()) - keys_.begin();
+	}
+
+	template <class K>
+	difference_type upper_index(const K& key) const
+	{
+		return mystl::upper_bound(keys_.begin(), keys_.end(), key, comp_ref()) - keys_.begin();
+	}
+
+	template <class K>
+	difference_type find_index(const K& key) const
+	{
+		const auto i = lower_index(key);
+		const auto n = static_cast<difference_type>(keys_.size());
+		return (i == n || comp_ref()(key, keys_[i])) ? n : i;
+	}
+
+	template <class K>
+	mystl::pair<difference_type, difference_type> equal_index(const K& key) const
+	{
+		const auto lo = lower_index(key);
+		const auto n = static_cast<difference_type>(keys_.size());
+		if (Unique)
+			return mystl::pair<difference_type, difference_type>(
+				lo, (lo == n || comp_ref()(key, keys_[lo])) ? lo : lo + 1);
+		const auto hi = mystl::upper_bound(keys_.begin() + lo, keys_.end(), key, comp_ref()) - keys_.begin();
+		return mystl::pair<difference_type, difference_type>(lo, hi);
+	}
+
+	bool is_sorted_keys(const key_container_type& keys) const
+	{
+		for (size_type i = 1; i < keys.size(); ++i)
+		{
+			if (comp_ref()(keys[i], keys[i - 1]))
+				return false;
+		}
+		return true;
+	}
+
+	// 按键做稳定排序, 输入已经有序时只做一次线性检查
+	void sort_items(mystl::vector<value_type>& items)
+	{
+		for (size_type i = 1; i < items.size(); ++i)
+		{
+			if (comp_ref()(items[i].first, items[i - 1].first))
+			{
+				mystl::stable_sort(items.begin(), items.end(), value_compare(comp_ref()));
+				break;
+			}
+		}
+	}
+
+	// 把有序的 items 拆分追加到两个数组, flat_map 在同一遍中去掉重复的键(保留先出现的那个)
+	void split_items(mystl::vector<value_type>& items)
+	{
+		reserve(items.size());
+		for (auto& item : items)
+		{
+			if (Unique && !keys_.empty() && !comp_ref()(keys_.back(), item.first))
+				continue;
+			push_back_item(mystl::move(item));
+		}
+	}
+
+	// 在末尾追加一个元素, 值构造失败时撤销键
+	template <class P>
+	void push_back_item(P&& item)
+	{
+		keys_.push_back(mystl::forward<P>(item).first);
+		MYSTL_TRY
+		{
+			values_ref().push_back(mystl::forward<P>(item).second);
+		}
+		MYSTL_CATCH_ALL
+		{
+			keys_.pop_back();
+			MYSTL_RETHROW;
+		}
+	}
+
+	// 对已经有序的两个数组去掉重复的键
+	void unique_sorted()
+	{
+		if (keys_.empty())
+			return;
+		size_type result = 0;
+		for (size_type i = 1; i < keys_.size(); ++i)
+		{
+			if (comp_ref()(keys_[result], keys_[i]))
+			{
+				++result;
+				if (result != i)
+				{
+					keys_[result] = mystl::move(keys_[i]);
+					values_ref()[result] = mystl::move(values_ref()[i]);
+				}
+			}
+		}
+		keys_.erase(keys_.begin() + result + 1, keys_.end());
+		values_ref().erase(values_ref().begin() + result + 1, values_ref().end());
+	}
+
+	// 把按键有序的 items 合并进来
+	// flat_map 中与已有元素等价的新元素被丢弃, flat_multimap 中新元素排在等价元素之后
+	void merge_items(mystl::vector<value_type>& items)
+	{
+		if (items.empty())
+			return;
+		const bool after_back = keys_.empty() || (Unique
+			? comp_ref()(keys_.back(), items.front().first)
+			: !comp_ref()(items.front().first, keys_.back()));
+		if (after_back)
+		{
+			split_items(items);
+			return;
+		}
+		key_container_type    new_keys;
+		mapped_container_type new_values;
+		MYSTL_TRY
+		{
+			new_keys.reserve(keys_.size() + items.size());
+			new_values.reserve(keys_.size() + items.size());
+			size_type i = 0, j = 0;
+			const size_type n = keys_.size(), m = items.size();
+			while (i < n && j < m)
+			{
+				// flat_map 中新元素与上一个输出的键等价时丢弃, 这样已有元素与先出现的新元素优先
+				if (Unique && !new_keys.empty() && !comp_ref()(new_keys.back(), items[j].first))
+				{
+					++j;
+				}
+				else if (comp_ref()(items[j].first, keys_[i]))
+				{
+					new_keys.push_back(mystl::move(items[j].first));
+					new_values.push_back(mystl::move(items[j].second));
+					++j;
+				}
+				else
+				{
+					new_keys.push_back(mystl::move(keys_[i]));
+					new_values.push_back(mystl::move(values_ref()[i]));
+					++i;
+				}
+			}
+			for (; i < n; ++i)
+			{
+				new_keys.push_back(mystl::move(keys_[i]));
+				new_values.push_back(mystl::move(values_ref()[i]));
+			}
+			for (; j < m; ++j)
+			{
+				if (Unique && !comp_ref()(new_keys.back(), items[j].first))
+					continue;
+				new_keys.push_back(mystl::move(items[j].first));
+				new_values.push_back(mystl::move(items[j].second));
+			}
+		}
+		MYSTL_CATCH_ALL
+		{
+			clear();
+			MYSTL_RETHROW;
+		}
+		keys_.swap(new_keys);
+		values_ref().swap(new_values);
+	}
+
+	// 在下标 pos 处插入一对键值, 值构造失败时撤销键
+	template <class K, class ...Args>
+	iterator insert_at(difference_type pos, K&& key, Args&& ...args)
+	{
+		keys_.emplace(keys_.begin() + pos, mystl::forward<K>(key));
+		MYSTL_TRY
+		{
+			values_ref().emplace(values_ref().begin() + pos, mystl::forward<Args>(args)...);
+		}
+		MYSTL_CATCH_ALL
+		{
+			keys_.erase(keys_.begin() + pos);
+			MYSTL_RETHROW;
+		}
+		return begin() + pos;
+	}
+
+	template <class K, class ...Args>
+	mystl::pair<iterator, bool> try_emplace_key(K&& key, Args&& ...args)
+	{
+		const auto pos = lower_index(key);
+		if (pos != static_cast<difference_type>(keys_.size()) && !comp_ref()(key, keys_[pos]))
+			return mystl::pair<iterator, bool>(begin() + pos, false);
+		return mystl::pair<iterator, bool>(
+			insert_at(pos, mystl::forward<K>(key), mystl::forward<Args>(args)...), true);
+	}
+
+	template <class K, class V>
+	mystl::pair<iterator, bool> insert_value(K&& key, V&& value)
+	{
+		if (Unique)
+			return try_emplace_key(mystl::forward<K>(key), mystl::forward<V>(value));
+		const auto pos = upper_index(key);
+		return mystl::pair<iterator, bool>(
+			insert_at(pos, mystl::forward<K>(key), mystl::forward<V>(value)), true);
+	}
+
+	// hint 恰好是正确的插入位置时省去一次查找
+	template <class K, class V>
+	iterator insert_value_hint(const_iterator hint, K&& key, V&& value)
+	{
+		const auto pos = index_of(hint);
+		const auto n = static_cast<difference_type>(keys_.size());
+		const bool fits = Unique
+			? (pos == 0 || comp_ref()(keys_[pos - 1], key)) && (pos == n || comp_ref()(key, keys_[pos]))
+			: (pos == 0 || !comp_ref()(key, keys_[pos - 1])) && (pos == n || !comp_ref()(keys_[pos], key));
+		if (fits)
+			return insert_at(pos, mystl::forward<K>(key), mystl::forward<V>(value));
+		return insert_value(mystl::forward<K>(key), mystl::forward<V>(value)).first;
+	}
+
+public:
+	friend bool operator==(const basic_flat_map& lhs, const basic_flat_map& rhs)
+	{
+		return lhs.keys_ == rhs.keys_ && lhs.values_ref() == rhs.values_ref();
+	}
+	friend bool operator!=(const basic_flat_map& lhs, const basic_flat_map& rhs)
+	{
+		return !(lhs == rhs);
+	}
+	friend bool operator<(const basic_flat_map& lhs, const basic_flat_map& rhs)
+	{
+		const size_type n = mystl::min(lhs.size(), rhs.size());
+		for (size_type i = 0; i < n; ++i)
+		{
+			if (lhs.keys_[i] < rhs.keys_[i])
+				return true;
+			if (rhs.keys_[i] < lhs.keys_[i])
+				return false;
+			if (lhs.values_ref()[i] < rhs.values_ref()[i])
+				return true;
+			if (rhs.values_ref()[i] < lhs.values_ref()[i])
+				return false;
+		}
+		return lhs.size() < rhs.size();
+	}
+	friend bool operator>(const basic_flat_map& lhs, const basic_flat_map& rhs)
+	{
+		return rhs < lhs;
+	}
+	friend bool operator<=(const basic_flat_map& lhs, const basic_flat_map& rhs)
+	{
+		return !(rhs < lhs);
+	}
+	friend bool operator>=(const basic_flat_map& lhs, const basic_flat_map& rhs)
+	{
+		return !(lhs < rhs);
+	}
+};
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare, bool Unique>
+void swap(basic_flat_map<Key, T, Compare, Unique>& lhs,
+          basic_flat_map<Key, T, Compare, Unique>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 模板类 flat_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+using flat_map = basic_flat_map<Key, T, Compare, true>;
+
+// 模板类 flat_multimap，键值允许重复
+template <class Key, class T, class Compare = mystl::less<Key>>
+using flat_multimap = basic_flat_map<Key, T, Compare, false>;
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_MAP_H_
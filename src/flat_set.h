@@ -0,0 +1,495 @@
+#ifndef MYTINYSTL_FLAT_SET_H_
+#define MYTINYSTL_FLAT_SET_H_
+
+// 这个头文件包含两个模板类 flat_set 和 flat_multiset
+// flat_set      : 用法与 set 相同, 元素以有序数组的形式连续存放在 mystl::vector 中
+// flat_multiset : 与 flat_set 相同, 但允许键值重复
+
+// notes:
+//
+// 与红黑树相比, 有序数组没有节点分配, 查找时访问的内存连续, 遍历与查找都快得多;
+// 代价是单个元素的插入与删除需要移动其后的所有元素, 时间复杂度为 O(n)
+// 因此批量数据请使用区间构造函数或 insert_range: 先整体排序去重, 再与已有元素做一次线性合并
+// 查找使用 mystl::lower_bound / upper_bound, 对原生指针走无分支的二分查找
+//
+// 异常保证：
+// 单个元素的 insert / emplace 做强异常安全保证, 其余函数满足基本异常保证
+// insert_range 在合并过程中抛出异常时容器会被清空
+
+#include <initializer_list>
+
+#include "vector.h"
+#include "algo.h"
+#include "fuctional.h"
+#include "exceptdef.h"
+#include "type_traits.h"
+#include "tuple.h"
+
+namespace mystl
+{
+
+// 模板类 basic_flat_set
+// 参数一代表键值类型，参数二代表键值比较方式，参数三代表键值是否唯一
+// 通常通过下面的 flat_set 与 flat_multiset 使用
+template <class Key, class Compare, bool Unique>
+class basic_flat_set
+{
+public:
+	typedef mystl::vector<Key>                           container_type;
+
+	typedef Key                                          key_type;
+	typedef Key                                          value_type;
+	typedef Compare                                      key_compare;
+	typedef Compare                                      value_compare;
+
+	typedef typename container_type::size_type           size_type;
+	typedef typename container_type::difference_type     difference_type;
+	typedef typename container_type::pointer             pointer;
+	typedef typename container_type::const_pointer       const_pointer;
+	typedef typename container_type::reference           reference;
+	typedef typename container_type::const_reference     const_reference;
+
+	// 元素即键值, 不允许通过迭代器修改
+	typedef typename container_type::const_iterator      iterator;
+	typedef typename container_type::const_iterator      const_iterator;
+	typedef mystl::reverse_iterator<iterator>            reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>      const_reverse_iterator;
+
+	template <class K>
+	using key_arg = typename transparent_key_arg<mystl::has_is_transparent<Compare>::value>::template type<K, key_type>;
+
+private:
+	compressed_pair<container_type, key_compare> keys_comp_;  // 有序的键值数组与键值比较函数, 空的比较函数不占空间
+
+	container_type&       keys_ref() noexcept       { return keys_comp_.first(); }
+	const container_type& keys_ref() const noexcept { return keys_comp_.first(); }
+	key_compare&          comp_ref() noexcept       { return keys_comp_.second(); }
+	const key_compare&    comp_ref() const noexcept { return keys_comp_.second(); }
+
+public:
+	// 构造、复制、移动、析构函数
+	basic_flat_set()
+		:keys_comp_()
+	{
+	}
+
+	explicit basic_flat_set(const key_compare& comp)
+		:keys_comp_(container_type(), comp)
+	{
+	}
+
+	// 区间构造: 输入可以无序, 排序并去重后存放
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_flat_set(InputIterator first, InputIterator last,
+	               const key_compare& comp = key_compare())
+		:keys_comp_(piecewise_construct, mystl::forward_as_tuple(first, last), mystl::forward_as_tuple(comp))
+	{
+		sort_and_unique(keys_ref());
+	}
+
+	basic_flat_set(std::initializer_list<value_type> ilist,
+	               const key_compare& comp = key_compare())
+		:keys_comp_(piecewise_construct, mystl::forward_as_tuple(ilist.begin(), ilist.end()),
+		            mystl::forward_as_tuple(comp))
+	{
+		sort_and_unique(keys_ref());
+	}
+
+	// 直接接管一个数组, 数组可以无序
+	explicit basic_flat_set(container_type keys, const key_compare& comp = key_compare())
+		:keys_comp_(mystl::move(keys), comp)
+	{
+		sort_and_unique(keys_ref());
+	}
+
+	// 输入已经有序(并且 flat_set 要求无重复), 不再排序
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_flat_set(sorted_unique_t, InputIterator first, InputIterator last,
+	               const key_compare& comp = key_compare())
+		:keys_comp_(piecewise_construct, mystl::forward_as_tuple(first, last), mystl::forward_as_tuple(comp))
+	{
+	}
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	basic_flat_set(sorted_equivalent_t, InputIterator first, InputIterator last,
+	               const key_compare& comp = key_compare())
+		:keys_comp_(piecewise_construct, mystl::forward_as_tuple(first, last), mystl::forward_as_tuple(comp))
+	{
+	}
+
+	basic_flat_set(const basic_flat_set& rhs)
+		:keys_comp_(rhs.keys_comp_)
+	{
+	}
+	basic_flat_set(basic_flat_set&& rhs) noexcept
+		:keys_comp_(mystl::move(rhs.keys_ref()), rhs.comp_ref())
+	{
+	}
+
+	basic_flat_set& operator=(const basic_flat_set& rhs)
+	{
+		if (this != &rhs)
+		{
+			keys_comp_ = rhs.keys_comp_;
+		}
+		return *this;
+	}
+	basic_flat_set& operator=(basic_flat_set&& rhs) noexcept
+	{
+		keys_ref() = mystl::move(rhs.keys_ref());
+		comp_ref() = rhs.comp_ref();
+		return *this;
+	}
+
+	basic_flat_set& operator=(std::initializer_list<value_type> ilist)
+	{
+		keys_ref().assign(ilist.begin(), ilist.end());
+		sort_and_unique(keys_ref());
+		return *this;
+	}
+
+	~basic_flat_set() = default;
+
+	// 迭代器相关
+
+	iterator               begin()         noexcept
+	{ return keys_ref().begin(); }
+	const_iterator         begin()   const noexcept
+	{ return keys_ref().begin(); }
+	iterator               end()           noexcept
+	{ return keys_ref().end(); }
+	const_iterator         end()     const noexcept
+	{ return keys_ref().end(); }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept
+	{ return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept
+	{ return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return begin(); }
+	const_iterator         cend()    const noexcept
+	{ return end(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return keys_ref().empty(); }
+	size_type size()     const noexcept { return keys_ref().size(); }
+	size_type max_size() const noexcept { return keys_ref().max_size(); }
+	size_type capacity() const noexcept { return keys_ref().capacity(); }
+
+	void      reserve(size_type n)      { keys_ref().reserve(n); }
+	void      shrink_to_fit()           { keys_ref().shrink_to_fit(); }
+
+	// 底层有序数组, 只读
+	const container_type& keys() const noexcept { return keys_ref(); }
+
+	// 修改容器操作
+
+	// emplace / emplace_hint
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		value_type tmp(mystl::forward<Args>(args)...);
+		return insert_value(mystl::move(tmp));
+	}
+
+	template <class ...Args>
+	iterator emplace_hint(const_iterator hint, Args&& ...args)
+	{
+		value_type tmp(mystl::forward<Args>(args)...);
+		return insert_value_hint(hint, mystl::move(tmp));
+	}
+
+	// insert
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{ return insert_value(value); }
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{ return insert_value(mystl::move(value)); }
+
+	iterator insert(const_iterator hint, const value_type& value)
+	{ return insert_value_hint(hint, value); }
+	iterator insert(const_iterator hint, value_type&& value)
+	{ return insert_value_hint(hint, mystl::move(value)); }
+
+	template <class InputIterator, typename std::enable_if<
+		mystl::is_input_iterator<InputIterator>::value, int>::type = 0>
+	void insert(InputIterator first, InputIterator last)
+	{ insert_range(first, last); }
+
+	void insert(std::initializer_list<value_type> ilist)
+	{ insert_range(ilist.begin(), ilist.end()); }
+
+	// insert_range
+	// 先把新元素排序去重, 再与已有元素线性合并, 时间复杂度 O(n + m log m)
+	// 新元素全部大于已有元素时直接追加到末尾
+	template <class InputIterator>
+	void insert_range(InputIterator first, InputIterator last)
+	{
+		container_type items(first, last);
+		sort_and_unique(items);
+		merge_sorted(items);
+	}
+
+	// 输入已经有序(并且无重复), 跳过排序
+	template <class InputIterator>
+	void insert(sorted_unique_t, InputIterator first, InputIterator last)
+	{
+		container_type items(first, last);
+		merge_sorted(items);
+	}
+
+	template <class InputIterator>
+	void insert(sorted_equivalent_t, InputIterator first, InputIterator last)
+	{
+		container_type items(first, last);
+		merge_sorted(items);
+	}
+
+	// erase / clear
+
+	iterator  erase(const_iterator pos)
+	{ return keys_ref().erase(pos); }
+	iterator  erase(const_iterator first, const_iterator last)
+	{ return keys_ref().erase(first, last); }
+
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{
+		auto range = equal_range<K>(key);
+		const auto n = static_cast<size_type>(range.second - range.first);
+		if (n == 0)
+			return 0;
+		keys_ref().erase(range.first, range.second);
+		return n;
+	}
+
+	void      clear() noexcept
+	{ keys_ref().clear(); }
+
+	void      swap(basic_flat_set& rhs) noexcept
+	{
+		keys_comp_.swap(rhs.keys_comp_);
+	}
+
+	// 查找相关
+
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{
+		auto it = lower_bound<K>(key);
+		return (it == end() || comp_ref()(key, *it)) ? end() : it;
+	}
+
+	template <class K = key_type>
+	size_type      count(const key_arg<K>& key) const
+	{
+		if (Unique)
+			return find<K>(key) == end() ? 0 : 1;
+		auto range = equal_range<K>(key);
+		return static_cast<size_type>(range.second - range.first);
+	}
+
+	template <class K = key_type>
+	bool           contains(const key_arg<K>& key) const
+	{ return find<K>(key) != end(); }
+
+	template <class K = key_type>
+	const_iterator lower_bound(const key_arg<K>& key) const
+	{ return mystl::lower_bound(keys_ref().begin(), keys_ref().end(), key, comp_ref()); }
+
+	template <class K = key_type>
+	const_iterator upper_bound(const key_arg<K>& key) const
+	{ return mystl::upper_bound(keys_ref().begin(), keys_ref().end(), key, comp_ref()); }
+
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator>
+	equal_range(const key_arg<K>& key) const
+	{
+		auto lo = lower_bound<K>(key);
+		if (Unique)
+			return mystl::pair<const_iterator, const_iterator>(
+				lo, (lo == end() || comp_ref()(key, *lo)) ? lo : lo + 1);
+		return mystl::pair<const_iterator, const_iterator>(
+			lo, mystl::upper_bound(lo, keys_ref().end(), key, comp_ref()));
+	}
+
+	// 观察者
+
+	key_compare   key_comp()   const { return comp_ref(); }
+	value_compare value_comp() const { return comp_ref(); }
+
+private:
+	// helper functions
+
+	// 把数组排好序, 对 flat_set 再去掉重复的键值(保留先出现的那个)
+	// 输入已经有序时只做一次线性检查
+	void sort_and_unique(container_type& v)
+	{
+		auto first = v.begin();
+		auto last = v.end();
+		for (auto it = first; it != last && it + 1 != last; ++it)
+		{
+			if (comp_ref()(*(it + 1), *it))
+			{
+				mystl::stable_sort(first, last, comp_ref());
+				break;
+			}
+		}
+		if (!Unique || first == last)
+			return;
+		// 有序数组中 a 与 b 相邻且 !comp(a, b) 即表示两者等价
+		auto result = v.begin();
+		for (auto it = first + 1; it != last; ++it)
+		{
+			if (comp_ref()(*result, *it))
+			{
+				++result;
+				if (result != it)
+					*result = mystl::move(*it);
+			}
+		}
+		v.erase(result + 1, v.end());
+	}
+
+	// 把已经有序(并去重)的 items 合并进来
+	// flat_set 中与已有元素等价的新元素被丢弃, flat_multiset 中新元素排在等价元素之后
+	void merge_sorted(container_type& items)
+	{
+		if (items.empty())
+			return;
+		if (keys_ref().empty())
+		{
+			keys_ref().swap(items);
+			return;
+		}
+		const bool after_back = Unique
+			? comp_ref()(keys_ref().back(), items.front())
+			: !comp_ref()(items.front(), keys_ref().back());
+		if (after_back)
+		{
+			keys_ref().reserve(keys_ref().size() + items.size());
+			for (auto& item : items)
+				keys_ref().push_back(mystl::move(item));
+			return;
+		}
+		container_type result;
+		MYSTL_TRY
+		{
+			result.reserve(keys_ref().size() + items.size());
+			auto i = keys_ref().begin(), ilast = keys_ref().end();
+			auto j = items.begin(), jlast = items.end();
+			while (i != ilast && j != jlast)
+			{
+				if (comp_ref()(*j, *i))
+				{
+					result.push_back(mystl::move(*j));
+					++j;
+				}
+				else
+				{
+					if (Unique && !comp_ref()(*i, *j))
+						++j;
+					result.push_back(mystl::move(*i));
+					++i;
+				}
+			}
+			for (; i != ilast; ++i)
+				result.push_back(mystl::move(*i));
+			for (; j != jlast; ++j)
+				result.push_back(mystl::move(*j));
+		}
+		MYSTL_CATCH_ALL
+		{
+			keys_ref().clear();
+			MYSTL_RETHROW;
+		}
+		keys_ref().swap(result);
+	}
+
+	// 在有序位置插入单个元素
+	template <class V>
+	mystl::pair<iterator, bool> insert_value(V&& value)
+	{
+		if (Unique)
+		{
+			auto pos = lower_bound<key_type>(value);
+			if (pos != end() && !comp_ref()(value, *pos))
+				return mystl::pair<iterator, bool>(pos, false);
+			return mystl::pair<iterator, bool>(keys_ref().insert(pos, mystl::forward<V>(value)), true);
+		}
+		auto pos = upper_bound<key_type>(value);
+		return mystl::pair<iterator, bool>(keys_ref().insert(pos, mystl::forward<V>(value)), true);
+	}
+
+	// hint 恰好是正确的插入位置时省去一次查找
+	template <class V>
+	iterator insert_value_hint(const_iterator hint, V&& value)
+	{
+		const bool fits = Unique
+			? (hint == begin() || comp_ref()(*(hint - 1), value)) && (hint == end() || comp_ref()(value, *hint))
+			: (hint == begin() || !comp_ref()(value, *(hint - 1))) && (hint == end() || !comp_ref()(*hint, value));
+		if (fits)
+			return keys_ref().insert(hint, mystl::forward<V>(value));
+		return insert_value(mystl::forward<V>(value)).first;
+	}
+
+public:
+	friend bool operator==(const basic_flat_set& lhs, const basic_flat_set& rhs)
+	{
+		return lhs.keys_ == rhs.keys_ref();
+	}
+	friend bool operator!=(const basic_flat_set& lhs, const basic_flat_set& rhs)
+	{
+		return !(lhs == rhs);
+	}
+	friend bool operator<(const basic_flat_set& lhs, const basic_flat_set& rhs)
+	{
+		return lhs.keys_ < rhs.keys_ref();
+	}
+	friend bool operator>(const basic_flat_set& lhs, const basic_flat_set& rhs)
+	{
+		return rhs < lhs;
+	}
+	friend bool operator<=(const basic_flat_set& lhs, const basic_flat_set& rhs)
+	{
+		return !(rhs < lhs);
+	}
+	friend bool operator>=(const basic_flat_set& lhs, const basic_flat_set& rhs)
+	{
+		return !(lhs < rhs);
+	}
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Compare, bool Unique>
+void swap(basic_flat_set<Key, Compare, Unique>& lhs,
+          basic_flat_set<Key, Compare, Unique>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 模板类 flat_set，键值不允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less
+template <class Key, class Compare = mystl::less<Key>>
+using flat_set = basic_flat_set<Key, Compare, true>;
+
+// 模板类 flat_multiset，键值允许重复
+template <class Key, class Compare = mystl::less<Key>>
+using flat_multiset = basic_flat_set<Key, Compare, false>;
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_SET_H_
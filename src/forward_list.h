@@ -0,0 +1,899 @@
+#ifndef MYTINYSTL_FORWARD_LIST_H_
+#define MYTINYSTL_FORWARD_LIST_H_
+
+// 这个头文件包含一个模板类 forward_list
+// forward_list : 单向链表
+
+// notes:
+//
+// 与 list 相同, 节点来自 shared_node_pool(见 node_pool.h):
+//   * 每个 forward_list 缺省有自己的节点池, 构造时传入同一个 pool_type 句柄的多个容器共用一个节点池
+//   * 共用节点池的容器之间 splice_after / merge 只改动指针, 否则退化为逐个移动元素
+//   * insert_after / insert_range_after 在已知元素个数时先一次性预留整块 slab, 再把新节点整体接入
+//   * sort 是自底向上的归并排序, 只改动节点之间的链接, 不申请内存
+// 与 std::forward_list 一样不记录元素个数, 没有 size()
+//
+// 异常保证：
+// mystl::forward_list<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_after
+//   * push_front
+//   * insert_after
+//   * insert_range_after
+
+#include <initializer_list>
+
+#include "fuctional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "node_pool.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// forward_list 的节点设计
+struct forward_list_node_base
+{
+	forward_list_node_base* next;  // 下一节点
+};
+
+template <class T>
+struct forward_list_node : public forward_list_node_base
+{
+	T value;  // 数据域
+};
+
+// forward_list 的迭代器设计
+template <class T, bool IsConst>
+struct forward_list_iterator : public mystl::iterator<mystl::forward_iterator_tag, T>
+{
+	typedef T                                                    value_type;
+	typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+	typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+	typedef ptrdiff_t                                            difference_type;
+	typedef forward_list_node_base*                              base_ptr;
+	typedef forward_list_node<T>*                                node_ptr;
+	typedef forward_list_iterator                                self;
+
+	base_ptr node;  // 指向当前节点
+
+	// 构造函数
+	forward_list_iterator() noexcept :node(nullptr) {}
+	explicit forward_list_iterator(base_ptr x) noexcept :node(x) {}
+
+	// 非 const 迭代器可以转换为 const 迭代器
+	template <bool C = IsConst, typename std::enable_if<C, int>::type = 0>
+	forward_list_iterator(const forward_list_iterator<T, false>& rhs) noexcept :node(rhs.node) {}
+
+	// 重载操作符
+	reference operator*()  const { return static_cast<node_ptr>(node)->value; }
+	pointer   operator->() const { return &(operator*()); }
+
+	self& operator++()
+	{
+		MYSTL_DEBUG(node != nullptr);
+		node = node->next;
+		return *this;
+	}
+	self operator++(int)
+	{
+		self tmp = *this;
+		++*this;
+		return tmp;
+	}
+
+	// 重载比较操作符
+	friend bool operator==(const self& lhs, const self& rhs) { return lhs.node == rhs.node; }
+	friend bool operator!=(const self& lhs, const self& rhs) { return lhs.node != rhs.node; }
+};
+
+// 模板类: forward_list
+// 模板参数 T 代表数据类型
+template <class T>
+class forward_list
+{
+public:
+	// forward_list 的嵌套型别定义
+	typedef mystl::allocator<T>                      allocator_type;
+	typedef mystl::allocator<T>                      data_allocator;
+
+	typedef typename allocator_type::value_type      value_type;
+	typedef typename allocator_type::pointer         pointer;
+	typedef typename allocator_type::const_pointer   const_pointer;
+	typedef typename allocator_type::reference       reference;
+	typedef typename allocator_type::const_reference const_reference;
+	typedef typename allocator_type::size_type       size_type;
+	typedef typename allocator_type::difference_type difference_type;
+
+	typedef forward_list_iterator<T, false>          iterator;
+	typedef forward_list_iterator<T, true>           const_iterator;
+
+	// 节点池句柄, 复制句柄即共用节点池
+	typedef shared_node_pool<forward_list_node<T>>   pool_type;
+
+	typedef forward_list_node_base*                  base_ptr;
+	typedef forward_list_node<T>*                    node_ptr;
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+private:
+	forward_list_node_base head_;  // 哨兵节点, before_begin() 指向它
+	pool_type              pool_;  // 节点池
+
+public:
+	// 构造、复制、移动、析构函数
+	forward_list() noexcept
+	{ head_.next = nullptr; }
+
+	// 与 pool 所属的其他 forward_list 共用节点池
+	explicit forward_list(const pool_type& pool) noexcept
+		:pool_(pool)
+	{ head_.next = nullptr; }
+
+	explicit forward_list(size_type n)
+	{
+		head_.next = nullptr;
+		insert_after(cbefore_begin(), n, value_type());
+	}
+
+	forward_list(size_type n, const value_type& value)
+	{
+		head_.next = nullptr;
+		insert_after(cbefore_begin(), n, value);
+	}
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	forward_list(IIter first, IIter last)
+	{
+		head_.next = nullptr;
+		insert_range_after(cbefore_begin(), first, last);
+	}
+
+	forward_list(std::initializer_list<value_type> ilist)
+	{
+		head_.next = nullptr;
+		insert_range_after(cbefore_begin(), ilist.begin(), ilist.end());
+	}
+
+	forward_list(const forward_list& rhs)
+	{
+		head_.next = nullptr;
+		insert_range_after(cbefore_begin(), rhs.cbegin(), rhs.cend());
+	}
+
+	forward_list(forward_list&& rhs) noexcept
+		:pool_(mystl::move(rhs.pool_))
+	{
+		head_.next = rhs.head_.next;
+		rhs.head_.next = nullptr;
+	}
+
+	forward_list& operator=(const forward_list& rhs)
+	{
+		if (this != &rhs)
+			assign(rhs.begin(), rhs.end());
+		return *this;
+	}
+
+	forward_list& operator=(forward_list&& rhs) noexcept
+	{
+		clear();
+		swap(rhs);
+		return *this;
+	}
+
+	forward_list& operator=(std::initializer_list<value_type> ilist)
+	{
+		assign(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	~forward_list()
+	{ clear(); }
+
+public:
+	// 迭代器相关操作
+	iterator       before_begin()        noexcept
+	{ return iterator(&head_); }
+	const_iterator before_begin()  const noexcept
+	{ return const_iterator(const_cast<base_ptr>(&head_)); }
+	iterator       begin()               noexcept
+	{ return iterator(head_.next); }
+	const_iterator begin()         const noexcept
+	{ return const_iterator(head_.next); }
+	iterator       end()                 noexcept
+	{ return iterator(nullptr); }
+	const_iterator end()           const noexcept
+	{ return const_iterator(nullptr); }
+
+	const_iterator cbefore_begin() const noexcept
+	{ return before_begin(); }
+	const_iterator cbegin()        const noexcept
+	{ return begin(); }
+	const_iterator cend()          const noexcept
+	{ return end(); }
+
+	// 容量相关操作
+	bool      empty()    const noexcept
+	{ return head_.next == nullptr; }
+
+	size_type max_size() const noexcept
+	{ return static_cast<size_type>(-1) / sizeof(forward_list_node<T>); }
+
+	// 访问元素相关操作
+	reference       front()
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+
+	const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+
+	// 节点池句柄, 可用于构造共用节点池的其他 forward_list; 尚未创建节点池时先创建
+	pool_type get_pool()
+	{
+		if (!pool_.valid())
+			pool_ = pool_type::create();
+		return pool_;
+	}
+
+	// 调整容器相关操作
+
+	// assign
+
+	void     assign(size_type n, const value_type& value);
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	void     assign(IIter first, IIter last);
+
+	void     assign(std::initializer_list<value_type> ilist)
+	{ assign(ilist.begin(), ilist.end()); }
+
+	// emplace_front / emplace_after
+
+	template <class ...Args>
+	void     emplace_front(Args&& ...args)
+	{ emplace_after(cbefore_begin(), mystl::forward<Args>(args)...); }
+
+	template <class ...Args>
+	iterator emplace_after(const_iterator pos, Args&& ...args)
+	{
+		MYSTL_DEBUG(pos.node != nullptr);
+		node_ptr p = create_node(mystl::forward<Args>(args)...);
+		p->next = pos.node->next;
+		pos.node->next = p;
+		return iterator(p);
+	}
+
+	// push_front / pop_front
+
+	void     push_front(const value_type& value)
+	{ emplace_front(value); }
+	void     push_front(value_type&& value)
+	{ emplace_front(mystl::move(value)); }
+
+	void     pop_front()
+	{
+		MYSTL_DEBUG(!empty());
+		erase_after(cbefore_begin());
+	}
+
+	// insert_after
+
+	iterator insert_after(const_iterator pos, const value_type& value)
+	{ return emplace_after(pos, value); }
+
+	iterator insert_after(const_iterator pos, value_type&& value)
+	{ return emplace_after(pos, mystl::move(value)); }
+
+	iterator insert_after(const_iterator pos, size_type n, const value_type& value);
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	iterator insert_after(const_iterator pos, IIter first, IIter last)
+	{ return insert_range_after(pos, first, last); }
+
+	iterator insert_after(const_iterator pos, std::initializer_list<value_type> ilist)
+	{ return insert_range_after(pos, ilist.begin(), ilist.end()); }
+
+	// insert_range_after
+	// 批量插入: 前向迭代器会先按元素个数预留节点池, 新节点串成一条链后整体接入, 返回最后一个新元素的位置
+	template <class IIter>
+	iterator insert_range_after(const_iterator pos, IIter first, IIter last);
+
+	// erase_after / clear
+
+	iterator erase_after(const_iterator pos);
+	iterator erase_after(const_iterator first, const_iterator last);
+
+	void     clear() noexcept
+	{
+		destroy_chain(head_.next);
+		head_.next = nullptr;
+	}
+
+	// resize
+
+	void     resize(size_type new_size) { resize(new_size, value_type()); }
+	void     resize(size_type new_size, const value_type& value);
+
+	void     swap(forward_list& rhs) noexcept
+	{
+		mystl::swap(head_.next, rhs.head_.next);
+		pool_.swap(rhs.pool_);
+	}
+
+	// forward_list 相关操作
+
+	void splice_after(const_iterator pos, forward_list& other);
+	void splice_after(const_iterator pos, forward_list&& other)
+	{ splice_after(pos, other); }
+	void splice_after(const_iterator pos, forward_list& other, const_iterator it);
+	void splice_after(const_iterator pos, forward_list&& other, const_iterator it)
+	{ splice_after(pos, other, it); }
+	void splice_after(const_iterator pos, forward_list& other,
+	                  const_iterator first, const_iterator last);
+	void splice_after(const_iterator pos, forward_list&& other,
+	                  const_iterator first, const_iterator last)
+	{ splice_after(pos, other, first, last); }
+
+	void remove(const value_type& value)
+	{ remove_if([&](const value_type& v) { return v == value; }); }
+	template <class UnaryPredicate>
+	void remove_if(UnaryPredicate pred);
+
+	void unique()
+	{ unique(mystl::equal_to<T>()); }
+	template <class BinaryPredicate>
+	void unique(BinaryPredicate pred);
+
+	void merge(forward_list& x)
+	{ merge(x, mystl::less<T>()); }
+	void merge(forward_list&& x)
+	{ merge(x, mystl::less<T>()); }
+	template <class Compare>
+	void merge(forward_list& x, Compare comp);
+	template <class Compare>
+	void merge(forward_list&& x, Compare comp)
+	{ merge(x, comp); }
+
+	void sort()
+	{ sort(mystl::less<T>()); }
+	template <class Compared>
+	void sort(Compared comp);
+
+	void reverse() noexcept;
+
+private:
+	// helper functions
+
+	static value_type& value_of(base_ptr p) noexcept
+	{ return static_cast<node_ptr>(p)->value; }
+
+	// create / destroy node
+	template <class ...Args>
+	node_ptr create_node(Args&& ...args);
+	void     destroy_node(base_ptr p) noexcept;
+	void     destroy_chain(base_ptr first) noexcept;
+
+	// 节点池
+	bool     share_pool_with(forward_list& other) noexcept;
+	template <class IIter>
+	void     reserve_nodes(IIter, IIter, input_iterator_tag) {}
+	template <class FIter>
+	void     reserve_nodes(FIter first, FIter last, forward_iterator_tag)
+	{ pool_.reserve(static_cast<size_type>(mystl::distance(first, last))); }
+
+	base_ptr transfer_after(base_ptr pos, forward_list& other, base_ptr before_first, base_ptr last);
+
+	// sort
+	template <class Compared>
+	static void merge_chains(base_ptr a, base_ptr b, base_ptr& out, Compared& comp);
+	static base_ptr concat_chains(base_ptr a, base_ptr b) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 用 n 个 value 为容器赋值, 复用已有的节点
+template <class T>
+void forward_list<T>::assign(size_type n, const value_type& value)
+{
+	base_ptr prev = &head_;
+	for (; n > 0 && prev->next != nullptr; --n, prev = prev->next)
+		value_of(prev->next) = value;
+	if (n > 0)
+		insert_after(const_iterator(prev), n, value);
+	else
+		erase_after(const_iterator(prev), cend());
+}
+
+// 用 [first, last) 为容器赋值, 复用已有的节点
+template <class T>
+template <class IIter, typename std::enable_if<
+	mystl::is_input_iterator<IIter>::value, int>::type>
+void forward_list<T>::assign(IIter first, IIter last)
+{
+	base_ptr prev = &head_;
+	for (; first != last && prev->next != nullptr; ++first, prev = prev->next)
+		value_of(prev->next) = *first;
+	if (first != last)
+		insert_range_after(const_iterator(prev), first, last);
+	else
+		erase_after(const_iterator(prev), cend());
+}
+
+// 在 pos 之后插入 n 个 value, 节点一次预留
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::insert_after(const_iterator pos, size_type n, const value_type& value)
+{
+	if (n == 0)
+		return iterator(pos.node);
+	pool_.reserve(n);
+	node_ptr head = create_node(value);
+	base_ptr tail = head;
+	MYSTL_TRY
+	{
+		for (size_type i = 1; i < n; ++i)
+		{
+			node_ptr p = create_node(value);
+			tail->next = p;
+			tail = p;
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		destroy_chain(head);
+		MYSTL_RETHROW;
+	}
+	tail->next = pos.node->next;
+	pos.node->next = head;
+	return iterator(tail);
+}
+
+// 在 pos 之后批量插入 [first, last) 的元素
+template <class T>
+template <class IIter>
+typename forward_list<T>::iterator
+forward_list<T>::insert_range_after(const_iterator pos, IIter first, IIter last)
+{
+	if (first == last)
+		return iterator(pos.node);
+	reserve_nodes(first, last, iterator_category(first));
+	node_ptr head = create_node(*first);
+	base_ptr tail = head;
+	MYSTL_TRY
+	{
+		for (++first; first != last; ++first)
+		{
+			node_ptr p = create_node(*first);
+			tail->next = p;
+			tail = p;
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		destroy_chain(head);
+		MYSTL_RETHROW;
+	}
+	tail->next = pos.node->next;
+	pos.node->next = head;
+	return iterator(tail);
+}
+
+// 删除 pos 之后的元素
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::erase_after(const_iterator pos)
+{
+	MYSTL_DEBUG(pos.node != nullptr && pos.node->next != nullptr);
+	base_ptr n = pos.node->next;
+	pos.node->next = n->next;
+	destroy_node(n);
+	return iterator(pos.node->next);
+}
+
+// 删除 (first, last) 内的元素
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::erase_after(const_iterator first, const_iterator last)
+{
+	base_ptr cur = first.node->next;
+	while (cur != last.node)
+	{
+		base_ptr next = cur->next;
+		destroy_node(cur);
+		cur = next;
+	}
+	first.node->next = last.node;
+	return iterator(last.node);
+}
+
+// 重置容器大小
+template <class T>
+void forward_list<T>::resize(size_type new_size, const value_type& value)
+{
+	base_ptr prev = &head_;
+	for (; new_size > 0 && prev->next != nullptr; --new_size)
+		prev = prev->next;
+	if (new_size > 0)
+		insert_after(const_iterator(prev), new_size, value);
+	else
+		erase_after(const_iterator(prev), cend());
+}
+
+// 将 other 的全部元素接合于 pos 之后
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& other)
+{
+	MYSTL_DEBUG(this != &other);
+	if (!other.empty())
+	{
+		share_pool_with(other);
+		transfer_after(pos.node, other, &other.head_, nullptr);
+	}
+}
+
+// 将 it 之后的一个元素接合于 pos 之后
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& other, const_iterator it)
+{
+	base_ptr n = it.node->next;
+	if (pos.node != it.node && pos.node != n)
+	{
+		share_pool_with(other);
+		transfer_after(pos.node, other, it.node, n->next);
+	}
+}
+
+// 将 other 中 (first, last) 内的元素接合于 pos 之后
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& other,
+                                   const_iterator first, const_iterator last)
+{
+	if (first.node->next != last.node && pos.node != first.node)
+	{
+		share_pool_with(other);
+		transfer_after(pos.node, other, first.node, last.node);
+	}
+}
+
+// 删除令一元操作 pred 为 true 的所有元素
+// 先把要删除的节点摘下串成一条链, 最后再析构, 这样 pred 引用容器中的元素也是安全的
+template <class T>
+template <class UnaryPredicate>
+void forward_list<T>::remove_if(UnaryPredicate pred)
+{
+	forward_list_node_base removed;
+	removed.next = nullptr;
+	base_ptr tail = &removed;
+	MYSTL_TRY
+	{
+		base_ptr prev = &head_;
+		while (prev->next != nullptr)
+		{
+			base_ptr cur = prev->next;
+			if (pred(value_of(cur)))
+			{
+				prev->next = cur->next;
+				cur->next = nullptr;
+				tail->next = cur;
+				tail = cur;
+			}
+			else
+			{
+				prev = cur;
+			}
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		destroy_chain(removed.next);
+		MYSTL_RETHROW;
+	}
+	destroy_chain(removed.next);
+}
+
+// 移除满足 pred 为 true 的相邻重复元素
+template <class T>
+template <class BinaryPredicate>
+void forward_list<T>::unique(BinaryPredicate pred)
+{
+	base_ptr cur = head_.next;
+	if (cur == nullptr)
+		return;
+	while (cur->next != nullptr)
+	{
+		if (pred(value_of(cur), value_of(cur->next)))
+			erase_after(const_iterator(cur));
+		else
+			cur = cur->next;
+	}
+}
+
+// 与另一个有序 forward_list 合并, 按照 comp 为 true 的顺序
+template <class T>
+template <class Compare>
+void forward_list<T>::merge(forward_list& x, Compare comp)
+{
+	if (this == &x || x.empty())
+		return;
+	share_pool_with(x);
+	base_ptr prev = &head_;
+	while (x.head_.next != nullptr)
+	{
+		if (prev->next == nullptr)
+		{ // 连接剩余部分
+			transfer_after(prev, x, &x.head_, nullptr);
+			break;
+		}
+		if (comp(value_of(x.head_.next), value_of(prev->next)))
+			prev = transfer_after(prev, x, &x.head_, x.head_.next->next);
+		else
+			prev = prev->next;
+	}
+}
+
+// 对 forward_list 进行排序
+// 自底向上的归并排序: bins[i] 保存长度约为 2^i 的有序链, 只改动 next 指针
+// comp 抛出异常时, 所有节点按当前的顺序重新接回容器, 不会丢失元素
+template <class T>
+template <class Compared>
+void forward_list<T>::sort(Compared comp)
+{
+	if (head_.next == nullptr || head_.next->next == nullptr)
+		return;
+	base_ptr chain = head_.next;
+	base_ptr bins[64];
+	size_type fill = 0;
+	base_ptr carry = nullptr;
+	MYSTL_TRY
+	{
+		while (chain != nullptr)
+		{
+			carry = chain;
+			chain = chain->next;
+			carry->next = nullptr;
+			size_type i = 0;
+			for (; i < fill && bins[i] != nullptr; ++i)
+			{
+				base_ptr a = bins[i];
+				bins[i] = nullptr;
+				merge_chains(a, carry, carry, comp);
+			}
+			bins[i] = carry;
+			carry = nullptr;
+			if (i == fill)
+				++fill;
+		}
+		for (size_type i = 0; i < fill; ++i)
+		{
+			if (bins[i] != nullptr)
+			{
+				base_ptr a = bins[i];
+				bins[i] = nullptr;
+				merge_chains(a, carry, carry, comp);
+			}
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (size_type i = fill; i > 0; --i)
+			carry = concat_chains(bins[i - 1], carry);
+		head_.next = concat_chains(carry, chain);
+		MYSTL_RETHROW;
+	}
+	head_.next = carry;
+}
+
+// 将 forward_list 反转
+template <class T>
+void forward_list<T>::reverse() noexcept
+{
+	base_ptr prev = nullptr;
+	base_ptr cur = head_.next;
+	while (cur != nullptr)
+	{
+		base_ptr next = cur->next;
+		cur->next = prev;
+		prev = cur;
+		cur = next;
+	}
+	head_.next = prev;
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 创建节点
+template <class T>
+template <class ...Args>
+typename forward_list<T>::node_ptr
+forward_list<T>::create_node(Args&& ...args)
+{
+	node_ptr p = pool_.allocate();
+	MYSTL_TRY
+	{
+		data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+		p->next = nullptr;
+	}
+	MYSTL_CATCH_ALL
+	{
+		pool_.deallocate(p);
+		MYSTL_RETHROW;
+	}
+	return p;
+}
+
+// 销毁节点
+template <class T>
+void forward_list<T>::destroy_node(base_ptr p) noexcept
+{
+	node_ptr n = static_cast<node_ptr>(p);
+	data_allocator::destroy(mystl::address_of(n->value));
+	pool_.deallocate(n);
+}
+
+// 销毁一条以 nullptr 结尾的节点链
+template <class T>
+void forward_list<T>::destroy_chain(base_ptr first) noexcept
+{
+	while (first != nullptr)
+	{
+		base_ptr next = first->next;
+		destroy_node(first);
+		first = next;
+	}
+}
+
+// 尽量与 other 共用节点池: 已经共用, 或者自身为空时改用 other 的节点池, 返回是否共用
+template <class T>
+bool forward_list<T>::share_pool_with(forward_list& other) noexcept
+{
+	if (pool_ == other.pool_)
+		return true;
+	if (empty() && other.pool_.valid())
+	{
+		pool_ = other.pool_;
+		return true;
+	}
+	return false;
+}
+
+// 把 other 中 (before_first, last) 的节点移到 pos 之后, 返回移过来的最后一个节点
+// 共用节点池时只改动指针, 否则逐个移动元素后删除 other 中的节点
+template <class T>
+typename forward_list<T>::base_ptr
+forward_list<T>::transfer_after(base_ptr pos, forward_list& other,
+                                base_ptr before_first, base_ptr last)
+{
+	if (pool_ == other.pool_)
+	{
+		base_ptr before_last = before_first;
+		while (before_last->next != last)
+			before_last = before_last->next;
+		if (before_last == before_first)
+			return pos;
+		before_last->next = pos->next;
+		pos->next = before_first->next;
+		before_first->next = last;
+		return before_last;
+	}
+	while (before_first->next != last)
+	{
+		pos = emplace_after(const_iterator(pos), mystl::move(value_of(before_first->next))).node;
+		other.erase_after(const_iterator(before_first));
+	}
+	return pos;
+}
+
+// 合并两条以 nullptr 结尾的有序链, 相等时 a 中的节点在前, 结果写入 out
+// comp 抛出异常时, 已合并的部分与 a, b 的剩余部分仍首尾相连写入 out
+template <class T>
+template <class Compared>
+void forward_list<T>::merge_chains(base_ptr a, base_ptr b, base_ptr& out, Compared& comp)
+{
+	forward_list_node_base head;
+	head.next = nullptr;
+	base_ptr tail = &head;
+	MYSTL_TRY
+	{
+		while (a != nullptr && b != nullptr)
+		{
+			if (comp(value_of(b), value_of(a)))
+			{
+				tail->next = b;
+				b = b->next;
+			}
+			else
+			{
+				tail->next = a;
+				a = a->next;
+			}
+			tail = tail->next;
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		tail->next = concat_chains(a, b);
+		out = head.next;
+		MYSTL_RETHROW;
+	}
+	tail->next = a != nullptr ? a : b;
+	out = head.next;
+}
+
+// 把链 b 接在链 a 之后
+template <class T>
+typename forward_list<T>::base_ptr
+forward_list<T>::concat_chains(base_ptr a, base_ptr b) noexcept
+{
+	if (a == nullptr)
+		return b;
+	base_ptr tail = a;
+	while (tail->next != nullptr)
+		tail = tail->next;
+	tail->next = b;
+	return a;
+}
+
+// 重载比较操作符
+template <class T>
+bool operator==(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+	auto f1 = lhs.cbegin();
+	auto f2 = rhs.cbegin();
+	auto l1 = lhs.cend();
+	auto l2 = rhs.cend();
+	for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2)
+		;
+	return f1 == l1 && f2 == l2;
+}
+
+template <class T>
+bool operator<(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+	return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T>
+bool operator!=(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(forward_list<T>& lhs, forward_list<T>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FORWARD_LIST_H_
@@ -0,0 +1,1120 @@
+#ifndef MYTINYSTL_FUNCTIONAL_H_
+#define MYTINYSTL_FUNCTIONAL_H_
+
+// 这个头文件包含了 mystl 的函数对象与哈希函数
+// 包括算术类、关系运算类、逻辑运算类以及证同、选择、投射等函数对象
+// 以及 invoke 与类型擦除的可调用对象 function, move_only_function, function_ref
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 定义一元函数的参数型别和返回值型别
+template <class Arg, class Result>
+struct unarg_function
+{
+	typedef Arg       argument_type;
+	typedef Result    result_type;
+};
+
+// 定义二元函数的参数型别的返回值型别
+template <class Arg1, class Arg2, class Result>
+struct binary_function
+{
+	typedef Arg1      first_argument_type;
+	typedef Arg2      second_argument_type;
+	typedef Result    result_type;
+};
+
+/*****************************************************************************************/
+// 算术类函数对象
+/*****************************************************************************************/
+
+// 函数对象：加法
+template <class T>
+struct plus :public binary_function<T, T, T>
+{
+	T operator()(const T& x, const T& y) const { return x + y; }
+};
+
+// 函数对象：减法
+template <class T>
+struct minus :public binary_function<T, T, T>
+{
+	T operator()(const T& x, const T& y) const { return x - y; }
+};
+
+// 函数对象：乘法
+template <class T>
+struct multiplies :public binary_function<T, T, T>
+{
+	T operator()(const T& x, const T& y) const { return x * y; }
+};
+
+// 函数对象：除法
+template <class T>
+struct divides :public binary_function<T, T, T>
+{
+	T operator()(const T& x, const T& y) const { return x / y; }
+};
+
+// 函数对象：模取
+template <class T>
+struct modulus :public binary_function<T, T, T>
+{
+	T operator()(const T& x, const T& y) const { return x % y; }
+};
+
+// 函数对象：否定
+template <class T>
+struct negate :public unarg_function<T, T>
+{
+	T operator()(const T& x) const { return -x; }
+};
+
+/*****************************************************************************************/
+// 关系运算类函数对象
+/*****************************************************************************************/
+
+// 函数对象：等于
+template <class T>
+struct equal_to :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x == y; }
+};
+
+// 函数对象：不等于
+template <class T>
+struct not_equal_to :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x != y; }
+};
+
+// 函数对象：大于
+template <class T>
+struct greater :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x > y; }
+};
+
+// 函数对象：小于
+template <class T>
+struct less :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x < y; }
+};
+
+// equal_to<void> 与 less<void> 为透明比较器, 可以比较不同类型的参数
+// 用于关联容器与哈希容器的异构查找, 例如用 const char* 查找以 string 为键的元素
+template <>
+struct equal_to<void>
+{
+	typedef void is_transparent;
+
+	template <class T, class U>
+	bool operator()(const T& x, const U& y) const { return x == y; }
+};
+
+template <>
+struct less<void>
+{
+	typedef void is_transparent;
+
+	template <class T, class U>
+	bool operator()(const T& x, const U& y) const { return x < y; }
+};
+
+// 函数对象：大于等于
+template <class T>
+struct greater_equal :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x >= y; }
+};
+
+// 函数对象：小于等于
+template <class T>
+struct less_equal :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x <= y; }
+};
+
+/*****************************************************************************************/
+// 逻辑运算类函数对象
+/*****************************************************************************************/
+
+// 函数对象：逻辑与
+template <class T>
+struct logical_and :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x && y; }
+};
+
+// 函数对象：逻辑或
+template <class T>
+struct logical_or :public binary_function<T, T, bool>
+{
+	bool operator()(const T& x, const T& y) const { return x || y; }
+};
+
+// 函数对象：逻辑非
+template <class T>
+struct logical_not :public unarg_function<T, bool>
+{
+	bool operator()(const T& x) const { return !x; }
+};
+
+/*****************************************************************************************/
+// 证同、选择、投射
+/*****************************************************************************************/
+
+// 证同函数：不会改变元素，返回本身
+template <class T>
+struct identity :public unarg_function<T, T>
+{
+	const T& operator()(const T& x) const { return x; }
+};
+
+// 选择函数：接受一个 pair，返回第一个元素
+template <class Pair>
+struct selectfirst :public unarg_function<Pair, typename Pair::first_type>
+{
+	const typename Pair::first_type& operator()(const Pair& x) const
+	{
+		return x.first;
+	}
+};
+
+// 选择函数：接受一个 pair，返回第二个元素
+template <class Pair>
+struct selectsecond :public unarg_function<Pair, typename Pair::second_type>
+{
+	const typename Pair::second_type& operator()(const Pair& x) const
+	{
+		return x.second;
+	}
+};
+
+// 投射函数：返回第一参数
+template <class Arg1, class Arg2>
+struct projectfirst :public binary_function<Arg1, Arg2, Arg1>
+{
+	Arg1 operator()(const Arg1& x, const Arg2&) const { return x; }
+};
+
+// 投射函数：返回第二参数
+template <class Arg1, class Arg2>
+struct projectsecond :public binary_function<Arg1, Arg2, Arg1>
+{
+	Arg2 operator()(const Arg1&, const Arg2& y) const { return y; }
+};
+
+/*****************************************************************************************/
+// 哈希函数
+// 核心是 wyhash(公有领域算法) 中的 mum 混合: 两个 64 位数相乘得到 128 位结果, 再把高低两半异或,
+// 连续两次即可使每个输出位都充分依赖输入的所有位
+//   * hash_int   : 整数, 两次 mum
+//   * hash_bytes : 任意字节串, 每 16 字节一次 mum, 长度不小于 48 时三路并行
+// 本文件中的特化都定义了 is_avalanching, 哈希容器看到该标记后不再对结果做二次混合
+/*****************************************************************************************/
+
+namespace hash_detail
+{
+
+// wyhash 使用的常数
+constexpr uint64_t kSecret0 = 0x2d358dccaa6c78a5ULL;
+constexpr uint64_t kSecret1 = 0x8bb84b93962eacc9ULL;
+constexpr uint64_t kSecret2 = 0x4b33a62ed433d4a3ULL;
+constexpr uint64_t kSecret3 = 0x4d5a2da51de1aa47ULL;
+
+// 128 位乘法, 低 64 位写回 a, 高 64 位写回 b
+inline void mum(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = a;
+	r *= b;
+	a = static_cast<uint64_t>(r);
+	b = static_cast<uint64_t>(r >> 64);
+#else
+	const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+	const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	const uint64_t t = rl + (rm0 << 32);
+	uint64_t c = t < rl ? 1 : 0;
+	const uint64_t lo = t + (rm1 << 32);
+	c += lo < t ? 1 : 0;
+	a = lo;
+	b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept
+{
+	mum(a, b);
+	return a ^ b;
+}
+
+// 按本机字节序读取, 不要求对齐
+inline uint64_t read8(const unsigned char* p) noexcept
+{
+	uint64_t v;
+	std::memcpy(&v, p, 8);
+	return v;
+}
+
+inline uint64_t read4(const unsigned char* p) noexcept
+{
+	uint32_t v;
+	std::memcpy(&v, p, 4);
+	return v;
+}
+
+// 读取 1~3 个字节
+inline uint64_t read3(const unsigned char* p, size_t k) noexcept
+{
+	return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+} // namespace hash_detail
+
+// 计算字节串 [data, data + len) 的 64 位哈希值
+inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) noexcept
+{
+	using namespace hash_detail;
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	seed ^= mix(seed ^ kSecret0, kSecret1);
+	uint64_t a, b;
+	if (len <= 16)
+	{
+		if (len >= 4)
+		{
+			// 4~16 字节: 首尾各取两个可能重叠的 4 字节
+			a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+			b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if (len > 0)
+		{
+			a = read3(p, len);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	else
+	{
+		size_t i = len;
+		if (i >= 48)
+		{
+			// 三条独立的依赖链, 让乘法器保持忙碌
+			uint64_t see1 = seed, see2 = seed;
+			do
+			{
+				seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+				see1 = mix(read8(p + 16) ^ kSecret2, read8(p + 24) ^ see1);
+				see2 = mix(read8(p + 32) ^ kSecret3, read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16)
+		{
+			seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		// 最后 16 个字节, 可能与前面已处理的部分重叠
+		a = read8(p + i - 16);
+		b = read8(p + i - 8);
+	}
+	a ^= kSecret1;
+	b ^= seed;
+	mum(a, b);
+	return mix(a ^ kSecret0 ^ len, b ^ kSecret1);
+}
+
+// 计算一个 64 位整数的哈希值
+// 只做一次 mum 时, 输入的低位只能通过进位影响高位, 雪崩不充分; 与 hash_bytes 处理 8 字节输入时相同,
+// 把 x 与其循环移位相乘后再混合一次
+inline uint64_t hash_int(uint64_t x) noexcept
+{
+	using namespace hash_detail;
+	uint64_t a = x ^ kSecret1;
+	uint64_t b = ((x << 32) | (x >> 32)) ^ kSecret0;
+	mum(a, b);
+	return mix(a ^ kSecret0, b ^ kSecret1);
+}
+
+/*****************************************************************************************/
+// 哈希函数对象
+/*****************************************************************************************/
+
+// 对于没有特化的类型，hash function 转交给 std::hash
+// 此时结果的质量没有保证, 哈希容器会再做一次混合
+template <class Key, bool IsEnum = std::is_enum<Key>::value>
+struct hash_base
+{
+	size_t operator()(const Key& key) const noexcept(noexcept(std::hash<Key>()(key)))
+	{
+		return std::hash<Key>()(key);
+	}
+};
+
+// 枚举按其底层整数计算
+template <class Key>
+struct hash_base<Key, true>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(Key key) const noexcept
+	{
+		typedef typename std::underlying_type<Key>::type underlying;
+		return static_cast<size_t>(mystl::hash_int(static_cast<uint64_t>(static_cast<underlying>(key))));
+	}
+};
+
+template <class Key>
+struct hash : public hash_base<Key>
+{
+};
+
+// 针对指针的偏特化版本
+template <class T>
+struct hash<T*>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(T* p) const noexcept
+	{
+		return static_cast<size_t>(mystl::hash_int(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p))));
+	}
+};
+
+// 对于整型类型，用 hash_int 混合
+#define MYSTL_TRIVIAL_HASH_FCN(Type)                                        \
+template <> struct hash<Type>                                                \
+{                                                                            \
+	typedef void is_avalanching;                                             \
+	size_t operator()(Type val) const noexcept                               \
+	{ return static_cast<size_t>(mystl::hash_int(static_cast<uint64_t>(val))); } \
+};
+
+MYSTL_TRIVIAL_HASH_FCN(bool)
+
+MYSTL_TRIVIAL_HASH_FCN(char)
+
+MYSTL_TRIVIAL_HASH_FCN(signed char)
+
+MYSTL_TRIVIAL_HASH_FCN(unsigned char)
+
+MYSTL_TRIVIAL_HASH_FCN(wchar_t)
+
+MYSTL_TRIVIAL_HASH_FCN(char16_t)
+
+MYSTL_TRIVIAL_HASH_FCN(char32_t)
+
+MYSTL_TRIVIAL_HASH_FCN(short)
+
+MYSTL_TRIVIAL_HASH_FCN(unsigned short)
+
+MYSTL_TRIVIAL_HASH_FCN(int)
+
+MYSTL_TRIVIAL_HASH_FCN(unsigned int)
+
+MYSTL_TRIVIAL_HASH_FCN(long)
+
+MYSTL_TRIVIAL_HASH_FCN(unsigned long)
+
+MYSTL_TRIVIAL_HASH_FCN(long long)
+
+MYSTL_TRIVIAL_HASH_FCN(unsigned long long)
+
+#undef MYSTL_TRIVIAL_HASH_FCN
+
+// 对于浮点数，逐位哈希; +0.0 与 -0.0 相等, 因此先把 0 统一处理
+template <>
+struct hash<float>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(const float& val) const noexcept
+	{
+		if (val == 0.0f)
+			return static_cast<size_t>(mystl::hash_int(0));
+		uint32_t bits;
+		std::memcpy(&bits, &val, sizeof(bits));
+		return static_cast<size_t>(mystl::hash_int(bits));
+	}
+};
+
+template <>
+struct hash<double>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(const double& val) const noexcept
+	{
+		if (val == 0.0)
+			return static_cast<size_t>(mystl::hash_int(0));
+		uint64_t bits;
+		std::memcpy(&bits, &val, sizeof(bits));
+		return static_cast<size_t>(mystl::hash_int(bits));
+	}
+};
+
+template <>
+struct hash<long double>
+{
+	typedef void is_avalanching;
+
+	// long double 可能含有未使用的填充字节, 转为 double 后再哈希
+	size_t operator()(const long double& val) const noexcept
+	{
+		return hash<double>()(static_cast<double>(val));
+	}
+};
+
+// 对于字符串，对其字节内容哈希
+template <class CharT, class Traits, class Alloc>
+struct hash<std::basic_string<CharT, Traits, Alloc>>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(const std::basic_string<CharT, Traits, Alloc>& str) const noexcept
+	{
+		return static_cast<size_t>(mystl::hash_bytes(str.data(), str.size() * sizeof(CharT)));
+	}
+};
+
+/*****************************************************************************************/
+// hash_combine
+// 把 value 的哈希值合并进 seed, 用于为 pair 以及由多个成员组成的类型计算哈希值
+// 合并的结果与顺序有关: 先合并 a 再合并 b 与相反的顺序结果不同
+/*****************************************************************************************/
+
+inline size_t hash_combine_value(size_t seed, size_t h) noexcept
+{
+	return static_cast<size_t>(hash_detail::mix(static_cast<uint64_t>(seed) ^ hash_detail::kSecret2,
+	                                            static_cast<uint64_t>(h) ^ hash_detail::kSecret3));
+}
+
+template <class T>
+void hash_combine(size_t& seed, const T& value)
+{
+	seed = mystl::hash_combine_value(seed, mystl::hash<T>()(value));
+}
+
+// 依次合并多个值的哈希值
+inline size_t hash_values() noexcept
+{
+	return 0;
+}
+
+template <class T, class... Rest>
+size_t hash_values(const T& value, const Rest& ...rest)
+{
+	size_t seed = mystl::hash_values(rest...);
+	mystl::hash_combine(seed, value);
+	return seed;
+}
+
+// 针对 pair 的特化版本
+template <class T1, class T2>
+struct hash<mystl::pair<T1, T2>>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(const mystl::pair<T1, T2>& p) const
+	{
+		return mystl::hash_values(p.first, p.second);
+	}
+};
+
+
+/*****************************************************************************************/
+// invoke
+// 统一调用普通可调用对象、成员函数指针与数据成员指针
+// 成员指针的第一个参数可以是对象(或其派生类对象)、std::reference_wrapper 或指针
+/*****************************************************************************************/
+
+namespace invoke_detail
+{
+
+template <class T>
+struct is_reference_wrapper : mystl::m_false_type {};
+
+template <class T>
+struct is_reference_wrapper<std::reference_wrapper<T>> : mystl::m_true_type {};
+
+// 成员指针的对象参数: 0 为对象本身, 1 为 reference_wrapper, 2 为指针
+template <class C, class T1>
+using object_kind = std::integral_constant<int,
+	std::is_base_of<C, typename std::decay<T1>::type>::value ? 0 :
+	is_reference_wrapper<typename std::decay<T1>::type>::value ? 1 : 2>;
+
+template <class T1>
+T1&& get_object(std::integral_constant<int, 0>, T1&& t1) noexcept
+{
+	return mystl::forward<T1>(t1);
+}
+
+template <class T1>
+auto get_object(std::integral_constant<int, 1>, T1&& t1) noexcept -> decltype(t1.get())
+{
+	return t1.get();
+}
+
+template <class T1>
+auto get_object(std::integral_constant<int, 2>, T1&& t1) -> decltype(*mystl::forward<T1>(t1))
+{
+	return *mystl::forward<T1>(t1);
+}
+
+// 成员函数指针
+template <class P, class C, class T1, class... Args>
+auto invoke_member(m_true_type, P C::* f, T1&& t1, Args&&... args)
+	-> decltype((get_object(object_kind<C, T1>(), mystl::forward<T1>(t1)).*f)(mystl::forward<Args>(args)...))
+{
+	return (get_object(object_kind<C, T1>(), mystl::forward<T1>(t1)).*f)(mystl::forward<Args>(args)...);
+}
+
+// 数据成员指针
+template <class P, class C, class T1>
+auto invoke_member(m_false_type, P C::* f, T1&& t1)
+	-> decltype(get_object(object_kind<C, T1>(), mystl::forward<T1>(t1)).*f)
+{
+	return get_object(object_kind<C, T1>(), mystl::forward<T1>(t1)).*f;
+}
+
+template <class F, class... Args>
+auto invoke_impl(m_false_type, F&& f, Args&&... args)
+	-> decltype(mystl::forward<F>(f)(mystl::forward<Args>(args)...))
+{
+	return mystl::forward<F>(f)(mystl::forward<Args>(args)...);
+}
+
+template <class P, class C, class... Args>
+auto invoke_impl(m_true_type, P C::* f, Args&&... args)
+	-> decltype(invoke_member(m_bool_constant<std::is_function<P>::value>(), f, mystl::forward<Args>(args)...))
+{
+	return invoke_member(m_bool_constant<std::is_function<P>::value>(), f, mystl::forward<Args>(args)...);
+}
+
+} // namespace invoke_detail
+
+template <class F, class... Args>
+auto invoke(F&& f, Args&&... args)
+	-> decltype(invoke_detail::invoke_impl(m_bool_constant<std::is_member_pointer<typename std::decay<F>::type>::value>(),
+	                                       mystl::forward<F>(f), mystl::forward<Args>(args)...))
+{
+	return invoke_detail::invoke_impl(m_bool_constant<std::is_member_pointer<typename std::decay<F>::type>::value>(),
+	                                  mystl::forward<F>(f), mystl::forward<Args>(args)...);
+}
+
+namespace invoke_detail
+{
+
+template <class AlwaysVoid, class F, class... Args>
+struct invoke_result_impl
+{
+};
+
+template <class F, class... Args>
+struct invoke_result_impl<decltype(void(mystl::invoke(std::declval<F>(), std::declval<Args>()...))), F, Args...>
+{
+	typedef decltype(mystl::invoke(std::declval<F>(), std::declval<Args>()...)) type;
+};
+
+template <class AlwaysVoid, class R, class F, class... Args>
+struct is_invocable_r_impl : m_false_type {};
+
+template <class R, class F, class... Args>
+struct is_invocable_r_impl<decltype(void(mystl::invoke(std::declval<F>(), std::declval<Args>()...))), R, F, Args...>
+	: m_bool_constant<std::is_void<R>::value ||
+	                  std::is_convertible<decltype(mystl::invoke(std::declval<F>(), std::declval<Args>()...)), R>::value>
+{
+};
+
+} // namespace invoke_detail
+
+// 以 Args 调用 F 的结果类型, 不能调用时没有 type 成员
+template <class F, class... Args>
+struct invoke_result : invoke_detail::invoke_result_impl<void, F, Args...> {};
+
+// 能否以 Args 调用 F, 且结果可以转换为 R(R 为 void 时忽略结果)
+template <class R, class F, class... Args>
+struct is_invocable_r : invoke_detail::is_invocable_r_impl<void, R, F, Args...> {};
+
+// 调用并把结果转换为 R
+template <class R, class F, class... Args>
+typename std::enable_if<std::is_void<R>::value, R>::type
+invoke_r(F&& f, Args&&... args)
+{
+	mystl::invoke(mystl::forward<F>(f), mystl::forward<Args>(args)...);
+}
+
+template <class R, class F, class... Args>
+typename std::enable_if<!std::is_void<R>::value, R>::type
+invoke_r(F&& f, Args&&... args)
+{
+	return mystl::invoke(mystl::forward<F>(f), mystl::forward<Args>(args)...);
+}
+
+/*****************************************************************************************/
+// function / move_only_function / function_ref
+//   * function<R(Args...), Size>           : 可复制的类型擦除可调用对象
+//   * move_only_function<R(Args...), Size> : 只能移动, 可以保存不可复制的可调用对象(如捕获了 unique_ptr 的 lambda)
+//   * function_ref<R(Args...)>             : 不拥有可调用对象, 只保存对象指针与调用函数指针, 用作参数
+// 前两者在对象内有 Size 字节的缓冲区, 可调用对象放得下、对齐满足且移动不抛出异常时就地构造, 否则保存在堆上
+// 对象中直接保存调用函数指针, 调用时只有一次间接跳转; 空对象的调用函数指针指向一个抛出
+// std::bad_function_call 的函数, 所以调用时不需要检查是否为空
+/*****************************************************************************************/
+
+// function 与 move_only_function 默认的缓冲区大小
+#ifndef MYSTL_FUNCTION_INLINE_SIZE
+#define MYSTL_FUNCTION_INLINE_SIZE 32
+#endif // !MYSTL_FUNCTION_INLINE_SIZE
+
+namespace function_detail
+{
+
+// 调用空的 function: 有异常时抛出 std::bad_function_call, 无异常模式下交给错误处理函数
+[[noreturn]] MYSTL_COLD inline void report_bad_function_call()
+{
+#if !defined(MYSTL_NO_EXCEPTIONS)
+	throw std::bad_function_call();
+#else
+	mystl::report_error(errc::bad_function_call, "call to empty mystl::function");
+#endif
+}
+
+enum class manage_op { move, copy, destroy };
+
+template <size_t Size>
+union storage
+{
+	void* ptr;
+	alignas(std::max_align_t) unsigned char buf[Size < sizeof(void*) ? sizeof(void*) : Size];
+};
+
+template <class F, size_t Size>
+struct stored_inline
+	: m_bool_constant<sizeof(F) <= Size && alignof(std::max_align_t) % alignof(F) == 0 &&
+	                  std::is_nothrow_move_constructible<F>::value>
+{
+};
+
+// 空对象, 以及可以就地保存 F 时的操作
+template <class F, size_t Size, bool Inline = stored_inline<F, Size>::value>
+struct handler
+{
+	static F* get(storage<Size>& s) noexcept
+	{
+		return reinterpret_cast<F*>(s.buf);
+	}
+
+	template <class... A>
+	static void create(storage<Size>& s, A&&... a)
+	{
+		::new (static_cast<void*>(s.buf)) F(mystl::forward<A>(a)...);
+	}
+
+	static void copy(storage<Size>& dst, storage<Size>& src, m_true_type)
+	{
+		::new (static_cast<void*>(dst.buf)) F(*get(src));
+	}
+
+	static void copy(storage<Size>&, storage<Size>&, m_false_type) noexcept
+	{
+	}
+
+	template <bool Copyable>
+	static void manage(manage_op op, storage<Size>& dst, storage<Size>& src)
+	{
+		switch (op)
+		{
+		case manage_op::move:
+			::new (static_cast<void*>(dst.buf)) F(mystl::move(*get(src)));
+			get(src)->~F();
+			break;
+		case manage_op::copy:
+			copy(dst, src, m_bool_constant<Copyable>());
+			break;
+		case manage_op::destroy:
+			get(dst)->~F();
+			break;
+		}
+	}
+};
+
+// F 保存在堆上, 缓冲区中只有指针
+template <class F, size_t Size>
+struct handler<F, Size, false>
+{
+	static F* get(storage<Size>& s) noexcept
+	{
+		return static_cast<F*>(s.ptr);
+	}
+
+	template <class... A>
+	static void create(storage<Size>& s, A&&... a)
+	{
+		s.ptr = new F(mystl::forward<A>(a)...);
+	}
+
+	static void copy(storage<Size>& dst, storage<Size>& src, m_true_type)
+	{
+		dst.ptr = new F(*get(src));
+	}
+
+	static void copy(storage<Size>&, storage<Size>&, m_false_type) noexcept
+	{
+	}
+
+	template <bool Copyable>
+	static void manage(manage_op op, storage<Size>& dst, storage<Size>& src)
+	{
+		switch (op)
+		{
+		case manage_op::move:
+			dst.ptr = src.ptr;
+			break;
+		case manage_op::copy:
+			copy(dst, src, m_bool_constant<Copyable>());
+			break;
+		case manage_op::destroy:
+			delete get(dst);
+			break;
+		}
+	}
+};
+
+// 空的函数指针与成员指针视为空对象
+template <class F>
+bool is_null(const F& f, m_true_type) noexcept
+{
+	return f == nullptr;
+}
+
+template <class F>
+bool is_null(const F&, m_false_type) noexcept
+{
+	return false;
+}
+
+template <class Sig, size_t Size, bool Copyable>
+class function_base;
+
+// function 与 move_only_function 的公共实现
+template <class R, class... Args, size_t Size, bool Copyable>
+class function_base<R(Args...), Size, Copyable>
+{
+protected:
+	typedef storage<Size>                              storage_type;
+	typedef R (*invoker_type)(storage_type&, Args&&...);
+	typedef void (*manager_type)(manage_op, storage_type&, storage_type&);
+
+	mutable storage_type storage_;
+	invoker_type         invoker_;
+	manager_type         manager_;   // 为空时对象为空
+
+	template <class F>
+	static R invoke_stored(storage_type& s, Args&&... args)
+	{
+		return mystl::invoke_r<R>(*handler<F, Size>::get(s), mystl::forward<Args>(args)...);
+	}
+
+	static R invoke_empty(storage_type&, Args&&...)
+	{
+		function_detail::report_bad_function_call();
+	}
+
+public:
+	function_base() noexcept
+		:invoker_(&invoke_empty), manager_(nullptr)
+	{
+	}
+
+	function_base(const function_base& rhs)
+		:invoker_(rhs.invoker_), manager_(rhs.manager_)
+	{
+		if (manager_)
+			manager_(manage_op::copy, storage_, rhs.storage_);
+	}
+
+	function_base(function_base&& rhs) noexcept
+		:invoker_(rhs.invoker_), manager_(rhs.manager_)
+	{
+		if (manager_)
+			manager_(manage_op::move, storage_, rhs.storage_);
+		rhs.invoker_ = &invoke_empty;
+		rhs.manager_ = nullptr;
+	}
+
+	~function_base()
+	{
+		if (manager_)
+			manager_(manage_op::destroy, storage_, storage_);
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return manager_ != nullptr;
+	}
+
+	R operator()(Args... args) const
+	{
+		return invoker_(storage_, mystl::forward<Args>(args)...);
+	}
+
+	// 保存的可调用对象的类型为 F 时返回指向它的指针, 否则返回空指针; 不需要 RTTI
+	template <class F>
+	F* target() noexcept
+	{
+		return manager_ == &handler<F, Size>::template manage<Copyable> ? handler<F, Size>::get(storage_) : nullptr;
+	}
+
+	template <class F>
+	const F* target() const noexcept
+	{
+		return manager_ == &handler<F, Size>::template manage<Copyable> ? handler<F, Size>::get(storage_) : nullptr;
+	}
+
+protected:
+	template <class F>
+	void init(F&& f)
+	{
+		typedef typename std::decay<F>::type functor;
+		if (is_null<functor>(f, m_bool_constant<std::is_pointer<functor>::value ||
+		                                         std::is_member_pointer<functor>::value>()))
+			return;
+		handler<functor, Size>::create(storage_, mystl::forward<F>(f));
+		invoker_ = &invoke_stored<functor>;
+		manager_ = &handler<functor, Size>::template manage<Copyable>;
+	}
+
+	void clear() noexcept
+	{
+		if (manager_)
+			manager_(manage_op::destroy, storage_, storage_);
+		invoker_ = &invoke_empty;
+		manager_ = nullptr;
+	}
+
+	void move_assign(function_base& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			clear();
+			if (rhs.manager_)
+				rhs.manager_(manage_op::move, storage_, rhs.storage_);
+			invoker_ = rhs.invoker_;
+			manager_ = rhs.manager_;
+			rhs.invoker_ = &invoke_empty;
+			rhs.manager_ = nullptr;
+		}
+	}
+
+	void swap_base(function_base& rhs) noexcept
+	{
+		function_base tmp(mystl::move(rhs));
+		rhs.move_assign(*this);
+		move_assign(tmp);
+	}
+};
+
+} // namespace function_detail
+
+template <class Sig, size_t Size = MYSTL_FUNCTION_INLINE_SIZE>
+class function;
+
+template <class R, class... Args, size_t Size>
+class function<R(Args...), Size> : public function_detail::function_base<R(Args...), Size, true>
+{
+	typedef function_detail::function_base<R(Args...), Size, true> base;
+
+	// 只有 F 可以复制、可以用 Args 调用且结果能转换为 R 时才启用
+	template <class F>
+	using enable_if_callable = typename std::enable_if<
+		!std::is_same<typename std::decay<F>::type, function>::value &&
+		std::is_copy_constructible<typename std::decay<F>::type>::value &&
+		mystl::is_invocable_r<R, typename std::decay<F>::type&, Args...>::value, int>::type;
+
+public:
+	typedef R result_type;
+
+	function() noexcept = default;
+	function(std::nullptr_t) noexcept {}
+	function(const function&) = default;
+	function(function&&) noexcept = default;
+
+	template <class F, enable_if_callable<F> = 0>
+	function(F&& f)
+	{
+		this->init(mystl::forward<F>(f));
+	}
+
+	function& operator=(const function& rhs)
+	{
+		function tmp(rhs);
+		swap(tmp);
+		return *this;
+	}
+
+	function& operator=(function&& rhs) noexcept
+	{
+		this->move_assign(rhs);
+		return *this;
+	}
+
+	function& operator=(std::nullptr_t) noexcept
+	{
+		this->clear();
+		return *this;
+	}
+
+	template <class F, enable_if_callable<F> = 0>
+	function& operator=(F&& f)
+	{
+		function tmp(mystl::forward<F>(f));
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(function& rhs) noexcept
+	{
+		this->swap_base(rhs);
+	}
+};
+
+template <class Sig, size_t Size = MYSTL_FUNCTION_INLINE_SIZE>
+class move_only_function;
+
+template <class R, class... Args, size_t Size>
+class move_only_function<R(Args...), Size> : public function_detail::function_base<R(Args...), Size, false>
+{
+	typedef function_detail::function_base<R(Args...), Size, false> base;
+
+	template <class F>
+	using enable_if_callable = typename std::enable_if<
+		!std::is_same<typename std::decay<F>::type, move_only_function>::value &&
+		mystl::is_invocable_r<R, typename std::decay<F>::type&, Args...>::value, int>::type;
+
+public:
+	typedef R result_type;
+
+	move_only_function() noexcept = default;
+	move_only_function(std::nullptr_t) noexcept {}
+	move_only_function(const move_only_function&) = delete;
+	move_only_function(move_only_function&&) noexcept = default;
+
+	template <class F, enable_if_callable<F> = 0>
+	move_only_function(F&& f)
+	{
+		this->init(mystl::forward<F>(f));
+	}
+
+	move_only_function& operator=(const move_only_function&) = delete;
+
+	move_only_function& operator=(move_only_function&& rhs) noexcept
+	{
+		this->move_assign(rhs);
+		return *this;
+	}
+
+	move_only_function& operator=(std::nullptr_t) noexcept
+	{
+		this->clear();
+		return *this;
+	}
+
+	template <class F, enable_if_callable<F> = 0>
+	move_only_function& operator=(F&& f)
+	{
+		move_only_function tmp(mystl::forward<F>(f));
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(move_only_function& rhs) noexcept
+	{
+		this->swap_base(rhs);
+	}
+};
+
+template <class Sig>
+class function_ref;
+
+template <class R, class... Args>
+class function_ref<R(Args...)>
+{
+	// 可调用对象的地址; 绑定到函数指针时保存函数指针本身
+	union bound_entity
+	{
+		void* obj;
+		void (*fn)();
+	};
+
+	typedef R (*invoker_type)(bound_entity, Args&&...);
+
+	bound_entity entity_;
+	invoker_type invoker_;
+
+	template <class F>
+	static R invoke_object(bound_entity e, Args&&... args)
+	{
+		return mystl::invoke_r<R>(*static_cast<F*>(e.obj), mystl::forward<Args>(args)...);
+	}
+
+	template <class Fp>
+	static R invoke_pointer(bound_entity e, Args&&... args)
+	{
+		return mystl::invoke_r<R>(reinterpret_cast<Fp>(e.fn), mystl::forward<Args>(args)...);
+	}
+
+public:
+	// 绑定到函数
+	template <class Fn, typename std::enable_if<std::is_function<Fn>::value &&
+		mystl::is_invocable_r<R, Fn*, Args...>::value, int>::type = 0>
+	function_ref(Fn* fn) noexcept
+	{
+		MYSTL_DEBUG(fn != nullptr);
+		entity_.fn = reinterpret_cast<void (*)()>(fn);
+		invoker_ = &invoke_pointer<Fn*>;
+	}
+
+	// 绑定到可调用对象, 不延长它的生命周期
+	template <class F, typename std::enable_if<
+		!std::is_same<typename std::decay<F>::type, function_ref>::value &&
+		!std::is_pointer<typename std::decay<F>::type>::value &&
+		mystl::is_invocable_r<R, typename std::remove_reference<F>::type&, Args...>::value, int>::type = 0>
+	function_ref(F&& f) noexcept
+	{
+		typedef typename std::remove_reference<F>::type functor;
+		entity_.obj = const_cast<void*>(static_cast<const volatile void*>(std::addressof(f)));
+		invoker_ = &invoke_object<functor>;
+	}
+
+	function_ref(const function_ref&) noexcept = default;
+	function_ref& operator=(const function_ref&) noexcept = default;
+
+	R operator()(Args... args) const
+	{
+		return invoker_(entity_, mystl::forward<Args>(args)...);
+	}
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_FUNCTIONAL_H_
@@ -0,0 +1,994 @@
+#ifndef MYTINYSTL_HASHTABLE_H_
+#define MYTINYSTL_HASHTABLE_H_
+
+// 这个头文件包含了一个模板类 hashtable
+// hashtable : 开放寻址的哈希表, 用于实现 unordered_map, unordered_set 与 node_hash_map
+
+// notes:
+//
+// hashtable 没有采用"桶 + 链表"的结构(每个元素一次内存分配, 查找时沿链表跳转),
+// 而是把元素直接放在一个连续数组(slots)中, 并为每个位置配一个字节的控制信息(ctrl):
+//   * kCtrlEmpty   : 空位置
+//   * kCtrlDeleted : 墓碑, 元素已被删除, 但探测序列不能在此终止
+//   * 0 ~ 127      : 有元素, 值为该元素哈希值的低 7 位(h2)
+// 哈希值的其余高位(h1)决定探测从哪个组开始, 每组 16 个位置, 16 个控制字节用一条 SSE2 指令
+// 与 h2 比较, 得到一个 16 位的候选掩码, 只有候选位置才需要调用 key_equal; 组内出现空位置时查找结束
+// 组与组之间按三角数序列探测(g, g+1, g+3, g+6, ...), 组数为 2 的幂时可以遍历所有组
+//
+// 删除元素时, 若该元素所在的组中仍有空位置, 说明从未有探测序列越过这个组, 可以直接标记为空,
+// 否则才需要留下墓碑; 墓碑过多时在插入触发扩容时按原容量重建, 一并清除
+//
+// 元素的存放方式由 Policy 决定:
+//   * flat_set_policy  / flat_map_policy : 元素直接存放在数组中, 重新哈希时会移动元素
+//   * node_map_policy                    : 数组中只存放指向元素的指针, 元素的地址在其生命期内不变
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "algobase.h"
+#include "iterator.h"
+#include "memory.h"
+#include "fuctional.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 控制字节与组
+/*****************************************************************************************/
+
+typedef signed char ctrl_t;
+
+constexpr ctrl_t kCtrlEmpty = static_cast<ctrl_t>(-128);
+constexpr ctrl_t kCtrlDeleted = static_cast<ctrl_t>(-2);
+
+// 每组的位置个数
+constexpr size_t kHashGroupWidth = 16;
+
+// hashtable 的默认最大负载因子
+constexpr float kHashDefaultMaxLoadFactor = 0.875f;
+
+inline bool ctrl_is_full(ctrl_t c) noexcept
+{
+	return c >= 0;
+}
+
+// 最低位 1 的位置
+inline unsigned hash_group_ctz(unsigned x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_ctz(x));
+#else
+	unsigned r = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+// 组内匹配结果, 第 i 位为 1 表示第 i 个位置满足条件
+// 使用方式: for (auto m = g.match(h2); m; m.clear_lowest()) { use(m.lowest()); }
+class hash_group_mask
+{
+private:
+	unsigned mask_;
+
+public:
+	explicit hash_group_mask(unsigned mask) noexcept : mask_(mask) {}
+
+	explicit operator bool() const noexcept { return mask_ != 0; }
+
+	unsigned lowest() const noexcept { return hash_group_ctz(mask_); }
+	void     clear_lowest() noexcept { mask_ &= mask_ - 1; }
+};
+
+// 一组 16 个控制字节
+struct hash_group
+{
+#if defined(__SSE2__)
+	__m128i ctrl;
+
+	// pos 必须按 16 字节对齐
+	explicit hash_group(const ctrl_t* pos) noexcept
+		:ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(pos)))
+	{
+	}
+
+	// 控制字节等于 h2 的位置
+	hash_group_mask match(ctrl_t h2) const noexcept
+	{
+		return hash_group_mask(static_cast<unsigned>(
+			_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+	}
+
+	// 空位置
+	hash_group_mask match_empty() const noexcept
+	{
+		return hash_group_mask(static_cast<unsigned>(
+			_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kCtrlEmpty), ctrl))));
+	}
+
+	// 空位置或墓碑, 即控制字节为负数的位置
+	hash_group_mask match_empty_or_deleted() const noexcept
+	{
+		return hash_group_mask(static_cast<unsigned>(_mm_movemask_epi8(ctrl)));
+	}
+#else
+	const ctrl_t* ctrl;
+
+	explicit hash_group(const ctrl_t* pos) noexcept
+		:ctrl(pos)
+	{
+	}
+
+	hash_group_mask match(ctrl_t h2) const noexcept
+	{
+		unsigned m = 0;
+		for (size_t i = 0; i < kHashGroupWidth; ++i)
+			m |= static_cast<unsigned>(ctrl[i] == h2) << i;
+		return hash_group_mask(m);
+	}
+
+	hash_group_mask match_empty() const noexcept
+	{
+		return match(kCtrlEmpty);
+	}
+
+	hash_group_mask match_empty_or_deleted() const noexcept
+	{
+		unsigned m = 0;
+		for (size_t i = 0; i < kHashGroupWidth; ++i)
+			m |= static_cast<unsigned>(ctrl[i] < 0) << i;
+		return hash_group_mask(m);
+	}
+#endif
+};
+
+// 对用户提供的哈希值再做一次混合, 使低位与高位都依赖输入的全部位
+// 哈希函数本身已有雪崩效果(定义了 is_avalanching)时跳过
+inline size_t hash_mix(size_t h) noexcept
+{
+#if SIZE_MAX > UINT32_MAX
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+#else
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+#endif
+	return h;
+}
+
+/*****************************************************************************************/
+// 存放策略
+// 每种策略提供:
+//   slot_type / value_type / key_type
+//   element(slot)            : 由位置得到元素的引用
+//   key(value)               : 由元素得到键
+//   construct(slot, args...) : 在位置上构造元素
+//   destroy(slot)            : 销毁位置上的元素
+//   transfer(to, from)       : 把元素从 from 移到未构造的 to, 之后 from 视为未构造
+/*****************************************************************************************/
+
+// 元素直接存放, 用于 unordered_set
+template <class T>
+struct flat_set_policy
+{
+	typedef T key_type;
+	typedef T value_type;
+	typedef T slot_type;
+
+	static value_type& element(slot_type* slot) noexcept { return *slot; }
+	static const key_type& key(const value_type& value) noexcept { return value; }
+
+	template <class... Args>
+	static void construct(slot_type* slot, Args&& ...args)
+	{
+		mystl::construct(slot, mystl::forward<Args>(args)...);
+	}
+
+	static void destroy(slot_type* slot) noexcept
+	{
+		mystl::destroy(slot);
+	}
+
+	static void transfer(slot_type* to, slot_type* from)
+	{
+		mystl::construct(to, mystl::move(*from));
+		mystl::destroy(from);
+	}
+};
+
+// 键值对直接存放, 用于 unordered_map
+// 位置上实际构造的是 pair<K, V>, 对外以 pair<const K, V> 的形式给出, 这样重新哈希时可以移动键,
+// 而不必复制; 两者布局完全相同(与 libc++ 的做法一致)
+template <class K, class V>
+struct flat_map_policy
+{
+	typedef K                          key_type;
+	typedef V                          mapped_type;
+	typedef mystl::pair<const K, V>    value_type;
+	typedef mystl::pair<K, V>          slot_type;
+
+	static value_type& element(slot_type* slot) noexcept
+	{
+		return reinterpret_cast<value_type&>(*slot);
+	}
+	static const key_type& key(const value_type& value) noexcept { return value.first; }
+
+	template <class... Args>
+	static void construct(slot_type* slot, Args&& ...args)
+	{
+		mystl::construct(slot, mystl::forward<Args>(args)...);
+	}
+
+	// 以键与构造值的参数构造, 用于 try_emplace / operator[]
+	template <class Key, class... Args>
+	static void construct_with_key(slot_type* slot, Key&& k, Args&& ...args)
+	{
+		mystl::construct(slot, mystl::forward<Key>(k), mapped_type(mystl::forward<Args>(args)...));
+	}
+
+	static void destroy(slot_type* slot) noexcept
+	{
+		mystl::destroy(slot);
+	}
+
+	static void transfer(slot_type* to, slot_type* from)
+	{
+		mystl::construct(to, mystl::move(*from));
+		mystl::destroy(from);
+	}
+};
+
+// 键值对单独分配, 数组中只存放指针, 用于 node_hash_map
+// 重新哈希只移动指针, 元素的地址保持不变
+template <class K, class V>
+struct node_map_policy
+{
+	typedef K                          key_type;
+	typedef V                          mapped_type;
+	typedef mystl::pair<const K, V>    value_type;
+	typedef value_type*                slot_type;
+	typedef mystl::allocator<value_type> node_allocator;
+
+	static value_type& element(slot_type* slot) noexcept { return **slot; }
+	static const key_type& key(const value_type& value) noexcept { return value.first; }
+
+	template <class... Args>
+	static void construct(slot_type* slot, Args&& ...args)
+	{
+		value_type* node = node_allocator::allocate(1);
+		MYSTL_TRY
+		{
+			node_allocator::construct(node, mystl::forward<Args>(args)...);
+		}
+		MYSTL_CATCH_ALL
+		{
+			node_allocator::deallocate(node, 1);
+			MYSTL_RETHROW;
+		}
+		*slot = node;
+	}
+
+	template <class Key, class... Args>
+	static void construct_with_key(slot_type* slot, Key&& k, Args&& ...args)
+	{
+		construct(slot, mystl::forward<Key>(k), mapped_type(mystl::forward<Args>(args)...));
+	}
+
+	static void destroy(slot_type* slot) noexcept
+	{
+		node_allocator::destroy(*slot);
+		node_allocator::deallocate(*slot, 1);
+	}
+
+	static void transfer(slot_type* to, slot_type* from) noexcept
+	{
+		*to = *from;
+	}
+};
+
+/*****************************************************************************************/
+// 哈希函数的特性萃取
+// 当 Hash 与 KeyEqual 都定义了 is_transparent 时, 查找类函数接受任意可与键比较的类型(见 key_arg)
+/*****************************************************************************************/
+
+// 哈希函数定义了 is_avalanching 时, 说明结果的每一位都已充分混合, 不需要再做 hash_mix
+template <class T>
+struct hash_is_avalanching
+{
+private:
+	template <class U>
+	static char test(typename U::is_avalanching*);
+	template <class U>
+	static long test(...);
+
+public:
+	static constexpr bool value = sizeof(test<T>(nullptr)) == 1;
+};
+
+/*****************************************************************************************/
+// hashtable 的迭代器
+// 依次访问控制字节为"有元素"的位置, 构造时与每次前进后都跳过空位置与墓碑
+/*****************************************************************************************/
+
+template <class Policy, class Hash, class KeyEqual>
+class hashtable;
+
+template <class Policy, bool IsConst>
+class hashtable_iterator
+{
+	template <class P, class H, class E>
+	friend class hashtable;
+	template <class P, bool C>
+	friend class hashtable_iterator;
+
+public:
+	typedef mystl::forward_iterator_tag                        iterator_category;
+	typedef typename Policy::value_type                        value_type;
+	typedef ptrdiff_t                                          difference_type;
+	typedef typename std::conditional<IsConst,
+		const value_type*, value_type*>::type                  pointer;
+	typedef typename std::conditional<IsConst,
+		const value_type&, value_type&>::type                  reference;
+
+	typedef typename Policy::slot_type                         slot_type;
+
+private:
+	const ctrl_t* ctrl_;  // 当前位置的控制字节
+	slot_type*    slot_;  // 当前位置
+	const ctrl_t* end_;   // 控制字节数组的尾部
+
+	hashtable_iterator(const ctrl_t* ctrl, slot_type* slot, const ctrl_t* end) noexcept
+		:ctrl_(ctrl), slot_(slot), end_(end)
+	{
+	}
+
+	void skip_empty_or_deleted() noexcept
+	{
+		while (ctrl_ != end_ && !ctrl_is_full(*ctrl_))
+		{
+			++ctrl_;
+			++slot_;
+		}
+	}
+
+public:
+	hashtable_iterator() noexcept
+		:ctrl_(nullptr), slot_(nullptr), end_(nullptr)
+	{
+	}
+
+	// 非 const 迭代器可以转换为 const 迭代器
+	template <bool C, typename std::enable_if<IsConst && !C, int>::type = 0>
+	hashtable_iterator(const hashtable_iterator<Policy, C>& rhs) noexcept
+		:ctrl_(rhs.ctrl_), slot_(rhs.slot_), end_(rhs.end_)
+	{
+	}
+
+	reference operator*()  const { return Policy::element(slot_); }
+	pointer   operator->() const { return &(operator*()); }
+
+	hashtable_iterator& operator++() noexcept
+	{
+		++ctrl_;
+		++slot_;
+		skip_empty_or_deleted();
+		return *this;
+	}
+
+	hashtable_iterator operator++(int) noexcept
+	{
+		hashtable_iterator tmp = *this;
+		++*this;
+		return tmp;
+	}
+
+	bool operator==(const hashtable_iterator& rhs) const noexcept { return ctrl_ == rhs.ctrl_; }
+	bool operator!=(const hashtable_iterator& rhs) const noexcept { return ctrl_ != rhs.ctrl_; }
+};
+
+/*****************************************************************************************/
+// 模板类 hashtable
+// 参数一代表存放策略，参数二代表哈希函数，参数三代表键值相等的比较函数
+// 只支持键唯一的插入, 容器的公共部分(查找、插入、删除、容量管理)都在这里实现
+/*****************************************************************************************/
+
+template <class Policy, class Hash, class KeyEqual>
+class hashtable
+{
+public:
+	typedef typename Policy::key_type     key_type;
+	typedef typename Policy::value_type   value_type;
+	typedef typename Policy::slot_type    slot_type;
+	typedef Hash                          hasher;
+	typedef KeyEqual                      key_equal;
+
+	typedef size_t                        size_type;
+	typedef ptrdiff_t                     difference_type;
+	typedef value_type&                   reference;
+	typedef const value_type&             const_reference;
+	typedef value_type*                   pointer;
+	typedef const value_type*             const_pointer;
+
+	typedef hashtable_iterator<Policy, false> iterator;
+	typedef hashtable_iterator<Policy, true>  const_iterator;
+
+	typedef mystl::allocator<unsigned char> byte_allocator;
+
+	// 查找类函数的参数类型, 只有 Hash 与 KeyEqual 都透明时才是 K 本身
+	template <class K>
+	using key_arg = typename transparent_key_arg<mystl::has_is_transparent<Hash>::value &&
+		mystl::has_is_transparent<KeyEqual>::value>::template type<K, key_type>;
+
+	static_assert(alignof(slot_type) <= alignof(std::max_align_t),
+	              "over-aligned types are not supported by hashtable");
+
+private:
+	ctrl_t*    ctrl_;         // 控制字节数组, 与 slots_ 位于同一块内存的头部
+	slot_type* slots_;        // 元素数组
+	size_type  size_;         // 元素个数
+	size_type  capacity_;     // 位置个数, 为 0 或 16 的 2 的幂倍
+	size_type  growth_left_;  // 不触发扩容时还能占用的空位置个数
+	float      mlf_;          // 最大负载因子
+	hasher     hash_;
+	key_equal  equals_;
+
+public:
+	// 构造、复制、移动、析构函数
+	explicit hashtable(size_type bucket_count = 0,
+	                   const Hash& hash = Hash(),
+	                   const KeyEqual& equal = KeyEqual())
+		:ctrl_(nullptr), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+		mlf_(kHashDefaultMaxLoadFactor), hash_(hash), equals_(equal)
+	{
+		if (bucket_count != 0)
+			resize(normalize_capacity(bucket_count));
+	}
+
+	hashtable(const hashtable& rhs)
+		:ctrl_(nullptr), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+		mlf_(rhs.mlf_), hash_(rhs.hash_), equals_(rhs.equals_)
+	{
+		if (rhs.size_ == 0)
+			return;
+		resize(capacity_for(rhs.size_));
+		MYSTL_TRY
+		{
+			// 目标表中没有重复的键, 也不会触发扩容, 直接找到第一个非满的位置构造
+			for (auto it = rhs.begin(); it != rhs.end(); ++it)
+			{
+				const size_t h = hash_of(Policy::key(*it));
+				const size_type i = find_first_non_full(h);
+				Policy::construct(slots_ + i, *it);
+				set_full(i, h);
+			}
+		}
+		MYSTL_CATCH_ALL
+		{
+			destroy_and_deallocate();
+			MYSTL_RETHROW;
+		}
+	}
+
+	hashtable(hashtable&& rhs) noexcept
+		:ctrl_(rhs.ctrl_), slots_(rhs.slots_), size_(rhs.size_), capacity_(rhs.capacity_),
+		growth_left_(rhs.growth_left_), mlf_(rhs.mlf_),
+		hash_(mystl::move(rhs.hash_)), equals_(mystl::move(rhs.equals_))
+	{
+		rhs.ctrl_ = nullptr;
+		rhs.slots_ = nullptr;
+		rhs.size_ = 0;
+		rhs.capacity_ = 0;
+		rhs.growth_left_ = 0;
+	}
+
+	hashtable& operator=(const hashtable& rhs)
+	{
+		if (this != &rhs)
+		{
+			hashtable tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	hashtable& operator=(hashtable&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			hashtable tmp(mystl::move(rhs));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	~hashtable()
+	{
+		destroy_and_deallocate();
+	}
+
+public:
+	// 迭代器相关操作
+	iterator       begin()        noexcept { return iterator_at(0, true); }
+	const_iterator begin()  const noexcept { return const_iterator_at(0, true); }
+	iterator       end()          noexcept { return iterator_at(capacity_, false); }
+	const_iterator end()    const noexcept { return const_iterator_at(capacity_, false); }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend()   const noexcept { return end(); }
+
+	// 容量相关操作
+	bool      empty()    const noexcept { return size_ == 0; }
+	size_type size()     const noexcept { return size_; }
+	size_type max_size() const noexcept
+	{
+		return static_cast<size_type>(-1) / (sizeof(slot_type) + 1) / 2;
+	}
+
+	// 修改容器相关操作
+
+	// 插入元素, 键已存在时不插入, 返回指向该键的迭代器
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{
+		return emplace_key(Policy::key(value), value);
+	}
+
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{
+		return emplace_key(Policy::key(value), mystl::move(value));
+	}
+
+	// 就地构造元素; 为了取得键, 先在栈上构造一个临时元素, 键不存在时再把它移入表中
+	template <class... Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		alignas(slot_type) unsigned char buf[sizeof(slot_type)];
+		slot_type* tmp = reinterpret_cast<slot_type*>(buf);
+		Policy::construct(tmp, mystl::forward<Args>(args)...);
+		mystl::pair<iterator, bool> result;
+		MYSTL_TRY
+		{
+			const key_type& k = Policy::key(Policy::element(tmp));
+			const size_t h = hash_of(k);
+			auto found = find_or_prepare_insert(k, h);
+			if (!found.second)
+			{
+				Policy::destroy(tmp);
+				return mystl::pair<iterator, bool>(iterator_at(found.first, false), false);
+			}
+			Policy::transfer(slots_ + found.first, tmp);
+			set_full(found.first, h);
+			result = mystl::pair<iterator, bool>(iterator_at(found.first, false), true);
+		}
+		MYSTL_CATCH_ALL
+		{
+			Policy::destroy(tmp);
+			MYSTL_RETHROW;
+		}
+		return result;
+	}
+
+	// 键不存在时以 args 构造元素; 键存在时什么也不做, args 不会被移动
+	template <class K, class... Args>
+	mystl::pair<iterator, bool> emplace_key(const K& key, Args&& ...args)
+	{
+		const size_t h = hash_of(key);
+		auto found = find_or_prepare_insert(key, h);
+		if (found.second)
+		{
+			Policy::construct(slots_ + found.first, mystl::forward<Args>(args)...);
+			set_full(found.first, h);
+		}
+		return mystl::pair<iterator, bool>(iterator_at(found.first, false), found.second);
+	}
+
+	// 键不存在时以 key 与 args 构造映射元素, 用于 map 的 try_emplace 与 operator[]
+	template <class K, class... Args>
+	mystl::pair<iterator, bool> try_emplace(K&& key, Args&& ...args)
+	{
+		const size_t h = hash_of(key);
+		auto found = find_or_prepare_insert(key, h);
+		if (found.second)
+		{
+			Policy::construct_with_key(slots_ + found.first, mystl::forward<K>(key),
+			                           mystl::forward<Args>(args)...);
+			set_full(found.first, h);
+		}
+		return mystl::pair<iterator, bool>(iterator_at(found.first, false), found.second);
+	}
+
+	template <class InputIter>
+	void insert(InputIter first, InputIter last)
+	{
+		for (; first != last; ++first)
+			emplace(*first);
+	}
+
+	// 删除元素, 返回下一个元素的迭代器
+	// 单独提供 iterator 版本, 避免透明查找时 erase(const K&) 把迭代器当作键
+	iterator erase(iterator pos)
+	{
+		return erase(const_iterator(pos));
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		MYSTL_DEBUG(pos != end());
+		const size_type i = static_cast<size_type>(pos.ctrl_ - ctrl_);
+		Policy::destroy(slots_ + i);
+		erase_meta(i);
+		return iterator_at(i + 1, true);
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		while (first != last)
+			first = erase(first);
+		return iterator_at(static_cast<size_type>(last.ctrl_ - ctrl_), false);
+	}
+
+	// 删除键为 key 的元素, 返回删除的个数
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{
+		const size_type i = find_index(key);
+		if (i == capacity_)
+			return 0;
+		Policy::destroy(slots_ + i);
+		erase_meta(i);
+		return 1;
+	}
+
+	// 销毁所有元素, 保留容量
+	void clear() noexcept
+	{
+		if (size_ != 0)
+		{
+			for (size_type i = 0; i < capacity_; ++i)
+			{
+				if (ctrl_is_full(ctrl_[i]))
+					Policy::destroy(slots_ + i);
+			}
+		}
+		reset_ctrl();
+	}
+
+	void swap(hashtable& rhs) noexcept
+	{
+		mystl::swap(ctrl_, rhs.ctrl_);
+		mystl::swap(slots_, rhs.slots_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(capacity_, rhs.capacity_);
+		mystl::swap(growth_left_, rhs.growth_left_);
+		mystl::swap(mlf_, rhs.mlf_);
+		mystl::swap(hash_, rhs.hash_);
+		mystl::swap(equals_, rhs.equals_);
+	}
+
+	// 查找相关操作
+	template <class K = key_type>
+	iterator find(const key_arg<K>& key)
+	{
+		return iterator_at(find_index(key), false);
+	}
+
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{
+		return const_iterator_at(find_index(key), false);
+	}
+
+	template <class K = key_type>
+	size_type count(const key_arg<K>& key) const
+	{
+		return find_index(key) == capacity_ ? 0 : 1;
+	}
+
+	template <class K = key_type>
+	bool contains(const key_arg<K>& key) const
+	{
+		return find_index(key) != capacity_;
+	}
+
+	template <class K = key_type>
+	mystl::pair<iterator, iterator> equal_range(const key_arg<K>& key)
+	{
+		auto it = find(key);
+		if (it == end())
+			return mystl::pair<iterator, iterator>(it, it);
+		auto next = it;
+		return mystl::pair<iterator, iterator>(it, ++next);
+	}
+
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{
+		auto it = find(key);
+		if (it == end())
+			return mystl::pair<const_iterator, const_iterator>(it, it);
+		auto next = it;
+		return mystl::pair<const_iterator, const_iterator>(it, ++next);
+	}
+
+	// bucket interface
+	// 开放寻址的表没有桶, bucket_count 返回位置个数
+	size_type bucket_count()     const noexcept { return capacity_; }
+	size_type max_bucket_count() const noexcept { return max_size(); }
+
+	// hash policy
+	float load_factor() const noexcept
+	{
+		return capacity_ != 0 ? static_cast<float>(size_) / capacity_ : 0.0f;
+	}
+
+	float max_load_factor() const noexcept { return mlf_; }
+
+	// 设置最大负载因子, 取值范围为 (0, 1)
+	// 调小后若当前的元素与剩余的空位置超出新的上限, 立即重建, 使 growth_left_ 符合新的负载因子
+	void max_load_factor(float ml)
+	{
+		THROW_OUT_OF_RANGE_IF(!(ml > 0.0f && ml < 1.0f), "invalid hash load factor");
+		mlf_ = ml;
+		if (capacity_ != 0 && size_ + growth_left_ > max_elements(capacity_))
+			resize(mystl::max(capacity_, capacity_for(size_)));
+	}
+
+	// 使位置个数不少于 count, 并足以按最大负载因子容纳当前的元素
+	void rehash(size_type count)
+	{
+		if (count == 0 && size_ == 0)
+		{
+			destroy_and_deallocate();
+			return;
+		}
+		const size_type need = mystl::max(normalize_capacity(count), capacity_for(size_));
+		if (need != capacity_)
+			resize(need);
+	}
+
+	// 预留空间, 使之后插入 count 个元素时都不会扩容
+	void reserve(size_type count)
+	{
+		if (count > size_ + growth_left_)
+			resize(capacity_for(count));
+	}
+
+	hasher    hash_function() const { return hash_; }
+	key_equal key_eq()        const { return equals_; }
+
+private:
+	//****************************** 辅助函数 *******************************
+
+	template <class K>
+	size_t hash_of(const K& key) const
+	{
+		return mix_hash(static_cast<size_t>(hash_(key)),
+		                mystl::m_bool_constant<hash_is_avalanching<Hash>::value>());
+	}
+
+	static size_t mix_hash(size_t h, mystl::m_true_type) noexcept  { return h; }
+	static size_t mix_hash(size_t h, mystl::m_false_type) noexcept { return mystl::hash_mix(h); }
+
+	static size_t  h1(size_t h) noexcept { return h >> 7; }
+	static ctrl_t  h2(size_t h) noexcept { return static_cast<ctrl_t>(h & 0x7f); }
+
+	iterator iterator_at(size_type i, bool skip) noexcept
+	{
+		iterator it(ctrl_ + i, slots_ + i, ctrl_ + capacity_);
+		if (skip)
+			it.skip_empty_or_deleted();
+		return it;
+	}
+
+	const_iterator const_iterator_at(size_type i, bool skip) const noexcept
+	{
+		const_iterator it(ctrl_ + i, slots_ + i, ctrl_ + capacity_);
+		if (skip)
+			it.skip_empty_or_deleted();
+		return it;
+	}
+
+	// 把容量规整为 16 的 2 的幂倍
+	static size_type normalize_capacity(size_type n) noexcept
+	{
+		size_type cap = kHashGroupWidth;
+		while (cap < n)
+			cap <<= 1;
+		return cap;
+	}
+
+	// 按最大负载因子容纳 n 个元素所需的容量
+	size_type capacity_for(size_type n) const noexcept
+	{
+		if (n == 0)
+			return 0;
+		return normalize_capacity(static_cast<size_type>(static_cast<double>(n) / mlf_) + 1);
+	}
+
+	// 容量为 cap 时最多能放的元素个数, 至少留下一个空位置, 保证未命中的查找能够终止
+	size_type max_elements(size_type cap) const noexcept
+	{
+		const size_type n = static_cast<size_type>(static_cast<double>(cap) * mlf_);
+		return n < cap ? n : cap - 1;
+	}
+
+	// 在表中查找 key, 返回位置, 不存在时返回 capacity_
+	template <class K>
+	size_type find_index(const K& key) const
+	{
+		if (capacity_ == 0)
+			return capacity_;
+		const size_t h = hash_of(key);
+		const size_type group_mask = capacity_ / kHashGroupWidth - 1;
+		size_type g = h1(h) & group_mask;
+		for (size_type step = 1; ; ++step)
+		{
+			const size_type base = g * kHashGroupWidth;
+			hash_group group(ctrl_ + base);
+			for (auto m = group.match(h2(h)); m; m.clear_lowest())
+			{
+				const size_type i = base + m.lowest();
+				if (equals_(Policy::key(Policy::element(slots_ + i)), key))
+					return i;
+			}
+			if (group.match_empty())
+				return capacity_;
+			g = (g + step) & group_mask;
+		}
+	}
+
+	// 哈希值 h 的探测序列上第一个空位置或墓碑
+	size_type find_first_non_full(size_t h) const noexcept
+	{
+		const size_type group_mask = capacity_ / kHashGroupWidth - 1;
+		size_type g = h1(h) & group_mask;
+		for (size_type step = 1; ; ++step)
+		{
+			const size_type base = g * kHashGroupWidth;
+			auto m = hash_group(ctrl_ + base).match_empty_or_deleted();
+			if (m)
+				return base + m.lowest();
+			g = (g + step) & group_mask;
+		}
+	}
+
+	// 查找 key, 找到时返回 (位置, false); 否则返回一个可以放入新元素的位置与 true,
+	// 需要时先扩容, 返回后调用者必须在该位置构造元素并调用 set_full
+	template <class K>
+	mystl::pair<size_type, bool> find_or_prepare_insert(const K& key, size_t h)
+	{
+		const size_type i = find_index(key);
+		if (i != capacity_)
+			return mystl::pair<size_type, bool>(i, false);
+		size_type target = capacity_ == 0 ? 0 : find_first_non_full(h);
+		if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[target] == kCtrlEmpty))
+		{
+			rehash_and_grow();
+			target = find_first_non_full(h);
+		}
+		return mystl::pair<size_type, bool>(target, true);
+	}
+
+	// 在位置 i 上放入哈希值为 h 的元素之后更新控制信息
+	void set_full(size_type i, size_t h) noexcept
+	{
+		if (ctrl_[i] == kCtrlEmpty)
+			--growth_left_;
+		ctrl_[i] = h2(h);
+		++size_;
+	}
+
+	// 位置 i 上的元素已销毁, 更新控制信息; 所在组中有空位置时不需要墓碑
+	void erase_meta(size_type i) noexcept
+	{
+		--size_;
+		const size_type base = i & ~(kHashGroupWidth - 1);
+		if (hash_group(ctrl_ + base).match_empty())
+		{
+			ctrl_[i] = kCtrlEmpty;
+			++growth_left_;
+		}
+		else
+		{
+			ctrl_[i] = kCtrlDeleted;
+		}
+	}
+
+	// 没有剩余空位置时调用: 墓碑占了大量位置就按原容量重建以清除墓碑, 否则容量翻倍
+	// 新容量至少要按当前的负载因子容纳 size_ + 1 个元素
+	void rehash_and_grow()
+	{
+		const size_type need = capacity_for(size_ + 1);
+		if (capacity_ == 0)
+			resize(mystl::max(need, kHashGroupWidth));
+		else if (size_ <= max_elements(capacity_) / 2)
+			resize(mystl::max(need, capacity_));
+		else
+			resize(mystl::max(need, capacity_ * 2));
+	}
+
+	// 分配 new_cap 个位置, 把所有元素移过去
+	// 元素的移动构造不应抛出异常, 否则表会处于不一致的状态
+	void resize(size_type new_cap)
+	{
+		THROW_LENGTH_ERROR_IF(new_cap > max_size(), "hashtable<T>'s size too big");
+		ctrl_t* old_ctrl = ctrl_;
+		slot_type* old_slots = slots_;
+		const size_type old_cap = capacity_;
+		const size_type old_size = size_;
+
+		allocate(new_cap);
+		for (size_type i = 0; i < old_cap; ++i)
+		{
+			if (ctrl_is_full(old_ctrl[i]))
+			{
+				const size_t h = hash_of(Policy::key(Policy::element(old_slots + i)));
+				const size_type target = find_first_non_full(h);
+				Policy::transfer(slots_ + target, old_slots + i);
+				ctrl_[target] = h2(h);
+			}
+		}
+		size_ = old_size;
+		// 新容量总能容纳原有元素, 这里只是防止回绕
+		growth_left_ = growth_left_ > old_size ? growth_left_ - old_size : 0;
+		if (old_cap != 0)
+			byte_allocator::deallocate(reinterpret_cast<unsigned char*>(old_ctrl), alloc_size(old_cap));
+	}
+
+	static size_type slot_offset(size_type cap) noexcept
+	{
+		return (cap + alignof(slot_type) - 1) & ~(alignof(slot_type) - 1);
+	}
+
+	static size_type alloc_size(size_type cap) noexcept
+	{
+		return slot_offset(cap) + cap * sizeof(slot_type);
+	}
+
+	// 分配一块新的空表, 不释放旧内存
+	void allocate(size_type cap)
+	{
+		unsigned char* mem = byte_allocator::allocate(alloc_size(cap));
+		ctrl_ = reinterpret_cast<ctrl_t*>(mem);
+		slots_ = reinterpret_cast<slot_type*>(mem + slot_offset(cap));
+		capacity_ = cap;
+		reset_ctrl();
+	}
+
+	// 把所有控制字节置为空, 不销毁元素
+	void reset_ctrl() noexcept
+	{
+		for (size_type i = 0; i < capacity_; ++i)
+			ctrl_[i] = kCtrlEmpty;
+		size_ = 0;
+		growth_left_ = capacity_ == 0 ? 0 : max_elements(capacity_);
+	}
+
+	void destroy_and_deallocate() noexcept
+	{
+		if (capacity_ == 0)
+			return;
+		clear();
+		byte_allocator::deallocate(reinterpret_cast<unsigned char*>(ctrl_), alloc_size(capacity_));
+		ctrl_ = nullptr;
+		slots_ = nullptr;
+		capacity_ = 0;
+		growth_left_ = 0;
+	}
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_HASHTABLE_H_
@@ -0,0 +1,251 @@
+#ifndef MYTINYSTL_HEAP_ALGO_H_
+#define MYTINYSTL_HEAP_ALGO_H_
+
+// 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及 is_heap, is_heap_until
+
+// notes:
+//
+// 所有算法都以堆的分叉数(arity)作为第一个模板参数, 默认为 2, 即普通的二叉堆
+// 使用 d 叉堆时写作 mystl::push_heap<4>(first, last), 同一个区间上的各个操作必须使用相同的分叉数
+// 在 d 叉堆中, 节点 i 的孩子为 d*i+1 ... d*i+d, 父节点为 (i-1)/d
+// 分叉数越大, 堆越矮, 下沉时访问的缓存行越少, 但每层需要多做 d-1 次比较;
+// 对于较大的堆, 4 叉堆通常比二叉堆更快
+
+#include <cstddef>
+
+#include "iterator.h"
+#include "util.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// push_heap
+// 该函数接受两个迭代器，表示一个 heap 容器的首尾，并且新元素已经插入到底部容器的最尾端，调整 heap
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+MYSTL_CONSTEXPR20 void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T value,
+                                     Compared comp)
+{
+	static_assert(D >= 2, "heap arity must be at least 2");
+	auto parent = (holeIndex - 1) / static_cast<Distance>(D);
+	while (holeIndex > topIndex && comp(*(first + parent), value))
+	{
+		// 使用 comp 比较，父节点小于新值时上溯
+		*(first + holeIndex) = mystl::move(*(first + parent));
+		holeIndex = parent;
+		parent = (holeIndex - 1) / static_cast<Distance>(D);
+	}
+	*(first + holeIndex) = mystl::move(value);
+}
+
+template <size_t D, class RandomIter, class Distance, class Compared>
+MYSTL_CONSTEXPR20 void push_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+	auto value = mystl::move(*(last - 1));
+	mystl::push_heap_aux<D>(first, static_cast<Distance>((last - first) - 1),
+	                        static_cast<Distance>(0), mystl::move(value), comp);
+}
+
+template <size_t D = 2, class RandomIter>
+MYSTL_CONSTEXPR20 void push_heap(RandomIter first, RandomIter last)
+{
+	// 新元素应该已置于底部容器的最尾端
+	if (last - first > 1)
+		mystl::push_heap_d<D>(first, last, distance_type(first),
+		                      [](const typename iterator_traits<RandomIter>::value_type& a,
+		                         const typename iterator_traits<RandomIter>::value_type& b)
+		                      { return a < b; });
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <size_t D = 2, class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void push_heap(RandomIter first, RandomIter last, Compared comp)
+{
+	if (last - first > 1)
+		mystl::push_heap_d<D>(first, last, distance_type(first), comp);
+}
+
+/*****************************************************************************************/
+// pop_heap
+// 该函数接受两个迭代器，表示 heap 容器的首尾，将 heap 的根节点取出放到容器尾部，调整 heap
+/*****************************************************************************************/
+
+// 在 holeIndex 的孩子中找出最大者, 孩子区间为 [child, child + count)
+template <size_t D, class RandomIter, class Distance, class Compared>
+MYSTL_CONSTEXPR20 Distance heap_max_child(RandomIter first, Distance child, Distance count, Compared comp)
+{
+	auto best = child;
+	for (Distance i = 1; i < count; ++i)
+	{
+		if (comp(*(first + best), *(first + (child + i))))
+			best = child + i;
+	}
+	return best;
+}
+
+// 下沉: 先让洞一直沿着最大的孩子下沉到底层, 再把 value 从洞的位置上溯回应处的位置
+// 与边比较边下沉相比, 每层少一次与 value 的比较, 而 value 通常本来就应该落在底层附近
+template <size_t D, class RandomIter, class T, class Distance, class Compared>
+MYSTL_CONSTEXPR20 void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value, Compared comp)
+{
+	static_assert(D >= 2, "heap arity must be at least 2");
+	const auto d = static_cast<Distance>(D);
+	auto topIndex = holeIndex;
+	auto child = d * holeIndex + 1;
+	// 孩子齐全的节点
+	while (child + d <= len)
+	{
+		child = mystl::heap_max_child<D>(first, child, d, comp);
+		*(first + holeIndex) = mystl::move(*(first + child));
+		holeIndex = child;
+		child = d * child + 1;
+	}
+	// 最后一个节点可能只有部分孩子
+	if (child < len)
+	{
+		child = mystl::heap_max_child<D>(first, child, len - child, comp);
+		*(first + holeIndex) = mystl::move(*(first + child));
+		holeIndex = child;
+	}
+	// 再执行一次上溯(percolate up)过程
+	mystl::push_heap_aux<D>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class T, class Distance, class Compared>
+MYSTL_CONSTEXPR20 void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result, T value,
+                                    Distance*, Compared comp)
+{
+	// 先将首值调至尾节点，然后调整[first, last)使之重新成为一个 heap
+	*result = mystl::move(*first);
+	mystl::adjust_heap<D>(first, static_cast<Distance>(0), static_cast<Distance>(last - first),
+	                      mystl::move(value), comp);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <size_t D = 2, class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void pop_heap(RandomIter first, RandomIter last, Compared comp)
+{
+	if (last - first < 2)
+		return;
+	auto value = mystl::move(*(last - 1));
+	mystl::pop_heap_aux<D>(first, last - 1, last - 1, mystl::move(value),
+	                       distance_type(first), comp);
+}
+
+template <size_t D = 2, class RandomIter>
+MYSTL_CONSTEXPR20 void pop_heap(RandomIter first, RandomIter last)
+{
+	mystl::pop_heap<D>(first, last,
+	                   [](const typename iterator_traits<RandomIter>::value_type& a,
+	                      const typename iterator_traits<RandomIter>::value_type& b)
+	                   { return a < b; });
+}
+
+/*****************************************************************************************/
+// sort_heap
+// 该函数接受两个迭代器，表示 heap 容器的首尾，不断执行 pop_heap 操作，直到首尾最多相差1
+/*****************************************************************************************/
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <size_t D = 2, class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void sort_heap(RandomIter first, RandomIter last, Compared comp)
+{
+	// 每执行一次 pop_heap，最大的元素都被放到尾部，直到容器最多只有一个元素，完成排序
+	while (last - first > 1)
+	{
+		mystl::pop_heap<D>(first, last--, comp);
+	}
+}
+
+template <size_t D = 2, class RandomIter>
+MYSTL_CONSTEXPR20 void sort_heap(RandomIter first, RandomIter last)
+{
+	mystl::sort_heap<D>(first, last,
+	                    [](const typename iterator_traits<RandomIter>::value_type& a,
+	                       const typename iterator_traits<RandomIter>::value_type& b)
+	                    { return a < b; });
+}
+
+/*****************************************************************************************/
+// make_heap
+// 该函数接受两个迭代器，表示 heap 容器的首尾，把容器内的数据变为一个 heap
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Distance, class Compared>
+MYSTL_CONSTEXPR20 void make_heap_aux(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+	if (last - first < 2)
+		return;
+	auto len = static_cast<Distance>(last - first);
+	// 从最后一个有孩子的节点开始, 依次下沉
+	auto holeIndex = (len - 2) / static_cast<Distance>(D);
+	while (true)
+	{
+		// 重排以 holeIndex 为首的子树
+		auto value = mystl::move(*(first + holeIndex));
+		mystl::adjust_heap<D>(first, holeIndex, len, mystl::move(value), comp);
+		if (holeIndex == 0)
+			return;
+		holeIndex--;
+	}
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <size_t D = 2, class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 void make_heap(RandomIter first, RandomIter last, Compared comp)
+{
+	mystl::make_heap_aux<D>(first, last, distance_type(first), comp);
+}
+
+template <size_t D = 2, class RandomIter>
+MYSTL_CONSTEXPR20 void make_heap(RandomIter first, RandomIter last)
+{
+	mystl::make_heap<D>(first, last,
+	                    [](const typename iterator_traits<RandomIter>::value_type& a,
+	                       const typename iterator_traits<RandomIter>::value_type& b)
+	                    { return a < b; });
+}
+
+/*****************************************************************************************/
+// is_heap_until / is_heap
+// 返回 [first, last) 中满足堆性质的最长前缀的尾部 / 判断 [first, last) 是否为一个堆
+/*****************************************************************************************/
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <size_t D = 2, class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 RandomIter is_heap_until(RandomIter first, RandomIter last, Compared comp)
+{
+	const auto len = last - first;
+	for (decltype(last - first) child = 1; child < len; ++child)
+	{
+		const auto parent = (child - 1) / static_cast<decltype(last - first)>(D);
+		if (comp(*(first + parent), *(first + child)))
+			return first + child;
+	}
+	return last;
+}
+
+template <size_t D = 2, class RandomIter>
+MYSTL_CONSTEXPR20 RandomIter is_heap_until(RandomIter first, RandomIter last)
+{
+	return mystl::is_heap_until<D>(first, last,
+	                               [](const typename iterator_traits<RandomIter>::value_type& a,
+	                                  const typename iterator_traits<RandomIter>::value_type& b)
+	                               { return a < b; });
+}
+
+template <size_t D = 2, class RandomIter, class Compared>
+MYSTL_CONSTEXPR20 bool is_heap(RandomIter first, RandomIter last, Compared comp)
+{
+	return mystl::is_heap_until<D>(first, last, comp) == last;
+}
+
+template <size_t D = 2, class RandomIter>
+MYSTL_CONSTEXPR20 bool is_heap(RandomIter first, RandomIter last)
+{
+	return mystl::is_heap_until<D>(first, last) == last;
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_HEAP_ALGO_H_
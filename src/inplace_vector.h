@@ -0,0 +1,521 @@
+#ifndef MYTINYSTL_INPLACE_VECTOR_H_
+#define MYTINYSTL_INPLACE_VECTOR_H_
+
+// 这个头文件包含一个模板类 inplace_vector
+// inplace_vector : 容量固定、元素保存在对象内部的向量, 不分配内存
+
+// notes:
+//
+// 容量 N 是模板参数, capacity() 总是 N; 元素个数超过 N 时 push_back / insert / resize 等抛出 std::length_error,
+// try_emplace_back / try_push_back 则返回 errc::length_error 而不改变容器
+// 元素可平凡默认构造且可平凡析构时, 元素保存在一个 T[N] 中, 从 C++20 起整个容器都可以在常量求值中使用;
+// 否则保存在对齐的字节缓冲区中, 只能在运行时使用
+// 常量求值中未使用的元素会被值初始化, 运行时不初始化
+// 异常保证：
+// mystl::inplace_vector<T, N> 满足基本异常保证, 并对以下函数做强异常安全保证：
+//   * emplace_back
+//   * push_back
+//   * try_emplace_back
+//   * try_push_back
+
+#include <cstddef>
+#include <initializer_list>
+
+#include "algo.h"
+#include "algobase.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl
+{
+
+namespace inplace_detail
+{
+
+// 元素存储, Trivial 为 true 时使用 T[N], 可以在常量求值中使用
+template <class T, size_t N, bool Trivial>
+struct storage;
+
+template <class T, size_t N>
+struct storage<T, N, true>
+{
+	T data_[N == 0 ? 1 : N];
+
+	MYSTL_CONSTEXPR20 storage() noexcept
+	{
+		// 常量求值中不能读写未初始化的对象, 先把所有元素值初始化
+		if (mystl::is_constant_evaluated())
+		{
+			for (size_t i = 0; i < (N == 0 ? 1 : N); ++i)
+				data_[i] = T();
+		}
+	}
+
+	MYSTL_CONSTEXPR20 T*       ptr()       noexcept { return data_; }
+	MYSTL_CONSTEXPR20 const T* ptr() const noexcept { return data_; }
+};
+
+template <class T, size_t N>
+struct storage<T, N, false>
+{
+	alignas(T) unsigned char buf_[(N == 0 ? 1 : N) * sizeof(T)];
+
+	T*       ptr()       noexcept { return reinterpret_cast<T*>(buf_); }
+	const T* ptr() const noexcept { return reinterpret_cast<const T*>(buf_); }
+};
+
+} // namespace inplace_detail
+
+// 模板类: inplace_vector
+// 模板参数 T 代表元素类型, N 代表容量
+template <class T, size_t N>
+class inplace_vector
+{
+public:
+	// inplace_vector 的嵌套型别定义
+	typedef T                                        value_type;
+	typedef T*                                       pointer;
+	typedef const T*                                 const_pointer;
+	typedef T&                                       reference;
+	typedef const T&                                 const_reference;
+	typedef size_t                                   size_type;
+	typedef ptrdiff_t                                difference_type;
+
+	typedef value_type*                              iterator;
+	typedef const value_type*                        const_iterator;
+	typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+private:
+	typedef inplace_detail::storage<T, N,
+		std::is_trivially_default_constructible<T>::value &&
+		std::is_trivially_destructible<T>::value> storage_type;
+
+	storage_type store_;  // 元素存储
+	size_type    size_;   // 元素个数
+
+public:
+	// 构造,拷贝,移动,析构
+	MYSTL_CONSTEXPR20 inplace_vector() noexcept
+		:store_(), size_(0)
+	{
+	}
+
+	MYSTL_CONSTEXPR20 explicit inplace_vector(size_type n)
+		:store_(), size_(0)
+	{ resize(n); }
+
+	MYSTL_CONSTEXPR20 inplace_vector(size_type n, const value_type& value)
+		:store_(), size_(0)
+	{ resize(n, value); }
+
+	// 只有 Iter 为迭代器时才启用, 避免与 inplace_vector(size_type, const value_type&) 产生歧义
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	MYSTL_CONSTEXPR20 inplace_vector(Iter first, Iter last)
+		:store_(), size_(0)
+	{ insert(end(), first, last); }
+
+	MYSTL_CONSTEXPR20 inplace_vector(const inplace_vector& rhs)
+		:store_(), size_(0)
+	{
+		mystl::uninitialized_copy(rhs.begin(), rhs.end(), begin());
+		size_ = rhs.size_;
+	}
+
+	MYSTL_CONSTEXPR20 inplace_vector(inplace_vector&& rhs)
+		noexcept(std::is_nothrow_move_constructible<T>::value)
+		:store_(), size_(0)
+	{
+		mystl::uninitialized_move(rhs.begin(), rhs.end(), begin());
+		size_ = rhs.size_;
+	}
+
+	MYSTL_CONSTEXPR20 inplace_vector(std::initializer_list<value_type> ilist)
+		:store_(), size_(0)
+	{ insert(end(), ilist.begin(), ilist.end()); }
+
+	MYSTL_CONSTEXPR20 inplace_vector& operator=(const inplace_vector& rhs)
+	{
+		if (this != &rhs)
+			assign(rhs.begin(), rhs.end());
+		return *this;
+	}
+
+	MYSTL_CONSTEXPR20 inplace_vector& operator=(inplace_vector&& rhs)
+		noexcept(std::is_nothrow_move_assignable<T>::value &&
+		         std::is_nothrow_move_constructible<T>::value)
+	{
+		if (this != &rhs)
+		{
+			const auto n = mystl::min(size_, rhs.size_);
+			mystl::move(rhs.begin(), rhs.begin() + n, begin());
+			if (n < rhs.size_)
+				mystl::uninitialized_move(rhs.begin() + n, rhs.end(), end());
+			else
+				mystl::destroy(begin() + n, end());
+			size_ = rhs.size_;
+		}
+		return *this;
+	}
+
+	MYSTL_CONSTEXPR20 inplace_vector& operator=(std::initializer_list<value_type> ilist)
+	{
+		assign(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	MYSTL_CONSTEXPR20 ~inplace_vector()
+	{
+		mystl::destroy(begin(), end());
+	}
+
+public:
+	// 迭代器相关操作
+	MYSTL_CONSTEXPR20 iterator               begin()         noexcept { return store_.ptr(); }
+	MYSTL_CONSTEXPR20 const_iterator         begin()   const noexcept { return store_.ptr(); }
+	MYSTL_CONSTEXPR20 iterator               end()           noexcept { return store_.ptr() + size_; }
+	MYSTL_CONSTEXPR20 const_iterator         end()     const noexcept { return store_.ptr() + size_; }
+
+	MYSTL_CONSTEXPR20 reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+	MYSTL_CONSTEXPR20 reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+	MYSTL_CONSTEXPR20 const_iterator         cbegin()  const noexcept { return begin(); }
+	MYSTL_CONSTEXPR20 const_iterator         cend()    const noexcept { return end(); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	MYSTL_CONSTEXPR20 const_reverse_iterator crend()   const noexcept { return rend(); }
+
+	// 容量相关操作
+	MYSTL_CONSTEXPR20 bool      empty()    const noexcept { return size_ == 0; }
+	MYSTL_CONSTEXPR20 size_type size()     const noexcept { return size_; }
+	static constexpr size_type  max_size()       noexcept { return N; }
+	static constexpr size_type  capacity()       noexcept { return N; }
+
+	// 容量固定, 只检查 n 是否超过 N
+	MYSTL_CONSTEXPR20 void reserve(size_type n)
+	{
+		THROW_LENGTH_ERROR_IF(n > N, "inplace_vector<T, N>'s size too big");
+	}
+	MYSTL_CONSTEXPR20 void shrink_to_fit() noexcept {}
+
+	// 访问元素相关操作
+	MYSTL_CONSTEXPR20 reference operator[](size_type n)
+	{
+		MYSTL_DEBUG(n < size());
+		return *(begin() + n);
+	}
+	MYSTL_CONSTEXPR20 const_reference operator[](size_type n) const
+	{
+		MYSTL_DEBUG(n < size());
+		return *(begin() + n);
+	}
+	MYSTL_CONSTEXPR20 reference at(size_type n)
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size()), "inplace_vector<T, N>::at() subscript out of range");
+		return (*this)[n];
+	}
+	MYSTL_CONSTEXPR20 const_reference at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size()), "inplace_vector<T, N>::at() subscript out of range");
+		return (*this)[n];
+	}
+
+	MYSTL_CONSTEXPR20 reference front()
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+	MYSTL_CONSTEXPR20 const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+	MYSTL_CONSTEXPR20 reference back()
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end() - 1);
+	}
+	MYSTL_CONSTEXPR20 const_reference back() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end() - 1);
+	}
+
+	MYSTL_CONSTEXPR20 pointer       data()       noexcept { return begin(); }
+	MYSTL_CONSTEXPR20 const_pointer data() const noexcept { return begin(); }
+
+	// 修改容器相关操作
+
+	// assign
+	MYSTL_CONSTEXPR20 void assign(size_type n, const value_type& value)
+	{
+		THROW_LENGTH_ERROR_IF(n > N, "inplace_vector<T, N>'s size too big");
+		const auto m = mystl::min(size_, n);
+		mystl::fill_n(begin(), m, value);
+		if (m < n)
+			mystl::uninitialized_fill_n(end(), n - m, value);
+		else
+			mystl::destroy(begin() + n, end());
+		size_ = n;
+	}
+
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	MYSTL_CONSTEXPR20 void assign(Iter first, Iter last)
+	{
+		clear();
+		insert(end(), first, last);
+	}
+
+	MYSTL_CONSTEXPR20 void assign(std::initializer_list<value_type> ilist)
+	{ assign(ilist.begin(), ilist.end()); }
+
+	// emplace / emplace_back
+	template <class... Args>
+	MYSTL_CONSTEXPR20 iterator emplace(const_iterator pos, Args&& ...args);
+
+	template <class... Args>
+	MYSTL_CONSTEXPR20 reference emplace_back(Args&& ...args)
+	{
+		THROW_LENGTH_ERROR_IF(size_ == N, "inplace_vector<T, N>'s size too big");
+		mystl::construct(end(), mystl::forward<Args>(args)...);
+		++size_;
+		return back();
+	}
+
+	// push_back / pop_back
+	MYSTL_CONSTEXPR20 void push_back(const value_type& value)
+	{ emplace_back(value); }
+	MYSTL_CONSTEXPR20 void push_back(value_type&& value)
+	{ emplace_back(mystl::move(value)); }
+
+	// try_emplace_back / try_push_back, 容器已满时返回 errc::length_error 而不抛出异常, 同 vector::try_reserve
+	template <class... Args>
+	MYSTL_CONSTEXPR20 errc try_emplace_back(Args&& ...args)
+	{
+		if (size_ == N)
+			return errc::length_error;
+		mystl::construct(end(), mystl::forward<Args>(args)...);
+		++size_;
+		return errc::ok;
+	}
+
+	MYSTL_CONSTEXPR20 errc try_push_back(const value_type& value)
+	{ return try_emplace_back(value); }
+	MYSTL_CONSTEXPR20 errc try_push_back(value_type&& value)
+	{ return try_emplace_back(mystl::move(value)); }
+
+	MYSTL_CONSTEXPR20 void pop_back()
+	{
+		MYSTL_DEBUG(!empty());
+		--size_;
+		mystl::destroy(end());
+	}
+
+	// insert
+	MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, const value_type& value)
+	{ return emplace(pos, value); }
+	MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, value_type&& value)
+	{ return emplace(pos, mystl::move(value)); }
+
+	MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, Iter first, Iter last);
+
+	MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+	{ return insert(pos, ilist.begin(), ilist.end()); }
+
+	// erase / clear
+	MYSTL_CONSTEXPR20 iterator erase(const_iterator pos)
+	{ return erase(pos, pos + 1); }
+	MYSTL_CONSTEXPR20 iterator erase(const_iterator first, const_iterator last);
+
+	MYSTL_CONSTEXPR20 void clear() noexcept
+	{
+		mystl::destroy(begin(), end());
+		size_ = 0;
+	}
+
+	// resize
+	MYSTL_CONSTEXPR20 void resize(size_type new_size)
+	{
+		THROW_LENGTH_ERROR_IF(new_size > N, "inplace_vector<T, N>'s size too big");
+		if (new_size < size_)
+		{
+			erase(begin() + new_size, end());
+			return;
+		}
+		for (; size_ < new_size; ++size_)
+			mystl::construct(end());
+	}
+	MYSTL_CONSTEXPR20 void resize(size_type new_size, const value_type& value)
+	{
+		THROW_LENGTH_ERROR_IF(new_size > N, "inplace_vector<T, N>'s size too big");
+		if (new_size < size_)
+		{
+			erase(begin() + new_size, end());
+			return;
+		}
+		mystl::uninitialized_fill_n(end(), new_size - size_, value);
+		size_ = new_size;
+	}
+
+	MYSTL_CONSTEXPR20 void swap(inplace_vector& rhs);
+
+private:
+	// 把追加在原来末尾 old_size 之后的新元素旋转到 pos 处, 返回指向第一个新元素的迭代器
+	MYSTL_CONSTEXPR20 iterator rotate_tail(const_iterator pos, size_type old_size);
+};
+
+/*****************************************************************************************/
+
+// 在 pos 位置就地构造元素
+template <class T, size_t N>
+template <class... Args>
+MYSTL_CONSTEXPR20 typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::emplace(const_iterator pos, Args&& ...args)
+{
+	MYSTL_DEBUG(pos >= begin() && pos <= end());
+	THROW_LENGTH_ERROR_IF(size_ == N, "inplace_vector<T, N>'s size too big");
+	const auto old_size = size_;
+	mystl::construct(end(), mystl::forward<Args>(args)...);
+	++size_;
+	return rotate_tail(pos, old_size);
+}
+
+// 在 pos 处插入 n 个元素
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::insert(const_iterator pos, size_type n, const value_type& value)
+{
+	MYSTL_DEBUG(pos >= begin() && pos <= end());
+	THROW_LENGTH_ERROR_IF(n > N - size_, "inplace_vector<T, N>'s size too big");
+	const auto old_size = size_;
+	mystl::uninitialized_fill_n(end(), n, value);
+	size_ += n;
+	return rotate_tail(pos, old_size);
+}
+
+// 在 pos 处插入 [first, last) 的元素; 输入迭代器只能遍历一次, 所以先逐个追加到末尾
+template <class T, size_t N>
+template <class Iter, typename std::enable_if<
+	mystl::is_input_iterator<Iter>::value, int>::type>
+MYSTL_CONSTEXPR20 typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::insert(const_iterator pos, Iter first, Iter last)
+{
+	MYSTL_DEBUG(pos >= begin() && pos <= end());
+	const auto old_size = size_;
+	MYSTL_TRY
+	{
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+	MYSTL_CATCH_ALL
+	{
+		erase(begin() + old_size, end());
+		MYSTL_RETHROW;
+	}
+	return rotate_tail(pos, old_size);
+}
+
+// 删除 [first, last) 上的元素
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::erase(const_iterator first, const_iterator last)
+{
+	MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+	const auto n = first - begin();
+	iterator r = begin() + n;
+	const auto new_end = mystl::move(r + (last - first), end(), r);
+	mystl::destroy(new_end, end());
+	size_ = static_cast<size_type>(new_end - begin());
+	return r;
+}
+
+// 与另一个 inplace_vector 交换, 元素逐个交换, 较长一方多出的元素移动过去
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 void inplace_vector<T, N>::swap(inplace_vector& rhs)
+{
+	if (this == &rhs)
+		return;
+	inplace_vector& shorter = size_ < rhs.size_ ? *this : rhs;
+	inplace_vector& longer = size_ < rhs.size_ ? rhs : *this;
+	const auto n = shorter.size_;
+	mystl::swap_range(shorter.begin(), shorter.begin() + n, longer.begin());
+	mystl::uninitialized_move(longer.begin() + n, longer.end(), shorter.end());
+	mystl::destroy(longer.begin() + n, longer.end());
+	shorter.size_ = longer.size_;
+	longer.size_ = n;
+}
+
+// 插入操作先把新元素追加在末尾, 再旋转到插入位置, 这样构造新元素时不会覆盖参数引用的原有元素
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::rotate_tail(const_iterator pos, size_type old_size)
+{
+	iterator p = begin() + (pos - begin());
+	mystl::rotate(p, begin() + old_size, end());
+	return p;
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator==(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs)
+{
+	return lhs.size() == rhs.size() &&
+		mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator<(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs)
+{
+	return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator!=(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator>(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator<=(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 bool operator>=(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, size_t N>
+MYSTL_CONSTEXPR20 void swap(inplace_vector<T, N>& lhs, inplace_vector<T, N>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+// 元素保存在对象内部, 不持有指向自身的指针, 元素可以按字节转移时整个容器也可以
+template <class T, size_t N>
+struct is_trivially_relocatable<inplace_vector<T, N>> : is_trivially_relocatable<T> {};
+
+} // namespace mystl
+#endif // !MYTINYSTL_INPLACE_VECTOR_H_
@@ -17,6 +17,7 @@ struct output_iterator_tag {};  // 输出迭代器标签
 struct forward_iterator_tag : public input_iterator_tag {};  // 前向迭代器标签
 struct bidirectional_iterator_tag : public forward_iterator_tag {};  // 双向迭代器标签
 struct random_access_iterator_tag : public bidirectional_iterator_tag {};  // 随机访问迭代器标签
+struct contiguous_iterator_tag : public random_access_iterator_tag {};  // 连续迭代器标签, 元素在内存中连续存放
 
 //iterator模板,定义迭代器的一般属性
 template <class Category, class T, class Distance = ptrdiff_t,
@@ -139,6 +140,14 @@ struct is_bidirectional_iterator : public has_iterator_cat_of<Iter, bidirectiona
 template <class Iter>
 struct is_random_access_iterator : public has_iterator_cat_of<Iter, random_access_iterator_tag> {};
 
+// 原生指针的 iterator_category 仍为 random_access_iterator_tag, 以免影响按标签分派的代码, 在这里单独识别
+// 类类型的迭代器声明 contiguous_iterator_tag 时, 还必须提供返回元素地址的 operator->, 对尾迭代器也有效
+template <class Iter>
+struct is_contiguous_iterator : public has_iterator_cat_of<Iter, contiguous_iterator_tag> {};
+
+template <class T>
+struct is_contiguous_iterator<T*> : public m_true_type {};
+
 template <class Iterator>
 struct is_iterator
 	: public m_bool_constant<is_input_iterator<Iterator>::value
@@ -148,7 +157,7 @@ struct is_iterator
 
 //萃取某个迭代器的category
 template <class Iterator>
-typename iterator_traits<Iterator>::iterator_category
+MYSTL_CONSTEXPR20 typename iterator_traits<Iterator>::iterator_category
 iterator_category(const Iterator&)
 {
 	using Category = typename iterator_traits<Iterator>::iterator_category;
@@ -158,7 +167,7 @@ iterator_category(const Iterator&)
 
 //萃取某个迭代器的distance_type
 template <class Iterator>
-typename iterator_traits<Iterator>::difference_type*
+MYSTL_CONSTEXPR20 typename iterator_traits<Iterator>::difference_type*
 distance_type(const Iterator&)
 {
 	return static_cast<typename iterator_traits<Iterator>::difference_type*>(nullptr);
@@ -169,7 +178,7 @@ distance_type(const Iterator&)
 //distance 的 input_iterator_tag 版本
 //提取出的辅助函数
 template <class InputIterator>
-typename iterator_traits<InputIterator>::difference_type
+MYSTL_CONSTEXPR20 typename iterator_traits<InputIterator>::difference_type
 distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag)
 {
 	typename iterator_traits<InputIterator>::difference_type n = 0;
@@ -185,14 +194,14 @@ distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag)
 //distance 的 random_access_iterator_tag版本
 //提取出的辅助函数
 template <class RandomIter>
-typename iterator_traits<RandomIter>::difference_type
+MYSTL_CONSTEXPR20 typename iterator_traits<RandomIter>::difference_type
 distance_dispatch(RandomIter first, RandomIter last, random_access_iterator_tag)
 {
 	return last - first;
 }
 
 template <class InputIterator>
-typename iterator_traits<InputIterator>::difference_type
+MYSTL_CONSTEXPR20 typename iterator_traits<InputIterator>::difference_type
 distance(InputIterator first, InputIterator last)
 {
 	return distance_dispatch(first, last, iterator_category(first));
@@ -202,7 +211,7 @@ distance(InputIterator first, InputIterator last)
 
 //advance 的 input_iterator_tag 版本
 template <class InputIterator, class Distance>
-void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag)
+MYSTL_CONSTEXPR20 void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag)
 {
 	while (n--)
 		++i;
@@ -210,7 +219,7 @@ void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag)
 
 //advance 的 bidirectional_iterator_tag 版本
 template <class BidirectionalIterator, class Distance>
-void advance_dispatch(BidirectionalIterator& i, Distance n, bidirectional_iterator_tag)
+MYSTL_CONSTEXPR20 void advance_dispatch(BidirectionalIterator& i, Distance n, bidirectional_iterator_tag)
 {
 	if (n >= 0)
 		while (n--)
@@ -222,17 +231,27 @@ void advance_dispatch(BidirectionalIterator& i, Distance n, bidirectional_iterat
 
 //advace 的 random_access_iterator_tag 版本
 template <class RandomIter, class Distance>
-void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag)
+MYSTL_CONSTEXPR20 void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag)
 {
 	i += n;
 }
 
 template <class InputIterator, class Distance>
-void advance(InputIterator& i, Distance n)
+MYSTL_CONSTEXPR20 void advance(InputIterator& i, Distance n)
 {
 	advance_dispatch(i, n, iterator_category(i));
 }
 
+// 模板类 : arrow_proxy
+// 解引用得到代理对象(而不是真正的引用)的迭代器用它作为 operator-> 的返回值: 持有代理, 再对它取地址
+template <class Reference>
+struct arrow_proxy
+{
+	Reference ref;
+
+	Reference* operator->() noexcept { return &ref; }
+};
+
 // ********************************************************************************************* //
 
 // 模板类 : reverse_iterator
@@ -244,8 +263,10 @@ private:
 	Iterator current;  // 记录该反向迭代器对应的正向迭代器
 
 public:
-	// 反向迭代器的五种相应型别
-	using iterator_category = typename iterator_traits<Iterator>::iterator_category;
+	// 反向迭代器的五种相应型别, 反向遍历的元素地址递减, 所以不是连续迭代器
+	using iterator_category = typename std::conditional<
+		is_contiguous_iterator<Iterator>::value, random_access_iterator_tag,
+		typename iterator_traits<Iterator>::iterator_category>::type;
 	using value_type = typename iterator_traits<Iterator>::value_type;
 	using difference_type = typename iterator_traits<Iterator>::difference_type;
 	using pointer = typename iterator_traits<Iterator>::pointer;
@@ -257,34 +278,35 @@ public:
 public:
 	//三类构造函数
 	reverse_iterator() = default;  // 默认构造
-	explicit reverse_iterator(iterator_type i) : current(i) {}  // 单参构造,参数为指定的迭代器型别
-	reverse_iterator(const self &rhs) : current(rhs.current) {}  // 拷贝构造
+	MYSTL_CONSTEXPR20 explicit reverse_iterator(iterator_type i) : current(i) {}  // 单参构造,参数为指定的迭代器型别
+	reverse_iterator(const self &rhs) = default;  // 拷贝构造
+	self& operator=(const self &rhs) = default;  // 拷贝赋值, 与拷贝构造一起默认, 避免 -Wdeprecated-copy
 
 public:
 	//获取对应的正向迭代器
-	Iterator_type base() const
+	MYSTL_CONSTEXPR20 iterator_type base() const
 	{
 		return current;
 	}
 
 	//重载运算符
-	reference operator*() const
+	MYSTL_CONSTEXPR20 reference operator*() const
 	{
 		auto tmp = current;
 		return *--tmp;
 	}
-	pointer operator->() const
+	MYSTL_CONSTEXPR20 pointer operator->() const
 	{
-		return &(operator*());
+		return arrow(m_bool_constant<std::is_pointer<pointer>::value>());
 	}
 
 	// 前进(++)变为后退(--)
-	self& operator++()
+	MYSTL_CONSTEXPR20 self& operator++()
 	{
 		--current;
 		return *this;
 	}
-	self operator(int)
+	MYSTL_CONSTEXPR20 self operator++(int)
 	{
 		self tmp = *this;
 		--current;
@@ -292,46 +314,57 @@ public:
 	}
 
 	// 后退(--)变为前进(++)
-	self& operator--()
+	MYSTL_CONSTEXPR20 self& operator--()
 	{
 		++current;
 		return *this;
 	}
-	self operator--(int)
+	MYSTL_CONSTEXPR20 self operator--(int)
 	{
 		self tmp = *this;
 		++current;
 		return tmp;
 	}
 
-	self& operator+=(difference_type n)
+	MYSTL_CONSTEXPR20 self& operator+=(difference_type n)
 	{
 		current -= n;
 		return *this;
 	}
-	self operator+(difference_type n) const
+	MYSTL_CONSTEXPR20 self operator+(difference_type n) const
 	{
 		return self(current - n);
 	}
-	self& operator-=(difference_type n) const
+	MYSTL_CONSTEXPR20 self& operator-=(difference_type n)
 	{
 		current += n;
 		return *this;
 	}
-	self operator-(difference_type n) const
+	MYSTL_CONSTEXPR20 self operator-(difference_type n) const
 	{
 		return self(current + n);
 	}
 
-	reference operator[](difference_type n) const
+	MYSTL_CONSTEXPR20 reference operator[](difference_type n) const
 	{
 		return *(*this + n);
 	}
+
+private:
+	// 解引用得到真正的引用时取它的地址; 得到代理对象时 pointer 为 arrow_proxy, 用代理构造它
+	MYSTL_CONSTEXPR20 pointer arrow(m_true_type) const
+	{
+		return &(operator*());
+	}
+	MYSTL_CONSTEXPR20 pointer arrow(m_false_type) const
+	{
+		return pointer{ operator*() };
+	}
 };
 
 //重载 operator-
 template <class Iterator>
-typename reverse_iterator<Iterator>::difference_type
+MYSTL_CONSTEXPR20 typename reverse_iterator<Iterator>::difference_type
 operator-(const reverse_iterator<Iterator>& lhs,
 		  const reverse_iterator<Iterator>& rhs)
 {
@@ -340,8 +373,7 @@ operator-(const reverse_iterator<Iterator>& lhs,
 
 //重载 operator==
 template <class Iterator>
-typename reverse_iterator<Iterator>::difference_type
-operator==(const reverse_iterator<Iterator>& lhs,
+MYSTL_CONSTEXPR20 bool operator==(const reverse_iterator<Iterator>& lhs,
 		  const reverse_iterator<Iterator>& rhs)
 {
 	return lhs.base() == rhs.base();
@@ -349,8 +381,7 @@ operator==(const reverse_iterator<Iterator>& lhs,
 
 //重载 operator<
 template <class Iterator>
-typename reverse_iterator<Iterator>::difference_type
-operator<(const reverse_iterator<Iterator>& lhs,
+MYSTL_CONSTEXPR20 bool operator<(const reverse_iterator<Iterator>& lhs,
 		  const reverse_iterator<Iterator>& rhs)
 {
 	return rhs.base() < lhs.base();
@@ -358,37 +389,264 @@ operator<(const reverse_iterator<Iterator>& lhs,
 
 //重载 operator!=
 template <class Iterator>
-typename reverse_iterator<Iterator>::difference_type
-operator-(const reverse_iterator<Iterator>& lhs,
-		  const reverse_iterator<Iterator>& rhs)
+MYSTL_CONSTEXPR20 bool operator!=(const reverse_iterator<Iterator>& lhs,
+                                  const reverse_iterator<Iterator>& rhs)
 {
-	return !(lsh == rhs);
+	return !(lhs == rhs);
 }
 
 //重载 operator>
 template <class Iterator>
-bool operator>(const reverse_iterator<Iterator>& lhs,
-               const reverse_iterator<Iterator>& rhs)
+MYSTL_CONSTEXPR20 bool operator>(const reverse_iterator<Iterator>& lhs,
+                                 const reverse_iterator<Iterator>& rhs)
 {
 	return rhs < lhs;
 }
 
 //重载 operator<=
 template <class Iterator>
-bool operator<=(const reverse_iterator<Iterator>& lhs,
-                const reverse_iterator<Iterator>& rhs)
+MYSTL_CONSTEXPR20 bool operator<=(const reverse_iterator<Iterator>& lhs,
+                                  const reverse_iterator<Iterator>& rhs)
 {
 	return !(rhs < lhs);
 }
 
 //重载 operator>=
 template <class Iterator>
-bool operator>=(const reverse_iterator<Iterator>& lhs,
-                const reverse_iterator<Iterator>& rhs)
+MYSTL_CONSTEXPR20 bool operator>=(const reverse_iterator<Iterator>& lhs,
+                                  const reverse_iterator<Iterator>& rhs)
 {
 	return !(lhs < rhs);
 }
 
+// ********************************************************************************************* //
+
+// 模板类 : move_iterator
+// 解引用得到右值引用, 把它交给 copy 等算法时元素被移动而不是复制
+// copy / copy_backward 会把一对 move_iterator 转交给底层迭代器上的 move / move_backward,
+// uninitialized_copy 会转交给 uninitialized_move, 从而命中它们的 memmove 版本
+template <class Iterator>
+class move_iterator
+{
+private:
+	Iterator current;
+
+public:
+	// 最多为随机访问迭代器: 解引用得到的不是元素的左值引用
+	using iterator_category = typename std::conditional<
+		is_random_access_iterator<Iterator>::value, random_access_iterator_tag,
+		typename iterator_traits<Iterator>::iterator_category>::type;
+	using value_type = typename iterator_traits<Iterator>::value_type;
+	using difference_type = typename iterator_traits<Iterator>::difference_type;
+	using pointer = Iterator;
+	using reference = typename std::conditional<
+		std::is_reference<typename iterator_traits<Iterator>::reference>::value,
+		typename std::remove_reference<typename iterator_traits<Iterator>::reference>::type&&,
+		typename iterator_traits<Iterator>::reference>::type;
+
+	using iterator_type = Iterator;
+	using self = move_iterator<Iterator>;
+
+public:
+	move_iterator() = default;
+	MYSTL_CONSTEXPR20 explicit move_iterator(iterator_type i) : current(i) {}
+
+	template <class Other>
+	MYSTL_CONSTEXPR20 move_iterator(const move_iterator<Other>& rhs) : current(rhs.base()) {}
+
+	MYSTL_CONSTEXPR20 iterator_type base() const
+	{
+		return current;
+	}
+
+	MYSTL_CONSTEXPR20 reference operator*() const
+	{
+		return static_cast<reference>(*current);
+	}
+	MYSTL_CONSTEXPR20 pointer operator->() const
+	{
+		return current;
+	}
+
+	MYSTL_CONSTEXPR20 self& operator++()
+	{
+		++current;
+		return *this;
+	}
+	MYSTL_CONSTEXPR20 self operator++(int)
+	{
+		self tmp = *this;
+		++current;
+		return tmp;
+	}
+	MYSTL_CONSTEXPR20 self& operator--()
+	{
+		--current;
+		return *this;
+	}
+	MYSTL_CONSTEXPR20 self operator--(int)
+	{
+		self tmp = *this;
+		--current;
+		return tmp;
+	}
+
+	MYSTL_CONSTEXPR20 self& operator+=(difference_type n)
+	{
+		current += n;
+		return *this;
+	}
+	MYSTL_CONSTEXPR20 self operator+(difference_type n) const
+	{
+		return self(current + n);
+	}
+	MYSTL_CONSTEXPR20 self& operator-=(difference_type n)
+	{
+		current -= n;
+		return *this;
+	}
+	MYSTL_CONSTEXPR20 self operator-(difference_type n) const
+	{
+		return self(current - n);
+	}
+
+	MYSTL_CONSTEXPR20 reference operator[](difference_type n) const
+	{
+		return static_cast<reference>(current[n]);
+	}
+};
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 auto operator-(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+	-> decltype(lhs.base() - rhs.base())
+{
+	return lhs.base() - rhs.base();
+}
+
+template <class Iterator>
+MYSTL_CONSTEXPR20 move_iterator<Iterator> operator+(typename move_iterator<Iterator>::difference_type n,
+                                                    const move_iterator<Iterator>& it)
+{
+	return it + n;
+}
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 bool operator==(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+{
+	return lhs.base() == rhs.base();
+}
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 bool operator!=(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 bool operator<(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+{
+	return lhs.base() < rhs.base();
+}
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 bool operator>(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 bool operator<=(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class Iterator1, class Iterator2>
+MYSTL_CONSTEXPR20 bool operator>=(const move_iterator<Iterator1>& lhs, const move_iterator<Iterator2>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+template <class Iterator>
+MYSTL_CONSTEXPR20 move_iterator<Iterator> make_move_iterator(Iterator i)
+{
+	return move_iterator<Iterator>(i);
+}
+
+// ********************************************************************************************* //
+
+// 迭代器解包
+// 算法先把包装过的迭代器解包为底层迭代器(最好是原生指针), 在底层迭代器上命中 memmove 等快速路径,
+// 再把结果还原为原来的类型
+// 包装迭代器通过特化 iterator_unwrapper<Iter> 加入, 需要提供:
+//   type                        : 解包后的迭代器类型
+//   static type unwrap(Iter it) : 解包
+//   static Iter rewrap(Iter orig, type it) : 把解包后的 it 还原, orig 为解包前的任一迭代器
+// 默认不解包; 类类型的连续迭代器解包为元素指针, reverse_iterator<reverse_iterator<I>> 解包为 I 解包后的类型,
+// move_iterator<I> 解包为 move_iterator<I 解包后的类型>
+template <class Iter, class = void>
+struct iterator_unwrapper
+{
+	using type = Iter;
+
+	static MYSTL_CONSTEXPR20 type unwrap(Iter it) { return it; }
+	static MYSTL_CONSTEXPR20 Iter rewrap(Iter, type it) { return it; }
+};
+
+template <class Iter>
+struct iterator_unwrapper<Iter, typename std::enable_if<
+	is_contiguous_iterator<Iter>::value && !std::is_pointer<Iter>::value>::type>
+{
+	using type = typename std::remove_reference<typename iterator_traits<Iter>::reference>::type*;
+
+	static MYSTL_CONSTEXPR20 type unwrap(Iter it) { return it.operator->(); }
+	static MYSTL_CONSTEXPR20 Iter rewrap(Iter orig, type it) { return orig + (it - orig.operator->()); }
+};
+
+template <class Iter>
+struct iterator_unwrapper<reverse_iterator<reverse_iterator<Iter>>>
+{
+	using wrapped = reverse_iterator<reverse_iterator<Iter>>;
+	using type = typename iterator_unwrapper<Iter>::type;
+
+	static MYSTL_CONSTEXPR20 type unwrap(wrapped it)
+	{
+		return iterator_unwrapper<Iter>::unwrap(it.base().base());
+	}
+	static MYSTL_CONSTEXPR20 wrapped rewrap(wrapped orig, type it)
+	{
+		return wrapped(reverse_iterator<Iter>(iterator_unwrapper<Iter>::rewrap(orig.base().base(), it)));
+	}
+};
+
+// move_iterator<I> 解包为 move_iterator<I 解包后的类型>, 保留移动语义
+template <class Iter>
+struct iterator_unwrapper<move_iterator<Iter>>
+{
+	using wrapped = move_iterator<Iter>;
+	using type = move_iterator<typename iterator_unwrapper<Iter>::type>;
+
+	static MYSTL_CONSTEXPR20 type unwrap(wrapped it)
+	{
+		return type(iterator_unwrapper<Iter>::unwrap(it.base()));
+	}
+	static MYSTL_CONSTEXPR20 wrapped rewrap(wrapped orig, type it)
+	{
+		return wrapped(iterator_unwrapper<Iter>::rewrap(orig.base(), it.base()));
+	}
+};
+
+template <class Iter>
+MYSTL_CONSTEXPR20 typename iterator_unwrapper<Iter>::type unwrap_iter(Iter it)
+{
+	return iterator_unwrapper<Iter>::unwrap(it);
+}
+
+template <class Iter>
+MYSTL_CONSTEXPR20 Iter rewrap_iter(Iter orig, typename iterator_unwrapper<Iter>::type it)
+{
+	return iterator_unwrapper<Iter>::rewrap(orig, it);
+}
+
 }  // namespace mystl
 
 #endif // !MYTINYSTL_ITERATOR_H_
\ No newline at end of file
@@ -0,0 +1,1119 @@
+#ifndef MYTINYSTL_LIST_H_
+#define MYTINYSTL_LIST_H_
+
+// 这个头文件包含一个模板类 list
+// list : 双向链表
+
+// notes:
+//
+// 节点不再逐个向 ::operator new 申请, 而是来自 shared_node_pool(见 node_pool.h):
+//   * 每个 list 缺省有自己的节点池, 节点集中在少数几块 slab 中, 频繁增删之后遍历仍有较好的局部性
+//   * 构造时传入同一个 pool_type 句柄的多个 list 共用一个节点池, 它们之间的 splice / merge 只需改动指针;
+//     不共用节点池时, splice / merge 会退化为逐个移动元素(节点必须还给分配它的池)
+//   * 区间插入(insert / insert_range / 复制构造)在已知元素个数时先一次性预留整块 slab, 再把新节点串成一条链后整体接入
+//   * sort 是自底向上的归并排序, 只改动节点之间的链接, 不申请内存, 也不移动元素
+// 哨兵节点直接存放在 list 对象中, 所以空 list 不申请内存, swap 之后 end() 会失效
+//
+// 异常保证：
+// mystl::list<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_back
+//   * emplace
+//   * push_front
+//   * push_back
+//   * insert
+//   * insert_range
+
+#include <initializer_list>
+
+#include "fuctional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "node_pool.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// list 的节点设计
+// 链接部分不依赖元素类型, 哨兵节点只包含这一部分
+struct list_node_base
+{
+	list_node_base* prev;  // 前一节点
+	list_node_base* next;  // 下一节点
+};
+
+template <class T>
+struct list_node : public list_node_base
+{
+	T value;  // 数据域
+};
+
+// list 的迭代器设计
+template <class T, bool IsConst>
+struct list_iterator : public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+	typedef T                                                    value_type;
+	typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+	typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+	typedef ptrdiff_t                                            difference_type;
+	typedef list_node_base*                                      base_ptr;
+	typedef list_node<T>*                                        node_ptr;
+	typedef list_iterator                                        self;
+
+	base_ptr node;  // 指向当前节点
+
+	// 构造函数
+	list_iterator() noexcept :node(nullptr) {}
+	explicit list_iterator(base_ptr x) noexcept :node(x) {}
+
+	// 非 const 迭代器可以转换为 const 迭代器
+	template <bool C = IsConst, typename std::enable_if<C, int>::type = 0>
+	list_iterator(const list_iterator<T, false>& rhs) noexcept :node(rhs.node) {}
+
+	// 重载操作符
+	reference operator*()  const { return static_cast<node_ptr>(node)->value; }
+	pointer   operator->() const { return &(operator*()); }
+
+	self& operator++()
+	{
+		MYSTL_DEBUG(node != nullptr);
+		node = node->next;
+		return *this;
+	}
+	self operator++(int)
+	{
+		self tmp = *this;
+		++*this;
+		return tmp;
+	}
+	self& operator--()
+	{
+		MYSTL_DEBUG(node != nullptr);
+		node = node->prev;
+		return *this;
+	}
+	self operator--(int)
+	{
+		self tmp = *this;
+		--*this;
+		return tmp;
+	}
+
+	// 重载比较操作符
+	friend bool operator==(const self& lhs, const self& rhs) { return lhs.node == rhs.node; }
+	friend bool operator!=(const self& lhs, const self& rhs) { return lhs.node != rhs.node; }
+};
+
+// 模板类: list
+// 模板参数 T 代表数据类型
+template <class T>
+class list
+{
+public:
+	// list 的嵌套型别定义
+	typedef mystl::allocator<T>                      allocator_type;
+	typedef mystl::allocator<T>                      data_allocator;
+
+	typedef typename allocator_type::value_type      value_type;
+	typedef typename allocator_type::pointer         pointer;
+	typedef typename allocator_type::const_pointer   const_pointer;
+	typedef typename allocator_type::reference       reference;
+	typedef typename allocator_type::const_reference const_reference;
+	typedef typename allocator_type::size_type       size_type;
+	typedef typename allocator_type::difference_type difference_type;
+
+	typedef list_iterator<T, false>                  iterator;
+	typedef list_iterator<T, true>                   const_iterator;
+	typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+	typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+	// 节点池句柄, 复制句柄即共用节点池
+	typedef shared_node_pool<list_node<T>>           pool_type;
+
+	typedef list_node_base*                          base_ptr;
+	typedef list_node<T>*                            node_ptr;
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+private:
+	list_node_base head_;  // 哨兵节点, head_.next 为第一个节点, head_.prev 为最后一个节点
+	size_type      size_;  // 大小
+	pool_type      pool_;  // 节点池
+
+public:
+	// 构造、复制、移动、析构函数
+	list() noexcept
+	{ init_empty(); }
+
+	// 与 pool 所属的其他 list 共用节点池
+	explicit list(const pool_type& pool) noexcept
+		:pool_(pool)
+	{ init_empty(); }
+
+	explicit list(size_type n)
+	{
+		init_empty();
+		insert_fill(cend(), n, value_type());
+	}
+
+	list(size_type n, const value_type& value)
+	{
+		init_empty();
+		insert_fill(cend(), n, value);
+	}
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	list(IIter first, IIter last)
+	{
+		init_empty();
+		insert_range(cend(), first, last);
+	}
+
+	list(std::initializer_list<value_type> ilist)
+	{
+		init_empty();
+		insert_range(cend(), ilist.begin(), ilist.end());
+	}
+
+	// 复制得到的 list 使用自己的节点池, 新节点连续地分配在同一块 slab 中
+	list(const list& rhs)
+	{
+		init_empty();
+		insert_range(cend(), rhs.cbegin(), rhs.cend());
+	}
+
+	list(list&& rhs) noexcept
+		:pool_(mystl::move(rhs.pool_))
+	{
+		init_empty();
+		take_nodes(rhs);
+	}
+
+	list& operator=(const list& rhs)
+	{
+		if (this != &rhs)
+			assign(rhs.begin(), rhs.end());
+		return *this;
+	}
+
+	list& operator=(list&& rhs) noexcept
+	{
+		clear();
+		swap(rhs);
+		return *this;
+	}
+
+	list& operator=(std::initializer_list<value_type> ilist)
+	{
+		assign(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	~list()
+	{ clear(); }
+
+public:
+	// 迭代器相关操作
+	iterator               begin()         noexcept
+	{ return iterator(head_.next); }
+	const_iterator         begin()   const noexcept
+	{ return const_iterator(head_.next); }
+	iterator               end()           noexcept
+	{ return iterator(&head_); }
+	const_iterator         end()     const noexcept
+	{ return const_iterator(const_cast<base_ptr>(&head_)); }
+
+	reverse_iterator       rbegin()        noexcept
+	{ return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept
+	{ return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept
+	{ return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept
+	{ return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept
+	{ return begin(); }
+	const_iterator         cend()    const noexcept
+	{ return end(); }
+	const_reverse_iterator crbegin() const noexcept
+	{ return rbegin(); }
+	const_reverse_iterator crend()   const noexcept
+	{ return rend(); }
+
+	// 容量相关操作
+	bool      empty()    const noexcept
+	{ return size_ == 0; }
+
+	size_type size()     const noexcept
+	{ return size_; }
+
+	size_type max_size() const noexcept
+	{ return static_cast<size_type>(-1) / sizeof(list_node<T>); }
+
+	// 访问元素相关操作
+	reference       front()
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+
+	const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin();
+	}
+
+	reference       back()
+	{
+		MYSTL_DEBUG(!empty());
+		return *(--end());
+	}
+
+	const_reference back()  const
+	{
+		MYSTL_DEBUG(!empty());
+		return *(--end());
+	}
+
+	// 节点池句柄, 可用于构造共用节点池的其他 list; 尚未创建节点池时先创建
+	pool_type get_pool()
+	{
+		if (!pool_.valid())
+			pool_ = pool_type::create();
+		return pool_;
+	}
+
+	// 调整容器相关操作
+
+	// assign
+
+	void     assign(size_type n, const value_type& value)
+	{ fill_assign(n, value); }
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	void     assign(IIter first, IIter last)
+	{ copy_assign(first, last); }
+
+	void     assign(std::initializer_list<value_type> ilist)
+	{ copy_assign(ilist.begin(), ilist.end()); }
+
+	// emplace_front / emplace_back / emplace
+
+	template <class ...Args>
+	void     emplace_front(Args&& ...args)
+	{
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+		link_nodes(head_.next, create_node(mystl::forward<Args>(args)...));
+		++size_;
+	}
+
+	template <class ...Args>
+	void     emplace_back(Args&& ...args)
+	{
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+		link_nodes(&head_, create_node(mystl::forward<Args>(args)...));
+		++size_;
+	}
+
+	template <class ...Args>
+	iterator emplace(const_iterator pos, Args&& ...args)
+	{
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+		node_ptr p = create_node(mystl::forward<Args>(args)...);
+		link_nodes(pos.node, p);
+		++size_;
+		return iterator(p);
+	}
+
+	// push_front / push_back
+
+	void     push_front(const value_type& value)
+	{ emplace_front(value); }
+	void     push_front(value_type&& value)
+	{ emplace_front(mystl::move(value)); }
+
+	void     push_back(const value_type& value)
+	{ emplace_back(value); }
+	void     push_back(value_type&& value)
+	{ emplace_back(mystl::move(value)); }
+
+	// pop_front / pop_back
+
+	void     pop_front()
+	{
+		MYSTL_DEBUG(!empty());
+		erase(cbegin());
+	}
+
+	void     pop_back()
+	{
+		MYSTL_DEBUG(!empty());
+		erase(--cend());
+	}
+
+	// insert
+
+	iterator insert(const_iterator pos, const value_type& value)
+	{ return emplace(pos, value); }
+
+	iterator insert(const_iterator pos, value_type&& value)
+	{ return emplace(pos, mystl::move(value)); }
+
+	iterator insert(const_iterator pos, size_type n, const value_type& value)
+	{ return insert_fill(pos, n, value); }
+
+	template <class IIter, typename std::enable_if<
+		mystl::is_input_iterator<IIter>::value, int>::type = 0>
+	iterator insert(const_iterator pos, IIter first, IIter last)
+	{ return insert_range(pos, first, last); }
+
+	iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+	{ return insert_range(pos, ilist.begin(), ilist.end()); }
+
+	// insert_range
+	// 批量插入: 前向迭代器会先按元素个数预留节点池, 新节点串成一条链后整体接入, 返回第一个新元素的位置
+	template <class IIter>
+	iterator insert_range(const_iterator pos, IIter first, IIter last);
+
+	// erase / clear
+
+	iterator erase(const_iterator pos);
+	iterator erase(const_iterator first, const_iterator last);
+
+	void     clear() noexcept;
+
+	// resize
+
+	void     resize(size_type new_size) { resize(new_size, value_type()); }
+	void     resize(size_type new_size, const value_type& value);
+
+	void     swap(list& rhs) noexcept;
+
+	// list 相关操作
+
+	void splice(const_iterator pos, list& other);
+	void splice(const_iterator pos, list&& other)
+	{ splice(pos, other); }
+	void splice(const_iterator pos, list& other, const_iterator it);
+	void splice(const_iterator pos, list&& other, const_iterator it)
+	{ splice(pos, other, it); }
+	void splice(const_iterator pos, list& other, const_iterator first, const_iterator last);
+	void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last)
+	{ splice(pos, other, first, last); }
+
+	void remove(const value_type& value)
+	{ remove_if([&](const value_type& v) { return v == value; }); }
+	template <class UnaryPredicate>
+	void remove_if(UnaryPredicate pred);
+
+	void unique()
+	{ unique(mystl::equal_to<T>()); }
+	template <class BinaryPredicate>
+	void unique(BinaryPredicate pred);
+
+	void merge(list& x)
+	{ merge(x, mystl::less<T>()); }
+	void merge(list&& x)
+	{ merge(x, mystl::less<T>()); }
+	template <class Compare>
+	void merge(list& x, Compare comp);
+	template <class Compare>
+	void merge(list&& x, Compare comp)
+	{ merge(x, comp); }
+
+	void sort()
+	{ sort(mystl::less<T>()); }
+	template <class Compared>
+	void sort(Compared comp);
+
+	void reverse() noexcept;
+
+private:
+	// helper functions
+
+	static value_type& value_of(base_ptr p) noexcept
+	{ return static_cast<node_ptr>(p)->value; }
+
+	void init_empty() noexcept
+	{
+		head_.prev = &head_;
+		head_.next = &head_;
+		size_ = 0;
+	}
+
+	// create / destroy node
+	template <class ...Args>
+	node_ptr create_node(Args&& ...args);
+	void     destroy_node(base_ptr p) noexcept;
+	void     destroy_chain(base_ptr first) noexcept;
+
+	// link / unlink
+	static void link_nodes(base_ptr pos, base_ptr first, base_ptr last) noexcept;
+	static void link_nodes(base_ptr pos, base_ptr p) noexcept
+	{ link_nodes(pos, p, p); }
+	static void unlink_nodes(base_ptr first, base_ptr last) noexcept;
+	void        relink_chain(base_ptr chain) noexcept;
+	void        take_nodes(list& rhs) noexcept;
+
+	// 节点池
+	bool     share_pool_with(list& other) noexcept;
+	template <class IIter>
+	void     reserve_nodes(IIter, IIter, input_iterator_tag) {}
+	template <class FIter>
+	void     reserve_nodes(FIter first, FIter last, forward_iterator_tag)
+	{ pool_.reserve(static_cast<size_type>(mystl::distance(first, last))); }
+
+	// insert
+	iterator insert_fill(const_iterator pos, size_type n, const value_type& value);
+	void     transfer(const_iterator pos, list& other, const_iterator first,
+	                  const_iterator last, size_type n);
+
+	// assign
+	void     fill_assign(size_type n, const value_type& value);
+	template <class IIter>
+	void     copy_assign(IIter first, IIter last);
+
+	// sort
+	template <class Compared>
+	static void merge_chains(base_ptr a, base_ptr b, base_ptr& out, Compared& comp);
+	static base_ptr concat_chains(base_ptr a, base_ptr b) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 在 pos 之前批量插入 [first, last) 的元素
+template <class T>
+template <class IIter>
+typename list<T>::iterator
+list<T>::insert_range(const_iterator pos, IIter first, IIter last)
+{
+	if (first == last)
+		return iterator(pos.node);
+	reserve_nodes(first, last, iterator_category(first));
+	node_ptr head = create_node(*first);
+	head->next = nullptr;
+	base_ptr tail = head;
+	size_type n = 1;
+	MYSTL_TRY
+	{
+		for (++first; first != last; ++first, ++n)
+		{
+			node_ptr p = create_node(*first);
+			tail->next = p;
+			p->prev = tail;
+			p->next = nullptr;
+			tail = p;
+		}
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
+	}
+	MYSTL_CATCH_ALL
+	{
+		destroy_chain(head);
+		MYSTL_RETHROW;
+	}
+	link_nodes(pos.node, head, tail);
+	size_ += n;
+	return iterator(head);
+}
+
+// 删除 pos 处的元素
+template <class T>
+typename list<T>::iterator
+list<T>::erase(const_iterator pos)
+{
+	MYSTL_DEBUG(pos != cend());
+	base_ptr n = pos.node;
+	base_ptr next = n->next;
+	unlink_nodes(n, n);
+	destroy_node(n);
+	--size_;
+	return iterator(next);
+}
+
+// 删除 [first, last) 内的元素
+template <class T>
+typename list<T>::iterator
+list<T>::erase(const_iterator first, const_iterator last)
+{
+	if (first != last)
+	{
+		base_ptr l = last.node->prev;
+		unlink_nodes(first.node, l);
+		l->next = nullptr;
+		for (base_ptr cur = first.node; cur != nullptr; --size_)
+		{
+			base_ptr next = cur->next;
+			destroy_node(cur);
+			cur = next;
+		}
+	}
+	return iterator(last.node);
+}
+
+// 清空 list, 节点还给节点池
+template <class T>
+void list<T>::clear() noexcept
+{
+	if (size_ != 0)
+	{
+		head_.prev->next = nullptr;
+		destroy_chain(head_.next);
+		init_empty();
+	}
+}
+
+// 重置容器大小
+template <class T>
+void list<T>::resize(size_type new_size, const value_type& value)
+{
+	if (new_size < size_)
+	{
+		auto i = cend();
+		for (size_type n = size_ - new_size; n > 0; --n)
+			--i;
+		erase(i, cend());
+	}
+	else
+	{
+		insert_fill(cend(), new_size - size_, value);
+	}
+}
+
+// 交换两个 list, 节点池一并交换
+template <class T>
+void list<T>::swap(list& rhs) noexcept
+{
+	if (this == &rhs)
+		return;
+	list_node_base tmp = head_;
+	head_ = rhs.head_;
+	rhs.head_ = tmp;
+	mystl::swap(size_, rhs.size_);
+	pool_.swap(rhs.pool_);
+	if (size_ == 0)
+	{
+		init_empty();
+	}
+	else
+	{
+		head_.next->prev = &head_;
+		head_.prev->next = &head_;
+	}
+	if (rhs.size_ == 0)
+	{
+		rhs.init_empty();
+	}
+	else
+	{
+		rhs.head_.next->prev = &rhs.head_;
+		rhs.head_.prev->next = &rhs.head_;
+	}
+}
+
+// 将 list other 接合于 pos 之前
+template <class T>
+void list<T>::splice(const_iterator pos, list& other)
+{
+	MYSTL_DEBUG(this != &other);
+	if (!other.empty())
+	{
+		THROW_LENGTH_ERROR_IF(size_ > max_size() - other.size_, "list<T>'s size too big");
+		share_pool_with(other);
+		transfer(pos, other, other.cbegin(), other.cend(), other.size_);
+	}
+}
+
+// 将 it 所指的节点接合于 pos 之前
+template <class T>
+void list<T>::splice(const_iterator pos, list& other, const_iterator it)
+{
+	if (pos.node != it.node && pos.node != it.node->next)
+	{
+		THROW_LENGTH_ERROR_IF(this != &other && size_ > max_size() - 1, "list<T>'s size too big");
+		share_pool_with(other);
+		const_iterator next = it;
+		transfer(pos, other, it, ++next, 1);
+	}
+}
+
+// 将 list other 的 [first, last) 内的节点接合于 pos 之前
+template <class T>
+void list<T>::splice(const_iterator pos, list& other, const_iterator first, const_iterator last)
+{
+	if (first != last)
+	{
+		size_type n = 0;
+		if (this != &other)
+		{
+			n = static_cast<size_type>(mystl::distance(first, last));
+			THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
+			share_pool_with(other);
+		}
+		transfer(pos, other, first, last, n);
+	}
+}
+
+// 删除令一元操作 pred 为 true 的所有元素
+// 先把要删除的节点摘下串成一条链, 最后再析构, 这样 pred 引用 list 中的元素也是安全的
+template <class T>
+template <class UnaryPredicate>
+void list<T>::remove_if(UnaryPredicate pred)
+{
+	list_node_base removed;
+	removed.next = nullptr;
+	base_ptr tail = &removed;
+	MYSTL_TRY
+	{
+		for (base_ptr cur = head_.next; cur != &head_; )
+		{
+			base_ptr next = cur->next;
+			if (pred(value_of(cur)))
+			{
+				unlink_nodes(cur, cur);
+				--size_;
+				tail->next = cur;
+				cur->next = nullptr;
+				tail = cur;
+			}
+			cur = next;
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		destroy_chain(removed.next);
+		MYSTL_RETHROW;
+	}
+	destroy_chain(removed.next);
+}
+
+// 移除 list 中满足 pred 为 true 重复元素
+template <class T>
+template <class BinaryPredicate>
+void list<T>::unique(BinaryPredicate pred)
+{
+	auto i = begin();
+	auto e = end();
+	if (i == e)
+		return;
+	auto j = i;
+	++j;
+	while (j != e)
+	{
+		if (pred(*i, *j))
+		{
+			j = erase(j);
+		}
+		else
+		{
+			i = j;
+			++j;
+		}
+	}
+}
+
+// 与另一个有序 list 合并, 按照 comp 为 true 的顺序
+template <class T>
+template <class Compare>
+void list<T>::merge(list& x, Compare comp)
+{
+	if (this == &x || x.empty())
+		return;
+	THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "list<T>'s size too big");
+	share_pool_with(x);
+
+	auto f1 = cbegin();
+	auto l1 = cend();
+	auto f2 = x.cbegin();
+	auto l2 = x.cend();
+	while (f1 != l1 && f2 != l2)
+	{
+		if (comp(*f2, *f1))
+		{
+			// 使 comp 为 true 的一段区间
+			auto next = f2;
+			++next;
+			size_type n = 1;
+			for (; next != l2 && comp(*next, *f1); ++next, ++n)
+				;
+			transfer(f1, x, f2, next, n);
+			f2 = next;
+		}
+		else
+		{
+			++f1;
+		}
+	}
+	// 连接剩余部分
+	if (f2 != l2)
+		transfer(l1, x, f2, l2, x.size_);
+}
+
+// 将 list 反转
+template <class T>
+void list<T>::reverse() noexcept
+{
+	if (size_ <= 1)
+		return;
+	base_ptr cur = &head_;
+	do
+	{
+		mystl::swap(cur->prev, cur->next);
+		cur = cur->prev;
+	} while (cur != &head_);
+}
+
+// 对 list 进行排序
+// 自底向上的归并排序: bins[i] 保存长度约为 2^i 的有序链, 只改动 next 指针, 最后统一恢复 prev 指针
+// comp 抛出异常时, 所有节点按当前的顺序重新接回 list, 不会丢失元素
+template <class T>
+template <class Compared>
+void list<T>::sort(Compared comp)
+{
+	if (size_ <= 1)
+		return;
+	head_.prev->next = nullptr;
+	base_ptr chain = head_.next;
+	base_ptr bins[64];
+	size_type fill = 0;
+	base_ptr carry = nullptr;
+	MYSTL_TRY
+	{
+		while (chain != nullptr)
+		{
+			carry = chain;
+			chain = chain->next;
+			carry->next = nullptr;
+			size_type i = 0;
+			for (; i < fill && bins[i] != nullptr; ++i)
+			{
+				base_ptr a = bins[i];
+				bins[i] = nullptr;
+				merge_chains(a, carry, carry, comp);
+			}
+			bins[i] = carry;
+			carry = nullptr;
+			if (i == fill)
+				++fill;
+		}
+		for (size_type i = 0; i < fill; ++i)
+		{
+			if (bins[i] != nullptr)
+			{
+				base_ptr a = bins[i];
+				bins[i] = nullptr;
+				merge_chains(a, carry, carry, comp);
+			}
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		for (size_type i = fill; i > 0; --i)
+			carry = concat_chains(bins[i - 1], carry);
+		relink_chain(concat_chains(carry, chain));
+		MYSTL_RETHROW;
+	}
+	relink_chain(carry);
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 创建节点
+template <class T>
+template <class ...Args>
+typename list<T>::node_ptr
+list<T>::create_node(Args&& ...args)
+{
+	node_ptr p = pool_.allocate();
+	MYSTL_TRY
+	{
+		data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+		p->prev = nullptr;
+		p->next = nullptr;
+	}
+	MYSTL_CATCH_ALL
+	{
+		pool_.deallocate(p);
+		MYSTL_RETHROW;
+	}
+	return p;
+}
+
+// 销毁节点
+template <class T>
+void list<T>::destroy_node(base_ptr p) noexcept
+{
+	node_ptr n = static_cast<node_ptr>(p);
+	data_allocator::destroy(mystl::address_of(n->value));
+	pool_.deallocate(n);
+}
+
+// 销毁一条以 nullptr 结尾的节点链
+template <class T>
+void list<T>::destroy_chain(base_ptr first) noexcept
+{
+	while (first != nullptr)
+	{
+		base_ptr next = first->next;
+		destroy_node(first);
+		first = next;
+	}
+}
+
+// 在 pos 之前连接 [first, last] 的节点
+template <class T>
+void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) noexcept
+{
+	pos->prev->next = first;
+	first->prev = pos->prev;
+	pos->prev = last;
+	last->next = pos;
+}
+
+// 断开 [first, last] 的节点
+template <class T>
+void list<T>::unlink_nodes(base_ptr first, base_ptr last) noexcept
+{
+	first->prev->next = last->next;
+	last->next->prev = first->prev;
+}
+
+// 把一条以 nullptr 结尾的节点链作为 list 的全部节点, 并恢复 prev 指针
+template <class T>
+void list<T>::relink_chain(base_ptr chain) noexcept
+{
+	base_ptr prev = &head_;
+	for (base_ptr cur = chain; cur != nullptr; cur = cur->next)
+	{
+		prev->next = cur;
+		cur->prev = prev;
+		prev = cur;
+	}
+	prev->next = &head_;
+	head_.prev = prev;
+}
+
+// 接管 rhs 的全部节点, rhs 变为空
+template <class T>
+void list<T>::take_nodes(list& rhs) noexcept
+{
+	if (rhs.size_ != 0)
+	{
+		head_ = rhs.head_;
+		size_ = rhs.size_;
+		head_.next->prev = &head_;
+		head_.prev->next = &head_;
+		rhs.init_empty();
+	}
+}
+
+// 尽量与 other 共用节点池: 已经共用, 或者自身为空时改用 other 的节点池, 返回是否共用
+template <class T>
+bool list<T>::share_pool_with(list& other) noexcept
+{
+	if (pool_ == other.pool_)
+		return true;
+	if (size_ == 0 && other.pool_.valid())
+	{
+		pool_ = other.pool_;
+		return true;
+	}
+	return false;
+}
+
+// 在 pos 之前插入 n 个 value, 节点一次预留
+template <class T>
+typename list<T>::iterator
+list<T>::insert_fill(const_iterator pos, size_type n, const value_type& value)
+{
+	if (n == 0)
+		return iterator(pos.node);
+	THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
+	pool_.reserve(n);
+	node_ptr head = create_node(value);
+	base_ptr tail = head;
+	MYSTL_TRY
+	{
+		for (size_type i = 1; i < n; ++i)
+		{
+			node_ptr p = create_node(value);
+			tail->next = p;
+			p->prev = tail;
+			tail = p;
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		tail->next = nullptr;
+		destroy_chain(head);
+		MYSTL_RETHROW;
+	}
+	link_nodes(pos.node, head, tail);
+	size_ += n;
+	return iterator(head);
+}
+
+// 把 other 中 [first, last) 的 n 个节点移到 pos 之前
+// 共用节点池时只改动指针, 否则逐个移动元素后删除 other 中的节点
+template <class T>
+void list<T>::transfer(const_iterator pos, list& other, const_iterator first,
+                       const_iterator last, size_type n)
+{
+	if (pool_ == other.pool_)
+	{
+		base_ptr f = first.node;
+		base_ptr l = last.node->prev;
+		unlink_nodes(f, l);
+		link_nodes(pos.node, f, l);
+		if (this != &other)
+		{
+			size_ += n;
+			other.size_ -= n;
+		}
+	}
+	else
+	{
+		while (first != last)
+		{
+			emplace(pos, mystl::move(value_of(first.node)));
+			first = other.erase(first);
+		}
+	}
+}
+
+// 用 n 个 value 为容器赋值, 复用已有的节点
+template <class T>
+void list<T>::fill_assign(size_type n, const value_type& value)
+{
+	auto i = begin();
+	auto e = end();
+	for (; n > 0 && i != e; --n, ++i)
+		*i = value;
+	if (n > 0)
+		insert_fill(e, n, value);
+	else
+		erase(i, e);
+}
+
+// 用 [first, last) 为容器赋值, 复用已有的节点
+template <class T>
+template <class IIter>
+void list<T>::copy_assign(IIter first, IIter last)
+{
+	auto f1 = begin();
+	auto l1 = end();
+	for (; f1 != l1 && first != last; ++f1, ++first)
+		*f1 = *first;
+	if (first == last)
+		erase(f1, l1);
+	else
+		insert_range(l1, first, last);
+}
+
+// 合并两条以 nullptr 结尾的有序链, 相等时 a 中的节点在前, 结果写入 out
+// comp 抛出异常时, 已合并的部分与 a, b 的剩余部分仍首尾相连写入 out
+template <class T>
+template <class Compared>
+void list<T>::merge_chains(base_ptr a, base_ptr b, base_ptr& out, Compared& comp)
+{
+	list_node_base head;
+	head.next = nullptr;
+	base_ptr tail = &head;
+	MYSTL_TRY
+	{
+		while (a != nullptr && b != nullptr)
+		{
+			if (comp(value_of(b), value_of(a)))
+			{
+				tail->next = b;
+				b = b->next;
+			}
+			else
+			{
+				tail->next = a;
+				a = a->next;
+			}
+			tail = tail->next;
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		tail->next = concat_chains(a, b);
+		out = head.next;
+		MYSTL_RETHROW;
+	}
+	tail->next = a != nullptr ? a : b;
+	out = head.next;
+}
+
+// 把链 b 接在链 a 之后
+template <class T>
+typename list<T>::base_ptr
+list<T>::concat_chains(base_ptr a, base_ptr b) noexcept
+{
+	if (a == nullptr)
+		return b;
+	base_ptr tail = a;
+	while (tail->next != nullptr)
+		tail = tail->next;
+	tail->next = b;
+	return a;
+}
+
+// 重载比较操作符
+template <class T>
+bool operator==(const list<T>& lhs, const list<T>& rhs)
+{
+	auto f1 = lhs.cbegin();
+	auto f2 = rhs.cbegin();
+	auto l1 = lhs.cend();
+	auto l2 = rhs.cend();
+	for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2)
+		;
+	return f1 == l1 && f2 == l2;
+}
+
+template <class T>
+bool operator<(const list<T>& lhs, const list<T>& rhs)
+{
+	return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T>
+bool operator!=(const list<T>& lhs, const list<T>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const list<T>& lhs, const list<T>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const list<T>& lhs, const list<T>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const list<T>& lhs, const list<T>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(list<T>& lhs, list<T>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_LIST_H_
@@ -2,7 +2,7 @@
 #define MYTINYSTL_MEMORY_H_
 
 // 这个头文件负责更高级的动态内存管理
-// 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr
+// 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及模板类 auto_ptr 与 unique_ptr
 
 #include <cstddef>
 #include <cstdlib>
@@ -13,6 +13,8 @@
 #include "allocator.h"
 #include "construct.h"
 #include "uninitialized.h"
+#include "exceptdef.h"
+#include "tuple.h"
 
 namespace mystl
 {
@@ -115,7 +117,7 @@ private:
 template <class ForwardIterator, class T>
 temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last)
 {
-	try
+	MYSTL_TRY
 	{
 		// len 为缓冲区长度,长度为两迭代器间距离
 		len = mystl::distance(first, last);
@@ -123,7 +125,7 @@ temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, Fo
 		if (len > 0)
 			initialize_buffer(*first, std::is_trivially_default_constructible<T>());
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
 		free(buffer);
 		buffer = nullptr;
@@ -224,5 +226,291 @@ public:
 	}
 };
 
+// 模板类: default_delete
+// unique_ptr 默认的删除器, 空类型, 不占空间
+template <class T>
+struct default_delete
+{
+	constexpr default_delete() noexcept = default;
+
+	template <class U, typename std::enable_if<
+		std::is_convertible<U*, T*>::value, int>::type = 0>
+	default_delete(const default_delete<U>&) noexcept {}
+
+	void operator()(T* p) const
+	{
+		static_assert(sizeof(T) > 0, "can not delete an incomplete type");
+		delete p;
+	}
+};
+
+template <class T>
+struct default_delete<T[]>
+{
+	constexpr default_delete() noexcept = default;
+
+	void operator()(T* p) const
+	{
+		static_assert(sizeof(T) > 0, "can not delete an incomplete type");
+		delete[] p;
+	}
+};
+
+// 模板类: unique_ptr
+// 独占所有权的智能指针, 只能移动不能复制
+// 指针与删除器保存在 compressed_pair 中, 删除器为空类型(如 default_delete)时 sizeof(unique_ptr) == sizeof(T*)
+template <class T, class Deleter = default_delete<T>>
+class unique_ptr
+{
+public:
+	typedef T*      pointer;
+	typedef T       element_type;
+	typedef Deleter deleter_type;
+
+private:
+	compressed_pair<pointer, deleter_type> data_;  // 指针与删除器
+
+	template <class U, class E>
+	friend class unique_ptr;
+
+public:
+	// 构造、移动、析构函数
+	constexpr unique_ptr() noexcept : data_(pointer(), deleter_type()) {}
+	constexpr unique_ptr(std::nullptr_t) noexcept : data_(pointer(), deleter_type()) {}
+
+	explicit unique_ptr(pointer p) noexcept : data_(p, deleter_type()) {}
+
+	template <class D>
+	unique_ptr(pointer p, D&& d) noexcept : data_(p, mystl::forward<D>(d)) {}
+
+	unique_ptr(unique_ptr&& rhs) noexcept
+		:data_(rhs.release(), mystl::forward<deleter_type>(rhs.get_deleter()))
+	{
+	}
+
+	// 指向派生类的 unique_ptr 可以转换为指向基类的 unique_ptr
+	template <class U, class E, typename std::enable_if<
+		std::is_convertible<U*, T*>::value && !std::is_array<U>::value &&
+		std::is_convertible<E, Deleter>::value, int>::type = 0>
+	unique_ptr(unique_ptr<U, E>&& rhs) noexcept
+		:data_(rhs.release(), mystl::forward<E>(rhs.get_deleter()))
+	{
+	}
+
+	unique_ptr(const unique_ptr&) = delete;
+	unique_ptr& operator=(const unique_ptr&) = delete;
+
+	unique_ptr& operator=(unique_ptr&& rhs) noexcept
+	{
+		reset(rhs.release());
+		get_deleter() = mystl::forward<deleter_type>(rhs.get_deleter());
+		return *this;
+	}
+
+	template <class U, class E, typename std::enable_if<
+		std::is_convertible<U*, T*>::value && !std::is_array<U>::value, int>::type = 0>
+	unique_ptr& operator=(unique_ptr<U, E>&& rhs) noexcept
+	{
+		reset(rhs.release());
+		get_deleter() = mystl::forward<E>(rhs.get_deleter());
+		return *this;
+	}
+
+	unique_ptr& operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	~unique_ptr()
+	{
+		if (data_.first() != nullptr)
+			get_deleter()(data_.first());
+	}
+
+public:
+	T&      operator*() const { return *data_.first(); }
+	pointer operator->() const noexcept { return data_.first(); }
+
+	pointer get() const noexcept { return data_.first(); }
+
+	deleter_type&       get_deleter() noexcept       { return data_.second(); }
+	const deleter_type& get_deleter() const noexcept { return data_.second(); }
+
+	explicit operator bool() const noexcept { return data_.first() != nullptr; }
+
+	// 放弃所有权, 返回原来的指针
+	pointer release() noexcept
+	{
+		pointer tmp = data_.first();
+		data_.first() = nullptr;
+		return tmp;
+	}
+
+	// 先保存新指针再删除旧对象, 这样旧对象的析构函数中访问本 unique_ptr 也是安全的
+	void reset(pointer p = pointer()) noexcept
+	{
+		pointer old = data_.first();
+		data_.first() = p;
+		if (old != nullptr)
+			get_deleter()(old);
+	}
+
+	void swap(unique_ptr& rhs) noexcept
+	{
+		data_.swap(rhs.data_);
+	}
+};
+
+// 数组版本, 用 operator[] 访问元素, 不支持派生类到基类的转换
+template <class T, class Deleter>
+class unique_ptr<T[], Deleter>
+{
+public:
+	typedef T*      pointer;
+	typedef T       element_type;
+	typedef Deleter deleter_type;
+
+private:
+	compressed_pair<pointer, deleter_type> data_;  // 指针与删除器
+
+public:
+	constexpr unique_ptr() noexcept : data_(pointer(), deleter_type()) {}
+	constexpr unique_ptr(std::nullptr_t) noexcept : data_(pointer(), deleter_type()) {}
+
+	explicit unique_ptr(pointer p) noexcept : data_(p, deleter_type()) {}
+
+	template <class D>
+	unique_ptr(pointer p, D&& d) noexcept : data_(p, mystl::forward<D>(d)) {}
+
+	unique_ptr(unique_ptr&& rhs) noexcept
+		:data_(rhs.release(), mystl::forward<deleter_type>(rhs.get_deleter()))
+	{
+	}
+
+	unique_ptr(const unique_ptr&) = delete;
+	unique_ptr& operator=(const unique_ptr&) = delete;
+
+	unique_ptr& operator=(unique_ptr&& rhs) noexcept
+	{
+		reset(rhs.release());
+		get_deleter() = mystl::forward<deleter_type>(rhs.get_deleter());
+		return *this;
+	}
+
+	unique_ptr& operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	~unique_ptr()
+	{
+		if (data_.first() != nullptr)
+			get_deleter()(data_.first());
+	}
+
+public:
+	T& operator[](size_t n) const { return data_.first()[n]; }
+
+	pointer get() const noexcept { return data_.first(); }
+
+	deleter_type&       get_deleter() noexcept       { return data_.second(); }
+	const deleter_type& get_deleter() const noexcept { return data_.second(); }
+
+	explicit operator bool() const noexcept { return data_.first() != nullptr; }
+
+	pointer release() noexcept
+	{
+		pointer tmp = data_.first();
+		data_.first() = nullptr;
+		return tmp;
+	}
+
+	void reset(pointer p = pointer()) noexcept
+	{
+		pointer old = data_.first();
+		data_.first() = p;
+		if (old != nullptr)
+			get_deleter()(old);
+	}
+
+	void swap(unique_ptr& rhs) noexcept
+	{
+		data_.swap(rhs.data_);
+	}
+};
+
+static_assert(sizeof(unique_ptr<int>) == sizeof(int*),
+              "unique_ptr with an empty deleter should be as small as a raw pointer");
+static_assert(sizeof(unique_ptr<int[]>) == sizeof(int*),
+              "unique_ptr with an empty deleter should be as small as a raw pointer");
+
+// make_unique
+template <class T, class... Args, typename std::enable_if<
+	!std::is_array<T>::value, int>::type = 0>
+unique_ptr<T> make_unique(Args&&... args)
+{
+	return unique_ptr<T>(new T(mystl::forward<Args>(args)...));
+}
+
+// 数组版本, 元素值初始化
+template <class T, typename std::enable_if<
+	std::is_array<T>::value && std::extent<T>::value == 0, int>::type = 0>
+unique_ptr<T> make_unique(size_t n)
+{
+	typedef typename std::remove_extent<T>::type elem_type;
+	return unique_ptr<T>(new elem_type[n]());
+}
+
+// 重载比较操作符与 swap
+template <class T1, class D1, class T2, class D2>
+bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs)
+{
+	return lhs.get() == rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs)
+{
+	return lhs.get() != rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator<(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs)
+{
+	return lhs.get() < rhs.get();
+}
+
+template <class T, class D>
+bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept
+{
+	return !lhs;
+}
+
+template <class T, class D>
+bool operator==(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept
+{
+	return !rhs;
+}
+
+template <class T, class D>
+bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept
+{
+	return static_cast<bool>(lhs);
+}
+
+template <class T, class D>
+bool operator!=(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept
+{
+	return static_cast<bool>(rhs);
+}
+
+template <class T, class D>
+void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_MEMORY_H_
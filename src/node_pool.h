@@ -0,0 +1,383 @@
+#ifndef MYTINYSTL_NODE_POOL_H_
+#define MYTINYSTL_NODE_POOL_H_
+
+// 这个头文件包含三个模板类 fixed_size_pool, node_pool 和 shared_node_pool
+// 用于节点式容器: 以整块内存(slab)为单位向 mystl::allocator 申请, 再切分为固定大小的节点
+
+// notes:
+//
+// 节点式容器每插入一个元素就调用一次 ::operator new, 分配开销大, 并且节点散落在堆中各处,
+// 遍历时几乎每一步都是缓存未命中; 节点池把同一容器的节点集中在少数几块连续内存中:
+//   * 分配: 先从空闲链表中取, 链表为空时在当前 slab 中顺序切分, slab 用完时再申请新的 slab
+//   * 释放: 节点放回空闲链表, 内存直到 release() 或池析构时才归还
+//   * slab 的大小从 kMinSlabNodes 个节点开始按两倍增长, 最大为 kMaxSlabBytes 字节
+// 节点池不是线程安全的, 也不会构造或析构节点中的对象, 只负责内存
+// shared_node_pool 是带引用计数的节点池句柄, 共用同一个池的容器之间可以直接转移节点
+
+#include <cstddef>
+#include <cstdint>
+
+#include "allocator.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 缓存行大小, 需要避免伪共享或按缓存行对齐的结构以此为准
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif // !MYSTL_CACHE_LINE_SIZE
+
+// 模板类 fixed_size_pool
+// 参数一代表节点大小，参数二代表节点的对齐要求(必须是 2 的幂)
+template <size_t NodeSize, size_t NodeAlign = alignof(std::max_align_t)>
+class fixed_size_pool
+{
+	static_assert((NodeAlign & (NodeAlign - 1)) == 0, "node alignment must be a power of two");
+
+private:
+	// 空闲节点复用自身的内存存放链表指针
+	struct free_node
+	{
+		free_node* next;
+	};
+
+	// 每个 slab 头部记录下一个 slab 与自身的字节数, 用于释放
+	struct slab_header
+	{
+		slab_header* next;
+		size_t       bytes;
+	};
+
+	typedef mystl::allocator<unsigned char> byte_allocator;
+
+public:
+	typedef size_t size_type;
+
+	static constexpr size_t kAlign = NodeAlign > alignof(free_node) ? NodeAlign : alignof(free_node);
+	// 节点的实际大小: 至少能放下一个指针, 并向上取整到对齐要求的整数倍
+	static constexpr size_t kNodeSize =
+		((NodeSize > sizeof(free_node) ? NodeSize : sizeof(free_node)) + kAlign - 1) & ~(kAlign - 1);
+
+	static constexpr size_t kMinSlabNodes = 16;
+	static constexpr size_t kMaxSlabBytes = 64 * 1024;
+
+private:
+	free_node*     free_;       // 空闲链表
+	slab_header*   slabs_;      // 所有 slab 组成的链表
+	unsigned char* cur_;        // 当前 slab 中尚未切分部分的起始位置
+	unsigned char* cur_end_;    // 当前 slab 的末尾
+	size_type      next_nodes_; // 下一个 slab 的节点数
+
+public:
+	// 构造、移动、析构函数, 节点池不可复制
+	fixed_size_pool() noexcept
+		:free_(nullptr), slabs_(nullptr), cur_(nullptr), cur_end_(nullptr),
+		 next_nodes_(kMinSlabNodes)
+	{
+	}
+
+	fixed_size_pool(const fixed_size_pool&) = delete;
+	fixed_size_pool& operator=(const fixed_size_pool&) = delete;
+
+	fixed_size_pool(fixed_size_pool&& rhs) noexcept
+		:free_(rhs.free_), slabs_(rhs.slabs_), cur_(rhs.cur_), cur_end_(rhs.cur_end_),
+		 next_nodes_(rhs.next_nodes_)
+	{
+		rhs.reset();
+	}
+
+	fixed_size_pool& operator=(fixed_size_pool&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			release();
+			free_ = rhs.free_;
+			slabs_ = rhs.slabs_;
+			cur_ = rhs.cur_;
+			cur_end_ = rhs.cur_end_;
+			next_nodes_ = rhs.next_nodes_;
+			rhs.reset();
+		}
+		return *this;
+	}
+
+	~fixed_size_pool()
+	{
+		release();
+	}
+
+	// 分配一个节点
+	void* allocate()
+	{
+		if (free_ != nullptr)
+		{
+			free_node* node = free_;
+			free_ = node->next;
+			return node;
+		}
+		if (cur_ == cur_end_)
+			add_slab(next_nodes_);
+		void* node = cur_;
+		cur_ += kNodeSize;
+		return node;
+	}
+
+	// 释放一个节点, 节点放回空闲链表
+	void deallocate(void* ptr) noexcept
+	{
+		if (ptr == nullptr)
+			return;
+		free_node* node = static_cast<free_node*>(ptr);
+		node->next = free_;
+		free_ = node;
+	}
+
+	// 预先申请内存, 保证接下来的 n 次 allocate 都不会再申请 slab
+	void reserve(size_type n)
+	{
+		const size_type avail = static_cast<size_type>(cur_end_ - cur_) / kNodeSize;
+		if (n > avail)
+			add_slab(n - avail > next_nodes_ ? n - avail : next_nodes_);
+	}
+
+	// 归还所有 slab, 调用前必须已经析构了节点中的所有对象
+	void release() noexcept
+	{
+		while (slabs_ != nullptr)
+		{
+			slab_header* next = slabs_->next;
+			byte_allocator::deallocate(reinterpret_cast<unsigned char*>(slabs_), slabs_->bytes);
+			slabs_ = next;
+		}
+		reset();
+	}
+
+	void swap(fixed_size_pool& rhs) noexcept
+	{
+		mystl::swap(free_, rhs.free_);
+		mystl::swap(slabs_, rhs.slabs_);
+		mystl::swap(cur_, rhs.cur_);
+		mystl::swap(cur_end_, rhs.cur_end_);
+		mystl::swap(next_nodes_, rhs.next_nodes_);
+	}
+
+private:
+	void reset() noexcept
+	{
+		free_ = nullptr;
+		slabs_ = nullptr;
+		cur_ = nullptr;
+		cur_end_ = nullptr;
+		next_nodes_ = kMinSlabNodes;
+	}
+
+	// 申请一个能容纳 n 个节点的 slab, 当前 slab 剩余的节点放入空闲链表
+	void add_slab(size_type n)
+	{
+		const size_t bytes = sizeof(slab_header) + kAlign + n * kNodeSize;
+		unsigned char* raw = byte_allocator::allocate(bytes);
+		slab_header* header = reinterpret_cast<slab_header*>(raw);
+		header->next = slabs_;
+		header->bytes = bytes;
+		slabs_ = header;
+
+		while (cur_ != cur_end_)
+		{
+			deallocate(cur_);
+			cur_ += kNodeSize;
+		}
+		const uintptr_t addr = reinterpret_cast<uintptr_t>(raw + sizeof(slab_header));
+		cur_ = reinterpret_cast<unsigned char*>((addr + kAlign - 1) & ~static_cast<uintptr_t>(kAlign - 1));
+		cur_end_ = cur_ + n * kNodeSize;
+
+		if (next_nodes_ * kNodeSize < kMaxSlabBytes)
+			next_nodes_ *= 2;
+	}
+};
+
+template <size_t NodeSize, size_t NodeAlign>
+constexpr size_t fixed_size_pool<NodeSize, NodeAlign>::kAlign;
+template <size_t NodeSize, size_t NodeAlign>
+constexpr size_t fixed_size_pool<NodeSize, NodeAlign>::kNodeSize;
+template <size_t NodeSize, size_t NodeAlign>
+constexpr size_t fixed_size_pool<NodeSize, NodeAlign>::kMinSlabNodes;
+template <size_t NodeSize, size_t NodeAlign>
+constexpr size_t fixed_size_pool<NodeSize, NodeAlign>::kMaxSlabBytes;
+
+// 模板类 node_pool
+// 以节点类型为参数的 fixed_size_pool, 分配与释放的都是 T* (只负责内存, 不构造对象)
+// 参数二可以指定比 alignof(T) 更严格的对齐, 例如按缓存行对齐
+template <class T, size_t Align = alignof(T)>
+class node_pool : public fixed_size_pool<sizeof(T), (Align > alignof(T) ? Align : alignof(T))>
+{
+	typedef fixed_size_pool<sizeof(T), (Align > alignof(T) ? Align : alignof(T))> base_type;
+
+public:
+	typedef T value_type;
+
+	node_pool() = default;
+	node_pool(node_pool&&) = default;
+	node_pool& operator=(node_pool&&) = default;
+
+	T* allocate()
+	{ return static_cast<T*>(base_type::allocate()); }
+
+	void deallocate(T* ptr) noexcept
+	{ base_type::deallocate(ptr); }
+
+	void swap(node_pool& rhs) noexcept
+	{ base_type::swap(rhs); }
+};
+
+// 模板类 shared_node_pool
+// 带引用计数的 node_pool 句柄, 复制句柄即共用同一个节点池, 最后一个句柄析构时归还所有 slab
+// 节点只能还给分配它的池, 所以共用一个池的容器之间才能直接转移节点(例如 list::splice)
+// 默认构造的句柄为空, 第一次 allocate 或 reserve 时才创建节点池(或用 create 直接创建); 引用计数不是原子的
+template <class T, size_t Align = alignof(T)>
+class shared_node_pool
+{
+private:
+	struct pool_rep
+	{
+		node_pool<T, Align> pool;
+		size_t              refs;
+	};
+	typedef mystl::allocator<pool_rep> rep_allocator;
+
+	pool_rep* rep_;
+
+public:
+	typedef T      value_type;
+	typedef size_t size_type;
+
+	// 构造、复制、移动、析构函数
+	shared_node_pool() noexcept
+		:rep_(nullptr)
+	{
+	}
+
+	shared_node_pool(const shared_node_pool& rhs) noexcept
+		:rep_(rhs.rep_)
+	{
+		if (rep_ != nullptr)
+			++rep_->refs;
+	}
+
+	shared_node_pool(shared_node_pool&& rhs) noexcept
+		:rep_(rhs.rep_)
+	{
+		rhs.rep_ = nullptr;
+	}
+
+	shared_node_pool& operator=(const shared_node_pool& rhs) noexcept
+	{
+		shared_node_pool tmp(rhs);
+		swap(tmp);
+		return *this;
+	}
+
+	shared_node_pool& operator=(shared_node_pool&& rhs) noexcept
+	{
+		shared_node_pool tmp(mystl::move(rhs));
+		swap(tmp);
+		return *this;
+	}
+
+	~shared_node_pool()
+	{
+		reset();
+	}
+
+	// 创建一个新的节点池并返回它的句柄
+	static shared_node_pool create()
+	{
+		shared_node_pool pool;
+		pool.get_rep();
+		return pool;
+	}
+
+	// 分配与释放节点
+	T* allocate()
+	{
+		return get_rep()->pool.allocate();
+	}
+
+	void deallocate(T* ptr) noexcept
+	{
+		if (rep_ != nullptr)
+			rep_->pool.deallocate(ptr);
+	}
+
+	// 保证接下来的 n 次 allocate 都不会再申请 slab
+	void reserve(size_type n)
+	{
+		if (n != 0)
+			get_rep()->pool.reserve(n);
+	}
+
+	// 放弃对节点池的引用, 句柄变为空
+	void reset() noexcept
+	{
+		if (rep_ != nullptr && --rep_->refs == 0)
+		{
+			rep_allocator::destroy(rep_);
+			rep_allocator::deallocate(rep_);
+		}
+		rep_ = nullptr;
+	}
+
+	bool      valid()     const noexcept { return rep_ != nullptr; }
+	size_type use_count() const noexcept { return rep_ == nullptr ? 0 : rep_->refs; }
+
+	void swap(shared_node_pool& rhs) noexcept
+	{
+		mystl::swap(rep_, rhs.rep_);
+	}
+
+	// 两个句柄指向同一个节点池时相等
+	friend bool operator==(const shared_node_pool& lhs, const shared_node_pool& rhs) noexcept
+	{
+		return lhs.rep_ == rhs.rep_;
+	}
+	friend bool operator!=(const shared_node_pool& lhs, const shared_node_pool& rhs) noexcept
+	{
+		return lhs.rep_ != rhs.rep_;
+	}
+
+private:
+	pool_rep* get_rep()
+	{
+		if (rep_ == nullptr)
+		{
+			pool_rep* rep = rep_allocator::allocate();
+			rep_allocator::construct(rep);
+			rep->refs = 1;
+			rep_ = rep;
+		}
+		return rep_;
+	}
+};
+
+// 重载 mystl 的 swap
+template <size_t NodeSize, size_t NodeAlign>
+void swap(fixed_size_pool<NodeSize, NodeAlign>& lhs,
+          fixed_size_pool<NodeSize, NodeAlign>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+template <class T, size_t Align>
+void swap(node_pool<T, Align>& lhs, node_pool<T, Align>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+template <class T, size_t Align>
+void swap(shared_node_pool<T, Align>& lhs, shared_node_pool<T, Align>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_NODE_POOL_H_
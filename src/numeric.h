@@ -0,0 +1,595 @@
+#ifndef MYTINYSTL_NUMERIC_H_
+#define MYTINYSTL_NUMERIC_H_
+
+// 这个头文件包含 mystl 的数值算法
+// accumulate, reduce, transform_reduce, inner_product, partial_sum, adjacent_difference, iota
+
+// notes:
+//
+// 对连续存储(is_contiguous_iterator)、元素类型与初值类型相同的 32/64 位整数与 float/double,
+// 使用默认运算的求和与点积改由 numeric_detail 中的向量化内核计算:
+//   * 数据量不小于 kAvx2MinBytes 且 CPU 支持 AVX2 时, 用 4 个 256 位累加器同时累加(运行时选择, 见 cpu_features.h)
+//   * 否则用 4 个标量累加器展开循环, 打断加法之间的依赖
+// 内核改变了加法的结合顺序. 整数按补码回绕, 结果与逐个相加相同, 所以总是使用内核;
+// 浮点数结果会有舍入差异, 因此只有允许重新结合的算法才使用:
+//   * reduce / transform_reduce: 标准本身不规定运算顺序, 总是使用内核
+//   * accumulate / inner_product: 规定从左到右计算, 定义 MYSTL_NUMERIC_REASSOCIATE 后才对浮点数使用内核
+// 并行的 reduce / transform_reduce / partial_sum 位于 parallel_algo.h, 各块同样使用这里的内核
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "cpu_features.h"
+#include "iterator.h"
+#include "util.h"
+
+#if defined(__AVX2__) || defined(MYSTL_HAS_TARGET_DISPATCH)
+#include <immintrin.h>
+#define MYSTL_NUMERIC_AVX2 1
+#endif
+
+namespace mystl
+{
+
+namespace numeric_detail
+{
+
+// 不小于此字节数时才使用 AVX2
+constexpr size_t kAvx2MinBytes = 256;
+
+#if defined(MYSTL_NUMERIC_REASSOCIATE)
+constexpr bool kReassociateFloat = true;
+#else
+constexpr bool kReassociateFloat = false;
+#endif
+
+// 内核支持的元素类型: 32/64 位整数(不含 bool)与 float/double
+template <class T>
+struct is_kernel_type : m_bool_constant<
+	(std::is_integral<T>::value && !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8)) ||
+	std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+// 内核中累加使用的类型: 整数使用对应的无符号类型, 溢出时按补码回绕
+template <class T, bool = std::is_integral<T>::value>
+struct acc_type
+{
+	typedef T type;
+};
+
+template <class T>
+struct acc_type<T, true>
+{
+	typedef typename std::make_unsigned<T>::type type;
+};
+
+// [first, last) 是否可以交给内核, 且内核的结果是否允许使用
+template <class Iter, class T, bool Reassociate>
+struct use_kernel : m_bool_constant<
+	is_contiguous_iterator<Iter>::value &&
+	std::is_same<typename std::remove_cv<typename iterator_traits<Iter>::value_type>::type, T>::value &&
+	is_kernel_type<T>::value &&
+	(std::is_integral<T>::value || Reassociate)> {};
+
+// 数据量为 bytes 时是否使用 AVX2
+inline bool use_avx2(size_t bytes) noexcept
+{
+#if defined(__AVX2__)
+	return bytes >= kAvx2MinBytes;
+#elif defined(MYSTL_HAS_TARGET_DISPATCH)
+	return bytes >= kAvx2MinBytes && get_cpu_features().avx2;
+#else
+	(void)bytes;
+	return false;
+#endif
+}
+
+// 标量版本: 4 个累加器展开
+template <class A>
+A sum_unrolled(const A* p, size_t n) noexcept
+{
+	A s0 = A(0), s1 = A(0), s2 = A(0), s3 = A(0);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		s0 += p[i];
+		s1 += p[i + 1];
+		s2 += p[i + 2];
+		s3 += p[i + 3];
+	}
+	for (; i < n; ++i)
+		s0 += p[i];
+	return (s0 + s1) + (s2 + s3);
+}
+
+template <class A>
+A dot_unrolled(const A* p, const A* q, size_t n) noexcept
+{
+	A s0 = A(0), s1 = A(0), s2 = A(0), s3 = A(0);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		s0 += p[i] * q[i];
+		s1 += p[i + 1] * q[i + 1];
+		s2 += p[i + 2] * q[i + 2];
+		s3 += p[i + 3] * q[i + 3];
+	}
+	for (; i < n; ++i)
+		s0 += p[i] * q[i];
+	return (s0 + s1) + (s2 + s3);
+}
+
+#if defined(MYSTL_NUMERIC_AVX2)
+
+// AVX2 版本: 主循环每次处理 4 个向量, 剩余部分交给标量版本
+
+MYSTL_TARGET_AVX2 inline float hsum(__m256 v) noexcept
+{
+	__m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+	x = _mm_add_ss(x, _mm_shuffle_ps(x, x, 1));
+	return _mm_cvtss_f32(x);
+}
+
+MYSTL_TARGET_AVX2 inline double hsum(__m256d v) noexcept
+{
+	__m128d x = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+	x = _mm_add_sd(x, _mm_unpackhi_pd(x, x));
+	return _mm_cvtsd_f64(x);
+}
+
+MYSTL_TARGET_AVX2 inline uint32_t hsum_epi32(__m256i v) noexcept
+{
+	__m128i x = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0x4e));
+	x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0xb1));
+	return static_cast<uint32_t>(_mm_cvtsi128_si32(x));
+}
+
+MYSTL_TARGET_AVX2 inline uint64_t hsum_epi64(__m256i v) noexcept
+{
+	__m128i x = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	x = _mm_add_epi64(x, _mm_unpackhi_epi64(x, x));
+	uint64_t r;
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&r), x);
+	return r;
+}
+
+MYSTL_TARGET_AVX2 inline float sum_avx2(const float* p, size_t n) noexcept
+{
+	__m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+	size_t i = 0;
+	for (; i + 32 <= n; i += 32)
+	{
+		a0 = _mm256_add_ps(a0, _mm256_loadu_ps(p + i));
+		a1 = _mm256_add_ps(a1, _mm256_loadu_ps(p + i + 8));
+		a2 = _mm256_add_ps(a2, _mm256_loadu_ps(p + i + 16));
+		a3 = _mm256_add_ps(a3, _mm256_loadu_ps(p + i + 24));
+	}
+	for (; i + 8 <= n; i += 8)
+		a0 = _mm256_add_ps(a0, _mm256_loadu_ps(p + i));
+	return hsum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3))) +
+		sum_unrolled(p + i, n - i);
+}
+
+MYSTL_TARGET_AVX2 inline double sum_avx2(const double* p, size_t n) noexcept
+{
+	__m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+		a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+		a2 = _mm256_add_pd(a2, _mm256_loadu_pd(p + i + 8));
+		a3 = _mm256_add_pd(a3, _mm256_loadu_pd(p + i + 12));
+	}
+	for (; i + 4 <= n; i += 4)
+		a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+	return hsum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3))) +
+		sum_unrolled(p + i, n - i);
+}
+
+// 整数按 32 位或 64 位分别处理, U 为对应的无符号类型
+template <class U>
+MYSTL_TARGET_AVX2 U sum_avx2_int(const U* p, size_t n, std::integral_constant<size_t, 4>) noexcept
+{
+	__m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+	size_t i = 0;
+	for (; i + 32 <= n; i += 32)
+	{
+		a0 = _mm256_add_epi32(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+		a1 = _mm256_add_epi32(a1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)));
+		a2 = _mm256_add_epi32(a2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 16)));
+		a3 = _mm256_add_epi32(a3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 24)));
+	}
+	for (; i + 8 <= n; i += 8)
+		a0 = _mm256_add_epi32(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	return static_cast<U>(hsum_epi32(_mm256_add_epi32(_mm256_add_epi32(a0, a1),
+	                                                  _mm256_add_epi32(a2, a3))) +
+		sum_unrolled(p + i, n - i));
+}
+
+template <class U>
+MYSTL_TARGET_AVX2 U sum_avx2_int(const U* p, size_t n, std::integral_constant<size_t, 8>) noexcept
+{
+	__m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		a0 = _mm256_add_epi64(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+		a1 = _mm256_add_epi64(a1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 4)));
+		a2 = _mm256_add_epi64(a2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)));
+		a3 = _mm256_add_epi64(a3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 12)));
+	}
+	for (; i + 4 <= n; i += 4)
+		a0 = _mm256_add_epi64(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	return static_cast<U>(hsum_epi64(_mm256_add_epi64(_mm256_add_epi64(a0, a1),
+	                                                  _mm256_add_epi64(a2, a3))) +
+		sum_unrolled(p + i, n - i));
+}
+
+template <class U>
+MYSTL_TARGET_AVX2 U sum_avx2(const U* p, size_t n) noexcept
+{
+	return numeric_detail::sum_avx2_int(p, n, std::integral_constant<size_t, sizeof(U)>());
+}
+
+MYSTL_TARGET_AVX2 inline float dot_avx2(const float* p, const float* q, size_t n) noexcept
+{
+	__m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+	size_t i = 0;
+	for (; i + 32 <= n; i += 32)
+	{
+		a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_loadu_ps(p + i), _mm256_loadu_ps(q + i)));
+		a1 = _mm256_add_ps(a1, _mm256_mul_ps(_mm256_loadu_ps(p + i + 8), _mm256_loadu_ps(q + i + 8)));
+		a2 = _mm256_add_ps(a2, _mm256_mul_ps(_mm256_loadu_ps(p + i + 16), _mm256_loadu_ps(q + i + 16)));
+		a3 = _mm256_add_ps(a3, _mm256_mul_ps(_mm256_loadu_ps(p + i + 24), _mm256_loadu_ps(q + i + 24)));
+	}
+	for (; i + 8 <= n; i += 8)
+		a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_loadu_ps(p + i), _mm256_loadu_ps(q + i)));
+	return hsum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3))) +
+		dot_unrolled(p + i, q + i, n - i);
+}
+
+MYSTL_TARGET_AVX2 inline double dot_avx2(const double* p, const double* q, size_t n) noexcept
+{
+	__m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(p + i), _mm256_loadu_pd(q + i)));
+		a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(p + i + 4), _mm256_loadu_pd(q + i + 4)));
+		a2 = _mm256_add_pd(a2, _mm256_mul_pd(_mm256_loadu_pd(p + i + 8), _mm256_loadu_pd(q + i + 8)));
+		a3 = _mm256_add_pd(a3, _mm256_mul_pd(_mm256_loadu_pd(p + i + 12), _mm256_loadu_pd(q + i + 12)));
+	}
+	for (; i + 4 <= n; i += 4)
+		a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(p + i), _mm256_loadu_pd(q + i)));
+	return hsum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3))) +
+		dot_unrolled(p + i, q + i, n - i);
+}
+
+// 32 位整数的乘法取低 32 位(vpmulld); AVX2 没有 64 位整数乘法, 64 位整数只用标量版本
+template <class U>
+MYSTL_TARGET_AVX2 U dot_avx2_int(const U* p, const U* q, size_t n,
+                                 std::integral_constant<size_t, 4>) noexcept
+{
+	__m256i a0 = _mm256_setzero_si256(), a1 = a0;
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		a0 = _mm256_add_epi32(a0, _mm256_mullo_epi32(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i))));
+		a1 = _mm256_add_epi32(a1, _mm256_mullo_epi32(
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i + 8))));
+	}
+	return static_cast<U>(hsum_epi32(_mm256_add_epi32(a0, a1)) + dot_unrolled(p + i, q + i, n - i));
+}
+
+template <class U>
+U dot_avx2_int(const U* p, const U* q, size_t n, std::integral_constant<size_t, 8>) noexcept
+{
+	return numeric_detail::dot_unrolled(p, q, n);
+}
+
+template <class U>
+MYSTL_TARGET_AVX2 U dot_avx2(const U* p, const U* q, size_t n) noexcept
+{
+	return numeric_detail::dot_avx2_int(p, q, n, std::integral_constant<size_t, sizeof(U)>());
+}
+
+#endif // MYSTL_NUMERIC_AVX2
+
+// p[0, n) 的和
+template <class T>
+T sum(const T* p, size_t n) noexcept
+{
+	typedef typename acc_type<T>::type A;
+	const A* a = reinterpret_cast<const A*>(p);
+#if defined(MYSTL_NUMERIC_AVX2)
+	if (use_avx2(n * sizeof(T)))
+		return static_cast<T>(numeric_detail::sum_avx2(a, n));
+#endif
+	return static_cast<T>(numeric_detail::sum_unrolled(a, n));
+}
+
+// p[0, n) 与 q[0, n) 的点积
+template <class T>
+T dot(const T* p, const T* q, size_t n) noexcept
+{
+	typedef typename acc_type<T>::type A;
+	const A* a = reinterpret_cast<const A*>(p);
+	const A* b = reinterpret_cast<const A*>(q);
+#if defined(MYSTL_NUMERIC_AVX2)
+	if (use_avx2(n * sizeof(T)))
+		return static_cast<T>(numeric_detail::dot_avx2(a, b, n));
+#endif
+	return static_cast<T>(numeric_detail::dot_unrolled(a, b, n));
+}
+
+template <class T>
+T add(T init, T value, m_false_type) noexcept
+{
+	return init + value;
+}
+
+// 整数以无符号类型相加, 与内核一样按补码回绕
+template <class T>
+T add(T init, T value, m_true_type) noexcept
+{
+	typedef typename std::make_unsigned<T>::type U;
+	return static_cast<T>(static_cast<U>(init) + static_cast<U>(value));
+}
+
+template <class T>
+T add(T init, T value) noexcept
+{
+	return numeric_detail::add(init, value, m_bool_constant<std::is_integral<T>::value>());
+}
+
+// 默认运算的求和, 可以使用内核时使用
+template <class InputIter, class T>
+T sum_dispatch(InputIter first, InputIter last, T init, m_false_type)
+{
+	for (; first != last; ++first)
+		init = mystl::move(init) + *first;
+	return init;
+}
+
+template <class ContiguousIter, class T>
+T sum_dispatch(ContiguousIter first, ContiguousIter last, T init, m_true_type)
+{
+	const size_t n = static_cast<size_t>(last - first);
+	if (n == 0)
+		return init;
+	return numeric_detail::add(init, numeric_detail::sum(&*first, n));
+}
+
+// 默认运算的点积, 可以使用内核时使用
+template <class InputIter1, class InputIter2, class T>
+T dot_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, m_false_type)
+{
+	for (; first1 != last1; ++first1, ++first2)
+		init = mystl::move(init) + *first1 * *first2;
+	return init;
+}
+
+template <class ContiguousIter1, class ContiguousIter2, class T>
+T dot_dispatch(ContiguousIter1 first1, ContiguousIter1 last1, ContiguousIter2 first2, T init,
+               m_true_type)
+{
+	const size_t n = static_cast<size_t>(last1 - first1);
+	if (n == 0)
+		return init;
+	return numeric_detail::add(init, numeric_detail::dot(&*first1, &*first2, n));
+}
+
+} // namespace numeric_detail
+
+/*****************************************************************************************/
+// accumulate
+// 版本1：以初值 init 对每个元素进行累加
+// 版本2：以初值 init 对每个元素进行二元操作
+/*****************************************************************************************/
+// 版本1
+template <class InputIter, class T>
+T accumulate(InputIter first, InputIter last, T init)
+{
+	return numeric_detail::sum_dispatch(first, last, init,
+		numeric_detail::use_kernel<InputIter, T, numeric_detail::kReassociateFloat>());
+}
+
+// 版本2
+template <class InputIter, class T, class BinaryOp>
+T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op)
+{
+	for (; first != last; ++first)
+		init = binary_op(mystl::move(init), *first);
+	return init;
+}
+
+/*****************************************************************************************/
+// reduce
+// 与 accumulate 相同, 但不规定运算顺序, binary_op 需满足结合律与交换律
+// 版本1：以 value_type() 为初值求和
+// 版本2：以 init 为初值求和
+// 版本3：以 init 为初值, 以 binary_op 归约
+/*****************************************************************************************/
+// 版本1
+template <class InputIter>
+typename iterator_traits<InputIter>::value_type
+reduce(InputIter first, InputIter last)
+{
+	typedef typename iterator_traits<InputIter>::value_type value_type;
+	return numeric_detail::sum_dispatch(first, last, value_type(),
+		numeric_detail::use_kernel<InputIter, value_type, true>());
+}
+
+// 版本2
+template <class InputIter, class T>
+T reduce(InputIter first, InputIter last, T init)
+{
+	return numeric_detail::sum_dispatch(first, last, init,
+		numeric_detail::use_kernel<InputIter, T, true>());
+}
+
+// 版本3
+template <class InputIter, class T, class BinaryOp>
+T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op)
+{
+	for (; first != last; ++first)
+		init = binary_op(mystl::move(init), *first);
+	return init;
+}
+
+/*****************************************************************************************/
+// transform_reduce
+// 版本1：对两个序列对应元素的乘积求和, 以 init 为初值
+// 版本2：以 transform_op 合并两个序列的对应元素, 再以 reduce_op 归约
+// 版本3：以 transform_op 变换每个元素, 再以 reduce_op 归约
+/*****************************************************************************************/
+// 版本1
+template <class InputIter1, class InputIter2, class T>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+{
+	return numeric_detail::dot_dispatch(first1, last1, first2, init, m_bool_constant<
+		numeric_detail::use_kernel<InputIter1, T, true>::value &&
+		numeric_detail::use_kernel<InputIter2, T, true>::value>());
+}
+
+// 版本2
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                   BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+	for (; first1 != last1; ++first1, ++first2)
+		init = reduce_op(mystl::move(init), transform_op(*first1, *first2));
+	return init;
+}
+
+// 版本3
+template <class InputIter, class T, class BinaryOp, class UnaryOp>
+T transform_reduce(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op)
+{
+	for (; first != last; ++first)
+		init = reduce_op(mystl::move(init), transform_op(*first));
+	return init;
+}
+
+/*****************************************************************************************/
+// inner_product
+// 版本1：以 init 为初值，计算两个区间的内积
+// 版本2：自定义 operator+ 和 operator*
+/*****************************************************************************************/
+// 版本1
+template <class InputIter1, class InputIter2, class T>
+T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+{
+	return numeric_detail::dot_dispatch(first1, last1, first2, init, m_bool_constant<
+		numeric_detail::use_kernel<InputIter1, T, numeric_detail::kReassociateFloat>::value &&
+		numeric_detail::use_kernel<InputIter2, T, numeric_detail::kReassociateFloat>::value>());
+}
+
+// 版本2
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                BinaryOp1 binary_op1, BinaryOp2 binary_op2)
+{
+	for (; first1 != last1; ++first1, ++first2)
+		init = binary_op1(mystl::move(init), binary_op2(*first1, *first2));
+	return init;
+}
+
+/*****************************************************************************************/
+// iota
+// 填充[first, last)，以 value 为初值开始递增
+/*****************************************************************************************/
+template <class ForwardIter, class T>
+void iota(ForwardIter first, ForwardIter last, T value)
+{
+	for (; first != last; ++first)
+	{
+		*first = value;
+		++value;
+	}
+}
+
+/*****************************************************************************************/
+// partial_sum
+// 版本1：计算局部累计求和，结果保存到以 result 为起始的位置上
+// 版本2：进行局部进行自定义二元操作
+/*****************************************************************************************/
+template <class InputIter, class OutputIter>
+OutputIter partial_sum(InputIter first, InputIter last, OutputIter result)
+{
+	if (first == last)
+		return result;
+	typename iterator_traits<InputIter>::value_type value = *first;
+	*result = value;
+	while (++first != last)
+	{
+		value = mystl::move(value) + *first;
+		*++result = value;
+	}
+	return ++result;
+}
+
+// 版本2
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter partial_sum(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op)
+{
+	if (first == last)
+		return result;
+	typename iterator_traits<InputIter>::value_type value = *first;
+	*result = value;
+	while (++first != last)
+	{
+		value = binary_op(mystl::move(value), *first);
+		*++result = value;
+	}
+	return ++result;
+}
+
+/*****************************************************************************************/
+// adjacent_difference
+// 版本1：计算相邻元素的差值，结果保存到以 result 为起始的位置上
+// 版本2：自定义相邻元素的二元操作
+/*****************************************************************************************/
+// 版本1
+template <class InputIter, class OutputIter>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result)
+{
+	if (first == last)
+		return result;
+	typename iterator_traits<InputIter>::value_type prev = *first;
+	*result = prev;
+	while (++first != last)
+	{
+		// 先取出当前元素, 以支持 result 与 first 指向同一位置
+		typename iterator_traits<InputIter>::value_type value = *first;
+		*++result = value - prev;
+		prev = mystl::move(value);
+	}
+	return ++result;
+}
+
+// 版本2
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op)
+{
+	if (first == last)
+		return result;
+	typename iterator_traits<InputIter>::value_type prev = *first;
+	*result = prev;
+	while (++first != last)
+	{
+		typename iterator_traits<InputIter>::value_type value = *first;
+		*++result = binary_op(value, prev);
+		prev = mystl::move(value);
+	}
+	return ++result;
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_NUMERIC_H_
@@ -0,0 +1,776 @@
+#ifndef MYTINYSTL_PACKED_VECTOR_H_
+#define MYTINYSTL_PACKED_VECTOR_H_
+
+// 这个头文件包含两个按位压缩存放无符号整数的模板类
+// packed_vector        : 每个元素固定占 Bits 位, 可随机读写
+// sorted_packed_vector : 用于有序序列, 分块存放与块首元素的差值(frame of reference), 只能在尾部增删
+
+// notes:
+//
+// 压缩后的位串存放在 mystl::vector<uint64_t> 中, 通过它使用 mystl::allocator 增长
+// 第 i 个元素位于位串的第 i * Bits 位起, 可能跨越两个字; 位串中最后一个元素之后的位始终为 0
+// decode(first, n, out) 批量解码:
+//   * 宽度不超过 kMaxSimdWidth 且 CPU 支持 AVX2 时, 每次解码 8 个元素: 8 个元素恰好占 width 字节,
+//     用 vpshufb 把每个元素所在的 4 个字节移到各自的 32 位通道, 再用 vpsrlvd 移位、与掩码相与
+//   * 其余情况逐个读取
+// sorted_packed_vector 每 kBlockSize 个元素为一块, 块中元素与块首元素的差用该块所需的最小宽度存放,
+// 所以读取仍是 O(1); 最后一个未满的块不压缩, 满了之后再压缩
+//
+// 异常保证：
+// mystl::packed_vector<Bits> 与 mystl::sorted_packed_vector<T> 的 push_back 满足强异常安全保证
+
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_features.h"
+#include "iterator.h"
+#include "vector.h"
+#include "exceptdef.h"
+#include "util.h"
+
+#if defined(__AVX2__) || defined(MYSTL_HAS_TARGET_DISPATCH)
+#include <immintrin.h>
+#define MYSTL_PACKED_AVX2 1
+#endif
+
+namespace mystl
+{
+
+namespace packed_detail
+{
+
+// 可以使用 AVX2 解码的最大宽度: 元素在字节内的偏移(至多 7)加上宽度不能超过 32
+constexpr unsigned kMaxSimdWidth = 25;
+
+// 低 width 位为 1 的掩码, width 可以为 0 到 64
+constexpr uint64_t low_mask(unsigned width) noexcept
+{
+	return width >= 64 ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << width) - 1);
+}
+
+// 表示 x 所需的位数, x 为 0 时返回 0
+inline unsigned bit_width(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return x == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(x));
+#else
+	unsigned r = 0;
+	for (; x != 0; x >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+// 读取从第 off 位起的 width 位
+inline uint64_t read_bits(const uint64_t* w, uint64_t off, unsigned width) noexcept
+{
+	if (width == 0)
+		return 0;
+	const size_t i = static_cast<size_t>(off / 64);
+	const unsigned s = static_cast<unsigned>(off % 64);
+	uint64_t v = w[i] >> s;
+	if (s + width > 64)
+		v |= w[i + 1] << (64 - s);
+	return v & low_mask(width);
+}
+
+// 把从第 off 位起的 width 位改为 v, v 的高位必须为 0
+inline void write_bits(uint64_t* w, uint64_t off, unsigned width, uint64_t v) noexcept
+{
+	if (width == 0)
+		return;
+	const size_t i = static_cast<size_t>(off / 64);
+	const unsigned s = static_cast<unsigned>(off % 64);
+	const uint64_t mask = low_mask(width);
+	w[i] = (w[i] & ~(mask << s)) | (v << s);
+	if (s + width > 64)
+	{
+		const unsigned r = 64 - s;
+		w[i + 1] = (w[i + 1] & ~(mask >> r)) | (v >> r);
+	}
+}
+
+inline bool has_avx2() noexcept
+{
+#if defined(__AVX2__)
+	return true;
+#elif defined(MYSTL_HAS_TARGET_DISPATCH)
+	return get_cpu_features().avx2;
+#else
+	return false;
+#endif
+}
+
+#if defined(MYSTL_PACKED_AVX2)
+
+// 把 8 个 32 位的值加上 base 后写到 out
+MYSTL_TARGET_AVX2 inline void store8(uint32_t* out, __m256i v, uint64_t base) noexcept
+{
+	v = _mm256_add_epi32(v, _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(base))));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+}
+
+MYSTL_TARGET_AVX2 inline void store8(uint64_t* out, __m256i v, uint64_t base) noexcept
+{
+	const __m256i b = _mm256_set1_epi64x(static_cast<long long>(base));
+	const __m256i lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v));
+	const __m256i hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi64(lo, b));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4), _mm256_add_epi64(hi, b));
+}
+
+template <class Out>
+MYSTL_TARGET_AVX2 void store8(Out* out, __m256i v, uint64_t base) noexcept
+{
+	alignas(32) uint32_t tmp[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(tmp), v);
+	for (int k = 0; k < 8; ++k)
+		out[k] = static_cast<Out>(base + tmp[k]);
+}
+
+// 从 bytes 的第 pos 字节起解码宽度为 width 的元素, 每次 8 个, 不读取第 nbytes 字节及之后的内容
+// 返回已解码的个数(8 的倍数)
+template <class Out>
+MYSTL_TARGET_AVX2 size_t unpack_avx2(const unsigned char* bytes, size_t nbytes, size_t pos,
+                                     unsigned width, size_t n, Out* out, uint64_t base) noexcept
+{
+	// 高 128 位通道从第 hb 字节起加载, 使两个通道中的索引都不超过 15
+	const size_t hb = (4 * width) >> 3;
+	alignas(32) unsigned char shuf[32];
+	alignas(32) uint32_t shift[8];
+	for (unsigned k = 0; k < 8; ++k)
+	{
+		size_t b = (k * width) >> 3;
+		if (k >= 4)
+			b -= hb;
+		for (unsigned j = 0; j < 4; ++j)
+			shuf[4 * k + j] = static_cast<unsigned char>(b + j);
+		shift[k] = (k * width) & 7;
+	}
+	const __m256i vshuf = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuf));
+	const __m256i vshift = _mm256_load_si256(reinterpret_cast<const __m256i*>(shift));
+	const __m256i vmask = _mm256_set1_epi32(static_cast<int>(low_mask(width)));
+
+	size_t done = 0;
+	while (n - done >= 8 && pos + hb + 16 <= nbytes)
+	{
+		const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos));
+		const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos + hb));
+		__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		v = _mm256_shuffle_epi8(v, vshuf);
+		v = _mm256_and_si256(_mm256_srlv_epi32(v, vshift), vmask);
+		store8(out + done, v, base);
+		done += 8;
+		pos += width;
+	}
+	return done;
+}
+
+#endif // MYSTL_PACKED_AVX2
+
+// 从位串 w(共 nwords 个字)的第 off 位起解码 n 个宽度为 width 的元素, 加上 base 后写到 out
+template <class Out>
+void unpack(const uint64_t* w, size_t nwords, uint64_t off, unsigned width,
+            size_t n, Out* out, uint64_t base) noexcept
+{
+	if (width == 0)
+	{
+		for (size_t k = 0; k < n; ++k)
+			out[k] = static_cast<Out>(base);
+		return;
+	}
+#if defined(MYSTL_PACKED_AVX2)
+	if (width <= kMaxSimdWidth && n >= 16 && has_avx2())
+	{
+		// 先逐个解码到字节边界, 最多 8 个
+		for (unsigned k = 0; k < 8 && off % 8 != 0; ++k, ++out, --n, off += width)
+			*out = static_cast<Out>(base + read_bits(w, off, width));
+		if (off % 8 == 0)
+		{
+			const size_t done = unpack_avx2(reinterpret_cast<const unsigned char*>(w), nwords * 8,
+			                                static_cast<size_t>(off / 8), width, n, out, base);
+			out += done;
+			n -= done;
+			off += static_cast<uint64_t>(done) * width;
+		}
+	}
+#else
+	(void)nwords;
+#endif
+	for (size_t k = 0; k < n; ++k, off += width)
+		out[k] = static_cast<Out>(base + read_bits(w, off, width));
+}
+
+} // namespace packed_detail
+
+/*****************************************************************************************/
+// packed_vector
+// 模板参数 Bits 代表每个元素的位数
+/*****************************************************************************************/
+
+template <unsigned Bits>
+class packed_vector
+{
+	static_assert(Bits >= 1 && Bits <= 64, "packed_vector's Bits must be in [1, 64]");
+
+public:
+	typedef typename std::conditional<Bits <= 32, uint32_t, uint64_t>::type value_type;
+	typedef size_t                                                         size_type;
+	typedef ptrdiff_t                                                      difference_type;
+
+	static constexpr unsigned   kBits = Bits;
+	static constexpr value_type kMaxValue = static_cast<value_type>(packed_detail::low_mask(Bits));
+
+	// 单个元素的引用, 用于非 const 的 operator[]
+	class reference
+	{
+	private:
+		uint64_t* w_;
+		uint64_t  off_;
+
+	public:
+		reference(uint64_t* w, uint64_t off) noexcept :w_(w), off_(off) {}
+		reference(const reference&) = default;
+
+		reference& operator=(value_type v) noexcept
+		{
+			MYSTL_DEBUG(v <= kMaxValue);
+			packed_detail::write_bits(w_, off_, Bits, v & kMaxValue);
+			return *this;
+		}
+
+		reference& operator=(const reference& rhs) noexcept
+		{
+			return *this = static_cast<value_type>(rhs);
+		}
+
+		operator value_type() const noexcept
+		{
+			return static_cast<value_type>(packed_detail::read_bits(w_, off_, Bits));
+		}
+	};
+
+	// 只读的随机访问迭代器, 解引用得到元素的值
+	class const_iterator : public mystl::iterator<random_access_iterator_tag, value_type,
+	                                              difference_type, const value_type*, value_type>
+	{
+	private:
+		const packed_vector* v_;
+		size_type            i_;
+
+	public:
+		const_iterator() noexcept :v_(nullptr), i_(0) {}
+		const_iterator(const packed_vector* v, size_type i) noexcept :v_(v), i_(i) {}
+
+		value_type operator*() const noexcept { return (*v_)[i_]; }
+		value_type operator[](difference_type n) const noexcept { return (*v_)[i_ + n]; }
+
+		const_iterator& operator++() noexcept { ++i_; return *this; }
+		const_iterator& operator--() noexcept { --i_; return *this; }
+		const_iterator  operator++(int) noexcept { const_iterator tmp = *this; ++i_; return tmp; }
+		const_iterator  operator--(int) noexcept { const_iterator tmp = *this; --i_; return tmp; }
+
+		const_iterator& operator+=(difference_type n) noexcept { i_ += n; return *this; }
+		const_iterator& operator-=(difference_type n) noexcept { i_ -= n; return *this; }
+		const_iterator  operator+(difference_type n) const noexcept { return const_iterator(v_, i_ + n); }
+		const_iterator  operator-(difference_type n) const noexcept { return const_iterator(v_, i_ - n); }
+		friend const_iterator operator+(difference_type n, const const_iterator& it) noexcept
+		{ return it + n; }
+		difference_type operator-(const const_iterator& rhs) const noexcept
+		{ return static_cast<difference_type>(i_) - static_cast<difference_type>(rhs.i_); }
+
+		bool operator==(const const_iterator& rhs) const noexcept { return i_ == rhs.i_; }
+		bool operator!=(const const_iterator& rhs) const noexcept { return i_ != rhs.i_; }
+		bool operator< (const const_iterator& rhs) const noexcept { return i_ <  rhs.i_; }
+		bool operator> (const const_iterator& rhs) const noexcept { return i_ >  rhs.i_; }
+		bool operator<=(const const_iterator& rhs) const noexcept { return i_ <= rhs.i_; }
+		bool operator>=(const const_iterator& rhs) const noexcept { return i_ >= rhs.i_; }
+	};
+
+	typedef const_iterator iterator;
+
+private:
+	mystl::vector<uint64_t> words_;
+	size_type               size_;
+
+public:
+	// 构造、复制、移动、析构函数
+	packed_vector() noexcept
+		:size_(0)
+	{
+	}
+
+	explicit packed_vector(size_type n, value_type value = 0)
+		:size_(0)
+	{
+		resize(n, value);
+	}
+
+	packed_vector(std::initializer_list<value_type> ilist)
+		:size_(0)
+	{
+		reserve(ilist.size());
+		for (auto v : ilist)
+			push_back(v);
+	}
+
+	packed_vector(const packed_vector&) = default;
+	packed_vector& operator=(const packed_vector&) = default;
+
+	packed_vector(packed_vector&& rhs) noexcept
+		:words_(mystl::move(rhs.words_)), size_(rhs.size_)
+	{
+		rhs.size_ = 0;
+	}
+
+	packed_vector& operator=(packed_vector&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			words_ = mystl::move(rhs.words_);
+			size_ = rhs.size_;
+			rhs.size_ = 0;
+		}
+		return *this;
+	}
+
+	// 迭代器相关操作
+	const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+	const_iterator end()    const noexcept { return const_iterator(this, size_); }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend()   const noexcept { return end(); }
+
+	// 容量相关操作
+	bool      empty()    const noexcept { return size_ == 0; }
+	size_type size()     const noexcept { return size_; }
+	size_type capacity() const noexcept { return words_.capacity() * 64 / Bits; }
+
+	void reserve(size_type n)
+	{ words_.reserve(words_for(n)); }
+
+	void shrink_to_fit()
+	{ words_.shrink_to_fit(); }
+
+	// 访问元素相关操作
+	value_type operator[](size_type n) const noexcept
+	{
+		MYSTL_DEBUG(n < size_);
+		return get(n);
+	}
+
+	reference operator[](size_type n) noexcept
+	{
+		MYSTL_DEBUG(n < size_);
+		return reference(words_.data(), static_cast<uint64_t>(n) * Bits);
+	}
+
+	value_type at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size_), "packed_vector<Bits>::at() subscript out of range");
+		return get(n);
+	}
+
+	value_type front() const noexcept
+	{
+		MYSTL_DEBUG(!empty());
+		return get(0);
+	}
+
+	value_type back() const noexcept
+	{
+		MYSTL_DEBUG(!empty());
+		return get(size_ - 1);
+	}
+
+	value_type get(size_type n) const noexcept
+	{
+		return static_cast<value_type>(
+			packed_detail::read_bits(words_.data(), static_cast<uint64_t>(n) * Bits, Bits));
+	}
+
+	void set(size_type n, value_type value) noexcept
+	{
+		MYSTL_DEBUG(n < size_ && value <= kMaxValue);
+		packed_detail::write_bits(words_.data(), static_cast<uint64_t>(n) * Bits, Bits, value & kMaxValue);
+	}
+
+	// 把 [first, first + n) 的元素解码到 out
+	void decode(size_type first, size_type n, value_type* out) const
+	{
+		THROW_OUT_OF_RANGE_IF(first > size_ || n > size_ - first,
+		                      "packed_vector<Bits>::decode's range out of range");
+		packed_detail::unpack(words_.data(), words_.size(), static_cast<uint64_t>(first) * Bits,
+		                      Bits, n, out, 0);
+	}
+
+	// 压缩后的位串
+	const uint64_t* data()      const noexcept { return words_.data(); }
+	size_type       num_words() const noexcept { return words_.size(); }
+
+	// 修改容器相关操作
+	void push_back(value_type value)
+	{
+		MYSTL_DEBUG(value <= kMaxValue);
+		const size_type need = words_for(size_ + 1);
+		if (need > words_.size())
+			words_.push_back(0);
+		packed_detail::write_bits(words_.data(), static_cast<uint64_t>(size_) * Bits, Bits, value & kMaxValue);
+		++size_;
+	}
+
+	void pop_back() noexcept
+	{
+		MYSTL_DEBUG(!empty());
+		--size_;
+		packed_detail::write_bits(words_.data(), static_cast<uint64_t>(size_) * Bits, Bits, 0);
+		if (words_for(size_) < words_.size())
+			words_.pop_back();
+	}
+
+	void resize(size_type n, value_type value = 0);
+
+	void clear() noexcept
+	{
+		words_.clear();
+		size_ = 0;
+	}
+
+	void swap(packed_vector& rhs) noexcept
+	{
+		words_.swap(rhs.words_);
+		mystl::swap(size_, rhs.size_);
+	}
+
+	bool operator==(const packed_vector& rhs) const noexcept
+	{
+		return size_ == rhs.size_ &&
+		       (size_ == 0 || std::memcmp(words_.data(), rhs.words_.data(), words_.size() * 8) == 0);
+	}
+
+	bool operator!=(const packed_vector& rhs) const noexcept
+	{ return !(*this == rhs); }
+
+private:
+	static size_type words_for(size_type n) noexcept
+	{ return static_cast<size_type>((static_cast<uint64_t>(n) * Bits + 63) / 64); }
+};
+
+template <unsigned Bits>
+constexpr unsigned packed_vector<Bits>::kBits;
+template <unsigned Bits>
+constexpr typename packed_vector<Bits>::value_type packed_vector<Bits>::kMaxValue;
+
+// 改变元素个数, 新增的元素为 value
+template <unsigned Bits>
+void packed_vector<Bits>::resize(size_type n, value_type value)
+{
+	MYSTL_DEBUG(value <= kMaxValue);
+	if (n <= size_)
+	{
+		words_.resize(words_for(n));
+		const unsigned rem = static_cast<unsigned>(static_cast<uint64_t>(n) * Bits % 64);
+		if (rem != 0)
+			words_.back() &= packed_detail::low_mask(rem);
+		size_ = n;
+		return;
+	}
+	words_.resize(words_for(n), 0);
+	if (value != 0)
+	{
+		value &= kMaxValue;
+		for (size_type i = size_; i < n; ++i)
+			packed_detail::write_bits(words_.data(), static_cast<uint64_t>(i) * Bits, Bits, value);
+	}
+	size_ = n;
+}
+
+// 重载 mystl 的 swap
+template <unsigned Bits>
+void swap(packed_vector<Bits>& lhs, packed_vector<Bits>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// sorted_packed_vector
+// 模板参数 T 代表元素的类型, 必须为无符号整数; 元素按非降序追加
+/*****************************************************************************************/
+
+template <class T = uint64_t>
+class sorted_packed_vector
+{
+	static_assert(std::is_unsigned<T>::value && !std::is_same<T, bool>::value,
+	              "sorted_packed_vector's T must be an unsigned integer type");
+
+public:
+	typedef T        value_type;
+	typedef size_t   size_type;
+	typedef ptrdiff_t difference_type;
+
+	static constexpr size_type kBlockSize = 128;
+
+private:
+	// 已压缩的块: 块首元素, 位串中的起始位置, 每个差值的宽度
+	struct block_header
+	{
+		T        base;
+		uint64_t offset;
+		unsigned width;
+	};
+
+	mystl::vector<uint64_t>     words_;
+	mystl::vector<block_header> blocks_;
+	mystl::vector<T>            tail_;    // 最后一个未满的块
+	uint64_t                    bits_;    // 位串中已使用的位数
+	size_type                   size_;
+
+public:
+	// 构造、复制、移动、析构函数
+	sorted_packed_vector() noexcept
+		:bits_(0), size_(0)
+	{
+	}
+
+	sorted_packed_vector(std::initializer_list<T> ilist)
+		:bits_(0), size_(0)
+	{
+		for (auto v : ilist)
+			push_back(v);
+	}
+
+	sorted_packed_vector(const sorted_packed_vector&) = default;
+	sorted_packed_vector& operator=(const sorted_packed_vector&) = default;
+
+	sorted_packed_vector(sorted_packed_vector&& rhs) noexcept
+		:words_(mystl::move(rhs.words_)), blocks_(mystl::move(rhs.blocks_)),
+		 tail_(mystl::move(rhs.tail_)), bits_(rhs.bits_), size_(rhs.size_)
+	{
+		rhs.bits_ = 0;
+		rhs.size_ = 0;
+	}
+
+	sorted_packed_vector& operator=(sorted_packed_vector&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			sorted_packed_vector tmp(mystl::move(rhs));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	// 容量相关操作
+	bool      empty() const noexcept { return size_ == 0; }
+	size_type size()  const noexcept { return size_; }
+
+	// 压缩部分占用的字节数, 不含未满的最后一块
+	size_type packed_bytes() const noexcept
+	{ return words_.size() * sizeof(uint64_t) + blocks_.size() * sizeof(block_header); }
+
+	// 访问元素相关操作
+	T operator[](size_type n) const noexcept
+	{
+		MYSTL_DEBUG(n < size_);
+		const size_type b = n / kBlockSize;
+		if (b == blocks_.size())
+			return tail_[n % kBlockSize];
+		const block_header& h = blocks_[b];
+		return static_cast<T>(h.base + packed_detail::read_bits(
+			words_.data(), h.offset + static_cast<uint64_t>(n % kBlockSize) * h.width, h.width));
+	}
+
+	T at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size_), "sorted_packed_vector<T>::at() subscript out of range");
+		return (*this)[n];
+	}
+
+	T front() const noexcept
+	{
+		MYSTL_DEBUG(!empty());
+		return blocks_.empty() ? tail_.front() : blocks_.front().base;
+	}
+
+	T back() const noexcept
+	{
+		MYSTL_DEBUG(!empty());
+		return tail_.empty() ? (*this)[size_ - 1] : tail_.back();
+	}
+
+	// 把 [first, first + n) 的元素解码到 out
+	void decode(size_type first, size_type n, T* out) const;
+
+	// 查找第一个不小于 value 的元素的位置, 不存在时返回 size()
+	size_type lower_bound(const T& value) const noexcept;
+
+	bool contains(const T& value) const noexcept
+	{
+		const size_type i = lower_bound(value);
+		return i != size_ && (*this)[i] == value;
+	}
+
+	// 修改容器相关操作
+	void push_back(const T& value);
+	void pop_back();
+
+	void clear() noexcept
+	{
+		words_.clear();
+		blocks_.clear();
+		tail_.clear();
+		bits_ = 0;
+		size_ = 0;
+	}
+
+	void swap(sorted_packed_vector& rhs) noexcept
+	{
+		words_.swap(rhs.words_);
+		blocks_.swap(rhs.blocks_);
+		tail_.swap(rhs.tail_);
+		mystl::swap(bits_, rhs.bits_);
+		mystl::swap(size_, rhs.size_);
+	}
+
+private:
+	void seal_tail();
+	void unseal_last();
+};
+
+template <class T>
+constexpr typename sorted_packed_vector<T>::size_type sorted_packed_vector<T>::kBlockSize;
+
+/*****************************************************************************************/
+
+template <class T>
+void sorted_packed_vector<T>::decode(size_type first, size_type n, T* out) const
+{
+	THROW_OUT_OF_RANGE_IF(first > size_ || n > size_ - first,
+	                      "sorted_packed_vector<T>::decode's range out of range");
+	while (n != 0)
+	{
+		const size_type b = first / kBlockSize;
+		const size_type j = first % kBlockSize;
+		const size_type cnt = mystl::min(n, kBlockSize - j);
+		if (b == blocks_.size())
+		{
+			std::memcpy(out, tail_.data() + j, cnt * sizeof(T));
+		}
+		else
+		{
+			const block_header& h = blocks_[b];
+			packed_detail::unpack(words_.data(), words_.size(), h.offset + static_cast<uint64_t>(j) * h.width,
+			                      h.width, cnt, out, h.base);
+		}
+		first += cnt;
+		out += cnt;
+		n -= cnt;
+	}
+}
+
+template <class T>
+typename sorted_packed_vector<T>::size_type
+sorted_packed_vector<T>::lower_bound(const T& value) const noexcept
+{
+	if (size_ == 0)
+		return 0;
+	// 先找最后一个块首元素小于 value 的块, 答案在这个块中或是下一块的块首
+	const size_type nblocks = blocks_.size() + (tail_.empty() ? 0 : 1);
+	size_type lo = 0, hi = nblocks;
+	while (lo < hi)
+	{
+		const size_type mid = lo + (hi - lo) / 2;
+		const T base = mid == blocks_.size() ? tail_.front() : blocks_[mid].base;
+		if (base < value)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == 0)
+		return 0;
+	size_type first = (lo - 1) * kBlockSize + 1;
+	size_type last = mystl::min(lo * kBlockSize, size_);
+	while (first < last)
+	{
+		const size_type mid = first + (last - first) / 2;
+		if ((*this)[mid] < value)
+			first = mid + 1;
+		else
+			last = mid;
+	}
+	return first;
+}
+
+template <class T>
+void sorted_packed_vector<T>::push_back(const T& value)
+{
+	MYSTL_DEBUG(empty() || !(value < back()));
+	tail_.push_back(value);
+	if (tail_.size() == kBlockSize)
+	{
+		MYSTL_TRY
+		{
+			seal_tail();
+		}
+		MYSTL_CATCH_ALL
+		{
+			tail_.pop_back();
+			MYSTL_RETHROW;
+		}
+	}
+	++size_;
+}
+
+template <class T>
+void sorted_packed_vector<T>::pop_back()
+{
+	MYSTL_DEBUG(!empty());
+	if (tail_.empty())
+		unseal_last();
+	tail_.pop_back();
+	--size_;
+}
+
+// 把已满的最后一块压缩到位串中
+template <class T>
+void sorted_packed_vector<T>::seal_tail()
+{
+	const T base = tail_.front();
+	const unsigned width = packed_detail::bit_width(static_cast<uint64_t>(tail_.back() - base));
+	const uint64_t end = bits_ + static_cast<uint64_t>(width) * kBlockSize;
+	// 先分配好空间, 之后的操作不会抛出异常
+	blocks_.reserve(blocks_.size() + 1);
+	words_.resize(static_cast<size_type>((end + 63) / 64), 0);
+	for (size_type j = 0; j < kBlockSize; ++j)
+	{
+		packed_detail::write_bits(words_.data(), bits_ + static_cast<uint64_t>(j) * width, width,
+		                          static_cast<uint64_t>(tail_[j] - base));
+	}
+	blocks_.push_back(block_header{ base, bits_, width });
+	bits_ = end;
+	tail_.clear();
+}
+
+// 把最后一个压缩的块还原为未满的块
+template <class T>
+void sorted_packed_vector<T>::unseal_last()
+{
+	const block_header h = blocks_.back();
+	tail_.resize(kBlockSize);
+	packed_detail::unpack(words_.data(), words_.size(), h.offset, h.width, kBlockSize, tail_.data(), h.base);
+	blocks_.pop_back();
+	bits_ = h.offset;
+	words_.resize(static_cast<size_type>((bits_ + 63) / 64));
+	const unsigned rem = static_cast<unsigned>(bits_ % 64);
+	if (rem != 0)
+		words_.back() &= packed_detail::low_mask(rem);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(sorted_packed_vector<T>& lhs, sorted_packed_vector<T>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_PACKED_VECTOR_H_
@@ -0,0 +1,901 @@
+#ifndef MYTINYSTL_PARALLEL_ALGO_H_
+#define MYTINYSTL_PARALLEL_ALGO_H_
+
+// 这个头文件包含了 mystl 算法的并行版本
+// 所有函数的第一个参数为执行策略 (mystl::execution::seq / par / par_unseq)
+// 只有随机访问迭代器才会真正并行, 其余迭代器以及 seq 策略都退化为串行算法
+// 元素个数不足两个块(见 MYSTL_PARALLEL_GRAIN_SIZE 与 with_grain)时同样串行执行
+// 默认运算的 reduce / transform_reduce 在元素可以交给 numeric.h 的向量化内核时, 各块直接使用内核
+
+#include <atomic>
+#include <cstddef>
+
+#include "algo.h"
+#include "algobase.h"
+#include "execution.h"
+#include "iterator.h"
+#include "memory.h"
+#include "numeric.h"
+
+namespace mystl
+{
+
+// 判断某个执行策略与迭代器组合是否需要走并行路径: 策略允许并行且所有迭代器均为随机访问迭代器
+template <bool...>
+struct bool_pack {};
+
+template <class ExecutionPolicy, class... Iters>
+struct use_parallel_path
+	: public m_bool_constant<
+	is_parallel_policy<typename std::decay<ExecutionPolicy>::type>::value &&
+	std::is_same<bool_pack<true, is_random_access_iterator<Iters>::value...>,
+	             bool_pack<is_random_access_iterator<Iters>::value..., true>>::value>
+{
+};
+
+// 各块中间结果的缓冲区, 以 allocator 申请并逐个构造, 离开作用域时析构
+template <class T>
+class chunk_results
+{
+private:
+	T*     data_;
+	size_t size_;
+
+public:
+	chunk_results(size_t n, const T& value) : data_(nullptr), size_(n)
+	{
+		data_ = mystl::allocator<T>::allocate(n);
+		mystl::uninitialized_fill_n(data_, n, value);
+	}
+
+	~chunk_results()
+	{
+		mystl::allocator<T>::destroy(data_, data_ + size_);
+		mystl::allocator<T>::deallocate(data_, size_);
+	}
+
+	chunk_results(const chunk_results&) = delete;
+	chunk_results& operator=(const chunk_results&) = delete;
+
+	T& operator[](size_t i) { return data_[i]; }
+	size_t size() const noexcept { return size_; }
+};
+
+/*****************************************************************************************/
+// for_each
+/*****************************************************************************************/
+
+template <class ForwardIter, class Function>
+void par_for_each_dispatch(size_t grain, ForwardIter first, ForwardIter last, Function f,
+                           m_false_type)
+{
+	(void)grain;
+	mystl::for_each(first, last, f);
+}
+
+template <class RandomIter, class Function>
+void par_for_each_dispatch(size_t grain, RandomIter first, RandomIter last, Function f,
+                           m_true_type)
+{
+	mystl::parallel_chunks(static_cast<size_t>(last - first), grain,
+	                       [&](size_t begin, size_t end, size_t)
+	                       {
+		                       mystl::for_each(first + begin, first + end, f);
+	                       });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class Function>
+enable_if_execution_policy<ExecutionPolicy, void>
+for_each(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, Function f)
+{
+	mystl::par_for_each_dispatch(policy_grain_size(policy), first, last, f,
+	                             use_parallel_path<ExecutionPolicy, ForwardIter>{});
+}
+
+/*****************************************************************************************/
+// transform
+/*****************************************************************************************/
+
+template <class InputIter, class OutputIter, class UnaryOperation>
+OutputIter par_transform_dispatch(size_t, InputIter first, InputIter last, OutputIter result,
+                                  UnaryOperation unary_op, m_false_type)
+{
+	return mystl::transform(first, last, result, unary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class UnaryOperation>
+RandomIter2 par_transform_dispatch(size_t grain, RandomIter1 first, RandomIter1 last,
+                                   RandomIter2 result, UnaryOperation unary_op, m_true_type)
+{
+	const auto n = last - first;
+	mystl::parallel_chunks(static_cast<size_t>(n), grain,
+	                       [&](size_t begin, size_t end, size_t)
+	                       {
+		                       mystl::transform(first + begin, first + end, result + begin,
+		                                        unary_op);
+	                       });
+	return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class UnaryOperation>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+transform(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last,
+          ForwardIter2 result, UnaryOperation unary_op)
+{
+	return mystl::par_transform_dispatch(
+		policy_grain_size(policy), first, last, result, unary_op,
+		use_parallel_path<ExecutionPolicy, ForwardIter1, ForwardIter2>{});
+}
+
+template <class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+OutputIter par_transform2_dispatch(size_t, InputIter1 first1, InputIter1 last1,
+                                   InputIter2 first2, OutputIter result,
+                                   BinaryOperation binary_op, m_false_type)
+{
+	return mystl::transform(first1, last1, first2, result, binary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOperation>
+RandomIter3 par_transform2_dispatch(size_t grain, RandomIter1 first1, RandomIter1 last1,
+                                    RandomIter2 first2, RandomIter3 result,
+                                    BinaryOperation binary_op, m_true_type)
+{
+	const auto n = last1 - first1;
+	mystl::parallel_chunks(static_cast<size_t>(n), grain,
+	                       [&](size_t begin, size_t end, size_t)
+	                       {
+		                       mystl::transform(first1 + begin, first1 + end, first2 + begin,
+		                                        result + begin, binary_op);
+	                       });
+	return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class ForwardIter3,
+          class BinaryOperation>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter3>
+transform(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1,
+          ForwardIter2 first2, ForwardIter3 result, BinaryOperation binary_op)
+{
+	return mystl::par_transform2_dispatch(
+		policy_grain_size(policy), first1, last1, first2, result, binary_op,
+		use_parallel_path<ExecutionPolicy, ForwardIter1, ForwardIter2, ForwardIter3>{});
+}
+
+/*****************************************************************************************/
+// reduce / transform_reduce
+// 并行时每块先独立归约, 再按块的顺序合并, 因此 binary_op 需满足结合律与交换律
+/*****************************************************************************************/
+
+// 串行的 transform_reduce, 为各块的局部归约服务
+template <class InputIter, class T, class BinaryOp, class UnaryOp>
+T unchecked_transform_reduce(InputIter first, InputIter last, T init,
+                             BinaryOp binary_op, UnaryOp unary_op)
+{
+	for (; first != last; ++first)
+		init = binary_op(mystl::move(init), unary_op(*first));
+	return init;
+}
+
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T unchecked_transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                             BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+	for (; first1 != last1; ++first1, ++first2)
+		init = reduce_op(mystl::move(init), transform_op(*first1, *first2));
+	return init;
+}
+
+template <class InputIter, class T, class BinaryOp, class UnaryOp>
+T par_transform_reduce_dispatch(size_t, InputIter first, InputIter last, T init,
+                                BinaryOp binary_op, UnaryOp unary_op, m_false_type)
+{
+	return mystl::unchecked_transform_reduce(first, last, mystl::move(init), binary_op, unary_op);
+}
+
+template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+T par_transform_reduce_dispatch(size_t grain, RandomIter first, RandomIter last, T init,
+                                BinaryOp binary_op, UnaryOp unary_op, m_true_type)
+{
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t chunks = mystl::parallel_chunk_count(n, grain);
+	if (chunks < 2)
+		return mystl::unchecked_transform_reduce(first, last, mystl::move(init),
+		                                         binary_op, unary_op);
+	// 每块以首元素作为归约初值, 这样不要求 init 是 binary_op 的单位元
+	chunk_results<T> partial(chunks, init);
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		T acc = unary_op(*(first + begin));
+		partial[i] = mystl::unchecked_transform_reduce(first + begin + 1, first + end,
+		                                               mystl::move(acc), binary_op, unary_op);
+	});
+	for (size_t i = 0; i < chunks; ++i)
+		init = binary_op(mystl::move(init), mystl::move(partial[i]));
+	return init;
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp, class UnaryOp>
+enable_if_execution_policy<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T init,
+                 BinaryOp binary_op, UnaryOp unary_op)
+{
+	return mystl::par_transform_reduce_dispatch(policy_grain_size(policy), first, last,
+	                                            mystl::move(init), binary_op, unary_op,
+	                                            use_parallel_path<ExecutionPolicy, ForwardIter>{});
+}
+
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T par_transform_reduce2_dispatch(size_t, InputIter1 first1, InputIter1 last1,
+                                 InputIter2 first2, T init, BinaryOp1 reduce_op,
+                                 BinaryOp2 transform_op, m_false_type)
+{
+	return mystl::unchecked_transform_reduce(first1, last1, first2, mystl::move(init),
+	                                         reduce_op, transform_op);
+}
+
+template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+T par_transform_reduce2_dispatch(size_t grain, RandomIter1 first1, RandomIter1 last1,
+                                 RandomIter2 first2, T init, BinaryOp1 reduce_op,
+                                 BinaryOp2 transform_op, m_true_type)
+{
+	const size_t n = static_cast<size_t>(last1 - first1);
+	const size_t chunks = mystl::parallel_chunk_count(n, grain);
+	if (chunks < 2)
+		return mystl::unchecked_transform_reduce(first1, last1, first2, mystl::move(init),
+		                                         reduce_op, transform_op);
+	chunk_results<T> partial(chunks, init);
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		T acc = transform_op(*(first1 + begin), *(first2 + begin));
+		partial[i] = mystl::unchecked_transform_reduce(first1 + begin + 1, first1 + end,
+		                                               first2 + begin + 1, mystl::move(acc),
+		                                               reduce_op, transform_op);
+	});
+	for (size_t i = 0; i < chunks; ++i)
+		init = reduce_op(mystl::move(init), mystl::move(partial[i]));
+	return init;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T,
+          class BinaryOp1, class BinaryOp2>
+enable_if_execution_policy<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1,
+                 ForwardIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+	return mystl::par_transform_reduce2_dispatch(
+		policy_grain_size(policy), first1, last1, first2, mystl::move(init), reduce_op,
+		transform_op, use_parallel_path<ExecutionPolicy, ForwardIter1, ForwardIter2>{});
+}
+
+// 默认运算的求和与点积: 元素可以交给 numeric.h 中的向量化内核时, 每块直接调用内核
+template <class ExecutionPolicy, class ContiguousIter, class T>
+T par_sum_kernel(ExecutionPolicy&& policy, ContiguousIter first, ContiguousIter last, T init)
+{
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t grain = policy_grain_size(policy);
+	const size_t chunks = use_parallel_path<ExecutionPolicy, ContiguousIter>::value
+		? mystl::parallel_chunk_count(n, grain) : 1;
+	if (chunks < 2)
+		return numeric_detail::sum_dispatch(first, last, init, m_true_type());
+	const T* p = &*first;
+	chunk_results<T> partial(chunks, T());
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		partial[i] = numeric_detail::sum(p + begin, end - begin);
+	});
+	for (size_t i = 0; i < chunks; ++i)
+		init = numeric_detail::add(init, partial[i]);
+	return init;
+}
+
+template <class ExecutionPolicy, class ContiguousIter1, class ContiguousIter2, class T>
+T par_dot_kernel(ExecutionPolicy&& policy, ContiguousIter1 first1, ContiguousIter1 last1,
+                 ContiguousIter2 first2, T init)
+{
+	const size_t n = static_cast<size_t>(last1 - first1);
+	const size_t grain = policy_grain_size(policy);
+	const size_t chunks = use_parallel_path<ExecutionPolicy, ContiguousIter1, ContiguousIter2>::value
+		? mystl::parallel_chunk_count(n, grain) : 1;
+	if (chunks < 2)
+		return numeric_detail::dot_dispatch(first1, last1, first2, init, m_true_type());
+	const T* p = &*first1;
+	const T* q = &*first2;
+	chunk_results<T> partial(chunks, T());
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		partial[i] = numeric_detail::dot(p + begin, q + begin, end - begin);
+	});
+	for (size_t i = 0; i < chunks; ++i)
+		init = numeric_detail::add(init, partial[i]);
+	return init;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+T par_transform_reduce_default(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1,
+                               ForwardIter2 first2, T init, m_false_type)
+{
+	using value_type1 = typename iterator_traits<ForwardIter1>::value_type;
+	using value_type2 = typename iterator_traits<ForwardIter2>::value_type;
+	return mystl::transform_reduce(
+		mystl::forward<ExecutionPolicy>(policy), first1, last1, first2, mystl::move(init),
+		[](T lhs, T rhs) { return lhs + rhs; },
+		[](const value_type1& lhs, const value_type2& rhs) { return lhs * rhs; });
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+T par_transform_reduce_default(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1,
+                               ForwardIter2 first2, T init, m_true_type)
+{
+	return mystl::par_dot_kernel(policy, first1, last1, first2, init);
+}
+
+// 默认以 operator+ 归约, operator* 变换
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+enable_if_execution_policy<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1,
+                 ForwardIter2 first2, T init)
+{
+	return mystl::par_transform_reduce_default(
+		mystl::forward<ExecutionPolicy>(policy), first1, last1, first2, mystl::move(init),
+		m_bool_constant<numeric_detail::use_kernel<ForwardIter1, T, true>::value &&
+		                numeric_detail::use_kernel<ForwardIter2, T, true>::value>());
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp>
+enable_if_execution_policy<ExecutionPolicy, T>
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T init, BinaryOp binary_op)
+{
+	using reference = typename iterator_traits<ForwardIter>::reference;
+	return mystl::transform_reduce(mystl::forward<ExecutionPolicy>(policy), first, last,
+	                               mystl::move(init), binary_op,
+	                               [](reference value) -> reference { return value; });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+T par_reduce_default(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T init,
+                     m_false_type)
+{
+	return mystl::reduce(mystl::forward<ExecutionPolicy>(policy), first, last, mystl::move(init),
+	                     [](T lhs, T rhs) { return lhs + rhs; });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+T par_reduce_default(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T init,
+                     m_true_type)
+{
+	return mystl::par_sum_kernel(policy, first, last, init);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy<ExecutionPolicy, T>
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T init)
+{
+	return mystl::par_reduce_default(mystl::forward<ExecutionPolicy>(policy), first, last,
+	                                 mystl::move(init),
+	                                 numeric_detail::use_kernel<ForwardIter, T, true>());
+}
+
+template <class ExecutionPolicy, class ForwardIter>
+enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last)
+{
+	using value_type = typename iterator_traits<ForwardIter>::value_type;
+	return mystl::reduce(mystl::forward<ExecutionPolicy>(policy), first, last, value_type());
+}
+
+/*****************************************************************************************/
+// inclusive_scan / exclusive_scan
+// 并行版本分三步：各块求和 -> 串行求各块的前缀偏移 -> 各块带偏移做串行扫描
+/*****************************************************************************************/
+
+// 串行 inclusive_scan, 以 init 作为第一个元素之前的累计值
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter unchecked_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    BinaryOp binary_op, T init)
+{
+	for (; first != last; ++first, ++result)
+	{
+		init = binary_op(mystl::move(init), *first);
+		*result = init;
+	}
+	return result;
+}
+
+// 串行 exclusive_scan, 输出位置 i 为前 i 个元素与 init 的累计值
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter unchecked_exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    T init, BinaryOp binary_op)
+{
+	for (; first != last; ++first, ++result)
+	{
+		// 先保存当前元素, 以支持 result 与 first 指向同一位置的原地扫描
+		T value = binary_op(init, *first);
+		*result = mystl::move(init);
+		init = mystl::move(value);
+	}
+	return result;
+}
+
+// 各块的总和, 块内以首元素为初值
+template <class RandomIter, class T, class BinaryOp>
+void par_scan_partial(size_t grain, RandomIter first, size_t n, chunk_results<T>& partial,
+                      BinaryOp binary_op)
+{
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		T acc = *(first + begin);
+		for (auto it = first + begin + 1; it != first + end; ++it)
+			acc = binary_op(mystl::move(acc), *it);
+		partial[i] = mystl::move(acc);
+	});
+}
+
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter par_inclusive_scan_dispatch(size_t, InputIter first, InputIter last,
+                                       OutputIter result, BinaryOp binary_op, T init,
+                                       m_false_type)
+{
+	return mystl::unchecked_inclusive_scan(first, last, result, binary_op, mystl::move(init));
+}
+
+template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+RandomIter2 par_inclusive_scan_dispatch(size_t grain, RandomIter1 first, RandomIter1 last,
+                                        RandomIter2 result, BinaryOp binary_op, T init,
+                                        m_true_type)
+{
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t chunks = mystl::parallel_chunk_count(n, grain);
+	if (chunks < 2)
+		return mystl::unchecked_inclusive_scan(first, last, result, binary_op, mystl::move(init));
+	chunk_results<T> partial(chunks, init);
+	mystl::par_scan_partial(grain, first, n, partial, binary_op);
+	// partial[i] 改写为第 i 块之前的累计值
+	for (size_t i = 0; i < chunks; ++i)
+	{
+		T next = binary_op(init, mystl::move(partial[i]));
+		partial[i] = mystl::move(init);
+		init = mystl::move(next);
+	}
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		mystl::unchecked_inclusive_scan(first + begin, first + end, result + begin,
+		                                binary_op, partial[i]);
+	});
+	return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp, class T>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last,
+               ForwardIter2 result, BinaryOp binary_op, T init)
+{
+	return mystl::par_inclusive_scan_dispatch(
+		policy_grain_size(policy), first, last, result, binary_op, mystl::move(init),
+		use_parallel_path<ExecutionPolicy, ForwardIter1, ForwardIter2>{});
+}
+
+// 没有初值的版本: 第一个元素本身作为初值
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last,
+               ForwardIter2 result, BinaryOp binary_op)
+{
+	if (first == last)
+		return result;
+	using value_type = typename iterator_traits<ForwardIter1>::value_type;
+	value_type init = *first;
+	*result = init;
+	++first;
+	++result;
+	return mystl::inclusive_scan(mystl::forward<ExecutionPolicy>(policy), first, last, result,
+	                             binary_op, mystl::move(init));
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last,
+               ForwardIter2 result)
+{
+	using value_type = typename iterator_traits<ForwardIter1>::value_type;
+	return mystl::inclusive_scan(mystl::forward<ExecutionPolicy>(policy), first, last, result,
+	                             [](const value_type& lhs, const value_type& rhs)
+	                             {
+		                             return lhs + rhs;
+	                             });
+}
+
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter par_exclusive_scan_dispatch(size_t, InputIter first, InputIter last,
+                                       OutputIter result, T init, BinaryOp binary_op,
+                                       m_false_type)
+{
+	return mystl::unchecked_exclusive_scan(first, last, result, mystl::move(init), binary_op);
+}
+
+template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+RandomIter2 par_exclusive_scan_dispatch(size_t grain, RandomIter1 first, RandomIter1 last,
+                                        RandomIter2 result, T init, BinaryOp binary_op,
+                                        m_true_type)
+{
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t chunks = mystl::parallel_chunk_count(n, grain);
+	if (chunks < 2)
+		return mystl::unchecked_exclusive_scan(first, last, result, mystl::move(init), binary_op);
+	chunk_results<T> partial(chunks, init);
+	mystl::par_scan_partial(grain, first, n, partial, binary_op);
+	for (size_t i = 0; i < chunks; ++i)
+	{
+		T next = binary_op(init, mystl::move(partial[i]));
+		partial[i] = mystl::move(init);
+		init = mystl::move(next);
+	}
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t i)
+	{
+		mystl::unchecked_exclusive_scan(first + begin, first + end, result + begin,
+		                                partial[i], binary_op);
+	});
+	return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T, class BinaryOp>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+exclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last,
+               ForwardIter2 result, T init, BinaryOp binary_op)
+{
+	return mystl::par_exclusive_scan_dispatch(
+		policy_grain_size(policy), first, last, result, mystl::move(init), binary_op,
+		use_parallel_path<ExecutionPolicy, ForwardIter1, ForwardIter2>{});
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+exclusive_scan(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last,
+               ForwardIter2 result, T init)
+{
+	return mystl::exclusive_scan(mystl::forward<ExecutionPolicy>(policy), first, last, result,
+	                             mystl::move(init), [](const T& lhs, const T& rhs)
+	                             {
+		                             return lhs + rhs;
+	                             });
+}
+
+/*****************************************************************************************/
+// partial_sum
+// 与 inclusive_scan 相同, 随机访问迭代器在并行策略下分块计算前缀和
+/*****************************************************************************************/
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+partial_sum(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result)
+{
+	return mystl::inclusive_scan(mystl::forward<ExecutionPolicy>(policy), first, last, result);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class BinaryOp>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+partial_sum(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+            BinaryOp binary_op)
+{
+	return mystl::inclusive_scan(mystl::forward<ExecutionPolicy>(policy), first, last, result,
+	                             binary_op);
+}
+
+/*****************************************************************************************/
+// copy / fill
+// 每块交给串行的 copy / fill_n, 对 trivially copyable 类型会命中 memmove / memset
+/*****************************************************************************************/
+
+template <class InputIter, class OutputIter>
+OutputIter par_copy_dispatch(size_t, InputIter first, InputIter last, OutputIter result,
+                             m_false_type)
+{
+	return mystl::copy(first, last, result);
+}
+
+template <class RandomIter1, class RandomIter2>
+RandomIter2 par_copy_dispatch(size_t grain, RandomIter1 first, RandomIter1 last,
+                              RandomIter2 result, m_true_type)
+{
+	const auto n = last - first;
+	mystl::parallel_chunks(static_cast<size_t>(n), grain,
+	                       [&](size_t begin, size_t end, size_t)
+	                       {
+		                       mystl::copy(first + begin, first + end, result + begin);
+	                       });
+	return result + n;
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+copy(ExecutionPolicy&& policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result)
+{
+	return mystl::par_copy_dispatch(policy_grain_size(policy), first, last, result,
+	                                use_parallel_path<ExecutionPolicy, ForwardIter1, ForwardIter2>{});
+}
+
+template <class ForwardIter, class T>
+void par_fill_dispatch(size_t, ForwardIter first, ForwardIter last, const T& value, m_false_type)
+{
+	mystl::fill(first, last, value);
+}
+
+template <class RandomIter, class T>
+void par_fill_dispatch(size_t grain, RandomIter first, RandomIter last, const T& value,
+                       m_true_type)
+{
+	mystl::parallel_chunks(static_cast<size_t>(last - first), grain,
+	                       [&](size_t begin, size_t end, size_t)
+	                       {
+		                       mystl::fill_n(first + begin, end - begin, value);
+	                       });
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy<ExecutionPolicy, void>
+fill(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, const T& value)
+{
+	mystl::par_fill_dispatch(policy_grain_size(policy), first, last, value,
+	                         use_parallel_path<ExecutionPolicy, ForwardIter>{});
+}
+
+/*****************************************************************************************/
+// find_if
+// 并行版本中每块以小段为单位推进, 一旦某块找到更靠前的结果, 之后的块会提前放弃(early cancellation)
+/*****************************************************************************************/
+
+constexpr static size_t kFindCancelStep = 1024;  // 检查取消标志的间隔
+
+template <class InputIter, class UnaryPredicate>
+InputIter par_find_if_dispatch(size_t, InputIter first, InputIter last,
+                               UnaryPredicate unary_pred, m_false_type)
+{
+	return mystl::find_if(first, last, unary_pred);
+}
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter par_find_if_dispatch(size_t grain, RandomIter first, RandomIter last,
+                                UnaryPredicate unary_pred, m_true_type)
+{
+	const size_t n = static_cast<size_t>(last - first);
+	// found 保存目前已知的最小命中下标, n 表示尚未命中
+	std::atomic<size_t> found(n);
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t i = begin; i < end; )
+		{
+			// 已经有更靠前的命中, 本块的结果不可能更优
+			if (found.load(std::memory_order_relaxed) < i)
+				return;
+			const size_t stop = end - i > kFindCancelStep ? i + kFindCancelStep : end;
+			for (; i < stop; ++i)
+			{
+				if (unary_pred(*(first + i)))
+				{
+					// 原子地取较小值
+					size_t cur = found.load(std::memory_order_relaxed);
+					while (i < cur && !found.compare_exchange_weak(cur, i, std::memory_order_relaxed))
+					{
+					}
+					return;
+				}
+			}
+		}
+	});
+	return first + found.load(std::memory_order_relaxed);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+enable_if_execution_policy<ExecutionPolicy, ForwardIter>
+find_if(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred)
+{
+	return mystl::par_find_if_dispatch(policy_grain_size(policy), first, last, unary_pred,
+	                                   use_parallel_path<ExecutionPolicy, ForwardIter>{});
+}
+
+/*****************************************************************************************/
+// sort / stable_sort
+// 并行版本: 各块独立排序, 之后逐轮两两归并, 每轮的归并再按线程数切分为若干互不重叠的子归并
+// 归并时需要一块与原区间等长的缓冲区, 申请失败时退化为串行排序
+/*****************************************************************************************/
+
+// 一次子归并: 把有序的 [first1, last1) 与 [first2, last2) 稳定地合并到 result
+template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+OutputIter par_merge_move(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                          InputIter2 last2, OutputIter result, Compared comp)
+{
+	while (first1 != last1 && first2 != last2)
+	{
+		if (comp(*first2, *first1))
+		{
+			*result = mystl::move(*first2);
+			++first2;
+		}
+		else
+		{
+			*result = mystl::move(*first1);
+			++first1;
+		}
+		++result;
+	}
+	result = mystl::move(first1, last1, result);
+	return mystl::move(first2, last2, result);
+}
+
+// 把 [first, middle) 与 [middle, last) 的归并切分为 pieces 个互不重叠的子归并, 求第 i 个子归并在后段的起点
+// 以前段的等分点 x 为界, 后段用 lower_bound(x) 切分, 保证相等元素前段在先, 归并保持稳定
+// 归并会移动(修改)源区间, 所以所有切分点必须在任何子归并开始之前求出
+template <class RandomIter, class Compared>
+size_t par_merge_split(RandomIter first, RandomIter middle, RandomIter last,
+                       size_t pieces, size_t i, Compared comp)
+{
+	const size_t len1 = static_cast<size_t>(middle - first);
+	if (i == 0 || len1 < pieces)
+		return i == 0 ? 0 : static_cast<size_t>(last - middle);
+	if (i == pieces)
+		return static_cast<size_t>(last - middle);
+	return static_cast<size_t>(
+		mystl::lower_bound(middle, last, *(first + len1 * i / pieces), comp) - middle);
+}
+
+// 执行第 i 个子归并, b_begin / b_end 为 par_merge_split 求出的后段切分点
+// 前段过短无法切分时整个归并由第 0 个子归并完成
+template <class RandomIter1, class RandomIter2, class Compared>
+void par_merge_piece(RandomIter1 first, RandomIter1 middle, RandomIter1 /*last*/,
+                     RandomIter2 result, size_t pieces, size_t i,
+                     size_t b_begin, size_t b_end, Compared comp)
+{
+	const size_t len1 = static_cast<size_t>(middle - first);
+	const size_t a_begin = len1 < pieces ? (i == 0 ? 0 : len1) : len1 * i / pieces;
+	const size_t a_end = len1 < pieces ? len1 : len1 * (i + 1) / pieces;
+	mystl::par_merge_move(first + a_begin, first + a_end, middle + b_begin, middle + b_end,
+	                      result + (a_begin + b_begin), comp);
+}
+
+// 各块已经排好序(块边界由 parallel_chunks 给出)且位于缓冲区中, 逐轮在缓冲区与原区间之间来回归并
+// 每轮共有 pairs 组归并, 每组再切分为 pieces 个子归并, 全部子归并一次性交给线程池
+template <class RandomIter, class T, class Compared>
+void par_merge_runs(RandomIter first, size_t n, size_t chunks, T* buffer, Compared comp)
+{
+	// 第 i 块的起点, 与 parallel_chunks 的切分方式保持一致
+	auto bound = [n, chunks](size_t i)
+	{
+		if (i >= chunks)
+			return n;
+		const size_t step = n / chunks;
+		const size_t extra = n % chunks;
+		return i * step + (i < extra ? i : extra);
+	};
+	const size_t threads = mystl::parallel_concurrency();
+	bool in_buffer = true;  // 当前有序数据位于缓冲区中还是原区间中
+	for (size_t width = 1; width < chunks; width *= 2)
+	{
+		const size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+		const size_t pieces = threads > pairs ? (threads + pairs - 1) / pairs : 1;
+		// 第 p 组的第 i 个切分点保存在 splits[p * (pieces + 1) + i]
+		chunk_results<size_t> splits(pairs * (pieces + 1), 0);
+		auto split_body = [&](size_t t)
+		{
+			const size_t p = t / (pieces + 1);
+			const size_t lo = bound(2 * width * p);
+			const size_t mid = bound(2 * width * p + width);
+			const size_t hi = bound(2 * width * (p + 1));
+			splits[t] = in_buffer
+				? mystl::par_merge_split(buffer + lo, buffer + mid, buffer + hi,
+				                         pieces, t % (pieces + 1), comp)
+				: mystl::par_merge_split(first + lo, first + mid, first + hi,
+				                         pieces, t % (pieces + 1), comp);
+		};
+		mystl::parallel_run(pairs * (pieces + 1), split_body);
+		auto merge_body = [&](size_t t)
+		{
+			const size_t p = t / pieces;
+			const size_t i = t % pieces;
+			const size_t lo = bound(2 * width * p);
+			const size_t mid = bound(2 * width * p + width);
+			const size_t hi = bound(2 * width * (p + 1));
+			const size_t b_begin = splits[p * (pieces + 1) + i];
+			const size_t b_end = splits[p * (pieces + 1) + i + 1];
+			if (in_buffer)
+				mystl::par_merge_piece(buffer + lo, buffer + mid, buffer + hi, first + lo,
+				                       pieces, i, b_begin, b_end, comp);
+			else
+				mystl::par_merge_piece(first + lo, first + mid, first + hi, buffer + lo,
+				                       pieces, i, b_begin, b_end, comp);
+		};
+		mystl::parallel_run(pairs * pieces, merge_body);
+		in_buffer = !in_buffer;
+	}
+	if (!in_buffer)
+		return;
+	mystl::parallel_chunks(n, MYSTL_PARALLEL_GRAIN_SIZE, [&](size_t begin, size_t end, size_t)
+	{
+		mystl::move(buffer + begin, buffer + end, first + begin);
+	});
+}
+
+// stable 为 true 时各块使用 stable_sort
+template <class RandomIter, class Compared>
+void par_sort_impl(size_t grain, RandomIter first, RandomIter last, Compared comp, bool stable)
+{
+	using value_type = typename iterator_traits<RandomIter>::value_type;
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t chunks = mystl::parallel_chunk_count(n, grain);
+	auto buf = chunks < 2
+		? mystl::pair<value_type*, ptrdiff_t>(nullptr, 0)
+		: mystl::get_temporary_buffer<value_type>(static_cast<ptrdiff_t>(n));
+	if (buf.first == nullptr || static_cast<size_t>(buf.second) < n)
+	{
+		mystl::release_temporary_buffer(buf.first);
+		if (stable)
+			mystl::stable_sort(first, last, comp);
+		else
+			mystl::sort(first, last, comp);
+		return;
+	}
+	// 各块排好序后移动构造进缓冲区, 之后缓冲区与原区间之间只做移动赋值
+	mystl::parallel_chunks(n, grain, [&](size_t begin, size_t end, size_t)
+	{
+		if (stable)
+			mystl::stable_sort(first + begin, first + end, comp);
+		else
+			mystl::sort(first + begin, first + end, comp);
+		mystl::uninitialized_move(first + begin, first + end, buf.first + begin);
+	});
+	mystl::par_merge_runs(first, n, chunks, buf.first, comp);
+	mystl::destroy(buf.first, buf.first + n);
+	mystl::release_temporary_buffer(buf.first);
+}
+
+template <class RandomIter, class Compared>
+void par_sort_dispatch(size_t, RandomIter first, RandomIter last, Compared comp, bool stable,
+                       m_false_type)
+{
+	if (stable)
+		mystl::stable_sort(first, last, comp);
+	else
+		mystl::sort(first, last, comp);
+}
+
+template <class RandomIter, class Compared>
+void par_sort_dispatch(size_t grain, RandomIter first, RandomIter last, Compared comp,
+                       bool stable, m_true_type)
+{
+	mystl::par_sort_impl(grain, first, last, comp, stable);
+}
+
+template <class ExecutionPolicy, class RandomIter, class Compared>
+enable_if_execution_policy<ExecutionPolicy, void>
+sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last, Compared comp)
+{
+	mystl::par_sort_dispatch(policy_grain_size(policy), first, last, comp, false,
+	                         use_parallel_path<ExecutionPolicy, RandomIter>{});
+}
+
+template <class ExecutionPolicy, class RandomIter>
+enable_if_execution_policy<ExecutionPolicy, void>
+sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last)
+{
+	using value_type = typename iterator_traits<RandomIter>::value_type;
+	mystl::sort(mystl::forward<ExecutionPolicy>(policy), first, last,
+	            [](const value_type& lhs, const value_type& rhs) { return lhs < rhs; });
+}
+
+template <class ExecutionPolicy, class RandomIter, class Compared>
+enable_if_execution_policy<ExecutionPolicy, void>
+stable_sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last, Compared comp)
+{
+	mystl::par_sort_dispatch(policy_grain_size(policy), first, last, comp, true,
+	                         use_parallel_path<ExecutionPolicy, RandomIter>{});
+}
+
+template <class ExecutionPolicy, class RandomIter>
+enable_if_execution_policy<ExecutionPolicy, void>
+stable_sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last)
+{
+	using value_type = typename iterator_traits<RandomIter>::value_type;
+	mystl::stable_sort(mystl::forward<ExecutionPolicy>(policy), first, last,
+	                   [](const value_type& lhs, const value_type& rhs) { return lhs < rhs; });
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_PARALLEL_ALGO_H_
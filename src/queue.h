@@ -0,0 +1,637 @@
+#ifndef MYTINYSTL_QUEUE_H_
+#define MYTINYSTL_QUEUE_H_
+
+// 这个头文件包含了三个模板类 queue, priority_queue 和 indexed_priority_queue
+// queue                  : 队列
+// priority_queue         : 优先队列
+// indexed_priority_queue : 支持通过句柄修改与删除任意元素的优先队列
+
+// notes:
+//
+// queue 缺省以 mystl::deque 为底层容器, 稳定状态下反复 push / pop 不会申请内存
+// 后两者都以堆的分叉数作为模板参数, 堆算法见 heap_algo.h
+// priority_queue 默认是二叉堆, 元素很多时可以选用 4 叉或 8 叉堆以减少缓存未命中
+
+#include <initializer_list>
+
+#include "deque.h"
+#include "vector.h"
+#include "fuctional.h"
+#include "heap_algo.h"
+#include "exceptdef.h"
+#include "tuple.h"
+
+namespace mystl
+{
+
+// 模板类 queue
+// 参数一代表数据类型，参数二代表底层容器类型，缺省使用 mystl::deque 作为底层容器
+template <class T, class Container = mystl::deque<T>>
+class queue
+{
+public:
+	typedef Container                           container_type;
+	// 使用底层容器的型别
+	typedef typename Container::value_type      value_type;
+	typedef typename Container::size_type       size_type;
+	typedef typename Container::reference       reference;
+	typedef typename Container::const_reference const_reference;
+
+	static_assert(std::is_same<T, value_type>::value,
+	              "the value_type of Container should be same with T");
+
+private:
+	container_type c_;  // 用底层容器表现 queue
+
+public:
+	// 构造、复制、移动函数
+	queue() = default;
+
+	explicit queue(size_type n)
+		:c_(n)
+	{
+	}
+
+	queue(size_type n, const value_type& value)
+		:c_(n, value)
+	{
+	}
+
+	template <class IIter>
+	queue(IIter first, IIter last)
+		:c_(first, last)
+	{
+	}
+
+	queue(std::initializer_list<T> ilist)
+		:c_(ilist.begin(), ilist.end())
+	{
+	}
+
+	queue(const Container& c)
+		:c_(c)
+	{
+	}
+
+	queue(Container&& c) noexcept(std::is_nothrow_move_constructible<Container>::value)
+		:c_(mystl::move(c))
+	{
+	}
+
+	queue(const queue& rhs)
+		:c_(rhs.c_)
+	{
+	}
+
+	queue(queue&& rhs) noexcept(std::is_nothrow_move_constructible<Container>::value)
+		:c_(mystl::move(rhs.c_))
+	{
+	}
+
+	queue& operator=(const queue& rhs)
+	{
+		c_ = rhs.c_;
+		return *this;
+	}
+
+	queue& operator=(queue&& rhs) noexcept(std::is_nothrow_move_assignable<Container>::value)
+	{
+		c_ = mystl::move(rhs.c_);
+		return *this;
+	}
+
+	queue& operator=(std::initializer_list<T> ilist)
+	{
+		c_ = ilist;
+		return *this;
+	}
+
+	~queue() = default;
+
+	// 访问元素相关操作
+	reference       front()       { return c_.front(); }
+	const_reference front() const { return c_.front(); }
+	reference       back()        { return c_.back(); }
+	const_reference back()  const { return c_.back(); }
+
+	// 容量相关操作
+	bool      empty() const noexcept { return c_.empty(); }
+	size_type size()  const noexcept { return c_.size(); }
+
+	// 修改容器相关操作
+	template <class ...Args>
+	void emplace(Args&& ...args)
+	{ c_.emplace_back(mystl::forward<Args>(args)...); }
+
+	void push(const value_type& value)
+	{ c_.push_back(value); }
+	void push(value_type&& value)
+	{ c_.emplace_back(mystl::move(value)); }
+
+	void pop()
+	{ c_.pop_front(); }
+
+	void clear()
+	{
+		while (!empty())
+			pop();
+	}
+
+	void swap(queue& rhs) noexcept(noexcept(mystl::swap(c_, rhs.c_)))
+	{ mystl::swap(c_, rhs.c_); }
+
+public:
+	friend bool operator==(const queue& lhs, const queue& rhs) { return lhs.c_ == rhs.c_; }
+	friend bool operator< (const queue& lhs, const queue& rhs) { return lhs.c_ <  rhs.c_; }
+};
+
+// 重载比较操作符
+template <class T, class Container>
+bool operator!=(const queue<T, Container>& lhs, const queue<T, Container>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T, class Container>
+bool operator>(const queue<T, Container>& lhs, const queue<T, Container>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T, class Container>
+bool operator<=(const queue<T, Container>& lhs, const queue<T, Container>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T, class Container>
+bool operator>=(const queue<T, Container>& lhs, const queue<T, Container>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, class Container>
+void swap(queue<T, Container>& lhs, queue<T, Container>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 priority_queue
+// 参数一代表数据类型，参数二代表容器类型，缺省使用 mystl::vector 作为底层容器
+// 参数三代表比较权值的方式，缺省使用 mystl::less 作为比较方式
+// 参数四代表堆的分叉数，缺省为 2
+template <class T, class Container = mystl::vector<T>,
+          class Compare = mystl::less<typename Container::value_type>,
+          size_t Arity = 2>
+class priority_queue
+{
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+	typedef Container                           container_type;
+	typedef Compare                             value_compare;
+	// 使用底层容器的型别
+	typedef typename Container::value_type      value_type;
+	typedef typename Container::size_type       size_type;
+	typedef typename Container::reference       reference;
+	typedef typename Container::const_reference const_reference;
+
+	static_assert(std::is_same<T, value_type>::value,
+	              "the value_type of Container should be same with T");
+
+	static constexpr size_t arity = Arity;
+
+private:
+	compressed_pair<container_type, value_compare> c_comp_;  // 用底层容器来表现 priority_queue, 以及权值比较的标准
+
+	container_type&       c_ref() noexcept          { return c_comp_.first(); }
+	const container_type& c_ref() const noexcept    { return c_comp_.first(); }
+	value_compare&        comp_ref() noexcept       { return c_comp_.second(); }
+	const value_compare&  comp_ref() const noexcept { return c_comp_.second(); }
+
+public:
+	// 构造、复制、移动函数
+	priority_queue() = default;
+
+	explicit priority_queue(const Compare& c)
+		:c_comp_(container_type(), c)
+	{
+	}
+
+	explicit priority_queue(size_type n)
+		:c_comp_(piecewise_construct, mystl::forward_as_tuple(n), mystl::forward_as_tuple())
+	{
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	priority_queue(size_type n, const value_type& value)
+		:c_comp_(piecewise_construct, mystl::forward_as_tuple(n, value), mystl::forward_as_tuple())
+	{
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	template <class IIter>
+	priority_queue(IIter first, IIter last)
+		:c_comp_(piecewise_construct, mystl::forward_as_tuple(first, last), mystl::forward_as_tuple())
+	{
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	priority_queue(std::initializer_list<T> ilist)
+		:c_comp_(piecewise_construct, mystl::forward_as_tuple(ilist), mystl::forward_as_tuple())
+	{
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	priority_queue(const Container& s)
+		:c_comp_(piecewise_construct, mystl::forward_as_tuple(s), mystl::forward_as_tuple())
+	{
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	priority_queue(Container&& s)
+		:c_comp_(piecewise_construct, mystl::forward_as_tuple(mystl::move(s)), mystl::forward_as_tuple())
+	{
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	priority_queue(const priority_queue& rhs)
+		:c_comp_(rhs.c_comp_)
+	{
+	}
+
+	priority_queue(priority_queue&& rhs)
+		:c_comp_(mystl::move(rhs.c_ref()), rhs.comp_ref())
+	{
+	}
+
+	priority_queue& operator=(const priority_queue& rhs)
+	{
+		c_ref() = rhs.c_ref();
+		comp_ref() = rhs.comp_ref();
+		return *this;
+	}
+
+	priority_queue& operator=(priority_queue&& rhs)
+	{
+		c_ref() = mystl::move(rhs.c_ref());
+		comp_ref() = rhs.comp_ref();
+		return *this;
+	}
+
+	priority_queue& operator=(std::initializer_list<T> ilist)
+	{
+		c_ref() = ilist;
+		comp_ref() = value_compare();
+		mystl::make_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+		return *this;
+	}
+
+	~priority_queue() = default;
+
+public:
+	// 访问元素相关操作
+	const_reference top() const { return c_ref().front(); }
+
+	// 容量相关操作
+	bool      empty() const noexcept { return c_ref().empty(); }
+	size_type size()  const noexcept { return c_ref().size(); }
+
+	// 修改容器相关操作
+	template <class... Args>
+	void emplace(Args&& ...args)
+	{
+		c_ref().emplace_back(mystl::forward<Args>(args)...);
+		mystl::push_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	void push(const value_type& value)
+	{
+		c_ref().push_back(value);
+		mystl::push_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	void push(value_type&& value)
+	{
+		c_ref().push_back(mystl::move(value));
+		mystl::push_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+	}
+
+	void pop()
+	{
+		mystl::pop_heap<Arity>(c_ref().begin(), c_ref().end(), comp_ref());
+		c_ref().pop_back();
+	}
+
+	void clear()
+	{
+		while (!empty())
+			pop();
+	}
+
+	void swap(priority_queue& rhs) noexcept(noexcept(mystl::swap(c_ref(), rhs.c_ref())) &&
+	                                        noexcept(mystl::swap(comp_ref(), rhs.comp_ref())))
+	{
+		mystl::swap(c_ref(), rhs.c_ref());
+		mystl::swap(comp_ref(), rhs.comp_ref());
+	}
+
+public:
+	friend bool operator==(const priority_queue& lhs, const priority_queue& rhs)
+	{
+		return lhs.c_ref() == rhs.c_ref();
+	}
+	friend bool operator!=(const priority_queue& lhs, const priority_queue& rhs)
+	{
+		return lhs.c_ref() != rhs.c_ref();
+	}
+};
+
+template <class T, class Container, class Compare, size_t Arity>
+constexpr size_t priority_queue<T, Container, Compare, Arity>::arity;
+
+// 重载 mystl 的 swap
+template <class T, class Container, class Compare, size_t Arity>
+void swap(priority_queue<T, Container, Compare, Arity>& lhs,
+          priority_queue<T, Container, Compare, Arity>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// indexed_priority_queue
+// 每次 push 返回一个句柄, 之后可以通过句柄访问、修改或删除该元素, 常用于调度器与 Dijkstra 等算法
+//   * 元素存放在 slots_ 中, 位置即句柄; 被删除的位置进入空闲链表, 供后续 push 复用
+//   * 堆 heap_ 中只保存句柄, pos_[h] 记录句柄 h 在 heap_ 中的下标, 使定位某个元素为 O(1)
+// 与 priority_queue 一致, top() 是 comp 意义下最大的元素; 需要最小堆时使用 mystl::greater
+/*****************************************************************************************/
+
+template <class T, class Compare = mystl::less<T>, size_t Arity = 4>
+class indexed_priority_queue
+{
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+	typedef T               value_type;
+	typedef Compare         value_compare;
+	typedef size_t          size_type;
+	typedef size_t          handle_type;
+	typedef const T&        const_reference;
+
+	static constexpr size_t arity = Arity;
+	// 不在队列中的句柄在 pos_ 中的标记
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+	mystl::vector<T>           slots_;  // 句柄 -> 元素
+	mystl::vector<size_type>   pos_;    // 句柄 -> 在 heap_ 中的下标, 空闲时为 npos
+	mystl::vector<handle_type> heap_;   // 以句柄表示的堆
+	compressed_pair<mystl::vector<handle_type>, value_compare> free_comp_;  // 可以复用的句柄, 以及权值比较的标准
+
+	mystl::vector<handle_type>&       free_ref() noexcept       { return free_comp_.first(); }
+	value_compare&                    comp_ref() noexcept       { return free_comp_.second(); }
+	const value_compare&              comp_ref() const noexcept { return free_comp_.second(); }
+
+public:
+	indexed_priority_queue() = default;
+
+	explicit indexed_priority_queue(const Compare& c)
+		:slots_(), pos_(), heap_(), free_comp_(mystl::vector<handle_type>(), c)
+	{
+	}
+
+public:
+	// 容量相关操作
+	bool      empty() const noexcept { return heap_.empty(); }
+	size_type size()  const noexcept { return heap_.size(); }
+
+	// 预留 n 个元素的空间
+	void reserve(size_type n)
+	{
+		slots_.reserve(n);
+		pos_.reserve(n);
+		heap_.reserve(n);
+	}
+
+	// 访问元素相关操作
+	const_reference top() const
+	{
+		MYSTL_DEBUG(!empty());
+		return slots_[heap_.front()];
+	}
+
+	handle_type top_handle() const
+	{
+		MYSTL_DEBUG(!empty());
+		return heap_.front();
+	}
+
+	// 句柄 h 是否仍在队列中
+	bool contains(handle_type h) const noexcept
+	{
+		return h < pos_.size() && pos_[h] != npos;
+	}
+
+	const_reference get(handle_type h) const
+	{
+		MYSTL_DEBUG(contains(h));
+		return slots_[h];
+	}
+
+	// 修改容器相关操作
+	handle_type push(const value_type& value)
+	{
+		return emplace(value);
+	}
+
+	handle_type push(value_type&& value)
+	{
+		return emplace(mystl::move(value));
+	}
+
+	template <class... Args>
+	handle_type emplace(Args&& ...args)
+	{
+		handle_type h;
+		if (!free_ref().empty())
+		{
+			h = free_ref().back();
+			slots_[h] = value_type(mystl::forward<Args>(args)...);
+			free_ref().pop_back();
+		}
+		else
+		{
+			h = slots_.size();
+			slots_.emplace_back(mystl::forward<Args>(args)...);
+			MYSTL_TRY
+			{
+				pos_.push_back(npos);
+				// 保证空闲句柄数组能容纳所有句柄, 之后 release 中的 push_back 不会再分配内存
+				free_ref().reserve(slots_.size());
+			}
+			MYSTL_CATCH_ALL
+			{
+				slots_.pop_back();
+				if (pos_.size() > slots_.size())
+					pos_.pop_back();
+				MYSTL_RETHROW;
+			}
+		}
+		MYSTL_TRY
+		{
+			heap_.push_back(h);
+		}
+		MYSTL_CATCH_ALL
+		{
+			free_ref().push_back(h);
+			MYSTL_RETHROW;
+		}
+		pos_[h] = heap_.size() - 1;
+		sift_up(heap_.size() - 1);
+		return h;
+	}
+
+	void pop()
+	{
+		MYSTL_DEBUG(!empty());
+		erase(heap_.front());
+	}
+
+	// 删除句柄 h 对应的元素, 之后 h 失效并可能被后续的 push 复用
+	void erase(handle_type h)
+	{
+		MYSTL_DEBUG(contains(h));
+		const size_type i = pos_[h];
+		const size_type last = heap_.size() - 1;
+		if (i != last)
+		{
+			place(i, heap_[last]);
+			heap_.pop_back();
+			restore(i);
+		}
+		else
+		{
+			heap_.pop_back();
+		}
+		release(h);
+	}
+
+	// 提升句柄 h 对应元素的优先级, 新值不能比原值"小"(在 comp 意义下)
+	// 对于以 mystl::greater 构成的最小堆, 即为把键值减小
+	void decrease_key(handle_type h, const value_type& value)
+	{
+		MYSTL_DEBUG(contains(h) && !comp_ref()(value, slots_[h]));
+		slots_[h] = value;
+		sift_up(pos_[h]);
+	}
+
+	// 把句柄 h 对应的元素改为 value, 根据新旧值的关系上溯或下沉
+	void update(handle_type h, const value_type& value)
+	{
+		MYSTL_DEBUG(contains(h));
+		slots_[h] = value;
+		restore(pos_[h]);
+	}
+
+	void clear()
+	{
+		slots_.clear();
+		pos_.clear();
+		heap_.clear();
+		free_ref().clear();
+	}
+
+	void swap(indexed_priority_queue& rhs) noexcept
+	{
+		slots_.swap(rhs.slots_);
+		pos_.swap(rhs.pos_);
+		heap_.swap(rhs.heap_);
+		free_ref().swap(rhs.free_ref());
+		mystl::swap(comp_ref(), rhs.comp_ref());
+	}
+
+private:
+	// 把句柄 h 放到堆的第 i 个位置
+	void place(size_type i, handle_type h) noexcept
+	{
+		heap_[i] = h;
+		pos_[h] = i;
+	}
+
+	// 位置 i 上的元素可能变大或变小, 上溯或下沉以恢复堆性质
+	void restore(size_type i)
+	{
+		if (i > 0 && comp_ref()(slots_[heap_[(i - 1) / Arity]], slots_[heap_[i]]))
+			sift_up(i);
+		else
+			sift_down(i);
+	}
+
+	void sift_up(size_type i)
+	{
+		const handle_type h = heap_[i];
+		while (i > 0)
+		{
+			const size_type parent = (i - 1) / Arity;
+			if (!comp_ref()(slots_[heap_[parent]], slots_[h]))
+				break;
+			place(i, heap_[parent]);
+			i = parent;
+		}
+		place(i, h);
+	}
+
+	void sift_down(size_type i)
+	{
+		const handle_type h = heap_[i];
+		const size_type len = heap_.size();
+		for (;;)
+		{
+			const size_type child = Arity * i + 1;
+			if (child >= len)
+				break;
+			const size_type end = len - child < Arity ? len : child + Arity;
+			size_type best = child;
+			for (size_type c = child + 1; c < end; ++c)
+			{
+				if (comp_ref()(slots_[heap_[best]], slots_[heap_[c]]))
+					best = c;
+			}
+			if (!comp_ref()(slots_[h], slots_[heap_[best]]))
+				break;
+			place(i, heap_[best]);
+			i = best;
+		}
+		place(i, h);
+	}
+
+	// 回收句柄 h, 元素本身被移走以便尽早释放其持有的资源
+	void release(handle_type h)
+	{
+		pos_[h] = npos;
+		value_type discard(mystl::move(slots_[h]));
+		(void)discard;
+		free_ref().push_back(h);
+	}
+};
+
+template <class T, class Compare, size_t Arity>
+constexpr size_t indexed_priority_queue<T, Compare, Arity>::arity;
+
+template <class T, class Compare, size_t Arity>
+constexpr typename indexed_priority_queue<T, Compare, Arity>::size_type
+indexed_priority_queue<T, Compare, Arity>::npos;
+
+// 重载 mystl 的 swap
+template <class T, class Compare, size_t Arity>
+void swap(indexed_priority_queue<T, Compare, Arity>& lhs,
+          indexed_priority_queue<T, Compare, Arity>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_QUEUE_H_
@@ -0,0 +1,1253 @@
+#ifndef MYTINYSTL_RANGES_H_
+#define MYTINYSTL_RANGES_H_
+
+// 这个头文件包含惰性求值的视图(view)与范围适配器, 以及把范围收集进容器的 to
+// ref_view / owning_view / subrange : 引用、持有一个范围, 或由一对迭代器组成的视图
+// transform / filter / take / drop   : 映射、过滤、取前 n 个、跳过前 n 个
+// zip / enumerate                    : 并行遍历两个范围、附带下标遍历
+// chunk / stride / join              : 按 n 个一组切分、每隔 n 个取一个、展平嵌套范围
+// to                                 : 把范围收集到容器中
+
+// notes:
+//
+// 视图不复制元素, 只在迭代时逐个计算, 适配器之间用 | 连接:
+//   auto r = v | views::filter(p) | views::transform(f) | ranges::to<mystl::vector>();
+// 外层视图的迭代器直接包含内层视图的迭代器, 整条流水线展开后是一个循环, 只遍历一次 v,
+// to 在能算出元素个数时(见 ranges::size)先 reserve, 所以只分配一次
+// 视图保存被适配的视图(按值)和函数对象, 迭代器保存指向所属视图的指针, 因此视图被移动后需要重新取迭代器
+// 左值范围以 ref_view 引用, 右值范围以 owning_view 持有(移动进来), 视图本身按值复制
+// filter_view 的 begin 不缓存结果, 每次调用都会从头找第一个满足条件的元素
+// join_view 中, 外层解引用得到的不是引用时, 内层范围暂存在视图中, 此时迭代器只能单遍遍历(input)
+// 只用到 C++11, 适配器对象是 constexpr 的空类对象
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "fuctional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace mystl
+{
+namespace ranges
+{
+
+// 所有视图的基类, 用来区分视图与普通容器
+struct view_base {};
+
+template <class T>
+struct is_view : m_bool_constant<std::is_base_of<view_base, T>::value> {};
+
+// 可以放在 | 右边的范围适配器闭包的基类
+struct closure_base {};
+
+template <class T>
+struct is_closure : m_bool_constant<std::is_base_of<closure_base, T>::value> {};
+
+/*****************************************************************************************/
+// begin / end / size
+
+template <class R>
+auto begin(R& r) -> decltype(r.begin())
+{
+	return r.begin();
+}
+
+template <class T, size_t N>
+T* begin(T (&a)[N]) noexcept
+{
+	return a;
+}
+
+template <class R>
+auto end(R& r) -> decltype(r.end())
+{
+	return r.end();
+}
+
+template <class T, size_t N>
+T* end(T (&a)[N]) noexcept
+{
+	return a + N;
+}
+
+template <class R>
+using iterator_t = decltype(ranges::begin(std::declval<R&>()));
+
+template <class R>
+using range_reference_t = decltype(*std::declval<iterator_t<R>&>());
+
+template <class R>
+using range_value_t = typename iterator_traits<iterator_t<R>>::value_type;
+
+template <class R>
+using range_difference_t = typename iterator_traits<iterator_t<R>>::difference_type;
+
+namespace ranges_detail
+{
+
+// 有 size 成员时使用 size, 数组使用 N, 否则迭代器支持随机访问时相减; 都不满足时没有 size
+template <class R>
+auto size_impl(const R& r, int) -> decltype(static_cast<size_t>(r.size()))
+{
+	return static_cast<size_t>(r.size());
+}
+
+template <class T, size_t N>
+size_t size_impl(const T (&)[N], int) noexcept
+{
+	return N;
+}
+
+template <class R>
+auto size_impl(const R& r, long)
+	-> typename std::enable_if<is_random_access_iterator<iterator_t<const R>>::value, size_t>::type
+{
+	return static_cast<size_t>(ranges::end(r) - ranges::begin(r));
+}
+
+} // namespace ranges_detail
+
+// 范围中的元素个数, 只对不必遍历就能知道个数的范围有定义
+template <class R>
+auto size(const R& r) -> decltype(ranges_detail::size_impl(r, 0))
+{
+	return ranges_detail::size_impl(r, 0);
+}
+
+namespace ranges_detail
+{
+
+template <class Iter>
+using iter_category_t = typename iterator_traits<Iter>::iterator_category;
+
+// 把迭代器类型 Cat 限制为不超过 Cap
+template <class Cat, class Cap>
+using cap_category_t = typename std::conditional<std::is_base_of<Cap, Cat>::value, Cap, Cat>::type;
+
+// 两个迭代器类型中较弱的一个
+template <class Cat1, class Cat2>
+using common_category_t = typename std::conditional<std::is_base_of<Cat1, Cat2>::value, Cat1, Cat2>::type;
+
+template <class T>
+using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+
+// 让 it 前进 n 步, 但不越过 last
+template <class Iter, class Distance>
+void bounded_advance(Iter& it, Distance n, Iter last, input_iterator_tag)
+{
+	for (; n > 0 && it != last; --n)
+		++it;
+}
+
+template <class Iter, class Distance>
+void bounded_advance(Iter& it, Distance n, Iter last, random_access_iterator_tag)
+{
+	const auto left = last - it;
+	it += n < left ? n : left;
+}
+
+template <class Iter, class Distance>
+void bounded_advance(Iter& it, Distance n, Iter last)
+{
+	ranges_detail::bounded_advance(it, n, last, iter_category_t<Iter>());
+}
+
+// 不随复制传播的缓存: 复制时得到空的缓存, 用于 join_view 暂存内层范围
+template <class T>
+class non_propagating_cache
+{
+private:
+	alignas(T) unsigned char buf_[sizeof(T)];
+	bool                     engaged_;
+
+public:
+	non_propagating_cache() noexcept : engaged_(false) {}
+	non_propagating_cache(const non_propagating_cache&) noexcept : engaged_(false) {}
+	non_propagating_cache& operator=(const non_propagating_cache& rhs) noexcept
+	{
+		if (this != &rhs)
+			reset();
+		return *this;
+	}
+	~non_propagating_cache() { reset(); }
+
+	T& get() noexcept
+	{ return *reinterpret_cast<T*>(buf_); }
+
+	void reset() noexcept
+	{
+		if (engaged_)
+		{
+			get().~T();
+			engaged_ = false;
+		}
+	}
+
+	template <class U>
+	T& emplace(U&& u)
+	{
+		reset();
+		::new (static_cast<void*>(buf_)) T(mystl::forward<U>(u));
+		engaged_ = true;
+		return get();
+	}
+};
+
+} // namespace ranges_detail
+
+/*****************************************************************************************/
+// ref_view
+// 引用一个左值范围, 不持有它
+
+template <class R>
+class ref_view : public view_base
+{
+private:
+	R* r_;
+
+public:
+	explicit ref_view(R& r) noexcept : r_(mystl::address_of(r)) {}
+
+	R& base() const noexcept { return *r_; }
+
+	iterator_t<R> begin() const { return ranges::begin(*r_); }
+	iterator_t<R> end()   const { return ranges::end(*r_); }
+	bool          empty() const { return begin() == end(); }
+
+	template <class B = R>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{ return ranges::size(*r_); }
+};
+
+/*****************************************************************************************/
+// owning_view
+// 持有一个从右值移动进来的范围
+
+template <class R>
+class owning_view : public view_base
+{
+private:
+	R r_;
+
+public:
+	explicit owning_view(R&& r) : r_(mystl::move(r)) {}
+
+	R&       base() noexcept       { return r_; }
+	const R& base() const noexcept { return r_; }
+
+	iterator_t<R>       begin()       { return ranges::begin(r_); }
+	iterator_t<const R> begin() const { return ranges::begin(r_); }
+	iterator_t<R>       end()         { return ranges::end(r_); }
+	iterator_t<const R> end()   const { return ranges::end(r_); }
+	bool                empty() const { return begin() == end(); }
+
+	template <class B = R>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{ return ranges::size(r_); }
+};
+
+/*****************************************************************************************/
+// subrange
+// 由一对迭代器 [first, last) 组成的视图
+
+template <class Iter>
+class subrange : public view_base
+{
+private:
+	Iter first_;
+	Iter last_;
+
+public:
+	subrange() : first_(), last_() {}
+	subrange(Iter first, Iter last) : first_(first), last_(last) {}
+
+	Iter begin() const { return first_; }
+	Iter end()   const { return last_; }
+	bool empty() const { return first_ == last_; }
+
+	template <class I = Iter>
+	auto size() const -> typename std::enable_if<is_random_access_iterator<I>::value, size_t>::type
+	{ return static_cast<size_t>(last_ - first_); }
+};
+
+/*****************************************************************************************/
+// all
+// 视图按值复制, 左值范围包装为 ref_view, 右值范围包装为 owning_view
+
+namespace ranges_detail
+{
+
+template <class R>
+using all_kind = std::integral_constant<int,
+	is_view<remove_cvref_t<R>>::value ? 0 : std::is_lvalue_reference<R>::value ? 1 : 2>;
+
+template <class R>
+typename std::decay<R>::type all_impl(R&& r, std::integral_constant<int, 0>)
+{
+	return mystl::forward<R>(r);
+}
+
+template <class R>
+ref_view<typename std::remove_reference<R>::type> all_impl(R&& r, std::integral_constant<int, 1>)
+{
+	return ref_view<typename std::remove_reference<R>::type>(r);
+}
+
+template <class R>
+owning_view<typename std::remove_reference<R>::type> all_impl(R&& r, std::integral_constant<int, 2>)
+{
+	return owning_view<typename std::remove_reference<R>::type>(mystl::move(r));
+}
+
+} // namespace ranges_detail
+
+template <class R>
+using all_t = decltype(ranges_detail::all_impl(std::declval<R>(), ranges_detail::all_kind<R>()));
+
+/*****************************************************************************************/
+// 适配器闭包
+// range | closure 等价于 closure(range), closure1 | closure2 得到依次应用两者的闭包
+
+// 绑定了除范围以外的一个参数的适配器, 如 filter(p), take(n)
+template <class Adaptor, class Arg>
+struct bound_closure : closure_base
+{
+	Arg arg;
+
+	explicit bound_closure(Arg a) : arg(mystl::move(a)) {}
+
+	template <class R>
+	auto operator()(R&& r) const -> decltype(Adaptor()(mystl::forward<R>(r), std::declval<const Arg&>()))
+	{
+		return Adaptor()(mystl::forward<R>(r), arg);
+	}
+};
+
+// 依次应用 first 与 second
+template <class First, class Second>
+struct pipeline_closure : closure_base
+{
+	First  first;
+	Second second;
+
+	pipeline_closure(First f, Second s) : first(mystl::move(f)), second(mystl::move(s)) {}
+
+	template <class R>
+	auto operator()(R&& r) const
+		-> decltype(std::declval<const Second&>()(std::declval<const First&>()(mystl::forward<R>(r))))
+	{
+		return second(first(mystl::forward<R>(r)));
+	}
+};
+
+template <class R, class C, typename std::enable_if<
+	is_closure<ranges_detail::remove_cvref_t<C>>::value &&
+	!is_closure<ranges_detail::remove_cvref_t<R>>::value, int>::type = 0>
+auto operator|(R&& r, C&& c) -> decltype(mystl::forward<C>(c)(mystl::forward<R>(r)))
+{
+	return mystl::forward<C>(c)(mystl::forward<R>(r));
+}
+
+template <class C1, class C2, typename std::enable_if<
+	is_closure<ranges_detail::remove_cvref_t<C1>>::value &&
+	is_closure<ranges_detail::remove_cvref_t<C2>>::value, int>::type = 0>
+pipeline_closure<typename std::decay<C1>::type, typename std::decay<C2>::type>
+operator|(C1&& c1, C2&& c2)
+{
+	return pipeline_closure<typename std::decay<C1>::type, typename std::decay<C2>::type>(
+		mystl::forward<C1>(c1), mystl::forward<C2>(c2));
+}
+
+/*****************************************************************************************/
+// transform_view
+// 对每个元素调用 f, 得到 f 的返回值
+
+template <class V, class F>
+class transform_view : public view_base
+{
+private:
+	V base_;
+	F fun_;
+
+public:
+	class iterator
+	{
+	private:
+		typedef iterator_t<const V> base_iterator;
+
+		base_iterator         cur_;
+		const transform_view* parent_;
+
+	public:
+		typedef ranges_detail::cap_category_t<ranges_detail::iter_category_t<base_iterator>,
+		                                      random_access_iterator_tag> iterator_category;
+		typedef decltype(mystl::invoke(std::declval<const F&>(),
+		                               *std::declval<base_iterator&>()))    reference;
+		typedef ranges_detail::remove_cvref_t<reference>                    value_type;
+		typedef void                                                        pointer;
+		typedef typename iterator_traits<base_iterator>::difference_type   difference_type;
+
+		iterator() : cur_(), parent_(nullptr) {}
+		iterator(const transform_view* parent, base_iterator cur) : cur_(cur), parent_(parent) {}
+
+		base_iterator base() const { return cur_; }
+
+		reference operator*() const
+		{ return mystl::invoke(parent_->fun_, *cur_); }
+		reference operator[](difference_type n) const
+		{ return mystl::invoke(parent_->fun_, cur_[n]); }
+
+		iterator& operator++() { ++cur_; return *this; }
+		iterator  operator++(int) { iterator tmp = *this; ++cur_; return tmp; }
+		iterator& operator--() { --cur_; return *this; }
+		iterator  operator--(int) { iterator tmp = *this; --cur_; return tmp; }
+
+		iterator& operator+=(difference_type n) { cur_ += n; return *this; }
+		iterator& operator-=(difference_type n) { cur_ -= n; return *this; }
+		iterator  operator+(difference_type n) const { return iterator(parent_, cur_ + n); }
+		iterator  operator-(difference_type n) const { return iterator(parent_, cur_ - n); }
+		difference_type operator-(const iterator& rhs) const { return cur_ - rhs.cur_; }
+
+		friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+
+		bool operator==(const iterator& rhs) const { return cur_ == rhs.cur_; }
+		bool operator!=(const iterator& rhs) const { return cur_ != rhs.cur_; }
+		bool operator< (const iterator& rhs) const { return cur_ < rhs.cur_; }
+		bool operator> (const iterator& rhs) const { return rhs.cur_ < cur_; }
+		bool operator<=(const iterator& rhs) const { return !(rhs.cur_ < cur_); }
+		bool operator>=(const iterator& rhs) const { return !(cur_ < rhs.cur_); }
+	};
+
+public:
+	transform_view(V base, F fun) : base_(mystl::move(base)), fun_(mystl::move(fun)) {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(this, ranges::begin(base_)); }
+	iterator end()   const { return iterator(this, ranges::end(base_)); }
+	bool     empty() const { return ranges::begin(base_) == ranges::end(base_); }
+
+	template <class B = V>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{ return ranges::size(base_); }
+};
+
+/*****************************************************************************************/
+// filter_view
+// 只保留使谓词 pred 为 true 的元素
+
+template <class V, class P>
+class filter_view : public view_base
+{
+private:
+	V base_;
+	P pred_;
+
+public:
+	class iterator
+	{
+	private:
+		typedef iterator_t<const V> base_iterator;
+
+		base_iterator      cur_;
+		base_iterator      end_;
+		const filter_view* parent_;
+
+		void satisfy()
+		{
+			while (cur_ != end_ && !mystl::invoke(parent_->pred_, *cur_))
+				++cur_;
+		}
+
+	public:
+		typedef ranges_detail::cap_category_t<ranges_detail::iter_category_t<base_iterator>,
+		                                      forward_iterator_tag>        iterator_category;
+		typedef typename iterator_traits<base_iterator>::value_type      value_type;
+		typedef typename iterator_traits<base_iterator>::pointer         pointer;
+		typedef typename iterator_traits<base_iterator>::reference       reference;
+		typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+
+		iterator() : cur_(), end_(), parent_(nullptr) {}
+		iterator(const filter_view* parent, base_iterator cur, base_iterator last)
+			: cur_(cur), end_(last), parent_(parent)
+		{
+			satisfy();
+		}
+
+		base_iterator base() const { return cur_; }
+
+		reference operator*() const { return *cur_; }
+
+		iterator& operator++()
+		{
+			++cur_;
+			satisfy();
+			return *this;
+		}
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		bool operator==(const iterator& rhs) const { return cur_ == rhs.cur_; }
+		bool operator!=(const iterator& rhs) const { return cur_ != rhs.cur_; }
+	};
+
+public:
+	filter_view(V base, P pred) : base_(mystl::move(base)), pred_(mystl::move(pred)) {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(this, ranges::begin(base_), ranges::end(base_)); }
+	iterator end()   const { return iterator(this, ranges::end(base_), ranges::end(base_)); }
+	bool     empty() const { return begin() == end(); }
+};
+
+/*****************************************************************************************/
+// take_view
+// 取前 n 个元素, 不足 n 个时取全部
+// 被适配的迭代器支持随机访问时直接使用它, 否则使用同时记录剩余个数的迭代器
+
+template <class V, bool = is_random_access_iterator<iterator_t<const V>>::value>
+class take_view;
+
+template <class V>
+class take_view<V, true> : public view_base
+{
+public:
+	typedef iterator_t<const V>                                    iterator;
+	typedef typename iterator_traits<iterator>::difference_type    difference_type;
+
+private:
+	V               base_;
+	difference_type n_;
+
+public:
+	take_view(V base, difference_type n) : base_(mystl::move(base)), n_(n < 0 ? 0 : n) {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return ranges::begin(base_); }
+	iterator end() const
+	{
+		auto first = ranges::begin(base_);
+		ranges_detail::bounded_advance(first, n_, ranges::end(base_));
+		return first;
+	}
+	bool     empty() const { return begin() == end(); }
+	size_t   size()  const { return static_cast<size_t>(end() - begin()); }
+};
+
+template <class V>
+class take_view<V, false> : public view_base
+{
+public:
+	class iterator
+	{
+	private:
+		typedef iterator_t<const V> base_iterator;
+
+	public:
+		typedef ranges_detail::cap_category_t<ranges_detail::iter_category_t<base_iterator>,
+		                                      forward_iterator_tag>        iterator_category;
+		typedef typename iterator_traits<base_iterator>::value_type      value_type;
+		typedef typename iterator_traits<base_iterator>::pointer         pointer;
+		typedef typename iterator_traits<base_iterator>::reference       reference;
+		typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+
+	private:
+		base_iterator   cur_;
+		difference_type count_;  // 还可以前进的步数
+
+	public:
+		iterator() : cur_(), count_(0) {}
+		iterator(base_iterator cur, difference_type count) : cur_(cur), count_(count) {}
+
+		base_iterator base() const { return cur_; }
+
+		reference operator*() const { return *cur_; }
+
+		iterator& operator++() { ++cur_; --count_; return *this; }
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		// 从同一个 begin 出发的迭代器, 位置相同时剩余步数也相同;
+		// end 的剩余步数为 0, 走完 n 步或走到被适配范围的末尾都与 end 相等
+		bool operator==(const iterator& rhs) const
+		{ return count_ == rhs.count_ || cur_ == rhs.cur_; }
+		bool operator!=(const iterator& rhs) const
+		{ return !(*this == rhs); }
+	};
+
+	typedef typename iterator::difference_type difference_type;
+
+private:
+	V               base_;
+	difference_type n_;
+
+public:
+	take_view(V base, difference_type n) : base_(mystl::move(base)), n_(n < 0 ? 0 : n) {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(ranges::begin(base_), n_); }
+	iterator end()   const { return iterator(ranges::end(base_), 0); }
+	bool     empty() const { return begin() == end(); }
+
+	template <class B = V>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{
+		const size_t n = ranges::size(base_);
+		return n < static_cast<size_t>(n_) ? n : static_cast<size_t>(n_);
+	}
+};
+
+/*****************************************************************************************/
+// drop_view
+// 跳过前 n 个元素, 不足 n 个时为空
+
+template <class V>
+class drop_view : public view_base
+{
+public:
+	typedef iterator_t<const V>                                    iterator;
+	typedef typename iterator_traits<iterator>::difference_type    difference_type;
+
+private:
+	V               base_;
+	difference_type n_;
+
+public:
+	drop_view(V base, difference_type n) : base_(mystl::move(base)), n_(n < 0 ? 0 : n) {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const
+	{
+		auto first = ranges::begin(base_);
+		ranges_detail::bounded_advance(first, n_, ranges::end(base_));
+		return first;
+	}
+	iterator end()   const { return ranges::end(base_); }
+	bool     empty() const { return begin() == end(); }
+
+	template <class B = V>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{
+		const size_t n = ranges::size(base_);
+		return n > static_cast<size_t>(n_) ? n - static_cast<size_t>(n_) : 0;
+	}
+};
+
+/*****************************************************************************************/
+// zip_view
+// 同时遍历两个范围, 元素为 pair<第一个范围的引用, 第二个范围的引用>, 长度取较短者
+
+template <class V1, class V2>
+class zip_view : public view_base
+{
+private:
+	V1 base1_;
+	V2 base2_;
+
+public:
+	class iterator
+	{
+	private:
+		typedef iterator_t<const V1> base_iterator1;
+		typedef iterator_t<const V2> base_iterator2;
+
+		base_iterator1 cur1_;
+		base_iterator2 cur2_;
+
+	public:
+		typedef ranges_detail::cap_category_t<ranges_detail::common_category_t<
+			ranges_detail::iter_category_t<base_iterator1>,
+			ranges_detail::iter_category_t<base_iterator2>>, forward_iterator_tag> iterator_category;
+		typedef mystl::pair<typename iterator_traits<base_iterator1>::reference,
+		                    typename iterator_traits<base_iterator2>::reference>  reference;
+		typedef mystl::pair<typename iterator_traits<base_iterator1>::value_type,
+		                    typename iterator_traits<base_iterator2>::value_type> value_type;
+		typedef void                                                              pointer;
+		typedef typename iterator_traits<base_iterator1>::difference_type         difference_type;
+
+		iterator() : cur1_(), cur2_() {}
+		iterator(base_iterator1 cur1, base_iterator2 cur2) : cur1_(cur1), cur2_(cur2) {}
+
+		reference operator*() const { return reference(*cur1_, *cur2_); }
+
+		iterator& operator++() { ++cur1_; ++cur2_; return *this; }
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		// 任意一个到达末尾即结束
+		bool operator==(const iterator& rhs) const
+		{ return cur1_ == rhs.cur1_ || cur2_ == rhs.cur2_; }
+		bool operator!=(const iterator& rhs) const
+		{ return !(*this == rhs); }
+	};
+
+public:
+	zip_view(V1 base1, V2 base2) : base1_(mystl::move(base1)), base2_(mystl::move(base2)) {}
+
+	iterator begin() const { return iterator(ranges::begin(base1_), ranges::begin(base2_)); }
+	iterator end()   const { return iterator(ranges::end(base1_), ranges::end(base2_)); }
+	bool     empty() const { return begin() == end(); }
+
+	template <class B1 = V1, class B2 = V2>
+	auto size() const -> decltype(ranges::size(std::declval<const B1&>()) + ranges::size(std::declval<const B2&>()))
+	{
+		const size_t n1 = ranges::size(base1_);
+		const size_t n2 = ranges::size(base2_);
+		return n1 < n2 ? n1 : n2;
+	}
+};
+
+/*****************************************************************************************/
+// enumerate_view
+// 元素为 pair<下标, 元素的引用>
+
+template <class V>
+class enumerate_view : public view_base
+{
+private:
+	V base_;
+
+public:
+	class iterator
+	{
+	private:
+		typedef iterator_t<const V> base_iterator;
+
+	public:
+		typedef ranges_detail::cap_category_t<ranges_detail::iter_category_t<base_iterator>,
+		                                      forward_iterator_tag>              iterator_category;
+		typedef typename iterator_traits<base_iterator>::difference_type       difference_type;
+		typedef mystl::pair<difference_type,
+		                    typename iterator_traits<base_iterator>::reference>  reference;
+		typedef mystl::pair<difference_type,
+		                    typename iterator_traits<base_iterator>::value_type> value_type;
+		typedef void                                                             pointer;
+
+	private:
+		base_iterator   cur_;
+		difference_type index_;
+
+	public:
+		iterator() : cur_(), index_(0) {}
+		iterator(base_iterator cur, difference_type index) : cur_(cur), index_(index) {}
+
+		base_iterator   base()  const { return cur_; }
+		difference_type index() const { return index_; }
+
+		reference operator*() const { return reference(index_, *cur_); }
+
+		iterator& operator++() { ++cur_; ++index_; return *this; }
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		bool operator==(const iterator& rhs) const { return cur_ == rhs.cur_; }
+		bool operator!=(const iterator& rhs) const { return cur_ != rhs.cur_; }
+	};
+
+public:
+	explicit enumerate_view(V base) : base_(mystl::move(base)) {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(ranges::begin(base_), 0); }
+	iterator end()   const { return iterator(ranges::end(base_), 0); }
+	bool     empty() const { return ranges::begin(base_) == ranges::end(base_); }
+
+	template <class B = V>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{ return ranges::size(base_); }
+};
+
+/*****************************************************************************************/
+// chunk_view
+// 每 n 个元素为一组, 元素为 subrange, 最后一组可能不足 n 个
+
+template <class V>
+class chunk_view : public view_base
+{
+private:
+	typedef iterator_t<const V> base_iterator;
+
+	static_assert(is_forward_iterator<base_iterator>::value,
+	              "chunk_view requires a forward range");
+
+public:
+	class iterator
+	{
+	public:
+		typedef forward_iterator_tag                                     iterator_category;
+		typedef subrange<base_iterator>                                  value_type;
+		typedef subrange<base_iterator>                                  reference;
+		typedef void                                                     pointer;
+		typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+
+	private:
+		base_iterator   cur_;
+		base_iterator   end_;
+		difference_type n_;
+
+	public:
+		iterator() : cur_(), end_(), n_(0) {}
+		iterator(base_iterator cur, base_iterator last, difference_type n)
+			: cur_(cur), end_(last), n_(n) {}
+
+		reference operator*() const
+		{
+			auto next = cur_;
+			ranges_detail::bounded_advance(next, n_, end_);
+			return reference(cur_, next);
+		}
+
+		iterator& operator++()
+		{
+			ranges_detail::bounded_advance(cur_, n_, end_);
+			return *this;
+		}
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		bool operator==(const iterator& rhs) const { return cur_ == rhs.cur_; }
+		bool operator!=(const iterator& rhs) const { return cur_ != rhs.cur_; }
+	};
+
+	typedef typename iterator::difference_type difference_type;
+
+private:
+	V               base_;
+	difference_type n_;
+
+public:
+	chunk_view(V base, difference_type n) : base_(mystl::move(base)), n_(n)
+	{
+		MYSTL_DEBUG(n > 0);
+	}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(ranges::begin(base_), ranges::end(base_), n_); }
+	iterator end()   const { return iterator(ranges::end(base_), ranges::end(base_), n_); }
+	bool     empty() const { return ranges::begin(base_) == ranges::end(base_); }
+
+	template <class B = V>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{
+		const size_t n = ranges::size(base_);
+		return (n + static_cast<size_t>(n_) - 1) / static_cast<size_t>(n_);
+	}
+};
+
+/*****************************************************************************************/
+// stride_view
+// 从第一个元素开始, 每隔 n 个取一个
+
+template <class V>
+class stride_view : public view_base
+{
+private:
+	typedef iterator_t<const V> base_iterator;
+
+public:
+	class iterator
+	{
+	public:
+		typedef ranges_detail::cap_category_t<ranges_detail::iter_category_t<base_iterator>,
+		                                      forward_iterator_tag>        iterator_category;
+		typedef typename iterator_traits<base_iterator>::value_type      value_type;
+		typedef typename iterator_traits<base_iterator>::pointer         pointer;
+		typedef typename iterator_traits<base_iterator>::reference       reference;
+		typedef typename iterator_traits<base_iterator>::difference_type difference_type;
+
+	private:
+		base_iterator   cur_;
+		base_iterator   end_;
+		difference_type n_;
+
+	public:
+		iterator() : cur_(), end_(), n_(0) {}
+		iterator(base_iterator cur, base_iterator last, difference_type n)
+			: cur_(cur), end_(last), n_(n) {}
+
+		base_iterator base() const { return cur_; }
+
+		reference operator*() const { return *cur_; }
+
+		iterator& operator++()
+		{
+			ranges_detail::bounded_advance(cur_, n_, end_);
+			return *this;
+		}
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		bool operator==(const iterator& rhs) const { return cur_ == rhs.cur_; }
+		bool operator!=(const iterator& rhs) const { return cur_ != rhs.cur_; }
+	};
+
+	typedef typename iterator::difference_type difference_type;
+
+private:
+	V               base_;
+	difference_type n_;
+
+public:
+	stride_view(V base, difference_type n) : base_(mystl::move(base)), n_(n)
+	{
+		MYSTL_DEBUG(n > 0);
+	}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(ranges::begin(base_), ranges::end(base_), n_); }
+	iterator end()   const { return iterator(ranges::end(base_), ranges::end(base_), n_); }
+	bool     empty() const { return ranges::begin(base_) == ranges::end(base_); }
+
+	template <class B = V>
+	auto size() const -> decltype(ranges::size(std::declval<const B&>()))
+	{
+		const size_t n = ranges::size(base_);
+		return n == 0 ? 0 : (n - 1) / static_cast<size_t>(n_) + 1;
+	}
+};
+
+/*****************************************************************************************/
+// join_view
+// 把元素为范围的范围展平为一个范围
+
+namespace ranges_detail
+{
+
+// 外层解引用得到引用时直接使用; 否则把得到的内层范围暂存起来
+template <class Ref, bool = std::is_reference<Ref>::value>
+class join_inner
+{
+public:
+	typedef typename std::remove_reference<Ref>::type inner_type;
+
+	template <class Iter>
+	inner_type& get(const Iter& outer) const { return *outer; }
+};
+
+template <class Ref>
+class join_inner<Ref, false>
+{
+public:
+	typedef typename std::decay<Ref>::type inner_type;
+
+private:
+	mutable non_propagating_cache<inner_type> cache_;
+
+public:
+	template <class Iter>
+	inner_type& get(const Iter& outer) const { return cache_.emplace(*outer); }
+};
+
+} // namespace ranges_detail
+
+template <class V>
+class join_view : public view_base
+{
+private:
+	typedef iterator_t<const V>                          outer_iterator;
+	typedef range_reference_t<const V>                   outer_reference;
+	typedef ranges_detail::join_inner<outer_reference>   inner_access;
+	typedef typename inner_access::inner_type            inner_range;
+	typedef iterator_t<inner_range>                      inner_iterator;
+
+	V            base_;
+	inner_access inner_;
+
+public:
+	class iterator
+	{
+	public:
+		typedef typename std::conditional<std::is_reference<outer_reference>::value,
+			ranges_detail::cap_category_t<ranges_detail::common_category_t<
+				ranges_detail::iter_category_t<outer_iterator>,
+				ranges_detail::iter_category_t<inner_iterator>>, forward_iterator_tag>,
+			input_iterator_tag>::type                                     iterator_category;
+		typedef typename iterator_traits<inner_iterator>::value_type      value_type;
+		typedef typename iterator_traits<inner_iterator>::pointer         pointer;
+		typedef typename iterator_traits<inner_iterator>::reference       reference;
+		typedef typename iterator_traits<inner_iterator>::difference_type difference_type;
+
+	private:
+		outer_iterator   outer_;
+		outer_iterator   outer_end_;
+		inner_iterator   inner_;
+		inner_iterator   inner_end_;
+		const join_view* parent_;
+
+		// 从 outer_ 开始找到第一个非空的内层范围
+		void satisfy()
+		{
+			for (; outer_ != outer_end_; ++outer_)
+			{
+				auto& inner = parent_->inner_.get(outer_);
+				inner_ = ranges::begin(inner);
+				inner_end_ = ranges::end(inner);
+				if (inner_ != inner_end_)
+					return;
+			}
+		}
+
+	public:
+		iterator() : outer_(), outer_end_(), inner_(), inner_end_(), parent_(nullptr) {}
+		iterator(const join_view* parent, outer_iterator outer, outer_iterator outer_end)
+			: outer_(outer), outer_end_(outer_end), inner_(), inner_end_(), parent_(parent)
+		{
+			satisfy();
+		}
+
+		reference operator*() const { return *inner_; }
+
+		iterator& operator++()
+		{
+			if (++inner_ == inner_end_)
+			{
+				++outer_;
+				satisfy();
+			}
+			return *this;
+		}
+		iterator  operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+		bool operator==(const iterator& rhs) const
+		{ return outer_ == rhs.outer_ && (outer_ == outer_end_ || inner_ == rhs.inner_); }
+		bool operator!=(const iterator& rhs) const
+		{ return !(*this == rhs); }
+	};
+
+public:
+	explicit join_view(V base) : base_(mystl::move(base)), inner_() {}
+
+	const V& base() const noexcept { return base_; }
+
+	iterator begin() const { return iterator(this, ranges::begin(base_), ranges::end(base_)); }
+	iterator end()   const { return iterator(this, ranges::end(base_), ranges::end(base_)); }
+};
+
+/*****************************************************************************************/
+// to
+// 把范围中的元素依次 push_back 到容器中, 能算出元素个数且容器有 reserve 时先 reserve
+
+namespace ranges_detail
+{
+
+template <class C, class R>
+auto reserve_hint(C& c, const R& r, int) -> decltype(c.reserve(ranges::size(r)), void())
+{
+	c.reserve(ranges::size(r));
+}
+
+template <class C, class R>
+void reserve_hint(C&, const R&, long)
+{
+}
+
+template <class C, class R>
+C to_container(R& r)
+{
+	C c;
+	ranges_detail::reserve_hint(c, r, 0);
+	auto last = ranges::end(r);
+	for (auto first = ranges::begin(r); first != last; ++first)
+		c.push_back(*first);
+	return c;
+}
+
+} // namespace ranges_detail
+
+// to<mystl::vector<int>>()
+template <class C>
+struct to_closure : closure_base
+{
+	template <class R>
+	C operator()(R&& r) const
+	{
+		return ranges_detail::to_container<C>(r);
+	}
+};
+
+// to<mystl::vector>(), 元素类型取范围的 value_type
+template <template <class...> class C>
+struct to_template_closure : closure_base
+{
+	template <class R>
+	C<range_value_t<typename std::remove_reference<R>::type>> operator()(R&& r) const
+	{
+		return ranges_detail::to_container<C<range_value_t<typename std::remove_reference<R>::type>>>(r);
+	}
+};
+
+template <class C>
+to_closure<C> to()
+{
+	return to_closure<C>();
+}
+
+template <template <class...> class C>
+to_template_closure<C> to()
+{
+	return to_template_closure<C>();
+}
+
+template <class C, class R>
+C to(R&& r)
+{
+	return ranges_detail::to_container<C>(r);
+}
+
+template <template <class...> class C, class R>
+C<range_value_t<typename std::remove_reference<R>::type>> to(R&& r)
+{
+	return ranges_detail::to_container<C<range_value_t<typename std::remove_reference<R>::type>>>(r);
+}
+
+/*****************************************************************************************/
+// 适配器对象
+// 以 views::filter(r, p) 的形式直接调用, 或以 views::filter(p) 得到闭包后用 | 连接
+
+struct all_fn : closure_base
+{
+	template <class R>
+	all_t<R> operator()(R&& r) const
+	{
+		return ranges_detail::all_impl(mystl::forward<R>(r), ranges_detail::all_kind<R>());
+	}
+};
+
+struct transform_fn
+{
+	template <class R, class F>
+	transform_view<all_t<R>, F> operator()(R&& r, F f) const
+	{
+		return transform_view<all_t<R>, F>(all_fn()(mystl::forward<R>(r)), mystl::move(f));
+	}
+
+	template <class F>
+	bound_closure<transform_fn, F> operator()(F f) const
+	{
+		return bound_closure<transform_fn, F>(mystl::move(f));
+	}
+};
+
+struct filter_fn
+{
+	template <class R, class P>
+	filter_view<all_t<R>, P> operator()(R&& r, P pred) const
+	{
+		return filter_view<all_t<R>, P>(all_fn()(mystl::forward<R>(r)), mystl::move(pred));
+	}
+
+	template <class P>
+	bound_closure<filter_fn, P> operator()(P pred) const
+	{
+		return bound_closure<filter_fn, P>(mystl::move(pred));
+	}
+};
+
+struct take_fn
+{
+	template <class R>
+	take_view<all_t<R>> operator()(R&& r, ptrdiff_t n) const
+	{
+		return take_view<all_t<R>>(all_fn()(mystl::forward<R>(r)), n);
+	}
+
+	bound_closure<take_fn, ptrdiff_t> operator()(ptrdiff_t n) const
+	{
+		return bound_closure<take_fn, ptrdiff_t>(n);
+	}
+};
+
+struct drop_fn
+{
+	template <class R>
+	drop_view<all_t<R>> operator()(R&& r, ptrdiff_t n) const
+	{
+		return drop_view<all_t<R>>(all_fn()(mystl::forward<R>(r)), n);
+	}
+
+	bound_closure<drop_fn, ptrdiff_t> operator()(ptrdiff_t n) const
+	{
+		return bound_closure<drop_fn, ptrdiff_t>(n);
+	}
+};
+
+struct chunk_fn
+{
+	template <class R>
+	chunk_view<all_t<R>> operator()(R&& r, ptrdiff_t n) const
+	{
+		return chunk_view<all_t<R>>(all_fn()(mystl::forward<R>(r)), n);
+	}
+
+	bound_closure<chunk_fn, ptrdiff_t> operator()(ptrdiff_t n) const
+	{
+		return bound_closure<chunk_fn, ptrdiff_t>(n);
+	}
+};
+
+struct stride_fn
+{
+	template <class R>
+	stride_view<all_t<R>> operator()(R&& r, ptrdiff_t n) const
+	{
+		return stride_view<all_t<R>>(all_fn()(mystl::forward<R>(r)), n);
+	}
+
+	bound_closure<stride_fn, ptrdiff_t> operator()(ptrdiff_t n) const
+	{
+		return bound_closure<stride_fn, ptrdiff_t>(n);
+	}
+};
+
+struct enumerate_fn : closure_base
+{
+	template <class R>
+	enumerate_view<all_t<R>> operator()(R&& r) const
+	{
+		return enumerate_view<all_t<R>>(all_fn()(mystl::forward<R>(r)));
+	}
+};
+
+struct join_fn : closure_base
+{
+	template <class R>
+	join_view<all_t<R>> operator()(R&& r) const
+	{
+		return join_view<all_t<R>>(all_fn()(mystl::forward<R>(r)));
+	}
+};
+
+struct zip_fn
+{
+	template <class R1, class R2>
+	zip_view<all_t<R1>, all_t<R2>> operator()(R1&& r1, R2&& r2) const
+	{
+		return zip_view<all_t<R1>, all_t<R2>>(all_fn()(mystl::forward<R1>(r1)),
+		                                      all_fn()(mystl::forward<R2>(r2)));
+	}
+};
+
+} // namespace ranges
+
+namespace views
+{
+
+constexpr ranges::all_fn       all{};
+constexpr ranges::transform_fn transform{};
+constexpr ranges::filter_fn    filter{};
+constexpr ranges::take_fn      take{};
+constexpr ranges::drop_fn      drop{};
+constexpr ranges::zip_fn       zip{};
+constexpr ranges::enumerate_fn enumerate{};
+constexpr ranges::chunk_fn     chunk{};
+constexpr ranges::stride_fn    stride{};
+constexpr ranges::join_fn      join{};
+
+} // namespace views
+} // namespace mystl
+#endif // !MYTINYSTL_RANGES_H_
@@ -0,0 +1,396 @@
+#ifndef MYTINYSTL_RING_QUEUE_H_
+#define MYTINYSTL_RING_QUEUE_H_
+
+// 这个头文件包含两个无锁的有界队列 spsc_ring 和 mpmc_queue
+// spsc_ring  : 单生产者单消费者的环形缓冲区
+// mpmc_queue : 多生产者多消费者的有界队列(Dmitry Vyukov 的序号算法)
+
+// notes:
+//
+// 两者的容量都向上取整为 2 的幂, 下标用不回绕的计数器表示, 槽位为 计数器 & mask, 存储来自 mystl::allocator
+// 生产者与消费者各自修改的数据放在不同的缓存行中, 避免伪共享
+//
+// spsc_ring:
+//   * 生产者只写 tail_, 消费者只写 head_; 双方各自缓存一份对方的下标, 只有缓存的下标显示队列满(空)时
+//     才去读对方的原子变量, 稳定状态下大多数操作不会访问对方所在的缓存行
+//   * push_n / pop_n 一次处理一批元素, 只发布一次下标
+//   * 只允许一个线程 push、一个线程 pop, 否则行为未定义
+//
+// mpmc_queue:
+//   * 每个槽位带一个序号, 生产者与消费者各自用 CAS 抢占 enqueue / dequeue 计数器, 再通过槽位序号交接元素
+//   * 槽位被抢占之后就必须完成交接, 所以要求 T 的移动构造、移动赋值与析构都不抛出异常;
+//     emplace 会先在槽位外构造好元素, 构造抛出异常时队列不受影响
+//
+// 两者都只提供 try_ 接口, 满(空)时立即返回 false, 是否自旋、让出或睡眠由调用者决定
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 缓存行大小, 需要避免伪共享或按缓存行对齐的结构以此为准
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif // !MYSTL_CACHE_LINE_SIZE
+
+// 不小于 n 的最小的 2 的幂, 至少为 2
+inline size_t ring_capacity_for(size_t n) noexcept
+{
+	size_t cap = 2;
+	while (cap < n)
+		cap <<= 1;
+	return cap;
+}
+
+/*****************************************************************************************/
+// spsc_ring
+// 单生产者单消费者的环形缓冲区
+/*****************************************************************************************/
+
+template <class T>
+class spsc_ring
+{
+public:
+	typedef T                   value_type;
+	typedef size_t              size_type;
+	typedef mystl::allocator<T> data_allocator;
+
+private:
+	char                pad0_[MYSTL_CACHE_LINE_SIZE];  // 与之前的对象隔开
+
+	// 只读部分
+	T*                  slots_;
+	size_type           mask_;
+	char                pad1_[MYSTL_CACHE_LINE_SIZE - sizeof(T*) - sizeof(size_type)];
+
+	// 消费者
+	std::atomic<size_t> head_;        // 下一个要读出的位置
+	size_type           tail_cache_;  // 消费者看到的 tail_
+	char                pad2_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_type)];
+
+	// 生产者
+	std::atomic<size_t> tail_;        // 下一个要写入的位置
+	size_type           head_cache_;  // 生产者看到的 head_
+	char                pad3_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_type)];
+
+public:
+	// 容量向上取整为 2 的幂
+	explicit spsc_ring(size_type capacity)
+		:slots_(nullptr), mask_(ring_capacity_for(capacity) - 1),
+		 head_(0), tail_cache_(0), tail_(0), head_cache_(0)
+	{
+		slots_ = data_allocator::allocate(mask_ + 1);
+	}
+
+	spsc_ring(const spsc_ring&) = delete;
+	spsc_ring& operator=(const spsc_ring&) = delete;
+
+	~spsc_ring()
+	{
+		const size_t t = tail_.load(std::memory_order_relaxed);
+		for (size_t h = head_.load(std::memory_order_relaxed); h != t; ++h)
+			data_allocator::destroy(slots_ + (h & mask_));
+		data_allocator::deallocate(slots_, mask_ + 1);
+	}
+
+	// 生产者接口
+
+	template <class ...Args>
+	bool try_emplace(Args&& ...args)
+	{
+		const size_t t = tail_.load(std::memory_order_relaxed);
+		if (t - head_cache_ > mask_)
+		{ // 缓存的 head 显示已满, 重新读取
+			head_cache_ = head_.load(std::memory_order_acquire);
+			if (t - head_cache_ > mask_)
+				return false;
+		}
+		data_allocator::construct(slots_ + (t & mask_), mystl::forward<Args>(args)...);
+		tail_.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_push(const value_type& value)
+	{ return try_emplace(value); }
+	bool try_push(value_type&& value)
+	{ return try_emplace(mystl::move(value)); }
+
+	// 从 first 开始最多写入 n 个元素, 返回实际写入的个数; 整批只发布一次
+	template <class InputIter>
+	size_type push_n(InputIter first, size_type n)
+	{
+		const size_t t = tail_.load(std::memory_order_relaxed);
+		size_type room = mask_ + 1 - (t - head_cache_);
+		if (room < n)
+		{
+			head_cache_ = head_.load(std::memory_order_acquire);
+			room = mask_ + 1 - (t - head_cache_);
+		}
+		if (n > room)
+			n = room;
+		size_type i = 0;
+		MYSTL_TRY
+		{
+			for (; i < n; ++i, ++first)
+				data_allocator::construct(slots_ + ((t + i) & mask_), *first);
+		}
+		MYSTL_CATCH_ALL
+		{
+			tail_.store(t + i, std::memory_order_release);
+			MYSTL_RETHROW;
+		}
+		tail_.store(t + n, std::memory_order_release);
+		return n;
+	}
+
+	// 消费者接口
+
+	bool try_pop(value_type& out)
+	{
+		const size_t h = head_.load(std::memory_order_relaxed);
+		if (h == tail_cache_)
+		{ // 缓存的 tail 显示为空, 重新读取
+			tail_cache_ = tail_.load(std::memory_order_acquire);
+			if (h == tail_cache_)
+				return false;
+		}
+		T* slot = slots_ + (h & mask_);
+		out = mystl::move(*slot);
+		data_allocator::destroy(slot);
+		head_.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 队首元素, 为空时返回 nullptr; 之后用 pop 移除
+	value_type* front()
+	{
+		const size_t h = head_.load(std::memory_order_relaxed);
+		if (h == tail_cache_)
+		{
+			tail_cache_ = tail_.load(std::memory_order_acquire);
+			if (h == tail_cache_)
+				return nullptr;
+		}
+		return slots_ + (h & mask_);
+	}
+
+	// 移除队首元素, 调用前 front() 必须不为 nullptr
+	void pop()
+	{
+		const size_t h = head_.load(std::memory_order_relaxed);
+		data_allocator::destroy(slots_ + (h & mask_));
+		head_.store(h + 1, std::memory_order_release);
+	}
+
+	// 最多读出 n 个元素写入 out, 返回实际读出的个数; 整批只发布一次
+	template <class OutputIter>
+	size_type pop_n(OutputIter out, size_type n)
+	{
+		const size_t h = head_.load(std::memory_order_relaxed);
+		size_type avail = tail_cache_ - h;
+		if (avail < n)
+		{
+			tail_cache_ = tail_.load(std::memory_order_acquire);
+			avail = tail_cache_ - h;
+		}
+		if (n > avail)
+			n = avail;
+		size_type i = 0;
+		MYSTL_TRY
+		{
+			for (; i < n; ++i, ++out)
+			{
+				T* slot = slots_ + ((h + i) & mask_);
+				*out = mystl::move(*slot);
+				data_allocator::destroy(slot);
+			}
+		}
+		MYSTL_CATCH_ALL
+		{
+			head_.store(h + i, std::memory_order_release);
+			MYSTL_RETHROW;
+		}
+		head_.store(h + n, std::memory_order_release);
+		return n;
+	}
+
+	// 容量相关, size 与 empty 在并发时只是近似值
+
+	size_type capacity() const noexcept
+	{ return mask_ + 1; }
+
+	size_type size() const noexcept
+	{
+		const size_t h = head_.load(std::memory_order_acquire);
+		const size_t t = tail_.load(std::memory_order_acquire);
+		return t - h;
+	}
+
+	bool empty() const noexcept
+	{ return size() == 0; }
+};
+
+/*****************************************************************************************/
+// mpmc_queue
+// 多生产者多消费者的有界队列
+/*****************************************************************************************/
+
+template <class T>
+class mpmc_queue
+{
+	static_assert(std::is_nothrow_move_constructible<T>::value &&
+	              std::is_nothrow_move_assignable<T>::value &&
+	              std::is_nothrow_destructible<T>::value,
+	              "mpmc_queue requires T to be nothrow movable and destructible");
+
+public:
+	typedef T      value_type;
+	typedef size_t size_type;
+
+private:
+	// 槽位: seq == 位置 时可写, seq == 位置 + 1 时可读
+	struct cell
+	{
+		std::atomic<size_t>      seq;
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* value() noexcept { return reinterpret_cast<T*>(storage); }
+	};
+	typedef mystl::allocator<cell> cell_allocator;
+
+	char                pad0_[MYSTL_CACHE_LINE_SIZE];  // 与之前的对象隔开
+
+	// 只读部分
+	cell*               cells_;
+	size_type           mask_;
+	char                pad1_[MYSTL_CACHE_LINE_SIZE - sizeof(cell*) - sizeof(size_type)];
+
+	std::atomic<size_t> enqueue_pos_;
+	char                pad2_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+	std::atomic<size_t> dequeue_pos_;
+	char                pad3_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+public:
+	// 容量向上取整为 2 的幂
+	explicit mpmc_queue(size_type capacity)
+		:cells_(nullptr), mask_(ring_capacity_for(capacity) - 1),
+		 enqueue_pos_(0), dequeue_pos_(0)
+	{
+		cells_ = cell_allocator::allocate(mask_ + 1);
+		for (size_type i = 0; i <= mask_; ++i)
+			::new (static_cast<void*>(&cells_[i].seq)) std::atomic<size_t>(i);
+	}
+
+	mpmc_queue(const mpmc_queue&) = delete;
+	mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+	~mpmc_queue()
+	{
+		const size_t e = enqueue_pos_.load(std::memory_order_relaxed);
+		for (size_t d = dequeue_pos_.load(std::memory_order_relaxed); d != e; ++d)
+			mystl::destroy(cells_[d & mask_].value());
+		cell_allocator::deallocate(cells_, mask_ + 1);
+	}
+
+	// 生产者接口, 队列满时返回 false
+
+	template <class ...Args>
+	bool try_emplace(Args&& ...args)
+	{
+		T value(mystl::forward<Args>(args)...);
+		return try_push(mystl::move(value));
+	}
+
+	bool try_push(const value_type& value)
+	{
+		T tmp(value);
+		return try_push(mystl::move(tmp));
+	}
+
+	bool try_push(value_type&& value) noexcept
+	{
+		size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+		cell* c;
+		for (;;)
+		{
+			c = &cells_[pos & mask_];
+			const size_t seq = c->seq.load(std::memory_order_acquire);
+			const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (dif == 0)
+			{
+				if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+			{ // 槽位中还有上一轮未取走的元素, 队列已满
+				return false;
+			}
+			else
+			{ // 其他生产者已经抢先, 重新读取
+				pos = enqueue_pos_.load(std::memory_order_relaxed);
+			}
+		}
+		mystl::construct(c->value(), mystl::move(value));
+		c->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 消费者接口, 队列空时返回 false
+
+	bool try_pop(value_type& out) noexcept
+	{
+		size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+		cell* c;
+		for (;;)
+		{
+			c = &cells_[pos & mask_];
+			const size_t seq = c->seq.load(std::memory_order_acquire);
+			const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+			if (dif == 0)
+			{
+				if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+			{ // 元素尚未写入, 队列为空
+				return false;
+			}
+			else
+			{
+				pos = dequeue_pos_.load(std::memory_order_relaxed);
+			}
+		}
+		out = mystl::move(*c->value());
+		mystl::destroy(c->value());
+		c->seq.store(pos + mask_ + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 容量相关, size 与 empty 在并发时只是近似值
+
+	size_type capacity() const noexcept
+	{ return mask_ + 1; }
+
+	size_type size() const noexcept
+	{
+		const size_t d = dequeue_pos_.load(std::memory_order_acquire);
+		const size_t e = enqueue_pos_.load(std::memory_order_acquire);
+		return e > d ? e - d : 0;
+	}
+
+	bool empty() const noexcept
+	{ return size() == 0; }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_RING_QUEUE_H_
@@ -0,0 +1,651 @@
+#ifndef MYTINYSTL_STATIC_SEARCH_H_
+#define MYTINYSTL_STATIC_SEARCH_H_
+
+// 这个头文件包含两个只读的静态查找结构: eytzinger_index 与 static_bplus_tree
+// 两者都由一个已排序的序列一次性构建, 之后只支持查找, 用于替代在大型有序数组上的二分查找
+
+// notes:
+//
+// 在有序数组上做二分查找时, 前几轮访问的中点彼此相距很远, 每一轮几乎都是一次缓存未命中,
+// 并且下一次访问的地址依赖本次比较的结果, 硬件无法提前加载
+// 本文件中的两种结构通过改变元素在内存中的排列来改善访问局部性:
+//   * eytzinger_index   : 按照完全二叉树的层序(BFS)存放元素, 节点 k 的孩子为 2k 与 2k+1,
+//                         同一路径上相邻几层的节点在内存中相邻, 并且可以提前预取四层之后的节点
+//   * static_bplus_tree : 每个节点存放 16 个键, 扇出为 17 的静态 B+ 树, 节点按缓存行对齐,
+//                         节点内部用 SIMD 一次比较多个键, 叶子层就是原有序数组本身
+// 两者在构建时都要求输入已按 Compare 排序, 构建后不可修改
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "fuctional.h"
+#include "iterator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 辅助函数
+/*****************************************************************************************/
+
+// 缓存行大小, 查找结构的存储区以此对齐
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif // !MYSTL_CACHE_LINE_SIZE
+
+// 统计二进制中 1 的个数
+inline unsigned search_popcount(unsigned x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_popcount(x));
+#else
+	unsigned r = 0;
+	for (; x != 0; x &= x - 1)
+		++r;
+	return r;
+#endif
+}
+
+// 统计二进制末尾连续的 1 的个数
+inline unsigned search_trailing_ones(size_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return ~x == 0 ? static_cast<unsigned>(sizeof(size_t) * 8)
+	               : static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(~x)));
+#else
+	unsigned r = 0;
+	for (; x & 1; x >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+// 预取一个地址, 地址无效时也不会产生错误, 因此可以越过数组末尾
+inline void search_prefetch_address(uintptr_t address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(reinterpret_cast<const void*>(address));
+#else
+	(void)address;
+#endif
+}
+
+// search_storage
+// 按缓存行对齐的定长数组, 元素个数在构造时确定
+template <class T>
+class search_storage
+{
+	static_assert(alignof(T) <= MYSTL_CACHE_LINE_SIZE,
+	              "over-aligned types are not supported by search_storage");
+
+private:
+	void*  raw_;   // operator new 返回的原始地址
+	T*     data_;  // 对齐之后的首地址
+	size_t size_;  // 已构造的元素个数
+
+public:
+	search_storage() noexcept
+		:raw_(nullptr), data_(nullptr), size_(0)
+	{
+	}
+
+	// 只分配 n 个元素的空间, 元素由使用者通过 push 逐个构造
+	explicit search_storage(size_t n)
+		:raw_(nullptr), data_(nullptr), size_(0)
+	{
+		if (n == 0)
+			return;
+		raw_ = ::operator new(n * sizeof(T) + MYSTL_CACHE_LINE_SIZE);
+		const uintptr_t addr = reinterpret_cast<uintptr_t>(raw_);
+		const uintptr_t aligned = (addr + MYSTL_CACHE_LINE_SIZE - 1)
+			& ~static_cast<uintptr_t>(MYSTL_CACHE_LINE_SIZE - 1);
+		data_ = reinterpret_cast<T*>(aligned);
+	}
+
+	search_storage(const search_storage& rhs)
+		:search_storage(rhs.size_)
+	{
+		MYSTL_TRY
+		{
+			for (; size_ < rhs.size_; ++size_)
+				mystl::construct(data_ + size_, rhs.data_[size_]);
+		}
+		MYSTL_CATCH_ALL
+		{
+			release();
+			MYSTL_RETHROW;
+		}
+	}
+
+	search_storage(search_storage&& rhs) noexcept
+		:raw_(rhs.raw_), data_(rhs.data_), size_(rhs.size_)
+	{
+		rhs.raw_ = nullptr;
+		rhs.data_ = nullptr;
+		rhs.size_ = 0;
+	}
+
+	search_storage& operator=(const search_storage& rhs)
+	{
+		if (this != &rhs)
+		{
+			search_storage tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	search_storage& operator=(search_storage&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			release();
+			swap(rhs);
+		}
+		return *this;
+	}
+
+	~search_storage()
+	{
+		release();
+	}
+
+	T*       data()       noexcept { return data_; }
+	const T* data() const noexcept { return data_; }
+	size_t   size() const noexcept { return size_; }
+
+	// 在第 size() 个位置构造一个元素
+	template <class... Args>
+	void push(Args&& ...args)
+	{
+		mystl::construct(data_ + size_, mystl::forward<Args>(args)...);
+		++size_;
+	}
+
+	void swap(search_storage& rhs) noexcept
+	{
+		mystl::swap(raw_, rhs.raw_);
+		mystl::swap(data_, rhs.data_);
+		mystl::swap(size_, rhs.size_);
+	}
+
+private:
+	void release() noexcept
+	{
+		if (raw_ != nullptr)
+		{
+			mystl::destroy(data_, data_ + size_);
+			::operator delete(raw_);
+		}
+		raw_ = nullptr;
+		data_ = nullptr;
+		size_ = 0;
+	}
+};
+
+/*****************************************************************************************/
+// eytzinger_index
+// 把有序序列重新排列为层序存放的完全二叉树, 位置 0 不属于树, 树根位于位置 1
+// 查找时从根出发, 每一步 k = 2k + (b[k] < x), 整个过程没有分支;
+// 循环结束后 k 的二进制末尾连续的 1 对应最后几次"向右走", 去掉它们(以及再一位)就得到答案
+/*****************************************************************************************/
+
+template <class T, class Compare = mystl::less<T>>
+class eytzinger_index
+{
+public:
+	typedef T                 value_type;
+	typedef const T*          const_pointer;
+	typedef const T&          const_reference;
+	typedef size_t            size_type;
+	typedef Compare           value_compare;
+
+private:
+	// 每个缓存行能容纳的元素个数; 节点 k 往下第四层的 16 个后代位于 b[16k, 16k + 16),
+	// 元素为 4 字节时恰好是一个缓存行, 在循环中提前预取它们即可隐藏访存延迟
+	static constexpr size_t kPrefetchStride =
+		sizeof(T) < MYSTL_CACHE_LINE_SIZE ? MYSTL_CACHE_LINE_SIZE / sizeof(T) : 1;
+
+	search_storage<T> data_;  // data_[1, size_] 为树, data_[0] 只是占位
+	size_type         size_;
+	Compare           comp_;
+
+public:
+	eytzinger_index()
+		:data_(), size_(0), comp_()
+	{
+	}
+
+	// 以已排序的区间 [first, last) 构建
+	template <class ForwardIter, typename std::enable_if<
+		mystl::is_forward_iterator<ForwardIter>::value, int>::type = 0>
+	eytzinger_index(ForwardIter first, ForwardIter last, const Compare& comp = Compare())
+		:data_(), size_(0), comp_(comp)
+	{
+		const size_type n = static_cast<size_type>(mystl::distance(first, last));
+		if (n == 0)
+			return;
+		// 先把有序序列复制到临时区, 再按层序依次构造, 保证已构造的元素总是一段连续前缀
+		search_storage<T> sorted(n);
+		for (; first != last; ++first)
+			sorted.push(*first);
+		search_storage<T> storage(n + 1);
+		storage.push(sorted.data()[0]);
+		emplace_level_order(storage, sorted.data(), n);
+		data_.swap(storage);
+		size_ = n;
+	}
+
+	eytzinger_index(const eytzinger_index&) = default;
+	eytzinger_index(eytzinger_index&&) noexcept = default;
+	eytzinger_index& operator=(const eytzinger_index&) = default;
+	eytzinger_index& operator=(eytzinger_index&&) noexcept = default;
+
+public:
+	size_type     size()     const noexcept { return size_; }
+	bool          empty()    const noexcept { return size_ == 0; }
+	value_compare value_comp() const        { return comp_; }
+
+	// 第一个不小于 x 的元素, 不存在时返回 nullptr
+	const_pointer lower_bound(const T& x) const
+	{
+		const T* b = data_.data();
+		size_type k = 1;
+		while (k <= size_)
+		{
+			prefetch_descendants(k);
+			k = 2 * k + (comp_(b[k], x) ? 1 : 0);
+		}
+		k >>= search_trailing_ones(k) + 1;
+		return k == 0 ? nullptr : b + k;
+	}
+
+	// 第一个大于 x 的元素, 不存在时返回 nullptr
+	const_pointer upper_bound(const T& x) const
+	{
+		const T* b = data_.data();
+		size_type k = 1;
+		while (k <= size_)
+		{
+			prefetch_descendants(k);
+			k = 2 * k + (comp_(x, b[k]) ? 0 : 1);
+		}
+		k >>= search_trailing_ones(k) + 1;
+		return k == 0 ? nullptr : b + k;
+	}
+
+	// 是否存在与 x 等价的元素
+	bool contains(const T& x) const
+	{
+		const T* p = lower_bound(x);
+		return p != nullptr && !comp_(x, *p);
+	}
+
+	void swap(eytzinger_index& rhs) noexcept
+	{
+		data_.swap(rhs.data_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(comp_, rhs.comp_);
+	}
+
+private:
+	// 先用中序遍历求出每个层序位置对应的有序序号, 再按层序位置从小到大构造
+	static void emplace_level_order(search_storage<T>& storage, const T* sorted, size_type n)
+	{
+		size_type* order = static_cast<size_type*>(::operator new(sizeof(size_type) * (n + 1)));
+		size_type rank = 0;
+		assign_rank(order, rank, 1, n);
+		MYSTL_TRY
+		{
+			for (size_type i = 1; i <= n; ++i)
+				storage.push(sorted[order[i]]);
+		}
+		MYSTL_CATCH_ALL
+		{
+			::operator delete(order);
+			MYSTL_RETHROW;
+		}
+		::operator delete(order);
+	}
+
+	// 中序遍历以 k 为根的子树, 为每个层序位置分配有序序号
+	// 递归深度为树高, 即 log2(n)
+	static void assign_rank(size_type* order, size_type& rank, size_type k, size_type n)
+	{
+		if (k > n)
+			return;
+		assign_rank(order, rank, 2 * k, n);
+		order[k] = rank++;
+		assign_rank(order, rank, 2 * k + 1, n);
+	}
+
+	void prefetch_descendants(size_type k) const noexcept
+	{
+		search_prefetch_address(reinterpret_cast<uintptr_t>(data_.data())
+		                        + k * kPrefetchStride * sizeof(T));
+	}
+};
+
+template <class T, class Compare>
+void swap(eytzinger_index<T, Compare>& lhs, eytzinger_index<T, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// static_bplus_tree
+// 静态 B+ 树: 每个节点 16 个键, 扇出 17, 自底向上分层存放在一块连续内存中
+//   * 第 0 层为叶子层, 就是原有序序列(尾部用最大元素补齐到 16 的倍数), 因此查找结果可以直接作为
+//     指向有序序列的指针, 同时 [begin(), end()) 就是原序列
+//   * 第 h 层节点 j 的第 i 个键为其第 i + 1 个孩子子树中的最小键, 缺失的孩子用最大元素补齐
+// 查找时每层统计节点中小于 x 的键的个数 r, 下一层的节点为 j * 17 + r; 统计过程对 int/unsigned/
+// float/double 配合默认的 less 使用 SSE2 一次比较多个键, 其余类型使用无分支的标量循环
+/*****************************************************************************************/
+
+// bplus_node_rank
+// 在一个 16 个键的节点中统计 comp(key, x) 与 comp(x, key) 成立的个数
+template <class T, class Compare>
+struct bplus_node_rank
+{
+	static size_t count_less(const T* node, const T& x, const Compare& comp)
+	{
+		size_t r = 0;
+		for (size_t i = 0; i < 16; ++i)
+			r += comp(node[i], x) ? 1 : 0;
+		return r;
+	}
+
+	static size_t count_greater(const T* node, const T& x, const Compare& comp)
+	{
+		size_t r = 0;
+		for (size_t i = 0; i < 16; ++i)
+			r += comp(x, node[i]) ? 1 : 0;
+		return r;
+	}
+};
+
+#if defined(__SSE2__)
+
+// 4 个 32 位比较结果合并为 16 位掩码后计数
+inline size_t bplus_mask_count_epi32(__m128i m0, __m128i m1, __m128i m2, __m128i m3) noexcept
+{
+	const __m128i p = _mm_packs_epi16(_mm_packs_epi32(m0, m1), _mm_packs_epi32(m2, m3));
+	return search_popcount(static_cast<unsigned>(_mm_movemask_epi8(p)));
+}
+
+template <>
+struct bplus_node_rank<int, mystl::less<int>>
+{
+	static size_t count_less(const int* node, const int& x, const mystl::less<int>&)
+	{
+		const __m128i xv = _mm_set1_epi32(x);
+		const __m128i* p = reinterpret_cast<const __m128i*>(node);
+		return bplus_mask_count_epi32(_mm_cmpgt_epi32(xv, _mm_load_si128(p)),
+		                              _mm_cmpgt_epi32(xv, _mm_load_si128(p + 1)),
+		                              _mm_cmpgt_epi32(xv, _mm_load_si128(p + 2)),
+		                              _mm_cmpgt_epi32(xv, _mm_load_si128(p + 3)));
+	}
+
+	static size_t count_greater(const int* node, const int& x, const mystl::less<int>&)
+	{
+		const __m128i xv = _mm_set1_epi32(x);
+		const __m128i* p = reinterpret_cast<const __m128i*>(node);
+		return bplus_mask_count_epi32(_mm_cmpgt_epi32(_mm_load_si128(p), xv),
+		                              _mm_cmpgt_epi32(_mm_load_si128(p + 1), xv),
+		                              _mm_cmpgt_epi32(_mm_load_si128(p + 2), xv),
+		                              _mm_cmpgt_epi32(_mm_load_si128(p + 3), xv));
+	}
+};
+
+// SSE2 只有有符号比较, 无符号数先翻转最高位再比较
+template <>
+struct bplus_node_rank<unsigned, mystl::less<unsigned>>
+{
+	static __m128i load_flipped(const __m128i* p) noexcept
+	{
+		return _mm_xor_si128(_mm_load_si128(p), _mm_set1_epi32(INT32_MIN));
+	}
+
+	static size_t count_less(const unsigned* node, const unsigned& x, const mystl::less<unsigned>&)
+	{
+		const __m128i xv = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(x)), _mm_set1_epi32(INT32_MIN));
+		const __m128i* p = reinterpret_cast<const __m128i*>(node);
+		return bplus_mask_count_epi32(_mm_cmpgt_epi32(xv, load_flipped(p)),
+		                              _mm_cmpgt_epi32(xv, load_flipped(p + 1)),
+		                              _mm_cmpgt_epi32(xv, load_flipped(p + 2)),
+		                              _mm_cmpgt_epi32(xv, load_flipped(p + 3)));
+	}
+
+	static size_t count_greater(const unsigned* node, const unsigned& x, const mystl::less<unsigned>&)
+	{
+		const __m128i xv = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(x)), _mm_set1_epi32(INT32_MIN));
+		const __m128i* p = reinterpret_cast<const __m128i*>(node);
+		return bplus_mask_count_epi32(_mm_cmpgt_epi32(load_flipped(p), xv),
+		                              _mm_cmpgt_epi32(load_flipped(p + 1), xv),
+		                              _mm_cmpgt_epi32(load_flipped(p + 2), xv),
+		                              _mm_cmpgt_epi32(load_flipped(p + 3), xv));
+	}
+};
+
+template <>
+struct bplus_node_rank<float, mystl::less<float>>
+{
+	static size_t count_less(const float* node, const float& x, const mystl::less<float>&)
+	{
+		const __m128 xv = _mm_set1_ps(x);
+		unsigned m = 0;
+		for (size_t i = 0; i < 4; ++i)
+			m |= static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(_mm_load_ps(node + 4 * i), xv))) << (4 * i);
+		return search_popcount(m);
+	}
+
+	static size_t count_greater(const float* node, const float& x, const mystl::less<float>&)
+	{
+		const __m128 xv = _mm_set1_ps(x);
+		unsigned m = 0;
+		for (size_t i = 0; i < 4; ++i)
+			m |= static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(xv, _mm_load_ps(node + 4 * i)))) << (4 * i);
+		return search_popcount(m);
+	}
+};
+
+template <>
+struct bplus_node_rank<double, mystl::less<double>>
+{
+	static size_t count_less(const double* node, const double& x, const mystl::less<double>&)
+	{
+		const __m128d xv = _mm_set1_pd(x);
+		unsigned m = 0;
+		for (size_t i = 0; i < 8; ++i)
+			m |= static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(_mm_load_pd(node + 2 * i), xv))) << (2 * i);
+		return search_popcount(m);
+	}
+
+	static size_t count_greater(const double* node, const double& x, const mystl::less<double>&)
+	{
+		const __m128d xv = _mm_set1_pd(x);
+		unsigned m = 0;
+		for (size_t i = 0; i < 8; ++i)
+			m |= static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(xv, _mm_load_pd(node + 2 * i)))) << (2 * i);
+		return search_popcount(m);
+	}
+};
+
+#endif // __SSE2__
+
+template <class T, class Compare = mystl::less<T>>
+class static_bplus_tree
+{
+public:
+	typedef T                 value_type;
+	typedef const T*          const_pointer;
+	typedef const T&          const_reference;
+	typedef const T*          const_iterator;
+	typedef size_t            size_type;
+	typedef Compare           value_compare;
+
+private:
+	static constexpr size_type kNodeKeys = 16;
+	static constexpr size_type kFanout = kNodeKeys + 1;
+	// 17^16 > 2^64, 层数不会超过 16
+	static constexpr size_type kMaxHeight = 16;
+
+	typedef bplus_node_rank<T, Compare> node_rank;
+
+	search_storage<T> data_;                 // 第 0 层(叶子)在最前, 之后依次为更高的层
+	size_type         size_;                 // 有效元素个数
+	size_type         height_;               // 层数
+	size_type         offset_[kMaxHeight];   // 每层首个键在 data_ 中的位置
+	size_type         blocks_[kMaxHeight];   // 每层的节点个数
+	Compare           comp_;
+
+public:
+	static_bplus_tree()
+		:data_(), size_(0), height_(0), offset_(), blocks_(), comp_()
+	{
+	}
+
+	// 以已排序的区间 [first, last) 构建
+	template <class ForwardIter, typename std::enable_if<
+		mystl::is_forward_iterator<ForwardIter>::value, int>::type = 0>
+	static_bplus_tree(ForwardIter first, ForwardIter last, const Compare& comp = Compare())
+		:data_(), size_(0), height_(0), offset_(), blocks_(), comp_(comp)
+	{
+		const size_type n = static_cast<size_type>(mystl::distance(first, last));
+		if (n == 0)
+			return;
+		// 计算各层的节点个数与偏移
+		size_type total = 0;
+		size_type blocks = (n + kNodeKeys - 1) / kNodeKeys;
+		size_type h = 0;
+		for (;;)
+		{
+			blocks_[h] = blocks;
+			offset_[h] = total;
+			total += blocks * kNodeKeys;
+			++h;
+			if (blocks == 1)
+				break;
+			blocks = (blocks + kFanout - 1) / kFanout;
+		}
+
+		search_storage<T> storage(total);
+		// 叶子层: 原序列, 不足 16 的倍数时用最后一个(最大的)元素补齐
+		for (; first != last; ++first)
+			storage.push(*first);
+		const T* leaf = storage.data();
+		while (storage.size() < blocks_[0] * kNodeKeys)
+			storage.push(leaf[n - 1]);
+		// 内部层: 第 l 层节点 j 的第 i 个键为孩子 j * 17 + i + 1 子树的最小键,
+		// 即该子树最左叶子的第一个键; 子树不存在时用最大元素
+		for (size_type l = 1; l < h; ++l)
+		{
+			for (size_type j = 0; j < blocks_[l]; ++j)
+			{
+				for (size_type i = 0; i < kNodeKeys; ++i)
+				{
+					size_type child = j * kFanout + i + 1;
+					size_type index = n;
+					if (child < blocks_[l - 1])
+					{
+						for (size_type d = l - 1; d > 0; --d)
+							child *= kFanout;
+						index = child * kNodeKeys;
+					}
+					storage.push(index < n ? leaf[index] : leaf[n - 1]);
+				}
+			}
+		}
+		data_.swap(storage);
+		size_ = n;
+		height_ = h;
+	}
+
+	static_bplus_tree(const static_bplus_tree&) = default;
+	static_bplus_tree(static_bplus_tree&&) noexcept = default;
+	static_bplus_tree& operator=(const static_bplus_tree&) = default;
+	static_bplus_tree& operator=(static_bplus_tree&&) noexcept = default;
+
+public:
+	// 叶子层即原有序序列
+	const_iterator begin() const noexcept { return data_.data(); }
+	const_iterator end()   const noexcept { return data_.data() + size_; }
+
+	size_type     size()     const noexcept { return size_; }
+	bool          empty()    const noexcept { return size_ == 0; }
+	value_compare value_comp() const        { return comp_; }
+
+	// 第一个不小于 x 的元素, 不存在时返回 end()
+	const_iterator lower_bound(const T& x) const
+	{
+		if (size_ == 0)
+			return end();
+		const T* base = data_.data();
+		size_type k = 0;
+		for (size_type h = height_ - 1; h > 0; --h)
+		{
+			const size_type r = node_rank::count_less(base + offset_[h] + k * kNodeKeys, x, comp_);
+			k = k * kFanout + r;
+			// 指向不存在的孩子说明 x 大于其前面所有子树的元素, 取最后一个节点即可
+			k = k < blocks_[h - 1] ? k : blocks_[h - 1] - 1;
+		}
+		const size_type pos = k * kNodeKeys + node_rank::count_less(base + k * kNodeKeys, x, comp_);
+		return base + (pos < size_ ? pos : size_);
+	}
+
+	// 第一个大于 x 的元素, 不存在时返回 end()
+	const_iterator upper_bound(const T& x) const
+	{
+		if (size_ == 0)
+			return end();
+		const T* base = data_.data();
+		size_type k = 0;
+		for (size_type h = height_ - 1; h > 0; --h)
+		{
+			const size_type r = kNodeKeys
+				- node_rank::count_greater(base + offset_[h] + k * kNodeKeys, x, comp_);
+			k = k * kFanout + r;
+			k = k < blocks_[h - 1] ? k : blocks_[h - 1] - 1;
+		}
+		const size_type pos = k * kNodeKeys + kNodeKeys
+			- node_rank::count_greater(base + k * kNodeKeys, x, comp_);
+		return base + (pos < size_ ? pos : size_);
+	}
+
+	// 是否存在与 x 等价的元素
+	bool contains(const T& x) const
+	{
+		const_iterator p = lower_bound(x);
+		return p != end() && !comp_(x, *p);
+	}
+
+	void swap(static_bplus_tree& rhs) noexcept
+	{
+		data_.swap(rhs.data_);
+		mystl::swap(size_, rhs.size_);
+		mystl::swap(height_, rhs.height_);
+		for (size_type i = 0; i < kMaxHeight; ++i)
+		{
+			mystl::swap(offset_[i], rhs.offset_[i]);
+			mystl::swap(blocks_[i], rhs.blocks_[i]);
+		}
+		mystl::swap(comp_, rhs.comp_);
+	}
+};
+
+template <class T, class Compare>
+void swap(static_bplus_tree<T, Compare>& lhs, static_bplus_tree<T, Compare>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_STATIC_SEARCH_H_
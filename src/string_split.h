@@ -0,0 +1,542 @@
+#ifndef MYTINYSTL_STRING_SPLIT_H_
+#define MYTINYSTL_STRING_SPLIT_H_
+
+// 这个头文件包含三个惰性的字符串切分视图, 以及对应的函数 split, tokenize, lines
+// basic_split_view    : 按分隔串切分, 保留空片段, n 个分隔符得到 n + 1 个片段
+// basic_tokenize_view : 按分隔字符集合切分, 跳过空片段(与 strtok 相同)
+// basic_lines_view    : 按 '\n' 切分为行, 去掉行尾的 '\r', 末尾的换行不产生空行
+
+// notes:
+//
+// 视图不复制也不持有文本, 每个片段都是指向原文本的 basic_string_view, 遍历时不申请内存;
+// 文本必须比视图及其迭代器活得更久
+// 迭代器是前向迭代器, 通过 mystl::iterator_traits 可以直接用于 mystl 的各种算法
+//
+// 分隔符是单个字符(或 tokenize 的集合不超过 4 个字符)时使用 delim_scanner:
+// char 用 SSE2 一次比较 64 个字节, 把其中所有分隔符的位置记在一个 64 位的掩码里,
+// 之后的片段只需从掩码中取出下一位, 短片段密集的文本(日志, CSV)每 64 字节只扫描一次
+// 分隔串长于一个字符时使用 string_detail::find
+
+#include <cstdint>
+
+#include "iterator.h"
+#include "string_view.h"
+
+namespace mystl
+{
+
+namespace string_detail
+{
+
+// 64 位整数最低位 1 的位置
+inline unsigned string_ctz64(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+	unsigned r = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+// delim_scanner
+// 计算一段文本(最多 64 个字符)中分隔符位置的掩码, 第 i 位为 1 表示 p[i] 是分隔符
+
+// 单个分隔符按值保存, 多个时只保存指针, 分隔符集合需要与文本一样保持有效
+
+// 通用版本: 逐个在分隔符集合中查找
+template <class CharT, class Traits, bool Plain = is_plain_char<CharT, Traits>::value>
+class delim_scanner
+{
+private:
+	const CharT* delims_;
+	size_t       count_;
+	CharT        single_;
+
+public:
+	delim_scanner(const CharT* delims, size_t count) noexcept
+		:delims_(delims), count_(count), single_(count != 0 ? delims[0] : CharT())
+	{
+	}
+
+	uint64_t mask(const CharT* p, size_t len) const noexcept
+	{
+		uint64_t m = 0;
+		for (size_t i = 0; i < len; ++i)
+		{
+			const bool hit = count_ == 1 ? Traits::eq(p[i], single_)
+			                             : Traits::find(delims_, count_, p[i]) != nullptr;
+			if (hit)
+				m |= uint64_t(1) << i;
+		}
+		return m;
+	}
+};
+
+// char 版本: 集合不超过 4 个字符时用 SSE2 比较, 否则查位图
+template <class CharT, class Traits>
+class delim_scanner<CharT, Traits, true>
+{
+private:
+	static constexpr size_t kMaxSimdDelims = 4;
+
+	byte_set set_;
+	char     delims_[kMaxSimdDelims];
+	size_t   count_;
+
+public:
+	delim_scanner(const char* delims, size_t count) noexcept
+		:set_(delims, count), count_(count)
+	{
+		for (size_t i = 0; i < kMaxSimdDelims; ++i)
+			delims_[i] = i < count ? delims[i] : (count != 0 ? delims[0] : '\0');
+	}
+
+	uint64_t mask(const char* p, size_t len) const noexcept
+	{
+#if defined(MYSTL_STRING_SSE2)
+		if (len == 64 && count_ != 0 && count_ <= kMaxSimdDelims)
+		{
+			// 不足 4 个时用第一个字符补齐, 多比较几次比按个数分支更快
+			const __m128i d0 = _mm_set1_epi8(delims_[0]);
+			const __m128i d1 = _mm_set1_epi8(delims_[1]);
+			const __m128i d2 = _mm_set1_epi8(delims_[2]);
+			const __m128i d3 = _mm_set1_epi8(delims_[3]);
+			uint64_t m = 0;
+			for (unsigned k = 0; k < 4; ++k)
+			{
+				const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+				__m128i eq = _mm_cmpeq_epi8(x, d0);
+				if (count_ > 1)
+				{
+					eq = _mm_or_si128(eq, _mm_cmpeq_epi8(x, d1));
+					eq = _mm_or_si128(eq, _mm_or_si128(_mm_cmpeq_epi8(x, d2), _mm_cmpeq_epi8(x, d3)));
+				}
+				m |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(eq))) << (16 * k);
+			}
+			return m;
+		}
+#endif
+		uint64_t m = 0;
+		for (size_t i = 0; i < len; ++i)
+		{
+			if (set_.contains(p[i]))
+				m |= uint64_t(1) << i;
+		}
+		return m;
+	}
+};
+
+template <class CharT, class Traits>
+constexpr size_t delim_scanner<CharT, Traits, true>::kMaxSimdDelims;
+
+// 扫描位置: 当前块的起点与块中尚未取出的分隔符掩码
+struct scan_cursor
+{
+	size_t   block = static_cast<size_t>(-1);
+	uint64_t mask  = 0;
+};
+
+// 返回 [from, size) 中下一个分隔符的位置, 没有则返回 size
+// 同一个 cursor 上 from 单调增加时, 每 64 个字符只计算一次掩码
+template <class Scanner, class CharT>
+size_t scan_next(const Scanner& sc, const CharT* data, size_t size, size_t from, scan_cursor& cur) noexcept
+{
+	if (from < cur.block || from - cur.block >= 64)
+	{
+		if (from >= size)
+			return size;
+		cur.block = from;
+		cur.mask = sc.mask(data + from, mystl::min(static_cast<size_t>(64), size - from));
+	}
+	else
+	{
+		cur.mask &= ~uint64_t(0) << (from - cur.block);
+	}
+	for (;;)
+	{
+		if (cur.mask != 0)
+			return cur.block + string_ctz64(cur.mask);
+		if (size - cur.block <= 64)
+			return size;
+		cur.block += 64;
+		cur.mask = sc.mask(data + cur.block, mystl::min(static_cast<size_t>(64), size - cur.block));
+	}
+}
+
+} // namespace string_detail
+
+/*****************************************************************************************/
+// basic_split_view
+// 按分隔串或单个分隔字符切分 text, 保留空片段; 分隔串为空时整个 text 是唯一的片段
+/*****************************************************************************************/
+
+template <class CharT, class Traits = mystl::char_traits<CharT>>
+class basic_split_view
+{
+public:
+	typedef basic_string_view<CharT, Traits>              view_type;
+	typedef string_detail::delim_scanner<CharT, Traits>   scanner_type;
+	typedef size_t                                        size_type;
+
+	class iterator : public mystl::iterator<mystl::forward_iterator_tag, view_type,
+	                                        ptrdiff_t, const view_type*, const view_type&>
+	{
+	private:
+		const basic_split_view*    parent_;
+		view_type                  token_;   // 当前片段
+		size_type                  pos_;     // 当前片段的起点, 结束时为 npos
+		string_detail::scan_cursor cursor_;
+
+		friend class basic_split_view;
+
+		iterator(const basic_split_view* parent, size_type pos) noexcept
+			:parent_(parent), pos_(pos)
+		{
+			if (pos_ != view_type::npos)
+				token_ = parent_->token_at(pos_, cursor_);
+		}
+
+	public:
+		iterator() noexcept
+			:parent_(nullptr), pos_(view_type::npos)
+		{
+		}
+
+		const view_type& operator*()  const noexcept { return token_; }
+		const view_type* operator->() const noexcept { return &token_; }
+
+		iterator& operator++() noexcept
+		{
+			MYSTL_DEBUG(pos_ != view_type::npos);
+			const size_type end = pos_ + token_.size();
+			if (end == parent_->text_.size())
+			{
+				pos_ = view_type::npos;
+			}
+			else
+			{
+				pos_ = end + parent_->dlen_;
+				token_ = parent_->token_at(pos_, cursor_);
+			}
+			return *this;
+		}
+
+		iterator operator++(int) noexcept
+		{
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const iterator& rhs) const noexcept { return pos_ == rhs.pos_; }
+		bool operator!=(const iterator& rhs) const noexcept { return pos_ != rhs.pos_; }
+	};
+
+	typedef iterator const_iterator;
+
+private:
+	view_type    text_;
+	view_type    delim_;    // 分隔串, 以单个字符构造时为空
+	size_type    dlen_;     // 分隔符的长度
+	scanner_type scanner_;  // 分隔符只有一个字符时使用
+
+public:
+	basic_split_view(view_type text, view_type delim) noexcept
+		:text_(text), delim_(delim), dlen_(delim.size()), scanner_(delim.data(), delim.size())
+	{
+	}
+
+	basic_split_view(view_type text, CharT delim) noexcept
+		:text_(text), delim_(), dlen_(1), scanner_(&delim, 1)
+	{
+	}
+
+	iterator begin() const noexcept { return iterator(this, 0); }
+	iterator end()   const noexcept { return iterator(); }
+
+	view_type text() const noexcept { return text_; }
+
+private:
+	// 从 pos 开始的片段
+	view_type token_at(size_type pos, string_detail::scan_cursor& cursor) const noexcept
+	{
+		size_type end = text_.size();
+		if (dlen_ == 1)
+		{
+			end = string_detail::scan_next(scanner_, text_.data(), text_.size(), pos, cursor);
+		}
+		else if (dlen_ != 0)
+		{
+			end = text_.find(delim_, pos);
+			if (end == view_type::npos)
+				end = text_.size();
+		}
+		return view_type(text_.data() + pos, end - pos);
+	}
+};
+
+/*****************************************************************************************/
+// basic_tokenize_view
+// 以 delims 中的任一字符为分隔, 跳过空片段, 只由分隔符组成的 text 没有片段
+/*****************************************************************************************/
+
+template <class CharT, class Traits = mystl::char_traits<CharT>>
+class basic_tokenize_view
+{
+public:
+	typedef basic_string_view<CharT, Traits>              view_type;
+	typedef string_detail::delim_scanner<CharT, Traits>   scanner_type;
+	typedef size_t                                        size_type;
+
+	class iterator : public mystl::iterator<mystl::forward_iterator_tag, view_type,
+	                                        ptrdiff_t, const view_type*, const view_type&>
+	{
+	private:
+		const basic_tokenize_view* parent_;
+		view_type                  token_;   // 当前片段
+		size_type                  pos_;     // 当前片段的起点, 结束时为 npos
+		string_detail::scan_cursor cursor_;
+
+		friend class basic_tokenize_view;
+
+		iterator(const basic_tokenize_view* parent, size_type from) noexcept
+			:parent_(parent), pos_(0)
+		{
+			advance_from(from);
+		}
+
+		// 从 from 开始找下一个非空片段
+		void advance_from(size_type from) noexcept
+		{
+			const view_type text = parent_->text_;
+			for (;;)
+			{
+				if (from >= text.size())
+				{
+					pos_ = view_type::npos;
+					return;
+				}
+				const size_type end = string_detail::scan_next(parent_->scanner_, text.data(),
+				                                               text.size(), from, cursor_);
+				if (end != from)
+				{
+					pos_ = from;
+					token_ = view_type(text.data() + from, end - from);
+					return;
+				}
+				from = end + 1;
+			}
+		}
+
+	public:
+		iterator() noexcept
+			:parent_(nullptr), pos_(view_type::npos)
+		{
+		}
+
+		const view_type& operator*()  const noexcept { return token_; }
+		const view_type* operator->() const noexcept { return &token_; }
+
+		iterator& operator++() noexcept
+		{
+			MYSTL_DEBUG(pos_ != view_type::npos);
+			advance_from(pos_ + token_.size() + 1);
+			return *this;
+		}
+
+		iterator operator++(int) noexcept
+		{
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const iterator& rhs) const noexcept { return pos_ == rhs.pos_; }
+		bool operator!=(const iterator& rhs) const noexcept { return pos_ != rhs.pos_; }
+	};
+
+	typedef iterator const_iterator;
+
+private:
+	view_type    text_;
+	view_type    delims_;
+	scanner_type scanner_;
+
+public:
+	basic_tokenize_view(view_type text, view_type delims) noexcept
+		:text_(text), delims_(delims), scanner_(delims.data(), delims.size())
+	{
+	}
+
+	iterator begin() const noexcept { return iterator(this, 0); }
+	iterator end()   const noexcept { return iterator(); }
+
+	view_type text()   const noexcept { return text_; }
+	view_type delims() const noexcept { return delims_; }
+};
+
+/*****************************************************************************************/
+// basic_lines_view
+// 按 '\n' 切分, 每行去掉结尾的 '\r'; 空文本没有行, 以换行结尾时不产生最后的空行
+/*****************************************************************************************/
+
+template <class CharT, class Traits = mystl::char_traits<CharT>>
+class basic_lines_view
+{
+public:
+	typedef basic_string_view<CharT, Traits>              view_type;
+	typedef string_detail::delim_scanner<CharT, Traits>   scanner_type;
+	typedef size_t                                        size_type;
+
+	class iterator : public mystl::iterator<mystl::forward_iterator_tag, view_type,
+	                                        ptrdiff_t, const view_type*, const view_type&>
+	{
+	private:
+		const basic_lines_view*    parent_;
+		view_type                  line_;    // 当前行, 不含 '\r' 与 '\n'
+		size_type                  pos_;     // 当前行的起点, 结束时为 npos
+		size_type                  next_;    // 下一行的起点
+		string_detail::scan_cursor cursor_;
+
+		friend class basic_lines_view;
+
+		iterator(const basic_lines_view* parent, size_type from) noexcept
+			:parent_(parent), pos_(0), next_(0)
+		{
+			advance_from(from);
+		}
+
+		void advance_from(size_type from) noexcept
+		{
+			const view_type text = parent_->text_;
+			if (from >= text.size())
+			{
+				pos_ = view_type::npos;
+				return;
+			}
+			const size_type end = string_detail::scan_next(parent_->scanner_, text.data(),
+			                                               text.size(), from, cursor_);
+			size_type len = end - from;
+			if (len != 0 && Traits::eq(text[end - 1], CharT('\r')))
+				--len;
+			pos_ = from;
+			next_ = end + 1;
+			line_ = view_type(text.data() + from, len);
+		}
+
+	public:
+		iterator() noexcept
+			:parent_(nullptr), pos_(view_type::npos), next_(0)
+		{
+		}
+
+		const view_type& operator*()  const noexcept { return line_; }
+		const view_type* operator->() const noexcept { return &line_; }
+
+		iterator& operator++() noexcept
+		{
+			MYSTL_DEBUG(pos_ != view_type::npos);
+			advance_from(next_);
+			return *this;
+		}
+
+		iterator operator++(int) noexcept
+		{
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const iterator& rhs) const noexcept { return pos_ == rhs.pos_; }
+		bool operator!=(const iterator& rhs) const noexcept { return pos_ != rhs.pos_; }
+	};
+
+	typedef iterator const_iterator;
+
+private:
+	view_type    text_;
+	scanner_type scanner_;
+
+public:
+	explicit basic_lines_view(view_type text) noexcept
+		:text_(text), scanner_(newline(), 1)
+	{
+	}
+
+	iterator begin() const noexcept { return iterator(this, 0); }
+	iterator end()   const noexcept { return iterator(); }
+
+	view_type text() const noexcept { return text_; }
+
+private:
+	static const CharT* newline() noexcept
+	{
+		static const CharT nl = CharT('\n');
+		return &nl;
+	}
+};
+
+typedef basic_split_view<char>       split_view;
+typedef basic_split_view<wchar_t>    wsplit_view;
+typedef basic_tokenize_view<char>    tokenize_view;
+typedef basic_tokenize_view<wchar_t> wtokenize_view;
+typedef basic_lines_view<char>       lines_view;
+typedef basic_lines_view<wchar_t>    wlines_view;
+
+/*****************************************************************************************/
+// split / tokenize / lines
+// 模板版本接受 basic_string_view; char 另有非模板版本, 可以直接传入 C 字符串或 mystl::string
+/*****************************************************************************************/
+
+template <class CharT, class Traits>
+basic_split_view<CharT, Traits>
+split(basic_string_view<CharT, Traits> text, basic_string_view<CharT, Traits> delim) noexcept
+{
+	return basic_split_view<CharT, Traits>(text, delim);
+}
+
+template <class CharT, class Traits>
+basic_split_view<CharT, Traits>
+split(basic_string_view<CharT, Traits> text, CharT delim) noexcept
+{
+	return basic_split_view<CharT, Traits>(text, delim);
+}
+
+inline split_view split(string_view text, string_view delim) noexcept
+{
+	return split_view(text, delim);
+}
+
+inline split_view split(string_view text, char delim) noexcept
+{
+	return split_view(text, delim);
+}
+
+template <class CharT, class Traits>
+basic_tokenize_view<CharT, Traits>
+tokenize(basic_string_view<CharT, Traits> text, basic_string_view<CharT, Traits> delims) noexcept
+{
+	return basic_tokenize_view<CharT, Traits>(text, delims);
+}
+
+inline tokenize_view tokenize(string_view text, string_view delims) noexcept
+{
+	return tokenize_view(text, delims);
+}
+
+template <class CharT, class Traits>
+basic_lines_view<CharT, Traits> lines(basic_string_view<CharT, Traits> text) noexcept
+{
+	return basic_lines_view<CharT, Traits>(text);
+}
+
+inline lines_view lines(string_view text) noexcept
+{
+	return lines_view(text);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_STRING_SPLIT_H_
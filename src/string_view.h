@@ -0,0 +1,1007 @@
+#ifndef MYTINYSTL_STRING_VIEW_H_
+#define MYTINYSTL_STRING_VIEW_H_
+
+// 这个头文件包含模板类 char_traits 与 basic_string_view, 以及字符串查找使用的底层函数
+// char_traits       : 字符特性, 提供字符串的基本操作
+// basic_string_view : 不持有内存的只读字符串视图
+
+// notes:
+//
+// basic_string 与 basic_string_view 的所有查找函数都转交给 string_detail 中的函数:
+//   * find / rfind            : char 配合默认的 char_traits 时, 使用 SSE2 同时比较模式串首尾两个字符,
+//                               一次筛选 16 个候选位置, 只对首尾都相同的位置做完整比较; 其余情况逐个比较
+//   * find_first_of 等四个函数 : char 使用 256 位的位图做集合判断, 每个字符只查一次表;
+//                               find_first_of 在支持 SSE4.2 且集合不超过 16 个字符时使用 PCMPESTRI
+// 要求 CharT 的相等即按位相等时才会选用上述快速路径(见 string_detail::is_plain_char)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <ostream>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYSTL_STRING_SSE2 1
+#endif
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define MYSTL_STRING_SSE42 1
+#endif
+
+#include "algobase.h"
+#include "fuctional.h"
+#include "iterator.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// char_traits
+
+template <class CharType>
+struct char_traits
+{
+	typedef CharType char_type;
+
+	static bool eq(char_type a, char_type b) noexcept
+	{
+		return a == b;
+	}
+
+	static bool lt(char_type a, char_type b) noexcept
+	{
+		return a < b;
+	}
+
+	static size_t length(const char_type* str) noexcept
+	{
+		size_t len = 0;
+		for (; *str != char_type(0); ++str)
+			++len;
+		return len;
+	}
+
+	static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+	{
+		for (; n != 0; --n, ++s1, ++s2)
+		{
+			if (*s1 < *s2)
+				return -1;
+			if (*s2 < *s1)
+				return 1;
+		}
+		return 0;
+	}
+
+	static const char_type* find(const char_type* s, size_t n, char_type ch) noexcept
+	{
+		for (; n != 0; --n, ++s)
+		{
+			if (*s == ch)
+				return s;
+		}
+		return nullptr;
+	}
+
+	static char_type* copy(char_type* dst, const char_type* src, size_t n) noexcept
+	{
+		MYSTL_DEBUG(src + n <= dst || dst + n <= src);
+		char_type* r = dst;
+		for (; n != 0; --n, ++dst, ++src)
+			*dst = *src;
+		return r;
+	}
+
+	static char_type* move(char_type* dst, const char_type* src, size_t n) noexcept
+	{
+		char_type* r = dst;
+		if (dst < src)
+		{
+			for (; n != 0; --n, ++dst, ++src)
+				*dst = *src;
+		}
+		else if (src < dst)
+		{
+			dst += n;
+			src += n;
+			for (; n != 0; --n)
+				*--dst = *--src;
+		}
+		return r;
+	}
+
+	static char_type* fill(char_type* dst, char_type ch, size_t count) noexcept
+	{
+		char_type* r = dst;
+		for (; count > 0; --count, ++dst)
+			*dst = ch;
+		return r;
+	}
+};
+
+// Partialized. char_traits<char>
+template <>
+struct char_traits<char>
+{
+	typedef char char_type;
+
+	static bool eq(char_type a, char_type b) noexcept
+	{ return a == b; }
+
+	// 与 memcmp 一致, 按 unsigned char 比较
+	static bool lt(char_type a, char_type b) noexcept
+	{ return static_cast<unsigned char>(a) < static_cast<unsigned char>(b); }
+
+	static size_t length(const char_type* str) noexcept
+	{ return std::strlen(str); }
+
+	static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+	{ return n == 0 ? 0 : std::memcmp(s1, s2, n); }
+
+	static const char_type* find(const char_type* s, size_t n, char_type ch) noexcept
+	{ return n == 0 ? nullptr : static_cast<const char_type*>(std::memchr(s, ch, n)); }
+
+	static char_type* copy(char_type* dst, const char_type* src, size_t n) noexcept
+	{
+		MYSTL_DEBUG(src + n <= dst || dst + n <= src);
+		return n == 0 ? dst : static_cast<char_type*>(std::memcpy(dst, src, n));
+	}
+
+	static char_type* move(char_type* dst, const char_type* src, size_t n) noexcept
+	{ return n == 0 ? dst : static_cast<char_type*>(std::memmove(dst, src, n)); }
+
+	static char_type* fill(char_type* dst, char_type ch, size_t count) noexcept
+	{ return count == 0 ? dst : static_cast<char_type*>(std::memset(dst, ch, count)); }
+};
+
+// Partialized. char_traits<wchar_t>
+template <>
+struct char_traits<wchar_t>
+{
+	typedef wchar_t char_type;
+
+	static bool eq(char_type a, char_type b) noexcept
+	{ return a == b; }
+
+	static bool lt(char_type a, char_type b) noexcept
+	{ return a < b; }
+
+	static size_t length(const char_type* str) noexcept
+	{ return std::wcslen(str); }
+
+	static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept
+	{ return n == 0 ? 0 : std::wmemcmp(s1, s2, n); }
+
+	static const char_type* find(const char_type* s, size_t n, char_type ch) noexcept
+	{ return n == 0 ? nullptr : std::wmemchr(s, ch, n); }
+
+	static char_type* copy(char_type* dst, const char_type* src, size_t n) noexcept
+	{
+		MYSTL_DEBUG(src + n <= dst || dst + n <= src);
+		return n == 0 ? dst : std::wmemcpy(dst, src, n);
+	}
+
+	static char_type* move(char_type* dst, const char_type* src, size_t n) noexcept
+	{ return n == 0 ? dst : std::wmemmove(dst, src, n); }
+
+	static char_type* fill(char_type* dst, char_type ch, size_t count) noexcept
+	{ return count == 0 ? dst : std::wmemset(dst, ch, count); }
+};
+
+/*****************************************************************************************/
+// string_detail
+// basic_string 与 basic_string_view 共用的查找函数, 参数与返回值的含义与成员函数相同, 找不到时返回 npos
+/*****************************************************************************************/
+
+namespace string_detail
+{
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+// 只有 char 配合 char_traits<char> 时才能按字节比较
+template <class CharT, class Traits>
+struct is_plain_char
+	: m_bool_constant<std::is_same<CharT, char>::value &&
+	                  std::is_same<Traits, char_traits<char>>::value> {};
+
+// 最低位 1 的位置
+inline unsigned string_ctz(unsigned x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_ctz(x));
+#else
+	unsigned r = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++r;
+	return r;
+#endif
+}
+
+// 最高位 1 的位置
+inline unsigned string_msb(unsigned x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 31u - static_cast<unsigned>(__builtin_clz(x));
+#else
+	unsigned r = 0;
+	for (; x >>= 1; )
+		++r;
+	return r;
+#endif
+}
+
+// 字节集合, 用 256 位的位图表示
+class byte_set
+{
+private:
+	uint64_t bits_[4];
+
+public:
+	byte_set(const char* s, size_t n) noexcept
+	{
+		bits_[0] = bits_[1] = bits_[2] = bits_[3] = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const unsigned char c = static_cast<unsigned char>(s[i]);
+			bits_[c >> 6] |= uint64_t(1) << (c & 63);
+		}
+	}
+
+	bool contains(char ch) const noexcept
+	{
+		const unsigned char c = static_cast<unsigned char>(ch);
+		return (bits_[c >> 6] >> (c & 63)) & 1;
+	}
+};
+
+// find
+
+// 通用版本: 用 Traits::find 定位首字符, 再比较其余部分
+template <class CharT, class Traits>
+size_t find(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m, m_false_type) noexcept
+{
+	if (m == 0)
+		return pos <= n ? pos : npos;
+	if (pos >= n || n - pos < m)
+		return npos;
+	const CharT* cur = h + pos;
+	const CharT* last = h + n - m + 1;  // 最后一个候选位置之后
+	while (cur < last)
+	{
+		cur = Traits::find(cur, static_cast<size_t>(last - cur), s[0]);
+		if (cur == nullptr)
+			return npos;
+		if (Traits::compare(cur + 1, s + 1, m - 1) == 0)
+			return static_cast<size_t>(cur - h);
+		++cur;
+	}
+	return npos;
+}
+
+// char 版本: 同时比较首尾字符, 一次筛选 16 个候选位置
+template <class CharT, class Traits>
+size_t find(const char* h, size_t n, const char* s, size_t pos, size_t m, m_true_type) noexcept
+{
+	if (m == 0)
+		return pos <= n ? pos : npos;
+	if (pos >= n || n - pos < m)
+		return npos;
+	if (m == 1)
+	{
+		const void* p = std::memchr(h + pos, s[0], n - pos);
+		return p == nullptr ? npos : static_cast<size_t>(static_cast<const char*>(p) - h);
+	}
+	// 先用 memchr 跳到首字符第一次出现的位置, 首字符少见时可以直接跳过大段内容
+	const void* head = std::memchr(h + pos, s[0], n - m + 1 - pos);
+	if (head == nullptr)
+		return npos;
+	size_t i = static_cast<size_t>(static_cast<const char*>(head) - h);
+#if defined(MYSTL_STRING_SSE2)
+	const __m128i first = _mm_set1_epi8(s[0]);
+	const __m128i last = _mm_set1_epi8(s[m - 1]);
+	// 本轮的候选位置为 [i, i + 16), 需要读取到 h[i + 15 + m - 1]
+	for (; i + 15 + m <= n; i += 16)
+	{
+		const __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+		const __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + m - 1));
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl))));
+		while (mask != 0)
+		{
+			const unsigned bit = string_ctz(mask);
+			if (std::memcmp(h + i + bit + 1, s + 1, m - 2) == 0)
+				return i + bit;
+			mask &= mask - 1;
+		}
+	}
+#endif
+	// 剩余的候选位置
+	for (; i + m <= n; ++i)
+	{
+		const void* p = std::memchr(h + i, s[0], n - m + 1 - i);
+		if (p == nullptr)
+			return npos;
+		i = static_cast<size_t>(static_cast<const char*>(p) - h);
+		if (h[i + m - 1] == s[m - 1] && std::memcmp(h + i + 1, s + 1, m - 2) == 0)
+			return i;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m) noexcept
+{
+	return string_detail::find<CharT, Traits>(h, n, s, pos, m, is_plain_char<CharT, Traits>());
+}
+
+template <class CharT, class Traits>
+size_t find_char(const CharT* h, size_t n, CharT ch, size_t pos) noexcept
+{
+	if (pos >= n)
+		return npos;
+	const CharT* p = Traits::find(h + pos, n - pos, ch);
+	return p == nullptr ? npos : static_cast<size_t>(p - h);
+}
+
+// rfind
+
+// 通用版本: 从后向前逐个比较
+template <class CharT, class Traits>
+size_t rfind(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m, m_false_type) noexcept
+{
+	if (m > n)
+		return npos;
+	size_t i = mystl::min(pos, n - m);
+	if (m == 0)
+		return i;
+	for (;; --i)
+	{
+		if (Traits::eq(h[i], s[0]) && Traits::compare(h + i + 1, s + 1, m - 1) == 0)
+			return i;
+		if (i == 0)
+			return npos;
+	}
+}
+
+// char 版本: 与 find 相同的首尾筛选, 从后向前处理每 16 个候选位置
+template <class CharT, class Traits>
+size_t rfind(const char* h, size_t n, const char* s, size_t pos, size_t m, m_true_type) noexcept
+{
+	if (m > n)
+		return npos;
+	size_t hi = mystl::min(pos, n - m);  // 最后一个候选位置
+	if (m == 0)
+		return hi;
+	if (m == 1)
+	{
+		for (size_t i = hi + 1; i > 0; --i)
+		{
+			if (h[i - 1] == s[0])
+				return i - 1;
+		}
+		return npos;
+	}
+	size_t end = hi + 1;  // 尚未处理的候选位置为 [0, end)
+#if defined(MYSTL_STRING_SSE2)
+	const __m128i first = _mm_set1_epi8(s[0]);
+	const __m128i last = _mm_set1_epi8(s[m - 1]);
+	for (; end >= 16; end -= 16)
+	{
+		const size_t b = end - 16;
+		const __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + b));
+		const __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + b + m - 1));
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl))));
+		while (mask != 0)
+		{
+			const unsigned bit = string_msb(mask);
+			if (std::memcmp(h + b + bit + 1, s + 1, m - 2) == 0)
+				return b + bit;
+			mask &= ~(1u << bit);
+		}
+	}
+#endif
+	for (; end > 0; --end)
+	{
+		const size_t i = end - 1;
+		if (h[i] == s[0] && h[i + m - 1] == s[m - 1] && std::memcmp(h + i + 1, s + 1, m - 2) == 0)
+			return i;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t rfind(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m) noexcept
+{
+	return string_detail::rfind<CharT, Traits>(h, n, s, pos, m, is_plain_char<CharT, Traits>());
+}
+
+template <class CharT, class Traits>
+size_t rfind_char(const CharT* h, size_t n, CharT ch, size_t pos) noexcept
+{
+	if (n == 0)
+		return npos;
+	for (size_t i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+	{
+		if (Traits::eq(h[i - 1], ch))
+			return i - 1;
+	}
+	return npos;
+}
+
+// find_first_of / find_first_not_of / find_last_of / find_last_not_of
+
+// 通用版本: 用 Traits::find 在集合中查找每个字符
+template <class CharT, class Traits>
+size_t find_first_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m, m_false_type) noexcept
+{
+	for (size_t i = pos; i < n; ++i)
+	{
+		if (Traits::find(s, m, h[i]) != nullptr)
+			return i;
+	}
+	return npos;
+}
+
+// char 版本: 集合不超过 16 个字符时使用 PCMPESTRI, 否则查位图
+template <class CharT, class Traits>
+size_t find_first_of(const char* h, size_t n, const char* s, size_t pos, size_t m, m_true_type) noexcept
+{
+	if (m == 0 || pos >= n)
+		return npos;
+	if (m == 1)
+		return string_detail::find_char<char, Traits>(h, n, s[0], pos);
+	size_t i = pos;
+#if defined(MYSTL_STRING_SSE42)
+	if (m <= 16)
+	{
+		// 集合复制到局部缓冲区, 避免越过 s 的末尾读取
+		alignas(16) char set_buf[16] = {};
+		std::memcpy(set_buf, s, m);
+		const __m128i set = _mm_load_si128(reinterpret_cast<const __m128i*>(set_buf));
+		const int len = static_cast<int>(m);
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+			const int idx = _mm_cmpestri(set, len, block, 16,
+			                             _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+			if (idx < 16)
+				return i + static_cast<size_t>(idx);
+		}
+	}
+#endif
+	const byte_set set(s, m);
+	for (; i < n; ++i)
+	{
+		if (set.contains(h[i]))
+			return i;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_first_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m) noexcept
+{
+	return string_detail::find_first_of<CharT, Traits>(h, n, s, pos, m, is_plain_char<CharT, Traits>());
+}
+
+template <class CharT, class Traits>
+size_t find_first_not_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m, m_false_type) noexcept
+{
+	for (size_t i = pos; i < n; ++i)
+	{
+		if (Traits::find(s, m, h[i]) == nullptr)
+			return i;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_first_not_of(const char* h, size_t n, const char* s, size_t pos, size_t m, m_true_type) noexcept
+{
+	const byte_set set(s, m);
+	for (size_t i = pos; i < n; ++i)
+	{
+		if (!set.contains(h[i]))
+			return i;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_first_not_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m) noexcept
+{
+	return string_detail::find_first_not_of<CharT, Traits>(h, n, s, pos, m, is_plain_char<CharT, Traits>());
+}
+
+template <class CharT, class Traits>
+size_t find_last_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m, m_false_type) noexcept
+{
+	if (n == 0 || m == 0)
+		return npos;
+	for (size_t i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+	{
+		if (Traits::find(s, m, h[i - 1]) != nullptr)
+			return i - 1;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_last_of(const char* h, size_t n, const char* s, size_t pos, size_t m, m_true_type) noexcept
+{
+	if (n == 0 || m == 0)
+		return npos;
+	const byte_set set(s, m);
+	for (size_t i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+	{
+		if (set.contains(h[i - 1]))
+			return i - 1;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_last_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m) noexcept
+{
+	return string_detail::find_last_of<CharT, Traits>(h, n, s, pos, m, is_plain_char<CharT, Traits>());
+}
+
+template <class CharT, class Traits>
+size_t find_last_not_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m, m_false_type) noexcept
+{
+	if (n == 0)
+		return npos;
+	for (size_t i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+	{
+		if (Traits::find(s, m, h[i - 1]) == nullptr)
+			return i - 1;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_last_not_of(const char* h, size_t n, const char* s, size_t pos, size_t m, m_true_type) noexcept
+{
+	if (n == 0)
+		return npos;
+	const byte_set set(s, m);
+	for (size_t i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+	{
+		if (!set.contains(h[i - 1]))
+			return i - 1;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_last_not_of(const CharT* h, size_t n, const CharT* s, size_t pos, size_t m) noexcept
+{
+	return string_detail::find_last_not_of<CharT, Traits>(h, n, s, pos, m, is_plain_char<CharT, Traits>());
+}
+
+// 单个字符的 not_of
+template <class CharT, class Traits>
+size_t find_first_not_of_char(const CharT* h, size_t n, CharT ch, size_t pos) noexcept
+{
+	for (size_t i = pos; i < n; ++i)
+	{
+		if (!Traits::eq(h[i], ch))
+			return i;
+	}
+	return npos;
+}
+
+template <class CharT, class Traits>
+size_t find_last_not_of_char(const CharT* h, size_t n, CharT ch, size_t pos) noexcept
+{
+	if (n == 0)
+		return npos;
+	for (size_t i = mystl::min(pos, n - 1) + 1; i > 0; --i)
+	{
+		if (!Traits::eq(h[i - 1], ch))
+			return i - 1;
+	}
+	return npos;
+}
+
+// 比较两个字符串, 先比较共同长度的部分, 再比较长度
+template <class CharT, class Traits>
+int compare(const CharT* s1, size_t n1, const CharT* s2, size_t n2) noexcept
+{
+	const int r = Traits::compare(s1, s2, mystl::min(n1, n2));
+	if (r != 0)
+		return r;
+	return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+}
+
+} // namespace string_detail
+
+/*****************************************************************************************/
+// basic_string_view
+// 模板参数 CharT 代表字符类型，Traits 代表字符特性
+/*****************************************************************************************/
+
+template <class CharT, class Traits = mystl::char_traits<CharT>>
+class basic_string_view
+{
+public:
+	typedef Traits                                  traits_type;
+	typedef CharT                                   value_type;
+	typedef const CharT*                            pointer;
+	typedef const CharT*                            const_pointer;
+	typedef const CharT&                            reference;
+	typedef const CharT&                            const_reference;
+	typedef const CharT*                            const_iterator;
+	typedef const_iterator                          iterator;
+	typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+	typedef const_reverse_iterator                  reverse_iterator;
+	typedef size_t                                  size_type;
+	typedef ptrdiff_t                               difference_type;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+	const_pointer data_;
+	size_type     size_;
+
+public:
+	// 构造、复制函数
+	constexpr basic_string_view() noexcept
+		:data_(nullptr), size_(0)
+	{
+	}
+
+	constexpr basic_string_view(const CharT* str, size_type count) noexcept
+		:data_(str), size_(count)
+	{
+	}
+
+	basic_string_view(const CharT* str) noexcept
+		:data_(str), size_(traits_type::length(str))
+	{
+	}
+
+	basic_string_view(const basic_string_view&) noexcept = default;
+	basic_string_view& operator=(const basic_string_view&) noexcept = default;
+
+	// 迭代器相关操作
+	constexpr const_iterator         begin()   const noexcept { return data_; }
+	constexpr const_iterator         end()     const noexcept { return data_ + size_; }
+	constexpr const_iterator         cbegin()  const noexcept { return data_; }
+	constexpr const_iterator         cend()    const noexcept { return data_ + size_; }
+	const_reverse_iterator           rbegin()  const noexcept { return const_reverse_iterator(end()); }
+	const_reverse_iterator           rend()    const noexcept { return const_reverse_iterator(begin()); }
+	const_reverse_iterator           crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator           crend()   const noexcept { return rend(); }
+
+	// 容量相关操作
+	constexpr size_type size()     const noexcept { return size_; }
+	constexpr size_type length()   const noexcept { return size_; }
+	constexpr bool      empty()    const noexcept { return size_ == 0; }
+	constexpr size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(CharT); }
+
+	// 访问元素相关操作
+	const_reference operator[](size_type n) const
+	{
+		MYSTL_DEBUG(n < size_);
+		return data_[n];
+	}
+
+	const_reference at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(n >= size_, "basic_string_view<Char, Traits>::at() subscript out of range");
+		return data_[n];
+	}
+
+	const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return data_[0];
+	}
+
+	const_reference back()  const
+	{
+		MYSTL_DEBUG(!empty());
+		return data_[size_ - 1];
+	}
+
+	constexpr const_pointer data() const noexcept { return data_; }
+
+	// 修改视图
+	void remove_prefix(size_type n)
+	{
+		MYSTL_DEBUG(n <= size_);
+		data_ += n;
+		size_ -= n;
+	}
+
+	void remove_suffix(size_type n)
+	{
+		MYSTL_DEBUG(n <= size_);
+		size_ -= n;
+	}
+
+	void swap(basic_string_view& rhs) noexcept
+	{
+		mystl::swap(data_, rhs.data_);
+		mystl::swap(size_, rhs.size_);
+	}
+
+	// 字符串操作
+
+	size_type copy(CharT* dst, size_type count, size_type pos = 0) const
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view<Char, Traits>::copy's pos out of range");
+		const size_type len = mystl::min(count, size_ - pos);
+		traits_type::copy(dst, data_ + pos, len);
+		return len;
+	}
+
+	basic_string_view substr(size_type pos = 0, size_type count = npos) const
+	{
+		THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view<Char, Traits>::substr's pos out of range");
+		return basic_string_view(data_ + pos, mystl::min(count, size_ - pos));
+	}
+
+	// compare
+
+	int compare(basic_string_view v) const noexcept
+	{ return string_detail::compare<CharT, Traits>(data_, size_, v.data_, v.size_); }
+
+	int compare(size_type pos1, size_type count1, basic_string_view v) const
+	{ return substr(pos1, count1).compare(v); }
+
+	int compare(size_type pos1, size_type count1, basic_string_view v,
+	            size_type pos2, size_type count2) const
+	{ return substr(pos1, count1).compare(v.substr(pos2, count2)); }
+
+	int compare(const CharT* s) const
+	{ return compare(basic_string_view(s)); }
+
+	int compare(size_type pos1, size_type count1, const CharT* s) const
+	{ return substr(pos1, count1).compare(basic_string_view(s)); }
+
+	int compare(size_type pos1, size_type count1, const CharT* s, size_type count2) const
+	{ return substr(pos1, count1).compare(basic_string_view(s, count2)); }
+
+	// starts_with / ends_with / contains
+
+	bool starts_with(basic_string_view v) const noexcept
+	{ return size_ >= v.size_ && traits_type::compare(data_, v.data_, v.size_) == 0; }
+	bool starts_with(CharT ch) const noexcept
+	{ return !empty() && traits_type::eq(front(), ch); }
+	bool starts_with(const CharT* s) const
+	{ return starts_with(basic_string_view(s)); }
+
+	bool ends_with(basic_string_view v) const noexcept
+	{ return size_ >= v.size_ && traits_type::compare(data_ + size_ - v.size_, v.data_, v.size_) == 0; }
+	bool ends_with(CharT ch) const noexcept
+	{ return !empty() && traits_type::eq(back(), ch); }
+	bool ends_with(const CharT* s) const
+	{ return ends_with(basic_string_view(s)); }
+
+	bool contains(basic_string_view v) const noexcept
+	{ return find(v) != npos; }
+	bool contains(CharT ch) const noexcept
+	{ return find(ch) != npos; }
+	bool contains(const CharT* s) const
+	{ return find(s) != npos; }
+
+	// find
+
+	size_type find(basic_string_view v, size_type pos = 0) const noexcept
+	{ return string_detail::find<CharT, Traits>(data_, size_, v.data_, pos, v.size_); }
+	size_type find(CharT ch, size_type pos = 0) const noexcept
+	{ return string_detail::find_char<CharT, Traits>(data_, size_, ch, pos); }
+	size_type find(const CharT* s, size_type pos, size_type count) const noexcept
+	{ return string_detail::find<CharT, Traits>(data_, size_, s, pos, count); }
+	size_type find(const CharT* s, size_type pos = 0) const
+	{ return find(s, pos, traits_type::length(s)); }
+
+	// rfind
+
+	size_type rfind(basic_string_view v, size_type pos = npos) const noexcept
+	{ return string_detail::rfind<CharT, Traits>(data_, size_, v.data_, pos, v.size_); }
+	size_type rfind(CharT ch, size_type pos = npos) const noexcept
+	{ return string_detail::rfind_char<CharT, Traits>(data_, size_, ch, pos); }
+	size_type rfind(const CharT* s, size_type pos, size_type count) const noexcept
+	{ return string_detail::rfind<CharT, Traits>(data_, size_, s, pos, count); }
+	size_type rfind(const CharT* s, size_type pos = npos) const
+	{ return rfind(s, pos, traits_type::length(s)); }
+
+	// find_first_of
+
+	size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept
+	{ return string_detail::find_first_of<CharT, Traits>(data_, size_, v.data_, pos, v.size_); }
+	size_type find_first_of(CharT ch, size_type pos = 0) const noexcept
+	{ return find(ch, pos); }
+	size_type find_first_of(const CharT* s, size_type pos, size_type count) const noexcept
+	{ return string_detail::find_first_of<CharT, Traits>(data_, size_, s, pos, count); }
+	size_type find_first_of(const CharT* s, size_type pos = 0) const
+	{ return find_first_of(s, pos, traits_type::length(s)); }
+
+	// find_last_of
+
+	size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept
+	{ return string_detail::find_last_of<CharT, Traits>(data_, size_, v.data_, pos, v.size_); }
+	size_type find_last_of(CharT ch, size_type pos = npos) const noexcept
+	{ return rfind(ch, pos); }
+	size_type find_last_of(const CharT* s, size_type pos, size_type count) const noexcept
+	{ return string_detail::find_last_of<CharT, Traits>(data_, size_, s, pos, count); }
+	size_type find_last_of(const CharT* s, size_type pos = npos) const
+	{ return find_last_of(s, pos, traits_type::length(s)); }
+
+	// find_first_not_of
+
+	size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept
+	{ return string_detail::find_first_not_of<CharT, Traits>(data_, size_, v.data_, pos, v.size_); }
+	size_type find_first_not_of(CharT ch, size_type pos = 0) const noexcept
+	{ return string_detail::find_first_not_of_char<CharT, Traits>(data_, size_, ch, pos); }
+	size_type find_first_not_of(const CharT* s, size_type pos, size_type count) const noexcept
+	{ return string_detail::find_first_not_of<CharT, Traits>(data_, size_, s, pos, count); }
+	size_type find_first_not_of(const CharT* s, size_type pos = 0) const
+	{ return find_first_not_of(s, pos, traits_type::length(s)); }
+
+	// find_last_not_of
+
+	size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept
+	{ return string_detail::find_last_not_of<CharT, Traits>(data_, size_, v.data_, pos, v.size_); }
+	size_type find_last_not_of(CharT ch, size_type pos = npos) const noexcept
+	{ return string_detail::find_last_not_of_char<CharT, Traits>(data_, size_, ch, pos); }
+	size_type find_last_not_of(const CharT* s, size_type pos, size_type count) const noexcept
+	{ return string_detail::find_last_not_of<CharT, Traits>(data_, size_, s, pos, count); }
+	size_type find_last_not_of(const CharT* s, size_type pos = npos) const
+	{ return find_last_not_of(s, pos, traits_type::length(s)); }
+};
+
+template <class CharT, class Traits>
+constexpr typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
+
+// 重载比较操作符
+// 另一侧是 const CharT* 时先构造视图再比较
+template <class CharT, class Traits>
+bool operator==(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+	return lhs.size() == rhs.size() && Traits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <class CharT, class Traits>
+bool operator==(basic_string_view<CharT, Traits> lhs, const CharT* rhs)
+{
+	return lhs == basic_string_view<CharT, Traits>(rhs);
+}
+
+template <class CharT, class Traits>
+bool operator==(const CharT* lhs, basic_string_view<CharT, Traits> rhs)
+{
+	return basic_string_view<CharT, Traits>(lhs) == rhs;
+}
+
+template <class CharT, class Traits>
+bool operator!=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+template <class CharT, class Traits>
+bool operator!=(basic_string_view<CharT, Traits> lhs, const CharT* rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class CharT, class Traits>
+bool operator!=(const CharT* lhs, basic_string_view<CharT, Traits> rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class CharT, class Traits>
+bool operator<(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+	return lhs.compare(rhs) < 0;
+}
+
+template <class CharT, class Traits>
+bool operator<(basic_string_view<CharT, Traits> lhs, const CharT* rhs)
+{
+	return lhs.compare(rhs) < 0;
+}
+
+template <class CharT, class Traits>
+bool operator<(const CharT* lhs, basic_string_view<CharT, Traits> rhs)
+{
+	return rhs.compare(lhs) > 0;
+}
+
+template <class CharT, class Traits>
+bool operator>(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+	return rhs < lhs;
+}
+
+template <class CharT, class Traits>
+bool operator>(basic_string_view<CharT, Traits> lhs, const CharT* rhs)
+{
+	return rhs < lhs;
+}
+
+template <class CharT, class Traits>
+bool operator>(const CharT* lhs, basic_string_view<CharT, Traits> rhs)
+{
+	return rhs < lhs;
+}
+
+template <class CharT, class Traits>
+bool operator<=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+	return !(rhs < lhs);
+}
+
+template <class CharT, class Traits>
+bool operator<=(basic_string_view<CharT, Traits> lhs, const CharT* rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class CharT, class Traits>
+bool operator<=(const CharT* lhs, basic_string_view<CharT, Traits> rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class CharT, class Traits>
+bool operator>=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) noexcept
+{
+	return !(lhs < rhs);
+}
+
+template <class CharT, class Traits>
+bool operator>=(basic_string_view<CharT, Traits> lhs, const CharT* rhs)
+{
+	return !(lhs < rhs);
+}
+
+template <class CharT, class Traits>
+bool operator>=(const CharT* lhs, basic_string_view<CharT, Traits> rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class CharT, class Traits>
+void swap(basic_string_view<CharT, Traits>& lhs, basic_string_view<CharT, Traits>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 重载 operator<<
+template <class CharT, class Traits>
+std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, basic_string_view<CharT, Traits> v)
+{
+	return os.write(v.data(), static_cast<std::streamsize>(v.size()));
+}
+
+// 对字符串视图的字节内容哈希
+template <class CharT, class Traits>
+struct hash<basic_string_view<CharT, Traits>>
+{
+	typedef void is_avalanching;
+
+	size_t operator()(basic_string_view<CharT, Traits> v) const noexcept
+	{
+		return static_cast<size_t>(mystl::hash_bytes(v.data(), v.size() * sizeof(CharT)));
+	}
+};
+
+typedef basic_string_view<char>     string_view;
+typedef basic_string_view<wchar_t>  wstring_view;
+typedef basic_string_view<char16_t> u16string_view;
+typedef basic_string_view<char32_t> u32string_view;
+
+} // namespace mystl
+#endif // !MYTINYSTL_STRING_VIEW_H_
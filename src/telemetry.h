@@ -0,0 +1,402 @@
+#ifndef MYTINYSTL_TELEMETRY_H_
+#define MYTINYSTL_TELEMETRY_H_
+
+// 这个头文件包含容器增长的统计工具 telemetry, 用于找出频繁重新分配、搬移元素的调用点
+
+// notes:
+//
+// 定义 MYSTL_TELEMETRY 后启用, 未定义时所有钩子宏展开为空, 容器的布局与生成的代码都不受影响
+// 启用后记录:
+//   * 每个 (元素类型, 调用点) 的重新分配次数与搬移的字节数
+//   * 容器销毁时的最终大小(以 2 的幂分桶的直方图)与浪费的容量字节数
+//   * 每个元素类型 get_new_cap 的增长次数与申请的容量字节数
+// 调用点是触发重新分配的成员函数的返回地址(__builtin_return_address), 报告中以地址输出, 可用
+// addr2line 还原; 这些成员函数在启用时不内联, 但 -O0 下 push_back 等本身也不内联, 调用点会归并到
+// 这些公有函数上, 因此建议在 -O1 以上使用
+// 销毁时按缓冲区地址找到最后一次重新分配的调用点, 所以移动、交换后的容器仍然归属正确;
+// 从未重新分配过的容器归入该类型的 "(no reallocation)" 一栏
+// MYSTL_TELEMETRY 必须对整个程序统一定义, 否则同一模板在不同翻译单元中的定义不一致
+// 统计表用 std 容器实现, 避免 mystl 容器统计自身; 所有操作以互斥量保护, 可在多线程中使用
+
+#include <cstddef>
+#include <cstdio>
+
+#include "exceptdef.h"
+
+#if defined(MYSTL_TELEMETRY)
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#endif
+
+namespace mystl
+{
+namespace telemetry
+{
+
+#if defined(MYSTL_TELEMETRY)
+
+// 最终大小直方图的桶数: 第 0 桶为 0, 第 k 桶为 [2^(k-1), 2^k)
+constexpr size_t histogram_buckets = sizeof(size_t) * 8 + 1;
+
+// 每个元素类型一个标签, 以其地址作为统计的键
+struct type_tag
+{
+	const char* signature;  // 含有类型名的函数签名, 报告时从中取出类型名
+	size_t      elem_size;
+};
+
+template <class T>
+const char* type_signature() noexcept
+{
+#if defined(_MSC_VER)
+	return __FUNCSIG__;
+#else
+	return __PRETTY_FUNCTION__;
+#endif
+}
+
+template <class T>
+const type_tag* tag_of() noexcept
+{
+	static const type_tag tag = { type_signature<T>(), sizeof(T) };
+	return &tag;
+}
+
+// 一个调用点的统计结果
+struct site_report
+{
+	std::string   type;                 // 元素类型名
+	const void*   site;                 // 调用点, nullptr 表示从未重新分配
+	size_t        elem_size;
+	std::uint64_t objects;              // 已销毁的容器个数
+	std::uint64_t reallocations;
+	std::uint64_t bytes_moved;
+	std::uint64_t wasted_bytes;         // 销毁时 (capacity - size) * sizeof(T) 之和
+	size_t        recommended_reserve;  // 建议的 reserve 大小, 0 表示不需要
+	std::uint64_t histogram[histogram_buckets];
+	size_t        bucket_max[histogram_buckets];  // 每个桶中见到的最大大小
+};
+
+// 一个元素类型的增长统计
+struct type_report
+{
+	std::string   type;
+	size_t        elem_size;
+	std::uint64_t growths;          // get_new_cap 的调用次数
+	std::uint64_t bytes_requested;  // get_new_cap 返回的容量字节数之和
+};
+
+namespace telemetry_detail
+{
+
+struct site_key
+{
+	const type_tag* tag;
+	const void*     site;
+
+	bool operator==(const site_key& rhs) const noexcept
+	{
+		return tag == rhs.tag && site == rhs.site;
+	}
+};
+
+struct site_key_hash
+{
+	size_t operator()(const site_key& k) const noexcept
+	{
+		const size_t a = reinterpret_cast<size_t>(k.tag);
+		const size_t b = reinterpret_cast<size_t>(k.site);
+		return a ^ (b + 0x9e3779b9 + (a << 6) + (a >> 2));
+	}
+};
+
+struct site_stats
+{
+	std::uint64_t objects = 0;
+	std::uint64_t reallocations = 0;
+	std::uint64_t bytes_moved = 0;
+	std::uint64_t wasted_bytes = 0;
+	std::uint64_t histogram[histogram_buckets] = {};
+	size_t        bucket_max[histogram_buckets] = {};
+};
+
+struct type_stats
+{
+	std::uint64_t growths = 0;
+	std::uint64_t bytes_requested = 0;
+};
+
+struct registry
+{
+	std::mutex                                                   lock;
+	std::unordered_map<site_key, site_stats, site_key_hash>      sites;
+	std::unordered_map<const type_tag*, type_stats>              types;
+	std::unordered_map<const void*, site_key>                    buffers;  // 缓冲区 -> 最后一次分配它的调用点
+};
+
+// 有意不释放: 静态对象中的容器可能在程序退出的最后阶段才销毁
+inline registry& instance()
+{
+	static registry* r = new registry;
+	return *r;
+}
+
+inline size_t bucket_of(size_t n) noexcept
+{
+	size_t k = 0;
+	while (n != 0)
+	{
+		++k;
+		n >>= 1;
+	}
+	return k;
+}
+
+inline std::string type_name(const type_tag* tag)
+{
+	const char* sig = tag->signature;
+#if defined(_MSC_VER)
+	const char* first = std::strstr(sig, "type_signature<");
+	if (first == nullptr)
+		return sig;
+	first += std::strlen("type_signature<");
+	const char* last = std::strrchr(sig, '>');
+#else
+	const char* first = std::strstr(sig, "T = ");
+	if (first == nullptr)
+		return sig;
+	first += 4;
+	const char* last = first + std::strcspn(first, ";]");
+#endif
+	return last == nullptr || last < first ? std::string(first) : std::string(first, last);
+}
+
+// 以 p90 所在桶的最大大小作为建议值; 平均每个容器重新分配不到一次, 或者从未搬移元素(如 reserve 空容器)时不建议
+inline size_t recommend(const site_stats& s) noexcept
+{
+	if (s.objects == 0 || s.reallocations < s.objects || s.bytes_moved == 0)
+		return 0;
+	const std::uint64_t target = s.objects - s.objects / 10;
+	std::uint64_t seen = 0;
+	for (size_t k = 0; k < histogram_buckets; ++k)
+	{
+		seen += s.histogram[k];
+		if (seen >= target)
+			return s.bucket_max[k];
+	}
+	return 0;
+}
+
+} // namespace telemetry_detail
+
+// get_new_cap 的钩子: 记录一次容量增长
+inline void on_grow(const type_tag* tag, size_t new_cap) noexcept
+{
+	auto& r = telemetry_detail::instance();
+	std::lock_guard<std::mutex> guard(r.lock);
+	MYSTL_TRY
+	{
+		auto& t = r.types[tag];
+		++t.growths;
+		t.bytes_requested += static_cast<std::uint64_t>(new_cap) * tag->elem_size;
+	}
+	MYSTL_CATCH_ALL
+	{
+	}
+}
+
+// 重新分配的钩子: old_buf 中的 size 个元素将被转移到 new_buf
+inline void on_reallocate(const type_tag* tag, const void* site, const void* old_buf,
+                          const void* new_buf, size_t size) noexcept
+{
+	auto& r = telemetry_detail::instance();
+	std::lock_guard<std::mutex> guard(r.lock);
+	MYSTL_TRY
+	{
+		const telemetry_detail::site_key key = { tag, site };
+		auto& s = r.sites[key];
+		++s.reallocations;
+		s.bytes_moved += static_cast<std::uint64_t>(size) * tag->elem_size;
+		if (old_buf != nullptr)
+			r.buffers.erase(old_buf);
+		r.buffers[new_buf] = key;
+	}
+	MYSTL_CATCH_ALL
+	{
+	}
+}
+
+// 释放缓冲区的钩子: 记录最终大小与浪费的容量
+inline void on_release(const type_tag* tag, const void* buf, size_t size, size_t cap) noexcept
+{
+	if (buf == nullptr)
+		return;
+	auto& r = telemetry_detail::instance();
+	std::lock_guard<std::mutex> guard(r.lock);
+	MYSTL_TRY
+	{
+		telemetry_detail::site_key key = { tag, nullptr };
+		auto it = r.buffers.find(buf);
+		if (it != r.buffers.end())
+		{
+			key = it->second;
+			r.buffers.erase(it);
+		}
+		auto& s = r.sites[key];
+		const size_t k = telemetry_detail::bucket_of(size);
+		++s.objects;
+		s.wasted_bytes += static_cast<std::uint64_t>(cap - size) * tag->elem_size;
+		++s.histogram[k];
+		s.bucket_max[k] = (std::max)(s.bucket_max[k], size);
+	}
+	MYSTL_CATCH_ALL
+	{
+	}
+}
+
+// 取得当前所有调用点的统计结果, 按搬移的字节数从大到小排列
+inline std::vector<site_report> snapshot()
+{
+	auto& r = telemetry_detail::instance();
+	std::vector<site_report> result;
+	std::lock_guard<std::mutex> guard(r.lock);
+	result.reserve(r.sites.size());
+	for (const auto& kv : r.sites)
+	{
+		const auto& s = kv.second;
+		site_report rep;
+		rep.type = telemetry_detail::type_name(kv.first.tag);
+		rep.site = kv.first.site;
+		rep.elem_size = kv.first.tag->elem_size;
+		rep.objects = s.objects;
+		rep.reallocations = s.reallocations;
+		rep.bytes_moved = s.bytes_moved;
+		rep.wasted_bytes = s.wasted_bytes;
+		rep.recommended_reserve = telemetry_detail::recommend(s);
+		std::copy(s.histogram, s.histogram + histogram_buckets, rep.histogram);
+		std::copy(s.bucket_max, s.bucket_max + histogram_buckets, rep.bucket_max);
+		result.push_back(std::move(rep));
+	}
+	std::sort(result.begin(), result.end(), [](const site_report& a, const site_report& b)
+	{
+		return a.bytes_moved > b.bytes_moved;
+	});
+	return result;
+}
+
+inline std::vector<type_report> type_snapshot()
+{
+	auto& r = telemetry_detail::instance();
+	std::vector<type_report> result;
+	std::lock_guard<std::mutex> guard(r.lock);
+	for (const auto& kv : r.types)
+	{
+		type_report rep;
+		rep.type = telemetry_detail::type_name(kv.first);
+		rep.elem_size = kv.first->elem_size;
+		rep.growths = kv.second.growths;
+		rep.bytes_requested = kv.second.bytes_requested;
+		result.push_back(std::move(rep));
+	}
+	return result;
+}
+
+// 清空统计结果; 仍然存活的缓冲区之后销毁时归入 "(no reallocation)"
+inline void reset()
+{
+	auto& r = telemetry_detail::instance();
+	std::lock_guard<std::mutex> guard(r.lock);
+	r.sites.clear();
+	r.types.clear();
+	r.buffers.clear();
+}
+
+// 输出统计报告, 对平均每个容器重新分配一次以上的调用点给出 reserve 建议
+inline void report(std::FILE* out = stderr)
+{
+	const auto types = type_snapshot();
+	const auto sites = snapshot();
+	std::fprintf(out, "mystl telemetry report\n");
+	for (const auto& t : types)
+	{
+		std::fprintf(out, "type %s (%zu bytes): %llu growths, %llu bytes requested\n",
+		             t.type.c_str(), t.elem_size,
+		             static_cast<unsigned long long>(t.growths),
+		             static_cast<unsigned long long>(t.bytes_requested));
+	}
+	for (const auto& s : sites)
+	{
+		if (s.site != nullptr)
+			std::fprintf(out, "site %p [%s]\n", s.site, s.type.c_str());
+		else
+			std::fprintf(out, "site (no reallocation) [%s]\n", s.type.c_str());
+		std::fprintf(out, "  objects %llu, reallocations %llu, bytes moved %llu, wasted bytes %llu\n",
+		             static_cast<unsigned long long>(s.objects),
+		             static_cast<unsigned long long>(s.reallocations),
+		             static_cast<unsigned long long>(s.bytes_moved),
+		             static_cast<unsigned long long>(s.wasted_bytes));
+		std::fprintf(out, "  final sizes:");
+		for (size_t k = 0; k < histogram_buckets; ++k)
+		{
+			if (s.histogram[k] == 0)
+				continue;
+			const size_t low = k == 0 ? 0 : static_cast<size_t>(1) << (k - 1);
+			std::fprintf(out, " [%zu,%zu]:%llu", low, s.bucket_max[k],
+			             static_cast<unsigned long long>(s.histogram[k]));
+		}
+		std::fprintf(out, "\n");
+		if (s.recommended_reserve != 0)
+			std::fprintf(out, "  suggest reserve(%zu)\n", s.recommended_reserve);
+	}
+}
+
+#else // !MYSTL_TELEMETRY
+
+inline void reset() noexcept {}
+inline void report(std::FILE* = stderr) noexcept {}
+
+#endif // MYSTL_TELEMETRY
+
+} // namespace telemetry
+} // namespace mystl
+
+// 容器中使用的钩子, 未启用时展开为空
+#if defined(MYSTL_TELEMETRY)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MYSTL_TELEMETRY_CALLER()   __builtin_return_address(0)
+#define MYSTL_TELEMETRY_NOINLINE   __attribute__((noinline))
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define MYSTL_TELEMETRY_CALLER()   _ReturnAddress()
+#define MYSTL_TELEMETRY_NOINLINE   __declspec(noinline)
+#else
+#define MYSTL_TELEMETRY_CALLER()   nullptr
+#define MYSTL_TELEMETRY_NOINLINE
+#endif
+
+#define MYSTL_TELEMETRY_ON_GROW(T, new_cap) \
+  mystl::telemetry::on_grow(mystl::telemetry::tag_of<T>(), (new_cap))
+
+#define MYSTL_TELEMETRY_ON_REALLOCATE(T, old_buf, new_buf, size) \
+  mystl::telemetry::on_reallocate(mystl::telemetry::tag_of<T>(), MYSTL_TELEMETRY_CALLER(), \
+                                  (old_buf), (new_buf), (size))
+
+#define MYSTL_TELEMETRY_ON_RELEASE(T, buf, size, cap) \
+  mystl::telemetry::on_release(mystl::telemetry::tag_of<T>(), (buf), (size), (cap))
+
+#else
+
+#define MYSTL_TELEMETRY_NOINLINE
+#define MYSTL_TELEMETRY_ON_GROW(T, new_cap)                      ((void)0)
+#define MYSTL_TELEMETRY_ON_REALLOCATE(T, old_buf, new_buf, size) ((void)0)
+#define MYSTL_TELEMETRY_ON_RELEASE(T, buf, size, cap)            ((void)0)
+
+#endif // MYSTL_TELEMETRY
+
+#endif // !MYTINYSTL_TELEMETRY_H_
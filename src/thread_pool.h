@@ -0,0 +1,829 @@
+#ifndef MYTINYSTL_THREAD_POOL_H_
+#define MYTINYSTL_THREAD_POOL_H_
+
+// 这个头文件包含一个基于工作窃取(work stealing)的任务调度器 thread_pool
+// 以及建立在它之上的 task_group(fork/join) 与 parallel_for
+
+// notes:
+//
+// 每个工作线程拥有一个 Chase-Lev 双端队列：
+//   * 所有者线程在底部 push / pop，不需要加锁
+//   * 其他线程从顶部 steal，只在争抢最后一个任务时需要一次 CAS
+// 外部线程提交的任务进入一个加锁的注入队列，由空闲的工作线程领取
+// 任务帧(task_frame)来自线程自己的帧池，按 slab 批量申请，spawn 时不经过 ::operator new
+// 可调用对象超过帧内的缓冲区大小时，才退化为在堆上保存该对象
+// 空闲的工作线程依次自旋、让出时间片，最后在条件变量上睡眠
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+class thread_pool;
+class task_group;
+
+// 任务帧中用于就地保存可调用对象的缓冲区大小
+#ifndef MYSTL_TASK_INLINE_SIZE
+#define MYSTL_TASK_INLINE_SIZE 96
+#endif // !MYSTL_TASK_INLINE_SIZE
+
+// 自旋等待时提示 CPU 当前处于忙等状态
+inline void cpu_relax() noexcept
+{
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+	_mm_pause();
+#elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+/*****************************************************************************************/
+// task_frame
+// 一个待执行的任务，可调用对象保存在 storage 中
+/*****************************************************************************************/
+
+struct task_frame
+{
+	void (*invoke)(task_frame*);  // 执行可调用对象并将其析构
+	task_group* group;            // 所属的任务组，用于完成计数
+	task_frame* next;             // 空闲链表 / 注入队列中的下一个帧
+	bool        shared;           // 是否取自外部线程共用的帧池, 释放时要放回那里
+	alignas(std::max_align_t) unsigned char storage[MYSTL_TASK_INLINE_SIZE];
+};
+
+// 可调用对象能放进帧内时就地构造
+template <class F>
+struct task_inline_invoker
+{
+	static void invoke(task_frame* frame)
+	{
+		F* f = reinterpret_cast<F*>(frame->storage);
+		// 无论是否抛出异常都要析构可调用对象
+		struct guard
+		{
+			F* f;
+			~guard() { mystl::destroy(f); }
+		} g{ f };
+		(*f)();
+	}
+};
+
+// 可调用对象过大时保存在堆上，帧内只存放指针
+template <class F>
+struct task_heap_invoker
+{
+	static void invoke(task_frame* frame)
+	{
+		F* f = *reinterpret_cast<F**>(frame->storage);
+		struct guard
+		{
+			F* f;
+			~guard() { delete f; }
+		} g{ f };
+		(*f)();
+	}
+};
+
+/*****************************************************************************************/
+// task_frame_pool
+// 固定大小的任务帧池，以 slab 为单位向 allocator 申请，释放的帧挂入空闲链表
+// 帧池本身不加锁，工作线程的帧池只由该线程访问
+/*****************************************************************************************/
+
+class task_frame_pool
+{
+private:
+	static constexpr size_t kFramesPerSlab = 64;
+
+	task_frame* free_;   // 空闲链表
+	task_frame* slabs_;  // 每个 slab 的第一个帧用作头部，串起所有 slab
+
+public:
+	task_frame_pool() noexcept : free_(nullptr), slabs_(nullptr) {}
+
+	~task_frame_pool()
+	{
+		while (slabs_)
+		{
+			task_frame* next = slabs_->next;
+			mystl::allocator<task_frame>::deallocate(slabs_, kFramesPerSlab);
+			slabs_ = next;
+		}
+	}
+
+	task_frame_pool(const task_frame_pool&) = delete;
+	task_frame_pool& operator=(const task_frame_pool&) = delete;
+
+	task_frame* acquire()
+	{
+		if (free_ == nullptr)
+			refill();
+		task_frame* frame = free_;
+		free_ = frame->next;
+		return frame;
+	}
+
+	void release(task_frame* frame) noexcept
+	{
+		frame->next = free_;
+		free_ = frame;
+	}
+
+private:
+	void refill()
+	{
+		task_frame* slab = mystl::allocator<task_frame>::allocate(kFramesPerSlab);
+		slab->next = slabs_;
+		slabs_ = slab;
+		for (size_t i = kFramesPerSlab - 1; i > 0; --i)
+			release(slab + i);
+	}
+};
+
+/*****************************************************************************************/
+// work_deque
+// Chase-Lev 工作窃取双端队列 (Lê, Pop, Cohen, Nardelli 对弱内存模型的修正版本)
+// bottom 只由所有者修改，top 由窃取者通过 CAS 推进
+// 环形数组满时扩容为两倍，旧数组保留到队列析构，以免窃取者读到已释放的内存
+/*****************************************************************************************/
+
+class work_deque
+{
+private:
+	struct ring
+	{
+		int64_t                   capacity;
+		int64_t                   mask;
+		std::atomic<task_frame*>* slots;
+		ring*                     retired;  // 扩容前的旧数组
+
+		task_frame* get(int64_t i) const noexcept
+		{
+			return slots[i & mask].load(std::memory_order_relaxed);
+		}
+
+		void put(int64_t i, task_frame* frame) noexcept
+		{
+			slots[i & mask].store(frame, std::memory_order_relaxed);
+		}
+	};
+
+	std::atomic<int64_t> top_;
+	char                 pad_[64 - sizeof(std::atomic<int64_t>)];  // 避免 top 与 bottom 伪共享
+	std::atomic<int64_t> bottom_;
+	std::atomic<ring*>   array_;
+
+public:
+	explicit work_deque(int64_t capacity = 256)
+		: top_(0), bottom_(0), array_(make_ring(capacity, nullptr))
+	{
+	}
+
+	~work_deque()
+	{
+		ring* r = array_.load(std::memory_order_relaxed);
+		while (r)
+		{
+			ring* retired = r->retired;
+			free_ring(r);
+			r = retired;
+		}
+	}
+
+	work_deque(const work_deque&) = delete;
+	work_deque& operator=(const work_deque&) = delete;
+
+	// 近似的元素个数，只用于调度上的启发式判断
+	int64_t size() const noexcept
+	{
+		const int64_t b = bottom_.load(std::memory_order_relaxed);
+		const int64_t t = top_.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	bool empty() const noexcept { return size() == 0; }
+
+	// 所有者在底部压入
+	void push(task_frame* frame)
+	{
+		const int64_t b = bottom_.load(std::memory_order_relaxed);
+		const int64_t t = top_.load(std::memory_order_acquire);
+		ring* a = array_.load(std::memory_order_relaxed);
+		if (b - t > a->capacity - 1)
+			a = grow(a, t, b);
+		a->put(b, frame);
+		// 窃取者以 acquire 读取 bottom 后, 能看到任务帧与槽位的内容
+		bottom_.store(b + 1, std::memory_order_release);
+	}
+
+	// 所有者从底部弹出，队列为空时返回 nullptr
+	task_frame* pop() noexcept
+	{
+		const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+		ring* a = array_.load(std::memory_order_relaxed);
+		// bottom 的写入与 top 的读取都是 seq_cst, 与 steal 中的两次读取处于同一全序中,
+		// 所有者与窃取者不会同时取走最后一个元素; 不使用独立的栅栏, ThreadSanitizer 才能理解这里的同步
+		bottom_.store(b, std::memory_order_seq_cst);
+		int64_t t = top_.load(std::memory_order_seq_cst);
+		task_frame* frame = nullptr;
+		if (t <= b)
+		{
+			frame = a->get(b);
+			if (t == b)
+			{
+				// 只剩最后一个元素，与窃取者竞争
+				if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+				                                  std::memory_order_relaxed))
+					frame = nullptr;
+				bottom_.store(b + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			bottom_.store(b + 1, std::memory_order_relaxed);
+		}
+		return frame;
+	}
+
+	// 其他线程从顶部窃取，队列为空或竞争失败时返回 nullptr
+	task_frame* steal() noexcept
+	{
+		int64_t t = top_.load(std::memory_order_seq_cst);
+		const int64_t b = bottom_.load(std::memory_order_seq_cst);
+		if (t >= b)
+			return nullptr;
+		ring* a = array_.load(std::memory_order_acquire);
+		task_frame* frame = a->get(t);
+		if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+		                                  std::memory_order_relaxed))
+			return nullptr;
+		return frame;
+	}
+
+private:
+	static ring* make_ring(int64_t capacity, ring* retired)
+	{
+		ring* r = mystl::allocator<ring>::allocate();
+		r->capacity = capacity;
+		r->mask = capacity - 1;
+		r->retired = retired;
+		r->slots = mystl::allocator<std::atomic<task_frame*>>::allocate(
+			static_cast<size_t>(capacity));
+		for (int64_t i = 0; i < capacity; ++i)
+			mystl::construct(r->slots + i, nullptr);
+		return r;
+	}
+
+	static void free_ring(ring* r) noexcept
+	{
+		mystl::allocator<std::atomic<task_frame*>>::deallocate(r->slots,
+		                                                       static_cast<size_t>(r->capacity));
+		mystl::allocator<ring>::deallocate(r);
+	}
+
+	ring* grow(ring* old, int64_t t, int64_t b)
+	{
+		ring* r = make_ring(old->capacity * 2, old);
+		for (int64_t i = t; i < b; ++i)
+			r->put(i, old->get(i));
+		array_.store(r, std::memory_order_release);
+		return r;
+	}
+};
+
+/*****************************************************************************************/
+// thread_pool_options
+// 线程池的构造参数
+/*****************************************************************************************/
+
+struct thread_pool_options
+{
+	// 工作线程数, 为 0 时取 hardware_concurrency() - 1 (调用者线程在等待时也会参与计算)
+	size_t threads = 0;
+
+	// 工作线程启动时调用的钩子, 参数为工作线程编号与 hook_context
+	// 可用于把线程绑定到指定核心(见 pin_worker_to_cpu)、设置线程名等
+	void (*on_worker_start)(size_t index, void* context) = nullptr;
+	void* hook_context = nullptr;
+
+	// 空闲策略: 先自旋 spin_rounds 轮, 再让出时间片 yield_rounds 轮, 之后睡眠等待唤醒
+	size_t spin_rounds = 64;
+	size_t yield_rounds = 16;
+};
+
+// 一个现成的绑核钩子：第 index 个工作线程绑定到第 index % CPU 数个逻辑核心
+// 不考虑 NUMA 拓扑, 仅在 Linux 上生效, 其他平台为空操作
+inline void pin_worker_to_cpu(size_t index, void* /*context*/)
+{
+#if defined(__linux__)
+	const unsigned cpus = std::thread::hardware_concurrency();
+	if (cpus == 0)
+		return;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(static_cast<int>(index % cpus), &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+	(void)index;
+#endif
+}
+
+/*****************************************************************************************/
+// task_group
+// fork/join 任务组: run 派生任务, wait 等待组内所有任务完成
+// 等待期间当前线程会执行池中的其他任务, 因此可以安全地嵌套使用
+// 任务抛出的第一个异常在 wait 中重新抛出
+/*****************************************************************************************/
+
+class task_group
+{
+	friend class thread_pool;
+
+private:
+	thread_pool&        pool_;
+	std::atomic<size_t> pending_;
+	std::atomic<bool>   has_exception_;
+	std::exception_ptr  exception_;
+
+public:
+	explicit task_group(thread_pool& pool) noexcept
+		: pool_(pool), pending_(0), has_exception_(false), exception_()
+	{
+	}
+
+	// 析构时等待尚未完成的任务(不重新抛出异常), 所以派生任务的代码抛出异常而跳过 wait 时,
+	// 任务也不会在任务组销毁之后访问它
+	~task_group();
+
+	task_group(const task_group&) = delete;
+	task_group& operator=(const task_group&) = delete;
+
+	template <class F>
+	void run(F&& f);
+
+	void wait();
+
+	bool done() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+	void capture_exception() noexcept
+	{
+		bool expected = false;
+		if (has_exception_.compare_exchange_strong(expected, true))
+			exception_ = std::current_exception();
+	}
+};
+
+/*****************************************************************************************/
+// thread_pool
+/*****************************************************************************************/
+
+class thread_pool
+{
+	friend class task_group;
+
+private:
+	// 每个工作线程的私有状态
+	struct worker
+	{
+		work_deque      deque;
+		task_frame_pool frames;
+		thread_pool*    pool;
+		size_t          index;
+		uint64_t        seed;  // 随机选择窃取对象
+		char            pad[64];
+	};
+
+	worker*             workers_;
+	std::thread*        threads_;
+	size_t              count_;
+	thread_pool_options options_;
+
+	// 外部线程提交的任务
+	std::mutex          inject_mutex_;
+	task_frame*         inject_head_;
+	task_frame*         inject_tail_;
+	std::atomic<size_t> inject_size_;
+
+	// 外部线程派生任务时使用的帧池
+	std::mutex          shared_frames_mutex_;
+	task_frame_pool     shared_frames_;
+
+	// 睡眠与唤醒
+	std::mutex              sleep_mutex_;
+	std::condition_variable sleep_cv_;
+	std::atomic<size_t>     sleepers_;
+	uint64_t                wake_epoch_;
+	std::atomic<bool>       stop_;
+
+public:
+	explicit thread_pool(const thread_pool_options& options = thread_pool_options())
+		: workers_(nullptr), threads_(nullptr), count_(0), options_(options),
+		  inject_head_(nullptr), inject_tail_(nullptr), inject_size_(0),
+		  sleepers_(0), wake_epoch_(0), stop_(false)
+	{
+		count_ = options_.threads;
+		if (count_ == 0)
+		{
+			const size_t hw = std::thread::hardware_concurrency();
+			count_ = hw > 1 ? hw - 1 : 1;
+		}
+		workers_ = mystl::allocator<worker>::allocate(count_);
+		for (size_t i = 0; i < count_; ++i)
+		{
+			mystl::construct(workers_ + i);
+			workers_[i].pool = this;
+			workers_[i].index = i;
+			workers_[i].seed = 0x9e3779b97f4a7c15ull * (i + 1);
+		}
+		threads_ = mystl::allocator<std::thread>::allocate(count_);
+		for (size_t i = 0; i < count_; ++i)
+			mystl::construct(threads_ + i, [this, i] { worker_loop(workers_[i]); });
+	}
+
+	// 析构时等待所有工作线程退出, 调用者需保证没有未完成的任务组
+	~thread_pool()
+	{
+		stop_.store(true, std::memory_order_seq_cst);
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			++wake_epoch_;
+		}
+		sleep_cv_.notify_all();
+		for (size_t i = 0; i < count_; ++i)
+			threads_[i].join();
+		mystl::allocator<std::thread>::destroy(threads_, threads_ + count_);
+		mystl::allocator<std::thread>::deallocate(threads_, count_);
+		mystl::allocator<worker>::destroy(workers_, workers_ + count_);
+		mystl::allocator<worker>::deallocate(workers_, count_);
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	// 进程内共享的默认线程池, 第一次使用时创建
+	static thread_pool& default_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	// 工作线程数
+	size_t size() const noexcept { return count_; }
+
+	// 参与计算的线程数, 包括在 wait 中帮忙的调用者线程
+	size_t concurrency() const noexcept { return count_ + 1; }
+
+	// 当前线程是否为本线程池的工作线程
+	bool in_worker() const noexcept
+	{
+		worker* w = current_worker();
+		return w != nullptr && w->pool == this;
+	}
+
+	// 对 [first, last) 内的下标做并行循环, f(begin, end) 处理一个子区间
+	// 自适应切分: 只有当前线程的队列为空(说明其他线程可能缺活)时才把剩余区间对半拆出去
+	// 否则按 grain 大小逐段顺序执行, 兼顾负载均衡与派生开销
+	template <class Function>
+	void parallel_for(size_t first, size_t last, size_t grain, Function f)
+	{
+		if (first >= last)
+			return;
+		if (grain == 0)
+			grain = 1;
+		task_group group(*this);
+		split_range(group, first, last, grain, f);
+		group.wait();
+	}
+
+private:
+	static worker*& current_worker() noexcept
+	{
+		static thread_local worker* w = nullptr;
+		return w;
+	}
+
+	template <class Function>
+	void split_range(task_group& group, size_t first, size_t last, size_t grain, Function& f)
+	{
+		while (first < last)
+		{
+			worker* w = current_worker();
+			const bool hungry = w == nullptr || w->pool != this || w->deque.empty();
+			if (last - first > grain && hungry)
+			{
+				const size_t middle = first + (last - first) / 2;
+				// 拆出去的后半段由执行它的线程继续自适应切分
+				group.run([this, &group, middle, last, grain, &f]
+				{
+					split_range(group, middle, last, grain, f);
+				});
+				last = middle;
+				continue;
+			}
+			const size_t stop = last - first > grain ? first + grain : last;
+			f(first, stop);
+			first = stop;
+		}
+	}
+
+	// 为任务组派生一个任务
+	template <class F>
+	void spawn(task_group& group, F&& f)
+	{
+		using callable = typename std::decay<F>::type;
+		worker* w = current_worker();
+		const bool local = w != nullptr && w->pool == this;
+		task_frame* frame = acquire_frame(local ? w : nullptr);
+		frame->group = &group;
+		frame->next = nullptr;
+		construct_callable<callable>(frame, mystl::forward<F>(f),
+		                             m_bool_constant<(sizeof(callable) <= MYSTL_TASK_INLINE_SIZE &&
+		                                              alignof(callable) <= alignof(std::max_align_t))>{});
+		group.pending_.fetch_add(1, std::memory_order_relaxed);
+		if (local)
+		{
+			w->deque.push(frame);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(inject_mutex_);
+			if (inject_tail_)
+				inject_tail_->next = frame;
+			else
+				inject_head_ = frame;
+			inject_tail_ = frame;
+			inject_size_.fetch_add(1, std::memory_order_relaxed);
+		}
+		wake_one();
+	}
+
+	template <class Callable, class F>
+	static void construct_callable(task_frame* frame, F&& f, m_true_type)
+	{
+		mystl::construct(reinterpret_cast<Callable*>(frame->storage), mystl::forward<F>(f));
+		frame->invoke = &task_inline_invoker<Callable>::invoke;
+	}
+
+	template <class Callable, class F>
+	static void construct_callable(task_frame* frame, F&& f, m_false_type)
+	{
+		*reinterpret_cast<Callable**>(frame->storage) = new Callable(mystl::forward<F>(f));
+		frame->invoke = &task_heap_invoker<Callable>::invoke;
+	}
+
+	task_frame* acquire_frame(worker* w)
+	{
+		task_frame* frame = nullptr;
+		if (w)
+		{
+			frame = w->frames.acquire();
+			frame->shared = false;
+			return frame;
+		}
+		std::lock_guard<std::mutex> lock(shared_frames_mutex_);
+		frame = shared_frames_.acquire();
+		frame->shared = true;
+		return frame;
+	}
+
+	// 取自共用帧池的帧放回共用帧池, 否则放入当前工作线程的帧池;
+	// 若把外部线程的帧留在工作线程中, 共用帧池会不断申请新的 slab
+	void release_frame(task_frame* frame) noexcept
+	{
+		worker* w = current_worker();
+		if (!frame->shared && w != nullptr && w->pool == this)
+		{
+			w->frames.release(frame);
+			return;
+		}
+		std::lock_guard<std::mutex> lock(shared_frames_mutex_);
+		shared_frames_.release(frame);
+	}
+
+	// 执行一个任务, 记录异常并更新任务组的计数
+	void execute(task_frame* frame) noexcept
+	{
+		task_group* group = frame->group;
+		MYSTL_TRY
+		{
+			frame->invoke(frame);
+		}
+		MYSTL_CATCH_ALL
+		{
+			group->capture_exception();
+		}
+		release_frame(frame);
+		group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	// 从注入队列取一个任务
+	task_frame* take_injected() noexcept
+	{
+		if (inject_size_.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+		std::lock_guard<std::mutex> lock(inject_mutex_);
+		task_frame* frame = inject_head_;
+		if (frame)
+		{
+			inject_head_ = frame->next;
+			if (inject_head_ == nullptr)
+				inject_tail_ = nullptr;
+			inject_size_.fetch_sub(1, std::memory_order_relaxed);
+		}
+		return frame;
+	}
+
+	// 随机选择起点, 依次尝试从其他工作线程窃取
+	task_frame* steal_from_others(worker* self) noexcept
+	{
+		uint64_t seed = self ? self->seed : reinterpret_cast<uintptr_t>(&seed);
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		if (self)
+			self->seed = seed;
+		const size_t start = static_cast<size_t>(seed % count_);
+		for (size_t k = 0; k < count_; ++k)
+		{
+			worker& victim = workers_[(start + k) % count_];
+			if (&victim == self)
+				continue;
+			task_frame* frame = victim.deque.steal();
+			if (frame)
+				return frame;
+		}
+		return nullptr;
+	}
+
+	// 找一个可执行的任务: 本地队列 -> 注入队列 -> 窃取
+	task_frame* find_task(worker* self) noexcept
+	{
+		task_frame* frame = self ? self->deque.pop() : nullptr;
+		if (frame == nullptr)
+			frame = take_injected();
+		if (frame == nullptr)
+			frame = steal_from_others(self);
+		return frame;
+	}
+
+	bool has_visible_work() const noexcept
+	{
+		if (inject_size_.load(std::memory_order_relaxed) != 0)
+			return true;
+		for (size_t i = 0; i < count_; ++i)
+		{
+			if (!workers_[i].deque.empty())
+				return true;
+		}
+		return false;
+	}
+
+	void wake_one()
+	{
+		// 用读-改-写代替栅栏: 与 idle 中登记睡眠者的 fetch_add 处于 sleepers_ 的同一修改顺序中,
+		// 要么这里看到睡眠者, 要么睡眠者登记后能看到已提交的任务
+		if (sleepers_.fetch_add(0, std::memory_order_acq_rel) == 0)
+			return;
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			++wake_epoch_;
+		}
+		sleep_cv_.notify_one();
+	}
+
+	// 空闲策略: 自旋 -> 让出时间片 -> 睡眠
+	void idle(size_t& rounds)
+	{
+		++rounds;
+		if (rounds <= options_.spin_rounds)
+		{
+			for (int i = 0; i < 32; ++i)
+				cpu_relax();
+			return;
+		}
+		if (rounds <= options_.spin_rounds + options_.yield_rounds)
+		{
+			std::this_thread::yield();
+			return;
+		}
+		std::unique_lock<std::mutex> lock(sleep_mutex_);
+		const uint64_t epoch = wake_epoch_;
+		sleepers_.fetch_add(1, std::memory_order_seq_cst);
+		// 登记为睡眠者之后再检查一次, 避免错过在登记前提交的任务
+		if (!has_visible_work() && !stop_.load(std::memory_order_relaxed))
+		{
+			sleep_cv_.wait(lock, [this, epoch]
+			{
+				return wake_epoch_ != epoch || stop_.load(std::memory_order_relaxed);
+			});
+		}
+		sleepers_.fetch_sub(1, std::memory_order_relaxed);
+		rounds = 0;
+	}
+
+	void worker_loop(worker& self)
+	{
+		current_worker() = &self;
+		if (options_.on_worker_start)
+			options_.on_worker_start(self.index, options_.hook_context);
+		size_t rounds = 0;
+		while (!stop_.load(std::memory_order_relaxed))
+		{
+			task_frame* frame = find_task(&self);
+			if (frame)
+			{
+				execute(frame);
+				rounds = 0;
+			}
+			else
+			{
+				idle(rounds);
+			}
+		}
+		current_worker() = nullptr;
+	}
+
+	// 等待任务组完成, 期间执行其他任务
+	void help_until_done(task_group& group)
+	{
+		worker* w = current_worker();
+		worker* self = (w != nullptr && w->pool == this) ? w : nullptr;
+		size_t rounds = 0;
+		while (!group.done())
+		{
+			task_frame* frame = find_task(self);
+			if (frame)
+			{
+				execute(frame);
+				rounds = 0;
+				continue;
+			}
+			// 等待者不睡眠, 避免错过任务组完成; 自旋过后只让出时间片
+			if (++rounds <= options_.spin_rounds)
+			{
+				for (int i = 0; i < 32; ++i)
+					cpu_relax();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+};
+
+template <class F>
+void task_group::run(F&& f)
+{
+	pool_.spawn(*this, mystl::forward<F>(f));
+}
+
+inline task_group::~task_group()
+{
+	if (!done())
+		pool_.help_until_done(*this);
+}
+
+inline void task_group::wait()
+{
+	pool_.help_until_done(*this);
+	if (has_exception_.load(std::memory_order_acquire))
+	{
+		has_exception_.store(false, std::memory_order_relaxed);
+		std::exception_ptr e = exception_;
+		exception_ = nullptr;
+		std::rethrow_exception(e);
+	}
+}
+
+// 在默认线程池上执行并行循环
+template <class Function>
+void parallel_for(size_t first, size_t last, size_t grain, Function f)
+{
+	thread_pool::default_pool().parallel_for(first, last, grain, f);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_THREAD_POOL_H_
@@ -0,0 +1,638 @@
+#ifndef MYTINYSTL_TUPLE_H_
+#define MYTINYSTL_TUPLE_H_
+
+// 这个头文件包含模板类 tuple 与 compressed_pair, 以及 index_sequence, get, make_tuple, tie,
+// forward_as_tuple, apply 等工具
+// tuple           : 元组
+// compressed_pair : 空类型不占空间的 pair, 用于容器保存比较函数、哈希函数、删除器等
+
+// notes:
+//
+// 每个元素保存在一个 tuple_leaf 中, 空的、非 final 的类型以私有继承的方式保存(空基类优化), 不占空间;
+// 所以 sizeof(compressed_pair<std::less<int>, int*>) == sizeof(int*)
+// 同一个空类型出现多次时, 这些基类子对象的地址必须不同, 编译器会为它们留出空间, 这是语言规定的
+// compressed_pair 不提供 first / second 成员变量, 通过 first() / second() 访问
+// tuple 的元素可以是引用(tie, forward_as_tuple 的结果), 所以赋值逐个元素进行, 不使用默认的赋值运算符
+
+#include <cstddef>
+#include <type_traits>
+
+#include "type_traits.h"
+#include "util.h"
+#include "fuctional.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// index_sequence
+/*****************************************************************************************/
+
+template <size_t... I>
+struct index_sequence
+{
+	static constexpr size_t size() noexcept { return sizeof...(I); }
+};
+
+namespace tuple_detail
+{
+
+template <class Seq1, class Seq2>
+struct concat_sequence;
+
+template <size_t... I, size_t... J>
+struct concat_sequence<index_sequence<I...>, index_sequence<J...>>
+{
+	typedef index_sequence<I..., (sizeof...(I) + J)...> type;
+};
+
+// 对半递归, 实例化深度为 log(N)
+template <size_t N>
+struct make_sequence
+{
+	typedef typename concat_sequence<typename make_sequence<N / 2>::type,
+	                                 typename make_sequence<N - N / 2>::type>::type type;
+};
+
+template <>
+struct make_sequence<0>
+{
+	typedef index_sequence<> type;
+};
+
+template <>
+struct make_sequence<1>
+{
+	typedef index_sequence<0> type;
+};
+
+} // namespace tuple_detail
+
+template <size_t N>
+using make_index_sequence = typename tuple_detail::make_sequence<N>::type;
+
+template <class... T>
+using index_sequence_for = make_index_sequence<sizeof...(T)>;
+
+// 标签类型 piecewise_construct_t: 以 tuple 中的参数分别构造 compressed_pair 的两个成员
+struct piecewise_construct_t
+{
+	explicit piecewise_construct_t() = default;
+};
+constexpr piecewise_construct_t piecewise_construct{};
+
+template <class... T>
+class tuple;
+
+/*****************************************************************************************/
+// tuple_size / tuple_element
+/*****************************************************************************************/
+
+template <class T>
+struct tuple_size;
+
+template <class... T>
+struct tuple_size<tuple<T...>> : m_integral_constant<size_t, sizeof...(T)> {};
+
+template <class T>
+struct tuple_size<const T> : m_integral_constant<size_t, tuple_size<T>::value> {};
+
+template <size_t I, class T>
+struct tuple_element;
+
+template <size_t I, class Head, class... Tail>
+struct tuple_element<I, tuple<Head, Tail...>> : tuple_element<I - 1, tuple<Tail...>> {};
+
+template <class Head, class... Tail>
+struct tuple_element<0, tuple<Head, Tail...>>
+{
+	typedef Head type;
+};
+
+template <size_t I, class T>
+struct tuple_element<I, const T>
+{
+	typedef typename std::add_const<typename tuple_element<I, T>::type>::type type;
+};
+
+template <size_t I, class... T>
+typename tuple_element<I, tuple<T...>>::type& get(tuple<T...>& t) noexcept;
+
+template <size_t I, class... T>
+const typename tuple_element<I, tuple<T...>>::type& get(const tuple<T...>& t) noexcept;
+
+template <size_t I, class... T>
+typename tuple_element<I, tuple<T...>>::type&& get(tuple<T...>&& t) noexcept;
+
+namespace tuple_detail
+{
+
+// 从另一个 tuple 逐个元素构造时使用的标签
+struct from_tuple_t {};
+
+/*****************************************************************************************/
+// tuple_leaf: 保存一个元素, 空类型使用空基类优化
+/*****************************************************************************************/
+
+template <class T>
+struct use_ebo : m_bool_constant<std::is_empty<T>::value && !__is_final(T)> {};
+
+template <size_t I, class T, bool = use_ebo<T>::value>
+class tuple_leaf
+{
+private:
+	T value_;
+
+public:
+	constexpr tuple_leaf() : value_() {}
+
+	template <class U, typename std::enable_if<
+		!std::is_same<typename std::decay<U>::type, tuple_leaf>::value, int>::type = 0>
+	constexpr explicit tuple_leaf(U&& u) : value_(mystl::forward<U>(u)) {}
+
+	template <class Tuple, size_t... J>
+	tuple_leaf(piecewise_construct_t, Tuple&& args, index_sequence<J...>)
+		: value_(mystl::forward<typename tuple_element<J, typename std::decay<Tuple>::type>::type>(
+			mystl::get<J>(args))...)
+	{
+	}
+
+	tuple_leaf(const tuple_leaf&) = default;
+	tuple_leaf(tuple_leaf&&) = default;
+
+	T&       get() noexcept       { return value_; }
+	const T& get() const noexcept { return value_; }
+};
+
+template <size_t I, class T>
+class tuple_leaf<I, T, true> : private T
+{
+public:
+	constexpr tuple_leaf() : T() {}
+
+	template <class U, typename std::enable_if<
+		!std::is_same<typename std::decay<U>::type, tuple_leaf>::value, int>::type = 0>
+	constexpr explicit tuple_leaf(U&& u) : T(mystl::forward<U>(u)) {}
+
+	template <class Tuple, size_t... J>
+	tuple_leaf(piecewise_construct_t, Tuple&& args, index_sequence<J...>)
+		: T(mystl::forward<typename tuple_element<J, typename std::decay<Tuple>::type>::type>(
+			mystl::get<J>(args))...)
+	{
+	}
+
+	tuple_leaf(const tuple_leaf&) = default;
+	tuple_leaf(tuple_leaf&&) = default;
+
+	T&       get() noexcept       { return static_cast<T&>(*this); }
+	const T& get() const noexcept { return static_cast<const T&>(*this); }
+};
+
+// 以 tuple_leaf<I, T> 为基类, 取第 I 个元素时由基类推导出 T, 不需要递归查找类型
+template <size_t I, class T>
+T& get_leaf(tuple_leaf<I, T>& leaf) noexcept
+{
+	return leaf.get();
+}
+
+template <size_t I, class T>
+const T& get_leaf(const tuple_leaf<I, T>& leaf) noexcept
+{
+	return leaf.get();
+}
+
+template <class Seq, class... T>
+struct tuple_impl;
+
+template <size_t... I, class... T>
+struct tuple_impl<index_sequence<I...>, T...> : tuple_leaf<I, T>...
+{
+	constexpr tuple_impl() : tuple_leaf<I, T>()... {}
+
+	template <class... U>
+	constexpr explicit tuple_impl(int, U&&... u) : tuple_leaf<I, T>(mystl::forward<U>(u))... {}
+
+	tuple_impl(const tuple_impl&) = default;
+	tuple_impl(tuple_impl&&) = default;
+};
+
+template <class... B>
+struct all_of : m_true_type {};
+
+template <class B, class... Rest>
+struct all_of<B, Rest...> : m_bool_constant<B::value && all_of<Rest...>::value> {};
+
+// 用于 sizeof...(T) != sizeof...(U) 时不展开 is_constructible, 避免包长度不一致的错误
+template <bool SameSize, class TList, class UList>
+struct constructible_from : m_false_type {};
+
+template <class... T, class... U>
+struct constructible_from<true, tuple<T...>, tuple<U...>>
+	: all_of<std::is_constructible<T, U>...> {};
+
+} // namespace tuple_detail
+
+/*****************************************************************************************/
+// get
+/*****************************************************************************************/
+
+template <size_t I, class... T>
+typename tuple_element<I, tuple<T...>>::type& get(tuple<T...>& t) noexcept
+{
+	return tuple_detail::get_leaf<I>(t.impl_);
+}
+
+template <size_t I, class... T>
+const typename tuple_element<I, tuple<T...>>::type& get(const tuple<T...>& t) noexcept
+{
+	return tuple_detail::get_leaf<I>(t.impl_);
+}
+
+template <size_t I, class... T>
+typename tuple_element<I, tuple<T...>>::type&& get(tuple<T...>&& t) noexcept
+{
+	typedef typename tuple_element<I, tuple<T...>>::type type;
+	return static_cast<type&&>(tuple_detail::get_leaf<I>(t.impl_));
+}
+
+/*****************************************************************************************/
+// tuple
+/*****************************************************************************************/
+
+template <class... T>
+class tuple
+{
+	template <size_t I, class... U>
+	friend typename tuple_element<I, tuple<U...>>::type& get(tuple<U...>&) noexcept;
+	template <size_t I, class... U>
+	friend const typename tuple_element<I, tuple<U...>>::type& get(const tuple<U...>&) noexcept;
+	template <size_t I, class... U>
+	friend typename tuple_element<I, tuple<U...>>::type&& get(tuple<U...>&&) noexcept;
+
+private:
+	typedef index_sequence_for<T...> indices;
+
+	tuple_detail::tuple_impl<indices, T...> impl_;
+
+public:
+	// 构造函数
+	template <class Dummy = void, typename std::enable_if<
+		std::is_void<Dummy>::value &&
+		tuple_detail::all_of<std::is_default_constructible<T>...>::value, int>::type = 0>
+	constexpr tuple() : impl_()
+	{
+	}
+
+	template <class Dummy = void, typename std::enable_if<
+		std::is_void<Dummy>::value && (sizeof...(T) > 0) &&
+		tuple_detail::all_of<std::is_copy_constructible<T>...>::value, int>::type = 0>
+	constexpr tuple(const T&... args) : impl_(0, args...)
+	{
+	}
+
+	template <class... U, typename std::enable_if<
+		(sizeof...(U) > 0) &&
+		tuple_detail::constructible_from<sizeof...(U) == sizeof...(T),
+		                                 tuple<T...>, tuple<U&&...>>::value, int>::type = 0>
+	constexpr tuple(U&&... args) : impl_(0, mystl::forward<U>(args)...)
+	{
+	}
+
+	tuple(const tuple&) = default;
+	tuple(tuple&&) = default;
+
+	template <class... U, typename std::enable_if<
+		tuple_detail::constructible_from<sizeof...(U) == sizeof...(T),
+		                                 tuple<T...>, tuple<const U&...>>::value, int>::type = 0>
+	tuple(const tuple<U...>& rhs) : tuple(tuple_detail::from_tuple_t(), rhs, indices())
+	{
+	}
+
+	template <class... U, typename std::enable_if<
+		tuple_detail::constructible_from<sizeof...(U) == sizeof...(T),
+		                                 tuple<T...>, tuple<U&&...>>::value, int>::type = 0>
+	tuple(tuple<U...>&& rhs) : tuple(tuple_detail::from_tuple_t(), mystl::move(rhs), indices())
+	{
+	}
+
+	template <class U1, class U2, size_t N = sizeof...(T), typename std::enable_if<N == 2, int>::type = 0>
+	tuple(const mystl::pair<U1, U2>& p) : impl_(0, p.first, p.second)
+	{
+	}
+
+	template <class U1, class U2, size_t N = sizeof...(T), typename std::enable_if<N == 2, int>::type = 0>
+	tuple(mystl::pair<U1, U2>&& p) : impl_(0, mystl::forward<U1>(p.first), mystl::forward<U2>(p.second))
+	{
+	}
+
+	// 赋值: 逐个元素赋值, 元素为引用时赋值给所引用的对象
+	tuple& operator=(const tuple& rhs)
+	{
+		assign(rhs, indices());
+		return *this;
+	}
+
+	tuple& operator=(tuple&& rhs) noexcept(
+		tuple_detail::all_of<std::is_nothrow_move_assignable<T>...>::value)
+	{
+		assign(mystl::move(rhs), indices());
+		return *this;
+	}
+
+	template <class... U, typename std::enable_if<sizeof...(U) == sizeof...(T), int>::type = 0>
+	tuple& operator=(const tuple<U...>& rhs)
+	{
+		assign(rhs, indices());
+		return *this;
+	}
+
+	template <class... U, typename std::enable_if<sizeof...(U) == sizeof...(T), int>::type = 0>
+	tuple& operator=(tuple<U...>&& rhs)
+	{
+		assign(mystl::move(rhs), indices());
+		return *this;
+	}
+
+	template <class U1, class U2, size_t N = sizeof...(T), typename std::enable_if<N == 2, int>::type = 0>
+	tuple& operator=(const mystl::pair<U1, U2>& p)
+	{
+		mystl::get<0>(*this) = p.first;
+		mystl::get<1>(*this) = p.second;
+		return *this;
+	}
+
+	void swap(tuple& rhs)
+	{
+		swap_impl(rhs, indices());
+	}
+
+private:
+	template <class Tuple, size_t... I>
+	tuple(tuple_detail::from_tuple_t, Tuple&& rhs, index_sequence<I...>)
+		: impl_(0, mystl::get<I>(mystl::forward<Tuple>(rhs))...)
+	{
+	}
+
+	template <class Tuple, size_t... I>
+	void assign(Tuple&& rhs, index_sequence<I...>)
+	{
+		int expand[] = { 0, ((void)(mystl::get<I>(*this) = mystl::get<I>(mystl::forward<Tuple>(rhs))), 0)... };
+		(void)expand;
+	}
+
+	template <size_t... I>
+	void swap_impl(tuple& rhs, index_sequence<I...>)
+	{
+		int expand[] = { 0, ((void)(mystl::swap(mystl::get<I>(*this), mystl::get<I>(rhs))), 0)... };
+		(void)expand;
+	}
+};
+
+template <>
+class tuple<>
+{
+public:
+	constexpr tuple() noexcept {}
+	void swap(tuple&) noexcept {}
+};
+
+/*****************************************************************************************/
+// make_tuple / tie / forward_as_tuple / ignore
+/*****************************************************************************************/
+
+namespace tuple_detail
+{
+
+// make_tuple 中 std::reference_wrapper<T> 保存为 T&
+template <class T>
+struct unwrap_ref
+{
+	typedef T type;
+};
+
+template <class T>
+struct unwrap_ref<std::reference_wrapper<T>>
+{
+	typedef T& type;
+};
+
+template <class T>
+using decay_unwrap = typename unwrap_ref<typename std::decay<T>::type>::type;
+
+struct ignore_t
+{
+	template <class U>
+	const ignore_t& operator=(U&&) const noexcept
+	{
+		return *this;
+	}
+};
+
+} // namespace tuple_detail
+
+// tie 中用于忽略某个元素
+constexpr tuple_detail::ignore_t ignore{};
+
+template <class... T>
+tuple<tuple_detail::decay_unwrap<T>...> make_tuple(T&&... args)
+{
+	return tuple<tuple_detail::decay_unwrap<T>...>(mystl::forward<T>(args)...);
+}
+
+template <class... T>
+tuple<T&...> tie(T&... args) noexcept
+{
+	return tuple<T&...>(args...);
+}
+
+template <class... T>
+tuple<T&&...> forward_as_tuple(T&&... args) noexcept
+{
+	return tuple<T&&...>(mystl::forward<T>(args)...);
+}
+
+/*****************************************************************************************/
+// apply: 以 tuple 的元素为参数调用 f
+/*****************************************************************************************/
+
+namespace tuple_detail
+{
+
+template <class F, class Tuple, size_t... I>
+auto apply_impl(F&& f, Tuple&& t, index_sequence<I...>)
+	-> decltype(mystl::invoke(mystl::forward<F>(f), mystl::get<I>(mystl::forward<Tuple>(t))...))
+{
+	return mystl::invoke(mystl::forward<F>(f), mystl::get<I>(mystl::forward<Tuple>(t))...);
+}
+
+} // namespace tuple_detail
+
+template <class F, class Tuple>
+auto apply(F&& f, Tuple&& t)
+	-> decltype(tuple_detail::apply_impl(mystl::forward<F>(f), mystl::forward<Tuple>(t),
+	            make_index_sequence<tuple_size<typename std::remove_reference<Tuple>::type>::value>()))
+{
+	return tuple_detail::apply_impl(mystl::forward<F>(f), mystl::forward<Tuple>(t),
+	       make_index_sequence<tuple_size<typename std::remove_reference<Tuple>::type>::value>());
+}
+
+/*****************************************************************************************/
+// 比较操作符与 swap
+/*****************************************************************************************/
+
+namespace tuple_detail
+{
+
+template <size_t I, size_t N>
+struct tuple_compare
+{
+	template <class T, class U>
+	static bool equal(const T& lhs, const U& rhs)
+	{
+		return mystl::get<I>(lhs) == mystl::get<I>(rhs) && tuple_compare<I + 1, N>::equal(lhs, rhs);
+	}
+
+	template <class T, class U>
+	static bool less(const T& lhs, const U& rhs)
+	{
+		if (mystl::get<I>(lhs) < mystl::get<I>(rhs))
+			return true;
+		if (mystl::get<I>(rhs) < mystl::get<I>(lhs))
+			return false;
+		return tuple_compare<I + 1, N>::less(lhs, rhs);
+	}
+};
+
+template <size_t N>
+struct tuple_compare<N, N>
+{
+	template <class T, class U>
+	static bool equal(const T&, const U&) { return true; }
+
+	template <class T, class U>
+	static bool less(const T&, const U&) { return false; }
+};
+
+} // namespace tuple_detail
+
+template <class... T, class... U>
+bool operator==(const tuple<T...>& lhs, const tuple<U...>& rhs)
+{
+	static_assert(sizeof...(T) == sizeof...(U), "tuples of different sizes can not be compared");
+	return tuple_detail::tuple_compare<0, sizeof...(T)>::equal(lhs, rhs);
+}
+
+template <class... T, class... U>
+bool operator<(const tuple<T...>& lhs, const tuple<U...>& rhs)
+{
+	static_assert(sizeof...(T) == sizeof...(U), "tuples of different sizes can not be compared");
+	return tuple_detail::tuple_compare<0, sizeof...(T)>::less(lhs, rhs);
+}
+
+template <class... T, class... U>
+bool operator!=(const tuple<T...>& lhs, const tuple<U...>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class... T, class... U>
+bool operator>(const tuple<T...>& lhs, const tuple<U...>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class... T, class... U>
+bool operator<=(const tuple<T...>& lhs, const tuple<U...>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class... T, class... U>
+bool operator>=(const tuple<T...>& lhs, const tuple<U...>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+template <class... T>
+void swap(tuple<T...>& lhs, tuple<T...>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// compressed_pair
+// 与 pair 相同, 但空的成员(比较函数、哈希函数、删除器等)不占空间
+/*****************************************************************************************/
+
+template <class T1, class T2>
+class compressed_pair : private tuple_detail::tuple_leaf<0, T1>,
+                        private tuple_detail::tuple_leaf<1, T2>
+{
+private:
+	typedef tuple_detail::tuple_leaf<0, T1> first_base;
+	typedef tuple_detail::tuple_leaf<1, T2> second_base;
+
+public:
+	typedef T1 first_type;
+	typedef T2 second_type;
+
+	constexpr compressed_pair() : first_base(), second_base() {}
+
+	template <class U1, class U2>
+	constexpr compressed_pair(U1&& a, U2&& b)
+		: first_base(mystl::forward<U1>(a)), second_base(mystl::forward<U2>(b))
+	{
+	}
+
+	// 以两个 tuple 中的参数分别构造两个成员, 如 compressed_pair<A, B>(piecewise_construct,
+	// forward_as_tuple(a1, a2), forward_as_tuple())
+	template <class... Args1, class... Args2>
+	compressed_pair(piecewise_construct_t, tuple<Args1...> args1, tuple<Args2...> args2)
+		: first_base(piecewise_construct, args1, index_sequence_for<Args1...>()),
+		  second_base(piecewise_construct, args2, index_sequence_for<Args2...>())
+	{
+	}
+
+	compressed_pair(const compressed_pair&) = default;
+	compressed_pair(compressed_pair&&) = default;
+
+	compressed_pair& operator=(const compressed_pair& rhs)
+	{
+		first() = rhs.first();
+		second() = rhs.second();
+		return *this;
+	}
+
+	compressed_pair& operator=(compressed_pair&& rhs) noexcept(
+		std::is_nothrow_move_assignable<T1>::value && std::is_nothrow_move_assignable<T2>::value)
+	{
+		first() = mystl::move(rhs.first());
+		second() = mystl::move(rhs.second());
+		return *this;
+	}
+
+	T1&       first() noexcept        { return first_base::get(); }
+	const T1& first() const noexcept  { return first_base::get(); }
+	T2&       second() noexcept       { return second_base::get(); }
+	const T2& second() const noexcept { return second_base::get(); }
+
+	void swap(compressed_pair& rhs)
+	{
+		mystl::swap(first(), rhs.first());
+		mystl::swap(second(), rhs.second());
+	}
+};
+
+template <class T1, class T2>
+void swap(compressed_pair<T1, T2>& lhs, compressed_pair<T1, T2>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+static_assert(sizeof(compressed_pair<mystl::less<int>, int*>) == sizeof(int*),
+              "an empty member of compressed_pair should take no space");
+static_assert(sizeof(tuple<mystl::less<int>, mystl::equal_to<int>, int*>) == sizeof(int*),
+              "empty elements of tuple should take no space");
+
+} // namespace mystl
+#endif // !MYTINYSTL_TUPLE_H_
@@ -6,9 +6,43 @@
 // use standard header for type_traits
 #include <type_traits>
 
+// constexpr 支持
+// MYSTL_CONSTEXPR14 : C++14 起为 constexpr, 用于函数体中有多条语句的简单函数
+// MYSTL_CONSTEXPR20 : C++20 起为 constexpr, 用于构造 / 析构对象、分配内存的函数, 以及依赖它们的算法与容器
+// 这样算法与 array, inplace_vector 等可以在编译期求值, 用来生成放在只读数据段中的查找表
+#if defined(_MSVC_LANG) && _MSVC_LANG > __cplusplus
+#define MYSTL_CPLUSPLUS _MSVC_LANG
+#else
+#define MYSTL_CPLUSPLUS __cplusplus
+#endif
+
+#if MYSTL_CPLUSPLUS >= 201402L
+#define MYSTL_CONSTEXPR14 constexpr
+#else
+#define MYSTL_CONSTEXPR14
+#endif
+
+#if MYSTL_CPLUSPLUS >= 202002L && defined(__cpp_constexpr_dynamic_alloc)
+#define MYSTL_HAS_CONSTEXPR20 1
+#define MYSTL_CONSTEXPR20 constexpr
+#else
+#define MYSTL_CONSTEXPR20
+#endif
+
 namespace mystl
 {
 
+// 是否处于常量求值中; 常量求值中不能使用 memmove / memset 等函数与内联汇编, 需要改用普通的循环
+// C++20 之前没有常量求值的 mystl 函数, 总是返回 false
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(MYSTL_HAS_CONSTEXPR20)
+	return std::is_constant_evaluated();
+#else
+	return false;
+#endif
+}
+
 // helper struct
 
 template <class T, T v>
@@ -42,6 +76,46 @@ struct is_pair : mystl::m_false_type {};
 template <class T1, class T2>
 struct is_pair<mystl::pair<T1, T2>> : mystl::m_true_type {};
 
+// has_is_transparent
+// 比较函数或哈希函数是否定义了 is_transparent, 定义了即表示支持不同类型参数的异构查找
+
+template <class T>
+struct has_is_transparent
+{
+private:
+  template <class U>
+  static char test(typename U::is_transparent*);
+  template <class U>
+  static long test(...);
+
+public:
+  static constexpr bool value = sizeof(test<T>(nullptr)) == 1;
+};
+
+// transparent_key_arg
+// 容器查找类函数的参数类型: 支持异构查找时为调用者传入的类型 K, 否则固定为键值类型 Key
+
+template <bool Transparent>
+struct transparent_key_arg
+{
+  template <class K, class Key>
+  using type = Key;
+};
+
+template <>
+struct transparent_key_arg<true>
+{
+  template <class K, class Key>
+  using type = K;
+};
+
+// is_trivially_relocatable
+// 把对象的字节复制到新地址、且不再析构原对象, 等价于在新地址移动构造再析构原对象
+// 平凡可复制的类型都满足; 只持有指向堆的指针、不持有指向自身的指针的类(如 vector)可以特化为 true
+
+template <class T>
+struct is_trivially_relocatable : m_bool_constant<std::is_trivially_copyable<T>::value> {};
+
 } // namespace mystl
 
 #endif // !MYTINYSTL_TYPE_TRAITS_H_
\ No newline at end of file
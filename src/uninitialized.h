@@ -3,84 +3,114 @@
 
 // 这个头文件用于对未初始化空间构造元素
 // 主要实现了,复制,填充,移动三种功能,填充和移动的功能实现均类似于复制的实现
+// 以及 uninitialized_move_if_noexcept 与转移对象的 uninitialized_relocate
+
+// notes:
+//
+// 异常保证：
+// 逐个构造的版本在抛出异常时析构已经构造的元素, 再重新抛出异常
+
+#include <cstring>
 
 #include "algobase.h"
 #include "construct.h"
+#include "exceptdef.h"
 #include "iterator.h"
 #include "type_traits.h"
 #include "util.h"
 
 namespace mystl
 {
+
+// 元素可平凡复制, 并且相应的赋值运算符可用且平凡时, 在未初始化空间上的构造才能改为 copy / fill / move 赋值
+// (含 const 或引用成员的类型可平凡复制, 却不能赋值)
+template <class T>
+struct uninit_copy_by_assign : std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                                            std::is_trivially_copy_assignable<T>::value> {};
+
+template <class T>
+struct uninit_move_by_assign : std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                                            std::is_trivially_move_assignable<T>::value> {};
 // uninitialized_copy
 // 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 
 // 当目标类型支持平凡复制时，直接使用复制算法
 template <class InputerIter, class ForwardIter>
-ForwardIter unchecked_uninit_copy(InputerIter first, InputerIter last, ForwardIter result, std::true_type)
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy(InputerIter first, InputerIter last, ForwardIter result, std::true_type)
 {
 	return mystl::copy(first, last, result);
 }
 
 // 当目标类型不支持平凡复制时，使用构造函数逐个构造元素，并处理可能发生的异常
 template <class InputIter, class ForwardIter>
-ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::false_type)
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::false_type)
 {
 	auto cur = result;
-	try
+	MYSTL_TRY
 	{
 		for (; first != last; ++first, ++cur)
 			mystl::construct(&*cur, *first);
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
-		for (; result != cur; --cur)
-			mystl::destroy(&*cur);
+		mystl::destroy(result, cur);
+		MYSTL_RETHROW;
 	}
 	return cur;
 }
 
 // 根据ForwardIter中元素类型的属性，调用unchecked_uninit_copy处理元素复制
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result)
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result)
 {
 	return mystl::unchecked_uninit_copy(first, last, result,
-	                                    std::is_trivially_copy_assignable<
+	                                    mystl::uninit_copy_by_assign<
 		                                    typename iterator_traits<ForwardIter>::
 		                                    value_type>{});
 }
 
+template <class InputIter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result);
+
+// 从 move_iterator 复制即为移动, 转交给 uninitialized_move 以命中它的快速路径
+template <class Iter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy(mystl::move_iterator<Iter> first, mystl::move_iterator<Iter> last,
+                                                 ForwardIter result)
+{
+	return mystl::uninitialized_move(first.base(), last.base(), result);
+}
+
 // uninitialized_copy_n
 // 把 [first, first + n) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::true_type)
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::true_type)
 {
 	return mystl::copy_n(first, n, result).second;
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::false_type)
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::false_type)
 {
 	auto cur = result;
-	try
+	MYSTL_TRY
 	{
 		for (; n > 0; --n, ++cur, ++first)
 			mystl::construct(&*cur, *first);
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
-		for (; result != cur; --cur)
-			mystl::destroy(&*cur);
+		mystl::destroy(result, cur);
+		MYSTL_RETHROW;
 	}
 	return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result)
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result)
 {
 	return mystl::unchecked_uninit_copy_n(first, n, result,
-	                                      std::is_trivially_copy_assignable<
+	                                      mystl::uninit_copy_by_assign<
 		                                      typename iterator_traits<InputIter>::
 		                                      value_type>{});
 }
@@ -88,34 +118,34 @@ ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result)
 // uninitialized_fill
 // 在 [first, last) 区间内填充元素值
 template <class ForwardIter, class T>
-void
+MYSTL_CONSTEXPR20 void
 unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type)
 {
 	mystl::fill(first, last, value);
 }
 
 template <class ForwardIter, class T>
-void
+MYSTL_CONSTEXPR20 void
 unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type)
 {
 	auto cur = first;
-	try
+	MYSTL_TRY
 	{
 		for (; cur != last; ++cur)
 			mystl::construct(&*cur, value);
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
-		for (; first != cur; ++first)
-			mystl::destroy(&*first);
+		mystl::destroy(first, cur);
+		MYSTL_RETHROW;
 	}
 }
 
 template <class ForwardIter, class T>
-void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value)
+MYSTL_CONSTEXPR20 void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value)
 {
 	mystl::unchecked_uninit_fill(first, last, value,
-	                             std::is_trivially_copy_assignable<
+	                             mystl::uninit_copy_by_assign<
 		                             typename iterator_traits<ForwardIter>::
 		                             value_type>{});
 }
@@ -124,35 +154,35 @@ void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value)
 // 从 first 位置开始，填充 n 个元素值，返回填充结束的位置
 
 template <class ForwardIter, class Size, class T>
-ForwardIter
+MYSTL_CONSTEXPR20 ForwardIter
 unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_type)
 {
 	return mystl::fill_n(first, n, value);
 }
 
 template <class ForwardIter, class Size, class T>
-ForwardIter
+MYSTL_CONSTEXPR20 ForwardIter
 unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::false_type)
 {
 	auto cur = first;
-	try
+	MYSTL_TRY
 	{
 		for (; n > 0; --n, ++cur)
 			mystl::construct(&*cur, value);
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
-		for (; first != cur; ++first)
-			mystl::destroy(&*first);
+		mystl::destroy(first, cur);
+		MYSTL_RETHROW;
 	}
 	return cur;
 }
 
 template <class ForwardIter, class Size, class T>
-ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value)
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value)
 {
 	return mystl::unchecked_uninit_fill_n(first, n, value,
-	                                      std::is_trivially_copy_assignable<
+	                                      mystl::uninit_copy_by_assign<
 		                                      typename iterator_traits<ForwardIter>::
 		                                      value_type>{});
 }
@@ -161,34 +191,35 @@ ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value)
 // 把[first, last)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
 
 template <class InputIter, class ForwardIter>
-ForwardIter
+MYSTL_CONSTEXPR20 ForwardIter
 unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::true_type)
 {
 	return mystl::move(first, last, result);
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter
+MYSTL_CONSTEXPR20 ForwardIter
 unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::false_type)
 {
 	ForwardIter cur = result;
-	try
+	MYSTL_TRY
 	{
 		for (; first != last; ++first, ++cur)
 			mystl::construct(&*cur, mystl::move(*first));
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
 		mystl::destroy(result, cur);
+		MYSTL_RETHROW;
 	}
 	return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result)
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result)
 {
 	return mystl::unchecked_uninit_move(first, last, result,
-	                                    std::is_trivially_move_assignable<
+	                                    mystl::uninit_move_by_assign<
 		                                    typename iterator_traits<InputIter>::
 		                                    value_type>{});
 }
@@ -197,39 +228,134 @@ ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter resu
 // 把[first, first + n)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter
+MYSTL_CONSTEXPR20 ForwardIter
 unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::true_type)
 {
 	return mystl::move(first, first + n, result);
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter
+MYSTL_CONSTEXPR20 ForwardIter
 unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::false_type)
 {
 	auto cur = result;
-	try
+	MYSTL_TRY
 	{
 		for (; n > 0; --n, ++first, ++cur)
 			mystl::construct(&*cur, mystl::move(*first));
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
-		for (; result != cur; ++result)
-			mystl::destroy(&*result);
-		throw;
+		mystl::destroy(result, cur);
+		MYSTL_RETHROW;
 	}
 	return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result)
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result)
 {
 	return mystl::unchecked_uninit_move_n(first, n, result,
-	                                      std::is_trivially_move_assignable<
+	                                      mystl::uninit_move_by_assign<
 		                                      typename iterator_traits<InputIter>::
 		                                      value_type>{});
 }
 
+// uninitialized_move_if_noexcept
+// 把[first, last)上的内容移动或复制到以 result 为起始处的空间，返回结束的位置
+// 移动构造不抛出异常、或者元素不能复制时移动, 否则复制; 抛出异常时源区间保持不变, 用于容器重新分配时的强异常保证
+
+template <class InputIter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter
+unchecked_uninit_move_if_noexcept(InputIter first, InputIter last, ForwardIter result, std::true_type)
+{
+	return mystl::uninitialized_move(first, last, result);
+}
+
+template <class InputIter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter
+unchecked_uninit_move_if_noexcept(InputIter first, InputIter last, ForwardIter result, std::false_type)
+{
+	return mystl::uninitialized_copy(first, last, result);
+}
+
+template <class InputIter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_move_if_noexcept(InputIter first, InputIter last, ForwardIter result)
+{
+	typedef typename iterator_traits<InputIter>::value_type value_type;
+	return mystl::unchecked_uninit_move_if_noexcept(first, last, result,
+	                                                std::integral_constant<bool,
+		                                                std::is_nothrow_move_constructible<value_type>::value ||
+		                                                !std::is_copy_constructible<value_type>::value>{});
+}
+
+// uninitialized_relocate
+// 把[first, last)上的对象转移到以 result 为起始处的空间，返回结束的位置; 之后源区间不再有对象, 不需要析构
+// 可平凡重定位(is_trivially_relocatable)的类型直接 memmove, 否则逐个移动构造并析构源对象
+// 抛出异常时源区间与目标区间中的对象都已被析构
+
+template <class T>
+MYSTL_CONSTEXPR20 T* unchecked_uninit_relocate(T* first, T* last, T* result, std::true_type) noexcept
+{
+	const size_t n = static_cast<size_t>(last - first);
+	if (mystl::is_constant_evaluated())
+	{
+		// 常量求值中不能使用 memmove, 按 memmove 的方向逐个移动构造并析构源对象
+		if (result <= first)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				mystl::construct(result + i, mystl::move(first[i]));
+				mystl::destroy(first + i);
+			}
+		}
+		else
+		{
+			for (size_t i = n; i > 0; --i)
+			{
+				mystl::construct(result + i - 1, mystl::move(first[i - 1]));
+				mystl::destroy(first + i - 1);
+			}
+		}
+		return result + n;
+	}
+	if (n != 0)
+		std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(T));
+	return result + n;
+}
+
+template <class InputIter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter
+unchecked_uninit_relocate(InputIter first, InputIter last, ForwardIter result, std::false_type)
+{
+	auto cur = result;
+	MYSTL_TRY
+	{
+		for (; first != last; ++first, ++cur)
+		{
+			mystl::construct(&*cur, mystl::move(*first));
+			mystl::destroy(&*first);
+		}
+	}
+	MYSTL_CATCH_ALL
+	{
+		mystl::destroy(first, last);
+		mystl::destroy(result, cur);
+		MYSTL_RETHROW;
+	}
+	return cur;
+}
+
+template <class InputIter, class ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_relocate(InputIter first, InputIter last, ForwardIter result)
+{
+	typedef typename iterator_traits<InputIter>::value_type value_type;
+	return mystl::unchecked_uninit_relocate(first, last, result,
+	                                        std::integral_constant<bool,
+		                                        std::is_pointer<InputIter>::value &&
+		                                        std::is_same<InputIter, ForwardIter>::value &&
+		                                        mystl::is_trivially_relocatable<value_type>::value>{});
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_UNINITIALIZED_H_
@@ -0,0 +1,333 @@
+#ifndef MYTINYSTL_UNORDERED_MAP_H_
+#define MYTINYSTL_UNORDERED_MAP_H_
+
+// 这个头文件包含两个模板类 unordered_map 和 node_hash_map
+// unordered_map : 用法与 map 类似，但元素无序，元素直接存放在开放寻址的哈希表中
+// node_hash_map : 与 unordered_map 相同, 但每个元素单独分配, 插入与重新哈希都不会改变元素的地址
+
+// notes:
+//
+// 异常保证：
+// mystl::unordered_map<Key, T> / mystl::node_hash_map<Key, T> 满足基本异常保证，
+// 对以下等函数做强异常安全保证：
+//   * emplace
+//   * try_emplace
+//   * insert
+// 重新哈希时 unordered_map 会移动元素, 要求元素的移动构造不抛出异常, 并且会使指向元素的指针与引用失效;
+// 需要指针稳定时使用 node_hash_map
+// 两者都不支持重复的键, 没有提供 unordered_multimap
+
+#include <initializer_list>
+
+#include "hashtable.h"
+
+namespace mystl
+{
+
+// 模板类 basic_unordered_map
+// 参数一代表元素的存放策略，参数二代表哈希函数，参数三代表键值相等的比较函数
+// 通常通过下面的 unordered_map 与 node_hash_map 使用
+template <class Policy, class Hash, class KeyEqual>
+class basic_unordered_map
+{
+private:
+	// 使用 hashtable 作为底层机制
+	typedef hashtable<Policy, Hash, KeyEqual> base_type;
+	base_type ht_;
+
+public:
+	// 使用 hashtable 的型别
+	typedef typename base_type::key_type        key_type;
+	typedef typename Policy::mapped_type        mapped_type;
+	typedef typename base_type::value_type      value_type;
+	typedef typename base_type::hasher          hasher;
+	typedef typename base_type::key_equal       key_equal;
+
+	typedef typename base_type::size_type       size_type;
+	typedef typename base_type::difference_type difference_type;
+	typedef typename base_type::pointer         pointer;
+	typedef typename base_type::const_pointer   const_pointer;
+	typedef typename base_type::reference       reference;
+	typedef typename base_type::const_reference const_reference;
+
+	typedef typename base_type::iterator        iterator;
+	typedef typename base_type::const_iterator  const_iterator;
+
+	template <class K>
+	using key_arg = typename base_type::template key_arg<K>;
+
+public:
+	// 构造、复制、移动、析构函数
+	basic_unordered_map()
+		:ht_()
+	{
+	}
+
+	explicit basic_unordered_map(size_type bucket_count,
+	                             const Hash& hash = Hash(),
+	                             const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+	}
+
+	template <class InputIterator>
+	basic_unordered_map(InputIterator first, InputIterator last,
+	                    const size_type bucket_count = 0,
+	                    const Hash& hash = Hash(),
+	                    const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+		ht_.insert(first, last);
+	}
+
+	basic_unordered_map(std::initializer_list<value_type> ilist,
+	                    const size_type bucket_count = 0,
+	                    const Hash& hash = Hash(),
+	                    const KeyEqual& equal = KeyEqual())
+		:ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+	{
+		for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
+			ht_.insert(*first);
+	}
+
+	basic_unordered_map(const basic_unordered_map& rhs)
+		:ht_(rhs.ht_)
+	{
+	}
+	basic_unordered_map(basic_unordered_map&& rhs) noexcept
+		:ht_(mystl::move(rhs.ht_))
+	{
+	}
+
+	basic_unordered_map& operator=(const basic_unordered_map& rhs)
+	{
+		ht_ = rhs.ht_;
+		return *this;
+	}
+	basic_unordered_map& operator=(basic_unordered_map&& rhs) noexcept
+	{
+		ht_ = mystl::move(rhs.ht_);
+		return *this;
+	}
+
+	basic_unordered_map& operator=(std::initializer_list<value_type> ilist)
+	{
+		ht_.clear();
+		ht_.reserve(ilist.size());
+		for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
+			ht_.insert(*first);
+		return *this;
+	}
+
+	~basic_unordered_map() = default;
+
+	// 迭代器相关
+
+	iterator       begin()        noexcept
+	{ return ht_.begin(); }
+	const_iterator begin()  const noexcept
+	{ return ht_.begin(); }
+	iterator       end()          noexcept
+	{ return ht_.end(); }
+	const_iterator end()    const noexcept
+	{ return ht_.end(); }
+
+	const_iterator cbegin() const noexcept
+	{ return ht_.cbegin(); }
+	const_iterator cend()   const noexcept
+	{ return ht_.cend(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return ht_.empty(); }
+	size_type size()     const noexcept { return ht_.size(); }
+	size_type max_size() const noexcept { return ht_.max_size(); }
+
+	// 修改容器操作
+
+	// emplace / emplace_hint
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{ return ht_.emplace(mystl::forward<Args>(args)...); }
+
+	// 开放寻址的表中 hint 没有意义, 忽略
+	template <class ...Args>
+	iterator emplace_hint(const_iterator, Args&& ...args)
+	{ return ht_.emplace(mystl::forward<Args>(args)...).first; }
+
+	// try_emplace
+	// 键不存在时才构造元素, 键存在时 args 不会被移动
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+	{ return ht_.try_emplace(key, mystl::forward<Args>(args)...); }
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+	{ return ht_.try_emplace(mystl::move(key), mystl::forward<Args>(args)...); }
+
+	// insert
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{ return ht_.insert(value); }
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{ return ht_.insert(mystl::move(value)); }
+
+	iterator insert(const_iterator, const value_type& value)
+	{ return ht_.insert(value).first; }
+	iterator insert(const_iterator, value_type&& value)
+	{ return ht_.insert(mystl::move(value)).first; }
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{ ht_.insert(first, last); }
+
+	void insert(std::initializer_list<value_type> ilist)
+	{ ht_.insert(ilist.begin(), ilist.end()); }
+
+	// insert_or_assign
+	// 键存在时对映射值赋值, 否则插入
+
+	template <class M>
+	mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+	{
+		auto result = ht_.try_emplace(key, mystl::forward<M>(obj));
+		if (!result.second)
+			result.first->second = mystl::forward<M>(obj);
+		return result;
+	}
+
+	template <class M>
+	mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+	{
+		auto result = ht_.try_emplace(mystl::move(key), mystl::forward<M>(obj));
+		if (!result.second)
+			result.first->second = mystl::forward<M>(obj);
+		return result;
+	}
+
+	// erase / clear
+
+	iterator  erase(iterator it)
+	{ return ht_.erase(it); }
+	iterator  erase(const_iterator it)
+	{ return ht_.erase(it); }
+	iterator  erase(const_iterator first, const_iterator last)
+	{ return ht_.erase(first, last); }
+
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{ return ht_.template erase<K>(key); }
+
+	void      clear()
+	{ ht_.clear(); }
+
+	void      swap(basic_unordered_map& other) noexcept
+	{ ht_.swap(other.ht_); }
+
+	// 查找相关
+
+	mapped_type& at(const key_type& key)
+	{
+		auto it = ht_.find(key);
+		THROW_OUT_OF_RANGE_IF(it == ht_.end(), "unordered_map<Key, T> no such element exists");
+		return it->second;
+	}
+	const mapped_type& at(const key_type& key) const
+	{
+		auto it = ht_.find(key);
+		THROW_OUT_OF_RANGE_IF(it == ht_.end(), "unordered_map<Key, T> no such element exists");
+		return it->second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		return ht_.try_emplace(key).first->second;
+	}
+	mapped_type& operator[](key_type&& key)
+	{
+		return ht_.try_emplace(mystl::move(key)).first->second;
+	}
+
+	template <class K = key_type>
+	size_type      count(const key_arg<K>& key) const
+	{ return ht_.template count<K>(key); }
+
+	template <class K = key_type>
+	bool           contains(const key_arg<K>& key) const
+	{ return ht_.template contains<K>(key); }
+
+	template <class K = key_type>
+	iterator       find(const key_arg<K>& key)
+	{ return ht_.template find<K>(key); }
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{ return ht_.template find<K>(key); }
+
+	template <class K = key_type>
+	mystl::pair<iterator, iterator> equal_range(const key_arg<K>& key)
+	{ return ht_.template equal_range<K>(key); }
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{ return ht_.template equal_range<K>(key); }
+
+	// bucket interface
+
+	size_type bucket_count()     const noexcept
+	{ return ht_.bucket_count(); }
+	size_type max_bucket_count() const noexcept
+	{ return ht_.max_bucket_count(); }
+
+	// hash policy
+
+	float     load_factor()            const noexcept { return ht_.load_factor(); }
+
+	float     max_load_factor()        const noexcept { return ht_.max_load_factor(); }
+	void      max_load_factor(float ml)                 { ht_.max_load_factor(ml); }
+
+	void      rehash(size_type count)                   { ht_.rehash(count); }
+	void      reserve(size_type count)                  { ht_.reserve(count); }
+
+	hasher    hash_function()          const            { return ht_.hash_function(); }
+	key_equal key_eq()                 const            { return ht_.key_eq(); }
+
+public:
+	friend bool operator==(const basic_unordered_map& lhs, const basic_unordered_map& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return false;
+		for (auto it = lhs.begin(); it != lhs.end(); ++it)
+		{
+			auto other = rhs.find(it->first);
+			if (other == rhs.end() || !(other->second == it->second))
+				return false;
+		}
+		return true;
+	}
+	friend bool operator!=(const basic_unordered_map& lhs, const basic_unordered_map& rhs)
+	{
+		return !(lhs == rhs);
+	}
+};
+
+// 重载 mystl 的 swap
+template <class Policy, class Hash, class KeyEqual>
+void swap(basic_unordered_map<Policy, Hash, KeyEqual>& lhs,
+          basic_unordered_map<Policy, Hash, KeyEqual>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+// 模板类 unordered_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 mystl::hash
+// 参数四代表键值比较方式，缺省使用 mystl::equal_to
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+using unordered_map = basic_unordered_map<flat_map_policy<Key, T>, Hash, KeyEqual>;
+
+// 模板类 node_hash_map，键值不允许重复, 元素地址稳定
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+using node_hash_map = basic_unordered_map<node_map_policy<Key, T>, Hash, KeyEqual>;
+
+} // namespace mystl
+#endif // !MYTINYSTL_UNORDERED_MAP_H_
@@ -0,0 +1,265 @@
+#ifndef MYTINYSTL_UNORDERED_SET_H_
+#define MYTINYSTL_UNORDERED_SET_H_
+
+// 这个头文件包含一个模板类 unordered_set
+// unordered_set : 用法与 set 类似，但元素无序，元素直接存放在开放寻址的哈希表中
+
+// notes:
+//
+// 异常保证：
+// mystl::unordered_set<Key> 满足基本异常保证，对以下等函数做强异常安全保证：
+//   * emplace
+//   * insert
+// 重新哈希时会移动元素, 要求元素的移动构造不抛出异常
+// 不支持重复的键, 没有提供 unordered_multiset
+
+#include <initializer_list>
+
+#include "hashtable.h"
+
+namespace mystl
+{
+
+// 模板类 unordered_set，键值不允许重复
+// 参数一代表键值类型，参数二代表哈希函数，缺省使用 mystl::hash，
+// 参数三代表键值比较方式，缺省使用 mystl::equal_to
+template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class unordered_set
+{
+private:
+	// 使用 hashtable 作为底层机制
+	typedef hashtable<flat_set_policy<Key>, Hash, KeyEqual> base_type;
+	base_type ht_;
+
+public:
+	// 使用 hashtable 的型别
+	typedef typename base_type::key_type        key_type;
+	typedef typename base_type::value_type      value_type;
+	typedef typename base_type::hasher          hasher;
+	typedef typename base_type::key_equal       key_equal;
+
+	typedef typename base_type::size_type       size_type;
+	typedef typename base_type::difference_type difference_type;
+	typedef typename base_type::pointer         pointer;
+	typedef typename base_type::const_pointer   const_pointer;
+	typedef typename base_type::reference       reference;
+	typedef typename base_type::const_reference const_reference;
+
+	// 元素即键值, 不允许通过迭代器修改
+	typedef typename base_type::const_iterator  iterator;
+	typedef typename base_type::const_iterator  const_iterator;
+
+	template <class K>
+	using key_arg = typename base_type::template key_arg<K>;
+
+public:
+	// 构造、复制、移动、析构函数
+	unordered_set()
+		:ht_()
+	{
+	}
+
+	explicit unordered_set(size_type bucket_count,
+	                       const Hash& hash = Hash(),
+	                       const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+	}
+
+	template <class InputIterator>
+	unordered_set(InputIterator first, InputIterator last,
+	              const size_type bucket_count = 0,
+	              const Hash& hash = Hash(),
+	              const KeyEqual& equal = KeyEqual())
+		:ht_(bucket_count, hash, equal)
+	{
+		ht_.insert(first, last);
+	}
+
+	unordered_set(std::initializer_list<value_type> ilist,
+	              const size_type bucket_count = 0,
+	              const Hash& hash = Hash(),
+	              const KeyEqual& equal = KeyEqual())
+		:ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+	{
+		for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
+			ht_.insert(*first);
+	}
+
+	unordered_set(const unordered_set& rhs)
+		:ht_(rhs.ht_)
+	{
+	}
+	unordered_set(unordered_set&& rhs) noexcept
+		:ht_(mystl::move(rhs.ht_))
+	{
+	}
+
+	unordered_set& operator=(const unordered_set& rhs)
+	{
+		ht_ = rhs.ht_;
+		return *this;
+	}
+	unordered_set& operator=(unordered_set&& rhs) noexcept
+	{
+		ht_ = mystl::move(rhs.ht_);
+		return *this;
+	}
+
+	unordered_set& operator=(std::initializer_list<value_type> ilist)
+	{
+		ht_.clear();
+		ht_.reserve(ilist.size());
+		for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
+			ht_.insert(*first);
+		return *this;
+	}
+
+	~unordered_set() = default;
+
+	// 迭代器相关
+
+	iterator       begin()        noexcept
+	{ return ht_.begin(); }
+	const_iterator begin()  const noexcept
+	{ return ht_.begin(); }
+	iterator       end()          noexcept
+	{ return ht_.end(); }
+	const_iterator end()    const noexcept
+	{ return ht_.end(); }
+
+	const_iterator cbegin() const noexcept
+	{ return ht_.cbegin(); }
+	const_iterator cend()   const noexcept
+	{ return ht_.cend(); }
+
+	// 容量相关
+
+	bool      empty()    const noexcept { return ht_.empty(); }
+	size_type size()     const noexcept { return ht_.size(); }
+	size_type max_size() const noexcept { return ht_.max_size(); }
+
+	// 修改容器操作
+
+	// emplace / emplace_hint
+
+	template <class ...Args>
+	mystl::pair<iterator, bool> emplace(Args&& ...args)
+	{
+		auto result = ht_.emplace(mystl::forward<Args>(args)...);
+		return mystl::pair<iterator, bool>(result.first, result.second);
+	}
+
+	// 开放寻址的表中 hint 没有意义, 忽略
+	template <class ...Args>
+	iterator emplace_hint(const_iterator, Args&& ...args)
+	{ return ht_.emplace(mystl::forward<Args>(args)...).first; }
+
+	// insert
+
+	mystl::pair<iterator, bool> insert(const value_type& value)
+	{
+		auto result = ht_.insert(value);
+		return mystl::pair<iterator, bool>(result.first, result.second);
+	}
+	mystl::pair<iterator, bool> insert(value_type&& value)
+	{
+		auto result = ht_.insert(mystl::move(value));
+		return mystl::pair<iterator, bool>(result.first, result.second);
+	}
+
+	iterator insert(const_iterator, const value_type& value)
+	{ return ht_.insert(value).first; }
+	iterator insert(const_iterator, value_type&& value)
+	{ return ht_.insert(mystl::move(value)).first; }
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{ ht_.insert(first, last); }
+
+	void insert(std::initializer_list<value_type> ilist)
+	{ ht_.insert(ilist.begin(), ilist.end()); }
+
+	// erase / clear
+
+	iterator  erase(const_iterator it)
+	{ return ht_.erase(it); }
+	iterator  erase(const_iterator first, const_iterator last)
+	{ return ht_.erase(first, last); }
+
+	template <class K = key_type>
+	size_type erase(const key_arg<K>& key)
+	{ return ht_.template erase<K>(key); }
+
+	void      clear()
+	{ ht_.clear(); }
+
+	void      swap(unordered_set& other) noexcept
+	{ ht_.swap(other.ht_); }
+
+	// 查找相关
+
+	template <class K = key_type>
+	size_type      count(const key_arg<K>& key) const
+	{ return ht_.template count<K>(key); }
+
+	template <class K = key_type>
+	bool           contains(const key_arg<K>& key) const
+	{ return ht_.template contains<K>(key); }
+
+	template <class K = key_type>
+	const_iterator find(const key_arg<K>& key) const
+	{ return ht_.template find<K>(key); }
+
+	template <class K = key_type>
+	mystl::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const
+	{ return ht_.template equal_range<K>(key); }
+
+	// bucket interface
+
+	size_type bucket_count()     const noexcept
+	{ return ht_.bucket_count(); }
+	size_type max_bucket_count() const noexcept
+	{ return ht_.max_bucket_count(); }
+
+	// hash policy
+
+	float     load_factor()            const noexcept { return ht_.load_factor(); }
+
+	float     max_load_factor()        const noexcept { return ht_.max_load_factor(); }
+	void      max_load_factor(float ml)                 { ht_.max_load_factor(ml); }
+
+	void      rehash(size_type count)                   { ht_.rehash(count); }
+	void      reserve(size_type count)                  { ht_.reserve(count); }
+
+	hasher    hash_function()          const            { return ht_.hash_function(); }
+	key_equal key_eq()                 const            { return ht_.key_eq(); }
+
+public:
+	friend bool operator==(const unordered_set& lhs, const unordered_set& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return false;
+		for (auto it = lhs.begin(); it != lhs.end(); ++it)
+		{
+			if (!rhs.contains(*it))
+				return false;
+		}
+		return true;
+	}
+	friend bool operator!=(const unordered_set& lhs, const unordered_set& rhs)
+	{
+		return !(lhs == rhs);
+	}
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class KeyEqual>
+void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
+          unordered_set<Key, Hash, KeyEqual>& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_UNORDERED_SET_H_
@@ -13,7 +13,7 @@ namespace mystl
 //move
 
 template <class T>
-typename std::remove_reference<T>::type&& move(T&& arg) noexcept
+constexpr typename std::remove_reference<T>::type&& move(T&& arg) noexcept
 {
 	// static_cast 将arg万能引用强转为右值引用
 	return static_cast<typename std::remove_reference<T>::type&&>(arg);
@@ -24,14 +24,14 @@ typename std::remove_reference<T>::type&& move(T&& arg) noexcept
 // 左值引用版本
 // std::remove_reference<T>::type 会去掉 T 的引用特性（如果有的话），返回去掉引用后的类型。
 template <class T>
-T&& forward(typename std::remove_reference<T>::type& arg) noexcept
+constexpr T&& forward(typename std::remove_reference<T>::type& arg) noexcept
 {
 	return static_cast<T&&>(arg);
 }
 
 // 右值引用版本
 template <class T>
-T&& forward(typename std::remove_reference<T>::type&& arg) noexcept
+constexpr T&& forward(typename std::remove_reference<T>::type&& arg) noexcept
 {
 	// 静态断言,如果参数arg为左值引用就断言失败
 	static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
@@ -43,7 +43,7 @@ T&& forward(typename std::remove_reference<T>::type&& arg) noexcept
 // Tp 一般是 template parameter的缩写
 // lhs, rhs 分别是left hand side和right hand side的缩写
 template <class Tp>
-void swap(Tp& lhs, Tp& rhs)
+MYSTL_CONSTEXPR20 void swap(Tp& lhs, Tp& rhs)
 {
 	auto tmp(mystl::move(lhs));
 	lhs = mystl::move(rhs);
@@ -53,11 +53,11 @@ void swap(Tp& lhs, Tp& rhs)
 // 用于一段范围的 swap
 // first1, last1 表示第一个范围的开始和结束迭代器. first2 表示第二个范围开始的迭代器
 template <class ForwardIter1, class ForwardIter2>
-ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
+MYSTL_CONSTEXPR20 ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
 {
 	// 直到 first1 达到 last 之前,做遍历
 	// (void) ++first2,将 ++first2 的结果强制转换为 void,主要目的在于确保 ++first2 的表达式不会产生未使用的结果的警告。
-	for (; first1 != last1; ++first, (void)++first2)
+	for (; first1 != last1; ++first1, (void)++first2)
 	{
 		mystl::swap(*first1, *first2);
 	}
@@ -67,7 +67,7 @@ ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 fi
 // 专门用于数组类型的 swap
 // Tp(&a)[N] 和 Tp(&b)[N] 表示两个同类型、同大小的数组,(注意加小括号,否则代表一个长度为N的数组a,内部为Tp类型的引用)
 template <class Tp, size_t N>
-void swap(Tp (&a)[N], Tp (&b)[N])
+MYSTL_CONSTEXPR20 void swap(Tp (&a)[N], Tp (&b)[N])
 {
 	mystl::swap_range(a, a + N, b);
 }
@@ -107,7 +107,7 @@ struct pair
 		          std::is_copy_constructible<U2>::value &&
 		          std::is_convertible<const U1&, Ty1>::value &&
 		          std::is_convertible<const U2&, Ty2>::value, int>::type = 0>
-	constexpr pair(const Ty1& a, const Ty2& b) : first(a), second(2)
+	constexpr pair(const Ty1& a, const Ty2& b) : first(a), second(b)
 	{
 	}
 
@@ -211,7 +211,7 @@ struct pair
 
 	// copy assign for this pair
 	// 要求两个pair中的元素类型相同
-	pair& operator=(const pair& rhs)
+	MYSTL_CONSTEXPR20 pair& operator=(const pair& rhs)
 	{
 		if (this != &rhs)
 		{
@@ -223,9 +223,9 @@ struct pair
 
 	// move assign for this pair
 	// 要求两个pair中的元素类型相同
-	pair& operator=(pair&& rhs)
+	MYSTL_CONSTEXPR20 pair& operator=(pair&& rhs)
 	{
-		if (this != rhs)
+		if (this != &rhs)
 		{
 			first = mystl::move(rhs.first);
 			second = mystl::move(rhs.second);
@@ -236,7 +236,7 @@ struct pair
 	// copy assign for other pair
 	// 不要求两个pair中的元素类型相同
 	template <class Other1, class Other2>
-	pair& operator=(const pair<Other1, Other2>& other)
+	MYSTL_CONSTEXPR20 pair& operator=(const pair<Other1, Other2>& other)
 	{
 		first = other.first;
 		second = other.second;
@@ -247,7 +247,7 @@ struct pair
 	// 不要求两个pair中的元素类型相同
 	// 由于forward,当other.first或者other.second为左值时,调用拷贝而不是移动,为右值时才调用移动
 	template <class Other1, class Other2>
-	pair& operator=(pair<Other1, Other2>&& other)
+	MYSTL_CONSTEXPR20 pair& operator=(pair<Other1, Other2>&& other)
 	{
 		first = mystl::forward<Other1>(other.first);
 		second = mystl::forward<Other2>(other.second);
@@ -257,7 +257,7 @@ struct pair
 	// 默认析构
 	~pair() = default;
 
-	void swap(pair& other)
+	MYSTL_CONSTEXPR20 void swap(pair& other)
 	{
 		if (this != &other)
 		{
@@ -269,55 +269,69 @@ struct pair
 
 // 重载比较运算符
 template <class Ty1, class Ty2>
-bool operator==(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 bool operator==(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
 {
 	return lhs.first == rhs.first && lhs.second == rhs.second;
 }
 
 template <class Ty1, class Ty2>
-bool operator<(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 bool operator<(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
 {
 	return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
 }
 
 template <class Ty1, class Ty2>
-bool operator!=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 bool operator!=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
 {
 	return !(lhs == rhs);
 }
 
 template <class Ty1, class Ty2>
-bool operator>(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 bool operator>(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
 {
-	return lhs > rhs;
+	return rhs < lhs;
 }
 
 template <class Ty1, class Ty2>
-bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
 {
 	return !(lhs > rhs);
 }
 
 template <class Ty1, class Ty2>
-bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs)
 {
 	return !(lhs < rhs);
 }
 
 // 重载 mystl 的 swap ,使其专门适用于两个pair
 template <class Ty1, class Ty2>
-void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs)
+MYSTL_CONSTEXPR20 void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs)
 {
 	lhs.swap(rhs);
 }
 
 // 全局函数，让两个数据成为一个 pair
 template <class Ty1, class Ty2>
-pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second)
+constexpr pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second)
 {
 	return pair<Ty1, Ty2>(mystl::forward<Ty1>(first), mystl::forward<Ty2>(second));
 }
 
+// 标签类型 sorted_unique_t / sorted_equivalent_t
+// 告知有序容器的构造函数或 insert 输入区间已经有序(并且无重复), 从而跳过排序与去重
+struct sorted_unique_t
+{
+	explicit sorted_unique_t() = default;
+};
+constexpr sorted_unique_t sorted_unique{};
+
+struct sorted_equivalent_t
+{
+	explicit sorted_equivalent_t() = default;
+};
+constexpr sorted_equivalent_t sorted_equivalent{};
+
 } // namespace mystl
 
 #endif // !MYTINYSTL_UTIL_H_
@@ -15,6 +15,10 @@
 //   * reserve
 //   * resize
 //   * insert
+// try_reserve / try_emplace_back / try_push_back 在分配失败时返回 errc 而不抛出异常
+// 重新分配空间时, 可平凡重定位(is_trivially_relocatable)的元素直接复制字节, 其余元素用
+// uninitialized_move_if_noexcept 转移: 移动构造可能抛出异常而元素又能复制时复制, 所以重新分配本身不破坏强异常保证
+// 定义 MYSTL_TELEMETRY 时记录重新分配与最终大小, 见 telemetry.h; 此时重新分配的函数不内联, 以便按调用点统计
 
 #include <initializer_list>
 
@@ -23,6 +27,7 @@
 #include "util.h"
 #include "exceptdef.h"
 #include "algo.h"
+#include "telemetry.h"
 
 namespace mystl
 {
@@ -76,10 +81,206 @@ private:
 
 public:
 	// 构造,拷贝,移动,析构
+	vector() noexcept
+	{ try_init(); }
 
+	explicit vector(size_type n)
+	{ fill_init(n, value_type()); }
 
+	vector(size_type n, const value_type& value)
+	{ fill_init(n, value); }
 
+	// 只有 Iter 为迭代器时才启用, 避免与 vector(size_type, const value_type&) 产生歧义
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	vector(Iter first, Iter last)
+	{
+		MYSTL_DEBUG(!(last < first));
+		range_init(first, last);
+	}
+
+	vector(const vector& rhs)
+	{ range_init(rhs.begin_, rhs.end_); }
+
+	vector(vector&& rhs) noexcept
+		:begin_(rhs.begin_),
+		end_(rhs.end_),
+		cap_(rhs.cap_)
+	{
+		rhs.begin_ = nullptr;
+		rhs.end_ = nullptr;
+		rhs.cap_ = nullptr;
+	}
+
+	vector(std::initializer_list<value_type> ilist)
+	{ range_init(ilist.begin(), ilist.end()); }
+
+	vector& operator=(const vector& rhs);
+	vector& operator=(vector&& rhs) noexcept;
+
+	vector& operator=(std::initializer_list<value_type> ilist)
+	{
+		vector tmp(ilist.begin(), ilist.end());
+		swap(tmp);
+		return *this;
+	}
+
+	~vector()
+	{
+		destroy_and_recover(begin_, end_, cap_ - begin_);
+		begin_ = end_ = cap_ = nullptr;
+	}
+
+public:
+	// 迭代器相关操作
+	iterator               begin()         noexcept { return begin_; }
+	const_iterator         begin()   const noexcept { return begin_; }
+	iterator               end()           noexcept { return end_; }
+	const_iterator         end()     const noexcept { return end_; }
+
+	reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+	reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+	const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+	const_iterator         cbegin()  const noexcept { return begin(); }
+	const_iterator         cend()    const noexcept { return end(); }
+	const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+	const_reverse_iterator crend()   const noexcept { return rend(); }
+
+	// 容量相关操作
+	bool      empty()    const noexcept { return begin_ == end_; }
+	size_type size()     const noexcept { return static_cast<size_type>(end_ - begin_); }
+	size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+	size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+
+	// 预留至少 n 个元素的空间, n 不大于当前容量时什么也不做
+	MYSTL_TELEMETRY_NOINLINE void reserve(size_type n);
+	// 释放多余的容量, 使 capacity() == size()
+	void      shrink_to_fit();
+
+	// 分配失败时不抛出异常的版本, 返回 errc::ok, errc::length_error(超过 max_size) 或 errc::bad_alloc,
+	// 失败时 vector 保持不变; 元素的构造函数抛出的异常照常传播
+	MYSTL_TELEMETRY_NOINLINE errc try_reserve(size_type n);
+
+	// 访问元素相关操作
+	reference operator[](size_type n)
+	{
+		MYSTL_DEBUG(n < size());
+		return *(begin_ + n);
+	}
+	const_reference operator[](size_type n) const
+	{
+		MYSTL_DEBUG(n < size());
+		return *(begin_ + n);
+	}
+	reference at(size_type n)
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
+		return (*this)[n];
+	}
+	const_reference at(size_type n) const
+	{
+		THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
+		return (*this)[n];
+	}
+
+	reference front()
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin_;
+	}
+	const_reference front() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *begin_;
+	}
+	reference back()
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end_ - 1);
+	}
+	const_reference back() const
+	{
+		MYSTL_DEBUG(!empty());
+		return *(end_ - 1);
+	}
+
+	pointer       data()       noexcept { return begin_; }
+	const_pointer data() const noexcept { return begin_; }
+
+	// 修改容器相关操作
+
+	// assign
+	void assign(size_type n, const value_type& value)
+	{ fill_assign(n, value); }
+
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	void assign(Iter first, Iter last)
+	{
+		MYSTL_DEBUG(!(last < first));
+		copy_assign(first, last, iterator_category(first));
+	}
+
+	void assign(std::initializer_list<value_type> il)
+	{ copy_assign(il.begin(), il.end(), mystl::forward_iterator_tag{}); }
+
+	// emplace / emplace_back
+	template <class... Args>
+	iterator emplace(const_iterator pos, Args&& ...args);
+
+	template <class... Args>
+	void emplace_back(Args&& ...args);
+
+	// push_back / pop_back
+	void push_back(const value_type& value);
+	void push_back(value_type&& value)
+	{ emplace_back(mystl::move(value)); }
+
+	// try_emplace_back / try_push_back, 需要重新分配而分配失败时返回错误, 同 try_reserve
+	template <class... Args>
+	errc try_emplace_back(Args&& ...args);
 
+	errc try_push_back(const value_type& value)
+	{ return try_emplace_back(value); }
+	errc try_push_back(value_type&& value)
+	{ return try_emplace_back(mystl::move(value)); }
+
+	void pop_back();
+
+	// insert
+	iterator insert(const_iterator pos, const value_type& value);
+	iterator insert(const_iterator pos, value_type&& value)
+	{ return emplace(pos, mystl::move(value)); }
+
+	iterator insert(const_iterator pos, size_type n, const value_type& value)
+	{
+		MYSTL_DEBUG(pos >= begin() && pos <= end());
+		return fill_insert(const_cast<iterator>(pos), n, value);
+	}
+
+	template <class Iter, typename std::enable_if<
+		mystl::is_input_iterator<Iter>::value, int>::type = 0>
+	void insert(const_iterator pos, Iter first, Iter last)
+	{
+		MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
+		copy_insert(const_cast<iterator>(pos), first, last);
+	}
+
+	// erase / clear
+	iterator erase(const_iterator pos);
+	iterator erase(const_iterator first, const_iterator last);
+	void     clear() { erase(begin(), end()); }
+
+	// resize / reverse
+	void resize(size_type new_size) { return resize(new_size, value_type()); }
+	void resize(size_type new_size, const value_type& value);
+
+	void reverse() { mystl::reverse(begin(), end()); }
+
+	// swap
+	void swap(vector& rhs) noexcept;
 
 private:
 	//*****************************辅助函数们***********************************
@@ -134,42 +335,326 @@ private:
 	// 在pos指定的位置构造(emplace原地构造),变长参数模板为所要提供的参数
 	// 需要插入新元素而当前存储空间不足时，函数将负责重新分配内存，确保足够的空间来容纳新元素，并将其他元素移动到合适的位置
 	template <class... Args>
-	void       reallocate_emplace(iterator pos, Args&& ...args);
+	MYSTL_TELEMETRY_NOINLINE void reallocate_emplace(iterator pos, Args&& ...args);
 
 	// 指定位置 pos 插入一个元素 value，如果当前的容量不足以容纳新增的元素，则会进行内存的重新分配
-	void       reallocate_insert(iterator pos, const value_type& value);
+	MYSTL_TELEMETRY_NOINLINE void reallocate_insert(iterator pos, const value_type& value);
+
+	// 把旧空间的元素转移到新空间 new_begin(容量为 new_cap), 在 pos 对应的位置留出 n 个元素(已由调用者构造), 再释放旧空间
+	// 可平凡重定位的类型直接 memmove, 旧元素不再析构; 其余类型用 uninitialized_move_if_noexcept 转移后析构旧元素
+	// 转移失败时析构新空间中已构造的元素(包括调用者构造的 n 个)并释放新空间, 旧空间保持不变
+	void       transfer_to(iterator pos, iterator new_begin, size_type new_cap, size_type n);
+	void       transfer_range(iterator pos, iterator new_begin, size_type new_cap, size_type n,
+	                          m_true_type) noexcept;
+	void       transfer_range(iterator pos, iterator new_begin, size_type new_cap, size_type n,
+	                          m_false_type);
 
 	//******************************用于插入值的函数*********************************
 
 	// 在向量中的指定位置 pos 插入 n 个值为 value 的元素
 	// 返回插入后新位置的迭代器
-	iterator  fill_insert(iterator pos, size_type n, const value_type& value);
+	MYSTL_TELEMETRY_NOINLINE iterator fill_insert(iterator pos, size_type n, const value_type& value);
 
 	// 在向量的指定位置 pos 插入范围 [first, last) 的元素
 	// first 和 last 是输入迭代器，表示要插入元素的范围
 	template <class IIter>
-	void      copy_insert(iterator pos, IIter first, IIter last);
+	MYSTL_TELEMETRY_NOINLINE void copy_insert(iterator pos, IIter first, IIter last);
 
 	//******************************用于收缩到适合大小的函数*********************************
 
 	// 重新分配内存并调整现有元素的存放位置，以适应新的大小要求
-	void      reinsert(size_type size);
+	MYSTL_TELEMETRY_NOINLINE void reinsert(size_type size);
 };
 
+
+// 复制赋值操作符
+template <class T>
+vector<T>& vector<T>::operator=(const vector& rhs)
+{
+	if (this != &rhs)
+	{
+		const auto len = rhs.size();
+		// 容量不够时先构造好副本再交换, 保证强异常安全
+		if (len > capacity())
+		{
+			vector tmp(rhs.begin(), rhs.end());
+			swap(tmp);
+		}
+		else if (size() >= len)
+		{
+			auto i = mystl::copy(rhs.begin(), rhs.end(), begin());
+			data_allocator::destroy(i, end_);
+			end_ = begin_ + len;
+		}
+		else
+		{
+			mystl::copy(rhs.begin(), rhs.begin() + size(), begin_);
+			mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
+			end_ = begin_ + len;
+		}
+	}
+	return *this;
+}
+
+// 移动赋值操作符
+template <class T>
+vector<T>& vector<T>::operator=(vector&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		destroy_and_recover(begin_, end_, cap_ - begin_);
+		begin_ = rhs.begin_;
+		end_ = rhs.end_;
+		cap_ = rhs.cap_;
+		rhs.begin_ = nullptr;
+		rhs.end_ = nullptr;
+		rhs.cap_ = nullptr;
+	}
+	return *this;
+}
+
+// 预留空间大小，当原容量小于要求大小时，才会重新分配
+template <class T>
+void vector<T>::reserve(size_type n)
+{
+	if (capacity() < n)
+	{
+		THROW_LENGTH_ERROR_IF(n > max_size(),
+		                      "n can not larger than max_size() in vector<T>::reserve(n)");
+		auto tmp = data_allocator::allocate(n);
+		MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, tmp, size());
+		transfer_to(end_, tmp, n, 0);
+	}
+}
+
+template <class T>
+errc vector<T>::try_reserve(size_type n)
+{
+	if (capacity() >= n)
+		return errc::ok;
+	if (n > max_size())
+		return errc::length_error;
+	auto tmp = data_allocator::try_allocate(n);
+	if (tmp == nullptr)
+		return errc::bad_alloc;
+	MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, tmp, size());
+	transfer_to(end_, tmp, n, 0);
+	return errc::ok;
+}
+
+// 放弃多余的容量
+template <class T>
+void vector<T>::shrink_to_fit()
+{
+	if (end_ < cap_)
+	{
+		reinsert(size());
+	}
+}
+
+// 在 pos 位置就地构造元素，避免额外的复制或移动开销
+template <class T>
+template <class ...Args>
+typename vector<T>::iterator
+vector<T>::emplace(const_iterator pos, Args&& ...args)
+{
+	MYSTL_DEBUG(pos >= begin() && pos <= end());
+	iterator xpos = const_cast<iterator>(pos);
+	const size_type n = xpos - begin_;
+	if (end_ != cap_ && xpos == end_)
+	{
+		data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+		++end_;
+	}
+	else if (end_ != cap_)
+	{
+		// 先构造出新元素, 防止 args 引用的正是容器内将被移动的元素
+		value_type value(mystl::forward<Args>(args)...);
+		auto new_end = end_;
+		data_allocator::construct(mystl::address_of(*end_), mystl::move(*(end_ - 1)));
+		++new_end;
+		mystl::move_backward(xpos, end_ - 1, end_);
+		*xpos = mystl::move(value);
+		end_ = new_end;
+	}
+	else
+	{
+		reallocate_emplace(xpos, mystl::forward<Args>(args)...);
+	}
+	return begin() + n;
+}
+
+// 在尾部就地构造元素，避免额外的复制或移动开销
+template <class T>
+template <class ...Args>
+void vector<T>::emplace_back(Args&& ...args)
+{
+	if (end_ < cap_)
+	{
+		data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+		++end_;
+	}
+	else
+	{
+		reallocate_emplace(end_, mystl::forward<Args>(args)...);
+	}
+}
+
+template <class T>
+template <class ...Args>
+errc vector<T>::try_emplace_back(Args&& ...args)
+{
+	if (end_ < cap_)
+	{
+		data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+		++end_;
+		return errc::ok;
+	}
+	if (capacity() == max_size())
+		return errc::length_error;
+	const auto new_size = get_new_cap(1);
+	auto new_begin = data_allocator::try_allocate(new_size);
+	if (new_begin == nullptr)
+		return errc::bad_alloc;
+	MYSTL_TRY
+	{
+		data_allocator::construct(mystl::address_of(*(new_begin + size())),
+		                          mystl::forward<Args>(args)...);
+	}
+	MYSTL_CATCH_ALL
+	{
+		data_allocator::deallocate(new_begin, new_size);
+		MYSTL_RETHROW;
+	}
+	MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, new_begin, size());
+	transfer_to(end_, new_begin, new_size, 1);
+	return errc::ok;
+}
+
+// 在尾部插入元素
+template <class T>
+void vector<T>::push_back(const value_type& value)
+{
+	if (end_ != cap_)
+	{
+		data_allocator::construct(mystl::address_of(*end_), value);
+		++end_;
+	}
+	else
+	{
+		reallocate_insert(end_, value);
+	}
+}
+
+// 弹出尾部元素
+template <class T>
+void vector<T>::pop_back()
+{
+	MYSTL_DEBUG(!empty());
+	data_allocator::destroy(end_ - 1);
+	--end_;
+}
+
+// 在 pos 处插入元素
+template <class T>
+typename vector<T>::iterator
+vector<T>::insert(const_iterator pos, const value_type& value)
+{
+	MYSTL_DEBUG(pos >= begin() && pos <= end());
+	iterator xpos = const_cast<iterator>(pos);
+	const size_type n = pos - begin_;
+	if (end_ != cap_ && xpos == end_)
+	{
+		data_allocator::construct(mystl::address_of(*end_), value);
+		++end_;
+	}
+	else if (end_ != cap_)
+	{
+		// 先复制一份, 防止 value 引用的正是容器内将被移动的元素
+		value_type value_copy = value;
+		auto new_end = end_;
+		data_allocator::construct(mystl::address_of(*end_), mystl::move(*(end_ - 1)));
+		++new_end;
+		mystl::move_backward(xpos, end_ - 1, end_);
+		*xpos = mystl::move(value_copy);
+		end_ = new_end;
+	}
+	else
+	{
+		reallocate_insert(xpos, value);
+	}
+	return begin_ + n;
+}
+
+// 删除 pos 位置上的元素
+template <class T>
+typename vector<T>::iterator
+vector<T>::erase(const_iterator pos)
+{
+	MYSTL_DEBUG(pos >= begin() && pos < end());
+	iterator xpos = begin_ + (pos - begin());
+	mystl::move(xpos + 1, end_, xpos);
+	data_allocator::destroy(end_ - 1);
+	--end_;
+	return xpos;
+}
+
+// 删除[first, last)上的元素
+template <class T>
+typename vector<T>::iterator
+vector<T>::erase(const_iterator first, const_iterator last)
+{
+	MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+	const auto n = first - begin();
+	iterator r = begin_ + (first - begin());
+	// 空区间什么也不做, 否则会把整个尾部自移动赋值, 清空 std::string 等元素
+	if (first == last)
+		return r;
+	data_allocator::destroy(mystl::move(r + (last - first), end_, r), end_);
+	end_ = end_ - (last - first);
+	return begin_ + n;
+}
+
+// 重置容器大小
+template <class T>
+void vector<T>::resize(size_type new_size, const value_type& value)
+{
+	if (new_size < size())
+	{
+		erase(begin() + new_size, end());
+	}
+	else
+	{
+		insert(end(), new_size - size(), value);
+	}
+}
+
+// 与另一个 vector 交换
+template <class T>
+void vector<T>::swap(vector<T>& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		mystl::swap(begin_, rhs.begin_);
+		mystl::swap(end_, rhs.end_);
+		mystl::swap(cap_, rhs.cap_);
+	}
+}
+
 //****************************辅助函数们***********************************
 
 // try_init 函数, 若分配失败则忽略, 不抛异常
 template <class T>
 void vector<T>::try_init() noexcept
 {
-	try
+	MYSTL_TRY
 	{
 		begin_ = data_allocator::allocate(16);
 		end_ = begin_;
 		// 选择16作为初始分配大小是一种在性能、效率和实现复杂度之间的折中方法
 		cap_ = begin_ + 16;
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
 		begin_ = nullptr;
 		end_ = nullptr;
@@ -180,18 +665,18 @@ void vector<T>::try_init() noexcept
 template <class T>
 void vector<T>::init_space(size_type size, size_type cap)
 {
-	try
+	MYSTL_TRY
 	{
 		begin_ = data_allocator::allocate(cap);
 		end_ = begin_ + size;
 		cap_ = begin_ + cap;
 	}
-	catch (...)
+	MYSTL_CATCH_ALL
 	{
 		begin_ = nullptr;
 		end_ = nullptr;
 		cap_ = nullptr;
-		throw;
+		MYSTL_RETHROW;
 	}
 }
 
@@ -209,13 +694,14 @@ void vector<T>::range_init(Iter first, Iter last)
 {
 	const size_type len =  mystl::distance(first, last);
 	const size_type init_size = mystl::max(len, static_cast<size_type>(16));
-	init_space(len, init_space);
+	init_space(len, init_size);
 	mystl::uninitialized_copy(first, last, begin_);
 }
 
 template <class T>
 void vector<T>::destroy_and_recover(iterator first, iterator last, size_type n)
 {
+	MYSTL_TELEMETRY_ON_RELEASE(T, first, static_cast<size_type>(last - first), n);
 	data_allocator::destroy(first, last);
 	data_allocator::deallocate(first, n);
 }
@@ -232,14 +718,17 @@ typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size)
 	{
 		// 如果 当前大小 + 要增加大小 超过 最大容量 - 16（留出一点余地），则总体只增加 add_size 长度。
 		// 否则，增加 add_size + 16（为了在未来的操作中留出额外的容量）
-		return old_size + add_size > max_size() - 16
+		const size_type new_size = old_size + add_size > max_size() - 16
 			? old_size + add_size : old_size + add_size + 16;
+		MYSTL_TELEMETRY_ON_GROW(T, new_size);
+		return new_size;
 	}
 	// 如果 当前大小 为零，那么新的容量将为 要增加大小 和 16 两者中的最大值（确保初始容量至少为16）
 	// 否则，新容量 将为 当前容量的1.5倍 以及 当前容量+要增加大小 两者中更大者，以确保容量足够且动态增长
 	const size_type new_size = old_size == 0
 		? mystl::max(add_size, static_cast<size_type>(16))
-		: mystl::max(old_size + old_size / 2, old_size + add_size);;
+		: mystl::max(old_size + old_size / 2, old_size + add_size);
+	MYSTL_TELEMETRY_ON_GROW(T, new_size);
 	return new_size;
 }
 
@@ -271,5 +760,292 @@ void vector<T>::fill_assign(size_type n, const value_type& value)
 }
 
 
+template <class T>
+template <class IIter>
+void vector<T>::copy_assign(IIter first, IIter last, input_iterator_tag)
+{
+	auto cur = begin_;
+	for (; first != last && cur != end_; ++first, ++cur)
+	{
+		*cur = *first;
+	}
+	if (first == last)
+	{
+		erase(cur, end_);
+	}
+	else
+	{
+		insert(end_, first, last);
+	}
+}
+
+template <class T>
+template <class FIter>
+void vector<T>::copy_assign(FIter first, FIter last, forward_iterator_tag)
+{
+	const size_type len = mystl::distance(first, last);
+	if (len > capacity())
+	{
+		vector tmp(first, last);
+		swap(tmp);
+	}
+	else if (size() >= len)
+	{
+		auto new_end = mystl::copy(first, last, begin_);
+		data_allocator::destroy(new_end, end_);
+		end_ = new_end;
+	}
+	else
+	{
+		auto mid = first;
+		mystl::advance(mid, size());
+		mystl::copy(first, mid, begin_);
+		auto new_end = mystl::uninitialized_copy(mid, last, end_);
+		end_ = new_end;
+	}
+}
+
+//***************************用于重新分配内存的函数*******************************
+
+template <class T>
+template <class ...Args>
+void vector<T>::reallocate_emplace(iterator pos, Args&& ...args)
+{
+	const auto new_size = get_new_cap(1);
+	auto new_begin = data_allocator::allocate(new_size);
+	MYSTL_TRY
+	{
+		// 先在新空间中构造新元素, 因为 args 可能引用旧空间中的元素
+		data_allocator::construct(mystl::address_of(*(new_begin + (pos - begin_))),
+		                          mystl::forward<Args>(args)...);
+	}
+	MYSTL_CATCH_ALL
+	{
+		data_allocator::deallocate(new_begin, new_size);
+		MYSTL_RETHROW;
+	}
+	MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, new_begin, size());
+	transfer_to(pos, new_begin, new_size, 1);
+}
+
+template <class T>
+void vector<T>::reallocate_insert(iterator pos, const value_type& value)
+{
+	const auto new_size = get_new_cap(1);
+	auto new_begin = data_allocator::allocate(new_size);
+	MYSTL_TRY
+	{
+		data_allocator::construct(mystl::address_of(*(new_begin + (pos - begin_))), value);
+	}
+	MYSTL_CATCH_ALL
+	{
+		data_allocator::deallocate(new_begin, new_size);
+		MYSTL_RETHROW;
+	}
+	MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, new_begin, size());
+	transfer_to(pos, new_begin, new_size, 1);
+}
+
+template <class T>
+void vector<T>::transfer_to(iterator pos, iterator new_begin, size_type new_cap, size_type n)
+{
+	const size_type new_size = size() + n;
+	transfer_range(pos, new_begin, new_cap, n, m_bool_constant<is_trivially_relocatable<T>::value>());
+	data_allocator::deallocate(begin_, cap_ - begin_);
+	begin_ = new_begin;
+	end_ = new_begin + new_size;
+	cap_ = new_begin + new_cap;
+}
+
+// 可平凡重定位: 直接复制字节, 旧元素视为已经转移, 不再析构
+template <class T>
+void vector<T>::transfer_range(iterator pos, iterator new_begin, size_type, size_type n,
+                               m_true_type) noexcept
+{
+	auto new_pos = mystl::uninitialized_relocate(begin_, pos, new_begin);
+	mystl::uninitialized_relocate(pos, end_, new_pos + n);
+}
+
+template <class T>
+void vector<T>::transfer_range(iterator pos, iterator new_begin, size_type new_cap, size_type n,
+                               m_false_type)
+{
+	const auto new_pos = new_begin + (pos - begin_);
+	auto new_end = new_begin;
+	MYSTL_TRY
+	{
+		new_end = mystl::uninitialized_move_if_noexcept(begin_, pos, new_begin);
+		mystl::uninitialized_move_if_noexcept(pos, end_, new_pos + n);
+	}
+	MYSTL_CATCH_ALL
+	{
+		data_allocator::destroy(new_begin, new_end);
+		data_allocator::destroy(new_pos, new_pos + n);
+		data_allocator::deallocate(new_begin, new_cap);
+		MYSTL_RETHROW;
+	}
+	data_allocator::destroy(begin_, end_);
+}
+
+//******************************用于插入值的函数*********************************
+
+template <class T>
+typename vector<T>::iterator
+vector<T>::fill_insert(iterator pos, size_type n, const value_type& value)
+{
+	if (n == 0)
+		return pos;
+	const size_type xpos = pos - begin_;
+	const value_type value_copy = value;  // 避免被覆盖
+	if (static_cast<size_type>(cap_ - end_) >= n)
+	{
+		// 如果备用空间大于等于增加的空间
+		const size_type after_elems = end_ - pos;
+		auto old_end = end_;
+		if (after_elems > n)
+		{
+			mystl::uninitialized_move(end_ - n, end_, end_);
+			end_ += n;
+			mystl::move_backward(pos, old_end - n, old_end);
+			mystl::fill_n(pos, n, value_copy);
+		}
+		else
+		{
+			end_ = mystl::uninitialized_fill_n(end_, n - after_elems, value_copy);
+			end_ = mystl::uninitialized_move(pos, old_end, end_);
+			mystl::fill_n(pos, after_elems, value_copy);
+		}
+	}
+	else
+	{
+		// 如果备用空间不足
+		const auto new_size = get_new_cap(n);
+		auto new_begin = data_allocator::allocate(new_size);
+		MYSTL_TRY
+		{
+			mystl::uninitialized_fill_n(new_begin + xpos, n, value_copy);
+		}
+		MYSTL_CATCH_ALL
+		{
+			data_allocator::deallocate(new_begin, new_size);
+			MYSTL_RETHROW;
+		}
+		MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, new_begin, size());
+		transfer_to(pos, new_begin, new_size, n);
+	}
+	return begin_ + xpos;
+}
+
+template <class T>
+template <class IIter>
+void vector<T>::copy_insert(iterator pos, IIter first, IIter last)
+{
+	if (first == last)
+		return;
+	const auto n = mystl::distance(first, last);
+	if ((cap_ - end_) >= n)
+	{
+		// 如果备用空间大小足够
+		const auto after_elems = end_ - pos;
+		auto old_end = end_;
+		// [pos, old_end) 上仍有对象(移动后的), 只能赋值; 只有 old_end 之后的位置才在未初始化空间上构造
+		if (after_elems > n)
+		{
+			end_ = mystl::uninitialized_move(end_ - n, end_, end_);
+			mystl::move_backward(pos, old_end - n, old_end);
+			mystl::copy(first, last, pos);
+		}
+		else
+		{
+			auto mid = first;
+			mystl::advance(mid, after_elems);
+			end_ = mystl::uninitialized_copy(mid, last, end_);
+			end_ = mystl::uninitialized_move(pos, old_end, end_);
+			mystl::copy(first, mid, pos);
+		}
+	}
+	else
+	{
+		// 备用空间不足
+		// 先在新空间中构造插入的元素, 因为 [first, last) 可能位于旧空间中
+		const auto new_size = get_new_cap(n);
+		auto new_begin = data_allocator::allocate(new_size);
+		MYSTL_TRY
+		{
+			mystl::uninitialized_copy(first, last, new_begin + (pos - begin_));
+		}
+		MYSTL_CATCH_ALL
+		{
+			data_allocator::deallocate(new_begin, new_size);
+			MYSTL_RETHROW;
+		}
+		MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, new_begin, size());
+		transfer_to(pos, new_begin, new_size, static_cast<size_type>(n));
+	}
+}
+
+//******************************用于收缩到适合大小的函数*********************************
+
+template <class T>
+void vector<T>::reinsert(size_type size)
+{
+	auto new_begin = data_allocator::allocate(size);
+	MYSTL_TELEMETRY_ON_REALLOCATE(T, begin_, new_begin, this->size());
+	transfer_to(end_, new_begin, size, 0);
+}
+
+//******************************重载比较操作符*********************************
+
+template <class T>
+bool operator==(const vector<T>& lhs, const vector<T>& rhs)
+{
+	return lhs.size() == rhs.size() &&
+		mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T>
+bool operator<(const vector<T>& lhs, const vector<T>& rhs)
+{
+	return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T>
+bool operator!=(const vector<T>& lhs, const vector<T>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const vector<T>& lhs, const vector<T>& rhs)
+{
+	return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const vector<T>& lhs, const vector<T>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const vector<T>& lhs, const vector<T>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(vector<T>& lhs, vector<T>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+// vector 只持有指向堆上空间的指针, 可以按字节转移
+template <class T>
+struct is_trivially_relocatable<vector<T>> : m_true_type {};
+
+// 分配器是无状态的, 不占空间, vector 只有三个指针
+static_assert(sizeof(vector<int>) == 3 * sizeof(void*), "vector should be exactly three pointers");
+
 } // namespace mystl
 #endif // !MYTINYSTL_VECTOR_H_
@@ -0,0 +1,209 @@
+#ifndef MYTINYSTL_BITSET_TEST_H_
+#define MYTINYSTL_BITSET_TEST_H_
+
+// bitset / dynamic_bitset 的测试, 以 std::vector<bool> 与 std::bitset 作为参照
+
+#include <bitset>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/bitset.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace bitset_test
+{
+
+// 逐位比较, 并检查 count、find_first / find_next、any / all
+template <class Bits>
+bool same_bits(const Bits& d, const std::vector<bool>& v)
+{
+	if (d.size() != v.size())
+		return false;
+	size_t c = 0;
+	for (size_t i = 0; i < v.size(); ++i)
+	{
+		if (d[i] != v[i])
+			return false;
+		c += v[i] ? 1 : 0;
+	}
+	if (d.count() != c || d.any() != (c > 0) || d.all() != (c == v.size()))
+		return false;
+	size_t k = d.find_first();
+	for (size_t i = 0; i < v.size(); ++i)
+	{
+		if (!v[i])
+			continue;
+		if (k != i)
+			return false;
+		k = d.find_next(k);
+	}
+	return k == Bits::npos;
+}
+
+// 块类型不同时走不同的 popcount / tzcnt 与 AVX2 的分支
+template <class Block>
+bool dynamic_bitset_ok(test_rng& rng)
+{
+	typedef mystl::dynamic_bitset<Block> bits;
+	for (int it = 0; it < 100; ++it)
+	{
+		const size_t n = rng.below(5000);
+		bits a(n), b(n, true);
+		std::vector<bool> va(n, false), vb(n, true);
+		for (size_t i = 0; i < n / 3; ++i)
+		{
+			size_t p = rng.below(n);
+			a.set(p);
+			va[p] = true;
+			p = rng.below(n);
+			b.reset(p);
+			vb[p] = false;
+		}
+		if (!same_bits(a, va) || !same_bits(b, vb))
+			return false;
+
+		std::vector<bool> vc(n);
+		bits c = a & b;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = va[i] && vb[i];
+		if (!same_bits(c, vc))
+			return false;
+		c = a | b;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = va[i] || vb[i];
+		if (!same_bits(c, vc))
+			return false;
+		c = a ^ b;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = va[i] != vb[i];
+		if (!same_bits(c, vc))
+			return false;
+		c = a - b;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = va[i] && !vb[i];
+		if (!same_bits(c, vc))
+			return false;
+		c = ~a;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = !va[i];
+		if (!same_bits(c, vc))
+			return false;
+
+		// 移位量可能超过长度
+		const size_t s = rng.below(n + 70);
+		c = a << s;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = i >= s && va[i - s];
+		if (!same_bits(c, vc))
+			return false;
+		c = a >> s;
+		for (size_t i = 0; i < n; ++i)
+			vc[i] = i + s < n && va[i + s];
+		if (!same_bits(c, vc))
+			return false;
+
+		if (n != 0)
+		{
+			const size_t p = rng.below(n);
+			const size_t len = rng.below(n - p + 1);
+			const bool v = rng.below(2) == 0;
+			c = a;
+			c.set(p, len, v);
+			vc = va;
+			for (size_t i = p; i < p + len; ++i)
+				vc[i] = v;
+			if (!same_bits(c, vc))
+				return false;
+		}
+
+		const size_t m = rng.below(5000);
+		const bool v = rng.below(2) == 0;
+		c = a;
+		c.resize(m, v);
+		vc = va;
+		vc.resize(m, v);
+		if (!same_bits(c, vc))
+			return false;
+		c.push_back(true);
+		vc.push_back(true);
+		if (!same_bits(c, vc))
+			return false;
+		c.pop_back();
+		vc.pop_back();
+		if (!same_bits(c, vc))
+			return false;
+
+		if (!(a - b).is_subset_of(a) || (n != 0 && (a - b).intersects(b)))
+			return false;
+	}
+	return true;
+}
+
+TEST(dynamic_bitset_test)
+{
+	test_rng rng(16);
+	EXPECT_TRUE(dynamic_bitset_ok<uint64_t>(rng));
+	EXPECT_TRUE(dynamic_bitset_ok<uint32_t>(rng));
+	EXPECT_TRUE(dynamic_bitset_ok<uint16_t>(rng));
+	EXPECT_TRUE(dynamic_bitset_ok<uint8_t>(rng));
+
+	mystl::dynamic_bitset<> d(10, true);
+	EXPECT_THROW(d.test(10), std::out_of_range);
+	d.clear();
+	EXPECT_TRUE(d.empty());
+}
+
+TEST(bitset_test)
+{
+	test_rng rng(17);
+	bool ok = true;
+	for (int it = 0; it < 200 && ok; ++it)
+	{
+		mystl::bitset<3000> a, b;
+		std::bitset<3000> sa, sb;
+		for (int i = 0; i < 800; ++i)
+		{
+			size_t p = rng.below(3000);
+			a.set(p);
+			sa.set(p);
+			p = rng.below(3000);
+			b.flip(p);
+			sb.flip(p);
+		}
+		const size_t s = rng.below(3100);
+		ok = (a << s).to_string() == (sa << s).to_string().c_str() &&
+			(a >> s).to_string() == (sa >> s).to_string().c_str() &&
+			(a & b).count() == (sa & sb).count() && (a | b).count() == (sa | sb).count() &&
+			(a ^ b).count() == (sa ^ sb).count() && (~a).count() == (~sa).count() &&
+			(a & ~b) == (a - b);
+	}
+	EXPECT_TRUE(ok);
+
+	mystl::bitset<70> x(0xF0F0ULL);
+	EXPECT_EQ(x.to_ullong(), 0xF0F0ULL);
+	EXPECT_EQ(x.find_first(), 4u);
+	EXPECT_EQ(x.find_next(7), 12u);
+	// 超出长度的高位被截掉
+	mystl::bitset<5> y(0xFFULL);
+	EXPECT_EQ(y.count(), 5u);
+	EXPECT_TRUE(y.all());
+	EXPECT_THROW(y.test(5), std::out_of_range);
+	mystl::bitset<0> z;
+	EXPECT_TRUE(z.none());
+	EXPECT_EQ(z.find_first(), z.npos);
+
+	mystl::bitset<70> x2 = x;
+	EXPECT_EQ(mystl::hash<mystl::bitset<70>>()(x), mystl::hash<mystl::bitset<70>>()(x2));
+	EXPECT_EQ(mystl::hash<mystl::dynamic_bitset<>>()(mystl::dynamic_bitset<>(10, true)),
+	          mystl::hash<mystl::dynamic_bitset<>>()(mystl::dynamic_bitset<>(10, true)));
+}
+
+} // namespace bitset_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_BITSET_TEST_H_
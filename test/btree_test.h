@@ -0,0 +1,236 @@
+#ifndef MYTINYSTL_BTREE_TEST_H_
+#define MYTINYSTL_BTREE_TEST_H_
+
+// btree_map / btree_multimap / btree_set / btree_multiset 的测试, 以 std::map 等作为参照
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/btree_map.h"
+#include "../src/btree_set.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace btree_test
+{
+
+template <class Tree, class Std>
+bool same_entries(const Tree& t, const Std& s)
+{
+	if (t.size() != s.size())
+		return false;
+	auto a = t.begin();
+	for (auto& p : s)
+	{
+		if (a == t.end() || a->first != p.first || a->second != p.second)
+			return false;
+		++a;
+	}
+	return a == t.end();
+}
+
+TEST(btree_map_random_ops_test)
+{
+	test_rng rng(3);
+	mystl::btree_map<int, std::string> m;
+	std::map<int, std::string> s;
+	mystl::btree_multimap<int, int> mm;
+	std::multimap<int, int> smm;
+	bool ok = true;
+	for (int it = 0; it < 100000 && ok; ++it)
+	{
+		const int k = static_cast<int>(rng.below(4000));
+		switch (rng.below(6))
+		{
+		case 0:
+		case 1:
+		{
+			auto a = m.insert(mystl::make_pair(k, std::to_string(it)));
+			auto b = s.insert(std::make_pair(k, std::to_string(it)));
+			ok = a.second == b.second && a.first->second == b.first->second;
+			mm.insert(mystl::make_pair(k, it));
+			smm.insert(std::make_pair(k, it));
+			break;
+		}
+		case 2:
+			ok = m.erase(k) == s.erase(k);
+			if (rng.below(4) == 0)
+				ok = ok && mm.erase(k) == smm.erase(k);
+			break;
+		case 3:
+			m[k] = "v";
+			s[k] = "v";
+			break;
+		case 4:
+		{
+			// 删除一小段区间
+			auto a = m.lower_bound(k);
+			auto b = s.lower_bound(k);
+			const size_t n = rng.below(5);
+			auto a_last = a;
+			auto b_last = b;
+			for (size_t i = 0; i < n && b_last != s.end(); ++i, ++a_last, ++b_last)
+			{
+			}
+			auto r = m.erase(a, a_last);
+			s.erase(b, b_last);
+			ok = (r == m.end()) == (b_last == s.end()) && (r == m.end() || r->first == b_last->first);
+			break;
+		}
+		default:
+		{
+			auto f = m.find(k);
+			auto g = s.find(k);
+			ok = (f == m.end()) == (g == s.end()) && (f == m.end() || f->second == g->second);
+			auto r = mm.equal_range(k);
+			ok = ok && static_cast<size_t>(mystl::distance(r.first, r.second)) == smm.count(k) &&
+				mm.count(k) == smm.count(k);
+			break;
+		}
+		}
+		ok = ok && m.size() == s.size() && mm.size() == smm.size();
+	}
+	EXPECT_TRUE(ok);
+	EXPECT_TRUE(same_entries(m, s));
+	EXPECT_TRUE(same_entries(mm, smm));
+
+	// 反向遍历
+	auto r = s.rbegin();
+	bool reverse_ok = true;
+	for (auto it = m.rbegin(); it != m.rend(); ++it, ++r)
+		reverse_ok = reverse_ok && it->first == r->first;
+	EXPECT_TRUE(reverse_ok && r == s.rend());
+
+	mystl::btree_map<int, std::string> copy(m);
+	EXPECT_TRUE(same_entries(copy, s));
+	copy.clear();
+	EXPECT_TRUE(copy.empty());
+	copy.swap(m);
+	EXPECT_TRUE(m.empty());
+	EXPECT_TRUE(same_entries(copy, s));
+}
+
+TEST(btree_set_test)
+{
+	test_rng rng(4);
+	mystl::btree_set<int> bs;
+	std::set<int> ss;
+	mystl::btree_multiset<int> bms;
+	std::multiset<int> sms;
+	for (int i = 0; i < 50000; ++i)
+	{
+		const int k = static_cast<int>(rng.below(5000));
+		if (rng.below(3) == 0)
+		{
+			bs.erase(k);
+			ss.erase(k);
+			auto it = bms.find(k);
+			if (it != bms.end())
+				bms.erase(it);
+			auto jt = sms.find(k);
+			if (jt != sms.end())
+				sms.erase(jt);
+		}
+		else
+		{
+			bs.insert(k);
+			ss.insert(k);
+			bms.insert(k);
+			sms.insert(k);
+		}
+	}
+	EXPECT_CON_EQ(bs, ss);
+	EXPECT_CON_EQ(bms, sms);
+
+	std::vector<int> sorted(ss.begin(), ss.end());
+	mystl::btree_set<int> bulk(mystl::sorted_unique, sorted.data(), sorted.data() + sorted.size());
+	EXPECT_CON_EQ(bulk, ss);
+}
+
+TEST(btree_hint_insert_test)
+{
+	// 以 lower_bound / upper_bound / 相等区间中间的位置作为提示插入 multimap,
+	// 元素必须插在有效提示之前, 与 std::multimap 的顺序一致
+	test_rng rng(1);
+	bool ok = true;
+	for (int round = 0; round < 4; ++round)
+	{
+		mystl::btree_multimap<int, int> m;
+		std::multimap<int, int> s;
+		for (int i = 0; i < 20000; ++i)
+		{
+			const int k = static_cast<int>(rng.below(round == 0 ? 5 : 200));
+			const size_t mode = rng.below(3);
+			auto sh = mode == 1 ? s.upper_bound(k) : s.lower_bound(k);
+			auto mh = mode == 1 ? m.upper_bound(k) : m.lower_bound(k);
+			if (mode == 2)
+			{
+				size_t steps = rng.below(3);
+				for (; steps > 0 && sh != s.end() && sh->first == k; --steps)
+				{
+					++sh;
+					++mh;
+				}
+			}
+			s.insert(sh, std::make_pair(k, i));
+			m.insert(mh, mystl::make_pair(k, i));
+		}
+		ok = ok && same_entries(m, s);
+	}
+	EXPECT_TRUE(ok);
+
+	// 无效的提示退化为普通插入
+	mystl::btree_set<int> bs;
+	std::set<int> ss;
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int k = static_cast<int>(rng.below(5000));
+		bs.insert(bs.lower_bound(k), k);
+		bs.insert(bs.begin(), k);
+		bs.insert(bs.end(), k);
+		ss.insert(k);
+	}
+	EXPECT_CON_EQ(bs, ss);
+}
+
+// 随机插入、查找、顺序遍历、删除, 对比 std::map
+inline void btree_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t n = 10000000;
+#else
+	const size_t n = 1000000;
+#endif
+	std::vector<uint64_t> keys(n);
+	test_rng rng(8);
+	for (auto& k : keys)
+		k = rng.next();
+	mystl::btree_map<uint64_t, uint64_t> m;
+	std::map<uint64_t, uint64_t> s;
+	perf_header("btree_map vs std::map");
+	perf_row("insert random",
+	         time_ms([&] { for (auto k : keys) m.emplace(k, k); }),
+	         time_ms([&] { for (auto k : keys) s.emplace(k, k); }));
+	uint64_t sum = 0;
+	perf_row("find hit",
+	         time_ms([&] { for (auto k : keys) sum += m.find(k)->second; }),
+	         time_ms([&] { for (auto k : keys) sum += s.find(k)->second; }));
+	perf_row("iterate",
+	         time_ms([&] { for (auto&& kv : m) sum += kv.second; }),
+	         time_ms([&] { for (auto& kv : s) sum += kv.second; }));
+	perf_row("erase random",
+	         time_ms([&] { for (auto k : keys) sum += m.erase(k); }),
+	         time_ms([&] { for (auto k : keys) sum += s.erase(k); }));
+	do_not_optimize(sum);
+	perf_footer();
+}
+
+} // namespace btree_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_TEST_H_
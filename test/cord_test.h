@@ -0,0 +1,184 @@
+#ifndef MYTINYSTL_CORD_TEST_H_
+#define MYTINYSTL_CORD_TEST_H_
+
+// cord 的测试: 随机拼接、插入、删除、取子串与 std::string 比较, 共享的副本不受之后修改的影响
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/cord.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace cord_test
+{
+
+// 按 chunks() 的顺序拼出全部内容
+inline std::string flat_content(const mystl::cord& c)
+{
+	std::string s;
+	for (auto v : c.chunks())
+		s.append(v.data(), v.size());
+	return s;
+}
+
+inline mystl::string_view as_view(const std::string& s)
+{
+	return mystl::string_view(s.data(), s.size());
+}
+
+TEST(cord_random_ops_test)
+{
+	test_rng rng(14);
+	bool ok = true;
+	for (int it = 0; it < 200 && ok; ++it)
+	{
+		mystl::cord c;
+		std::string r;
+		// 操作过程中产生的副本与子串, 最后检查它们没有被后来的修改影响
+		std::vector<std::pair<mystl::cord, std::string>> kept;
+		for (size_t ops = rng.below(60); ops > 0 && ok; --ops)
+		{
+			const size_t n = rng.below(4) == 0 ? rng.below(6000) : rng.below(300);
+			std::string lit(n, static_cast<char>('a' + rng.below(26)));
+			for (auto& ch : lit)
+			{
+				if (rng.below(5) == 0)
+					ch = static_cast<char>('A' + rng.below(26));
+			}
+			const size_t pos = rng.below(r.size() + 1);
+			switch (rng.below(9))
+			{
+			case 0:
+			case 1:
+				c.append(as_view(lit));
+				r += lit;
+				break;
+			case 2:
+				c.prepend(as_view(lit));
+				r = lit + r;
+				break;
+			case 3:
+				c.insert(pos, as_view(lit));
+				r.insert(pos, lit);
+				break;
+			case 4:
+			{
+				const size_t m = rng.below(2000);
+				c.erase(pos, m);
+				r.erase(pos, m);
+				break;
+			}
+			case 5:
+			{
+				const size_t m = rng.below(5000);
+				mystl::cord s = c.substr(pos, m);
+				const std::string rs = r.substr(pos, m);
+				ok = flat_content(s) == rs;
+				kept.emplace_back(s, rs);
+				c.append(s);
+				r += rs;
+				break;
+			}
+			case 6:
+			{
+				// 把自身的副本插入自身
+				mystl::cord d(c);
+				kept.emplace_back(d, r);
+				c.insert(pos, d);
+				r.insert(pos, std::string(r));
+				if (r.size() > 200000)
+				{
+					c.clear();
+					r.clear();
+				}
+				break;
+			}
+			case 7:
+				if (rng.below(4) == 0)
+				{
+					auto v = c.flatten();
+					ok = std::string(v.data(), v.size()) == r;
+				}
+				break;
+			default:
+				c.append(c);
+				r += r;
+				if (r.size() > 200000)
+				{
+					c = mystl::cord();
+					r.clear();
+				}
+				break;
+			}
+			ok = ok && c.size() == r.size() && flat_content(c) == r;
+			if (ok && !r.empty())
+			{
+				const size_t q = rng.below(r.size());
+				ok = c[q] == r[q];
+			}
+		}
+		for (auto& kv : kept)
+			ok = ok && flat_content(kv.first) == kv.second;
+
+		mystl::cord x(as_view(r));
+		ok = ok && x == c && c == as_view(r) && c.to_string().size() == r.size();
+		if (ok && !r.empty())
+		{
+			mystl::cord y = c.substr(0, r.size() - 1);
+			ok = y < c && c > y && y != c;
+		}
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(cord_misc_test)
+{
+	// 大量小块插入到随机位置, 内容保持正确, 块的个数与插入次数同阶
+	test_rng rng(15);
+	mystl::cord c;
+	std::string r;
+	for (int i = 0; i < 5000; ++i)
+	{
+		const std::string lit(200 + rng.below(100), static_cast<char>('a' + i % 26));
+		const size_t pos = rng.below(r.size() + 1);
+		c.insert(pos, as_view(lit));
+		r.insert(pos, lit);
+	}
+	EXPECT_TRUE(flat_content(c) == r);
+	size_t chunks = 0;
+	for (auto v : c.chunks())
+	{
+		(void)v;
+		++chunks;
+	}
+	EXPECT_LT(chunks, 3 * 5000u);
+	EXPECT_EQ(c.at(7), r[7]);
+	EXPECT_THROW(c.at(r.size()), std::out_of_range);
+
+	char buf[16];
+	EXPECT_EQ(c.copy(buf, 16, 100), 16u);
+	EXPECT_EQ(std::string(buf, 16), r.substr(100, 16));
+
+	// 短内容只有一个块, try_flat 不复制
+	mystl::cord s(mystl::string_view("hello"));
+	EXPECT_TRUE(s.try_flat() == "hello");
+	s += mystl::string_view(" world");
+	EXPECT_TRUE(s.to_string() == "hello world");
+	mystl::cord t = s;
+	t.erase(0, 6);
+	EXPECT_TRUE(t == mystl::string_view("world"));
+	EXPECT_TRUE(s == mystl::string_view("hello world"));
+	t.swap(s);
+	EXPECT_EQ(s.size(), 5u);
+}
+
+} // namespace cord_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_CORD_TEST_H_
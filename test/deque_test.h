@@ -0,0 +1,206 @@
+#ifndef MYTINYSTL_DEQUE_TEST_H_
+#define MYTINYSTL_DEQUE_TEST_H_
+
+// deque 的测试: 不同的块大小下对同一组随机操作与 std::deque 比较
+
+#include <deque>
+#include <string>
+
+#include "../src/deque.h"
+#include "../src/queue.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace deque_test
+{
+
+template <size_t B>
+bool deque_random_ops_ok(uint64_t seed)
+{
+	test_rng rng(seed);
+	mystl::deque<std::string, B> d;
+	std::deque<std::string> s;
+	for (int it = 0; it < 20000; ++it)
+	{
+		const std::string v = std::to_string(rng.below(1000));
+		const size_t pos = rng.below(s.size() + 1);
+		switch (rng.below(12))
+		{
+		case 0:
+		case 1:
+			d.push_back(v);
+			s.push_back(v);
+			break;
+		case 2:
+		case 3:
+			d.emplace_front(v);
+			s.push_front(v);
+			break;
+		case 4:
+			if (!s.empty())
+			{
+				d.pop_back();
+				s.pop_back();
+			}
+			break;
+		case 5:
+			if (!s.empty())
+			{
+				d.pop_front();
+				s.pop_front();
+			}
+			break;
+		case 6:
+		{
+			// 先保存返回值, 再与插入后的 begin() 比较
+			auto r = d.insert(d.begin() + pos, v);
+			if (r - d.begin() != static_cast<ptrdiff_t>(pos))
+				return false;
+			s.insert(s.begin() + pos, v);
+			break;
+		}
+		case 7:
+			if (pos < s.size())
+			{
+				auto r = d.erase(d.begin() + pos);
+				if (r - d.begin() != static_cast<ptrdiff_t>(pos))
+					return false;
+				s.erase(s.begin() + pos);
+			}
+			break;
+		case 8:
+		{
+			const size_t n = rng.below(20);
+			d.insert(d.begin() + pos, n, v);
+			// libstdc++ 12 的 std::deque 在中间插入 0 个元素时会把 pos 之后的元素变成空值,
+			// 所以参照端跳过空插入, mystl 一侧仍然覆盖
+			if (n != 0)
+				s.insert(s.begin() + pos, n, v);
+			break;
+		}
+		case 9:
+		{
+			mystl::vector<std::string> src;
+			for (size_t k = rng.below(30); k > 0; --k)
+				src.push_back(std::to_string(k));
+			d.insert(d.begin() + pos, src.begin(), src.end());
+			if (!src.empty())
+				s.insert(s.begin() + pos, src.begin(), src.end());
+			break;
+		}
+		case 10:
+		{
+			const size_t last = pos + rng.below(s.size() - pos + 1);
+			auto r = d.erase(d.begin() + pos, d.begin() + last);
+			if (r - d.begin() != static_cast<ptrdiff_t>(pos))
+				return false;
+			s.erase(s.begin() + pos, s.begin() + last);
+			break;
+		}
+		default:
+			if (rng.below(50) == 0)
+			{
+				const size_t n = rng.below(100);
+				d.resize(n, v);
+				s.resize(n, v);
+			}
+			else if (rng.below(50) == 0)
+			{
+				d.shrink_to_fit();
+			}
+			break;
+		}
+		if (d.size() != s.size())
+			return false;
+	}
+	if (!container_equal(d, s))
+		return false;
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		if (d[i] != s[i])
+			return false;
+	}
+
+	// 迭代器算术
+	for (int k = 0; k < 200 && !s.empty(); ++k)
+	{
+		const ptrdiff_t a = static_cast<ptrdiff_t>(rng.below(s.size()));
+		const ptrdiff_t b = static_cast<ptrdiff_t>(rng.below(s.size()));
+		auto ia = d.begin() + a;
+		auto ib = ia + (b - a);
+		if (ib - d.begin() != b || *ib != s[static_cast<size_t>(b)] || (ia < ib) != (a < b) ||
+		    d.end() - (static_cast<ptrdiff_t>(s.size()) - b) != ib)
+			return false;
+	}
+
+	mystl::deque<std::string, B> c(d);
+	mystl::deque<std::string, B> m(mystl::move(c));
+	c = d;
+	mystl::deque<std::string, B> rv(d.rbegin(), d.rend());
+	return container_equal(m, s) && container_equal(c, s) && rv.size() == d.size() && c == d;
+}
+
+TEST(deque_random_ops_test)
+{
+	for (uint64_t seed = 1; seed < 4; ++seed)
+	{
+		EXPECT_TRUE(deque_random_ops_ok<1>(seed));
+		EXPECT_TRUE(deque_random_ops_ok<3>(seed));
+		EXPECT_TRUE(deque_random_ops_ok<16>(seed));
+		EXPECT_TRUE(deque_random_ops_ok<mystl::deque_block_size<std::string>::value>(seed));
+	}
+}
+
+TEST(deque_fifo_test)
+{
+	mystl::queue<int> q;
+	for (int i = 0; i < 10000; ++i)
+		q.push(i);
+	bool ok = true;
+	for (int i = 0; i < 10000; ++i)
+	{
+		ok = ok && q.front() == i;
+		q.pop();
+	}
+	EXPECT_TRUE(ok && q.empty());
+
+	// 稳定状态的先进先出: 两端交替使用缓存的空闲块
+	mystl::deque<int> w;
+	for (int i = 0; i < 5000; ++i)
+		w.push_back(i);
+	for (int i = 0; i < 200000; ++i)
+	{
+		w.push_back(i);
+		w.pop_front();
+	}
+	for (int r = 0; r < 100; ++r)
+	{
+		for (int i = 0; i < 3000; ++i)
+			w.push_front(i);
+		for (int i = 0; i < 3000; ++i)
+			w.pop_front();
+	}
+	EXPECT_EQ(w.size(), 5000u);
+	EXPECT_EQ(w.front(), 195000);
+	EXPECT_EQ(w.back(), 199999);
+
+	mystl::deque<int> e;
+	for (int i = 0; i < 100; ++i)
+		e.push_front(i);
+	for (int i = 0; i < 100; ++i)
+		e.pop_back();
+	e.shrink_to_fit();
+	EXPECT_TRUE(e.empty());
+	e = { 1, 2 };
+	EXPECT_EQ(e.size(), 2u);
+	EXPECT_EQ(e[1], 2);
+}
+
+} // namespace deque_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_DEQUE_TEST_H_
@@ -0,0 +1,267 @@
+#ifndef MYTINYSTL_EXCEPT_TEST_H_
+#define MYTINYSTL_EXCEPT_TEST_H_
+
+// 错误报告与 try_* 接口的测试
+// 开启异常时检查 report_error 抛出的异常类型; 以 -fno-exceptions 编译时(见 test.cpp)检查错误交给处理函数,
+// 处理函数返回后程序终止, 以及 try_* 接口在无异常模式下的返回值
+
+#include <csetjmp>
+#include <new>
+#include <stdexcept>
+
+#include "../src/basic_string.h"
+#include "../src/exceptdef.h"
+#include "../src/fuctional.h"
+#include "../src/inplace_vector.h"
+#include "../src/vector.h"
+#include "test.h"
+
+#if defined(MYSTL_NO_EXCEPTIONS) && (defined(__unix__) || defined(__APPLE__))
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define MYSTL_TEST_DEATH_TEST 1
+#endif
+
+// AddressSanitizer 与 ThreadSanitizer 把超出上限的分配当作错误报告而不是返回空指针, 此时跳过分配失败的检查
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define MYSTL_TEST_HUGE_ALLOC 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define MYSTL_TEST_HUGE_ALLOC 0
+#endif
+#endif
+#ifndef MYSTL_TEST_HUGE_ALLOC
+#define MYSTL_TEST_HUGE_ALLOC 1
+#endif
+
+namespace mystl
+{
+namespace test
+{
+namespace except_test
+{
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+// 第 throw_at 次构造时抛出异常
+struct throwing_ctor
+{
+	static int throw_at;
+	int v;
+
+	throwing_ctor(int x) :v(x)
+	{
+		if (throw_at == 0)
+			throw 1;
+		if (throw_at > 0)
+			--throw_at;
+	}
+};
+
+int throwing_ctor::throw_at = -1;
+#endif // !MYSTL_NO_EXCEPTIONS
+
+inline void dummy_handler(mystl::errc, const char*) {}
+
+TEST(error_report_test)
+{
+	EXPECT_THROW(mystl::report_error(mystl::errc::length_error, "x"), std::length_error);
+	EXPECT_THROW(mystl::report_error(mystl::errc::out_of_range, "x"), std::out_of_range);
+	EXPECT_THROW(mystl::report_error(mystl::errc::bad_alloc, "x"), std::bad_alloc);
+	EXPECT_THROW(mystl::report_error(mystl::errc::runtime_error, "x"), std::runtime_error);
+
+	mystl::vector<int> v(3);
+	EXPECT_THROW(v.at(3), std::out_of_range);
+	mystl::string s("abc");
+	EXPECT_THROW(s.at(10), std::out_of_range);
+
+	// 处理函数可以设置和取回, 开启异常时不会被调用
+	EXPECT_TRUE(mystl::set_error_handler(dummy_handler) == nullptr);
+	EXPECT_TRUE(mystl::get_error_handler() == dummy_handler);
+	EXPECT_TRUE(mystl::set_error_handler(nullptr) == dummy_handler);
+}
+
+TEST(try_api_test)
+{
+	mystl::vector<int> v;
+	bool ok = true;
+	for (int i = 0; i < 1000; ++i)
+		ok = ok && v.try_push_back(i) == mystl::errc::ok;
+	EXPECT_TRUE(ok);
+	EXPECT_EQ(v.size(), 1000u);
+	EXPECT_EQ(v[999], 999);
+	EXPECT_TRUE(v.try_reserve(5000) == mystl::errc::ok);
+	EXPECT_GT(v.capacity(), 4999u);
+	EXPECT_EQ(v[500], 500);
+	EXPECT_TRUE(v.try_reserve(10) == mystl::errc::ok);
+	EXPECT_TRUE(v.try_reserve(static_cast<size_t>(-1) / 2) == mystl::errc::length_error);
+	EXPECT_EQ(v.size(), 1000u);
+
+	mystl::vector<mystl::string> vs;
+	for (int i = 0; i < 100; ++i)
+		ok = ok && vs.try_emplace_back(static_cast<size_t>(i), 'q') == mystl::errc::ok;
+	EXPECT_TRUE(ok);
+	EXPECT_EQ(vs[99].size(), 99u);
+
+	mystl::string s;
+	for (int i = 0; i < 100; ++i)
+		ok = ok && s.try_push_back('a') == mystl::errc::ok;
+	EXPECT_TRUE(ok);
+	EXPECT_EQ(s.size(), 100u);
+	EXPECT_TRUE(s.try_reserve(300) == mystl::errc::ok);
+	EXPECT_TRUE(s.try_reserve(s.max_size() + 1) == mystl::errc::length_error);
+	EXPECT_EQ(s.size(), 100u);
+
+#if MYSTL_TEST_HUGE_ALLOC
+	// 分配失败时返回 bad_alloc, 原内容不变
+	EXPECT_TRUE(v.try_reserve((static_cast<size_t>(1) << 60) / sizeof(int)) == mystl::errc::bad_alloc);
+	EXPECT_TRUE(s.try_reserve(static_cast<size_t>(1) << 52) == mystl::errc::bad_alloc);
+	EXPECT_EQ(v[999], 999);
+	EXPECT_EQ(s[99], 'a');
+#endif
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+	// 元素的构造函数抛出的异常照常传出, 容器不变
+	mystl::vector<throwing_ctor> tv;
+	tv.try_emplace_back(0);
+	throwing_ctor::throw_at = 0;
+	EXPECT_THROW(tv.try_emplace_back(1), int);
+	throwing_ctor::throw_at = -1;
+	EXPECT_EQ(tv.size(), 1u);
+	while (tv.size() < tv.capacity())
+		tv.try_emplace_back(static_cast<int>(tv.size()));
+	// 需要重新分配时抛出异常, 新申请的空间被释放, 原空间不变
+	const size_t cap = tv.capacity();
+	throwing_ctor::throw_at = 0;
+	EXPECT_THROW(tv.try_emplace_back(-1), int);
+	throwing_ctor::throw_at = -1;
+	EXPECT_EQ(tv.size(), cap);
+	EXPECT_EQ(tv.capacity(), cap);
+	EXPECT_EQ(tv[cap - 1].v, static_cast<int>(cap - 1));
+#endif
+
+	// inplace_vector 已满时返回 length_error
+	mystl::inplace_vector<int, 4> iv;
+	for (int i = 0; i < 4; ++i)
+		ok = ok && iv.try_push_back(i) == mystl::errc::ok;
+	EXPECT_TRUE(ok);
+	EXPECT_TRUE(iv.try_push_back(4) == mystl::errc::length_error);
+	EXPECT_TRUE(iv.try_emplace_back(4) == mystl::errc::length_error);
+	EXPECT_EQ(iv.size(), 4u);
+	EXPECT_EQ(iv.back(), 3);
+}
+
+#if defined(MYSTL_NO_EXCEPTIONS)
+
+// 记录错误后跳回 report_code, 代替不会返回的处理函数
+static std::jmp_buf handler_env;
+static mystl::errc  handled_code = mystl::errc::ok;
+static bool         handled_what = false;
+
+inline void jump_handler(mystl::errc code, const char* what)
+{
+	handled_code = code;
+	handled_what = what != nullptr && what[0] != '\0';
+	std::longjmp(handler_env, 1);
+}
+
+// 执行 f, 返回交给处理函数的错误, 没有出错时返回 errc::ok
+// f 中不应有需要析构的局部对象, longjmp 会跳过它们
+template <class F>
+mystl::errc report_code(F f)
+{
+	handled_code = mystl::errc::ok;
+	handled_what = false;
+	if (setjmp(handler_env) == 0)
+		f();
+	return handled_code;
+}
+
+TEST(no_exceptions_handler_test)
+{
+	mystl::error_handler old = mystl::set_error_handler(jump_handler);
+	mystl::vector<int> v(3);
+	mystl::string s("abc");
+	mystl::inplace_vector<int, 2> iv(2);
+	mystl::function<int(int)> f;
+	EXPECT_TRUE(report_code([&] { v.at(2); }) == mystl::errc::ok);
+	EXPECT_TRUE(report_code([&] { v.at(3); }) == mystl::errc::out_of_range);
+	EXPECT_TRUE(handled_what);
+	EXPECT_TRUE(report_code([&] { v.reserve(v.max_size() + 1); }) == mystl::errc::length_error);
+	EXPECT_TRUE(report_code([&] { s.at(10); }) == mystl::errc::out_of_range);
+	EXPECT_TRUE(report_code([&] { iv.push_back(1); }) == mystl::errc::length_error);
+	EXPECT_TRUE(report_code([&] { f(1); }) == mystl::errc::bad_function_call);
+	EXPECT_TRUE(report_code([] { mystl::report_error(mystl::errc::bad_alloc, "x"); }) == mystl::errc::bad_alloc);
+	// 出错的操作没有改变容器
+	EXPECT_EQ(v.size(), 3u);
+	EXPECT_EQ(iv.size(), 2u);
+	EXPECT_TRUE(mystl::set_error_handler(old) == jump_handler);
+}
+
+#if defined(MYSTL_TEST_DEATH_TEST)
+
+static int handler_pipe = -1;
+
+// 写入错误类别后返回, report_error 随后应当终止程序
+inline void returning_handler(mystl::errc code, const char*)
+{
+	const char c = static_cast<char>('0' + static_cast<int>(code));
+	if (write(handler_pipe, &c, 1) != 1)
+		std::_Exit(2);
+}
+
+// 在子进程中执行 f, 检查它以 SIGABRT 终止, 返回处理函数收到的错误类别, 处理函数未被调用时返回 0
+template <class F>
+char run_until_abort(F f, mystl::error_handler handler)
+{
+	int fds[2];
+	if (pipe(fds) != 0)
+		return 0;
+	std::fflush(nullptr);
+	const pid_t pid = fork();
+	if (pid == 0)
+	{
+		close(fds[0]);
+		handler_pipe = fds[1];
+		mystl::set_error_handler(handler);
+		// 不输出 report_error 的错误信息; 其他测试的线程可能还在, 子进程中只用异步信号安全的调用做准备
+		const int null_fd = open("/dev/null", O_WRONLY);
+		if (null_fd < 0 || dup2(null_fd, 2) < 0)
+			std::_Exit(2);
+		f();
+		std::_Exit(0);
+	}
+	close(fds[1]);
+	char c = 0;
+	if (read(fds[0], &c, 1) != 1)
+		c = 0;
+	close(fds[0]);
+	int status = 0;
+	waitpid(pid, &status, 0);
+	return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT ? c : 'x';
+}
+
+TEST(no_exceptions_abort_test)
+{
+	mystl::vector<int> v(3);
+	mystl::string s("abc");
+	const char out_of_range = static_cast<char>('0' + static_cast<int>(mystl::errc::out_of_range));
+	const char length_error = static_cast<char>('0' + static_cast<int>(mystl::errc::length_error));
+	EXPECT_EQ(run_until_abort([&] { v.at(3); }, returning_handler), out_of_range);
+	EXPECT_EQ(run_until_abort([&] { s.reserve(s.max_size() + 1); }, returning_handler), length_error);
+	// 没有处理函数时直接终止
+	EXPECT_EQ(run_until_abort([&] { v.at(3); }, nullptr), 0);
+}
+
+#endif // MYSTL_TEST_DEATH_TEST
+
+#endif // MYSTL_NO_EXCEPTIONS
+
+} // namespace except_test
+} // namespace test
+} // namespace mystl
+#undef MYSTL_TEST_HUGE_ALLOC
+#undef MYSTL_TEST_DEATH_TEST
+#endif // !MYTINYSTL_EXCEPT_TEST_H_
@@ -0,0 +1,171 @@
+#ifndef MYTINYSTL_EXECUTION_TEST_H_
+#define MYTINYSTL_EXECUTION_TEST_H_
+
+// 执行策略与并行算法的测试: 以串行的 std 算法作为参照
+// 用 par.with_grain 取很小的块, 使较小的数据也会真正切分成多个任务
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "../src/parallel_algo.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace execution_test
+{
+
+inline std::vector<int> random_ints(size_t n, uint64_t seed, int range = 1000)
+{
+	test_rng rng(seed);
+	std::vector<int> v(n);
+	for (auto& x : v)
+		x = static_cast<int>(rng.below(static_cast<size_t>(range))) - range / 2;
+	return v;
+}
+
+TEST(parallel_for_each_transform_test)
+{
+	const auto par = mystl::execution::par.with_grain(64);
+	for (size_t n : { 0u, 1u, 63u, 64u, 65u, 1000u, 100003u })
+	{
+		auto src = random_ints(n, n + 1);
+		mystl::vector<int> a(src.data(), src.data() + src.size());
+		mystl::for_each(par, a.begin(), a.end(), [](int& x) { x = x * 3 + 1; });
+		std::for_each(src.begin(), src.end(), [](int& x) { x = x * 3 + 1; });
+		EXPECT_CON_EQ(a, src);
+
+		mystl::vector<long long> out(n);
+		std::vector<long long> expect(n);
+		mystl::transform(par, a.begin(), a.end(), out.begin(), [](int x) { return 2LL * x; });
+		std::transform(src.begin(), src.end(), expect.begin(), [](int x) { return 2LL * x; });
+		EXPECT_CON_EQ(out, expect);
+
+		mystl::transform(mystl::execution::par_unseq.with_grain(16), a.begin(), a.end(), a.begin(),
+		                 out.begin(), [](int x, int y) { return 1LL * x * y; });
+		std::transform(src.begin(), src.end(), src.begin(), expect.begin(),
+		               [](int x, int y) { return 1LL * x * y; });
+		EXPECT_CON_EQ(out, expect);
+	}
+}
+
+TEST(parallel_reduce_scan_test)
+{
+	const auto par = mystl::execution::par.with_grain(128);
+	for (size_t n : { 0u, 1u, 127u, 129u, 5000u, 250001u })
+	{
+		auto src = random_ints(n, n + 7);
+		mystl::vector<long long> a(src.data(), src.data() + src.size());
+		const long long sum = std::accumulate(src.begin(), src.end(), 0LL);
+		EXPECT_EQ(mystl::reduce(par, a.begin(), a.end(), 0LL), sum);
+		EXPECT_EQ(mystl::reduce(mystl::execution::seq, a.begin(), a.end(), 0LL), sum);
+		EXPECT_EQ(mystl::transform_reduce(par, a.begin(), a.end(), 0LL,
+		                                  [](long long x, long long y) { return x + y; },
+		                                  [](long long x) { return x * x; }),
+		          std::inner_product(src.begin(), src.end(), src.begin(), 0LL));
+
+		mystl::vector<long long> out(n);
+		std::vector<long long> expect(n);
+		mystl::inclusive_scan(par, a.begin(), a.end(), out.begin());
+		std::partial_sum(src.begin(), src.end(), expect.begin(),
+		                 [](long long x, long long y) { return x + y; });
+		EXPECT_CON_EQ(out, expect);
+
+		mystl::exclusive_scan(par, a.begin(), a.end(), out.begin(), 10LL);
+		long long acc = 10;
+		for (size_t i = 0; i < n; ++i)
+		{
+			expect[i] = acc;
+			acc += src[i];
+		}
+		EXPECT_CON_EQ(out, expect);
+	}
+}
+
+TEST(parallel_copy_fill_find_test)
+{
+	const auto par = mystl::execution::par.with_grain(100);
+	auto src = random_ints(54321, 3);
+	mystl::vector<int> a(src.size());
+	mystl::copy(par, src.data(), src.data() + src.size(), a.begin());
+	EXPECT_CON_EQ(a, src);
+
+	mystl::fill(par, a.begin(), a.end(), 7);
+	EXPECT_TRUE(std::all_of(a.begin(), a.end(), [](int x) { return x == 7; }));
+
+	// 找到的必须是第一个满足条件的位置, 即使后面的块先找到
+	for (size_t pos : { 0u, 99u, 100u, 30000u, 54320u })
+	{
+		mystl::fill(par, a.begin(), a.end(), 0);
+		a[pos] = 1;
+		a[54320] = 1;
+		auto it = mystl::find_if(par, a.begin(), a.end(), [](int x) { return x == 1; });
+		EXPECT_EQ(static_cast<size_t>(it - a.begin()), pos);
+	}
+	auto none = mystl::find_if(par, a.begin(), a.end(), [](int x) { return x == 2; });
+	EXPECT_TRUE(none == a.end());
+}
+
+TEST(parallel_sort_test)
+{
+	const auto par = mystl::execution::par.with_grain(256);
+	for (size_t n : { 0u, 1u, 255u, 257u, 10000u, 300007u })
+	{
+		auto src = random_ints(n, n + 11, 100);
+		mystl::vector<int> a(src.data(), src.data() + src.size());
+		mystl::sort(par, a.begin(), a.end());
+		std::sort(src.begin(), src.end());
+		EXPECT_CON_EQ(a, src);
+	}
+
+	// stable_sort 保持相等元素的原有顺序: 只按 first 排序, second 记录原来的下标
+	typedef std::pair<int, int> item;
+	test_rng rng(5);
+	std::vector<item> items(200000);
+	for (size_t i = 0; i < items.size(); ++i)
+		items[i] = item(static_cast<int>(rng.below(50)), static_cast<int>(i));
+	mystl::vector<item> b(items.data(), items.data() + items.size());
+	auto by_first = [](const item& x, const item& y) { return x.first < y.first; };
+	mystl::stable_sort(par, b.begin(), b.end(), by_first);
+	std::stable_sort(items.begin(), items.end(), by_first);
+	EXPECT_CON_EQ(b, items);
+}
+
+// 不同块大小下并行 reduce / sort 相对串行版本的耗时, 用于确定盈亏平衡的块大小
+inline void execution_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t n = 1u << 25;
+#else
+	const size_t n = 1u << 22;
+#endif
+	auto src = random_ints(n, 42);
+	mystl::vector<long long> a(src.data(), src.data() + src.size());
+	perf_header("parallel reduce / sort by grain size", "par", "seq");
+	long long seq_sum = 0;
+	const double seq_reduce = time_ms([&] { seq_sum = mystl::reduce(mystl::execution::seq, a.begin(), a.end(), 0LL); });
+	do_not_optimize(seq_sum);
+	mystl::vector<int> s(src.data(), src.data() + src.size());
+	const double seq_sort = time_ms([&] { mystl::sort(mystl::execution::seq, s.begin(), s.end()); });
+	for (size_t grain : { 1024u, 4096u, 16384u, 65536u, 262144u, 1048576u })
+	{
+		const auto par = mystl::execution::par.with_grain(grain);
+		long long sum = 0;
+		const double t = time_ms([&] { sum = mystl::reduce(par, a.begin(), a.end(), 0LL); });
+		do_not_optimize(sum);
+		perf_row("reduce grain=" + std::to_string(grain), t, seq_reduce);
+		mystl::vector<int> b(src.data(), src.data() + src.size());
+		perf_row("sort   grain=" + std::to_string(grain),
+		         time_ms([&] { mystl::sort(par, b.begin(), b.end()); }), seq_sort);
+	}
+	perf_footer();
+}
+
+} // namespace execution_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_EXECUTION_TEST_H_
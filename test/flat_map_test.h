@@ -0,0 +1,226 @@
+#ifndef MYTINYSTL_FLAT_MAP_TEST_H_
+#define MYTINYSTL_FLAT_MAP_TEST_H_
+
+// flat_map / flat_multimap / flat_set / flat_multiset 的测试, 以 std::map / std::set 等作为参照
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "../src/flat_map.h"
+#include "../src/flat_set.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_map_test
+{
+
+// 支持以 const char* 直接查找的透明比较
+struct transparent_less
+{
+	typedef void is_transparent;
+	bool operator()(const std::string& a, const std::string& b) const { return a < b; }
+	bool operator()(const std::string& a, const char* b) const { return a < b; }
+	bool operator()(const char* a, const std::string& b) const { return a < b; }
+};
+
+// 按顺序逐个比较键与值
+template <class Flat, class Std>
+bool same_pairs(const Flat& f, const Std& s)
+{
+	if (f.size() != s.size())
+		return false;
+	auto a = f.begin();
+	for (auto& p : s)
+	{
+		if (a->first != p.first || a->second != p.second)
+			return false;
+		++a;
+	}
+	return true;
+}
+
+TEST(flat_map_random_ops_test)
+{
+	test_rng rng(1);
+	bool ok = true;
+	for (int round = 0; round < 100 && ok; ++round)
+	{
+		mystl::flat_map<int, int> fm;
+		std::map<int, int> sm;
+		mystl::flat_multimap<int, int> fmm;
+		std::multimap<int, int> smm;
+		mystl::flat_set<int> fs;
+		std::set<int> ss;
+		mystl::flat_multiset<int> fms;
+		std::multiset<int> sms;
+		for (int op = 0; op < 300 && ok; ++op)
+		{
+			const int k = static_cast<int>(rng.below(100));
+			const int v = static_cast<int>(rng.below(1000000));
+			switch (rng.below(7))
+			{
+			case 0:
+			{
+				auto r = fm.insert(mystl::pair<int, int>(k, v));
+				auto s = sm.insert(std::make_pair(k, v));
+				ok = r.second == s.second && r.first->second == s.first->second;
+				fmm.emplace(k, v);
+				smm.emplace(k, v);
+				fs.insert(k);
+				ss.insert(k);
+				fms.insert(k);
+				sms.insert(k);
+				break;
+			}
+			case 1:
+				// 也会删除不存在的键
+				ok = fm.erase(k) == sm.erase(k) && fmm.erase(k) == smm.erase(k) &&
+					fs.erase(k) == ss.erase(k) && fms.erase(k) == sms.erase(k);
+				break;
+			case 2:
+			{
+				// 批量插入, 一半的轮次与已有的键大量重叠
+				mystl::vector<mystl::pair<int, int>> batch;
+				mystl::vector<int> keys;
+				const size_t n = rng.below(20);
+				for (size_t i = 0; i < n; ++i)
+				{
+					const int key = static_cast<int>(rng.below(round % 2 ? 100 : 1000)) +
+						(rng.below(2) ? 100 : 0);
+					batch.push_back(mystl::pair<int, int>(key, static_cast<int>(i)));
+					keys.push_back(key);
+					sm.insert(std::make_pair(key, static_cast<int>(i)));
+					smm.insert(std::make_pair(key, static_cast<int>(i)));
+					ss.insert(key);
+					sms.insert(key);
+				}
+				fm.insert_range(batch.begin(), batch.end());
+				fmm.insert_range(batch.begin(), batch.end());
+				fs.insert_range(keys.begin(), keys.end());
+				fms.insert_range(keys.begin(), keys.end());
+				break;
+			}
+			case 3:
+				fm[k] = v;
+				sm[k] = v;
+				break;
+			case 4:
+				fm.insert_or_assign(k, v);
+				sm[k] = v;
+				break;
+			case 5:
+			{
+				auto it = fm.find(k);
+				auto jt = sm.find(k);
+				ok = (it == fm.end()) == (jt == sm.end());
+				if (ok && it != fm.end())
+				{
+					ok = it->second == jt->second;
+					fm.erase(it);
+					sm.erase(jt);
+				}
+				break;
+			}
+			default:
+				// 带位置提示的插入, multimap 的相等元素插在提示之前
+				fm.insert(fm.lower_bound(k), mystl::pair<int, int>(k, v));
+				sm.insert(std::make_pair(k, v));
+				fmm.insert(fmm.upper_bound(k), mystl::pair<int, int>(k, v));
+				smm.insert(std::make_pair(k, v));
+				break;
+			}
+			ok = ok && fm.size() == sm.size() && fmm.size() == smm.size() &&
+				fs.size() == ss.size() && fms.size() == sms.size();
+		}
+		ok = ok && same_pairs(fm, sm) && same_pairs(fmm, smm) &&
+			container_equal(fs, ss) && container_equal(fms, sms);
+		for (int k = 0; k < 1200 && ok; ++k)
+		{
+			auto r = fmm.equal_range(k);
+			ok = fmm.count(k) == smm.count(k) &&
+				static_cast<size_t>(r.second - r.first) == smm.count(k) &&
+				fs.contains(k) == (ss.count(k) > 0);
+		}
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(flat_map_erase_absent_test)
+{
+	// 删除不存在的键不能改动其他元素的值
+	mystl::flat_map<int, std::string> m;
+	m[1] = "a";
+	m[5] = "b";
+	m[9] = "c";
+	EXPECT_EQ(m.erase(4), 0u);
+	EXPECT_EQ(m.erase(10), 0u);
+	EXPECT_EQ(m.size(), 3u);
+	EXPECT_EQ(m[1], "a");
+	EXPECT_EQ(m[5], "b");
+	EXPECT_EQ(m[9], "c");
+
+	mystl::flat_set<std::string> s;
+	s.insert("x");
+	s.insert("z");
+	EXPECT_EQ(s.erase(std::string("y")), 0u);
+	EXPECT_EQ(s.size(), 2u);
+	EXPECT_EQ(*s.begin(), "x");
+	EXPECT_EQ(s.count("z"), 1u);
+}
+
+TEST(flat_map_construct_test)
+{
+	// 批量构造: 重复的键保留第一个
+	test_rng rng(2);
+	mystl::vector<mystl::pair<int, int>> in;
+	std::map<int, int> ref;
+	for (int i = 0; i < 10000; ++i)
+	{
+		const int k = static_cast<int>(rng.below(5000));
+		in.push_back(mystl::pair<int, int>(k, i));
+		ref.insert(std::make_pair(k, i));
+	}
+	mystl::flat_map<int, int> b(in.begin(), in.end());
+	EXPECT_TRUE(same_pairs(b, ref));
+	mystl::flat_multimap<int, int> bm(in.begin(), in.end());
+	EXPECT_EQ(bm.size(), in.size());
+
+	mystl::flat_map<int, int> z(mystl::vector<int>{ 3, 1, 2, 1 }, mystl::vector<int>{ 30, 10, 20, 11 });
+	EXPECT_EQ(z.size(), 3u);
+	EXPECT_EQ(z.at(1), 10);
+	EXPECT_THROW(z.at(4), std::out_of_range);
+
+	mystl::flat_map<int, int> sorted(mystl::sorted_unique, b.begin(), b.end());
+	EXPECT_TRUE(sorted == b);
+
+	mystl::flat_map<std::string, int, transparent_less> t = { { "b", 2 }, { "a", 1 } };
+	EXPECT_EQ(t.find("a")->second, 1);
+	EXPECT_TRUE(t.contains("b"));
+	EXPECT_EQ(t.erase("a"), 1u);
+	mystl::flat_set<std::string, transparent_less> ts = { "x", "y", "x" };
+	EXPECT_EQ(ts.size(), 2u);
+	EXPECT_EQ(ts.count("x"), 1u);
+
+	mystl::flat_map<int, int> c = b;
+	EXPECT_TRUE(c == b);
+	c[99999] = 1;
+	EXPECT_TRUE(b < c);
+	c.swap(b);
+	EXPECT_EQ(b.size(), ref.size() + 1);
+	// 反向迭代器的 operator-> 经过 arrow_proxy
+	bool reverse_ok = true;
+	auto expect = ref.rbegin();
+	for (auto r = c.rbegin(); r != c.rend(); ++r, ++expect)
+		reverse_ok = reverse_ok && expect != ref.rend() && r->first == expect->first;
+	EXPECT_TRUE(reverse_ok);
+}
+
+} // namespace flat_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_MAP_TEST_H_
@@ -0,0 +1,249 @@
+#ifndef MYTINYSTL_FUNCTION_TEST_H_
+#define MYTINYSTL_FUNCTION_TEST_H_
+
+// function / move_only_function / function_ref 的测试, 以及与 std::function 比较构造和调用的开销
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include "../src/fuctional.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace function_test
+{
+
+// 记录存活对象个数, 检查没有泄漏或重复析构
+static int live_objects = 0;
+
+// 超过缺省内联缓冲区大小的可调用对象
+struct big_callable
+{
+	char pad[100];
+	int  v;
+
+	big_callable(int x) :v(x) { ++live_objects; }
+	big_callable(const big_callable& rhs) :v(rhs.v) { ++live_objects; }
+	big_callable(big_callable&& rhs) noexcept :v(rhs.v) { ++live_objects; }
+	~big_callable() { --live_objects; }
+	int operator()(int a) const { return a + v; }
+};
+
+// 移动构造可能抛出异常, 不能放进内联缓冲区
+struct throwing_move_callable
+{
+	int v;
+
+	throwing_move_callable(int a) :v(a) { ++live_objects; }
+	throwing_move_callable(const throwing_move_callable& rhs) :v(rhs.v) { ++live_objects; }
+	~throwing_move_callable() { --live_objects; }
+	int operator()(int a) { return a * v; }
+};
+
+// 只能移动的可调用对象
+struct unique_callable
+{
+	std::unique_ptr<int> p;
+
+	explicit unique_callable(int v) :p(new int(v)) {}
+	int operator()() const { return *p; }
+};
+
+struct member_holder
+{
+	int x = 3;
+	int get(int a) const { return x + a; }
+};
+
+inline int add_one(int a) { return a + 1; }
+
+inline int call_ref(mystl::function_ref<int(int)> f, int v) { return f(v); }
+
+TEST(function_test)
+{
+	{
+		mystl::function<int(int)> f = add_one;
+		EXPECT_EQ(f(1), 2);
+		f = [](int a) { return a * 2; };
+		EXPECT_EQ(f(3), 6);
+
+		mystl::function<int(int)> g = big_callable(5);
+		EXPECT_EQ(g(1), 6);
+		EXPECT_EQ(live_objects, 1);
+		auto h = g;
+		EXPECT_EQ(live_objects, 2);
+		EXPECT_EQ(h(2), 7);
+		f = mystl::move(g);
+		EXPECT_FALSE(static_cast<bool>(g));
+		EXPECT_EQ(live_objects, 2);
+		EXPECT_EQ(f(0), 5);
+
+		// 内联存储与堆存储互相交换
+		mystl::function<int(int)> small = [](int a) { return a; };
+		small.swap(f);
+		EXPECT_EQ(small(1), 6);
+		EXPECT_EQ(f(1), 1);
+		EXPECT_TRUE(small.target<big_callable>() != nullptr);
+		EXPECT_EQ(small.target<big_callable>()->v, 5);
+		EXPECT_TRUE(small.target<int(*)(int)>() == nullptr);
+
+		// 成员函数与成员变量指针
+		member_holder s;
+		mystl::function<int(const member_holder&, int)> m = &member_holder::get;
+		EXPECT_EQ(m(s, 1), 4);
+		mystl::function<int(member_holder*, int)> mp = &member_holder::get;
+		EXPECT_EQ(mp(&s, 2), 5);
+		mystl::function<int(member_holder&)> md = &member_holder::x;
+		EXPECT_EQ(md(s), 3);
+
+		int (*np)(int) = nullptr;
+		mystl::function<int(int)> e = np;
+		EXPECT_FALSE(static_cast<bool>(e));
+		EXPECT_THROW(e(1), std::bad_function_call);
+
+		// 返回值被丢弃
+		mystl::function<void(int)> vv = add_one;
+		vv(3);
+
+		mystl::function<int(int), 128> bigbuf = big_callable(1);
+		EXPECT_EQ(bigbuf(1), 2);
+		mystl::function<int(int)> tm = throwing_move_callable(3);
+		EXPECT_EQ(tm(2), 6);
+		auto tm2 = tm;
+		EXPECT_EQ(tm2(1), 3);
+		f = nullptr;
+		EXPECT_FALSE(static_cast<bool>(f));
+
+		mystl::vector<mystl::function<int(int)>> v;
+		for (int i = 0; i < 100; ++i)
+			v.push_back([i](int a) { return a + i; });
+		int sum = 0;
+		for (auto& x : v)
+			sum += x(0);
+		EXPECT_EQ(sum, 4950);
+	}
+	EXPECT_EQ(live_objects, 0);
+}
+
+TEST(move_only_function_test)
+{
+	{
+		mystl::move_only_function<int()> mo = unique_callable(7);
+		EXPECT_EQ(mo(), 7);
+		mystl::move_only_function<int()> mo2 = mystl::move(mo);
+		EXPECT_FALSE(static_cast<bool>(mo));
+		EXPECT_EQ(mo2(), 7);
+
+		mystl::move_only_function<int(int)> mb = big_callable(2);
+		EXPECT_EQ(mb(1), 3);
+		mystl::move_only_function<int(int)> mb2;
+		mb2 = mystl::move(mb);
+		EXPECT_EQ(mb2(1), 3);
+		mb2.swap(mb);
+		EXPECT_EQ(mb(0), 2);
+	}
+	EXPECT_EQ(live_objects, 0);
+	static_assert(!std::is_copy_constructible<mystl::move_only_function<int()>>::value, "");
+	static_assert(!std::is_constructible<mystl::function<int()>, unique_callable>::value, "");
+	static_assert(std::is_constructible<mystl::move_only_function<int()>, unique_callable>::value, "");
+}
+
+TEST(function_ref_test)
+{
+	EXPECT_EQ(call_ref(add_one, 1), 2);
+	int k = 10;
+	EXPECT_EQ(call_ref([&](int a) { return a + k; }, 1), 11);
+	big_callable b(4);
+	EXPECT_EQ(call_ref(b, 1), 5);
+	const big_callable& cb = b;
+	EXPECT_EQ(call_ref(cb, 2), 6);
+	mystl::function<int(int)> ff = add_one;
+	EXPECT_EQ(call_ref(ff, 5), 6);
+	mystl::function_ref<int(int)> r1 = add_one;
+	mystl::function_ref<int(int)> r2 = r1;
+	EXPECT_EQ(r2(0), 1);
+	// function_ref 只有两个指针
+	static_assert(sizeof(mystl::function_ref<int(int)>) == 2 * sizeof(void*), "");
+}
+
+// 捕获 24 字节的 lambda: std::function 需要申请内存, mystl::function 放在内联缓冲区中
+inline void function_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const long n = 100000000;
+#else
+	const long n = 10000000;
+#endif
+	struct capture
+	{
+		long a, b, c;
+	};
+	const capture cap = { 1, 2, 3 };
+	long sum = 0;
+	perf_header("function vs std::function");
+	const double small_mystl = time_ms([&]
+	{
+		for (long i = 0; i < n / 10; ++i)
+		{
+			mystl::function<long(long)> f = [i](long x) { return x + i; };
+			sum += f(i);
+		}
+	});
+	const double small_std = time_ms([&]
+	{
+		for (long i = 0; i < n / 10; ++i)
+		{
+			std::function<long(long)> f = [i](long x) { return x + i; };
+			sum += f(i);
+		}
+	});
+	perf_row("construct+call 8B capture", small_mystl, small_std);
+	const double big_mystl = time_ms([&]
+	{
+		for (long i = 0; i < n / 10; ++i)
+		{
+			mystl::function<long(long)> f = [cap](long x) { return x + cap.a + cap.b + cap.c; };
+			sum += f(i);
+		}
+	});
+	const double big_std = time_ms([&]
+	{
+		for (long i = 0; i < n / 10; ++i)
+		{
+			std::function<long(long)> f = [cap](long x) { return x + cap.a + cap.b + cap.c; };
+			sum += f(i);
+		}
+	});
+	perf_row("construct+call 24B capture", big_mystl, big_std);
+	{
+		mystl::function<long(long)> mf = [cap](long x) { return x + cap.a; };
+		std::function<long(long)> sf = [cap](long x) { return x + cap.a; };
+		mystl::function<long(long)> mcopy;
+		std::function<long(long)> scopy;
+		perf_row("copy 24B capture",
+		         time_ms([&] { for (long i = 0; i < n / 10; ++i) { mcopy = mf; sum += mcopy(i); } }),
+		         time_ms([&] { for (long i = 0; i < n / 10; ++i) { scopy = sf; sum += scopy(i); } }));
+		do_not_optimize(mf);
+		do_not_optimize(sf);
+		perf_row("invoke",
+		         time_ms([&] { for (long i = 0; i < n; ++i) sum += mf(i); }),
+		         time_ms([&] { for (long i = 0; i < n; ++i) sum += sf(i); }));
+		mystl::function_ref<long(long)> rf = mf;
+		do_not_optimize(rf);
+		perf_row("invoke via function_ref",
+		         time_ms([&] { for (long i = 0; i < n; ++i) sum += rf(i); }),
+		         time_ms([&] { for (long i = 0; i < n; ++i) sum += sf(i); }));
+	}
+	do_not_optimize(sum);
+	perf_footer();
+}
+
+} // namespace function_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FUNCTION_TEST_H_
@@ -0,0 +1,154 @@
+#ifndef MYTINYSTL_HASH_TEST_H_
+#define MYTINYSTL_HASH_TEST_H_
+
+// fuctional.h 中哈希函数的测试: 雪崩性检查、hash_combine 与按输入长度的吞吐量
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../src/fuctional.h"
+#include "../src/hashtable.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace hash_test
+{
+
+// 翻转输入的每一位, 统计输出每一位翻转的比例, 返回与 0.5 的最大偏差
+template <class Hash>
+double worst_avalanche_bias(size_t len, size_t samples, uint64_t seed, Hash hash)
+{
+	test_rng rng(seed);
+	std::vector<size_t> flips(len * 8 * 64, 0);
+	std::string s(len, '\0');
+	for (size_t n = 0; n < samples; ++n)
+	{
+		for (auto& c : s)
+			c = static_cast<char>(rng.next());
+		const uint64_t h = hash(s);
+		for (size_t b = 0; b < len * 8; ++b)
+		{
+			std::string t = s;
+			t[b / 8] = static_cast<char>(t[b / 8] ^ (1 << (b % 8)));
+			const uint64_t d = h ^ hash(t);
+			for (size_t o = 0; o < 64; ++o)
+				flips[b * 64 + o] += static_cast<size_t>((d >> o) & 1);
+		}
+	}
+	double worst = 0;
+	for (size_t c : flips)
+		worst = std::max(worst, std::fabs(static_cast<double>(c) / static_cast<double>(samples) - 0.5));
+	return worst;
+}
+
+enum class color { red, green };
+
+TEST(hash_avalanche_test)
+{
+	// 1000 个样本时单个比例的标准差约为 0.016, 好的混合函数的最大偏差远小于 0.1
+	// 单字节输入只有 256 种取值, 统计量本身的波动就接近 0.1, 所以从两个字节开始检查
+	for (size_t len : { 2u, 3u, 4u, 8u, 13u, 16u, 17u, 33u, 64u })
+	{
+		const double bias = worst_avalanche_bias(len, 1000, len, [](const std::string& s)
+		{
+			return mystl::hash_bytes(s.data(), s.size());
+		});
+		EXPECT_LT(bias, 0.1);
+	}
+	const double int_bias = worst_avalanche_bias(8, 4000, 99, [](const std::string& s)
+	{
+		uint64_t x = 0;
+		for (size_t i = 0; i < 8; ++i)
+			x |= static_cast<uint64_t>(static_cast<unsigned char>(s[i])) << (8 * i);
+		return mystl::hash_int(x);
+	});
+	EXPECT_LT(int_bias, 0.1);
+
+	static_assert(mystl::hash_is_avalanching<mystl::hash<int>>::value, "");
+	static_assert(mystl::hash_is_avalanching<mystl::hash<color>>::value, "");
+	static_assert(mystl::hash_is_avalanching<mystl::hash<std::string>>::value, "");
+}
+
+TEST(hash_values_test)
+{
+	// 相等的值哈希相等, 种子不同结果不同
+	EXPECT_EQ(mystl::hash_bytes("abcdef", 6), mystl::hash_bytes(std::string("abcdef").data(), 6));
+	EXPECT_NE(mystl::hash_bytes("abcdef", 6, 1), mystl::hash_bytes("abcdef", 6, 2));
+	EXPECT_EQ(mystl::hash<std::string>()("key"), mystl::hash<std::string>()(std::string("key")));
+	EXPECT_EQ(mystl::hash<double>()(0.0), mystl::hash<double>()(-0.0));
+	EXPECT_EQ(mystl::hash<float>()(0.0f), mystl::hash<float>()(-0.0f));
+	EXPECT_NE(mystl::hash<color>()(color::red), mystl::hash<color>()(color::green));
+
+	// hash_combine 与顺序有关
+	size_t a = 0, b = 0;
+	mystl::hash_combine(a, 1);
+	mystl::hash_combine(a, std::string("x"));
+	mystl::hash_combine(b, std::string("x"));
+	mystl::hash_combine(b, 1);
+	EXPECT_NE(a, b);
+	EXPECT_NE(mystl::hash_values(1, 2, 3), mystl::hash_values(3, 2, 1));
+	EXPECT_EQ(mystl::hash_values(1, 2, 3), mystl::hash_values(1, 2, 3));
+
+	typedef mystl::pair<int, int> point;
+	mystl::hash<point> ph;
+	EXPECT_NE(ph(point(1, 2)), ph(point(2, 1)));
+	// 小整数对在低位上也要分散开
+	std::vector<size_t> buckets(64, 0);
+	for (int x = 0; x < 64; ++x)
+		for (int y = 0; y < 64; ++y)
+			++buckets[ph(point(x, y)) & 63];
+	size_t fullest = 0;
+	for (size_t c : buckets)
+		fullest = std::max(fullest, c);
+	EXPECT_LT(fullest, 128u);
+}
+
+// 按输入长度统计哈希相同总字节数的耗时, 对比 std::hash<std::string>
+inline void hash_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t total = 1u << 30;
+#else
+	const size_t total = 1u << 27;
+#endif
+	perf_header("hash throughput by input length (same bytes)");
+	for (size_t len : { 4u, 8u, 16u, 32u, 64u, 256u, 1024u, 4096u })
+	{
+		std::vector<std::string> inputs(64);
+		test_rng rng(len);
+		for (auto& s : inputs)
+		{
+			s.resize(len);
+			for (auto& c : s)
+				c = static_cast<char>(rng.next());
+		}
+		const size_t rounds = total / len / inputs.size();
+		size_t sum = 0;
+		const double mystl_ms = time_ms([&]
+		{
+			for (size_t r = 0; r < rounds; ++r)
+				for (auto& s : inputs)
+					sum += static_cast<size_t>(mystl::hash_bytes(s.data(), s.size(), r));
+		});
+		const double std_ms = time_ms([&]
+		{
+			std::hash<std::string> h;
+			for (size_t r = 0; r < rounds; ++r)
+				for (auto& s : inputs)
+					sum += h(s) + r;
+		});
+		do_not_optimize(sum);
+		perf_row("hash_bytes len=" + std::to_string(len), mystl_ms, std_ms);
+	}
+	perf_footer();
+}
+
+} // namespace hash_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HASH_TEST_H_
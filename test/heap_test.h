@@ -0,0 +1,246 @@
+#ifndef MYTINYSTL_HEAP_TEST_H_
+#define MYTINYSTL_HEAP_TEST_H_
+
+// d 叉堆算法、priority_queue 与 indexed_priority_queue 的测试
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/heap_algo.h"
+#include "../src/queue.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace heap_test
+{
+
+template <size_t D>
+bool heap_algorithms_ok(uint64_t seed)
+{
+	test_rng rng(seed);
+	for (size_t n = 0; n < 300; ++n)
+	{
+		mystl::vector<int> v;
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(static_cast<int>(rng.below(50)));
+		mystl::make_heap<D>(v.begin(), v.end());
+		if (!mystl::is_heap<D>(v.begin(), v.end()))
+			return false;
+		v.push_back(static_cast<int>(rng.below(100)));
+		mystl::push_heap<D>(v.begin(), v.end());
+		if (!mystl::is_heap<D>(v.begin(), v.end()))
+			return false;
+		const int top = v.front();
+		mystl::pop_heap<D>(v.begin(), v.end());
+		if (v.back() != top || !mystl::is_heap<D>(v.begin(), v.end() - 1))
+			return false;
+		mystl::sort_heap<D>(v.begin(), v.end() - 1);
+		if (!std::is_sorted(v.begin(), v.end()))
+			return false;
+		// 自定义比较: 小顶堆
+		mystl::make_heap<D>(v.begin(), v.end(), std::greater<int>());
+		if (mystl::is_heap_until<D>(v.begin(), v.end(), std::greater<int>()) != v.end())
+			return false;
+	}
+	return true;
+}
+
+template <size_t D>
+bool priority_queue_ok(uint64_t seed)
+{
+	test_rng rng(seed);
+	mystl::priority_queue<std::string, mystl::vector<std::string>, mystl::greater<std::string>, D> q;
+	std::priority_queue<std::string, std::vector<std::string>, std::greater<std::string>> s;
+	for (int i = 0; i < 20000; ++i)
+	{
+		if (rng.below(3) != 0 && !q.empty())
+		{
+			if (q.top() != s.top())
+				return false;
+			q.pop();
+			s.pop();
+		}
+		else
+		{
+			const std::string x = std::to_string(rng.below(1000));
+			q.push(x);
+			s.push(x);
+		}
+		if (q.size() != s.size())
+			return false;
+	}
+	return true;
+}
+
+TEST(heap_algorithm_test)
+{
+	EXPECT_TRUE(heap_algorithms_ok<2>(1));
+	EXPECT_TRUE(heap_algorithms_ok<3>(2));
+	EXPECT_TRUE(heap_algorithms_ok<4>(3));
+	EXPECT_TRUE(heap_algorithms_ok<8>(4));
+}
+
+TEST(priority_queue_test)
+{
+	EXPECT_TRUE(priority_queue_ok<2>(5));
+	EXPECT_TRUE(priority_queue_ok<4>(6));
+	EXPECT_TRUE(priority_queue_ok<8>(7));
+
+	int a[] = { 5, 1, 9, 3, 7 };
+	mystl::priority_queue<int> q(a, a + 5);
+	EXPECT_EQ(q.top(), 9);
+	q.pop();
+	EXPECT_EQ(q.top(), 7);
+	mystl::priority_queue<int> r = { 4, 8 };
+	q.swap(r);
+	EXPECT_EQ(q.size(), 2u);
+	EXPECT_EQ(q.top(), 8);
+	q.clear();
+	EXPECT_TRUE(q.empty());
+}
+
+TEST(indexed_priority_queue_test)
+{
+	// 以 std::set 为参照, 随机执行 push / decrease_key / update / erase / pop
+	typedef std::pair<int, int> item;
+	test_rng rng(9);
+	mystl::indexed_priority_queue<item, mystl::greater<item>> q;
+	std::set<item> ref;
+	std::vector<std::pair<size_t, item>> live;
+	bool ok = true;
+	for (int it = 0; it < 100000 && ok; ++it)
+	{
+		switch (rng.below(5))
+		{
+		case 0:
+		case 1:
+		{
+			const item v(static_cast<int>(rng.below(1000)), it);
+			live.push_back(std::make_pair(q.push(v), v));
+			ref.insert(v);
+			break;
+		}
+		case 2:
+			if (!live.empty())
+			{
+				auto& e = live[rng.below(live.size())];
+				const item v(e.second.first - static_cast<int>(rng.below(50)), e.second.second);
+				ref.erase(e.second);
+				ref.insert(v);
+				q.decrease_key(e.first, v);
+				e.second = v;
+			}
+			break;
+		case 3:
+			if (!live.empty())
+			{
+				const size_t k = rng.below(live.size());
+				q.erase(live[k].first);
+				ok = ok && !q.contains(live[k].first);
+				ref.erase(live[k].second);
+				live[k] = live.back();
+				live.pop_back();
+			}
+			break;
+		default:
+			if (!live.empty())
+			{
+				auto& e = live[rng.below(live.size())];
+				const item v(static_cast<int>(rng.below(1000)), e.second.second);
+				ref.erase(e.second);
+				ref.insert(v);
+				q.update(e.first, v);
+				ok = ok && q.get(e.first) == v;
+				e.second = v;
+			}
+			break;
+		}
+		ok = ok && q.size() == ref.size();
+		if (ok && !ref.empty())
+		{
+			ok = q.top() == *ref.begin();
+			if (rng.below(7) == 0)
+			{
+				const size_t h = q.top_handle();
+				q.pop();
+				ref.erase(ref.begin());
+				for (size_t k = 0; k < live.size(); ++k)
+				{
+					if (live[k].first == h)
+					{
+						live[k] = live.back();
+						live.pop_back();
+						break;
+					}
+				}
+			}
+		}
+	}
+	EXPECT_TRUE(ok);
+	q.clear();
+	EXPECT_TRUE(q.empty());
+}
+
+// 大堆上 push / pop 的耗时, 对比二叉、4 叉、8 叉堆与 std::priority_queue
+template <size_t D>
+double priority_queue_ms(const std::vector<unsigned>& data)
+{
+	return time_ms([&]
+	{
+		mystl::priority_queue<unsigned, mystl::vector<unsigned>, mystl::less<unsigned>, D> q;
+		for (unsigned x : data)
+			q.push(x);
+		unsigned sum = 0;
+		while (!q.empty())
+		{
+			sum += q.top();
+			q.pop();
+		}
+		do_not_optimize(sum);
+	});
+}
+
+inline void heap_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t n = 1u << 24;
+#else
+	const size_t n = 1u << 21;
+#endif
+	std::vector<unsigned> data(n);
+	test_rng rng(1);
+	for (auto& x : data)
+		x = static_cast<unsigned>(rng.next());
+	const double std_ms = time_ms([&]
+	{
+		std::priority_queue<unsigned> q;
+		for (unsigned x : data)
+			q.push(x);
+		unsigned sum = 0;
+		while (!q.empty())
+		{
+			sum += q.top();
+			q.pop();
+		}
+		do_not_optimize(sum);
+	});
+	perf_header("priority_queue push + pop all");
+	const std::string suffix = " n=" + std::to_string(n);
+	perf_row("2-ary" + suffix, priority_queue_ms<2>(data), std_ms);
+	perf_row("4-ary" + suffix, priority_queue_ms<4>(data), std_ms);
+	perf_row("8-ary" + suffix, priority_queue_ms<8>(data), std_ms);
+	perf_footer();
+}
+
+} // namespace heap_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HEAP_TEST_H_
@@ -0,0 +1,164 @@
+#ifndef MYTINYSTL_INPLACE_VECTOR_TEST_H_
+#define MYTINYSTL_INPLACE_VECTOR_TEST_H_
+
+// inplace_vector 与 array 的测试
+// 以 C++20 编译时, 另外检查它们与基本算法能在常量求值中使用
+
+#include <stdexcept>
+#include <string>
+
+#include "../src/algo.h"
+#include "../src/array.h"
+#include "../src/inplace_vector.h"
+#include "../src/uninitialized.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace inplace_vector_test
+{
+
+#if defined(MYSTL_HAS_CONSTEXPR20)
+
+// 在常量求值中构造、插入、删除、排序并查找, 覆盖 construct / uninitialized / algo 的常量求值路径
+constexpr bool inplace_vector_constexpr_ok()
+{
+	mystl::inplace_vector<int, 8> v = { 5, 3, 7 };
+	v.push_back(1);
+	v.insert(v.begin() + 1, 2, 9);
+	v.erase(v.begin());
+	mystl::sort(v.begin(), v.end());
+	mystl::inplace_vector<int, 8> w(v);
+	w.resize(2);
+	v.swap(w);
+	return w.size() == 5 && *mystl::lower_bound(w.begin(), w.end(), 4) == 7 &&
+		w.back() == 9 && v.size() == 2 && v.try_emplace_back(0) == mystl::errc::ok;
+}
+
+static_assert(inplace_vector_constexpr_ok(), "");
+
+constexpr int algo_constexpr_value()
+{
+	int a[8] = { 5, 3, 7, 1, 8, 2, 6, 4 };
+	mystl::sort(a, a + 8);
+	int b[8] = {};
+	mystl::copy(a, a + 8, b);
+	mystl::copy_backward(b, b + 4, b + 8);
+	mystl::stable_sort(a, a + 8, [](int x, int y) { return x > y; });
+	unsigned char c[4] = {};
+	mystl::fill_n(c, 4, static_cast<unsigned char>(7));
+	auto p = mystl::lower_bound(b, b + 8, 3);
+	mystl::make_heap(a, a + 8);
+	mystl::sort_heap(a, a + 8);
+	mystl::reverse(a, a + 8);
+	return *p + a[0] + c[3];
+}
+
+static_assert(algo_constexpr_value() == 3 + 8 + 7, "");
+
+constexpr mystl::array<int, 6> make_table()
+{
+	mystl::array<int, 6> a = {{ 9, 4, 1, 8, 2, 6 }};
+	mystl::sort(a.begin(), a.end());
+	return a;
+}
+
+constexpr auto sorted_table = make_table();
+static_assert(sorted_table[0] == 1 && mystl::get<5>(sorted_table) == 9, "");
+static_assert(*mystl::lower_bound(sorted_table.begin(), sorted_table.end(), 5) == 6, "");
+
+constexpr mystl::inplace_vector<int, 4> constant_iv = { 3, 1, 2 };
+static_assert(constant_iv.size() == 3 && constant_iv[2] == 2, "");
+
+constexpr int array_constexpr_value()
+{
+	mystl::inplace_vector<int, 4> v(3, 7);
+	mystl::array<int, 4> a{};
+	a.fill(1);
+	mystl::copy(v.begin(), v.end(), a.begin());
+	mystl::inplace_vector<int, 4> w;
+	w = v;
+	w.pop_back();
+	if (v.try_push_back(1) != mystl::errc::ok)
+		return -1;
+	if (v.try_push_back(1) != mystl::errc::length_error)
+		return -2;
+	mystl::stable_sort(v.begin(), v.end());
+	mystl::array<int, 4> b = a;
+	b.swap(a);
+	return a[0] + a[3] + static_cast<int>(w.size()) + v[0] + (a == b) + (v > w);
+}
+
+static_assert(array_constexpr_value() == 7 + 1 + 2 + 1 + 1 + 0, "");
+
+#endif // MYSTL_HAS_CONSTEXPR20
+
+TEST(inplace_vector_test)
+{
+	// 非平凡的元素保存在字节缓冲区中
+	mystl::inplace_vector<std::string, 5> s = { "a", "b" };
+	s.insert(s.begin(), 2, std::string(40, 'x'));
+	s.emplace(s.begin() + 1, s[3]);
+	EXPECT_EQ(s.size(), 5u);
+	EXPECT_TRUE(s[1] == "b" && s[4] == "b");
+	s.erase(s.begin());
+	mystl::inplace_vector<std::string, 5> t(s);
+	t.resize(1);
+	s.swap(t);
+	EXPECT_EQ(s.size(), 1u);
+	EXPECT_EQ(t.size(), 4u);
+	EXPECT_TRUE(t[0] == "b" && t[3] == "b");
+
+	// 超出容量时抛出异常, 容器不变
+	EXPECT_THROW(t.insert(t.end(), { "1", "2" }), std::length_error);
+	EXPECT_THROW(t.resize(6), std::length_error);
+	EXPECT_EQ(t.size(), 4u);
+	t.push_back("c");
+	EXPECT_THROW(t.push_back("d"), std::length_error);
+	EXPECT_TRUE(t.try_push_back("d") == mystl::errc::length_error);
+	EXPECT_TRUE(t.back() == "c");
+	EXPECT_EQ(t.capacity(), 5u);
+
+	mystl::inplace_vector<int, 16> v;
+	for (int i = 0; i < 16; ++i)
+		v.push_back(15 - i);
+	mystl::sort(v.begin(), v.end());
+	EXPECT_EQ(v.front(), 0);
+	EXPECT_EQ(v.back(), 15);
+	v.erase(v.begin() + 2, v.begin() + 10);
+	EXPECT_EQ(v.size(), 8u);
+	EXPECT_EQ(v[2], 10);
+	mystl::inplace_vector<int, 16> w(v.begin(), v.end());
+	EXPECT_TRUE(w == v);
+	w.assign(3, 4);
+	EXPECT_FALSE(w < v);
+	EXPECT_EQ(w.size(), 3u);
+	static_assert(mystl::is_trivially_relocatable<mystl::inplace_vector<int, 4>>::value, "");
+}
+
+TEST(array_test)
+{
+	mystl::array<std::string, 2> as = {{ "q", "r" }};
+	EXPECT_THROW(as.at(2), std::out_of_range);
+	EXPECT_TRUE(as.at(1) == "r");
+	mystl::array<std::string, 2> bs = as;
+	bs[0] = "p";
+	EXPECT_TRUE(bs < as);
+	bs.swap(as);
+	EXPECT_TRUE(as[0] == "p" && bs[0] == "q");
+
+	mystl::array<int, 5> a = {{ 5, 1, 4, 2, 3 }};
+	mystl::sort(a.begin(), a.end());
+	EXPECT_EQ(a.front(), 1);
+	EXPECT_EQ(mystl::get<4>(a), 5);
+	EXPECT_EQ(a.size(), 5u);
+	a.fill(9);
+	EXPECT_EQ(a.back(), 9);
+}
+
+} // namespace inplace_vector_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_INPLACE_VECTOR_TEST_H_
@@ -0,0 +1,159 @@
+#ifndef MYTINYSTL_ITERATOR_TEST_H_
+#define MYTINYSTL_ITERATOR_TEST_H_
+
+// 连续迭代器标签与迭代器解包的测试: 经过包装的迭代器仍走指针上的快速路径, 结果与逐个处理一致
+
+#include <string>
+#include <type_traits>
+
+#include "../src/algo.h"
+#include "../src/algobase.h"
+#include "../src/deque.h"
+#include "../src/uninitialized.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace iterator_test
+{
+
+// 声明为 contiguous_iterator_tag 的类类型迭代器
+template <class T>
+struct contiguous_iter : public mystl::iterator<mystl::contiguous_iterator_tag, T>
+{
+	T* p;
+
+	contiguous_iter(T* q = nullptr) :p(q) {}
+	T& operator*() const { return *p; }
+	T* operator->() const { return p; }
+	contiguous_iter& operator++() { ++p; return *this; }
+	contiguous_iter operator++(int) { contiguous_iter t = *this; ++p; return t; }
+	contiguous_iter& operator--() { --p; return *this; }
+	contiguous_iter operator--(int) { contiguous_iter t = *this; --p; return t; }
+	contiguous_iter operator+(ptrdiff_t n) const { return contiguous_iter(p + n); }
+	contiguous_iter operator-(ptrdiff_t n) const { return contiguous_iter(p - n); }
+	contiguous_iter& operator+=(ptrdiff_t n) { p += n; return *this; }
+	contiguous_iter& operator-=(ptrdiff_t n) { p -= n; return *this; }
+	ptrdiff_t operator-(contiguous_iter rhs) const { return p - rhs.p; }
+	T& operator[](ptrdiff_t n) const { return p[n]; }
+	bool operator==(contiguous_iter rhs) const { return p == rhs.p; }
+	bool operator!=(contiguous_iter rhs) const { return p != rhs.p; }
+	bool operator<(contiguous_iter rhs) const { return p < rhs.p; }
+};
+
+typedef contiguous_iter<int> int_iter;
+typedef mystl::reverse_iterator<mystl::reverse_iterator<int_iter>> double_reverse;
+
+TEST(contiguous_iterator_traits_test)
+{
+	static_assert(mystl::is_contiguous_iterator<int*>::value, "");
+	static_assert(mystl::is_contiguous_iterator<const int*>::value, "");
+	static_assert(mystl::is_contiguous_iterator<int_iter>::value, "");
+	static_assert(!mystl::is_contiguous_iterator<mystl::reverse_iterator<int*>>::value, "");
+	static_assert(!mystl::is_contiguous_iterator<mystl::deque<int>::iterator>::value, "");
+	// 反向迭代器把连续降为随机访问
+	static_assert(std::is_same<mystl::iterator_traits<mystl::reverse_iterator<int_iter>>::iterator_category,
+	                           mystl::random_access_iterator_tag>::value, "");
+	static_assert(std::is_same<decltype(mystl::unwrap_iter(int_iter())), int*>::value, "");
+	static_assert(std::is_same<decltype(mystl::unwrap_iter(double_reverse())), int*>::value, "");
+	static_assert(std::is_same<decltype(mystl::unwrap_iter(mystl::make_move_iterator(int_iter()))),
+	                           mystl::move_iterator<int*>>::value, "");
+
+	int a[4] = { 1, 2, 3, 4 };
+	int_iter it(a + 2);
+	EXPECT_TRUE(mystl::unwrap_iter(it) == a + 2);
+	EXPECT_TRUE(mystl::rewrap_iter(int_iter(a), a + 3).p == a + 3);
+}
+
+TEST(iterator_unwrap_algo_test)
+{
+	int a[10], b[10];
+	for (int i = 0; i < 10; ++i)
+		a[i] = i;
+	int_iter r = mystl::copy(int_iter(a), int_iter(a + 10), int_iter(b));
+	EXPECT_TRUE(r.p == b + 10);
+	EXPECT_EQ(b[9], 9);
+
+	// 两侧都是反向迭代器: 等价于正向复制
+	mystl::reverse_iterator<int*> rf(a + 10), rl(a);
+	auto r2 = mystl::copy(rf, rl, mystl::reverse_iterator<int*>(b + 10));
+	EXPECT_TRUE(r2.base() == b);
+	bool ok = true;
+	for (int i = 0; i < 10; ++i)
+		ok = ok && b[i] == i;
+	EXPECT_TRUE(ok);
+	// 只有一侧反向: 逆序
+	mystl::copy(rf, rl, b);
+	for (int i = 0; i < 10; ++i)
+		ok = ok && b[i] == 9 - i;
+	EXPECT_TRUE(ok);
+
+	// 反向的重叠复制, 相当于整体右移两位
+	mystl::copy(mystl::reverse_iterator<int*>(a + 8), mystl::reverse_iterator<int*>(a),
+	            mystl::reverse_iterator<int*>(a + 10));
+	for (int i = 2; i < 10; ++i)
+		ok = ok && a[i] == i - 2;
+	EXPECT_TRUE(ok);
+	for (int i = 0; i < 10; ++i)
+		a[i] = i;
+	mystl::copy_backward(mystl::reverse_iterator<int*>(a + 10), mystl::reverse_iterator<int*>(a + 2),
+	                     mystl::reverse_iterator<int*>(a));
+	for (int i = 0; i < 8; ++i)
+		ok = ok && a[i] == i + 2;
+	EXPECT_TRUE(ok);
+
+	// 非平凡类型走逐个移动
+	std::string s[4] = { "a", "b", "c", "d" }, t[4];
+	mystl::move(mystl::reverse_iterator<std::string*>(s + 4), mystl::reverse_iterator<std::string*>(s),
+	            mystl::reverse_iterator<std::string*>(t + 4));
+	EXPECT_TRUE(t[0] == "a" && t[3] == "d" && s[0].empty());
+
+	// 双重反向解包为指针, 结果还原为双重反向迭代器
+	for (int i = 0; i < 10; ++i)
+		a[i] = i;
+	double_reverse f{ mystl::reverse_iterator<int_iter>(int_iter(a)) };
+	double_reverse l{ mystl::reverse_iterator<int_iter>(int_iter(a + 10)) };
+	double_reverse o{ mystl::reverse_iterator<int_iter>(int_iter(b)) };
+	auto r3 = mystl::copy(f, l, o);
+	EXPECT_TRUE(r3.base().base().p == b + 10);
+	for (int i = 0; i < 10; ++i)
+		ok = ok && b[i] == i;
+	EXPECT_TRUE(ok);
+
+	char c[16];
+	mystl::fill(mystl::reverse_iterator<char*>(c + 16), mystl::reverse_iterator<char*>(c), 'x');
+	EXPECT_TRUE(c[0] == 'x' && c[15] == 'x');
+	mystl::fill(contiguous_iter<char>(c), contiguous_iter<char>(c + 8), 'y');
+	EXPECT_TRUE(c[7] == 'y' && c[8] == 'x');
+	auto e = mystl::fill_n(contiguous_iter<char>(c), 3, 'z');
+	EXPECT_TRUE(e.p == c + 3 && c[2] == 'z');
+
+	int u[10];
+	mystl::uninitialized_copy(int_iter(a), int_iter(a + 10), u);
+	EXPECT_EQ(u[9], 9);
+
+	// 不连续的迭代器不受影响
+	mystl::deque<int> d;
+	for (int i = 0; i < 100; ++i)
+		d.push_back(i);
+	mystl::vector<int> v(100);
+	mystl::copy(d.begin(), d.end(), v.begin());
+	EXPECT_EQ(v[99], 99);
+	mystl::fill(d.begin(), d.end(), 3);
+	EXPECT_EQ(d[50], 3);
+	mystl::vector<int> w(v.rbegin(), v.rend());
+	EXPECT_EQ(w[0], 99);
+
+	int sorted[100];
+	for (int i = 0; i < 100; ++i)
+		sorted[i] = i * 2;
+	EXPECT_TRUE(mystl::lower_bound(int_iter(sorted), int_iter(sorted + 100), 51).p == sorted + 26);
+}
+
+} // namespace iterator_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_ITERATOR_TEST_H_
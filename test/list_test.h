@@ -0,0 +1,451 @@
+#ifndef MYTINYSTL_LIST_TEST_H_
+#define MYTINYSTL_LIST_TEST_H_
+
+// list / forward_list 的测试, 以 std::list / std::forward_list 作为参照, 以及大量增删后的遍历性能
+
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/forward_list.h"
+#include "../src/list.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace list_test
+{
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+// 比较时抛出异常的元素, budget 为 0 时的那次比较抛出
+struct throwing_less_value
+{
+	int value;
+	static int budget;
+
+	explicit throwing_less_value(int v) :value(v) {}
+	bool operator<(const throwing_less_value& rhs) const
+	{
+		if (budget >= 0 && budget-- == 0)
+			throw 1;
+		return value < rhs.value;
+	}
+};
+
+int throwing_less_value::budget = -1;
+#endif // !MYSTL_NO_EXCEPTIONS
+
+// 把两个迭代器前进到同一个随机位置
+template <class L, class S>
+void advance_both(test_rng& rng, L& l, S& s, typename L::iterator& li, typename S::iterator& si)
+{
+	const size_t n = rng.below(s.size() + 1);
+	li = l.begin();
+	si = s.begin();
+	for (size_t k = 0; k < n; ++k, ++li, ++si)
+	{
+	}
+}
+
+TEST(list_random_ops_test)
+{
+	test_rng rng(5);
+	typedef std::string S;
+	bool ok = true;
+	for (int round = 0; round < 20 && ok; ++round)
+	{
+		// b 与 a 共用节点池, c 有自己的节点池
+		mystl::list<S> a, b(a.get_pool()), c;
+		std::list<S> sa, sb, sc;
+		for (int it = 0; it < 2000 && ok; ++it)
+		{
+			const S v = std::to_string(rng.below(100));
+			const bool use_a = rng.below(2) == 0;
+			mystl::list<S>& l = use_a ? a : c;
+			std::list<S>& s = use_a ? sa : sc;
+			mystl::list<S>::iterator li;
+			std::list<S>::iterator si;
+			switch (rng.below(15))
+			{
+			case 0:
+				l.push_back(v);
+				s.push_back(v);
+				break;
+			case 1:
+				l.emplace_front(v);
+				s.push_front(v);
+				break;
+			case 2:
+				if (!s.empty())
+				{
+					l.pop_back();
+					s.pop_back();
+				}
+				break;
+			case 3:
+				if (!s.empty())
+				{
+					l.pop_front();
+					s.pop_front();
+				}
+				break;
+			case 4:
+				advance_both(rng, l, s, li, si);
+				ok = *l.insert(li, v) == *s.insert(si, v);
+				break;
+			case 5:
+				advance_both(rng, l, s, li, si);
+				if (si != s.end())
+				{
+					l.erase(li);
+					s.erase(si);
+				}
+				break;
+			case 6:
+			{
+				advance_both(rng, l, s, li, si);
+				mystl::vector<S> src;
+				for (size_t k = rng.below(10); k > 0; --k)
+					src.push_back(std::to_string(rng.below(100)));
+				auto r = l.insert_range(li, src.begin(), src.end());
+				s.insert(si, src.begin(), src.end());
+				ok = src.empty() ? r == li : *r == src[0];
+				break;
+			}
+			case 7:
+			{
+				advance_both(rng, l, s, li, si);
+				const size_t n = rng.below(5);
+				l.insert(li, n, v);
+				s.insert(si, n, v);
+				break;
+			}
+			case 8:
+				if (rng.below(10) == 0)
+				{
+					l.sort();
+					s.sort();
+				}
+				break;
+			case 9:
+			{
+				// 单个节点从 b 转移过来: a 与 b 共用节点池时只改指针, c 则逐个移动元素
+				b.push_back(v);
+				sb.push_back(v);
+				advance_both(rng, l, s, li, si);
+				l.splice(li, b, --b.end());
+				s.splice(si, sb, --sb.end());
+				break;
+			}
+			case 10:
+				if (rng.below(10) == 0)
+				{
+					for (int k = 0; k < 5; ++k)
+					{
+						b.push_back(std::to_string(k));
+						sb.push_back(std::to_string(k));
+					}
+					advance_both(rng, l, s, li, si);
+					l.splice(li, b);
+					s.splice(si, sb);
+				}
+				break;
+			case 11:
+				if (rng.below(20) == 0)
+				{
+					l.remove(v);
+					s.remove(v);
+					l.unique();
+					s.unique();
+				}
+				break;
+			case 12:
+				if (rng.below(20) == 0)
+				{
+					l.reverse();
+					s.reverse();
+				}
+				break;
+			case 13:
+				if (rng.below(30) == 0)
+				{
+					l.sort();
+					s.sort();
+					mystl::list<S> x = { "1", "5", "9" };
+					std::list<S> sx = { "1", "5", "9" };
+					l.merge(x);
+					s.merge(sx);
+					ok = x.empty();
+				}
+				break;
+			default:
+				if (rng.below(30) == 0)
+				{
+					const size_t n = rng.below(50);
+					l.resize(n, v);
+					s.resize(n, v);
+				}
+				break;
+			}
+			ok = ok && l.size() == s.size() && container_equal(l, s) && container_equal(b, sb);
+		}
+
+		mystl::list<S> d(a);
+		ok = ok && container_equal(d, sa);
+		mystl::list<S> e(mystl::move(d));
+		ok = ok && container_equal(e, sa) && d.empty();
+		d = c;
+		ok = ok && container_equal(d, sc);
+		d = mystl::move(e);
+		d.swap(c);
+		ok = ok && container_equal(d, sc) && container_equal(c, sa);
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(list_sort_test)
+{
+	// sort 是稳定的
+	test_rng rng(6);
+	typedef std::pair<int, int> P;
+	mystl::list<P> l;
+	std::list<P> s;
+	for (int k = 0; k < 1000; ++k)
+	{
+		const P p(static_cast<int>(rng.below(10)), k);
+		l.push_back(p);
+		s.push_back(p);
+	}
+	auto by_first = [](const P& x, const P& y) { return x.first < y.first; };
+	l.sort(by_first);
+	s.sort(by_first);
+	EXPECT_CON_EQ(l, s);
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+	// 比较抛出异常后所有节点仍在链表中, 前后两个方向都能完整遍历
+	mystl::list<throwing_less_value> t;
+	for (int k = 0; k < 1000; ++k)
+		t.push_back(throwing_less_value(static_cast<int>(rng.below(1000))));
+	throwing_less_value::budget = 3000;
+	EXPECT_THROW(t.sort(), int);
+	throwing_less_value::budget = -1;
+	EXPECT_EQ(t.size(), 1000u);
+	EXPECT_EQ(static_cast<size_t>(mystl::distance(t.begin(), t.end())), 1000u);
+	EXPECT_EQ(static_cast<size_t>(mystl::distance(t.rbegin(), t.rend())), 1000u);
+	t.sort();
+	bool sorted = true;
+	for (auto i = t.begin(), j = ++t.begin(); j != t.end(); ++i, ++j)
+		sorted = sorted && !(*j < *i);
+	EXPECT_TRUE(sorted);
+
+	mystl::forward_list<throwing_less_value> ft;
+	for (int k = 0; k < 1000; ++k)
+		ft.push_front(throwing_less_value(static_cast<int>(rng.below(1000))));
+	throwing_less_value::budget = 3000;
+	EXPECT_THROW(ft.sort(), int);
+	throwing_less_value::budget = -1;
+	EXPECT_EQ(static_cast<size_t>(mystl::distance(ft.begin(), ft.end())), 1000u);
+#endif // !MYSTL_NO_EXCEPTIONS
+}
+
+TEST(forward_list_random_ops_test)
+{
+	test_rng rng(7);
+	typedef std::string S;
+	bool ok = true;
+	for (int round = 0; round < 20 && ok; ++round)
+	{
+		mystl::forward_list<S> a;
+		std::forward_list<S> sa;
+		// 奇数轮 b 与 a 共用节点池
+		mystl::forward_list<S> b(round % 2 ? a.get_pool() : mystl::forward_list<S>::pool_type());
+		std::forward_list<S> sb;
+		size_t n = 0;
+		for (int it = 0; it < 2000 && ok; ++it)
+		{
+			const S v = std::to_string(rng.below(100));
+			const size_t p = rng.below(n + 1);
+			auto li = a.before_begin();
+			auto si = sa.before_begin();
+			for (size_t k = 0; k < p; ++k, ++li, ++si)
+			{
+			}
+			switch (rng.below(12))
+			{
+			case 0:
+				a.push_front(v);
+				sa.push_front(v);
+				break;
+			case 1:
+				if (!sa.empty())
+				{
+					a.pop_front();
+					sa.pop_front();
+				}
+				break;
+			case 2:
+				a.insert_after(li, v);
+				sa.insert_after(si, v);
+				break;
+			case 3:
+				if (std::next(si) != sa.end())
+				{
+					a.erase_after(li);
+					sa.erase_after(si);
+				}
+				break;
+			case 4:
+			{
+				mystl::vector<S> src;
+				for (size_t k = rng.below(10); k > 0; --k)
+					src.push_back(std::to_string(rng.below(100)));
+				a.insert_range_after(li, src.begin(), src.end());
+				sa.insert_after(si, src.begin(), src.end());
+				break;
+			}
+			case 5:
+			{
+				const size_t k = rng.below(4);
+				a.insert_after(li, k, v);
+				sa.insert_after(si, k, v);
+				break;
+			}
+			case 6:
+				if (rng.below(10) == 0)
+				{
+					a.sort();
+					sa.sort();
+				}
+				break;
+			case 7:
+				b.push_front(v);
+				sb.push_front(v);
+				a.splice_after(li, b, b.before_begin());
+				sa.splice_after(si, sb, sb.before_begin());
+				break;
+			case 8:
+				if (rng.below(10) == 0)
+				{
+					b.push_front(v + "x");
+					sb.push_front(v + "x");
+					a.splice_after(li, b);
+					sa.splice_after(si, sb);
+				}
+				break;
+			case 9:
+				if (rng.below(20) == 0)
+				{
+					a.remove(v);
+					sa.remove(v);
+					a.unique();
+					sa.unique();
+				}
+				break;
+			case 10:
+				if (rng.below(20) == 0)
+				{
+					a.reverse();
+					sa.reverse();
+				}
+				break;
+			default:
+				if (rng.below(30) == 0)
+				{
+					a.sort();
+					sa.sort();
+					mystl::forward_list<S> x = { "1", "5", "9" };
+					std::forward_list<S> sx = { "1", "5", "9" };
+					a.merge(x);
+					sa.merge(sx);
+					const size_t r = rng.below(40);
+					a.resize(r, v);
+					sa.resize(r, v);
+				}
+				break;
+			}
+			n = static_cast<size_t>(std::distance(sa.begin(), sa.end()));
+			ok = container_equal(a, sa) && container_equal(b, sb);
+		}
+
+		mystl::forward_list<S> d(a);
+		ok = ok && container_equal(d, sa);
+		d = mystl::move(a);
+		ok = ok && container_equal(d, sa);
+		d.assign(5, "q");
+		ok = ok && mystl::distance(d.begin(), d.end()) == 5;
+	}
+	EXPECT_TRUE(ok);
+}
+
+// 反复随机删除和插入之后按顺序遍历: std::list 的节点散落在堆中,
+// mystl::list 的节点集中在节点池的少数几个 slab 中
+inline void list_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t n = 4000000;
+#else
+	const size_t n = 400000;
+#endif
+	perf_header("list iteration after churn");
+	mystl::list<uint64_t> l;
+	std::list<uint64_t> s;
+	// 增删时交错分配一些其他内存, 模拟长期运行的程序
+	std::vector<std::vector<char>> noise;
+	perf_row("push_back",
+	         time_ms([&] { for (size_t i = 0; i < n; ++i) l.push_back(i); }),
+	         time_ms([&] { for (size_t i = 0; i < n; ++i) s.push_back(i); }));
+	auto churn = [&](size_t rounds, size_t seed)
+	{
+		test_rng r(seed);
+		const double a = time_ms([&]
+		{
+			for (size_t k = 0; k < rounds; ++k)
+			{
+				auto it = l.begin();
+				for (size_t step = r.below(64); step > 0; --step)
+					++it;
+				it = l.erase(it);
+				noise.emplace_back(r.below(64) + 1);
+				l.insert(l.begin(), r.next());
+			}
+		});
+		test_rng r2(seed);
+		const double b = time_ms([&]
+		{
+			for (size_t k = 0; k < rounds; ++k)
+			{
+				auto it = s.begin();
+				for (size_t step = r2.below(64); step > 0; --step)
+					++it;
+				it = s.erase(it);
+				noise.emplace_back(r2.below(64) + 1);
+				s.insert(s.begin(), r2.next());
+			}
+		});
+		perf_row("churn erase+insert", a, b);
+	};
+	churn(n, 9);
+	// 把头部的新节点打散到整个链表中
+	l.sort();
+	s.sort();
+	uint64_t sum = 0;
+	perf_row("iterate after churn+sort",
+	         time_ms([&] { for (int r = 0; r < 10; ++r) for (auto x : l) sum += x; }),
+	         time_ms([&] { for (int r = 0; r < 10; ++r) for (auto x : s) sum += x; }));
+	perf_row("clear",
+	         time_ms([&] { l.clear(); }),
+	         time_ms([&] { s.clear(); }));
+	do_not_optimize(sum);
+	perf_footer();
+}
+
+} // namespace list_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_LIST_TEST_H_
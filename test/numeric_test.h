@@ -0,0 +1,213 @@
+#ifndef MYTINYSTL_NUMERIC_TEST_H_
+#define MYTINYSTL_NUMERIC_TEST_H_
+
+// 数值算法的测试: 长度覆盖内核展开与向量宽度的各个余数, 以逐个计算的结果作为参照
+// 以及求和、点积内核与普通循环的比较
+
+#include <cmath>
+#include <cstdint>
+
+#include "../src/list.h"
+#include "../src/numeric.h"
+#include "../src/parallel_algo.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace numeric_test
+{
+
+TEST(numeric_kernel_test)
+{
+	const size_t sizes[] = { 0, 1, 3, 7, 8, 31, 32, 33, 100, 1001, 4097, 100000 };
+	bool ok = true;
+	for (size_t n : sizes)
+	{
+		mystl::vector<int> vi(n);
+		mystl::vector<int64_t> vl(n);
+		mystl::vector<unsigned> vu(n);
+		mystl::vector<float> vf(n);
+		mystl::vector<double> vd(n);
+		// 整数和按无符号计算, 允许回绕
+		unsigned ei = 0, eu = 0;
+		uint64_t el = 0;
+		double ed = 0;
+		float ef = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			vi[i] = static_cast<int>(i * 7 % 1000) - 300;
+			vl[i] = static_cast<int64_t>(i) * 1000003 - 77;
+			vu[i] = static_cast<unsigned>(i * 2654435761u);
+			vf[i] = static_cast<float>(i % 17) * 0.25f;
+			vd[i] = static_cast<double>(i % 13) * 0.5;
+			ei += static_cast<unsigned>(vi[i]);
+			el += static_cast<uint64_t>(vl[i]);
+			eu += vu[i];
+			ed += vd[i];
+			ef += vf[i];
+		}
+		ok = ok && mystl::accumulate(vi.begin(), vi.end(), 5) == static_cast<int>(ei + 5);
+		ok = ok && mystl::reduce(vi.begin(), vi.end()) == static_cast<int>(ei);
+		ok = ok && mystl::reduce(vl.begin(), vl.end(), int64_t(1)) == static_cast<int64_t>(el + 1);
+		ok = ok && mystl::accumulate(vu.begin(), vu.end(), 0u) == eu;
+		// 各项都是 0.5 的倍数, 任意顺序相加都没有舍入
+		ok = ok && mystl::reduce(vd.begin(), vd.end(), 0.0) == ed;
+		ok = ok && std::fabs(mystl::reduce(vf.begin(), vf.end(), 0.0f) - ef) <= 1e-3f * ef + 1e-6f;
+#if !defined(MYSTL_NUMERIC_REASSOCIATE)
+		// accumulate 对浮点数严格从左到右
+		ok = ok && mystl::accumulate(vf.begin(), vf.end(), 0.0f) == ef;
+#endif
+
+		unsigned di = 0;
+		uint64_t dl = 0;
+		double dd = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			di += static_cast<unsigned>(vi[i]) * static_cast<unsigned>(vi[i]);
+			dl += static_cast<uint64_t>(vl[i]) * static_cast<uint64_t>(vl[i]);
+			dd += vd[i] * vd[i];
+		}
+		ok = ok && mystl::inner_product(vi.begin(), vi.end(), vi.begin(), 0) == static_cast<int>(di);
+		ok = ok && mystl::transform_reduce(vi.begin(), vi.end(), vi.begin(), 0) == static_cast<int>(di);
+		ok = ok && mystl::transform_reduce(vd.begin(), vd.end(), vd.begin(), 0.0) == dd;
+		ok = ok && mystl::transform_reduce(vl.begin(), vl.end(), vl.begin(), int64_t(0)) == static_cast<int64_t>(dl);
+
+		// 并行版本
+		const auto par = mystl::execution::par.with_grain(64);
+		ok = ok && mystl::reduce(mystl::execution::par, vi.begin(), vi.end(), 0) == static_cast<int>(ei);
+		ok = ok && mystl::reduce(par, vl.begin(), vl.end()) == static_cast<int64_t>(el);
+		ok = ok && mystl::transform_reduce(par, vi.begin(), vi.end(), vi.begin(), 0) == static_cast<int>(di);
+		ok = ok && mystl::reduce(mystl::execution::seq, vd.begin(), vd.end(), 0.0) == ed;
+
+		mystl::vector<int64_t> ps(n), ps2(n), ad(n);
+		mystl::partial_sum(vl.begin(), vl.end(), ps.begin());
+		mystl::partial_sum(par, vl.begin(), vl.end(), ps2.begin());
+		ok = ok && ps == ps2 && (n == 0 || ps[n - 1] == static_cast<int64_t>(el));
+		mystl::adjacent_difference(ps.begin(), ps.end(), ad.begin());
+		ok = ok && ad == vl;
+		// 原地计算
+		mystl::adjacent_difference(ps.begin(), ps.end(), ps.begin());
+		ok = ok && ps == vl;
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(numeric_misc_test)
+{
+	mystl::list<int> l;
+	for (int i = 0; i < 10; ++i)
+		l.push_back(i);
+	EXPECT_EQ(mystl::accumulate(l.begin(), l.end(), 0), 45);
+	EXPECT_EQ(mystl::reduce(l.begin(), l.end()), 45);
+	EXPECT_EQ(mystl::inner_product(l.begin(), l.end(), l.begin(), 0), 285);
+
+	mystl::vector<int> io(5);
+	mystl::iota(io.begin(), io.end(), 3);
+	EXPECT_EQ(io[0], 3);
+	EXPECT_EQ(io[4], 7);
+	EXPECT_EQ(mystl::accumulate(io.begin(), io.end(), 1, [](int a, int b) { return a * b; }), 3 * 4 * 5 * 6 * 7);
+	EXPECT_EQ(mystl::transform_reduce(io.begin(), io.end(), 0, [](int a, int b) { return a + b; },
+	                                  [](int x) { return x * x; }), 9 + 16 + 25 + 36 + 49);
+
+	// 初值类型与元素类型不同时不走内核, 按初值类型累加
+	mystl::vector<int> big(1000, 0x7fffffff);
+	EXPECT_EQ(mystl::accumulate(big.begin(), big.end(), 0LL), 1000LL * 0x7fffffff);
+	mystl::vector<double> half(3, 0.5);
+	EXPECT_EQ(mystl::accumulate(half.begin(), half.end(), 0), 0);
+
+	mystl::vector<int> ps(5), pd(5);
+	mystl::partial_sum(io.begin(), io.end(), ps.begin(), [](int a, int b) { return a * b; });
+	EXPECT_EQ(ps[4], 2520);
+	mystl::adjacent_difference(ps.begin(), ps.end(), pd.begin(), [](int a, int b) { return a / b; });
+	EXPECT_CON_EQ(pd, io);
+}
+
+// 求和与点积: 普通循环对浮点数只能逐个相加, 内核使用多个累加器
+inline void numeric_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t n = 1u << 25;
+#else
+	const size_t n = 1u << 22;
+#endif
+	mystl::vector<float> f(n);
+	mystl::vector<double> d(n);
+	mystl::vector<int> ii(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		f[i] = static_cast<float>(i & 255) * 0.5f;
+		d[i] = f[i];
+		ii[i] = static_cast<int>(i & 1023);
+	}
+	float sf = 0;
+	double sd = 0;
+	int si = 0;
+	perf_header("numeric kernels, 20 passes", "mystl", "loop");
+	perf_row("reduce float", time_ms([&] { for (int k = 0; k < 20; ++k) sf += mystl::reduce(f.begin(), f.end(), 0.0f); }),
+	         time_ms([&]
+	{
+		for (int k = 0; k < 20; ++k)
+		{
+			float s = 0;
+			for (float x : f)
+				s += x;
+			sf += s;
+		}
+	}));
+	perf_row("transform_reduce double",
+	         time_ms([&] { for (int k = 0; k < 20; ++k) sd += mystl::transform_reduce(d.begin(), d.end(), d.begin(), 0.0); }),
+	         time_ms([&]
+	{
+		for (int k = 0; k < 20; ++k)
+		{
+			double s = 0;
+			for (size_t i = 0; i < n; ++i)
+				s += d[i] * d[i];
+			sd += s;
+		}
+	}));
+	perf_row("transform_reduce double par",
+	         time_ms([&]
+	{
+		for (int k = 0; k < 20; ++k)
+			sd += mystl::transform_reduce(mystl::execution::par, d.begin(), d.end(), d.begin(), 0.0);
+	}),
+	         time_ms([&]
+	{
+		for (int k = 0; k < 20; ++k)
+		{
+			double s = 0;
+			for (size_t i = 0; i < n; ++i)
+				s += d[i] * d[i];
+			sd += s;
+		}
+	}));
+	perf_row("accumulate int", time_ms([&] { for (int k = 0; k < 20; ++k) si += mystl::accumulate(ii.begin(), ii.end(), 0); }),
+	         time_ms([&]
+	{
+		for (int k = 0; k < 20; ++k)
+		{
+			int s = 0;
+			for (int x : ii)
+				s += x;
+			si += s;
+		}
+	}));
+	mystl::vector<int64_t> src(d.begin(), d.end()), out(n);
+	perf_row("partial_sum int64 par",
+	         time_ms([&] { for (int k = 0; k < 20; ++k) mystl::partial_sum(mystl::execution::par, src.begin(), src.end(), out.begin()); }),
+	         time_ms([&] { for (int k = 0; k < 20; ++k) mystl::partial_sum(src.begin(), src.end(), out.begin()); }));
+	do_not_optimize(sf);
+	do_not_optimize(sd);
+	do_not_optimize(si);
+	do_not_optimize(out);
+	perf_footer();
+}
+
+} // namespace numeric_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_NUMERIC_TEST_H_
@@ -0,0 +1,164 @@
+#ifndef MYTINYSTL_PACKED_VECTOR_TEST_H_
+#define MYTINYSTL_PACKED_VECTOR_TEST_H_
+
+// packed_vector / sorted_packed_vector 的测试, 以 std::vector 作为参照
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/packed_vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace packed_vector_test
+{
+
+// 随机写入、批量解码、resize 与 pop_back, 各种位宽下与 std::vector 比较
+template <unsigned Bits>
+bool packed_vector_ok(test_rng& rng)
+{
+	typedef mystl::packed_vector<Bits> pv;
+	typedef typename pv::value_type value_type;
+	for (int it = 0; it < 20; ++it)
+	{
+		pv p;
+		std::vector<value_type> r;
+		const size_t n = rng.below(3000);
+		for (size_t i = 0; i < n; ++i)
+		{
+			const value_type v = static_cast<value_type>(rng.next() & pv::kMaxValue);
+			p.push_back(v);
+			r.push_back(v);
+		}
+		for (int k = 0; k < 200 && n != 0; ++k)
+		{
+			const size_t i = rng.below(n);
+			const value_type v = static_cast<value_type>(rng.next() & pv::kMaxValue);
+			if (k % 2)
+				p[i] = v;
+			else
+				p.set(i, v);
+			r[i] = v;
+		}
+		if (p.size() != r.size() || !std::equal(p.begin(), p.end(), r.begin()))
+			return false;
+
+		// 解码任意一段, 不能写出界
+		for (int k = 0; k < 20; ++k)
+		{
+			const size_t f = rng.below(n + 1);
+			const size_t c = rng.below(n - f + 1);
+			std::vector<value_type> out(c + 1, 7);
+			p.decode(f, c, out.data());
+			if (!std::equal(out.begin(), out.begin() + c, r.begin() + f) || out[c] != 7)
+				return false;
+		}
+
+		const size_t m = rng.below(3000);
+		const value_type v = static_cast<value_type>(rng.next() & pv::kMaxValue);
+		pv q = p;
+		q.resize(m, v);
+		r.resize(m, v);
+		while (!q.empty() && q.size() > m / 2)
+		{
+			q.pop_back();
+			r.pop_back();
+		}
+		pv q2;
+		for (auto x : r)
+			q2.push_back(x);
+		if (!(q == q2) || !std::equal(q.begin(), q.end(), r.begin()))
+			return false;
+	}
+	return true;
+}
+
+TEST(packed_vector_test)
+{
+	test_rng rng(18);
+	EXPECT_TRUE(packed_vector_ok<1>(rng));
+	EXPECT_TRUE(packed_vector_ok<3>(rng));
+	EXPECT_TRUE(packed_vector_ok<7>(rng));
+	EXPECT_TRUE(packed_vector_ok<8>(rng));
+	EXPECT_TRUE(packed_vector_ok<13>(rng));
+	EXPECT_TRUE(packed_vector_ok<20>(rng));
+	EXPECT_TRUE(packed_vector_ok<24>(rng));
+	EXPECT_TRUE(packed_vector_ok<25>(rng));
+	EXPECT_TRUE(packed_vector_ok<31>(rng));
+	EXPECT_TRUE(packed_vector_ok<32>(rng));
+	EXPECT_TRUE(packed_vector_ok<33>(rng));
+	EXPECT_TRUE(packed_vector_ok<57>(rng));
+	EXPECT_TRUE(packed_vector_ok<64>(rng));
+
+	// 20 位的元素只占 32 位的 5/8
+	mystl::packed_vector<20> p;
+	for (uint32_t i = 0; i < 6400; ++i)
+		p.push_back(i);
+	EXPECT_EQ(p.num_words(), 6400u * 20 / 64);
+	EXPECT_EQ(p.at(6399), 6399u);
+	EXPECT_THROW(p.at(6400), std::out_of_range);
+}
+
+TEST(sorted_packed_vector_test)
+{
+	test_rng rng(19);
+	bool ok = true;
+	for (int it = 0; it < 30 && ok; ++it)
+	{
+		// 间隔全为 0、很小、很大三种情形
+		mystl::sorted_packed_vector<uint64_t> s;
+		std::vector<uint64_t> r;
+		const size_t n = rng.below(5000);
+		uint64_t x = rng.below(1000);
+		for (size_t i = 0; i < n; ++i)
+		{
+			x += it % 3 == 0 ? 0 : it % 3 == 1 ? rng.below(16) : (rng.next() >> 40);
+			s.push_back(x);
+			r.push_back(x);
+		}
+		for (size_t i = 0; i < n && ok; ++i)
+			ok = s[i] == r[i];
+		for (int k = 0; k < 50 && ok; ++k)
+		{
+			const size_t f = rng.below(n + 1);
+			const size_t c = rng.below(n - f + 1);
+			std::vector<uint64_t> out(c);
+			s.decode(f, c, out.data());
+			ok = std::equal(out.begin(), out.end(), r.begin() + f);
+		}
+		for (int k = 0; k < 200 && ok; ++k)
+		{
+			const uint64_t q = n != 0 ? r[rng.below(n)] + rng.below(3) - 1 : 5;
+			ok = s.lower_bound(q) == static_cast<size_t>(std::lower_bound(r.begin(), r.end(), q) - r.begin());
+		}
+		const size_t m = n / 2;
+		while (ok && s.size() > m)
+		{
+			s.pop_back();
+			r.pop_back();
+			ok = s.empty() || s.back() == r.back();
+		}
+		for (int i = 0; i < 300; ++i)
+		{
+			x += 3;
+			s.push_back(x);
+			r.push_back(x);
+		}
+		for (size_t i = 0; i < r.size() && ok; ++i)
+			ok = s[i] == r[i];
+	}
+	EXPECT_TRUE(ok);
+
+	mystl::sorted_packed_vector<uint32_t> s32 = { 1, 2, 3 };
+	EXPECT_TRUE(s32.contains(2));
+	EXPECT_FALSE(s32.contains(4));
+}
+
+} // namespace packed_vector_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_PACKED_VECTOR_TEST_H_
@@ -0,0 +1,210 @@
+#ifndef MYTINYSTL_RANGES_TEST_H_
+#define MYTINYSTL_RANGES_TEST_H_
+
+// 视图与范围适配器的测试, 以及一条流水线与逐步生成临时 vector 的比较
+
+#include <type_traits>
+
+#include "../src/basic_string.h"
+#include "../src/list.h"
+#include "../src/ranges.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace ranges_test
+{
+
+struct point
+{
+	int x;
+	int y;
+};
+
+TEST(ranges_basic_test)
+{
+	mystl::vector<int> v;
+	for (int i = 0; i < 20; ++i)
+		v.push_back(i);
+	auto r = v | views::filter([](int x) { return x % 2 == 0; }) | views::transform([](int x) { return x * 10; });
+	auto out = r | ranges::to<mystl::vector>();
+	EXPECT_EQ(out.size(), 10u);
+	EXPECT_EQ(out[3], 60);
+	auto out2 = ranges::to<mystl::vector<long>>(v | views::take(5));
+	EXPECT_EQ(out2.size(), 5u);
+	EXPECT_EQ(out2[4], 4);
+
+	// transform 保持随机访问与大小
+	auto tv = v | views::transform([](int x) { return x + 1; });
+	EXPECT_EQ(tv.size(), 20u);
+	EXPECT_EQ(tv.end() - tv.begin(), 20);
+	EXPECT_EQ(tv.begin()[3], 4);
+	EXPECT_EQ((v | views::take(100)).size(), 20u);
+	auto dr = v | views::drop(15);
+	EXPECT_EQ(dr.size(), 5u);
+	EXPECT_EQ(*dr.begin(), 15);
+	EXPECT_TRUE((v | views::drop(50)).empty());
+
+	// 双向迭代器上的 take / stride
+	mystl::list<int> l;
+	for (int i = 0; i < 10; ++i)
+		l.push_back(i);
+	int s = 0;
+	auto lt = l | views::take(3);
+	for (int x : lt)
+		s += x;
+	EXPECT_EQ(s, 3);
+	EXPECT_EQ(lt.size(), 3u);
+	s = 0;
+	for (int x : l | views::take(30))
+		s += x;
+	EXPECT_EQ(s, 45);
+	EXPECT_EQ(ranges::size(l | views::stride(3)), 4u);
+	s = 0;
+	for (int x : l | views::stride(3))
+		s += x;
+	EXPECT_EQ(s, 0 + 3 + 6 + 9);
+	s = 0;
+	for (int x : v | views::stride(7))
+		s += x;
+	EXPECT_EQ(s, 0 + 7 + 14);
+
+	int arr[] = { 5, 6, 7 };
+	s = 0;
+	for (int x : arr | views::drop(1))
+		s += x;
+	EXPECT_EQ(s, 13);
+
+	// 右值范围被视图持有
+	auto ow = mystl::vector<int>(10, 3) | views::transform([](int x) { return x * 2; });
+	s = 0;
+	for (int x : ow)
+		s += x;
+	EXPECT_EQ(s, 60);
+
+	mystl::vector<point> ps;
+	ps.push_back(point{ 1, 2 });
+	ps.push_back(point{ 3, 4 });
+	auto ys = ps | views::transform(&point::y) | ranges::to<mystl::vector>();
+	EXPECT_EQ(ys[1], 4);
+
+	mystl::string str("hello world");
+	auto up = str | views::transform([](char c)
+	{
+		return static_cast<char>(c >= 'a' && c <= 'z' ? c - 32 : c);
+	}) | ranges::to<mystl::string>();
+	EXPECT_TRUE(up == "HELLO WORLD");
+}
+
+TEST(ranges_zip_chunk_join_test)
+{
+	mystl::vector<int> v;
+	for (int i = 0; i < 20; ++i)
+		v.push_back(i);
+	mystl::vector<double> d;
+	for (int i = 0; i < 5; ++i)
+		d.push_back(i * 0.5);
+
+	// zip 的长度取较短者, 元素是引用
+	auto z = views::zip(v, d);
+	EXPECT_EQ(z.size(), 5u);
+	for (auto p : z)
+		p.first += 100;
+	EXPECT_TRUE(v[0] == 100 && v[4] == 104 && v[5] == 5);
+	auto zv = z | ranges::to<mystl::vector>();
+	static_assert(std::is_same<decltype(zv), mystl::vector<mystl::pair<int, double>>>::value, "");
+	EXPECT_EQ(zv[1].first, 101);
+	EXPECT_EQ(zv[1].second, 0.5);
+
+	bool ok = true;
+	for (auto p : v | views::enumerate)
+		ok = ok && p.second == (p.first < 5 ? static_cast<int>(p.first) + 100 : static_cast<int>(p.first));
+	EXPECT_TRUE(ok);
+
+	auto ch = v | views::chunk(6);
+	EXPECT_EQ(ch.size(), 4u);
+	size_t n = 0;
+	for (auto c : ch)
+		n += c.size();
+	EXPECT_EQ(n, 20u);
+	auto flat = ch | views::join | ranges::to<mystl::vector>();
+	EXPECT_EQ(flat.size(), 20u);
+	EXPECT_EQ(flat[7], 7);
+
+	// join 跳过空的内层范围, 并能写入
+	mystl::vector<mystl::vector<int>> vv(3);
+	vv[0].push_back(1);
+	vv[2].push_back(2);
+	vv[2].push_back(3);
+	auto jf = vv | views::join | ranges::to<mystl::vector>();
+	EXPECT_EQ(jf.size(), 3u);
+	EXPECT_EQ(jf[2], 3);
+	for (int& x : vv | views::join)
+		x *= 2;
+	EXPECT_EQ(vv[2][1], 6);
+
+	// 内层范围是临时对象
+	auto jt = v | views::take(3) | views::transform([](int x)
+	{
+		return views::take(mystl::vector<int>(static_cast<size_t>(x % 100 + 1), 7), 2);
+	}) | views::join | ranges::to<mystl::vector>();
+	EXPECT_EQ(jt.size(), 5u);
+
+	// 适配器可以先组合再使用
+	auto pipe = views::filter([](int x) { return x > 100; }) | views::transform([](int x) { return x - 100; }) |
+		views::take(2);
+	auto cp = v | pipe | ranges::to<mystl::list>();
+	EXPECT_EQ(cp.size(), 2u);
+	EXPECT_EQ(cp.front(), 1);
+}
+
+// filter -> transform -> take: 每一步生成一个临时 vector, 与一条视图流水线比较
+inline void ranges_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const int n = 40000000;
+#else
+	const int n = 4000000;
+#endif
+	mystl::vector<int> big;
+	for (int i = 0; i < n; ++i)
+		big.push_back(i);
+	long long acc = 0;
+	perf_header("filter | transform | take", "views", "temporaries");
+	const double fused = time_ms([&]
+	{
+		for (int k = 0; k < 10; ++k)
+		{
+			auto c = big | views::filter([](int x) { return x % 3 == 0; }) |
+				views::transform([](int x) { return x * 2; }) | views::take(n / 4) | ranges::to<mystl::vector>();
+			acc += c.back();
+		}
+	});
+	const double temps = time_ms([&]
+	{
+		for (int k = 0; k < 10; ++k)
+		{
+			mystl::vector<int> a;
+			for (int x : big)
+				if (x % 3 == 0)
+					a.push_back(x);
+			mystl::vector<int> b;
+			b.reserve(a.size());
+			for (int x : a)
+				b.push_back(x * 2);
+			mystl::vector<int> c(b.begin(), b.begin() + (b.size() < static_cast<size_t>(n / 4) ? b.size() : n / 4));
+			acc += c.back();
+		}
+	});
+	perf_row("10 passes", fused, temps);
+	do_not_optimize(acc);
+	perf_footer();
+}
+
+} // namespace ranges_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_RANGES_TEST_H_
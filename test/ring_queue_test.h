@@ -0,0 +1,360 @@
+#ifndef MYTINYSTL_RING_QUEUE_TEST_H_
+#define MYTINYSTL_RING_QUEUE_TEST_H_
+
+// spsc_ring / mpmc_queue 的测试: 单线程语义、多线程压力测试, 以及与加锁队列比较的吞吐量和往返延迟
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/ring_queue.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace ring_queue_test
+{
+
+// 作为参照的加锁队列
+template <class T>
+class locked_queue
+{
+	std::mutex    mutex_;
+	std::deque<T> queue_;
+	size_t        capacity_;
+
+public:
+	explicit locked_queue(size_t capacity) :capacity_(capacity) {}
+
+	bool try_push(const T& value)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (queue_.size() == capacity_)
+			return false;
+		queue_.push_back(value);
+		return true;
+	}
+
+	bool try_pop(T& out)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (queue_.empty())
+			return false;
+		out = queue_.front();
+		queue_.pop_front();
+		return true;
+	}
+};
+
+TEST(spsc_ring_basic_test)
+{
+	mystl::spsc_ring<std::string> r(5);
+	EXPECT_EQ(r.capacity(), 8u);
+	EXPECT_TRUE(r.empty());
+	bool ok = true;
+	for (int i = 0; i < 8; ++i)
+		ok = ok && r.try_push(std::to_string(i));
+	EXPECT_TRUE(ok);
+	EXPECT_FALSE(r.try_push("x"));
+	EXPECT_EQ(r.size(), 8u);
+
+	std::string s;
+	EXPECT_TRUE(r.try_pop(s));
+	EXPECT_EQ(s, "0");
+	EXPECT_EQ(*r.front(), "1");
+	r.pop();
+	std::string out[10];
+	EXPECT_EQ(r.pop_n(out, 10), 6u);
+	EXPECT_EQ(out[5], "7");
+	EXPECT_TRUE(r.empty());
+	EXPECT_TRUE(r.front() == nullptr);
+	EXPECT_FALSE(r.try_pop(s));
+
+	// 批量写入只写入放得下的部分, 析构时销毁剩下的元素
+	std::string in[10] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" };
+	EXPECT_EQ(r.push_n(in, 10), 8u);
+	EXPECT_TRUE(r.try_emplace(0, 'z') == false);
+	EXPECT_TRUE(r.try_pop(s));
+	EXPECT_EQ(s, "a");
+	EXPECT_TRUE(r.try_emplace(3, 'z'));
+}
+
+TEST(mpmc_queue_basic_test)
+{
+	mystl::mpmc_queue<std::string> q(3);
+	EXPECT_EQ(q.capacity(), 4u);
+	EXPECT_TRUE(q.try_emplace(3, 'a'));
+	std::string s;
+	EXPECT_TRUE(q.try_pop(s));
+	EXPECT_EQ(s, "aaa");
+	EXPECT_FALSE(q.try_pop(s));
+	bool ok = true;
+	for (int i = 0; i < 4; ++i)
+		ok = ok && q.try_push(std::to_string(i));
+	EXPECT_TRUE(ok);
+	EXPECT_FALSE(q.try_push("full"));
+	EXPECT_EQ(q.size(), 4u);
+	// 环绕多圈后仍保持先进先出
+	for (int i = 4; i < 100 && ok; ++i)
+		ok = q.try_pop(s) && s == std::to_string(i - 4) && q.try_push(std::to_string(i));
+	EXPECT_TRUE(ok);
+}
+
+TEST(spsc_ring_stress_test)
+{
+	const uint64_t n = 2000000;
+	mystl::spsc_ring<uint64_t> r(256);
+	std::thread producer([&]
+	{
+		uint64_t buf[32];
+		for (uint64_t i = 0; i < n;)
+		{
+			uint64_t k = 0;
+			for (; k < 32 && i + k < n; ++k)
+				buf[k] = i + k;
+			// 单个与批量交替写入
+			if (k == 1 || i % 3 == 0)
+			{
+				while (!r.try_push(buf[0]))
+					std::this_thread::yield();
+				++i;
+				continue;
+			}
+			for (uint64_t done = 0; done < k;)
+			{
+				const size_t m = r.push_n(buf + done, static_cast<size_t>(k - done));
+				if (m == 0)
+					std::this_thread::yield();
+				done += m;
+			}
+			i += k;
+		}
+	});
+	bool in_order = true;
+	uint64_t expect = 0;
+	while (expect < n)
+	{
+		uint64_t buf[64];
+		const size_t got = expect % 2 ? r.pop_n(buf, 64) : (r.try_pop(buf[0]) ? 1 : 0);
+		for (size_t j = 0; j < got; ++j)
+			in_order = in_order && buf[j] == expect++;
+		if (got == 0)
+			std::this_thread::yield();
+	}
+	producer.join();
+	EXPECT_TRUE(in_order);
+	EXPECT_TRUE(r.empty());
+}
+
+// P 个生产者与 C 个消费者, 每个元素恰好被取出一次, 且来自同一个生产者的元素按顺序取出
+inline bool mpmc_stress_ok(unsigned producers, unsigned consumers, uint64_t per_producer)
+{
+	mystl::mpmc_queue<uint64_t> q(64);
+	const uint64_t total = per_producer * producers;
+	std::atomic<uint64_t> popped(0);
+	std::atomic<uint64_t> sum(0);
+	std::atomic<bool> ok(true);
+	std::vector<std::thread> threads;
+	for (unsigned p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&, p]
+		{
+			for (uint64_t i = 0; i < per_producer; ++i)
+			{
+				// 高位记录生产者编号, 低位记录序号
+				while (!q.try_push((static_cast<uint64_t>(p) << 40) | i))
+					std::this_thread::yield();
+			}
+		});
+	}
+	for (unsigned c = 0; c < consumers; ++c)
+	{
+		threads.emplace_back([&]
+		{
+			std::vector<uint64_t> last(producers, 0);
+			std::vector<bool> seen(producers, false);
+			uint64_t local = 0;
+			while (popped.load(std::memory_order_relaxed) < total)
+			{
+				uint64_t v;
+				if (!q.try_pop(v))
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				popped.fetch_add(1, std::memory_order_relaxed);
+				const size_t p = static_cast<size_t>(v >> 40);
+				const uint64_t i = v & ((uint64_t(1) << 40) - 1);
+				if (p >= producers || (seen[p] && i <= last[p]))
+					ok = false;
+				else
+				{
+					seen[p] = true;
+					last[p] = i;
+				}
+				local += i;
+			}
+			sum += local;
+		});
+	}
+	for (auto& t : threads)
+		t.join();
+	return ok && popped == total && sum == producers * (per_producer * (per_producer - 1) / 2) && q.empty();
+}
+
+TEST(mpmc_queue_stress_test)
+{
+	for (unsigned p : { 1u, 2u, 4u })
+		for (unsigned c : { 1u, 2u, 4u })
+			EXPECT_TRUE(mpmc_stress_ok(p, c, 200000 / p));
+}
+
+// 一个生产者与一个消费者传递 messages 个消息的耗时
+template <class Queue>
+double spsc_throughput_ms(Queue& q, uint64_t messages)
+{
+	return time_ms([&]
+	{
+		std::thread producer([&]
+		{
+			for (uint64_t i = 0; i < messages; ++i)
+				while (!q.try_push(i))
+					std::this_thread::yield();
+		});
+		uint64_t v = 0, sum = 0;
+		for (uint64_t got = 0; got < messages;)
+		{
+			if (q.try_pop(v))
+			{
+				sum += v;
+				++got;
+			}
+			else
+				std::this_thread::yield();
+		}
+		producer.join();
+		do_not_optimize(sum);
+	});
+}
+
+// producers 个生产者与 consumers 个消费者传递约 messages 个消息的耗时
+template <class Queue>
+double mpmc_throughput_ms(Queue& q, unsigned producers, unsigned consumers, uint64_t messages)
+{
+	const uint64_t per = messages / producers;
+	return time_ms([&]
+	{
+		std::atomic<uint64_t> popped(0);
+		std::vector<std::thread> threads;
+		for (unsigned p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&]
+			{
+				for (uint64_t i = 0; i < per; ++i)
+					while (!q.try_push(i))
+						std::this_thread::yield();
+			});
+		}
+		for (unsigned c = 0; c < consumers; ++c)
+		{
+			threads.emplace_back([&]
+			{
+				uint64_t v = 0, sum = 0;
+				while (popped.load(std::memory_order_relaxed) < per * producers)
+				{
+					if (q.try_pop(v))
+					{
+						sum += v;
+						popped.fetch_add(1, std::memory_order_relaxed);
+					}
+					else
+						std::this_thread::yield();
+				}
+				do_not_optimize(sum);
+			});
+		}
+		for (auto& t : threads)
+			t.join();
+	});
+}
+
+// 两个线程通过一对队列来回传递一个值 round_trips 次的耗时
+template <class Queue>
+double round_trip_ms(Queue& there, Queue& back, uint64_t round_trips)
+{
+	return time_ms([&]
+	{
+		std::thread echo([&]
+		{
+			uint64_t v = 0;
+			for (uint64_t i = 0; i < round_trips; ++i)
+			{
+				while (!there.try_pop(v))
+					std::this_thread::yield();
+				while (!back.try_push(v + 1))
+					std::this_thread::yield();
+			}
+		});
+		uint64_t v = 0;
+		for (uint64_t i = 0; i < round_trips; ++i)
+		{
+			while (!there.try_push(v))
+				std::this_thread::yield();
+			while (!back.try_pop(v))
+				std::this_thread::yield();
+		}
+		echo.join();
+		do_not_optimize(v);
+	});
+}
+
+// 不同生产者与消费者个数下的吞吐量, 以及往返延迟, 对比加锁的 std::deque
+inline void ring_queue_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const uint64_t messages = 20000000;
+	const uint64_t round_trips = 1000000;
+#else
+	const uint64_t messages = 2000000;
+	const uint64_t round_trips = 100000;
+#endif
+	perf_header("ring queues (same message count)", "mystl", "mutex+deque");
+	{
+		mystl::spsc_ring<uint64_t> r(1024);
+		locked_queue<uint64_t> l(1024);
+		const double a = spsc_throughput_ms(r, messages);
+		perf_row("spsc_ring P=1 C=1", a, spsc_throughput_ms(l, messages));
+	}
+	for (unsigned producers : { 1u, 2u, 4u })
+	{
+		for (unsigned consumers : { 1u, 2u, 4u })
+		{
+			mystl::mpmc_queue<uint64_t> m(1024);
+			locked_queue<uint64_t> l(1024);
+			const double a = mpmc_throughput_ms(m, producers, consumers, messages);
+			perf_row("mpmc_queue P=" + std::to_string(producers) + " C=" + std::to_string(consumers),
+			         a, mpmc_throughput_ms(l, producers, consumers, messages));
+		}
+	}
+	{
+		mystl::spsc_ring<uint64_t> s1(16), s2(16);
+		locked_queue<uint64_t> l1(16), l2(16);
+		const double a = round_trip_ms(s1, s2, round_trips);
+		perf_row("spsc round trips", a, round_trip_ms(l1, l2, round_trips));
+		mystl::mpmc_queue<uint64_t> m1(16), m2(16);
+		locked_queue<uint64_t> l3(16), l4(16);
+		const double b = round_trip_ms(m1, m2, round_trips);
+		perf_row("mpmc round trips", b, round_trip_ms(l3, l4, round_trips));
+	}
+	perf_footer();
+}
+
+} // namespace ring_queue_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_RING_QUEUE_TEST_H_
@@ -0,0 +1,231 @@
+#ifndef MYTINYSTL_SEARCH_TEST_H_
+#define MYTINYSTL_SEARCH_TEST_H_
+
+// 二分查找族与静态查找结构(eytzinger_index / static_bplus_tree)的测试
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../src/algo.h"
+#include "../src/list.h"
+#include "../src/static_search.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace search_test
+{
+
+// 含有大量重复元素的有序序列
+template <class T>
+std::vector<T> sorted_values(size_t n, uint64_t seed, size_t range)
+{
+	test_rng rng(seed);
+	std::vector<T> v(n);
+	for (auto& x : v)
+		x = static_cast<T>(rng.below(range));
+	std::sort(v.begin(), v.end());
+	return v;
+}
+
+// 结构返回的位置与 std::lower_bound / upper_bound 求出的下标一致
+template <class Index, class T>
+bool same_bounds(const Index& index, const std::vector<T>& v, const T& x)
+{
+	const size_t lo = static_cast<size_t>(std::lower_bound(v.begin(), v.end(), x) - v.begin());
+	const size_t hi = static_cast<size_t>(std::upper_bound(v.begin(), v.end(), x) - v.begin());
+	auto l = index.lower_bound(x);
+	auto u = index.upper_bound(x);
+	const bool lower_ok = lo == v.size() ? l == nullptr : (l != nullptr && *l == v[lo]);
+	const bool upper_ok = hi == v.size() ? u == nullptr : (u != nullptr && *u == v[hi]);
+	return lower_ok && upper_ok && index.contains(x) == (lo != hi);
+}
+
+template <class T>
+bool same_bplus_bounds(const mystl::static_bplus_tree<T>& tree, const std::vector<T>& v, const T& x)
+{
+	const auto lo = std::lower_bound(v.begin(), v.end(), x) - v.begin();
+	const auto hi = std::upper_bound(v.begin(), v.end(), x) - v.begin();
+	return tree.lower_bound(x) - tree.begin() == lo && tree.upper_bound(x) - tree.begin() == hi &&
+		tree.contains(x) == (lo != hi);
+}
+
+TEST(binary_search_family_test)
+{
+	for (size_t n : { 0u, 1u, 2u, 3u, 16u, 17u, 1000u, 4097u })
+	{
+		auto v = sorted_values<int>(n, n + 3, n / 2 + 1);
+		mystl::vector<int> a(v.data(), v.data() + v.size());
+		mystl::list<int> l(v.data(), v.data() + v.size());
+		bool ok = true;
+		for (int x = -1; x <= static_cast<int>(n / 2) + 1; ++x)
+		{
+			const auto lo = std::lower_bound(v.begin(), v.end(), x) - v.begin();
+			const auto hi = std::upper_bound(v.begin(), v.end(), x) - v.begin();
+			ok = ok && mystl::lower_bound(a.begin(), a.end(), x) - a.begin() == lo;
+			ok = ok && mystl::upper_bound(a.begin(), a.end(), x) - a.begin() == hi;
+			auto r = mystl::equal_range(a.begin(), a.end(), x);
+			ok = ok && r.first - a.begin() == lo && r.second - a.begin() == hi;
+			ok = ok && mystl::binary_search(a.begin(), a.end(), x) == (lo != hi);
+			// 前向迭代器走经典版本
+			ok = ok && mystl::distance(l.begin(), mystl::lower_bound(l.begin(), l.end(), x)) == lo;
+			ok = ok && mystl::distance(l.begin(), mystl::upper_bound(l.begin(), l.end(), x)) == hi;
+		}
+		EXPECT_TRUE(ok);
+	}
+
+	// 自定义比较: 降序
+	std::vector<int> d = { 9, 7, 7, 5, 3, 3, 3, 1 };
+	for (int x = 0; x <= 10; ++x)
+	{
+		EXPECT_EQ(mystl::lower_bound(d.data(), d.data() + d.size(), x, std::greater<int>()) - d.data(),
+		          std::lower_bound(d.begin(), d.end(), x, std::greater<int>()) - d.begin());
+		EXPECT_EQ(mystl::upper_bound(d.data(), d.data() + d.size(), x, std::greater<int>()) - d.data(),
+		          std::upper_bound(d.begin(), d.end(), x, std::greater<int>()) - d.begin());
+		EXPECT_EQ(mystl::binary_search(d.data(), d.data() + d.size(), x, std::greater<int>()),
+		          std::binary_search(d.begin(), d.end(), x, std::greater<int>()));
+	}
+}
+
+TEST(eytzinger_index_test)
+{
+	mystl::eytzinger_index<int> empty;
+	EXPECT_TRUE(empty.empty());
+	EXPECT_TRUE(empty.lower_bound(3) == nullptr);
+	EXPECT_FALSE(empty.contains(3));
+
+	for (size_t n : { 1u, 2u, 7u, 8u, 15u, 16u, 100u, 1023u, 1024u, 1025u, 50000u })
+	{
+		auto v = sorted_values<int>(n, n, n);
+		mystl::eytzinger_index<int> index(v.data(), v.data() + v.size());
+		EXPECT_EQ(index.size(), n);
+		bool ok = true;
+		for (int x = -2; x <= static_cast<int>(n) + 2; x += n > 2000 ? 7 : 1)
+			ok = ok && same_bounds(index, v, x);
+		EXPECT_TRUE(ok);
+	}
+
+	auto s = sorted_values<unsigned>(3000, 9, 100000);
+	std::vector<std::string> words;
+	for (auto x : s)
+		words.push_back(std::to_string(x));
+	std::sort(words.begin(), words.end());
+	mystl::eytzinger_index<std::string> word_index(words.data(), words.data() + words.size());
+	mystl::eytzinger_index<std::string> copy(word_index);
+	bool ok = true;
+	for (size_t i = 0; i < words.size(); i += 13)
+	{
+		ok = ok && same_bounds(copy, words, words[i]);
+		ok = ok && same_bounds(copy, words, words[i] + "5");
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(static_bplus_tree_test)
+{
+	mystl::static_bplus_tree<int> empty;
+	EXPECT_TRUE(empty.lower_bound(1) == empty.end());
+	EXPECT_FALSE(empty.contains(1));
+
+	// 覆盖 1 层到 4 层, 以及节点未填满的情况
+	for (size_t n : { 1u, 15u, 16u, 17u, 272u, 273u, 289u, 4913u, 5000u, 83521u, 100000u })
+	{
+		auto v = sorted_values<int>(n, n + 1, n);
+		mystl::static_bplus_tree<int> tree(v.data(), v.data() + v.size());
+		EXPECT_EQ(tree.size(), n);
+		EXPECT_TRUE(std::equal(tree.begin(), tree.end(), v.begin()));
+		bool ok = true;
+		for (int x = -2; x <= static_cast<int>(n) + 2; x += n > 5000 ? 5 : 1)
+			ok = ok && same_bplus_bounds(tree, v, x);
+		EXPECT_TRUE(ok);
+	}
+
+	// 各个 SIMD 特化与通用版本
+	auto u = sorted_values<unsigned>(10000, 5, 4000000000u);
+	mystl::static_bplus_tree<unsigned> ut(u.data(), u.data() + u.size());
+	auto f = sorted_values<float>(10000, 6, 20000);
+	mystl::static_bplus_tree<float> ft(f.data(), f.data() + f.size());
+	auto d = sorted_values<double>(10000, 7, 20000);
+	mystl::static_bplus_tree<double> dt(d.data(), d.data() + d.size());
+	auto ll = sorted_values<long long>(10000, 8, 20000);
+	mystl::static_bplus_tree<long long> lt(ll.data(), ll.data() + ll.size());
+	bool ok = true;
+	test_rng rng(11);
+	for (int i = 0; i < 20000; ++i)
+	{
+		ok = ok && same_bplus_bounds(ut, u, static_cast<unsigned>(rng.next()));
+		ok = ok && same_bplus_bounds(ft, f, static_cast<float>(rng.below(20002)) - 1.5f);
+		ok = ok && same_bplus_bounds(dt, d, static_cast<double>(rng.below(20002)) - 0.5);
+		ok = ok && same_bplus_bounds(lt, ll, static_cast<long long>(rng.below(20002)) - 1);
+	}
+	EXPECT_TRUE(ok);
+}
+
+// 在不同大小(分别落在 L1 / L2 / LLC / 内存中)的 int 有序表上做随机查找, 与 std::lower_bound 比较
+inline void search_perf()
+{
+	const size_t queries = 1u << 20;
+#if LARGER_TEST_DATA_ON
+	const size_t sizes[] = { 1u << 12, 1u << 16, 1u << 21, 1u << 26 };
+#else
+	const size_t sizes[] = { 1u << 12, 1u << 16, 1u << 21, 1u << 24 };
+#endif
+	const char* levels[] = { "L1", "L2", "LLC", "DRAM" };
+	perf_header("lower_bound on sorted int tables (1M probes)");
+	for (size_t s = 0; s < 4; ++s)
+	{
+		const size_t n = sizes[s];
+		std::vector<int> v(n);
+		for (size_t i = 0; i < n; ++i)
+			v[i] = static_cast<int>(2 * i);
+		std::vector<int> q(queries);
+		test_rng rng(s + 1);
+		for (auto& x : q)
+			x = static_cast<int>(rng.below(2 * n));
+		const int* first = v.data();
+		const int* last = v.data() + n;
+
+		size_t sum = 0;
+		const double std_ms = time_ms([&]
+		{
+			for (int x : q)
+				sum += static_cast<size_t>(std::lower_bound(first, last, x) - first);
+		});
+		const double mystl_ms = time_ms([&]
+		{
+			for (int x : q)
+				sum += static_cast<size_t>(mystl::lower_bound(first, last, x) - first);
+		});
+		mystl::eytzinger_index<int> eyt(first, last);
+		const double eyt_ms = time_ms([&]
+		{
+			for (int x : q)
+			{
+				const int* p = eyt.lower_bound(x);
+				sum += p == nullptr ? 0 : static_cast<size_t>(*p);
+			}
+		});
+		mystl::static_bplus_tree<int> tree(first, last);
+		const double tree_ms = time_ms([&]
+		{
+			for (int x : q)
+				sum += static_cast<size_t>(tree.lower_bound(x) - tree.begin());
+		});
+		do_not_optimize(sum);
+		const std::string suffix = std::string(" ") + levels[s] + " " + std::to_string(n * sizeof(int) >> 10) + "KB";
+		perf_row("lower_bound" + suffix, mystl_ms, std_ms);
+		perf_row("eytzinger" + suffix, eyt_ms, std_ms);
+		perf_row("static_bplus" + suffix, tree_ms, std_ms);
+	}
+	perf_footer();
+}
+
+} // namespace search_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_SEARCH_TEST_H_
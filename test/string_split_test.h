@@ -0,0 +1,188 @@
+#ifndef MYTINYSTL_STRING_SPLIT_TEST_H_
+#define MYTINYSTL_STRING_SPLIT_TEST_H_
+
+// string_view 与 split / tokenize / lines 视图的测试, 以基于 std::string 的朴素实现作为参照
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/algo.h"
+#include "../src/basic_string.h"
+#include "../src/string_split.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace string_split_test
+{
+
+template <class View>
+std::vector<std::string> collect(const View& v)
+{
+	std::vector<std::string> r;
+	for (auto it = v.begin(); it != v.end(); ++it)
+		r.emplace_back(it->data(), it->size());
+	return r;
+}
+
+inline std::vector<std::string> ref_split(const std::string& s, const std::string& d)
+{
+	std::vector<std::string> r;
+	if (d.empty())
+	{
+		r.push_back(s);
+		return r;
+	}
+	for (size_t p = 0;;)
+	{
+		const size_t e = s.find(d, p);
+		if (e == std::string::npos)
+		{
+			r.push_back(s.substr(p));
+			return r;
+		}
+		r.push_back(s.substr(p, e - p));
+		p = e + d.size();
+	}
+}
+
+inline std::vector<std::string> ref_tokenize(const std::string& s, const std::string& d)
+{
+	std::vector<std::string> r;
+	for (size_t p = 0; p < s.size();)
+	{
+		size_t e = s.find_first_of(d, p);
+		if (e == std::string::npos)
+			e = s.size();
+		if (e > p)
+			r.push_back(s.substr(p, e - p));
+		p = e + 1;
+	}
+	return r;
+}
+
+inline std::vector<std::string> ref_lines(const std::string& s)
+{
+	std::vector<std::string> r;
+	for (size_t p = 0; p < s.size();)
+	{
+		size_t e = s.find('\n', p);
+		if (e == std::string::npos)
+			e = s.size();
+		size_t len = e - p;
+		if (len != 0 && s[e - 1] == '\r')
+			--len;
+		r.push_back(s.substr(p, len));
+		p = e + 1;
+	}
+	return r;
+}
+
+TEST(string_view_test)
+{
+	const std::string text = "the quick brown fox jumps over the lazy dog";
+	mystl::string_view v(text.data(), text.size());
+	EXPECT_EQ(v.size(), text.size());
+	EXPECT_EQ(v.front(), 't');
+	EXPECT_EQ(v.back(), 'g');
+	EXPECT_THROW(v.at(v.size()), std::out_of_range);
+	EXPECT_THROW(v.substr(v.size() + 1), std::out_of_range);
+	EXPECT_TRUE(v.substr(4, 5) == "quick");
+	EXPECT_TRUE(v.starts_with("the") && v.ends_with('g') && v.contains("fox"));
+	EXPECT_FALSE(v.contains("cat"));
+	EXPECT_EQ(v.compare(0, 3, "the"), 0);
+	EXPECT_LT(v.compare("the r"), 0);
+
+	// 查找函数与 std::string 逐个位置比较
+	bool ok = true;
+	const char* needles[] = { "the", "o", "", "dog", "xyz", "the lazy dog!", "aeiou" };
+	for (const char* n : needles)
+	{
+		for (size_t pos = 0; pos <= text.size() + 1 && ok; ++pos)
+		{
+			ok = v.find(n, pos) == text.find(n, pos) && v.rfind(n, pos) == text.rfind(n, pos) &&
+				v.find_first_of(n, pos) == text.find_first_of(n, pos) &&
+				v.find_last_of(n, pos) == text.find_last_of(n, pos) &&
+				v.find_first_not_of(n, pos) == text.find_first_not_of(n, pos) &&
+				v.find_last_not_of(n, pos) == text.find_last_not_of(n, pos);
+		}
+	}
+	EXPECT_TRUE(ok);
+
+	mystl::string_view w = v;
+	w.remove_prefix(4);
+	w.remove_suffix(4);
+	EXPECT_TRUE(w == "quick brown fox jumps over the lazy");
+	char buf[5] = {};
+	EXPECT_EQ(w.copy(buf, 5), 5u);
+	EXPECT_EQ(std::string(buf, 5), "quick");
+	w.swap(v);
+	EXPECT_EQ(v.size(), text.size() - 8);
+}
+
+TEST(string_split_random_test)
+{
+	test_rng rng(13);
+	bool ok = true;
+	const char alphabet[] = "ab,;\n\r ";
+	for (int it = 0; it < 20000 && ok; ++it)
+	{
+		// 大部分文本只用少数几个字符, 分隔符密集
+		std::string s;
+		const size_t kinds = rng.below(3) == 0 ? 7 : 2 + rng.below(6);
+		for (size_t i = rng.below(200); i > 0; --i)
+			s += alphabet[rng.below(kinds)];
+		mystl::string_view sv(s.data(), s.size());
+		const std::string d = std::string(",;").substr(0, rng.below(3));
+		const std::string td = std::string(",; \n\rb").substr(0, rng.below(7));
+		ok = collect(mystl::split(sv, ',')) == ref_split(s, ",") &&
+			collect(mystl::split(sv, mystl::string_view(d.data(), d.size()))) == ref_split(s, d) &&
+			collect(mystl::tokenize(sv, mystl::string_view(td.data(), td.size()))) == ref_tokenize(s, td) &&
+			collect(mystl::lines(sv)) == ref_lines(s);
+
+		// 非 char 字符类型走通用的扫描
+		std::wstring ws(s.begin(), s.end());
+		mystl::wstring_view wv(ws.data(), ws.size());
+		ok = ok && static_cast<size_t>(mystl::distance(mystl::split(wv, L',').begin(),
+		                                               mystl::split(wv, L',').end())) == ref_split(s, ",").size();
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(string_split_algo_test)
+{
+	// 视图的迭代器可以直接交给 mystl 的算法
+	mystl::string owned("k1=v1 k2=v2  k3=v3");
+	auto toks = mystl::tokenize(owned, " ");
+	EXPECT_EQ(mystl::distance(toks.begin(), toks.end()), 3);
+	EXPECT_TRUE(mystl::find_if_not(toks.begin(), toks.end(), [](mystl::string_view t)
+	{
+		return t.starts_with("k");
+	}) == toks.end());
+	auto f = mystl::find(toks.begin(), toks.end(), mystl::string_view("k2=v2"));
+	EXPECT_TRUE(f != toks.end());
+	EXPECT_EQ(f->size(), 5u);
+
+	mystl::vector<mystl::string_view> parts;
+	for (auto t : toks)
+		parts.push_back(t);
+	EXPECT_EQ(parts.size(), 3u);
+	EXPECT_TRUE(parts[2] == "k3=v3");
+	// 片段指向原文本, 没有复制
+	EXPECT_TRUE(parts[0].data() == owned.data());
+
+	auto sp = mystl::split("a::b::c", "::");
+	EXPECT_EQ(mystl::distance(sp.begin(), sp.end()), 3);
+	auto ls = mystl::lines("x\r\ny\n\nz\n");
+	EXPECT_EQ(mystl::distance(ls.begin(), ls.end()), 4);
+	EXPECT_TRUE(*ls.begin() == "x");
+}
+
+} // namespace string_split_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_STRING_SPLIT_TEST_H_
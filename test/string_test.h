@@ -0,0 +1,245 @@
+#ifndef MYTINYSTL_STRING_TEST_H_
+#define MYTINYSTL_STRING_TEST_H_
+
+// basic_string 的测试: 随机修改与查找和 std::string 比较, 以及短字符串优化的边界
+
+#include <sstream>
+#include <string>
+
+#include "../src/basic_string.h"
+#include "../src/list.h"
+#include "../src/unordered_map.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace string_test
+{
+
+// 内容、长度一致, 并且以空字符结尾
+inline bool same_string(const mystl::string& a, const std::string& b)
+{
+	return a.size() == b.size() && std::string(a.data(), a.size()) == b && a.c_str()[a.size()] == '\0';
+}
+
+TEST(string_random_ops_test)
+{
+	static_assert(sizeof(mystl::string) == 3 * sizeof(void*), "");
+	test_rng rng(11);
+	bool ok = true;
+	for (int it = 0; it < 20000 && ok; ++it)
+	{
+		mystl::string a;
+		std::string b;
+		for (size_t ops = rng.below(30); ops > 0 && ok; --ops)
+		{
+			const size_t sz = b.size();
+			const size_t pos = rng.below(sz + 1);
+			const size_t n = rng.below(8) + (rng.below(5) == 0 ? rng.below(40) : 0);
+			const std::string lit(n, static_cast<char>('a' + rng.below(4)));
+			switch (rng.below(12))
+			{
+			case 0:
+				a.append(lit.c_str());
+				b.append(lit);
+				break;
+			case 1:
+				a.insert(pos, lit.c_str());
+				b.insert(pos, lit);
+				break;
+			case 2:
+			{
+				const size_t c = rng.below(5);
+				a.erase(pos, c);
+				b.erase(pos, c);
+				break;
+			}
+			case 3:
+			{
+				const size_t c = rng.below(5);
+				a.replace(pos, c, lit.c_str());
+				b.replace(pos, c, lit);
+				break;
+			}
+			case 4:
+				// 用自身的一部分替换
+				if (sz != 0)
+				{
+					const size_t p2 = rng.below(sz);
+					const size_t c2 = rng.below(sz - p2 + 1);
+					const size_t c = rng.below(5);
+					a.replace(pos, c, a.data() + p2, c2);
+					b.replace(pos, c, b.data() + p2, c2);
+				}
+				break;
+			case 5:
+				// 插入自身的一部分
+				if (sz != 0)
+				{
+					const size_t p2 = rng.below(sz);
+					const size_t c2 = rng.below(sz - p2 + 1);
+					a.insert(pos, a.data() + p2, c2);
+					b.insert(pos, b.data() + p2, c2);
+				}
+				break;
+			case 6:
+				a.append(a.data(), a.size());
+				b.append(std::string(b));
+				break;
+			case 7:
+				a.push_back('z');
+				b.push_back('z');
+				break;
+			case 8:
+				a.shrink_to_fit();
+				break;
+			case 9:
+			{
+				const size_t r = rng.below(50);
+				a.resize(r, 'q');
+				b.resize(r, 'q');
+				break;
+			}
+			case 10:
+			{
+				mystl::string c(a);
+				a = c;
+				mystl::string d(mystl::move(c));
+				a.swap(d);
+				a = mystl::move(d);
+				break;
+			}
+			default:
+			{
+				const size_t c = rng.below(4);
+				a.replace(pos, c, n, 'x');
+				b.replace(pos, c, n, 'x');
+				break;
+			}
+			}
+			ok = same_string(a, b);
+		}
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(string_find_test)
+{
+	// 小字母表使部分匹配频繁出现
+	test_rng rng(12);
+	bool ok = true;
+	for (int it = 0; it < 20000 && ok; ++it)
+	{
+		std::string h;
+		mystl::string hs;
+		for (size_t i = rng.below(80); i > 0; --i)
+		{
+			const char c = static_cast<char>('a' + rng.below(3));
+			h += c;
+			hs.push_back(c);
+		}
+		for (int q = 0; q < 10 && ok; ++q)
+		{
+			std::string nd;
+			for (size_t i = rng.below(5); i > 0; --i)
+				nd += static_cast<char>('a' + rng.below(3));
+			// 超过 16 字节的模式走另一条路径
+			if (rng.below(4) == 0)
+				nd = std::string("abc").substr(0, rng.below(4)) + "xyzabcdefghijklmnopq";
+			const size_t pos = rng.below(h.size() + 3);
+			const size_t rpos = rng.below(3) == 0 ? std::string::npos : rng.below(h.size() + 3);
+			ok = hs.find(nd.c_str(), pos) == h.find(nd, pos) &&
+				hs.rfind(nd.c_str(), rpos) == h.rfind(nd, rpos) &&
+				hs.find_first_of(nd.c_str(), pos) == h.find_first_of(nd, pos) &&
+				hs.find_last_of(nd.c_str(), rpos) == h.find_last_of(nd, rpos) &&
+				hs.find_first_not_of(nd.c_str(), pos) == h.find_first_not_of(nd, pos) &&
+				hs.find_last_not_of(nd.c_str(), rpos) == h.find_last_not_of(nd, rpos);
+			if (ok && !nd.empty())
+			{
+				ok = hs.find(nd[0], pos) == h.find(nd[0], pos) &&
+					hs.rfind(nd[0], rpos) == h.rfind(nd[0], rpos) &&
+					hs.find_first_not_of(nd[0], pos) == h.find_first_not_of(nd[0], pos) &&
+					hs.find_last_not_of(nd[0], rpos) == h.find_last_not_of(nd[0], rpos);
+			}
+			std::string set = "qwertyuiopasdfghjklzxcvbnm";
+			set.resize(rng.below(27));
+			ok = ok && hs.find_first_of(set.c_str(), pos) == h.find_first_of(set, pos);
+		}
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(string_misc_test)
+{
+	// 23 个字符以内不申请内存
+	for (size_t n = 20; n < 27; ++n)
+	{
+		mystl::string s(n, 'x');
+		EXPECT_EQ(s.size(), n);
+		EXPECT_EQ(s.capacity(), n <= 23 ? 23u : n);
+		mystl::string t = s;
+		EXPECT_TRUE(t == s);
+	}
+
+	mystl::string s;
+	s.resize_and_overwrite(100, [](char* p, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+			p[i] = static_cast<char>('a' + i % 26);
+		return static_cast<size_t>(50);
+	});
+	EXPECT_EQ(s.size(), 50u);
+	EXPECT_EQ(s[49], static_cast<char>('a' + 49 % 26));
+	EXPECT_EQ(s.c_str()[50], '\0');
+
+	mystl::string_view v = s;
+	EXPECT_EQ(v.size(), 50u);
+	EXPECT_TRUE(v == s && s == v);
+	EXPECT_TRUE(s.starts_with("abc") && s.ends_with(v.substr(40)));
+
+	mystl::string u("hello");
+	EXPECT_TRUE(u + " world" == "hello world");
+	EXPECT_TRUE("x" + u == "xhello");
+	EXPECT_TRUE(u + '!' == mystl::string("hello!"));
+	EXPECT_TRUE(mystl::string("a") < mystl::string("b") && mystl::string("ab") > "aa" && v != u);
+
+	mystl::string ins("abc");
+	ins.insert(0, 3, 'z');
+	ins.erase(0, 1);
+	ins.insert(ins.begin() + 1, 'y');
+	EXPECT_TRUE(ins == "zyzabc");
+	mystl::string e0("q");
+	e0.erase(0);
+	EXPECT_TRUE(e0.empty());
+
+	std::ostringstream os;
+	os << ins << v.substr(0, 3);
+	EXPECT_EQ(os.str(), "zyzabcabc");
+
+	// 从非连续的迭代器区间构造与追加
+	mystl::list<char> lc = { 'p', 'q' };
+	mystl::string fl(lc.begin(), lc.end());
+	fl.append(lc.begin(), lc.end());
+	EXPECT_TRUE(fl == "pqpq");
+
+	// 以 string_view 异构查找
+	mystl::unordered_map<mystl::string, int, mystl::hash<mystl::string>, mystl::equal_to<void>> m;
+	m[mystl::string("key")] = 3;
+	EXPECT_TRUE(m.find(mystl::string_view("key")) != m.end());
+	EXPECT_EQ(m.count("key"), 1u);
+
+	mystl::wstring w(L"wide string that is quite long indeed");
+	EXPECT_EQ(w.find(L"quite"), 20u);
+	EXPECT_EQ(w.rfind(L'i'), std::wstring(w.data()).rfind(L'i'));
+	mystl::u32string u32(U"abc");
+	u32 += U"defgh";
+	EXPECT_EQ(u32.size(), 8u);
+	EXPECT_EQ(u32.find_first_of(U"hx"), 7u);
+}
+
+} // namespace string_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_STRING_TEST_H_
@@ -0,0 +1,11 @@
+// 容器增长统计的测试入口: MYSTL_TELEMETRY 必须对整个程序统一定义, 所以单独构建, 例如:
+//   g++ -std=c++11 -O2 -pthread telemetry_test.cpp -o mystl_telemetry_test && ./mystl_telemetry_test
+
+#define MYSTL_TELEMETRY 1
+
+#include "telemetry_test.h"
+
+int main()
+{
+	return RUN_ALL_TESTS() == 0 ? 0 : 1;
+}
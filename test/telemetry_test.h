@@ -0,0 +1,119 @@
+#ifndef MYTINYSTL_TELEMETRY_TEST_H_
+#define MYTINYSTL_TELEMETRY_TEST_H_
+
+// 容器增长统计的测试
+// test.cpp 中未定义 MYSTL_TELEMETRY, 只检查接口可用且容器布局不变;
+// 统计结果由 telemetry_test.cpp 检查, 它在包含任何头文件之前定义 MYSTL_TELEMETRY
+
+#include <string>
+#include <thread>
+
+#include "../src/telemetry.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace telemetry_test
+{
+
+// 只在这里使用的元素类型, 统计结果不受其他测试影响
+struct telemetry_elem
+{
+	int v;
+
+	telemetry_elem(int x = 0) :v(x) {}
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MYSTL_TEST_NOINLINE __attribute__((noinline))
+#else
+#define MYSTL_TEST_NOINLINE
+#endif
+
+MYSTL_TEST_NOINLINE inline void grow_many(int n)
+{
+	mystl::vector<telemetry_elem> v;
+	for (int i = 0; i < n; ++i)
+		v.push_back(telemetry_elem(i));
+}
+
+MYSTL_TEST_NOINLINE inline void grow_reserved(int n)
+{
+	mystl::vector<telemetry_elem> v;
+	v.reserve(static_cast<size_t>(n));
+	for (int i = 0; i < n; ++i)
+		v.push_back(telemetry_elem(i));
+}
+
+#if !defined(MYSTL_TELEMETRY)
+
+TEST(telemetry_disabled_test)
+{
+	// 未启用时钩子展开为空, 不改变容器的大小
+	static_assert(sizeof(mystl::vector<int>) == 3 * sizeof(void*), "");
+	mystl::telemetry::reset();
+	grow_many(1000);
+	grow_reserved(1000);
+	mystl::vector<telemetry_elem> v(10);
+	v.shrink_to_fit();
+	EXPECT_EQ(v.capacity(), 10u);
+}
+
+#else
+
+TEST(telemetry_test)
+{
+	mystl::telemetry::reset();
+	for (int i = 0; i < 100; ++i)
+		grow_many(1000);
+	for (int i = 0; i < 10; ++i)
+		grow_reserved(1000);
+	std::thread a([] { for (int i = 0; i < 50; ++i) grow_many(200); });
+	std::thread b([] { for (int i = 0; i < 50; ++i) grow_many(200); });
+	a.join();
+	b.join();
+
+	uint64_t objects = 0, reallocations = 0, moved = 0;
+	bool found = false, reserved_ok = true;
+	for (const auto& r : mystl::telemetry::snapshot())
+	{
+		if (r.type.find("telemetry_elem") == std::string::npos)
+			continue;
+		objects += r.objects;
+		reallocations += r.reallocations;
+		moved += r.bytes_moved;
+		EXPECT_EQ(r.elem_size, sizeof(telemetry_elem));
+		// 逐个 push_back 的调用点: 每个容器多次重新分配, 建议 reserve 最常见的最终大小
+		if (r.site != nullptr && r.objects >= 100 && r.recommended_reserve == 1000)
+			found = true;
+		// 先 reserve 的容器不搬移元素, 不给出建议
+		if (r.bytes_moved == 0)
+			reserved_ok = reserved_ok && r.recommended_reserve == 0;
+	}
+	EXPECT_TRUE(found);
+	EXPECT_TRUE(reserved_ok);
+	// 两个线程的 100 个容器与主线程的 110 个容器都记录在同一张表中
+	EXPECT_EQ(objects, 210u);
+	EXPECT_GT(reallocations, 200u);
+	// 从 1 增长到 1000 个元素, 每个容器至少搬移 (1000 / 2) 个元素
+	EXPECT_GT(moved, 100u * 500 * sizeof(telemetry_elem));
+	bool grew = false;
+	for (const auto& t : mystl::telemetry::type_snapshot())
+		grew = grew || (t.type.find("telemetry_elem") != std::string::npos && t.growths > 200);
+	EXPECT_TRUE(grew);
+
+	mystl::telemetry::reset();
+	EXPECT_TRUE(mystl::telemetry::snapshot().empty());
+}
+
+#endif // MYSTL_TELEMETRY
+
+#undef MYSTL_TEST_NOINLINE
+
+} // namespace telemetry_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_TELEMETRY_TEST_H_
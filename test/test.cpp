@@ -0,0 +1,55 @@
+// 测试的入口, 包含所有的 *_test.h, 运行全部测试用例, 之后运行性能测试
+// 在 test 目录下构建并运行, 例如:
+//   g++ -std=c++11 -O2 -pthread test.cpp -o mystl_test && ./mystl_test
+// 各个 C++ 标准下都应通过, 调试时可以加上 -fsanitize=address,undefined 或 -fsanitize=thread
+// 无异常模式另外构建一次, 抛出异常的用例不参与编译, 改为检查错误处理函数:
+//   g++ -std=c++11 -O2 -pthread -fno-exceptions test.cpp -o mystl_test_noexcept && ./mystl_test_noexcept
+// 容器增长统计的检查在定义了 MYSTL_TELEMETRY 的 telemetry_test.cpp 中, 同样单独构建并运行
+
+#include "execution_test.h"
+#include "thread_pool_test.h"
+#include "search_test.h"
+#include "vector_test.h"
+#include "heap_test.h"
+#include "unordered_map_test.h"
+#include "hash_test.h"
+#include "flat_map_test.h"
+#include "btree_test.h"
+#include "deque_test.h"
+#include "list_test.h"
+#include "ring_queue_test.h"
+#include "string_test.h"
+#include "string_split_test.h"
+#include "cord_test.h"
+#include "bitset_test.h"
+#include "packed_vector_test.h"
+#include "function_test.h"
+#include "iterator_test.h"
+#include "uninitialized_test.h"
+#include "ranges_test.h"
+#include "numeric_test.h"
+#include "except_test.h"
+#include "telemetry_test.h"
+#include "tuple_test.h"
+#include "inplace_vector_test.h"
+
+int main()
+{
+	const int failed = RUN_ALL_TESTS();
+
+#if PERFORMANCE_TEST_ON
+	mystl::test::execution_test::execution_perf();
+	mystl::test::search_test::search_perf();
+	mystl::test::heap_test::heap_perf();
+	mystl::test::unordered_map_test::unordered_map_perf();
+	mystl::test::hash_test::hash_perf();
+	mystl::test::btree_test::btree_perf();
+	mystl::test::list_test::list_perf();
+	mystl::test::ring_queue_test::ring_queue_perf();
+	mystl::test::function_test::function_perf();
+	mystl::test::ranges_test::ranges_perf();
+	mystl::test::numeric_test::numeric_perf();
+#endif
+
+	return failed == 0 ? 0 : 1;
+}
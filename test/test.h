@@ -0,0 +1,296 @@
+#ifndef MYTINYSTL_TEST_H_
+#define MYTINYSTL_TEST_H_
+
+// 一个简单的单元测试框架, 定义了两个类 TestCase 和 UnitTest, 以及一系列用于测试的宏
+// 每个 *_test.h 用 TEST(name) 定义测试用例, 由 test.cpp 统一包含并通过 RUN_ALL_TESTS() 运行
+// 测试以 std 中对应的容器或算法作为参照, 对同一组随机操作比较两边的结果(差分测试)
+
+// notes:
+//
+// 性能测试由 PERFORMANCE_TEST_ON 控制, 默认打开, 每个 *_test.h 提供一个 xxx_perf() 函数, 由 test.cpp 调用
+// LARGER_TEST_DATA_ON 为 1 时性能测试使用更大的数据量
+// 以 -fno-exceptions 编译时进入 mystl 的无异常模式(MYSTL_NO_EXCEPTIONS), 检查抛出异常的用例不参与编译
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/exceptdef.h"
+
+namespace mystl
+{
+namespace test
+{
+
+// TestCase 类
+// 封装单个测试用例
+class TestCase
+{
+public:
+	// 构造函数, 接受一个字符串代表测试用例的名称
+	explicit TestCase(const char* case_name) : testcase_name(case_name) {}
+
+	virtual ~TestCase() = default;
+
+	// 一个纯虚函数, 用于测试用例
+	virtual void Run() = 0;
+
+public:
+	const char* testcase_name;  // 测试用例的名称
+	int         nTestResult;    // 测试用例的执行结果
+	double      nFailed;        // 测试失败的断言个数
+	double      nPassed;        // 测试通过的断言个数
+};
+
+// UnitTest 类
+// 单例, 保存所有的测试用例
+class UnitTest
+{
+public:
+	// 获取一个实例
+	static UnitTest* GetInstance()
+	{
+		static UnitTest instance;
+		return &instance;
+	}
+
+	// 注册测试用例
+	TestCase* RegisterTestCase(TestCase* testcase)
+	{
+		testcases_.push_back(testcase);
+		return testcase;
+	}
+
+	// 执行所有的测试用例, 返回失败的用例个数
+	int Run()
+	{
+		nTestResult = 1;
+		nPassed = 0;
+		nFailed = 0;
+		for (auto it : testcases_)
+		{
+			TestCase* testcase = it;
+			CurrentTestCase = testcase;
+			testcase->nTestResult = 1;
+			testcase->nFailed = 0;
+			testcase->nPassed = 0;
+			std::cout << "============================================\n";
+			std::cout << " Run TestCase:" << testcase->testcase_name << "\n";
+			testcase->Run();
+			if (testcase->nFailed == 0)
+				std::cout << " " << testcase->nPassed << " / " << testcase->nPassed
+				          << " Cases passed. ( 100% )\n";
+			else
+				std::cout << " " << testcase->nPassed << " / " << testcase->nFailed + testcase->nPassed
+				          << " Cases passed. ( "
+				          << testcase->nPassed / (testcase->nFailed + testcase->nPassed) * 100 << "% )\n";
+			std::cout << " End TestCase:" << testcase->testcase_name << "\n";
+			if (testcase->nTestResult)
+				++nPassed;
+			else
+			{
+				++nFailed;
+				nTestResult = 0;
+			}
+		}
+		std::cout << "============================================\n";
+		std::cout << " Total TestCase : " << nPassed + nFailed << "\n";
+		std::cout << " Total Passed : " << nPassed << "\n";
+		std::cout << " Total Failed : " << nFailed << "\n";
+		std::cout << " " << nPassed << " / " << nFailed + nPassed << " TestCases passed. ( "
+		          << nPassed / (nFailed + nPassed) * 100 << "% )\n";
+		return static_cast<int>(nFailed);
+	}
+
+public:
+	TestCase* CurrentTestCase = nullptr;  // 当前执行的测试用例
+	double    nPassed = 0;                // 通过的用例数
+	double    nFailed = 0;                // 失败的用例数
+	int       nTestResult = 1;
+
+protected:
+	std::vector<TestCase*> testcases_;  // 保存用例集合
+};
+
+/*****************************************************************************************/
+
+// 测试用例的类名, 替换为 test_case_name_TEST
+#define TESTCASE_NAME(testcase_name) \
+  testcase_name##_TEST
+
+// 使用宏定义掩盖复杂的测试样例封装过程, 把 TEST 中的测试案例放到单例对象中
+#define MYTINYSTL_TEST_(testcase_name)                                              \
+  class TESTCASE_NAME(testcase_name) : public mystl::test::TestCase {              \
+  public:                                                                           \
+    TESTCASE_NAME(testcase_name)(const char* case_name)                             \
+      : mystl::test::TestCase(case_name) {};                                        \
+    virtual void Run();                                                             \
+  private:                                                                          \
+    static mystl::test::TestCase* const testcase_;                                  \
+  };                                                                                \
+                                                                                    \
+  mystl::test::TestCase* const TESTCASE_NAME(testcase_name)::testcase_ =            \
+    mystl::test::UnitTest::GetInstance()->RegisterTestCase(                         \
+      new TESTCASE_NAME(testcase_name)(#testcase_name));                            \
+  void TESTCASE_NAME(testcase_name)::Run()
+
+// 记录一次断言的结果, 失败时打印所在的位置
+#define MYTINYSTL_EXPECT_(cond, text)                                               \
+  do {                                                                              \
+    if (cond) {                                                                     \
+      mystl::test::UnitTest::GetInstance()->CurrentTestCase->nPassed++;             \
+    } else {                                                                        \
+      mystl::test::UnitTest::GetInstance()->CurrentTestCase->nTestResult = 0;       \
+      mystl::test::UnitTest::GetInstance()->CurrentTestCase->nFailed++;             \
+      std::cout << " EXPECT failed: " << text << "  (" << __FILE__ << ":"           \
+                << __LINE__ << ")\n";                                               \
+    }                                                                               \
+  } while (0)
+
+/*
+Run()后边没有写实现, 是为了用宏定义将测试用例放入到 Run 的实现里, 例如:
+TEST(AddTestDemo)
+{
+	EXPECT_EQ(3, Add(1, 2));
+	EXPECT_EQ(2, Add(1, 1));
+}
+上述代码将 { EXPECT_EQ(3, Add(1, 2)); EXPECT_EQ(2, Add(1, 1)); } 接到 Run() 的后面
+*/
+
+// 简单测试的宏定义
+#define TEST(testcase_name) \
+  MYTINYSTL_TEST_(testcase_name)
+
+// 断言 Condition 为真 / 为假
+#define EXPECT_TRUE(Condition)  MYTINYSTL_EXPECT_((Condition), "EXPECT_TRUE(" #Condition ")")
+#define EXPECT_FALSE(Condition) MYTINYSTL_EXPECT_(!(Condition), "EXPECT_FALSE(" #Condition ")")
+
+// 比较断言
+#define EXPECT_EQ(v1, v2) MYTINYSTL_EXPECT_((v1) == (v2), "EXPECT_EQ(" #v1 ", " #v2 ")")
+#define EXPECT_NE(v1, v2) MYTINYSTL_EXPECT_((v1) != (v2), "EXPECT_NE(" #v1 ", " #v2 ")")
+#define EXPECT_LT(v1, v2) MYTINYSTL_EXPECT_((v1) < (v2),  "EXPECT_LT(" #v1 ", " #v2 ")")
+#define EXPECT_LE(v1, v2) MYTINYSTL_EXPECT_((v1) <= (v2), "EXPECT_LE(" #v1 ", " #v2 ")")
+#define EXPECT_GT(v1, v2) MYTINYSTL_EXPECT_((v1) > (v2),  "EXPECT_GT(" #v1 ", " #v2 ")")
+#define EXPECT_GE(v1, v2) MYTINYSTL_EXPECT_((v1) >= (v2), "EXPECT_GE(" #v1 ", " #v2 ")")
+
+// 断言两个容器(或区间)的元素逐个相等
+#define EXPECT_CON_EQ(c1, c2) \
+  MYTINYSTL_EXPECT_(mystl::test::container_equal((c1), (c2)), "EXPECT_CON_EQ(" #c1 ", " #c2 ")")
+
+// 断言表达式抛出异常
+// 无异常模式下出错会调用错误处理函数后终止, 这类断言不执行, 由 except_test.h 中的用例单独检查
+#if !defined(MYSTL_NO_EXCEPTIONS)
+#define EXPECT_THROW(expr, exception_type)                                          \
+  do {                                                                              \
+    bool mystl_test_thrown_ = false;                                                \
+    try { expr; } catch (const exception_type&) { mystl_test_thrown_ = true; }      \
+    MYTINYSTL_EXPECT_(mystl_test_thrown_, "EXPECT_THROW(" #expr ", " #exception_type ")"); \
+  } while (0)
+#else
+#define EXPECT_THROW(expr, exception_type) ((void)0)
+#endif
+
+// 运行所有测试案例
+#define RUN_ALL_TESTS() \
+  mystl::test::UnitTest::GetInstance()->Run()
+
+/*****************************************************************************************/
+// 辅助函数
+
+// 两个容器的大小与元素逐个相等, 两个容器的类型可以不同(如 mystl::vector 与 std::vector)
+template <class Container1, class Container2>
+bool container_equal(const Container1& con1, const Container2& con2)
+{
+	auto first1 = con1.begin(), last1 = con1.end();
+	auto first2 = con2.begin(), last2 = con2.end();
+	for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+	{
+		if (!(*first1 == *first2))
+			return false;
+	}
+	return first1 == last1 && first2 == last2;
+}
+
+// 可复现的伪随机数生成器(xorshift64*), 不同平台上得到相同的序列
+class test_rng
+{
+public:
+	explicit test_rng(uint64_t seed = 0x9e3779b97f4a7c15ull) : state_(seed ? seed : 1) {}
+
+	uint64_t next()
+	{
+		state_ ^= state_ >> 12;
+		state_ ^= state_ << 25;
+		state_ ^= state_ >> 27;
+		return state_ * 0x2545f4914f6cdd1dull;
+	}
+
+	// [0, n) 内的随机数
+	size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+
+private:
+	uint64_t state_;
+};
+
+/*****************************************************************************************/
+// 性能测试
+
+// 是否开启性能测试
+#ifndef PERFORMANCE_TEST_ON
+#define PERFORMANCE_TEST_ON 1
+#endif // !PERFORMANCE_TEST_ON
+
+// 是否使用更大的测试数据
+#ifndef LARGER_TEST_DATA_ON
+#define LARGER_TEST_DATA_ON 0
+#endif // !LARGER_TEST_DATA_ON
+
+// 防止编译器把结果未被使用的计算优化掉
+template <class T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__asm__ __volatile__("" : : "g"(&value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+// 执行 f 一次, 返回耗时(毫秒)
+template <class F>
+double time_ms(F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	const auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// 性能测试表格的表头与行, 每行是一个测试项在 mystl 与参照实现下的耗时
+inline void perf_header(const char* title, const char* lhs = "mystl", const char* rhs = "std")
+{
+	std::printf("|---------------------------------------------------------------|\n");
+	std::printf("| %-61s |\n", title);
+	std::printf("|-------------------------------|---------------|---------------|\n");
+	std::printf("| %-29s | %13s | %13s |\n", "case", lhs, rhs);
+	std::printf("|-------------------------------|---------------|---------------|\n");
+}
+
+inline void perf_row(const std::string& name, double lhs_ms, double rhs_ms)
+{
+	std::printf("| %-29s | %10.2f ms | %10.2f ms |\n", name.c_str(), lhs_ms, rhs_ms);
+}
+
+inline void perf_footer()
+{
+	std::printf("|---------------------------------------------------------------|\n");
+}
+
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_TEST_H_
@@ -0,0 +1,179 @@
+#ifndef MYTINYSTL_THREAD_POOL_TEST_H_
+#define MYTINYSTL_THREAD_POOL_TEST_H_
+
+// thread_pool / task_group / parallel_for 的测试
+// 线程池中只用原子操作本身的内存序同步, 可以加上 -fsanitize=thread 运行, 不应有数据竞争的报告
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/thread_pool.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace thread_pool_test
+{
+
+inline long fib_task(mystl::thread_pool& pool, int n)
+{
+	if (n < 12)
+		return n < 2 ? n : fib_task(pool, n - 1) + fib_task(pool, n - 2);
+	long a = 0, b = 0;
+	mystl::task_group group(pool);
+	group.run([&] { a = fib_task(pool, n - 1); });
+	b = fib_task(pool, n - 2);
+	group.wait();
+	return a + b;
+}
+
+inline std::atomic<size_t>& started_workers()
+{
+	static std::atomic<size_t> count(0);
+	return count;
+}
+
+inline void count_worker_start(size_t, void*)
+{
+	++started_workers();
+}
+
+TEST(thread_pool_parallel_for_test)
+{
+	mystl::thread_pool pool;
+	for (size_t n : { 0u, 1u, 7u, 1000u, 100003u })
+	{
+		for (size_t grain : { 1u, 16u, 4096u })
+		{
+			// 每个下标恰好被访问一次
+			std::vector<std::atomic<int>> hits(n + 1);
+			for (auto& h : hits)
+				h.store(0);
+			pool.parallel_for(1, n + 1, grain, [&](size_t b, size_t e)
+			{
+				for (size_t i = b; i < e; ++i)
+					hits[i].fetch_add(1, std::memory_order_relaxed);
+			});
+			bool exactly_once = hits.empty() || hits[0].load() == 0;
+			for (size_t i = 1; i <= n; ++i)
+				exactly_once = exactly_once && hits[i].load() == 1;
+			EXPECT_TRUE(exactly_once);
+		}
+	}
+
+	std::atomic<long> sum(0);
+	mystl::parallel_for(0, 10000, 64, [&](size_t b, size_t e)
+	{
+		long s = 0;
+		for (size_t i = b; i < e; ++i)
+			s += static_cast<long>(i);
+		sum += s;
+	});
+	EXPECT_EQ(sum.load(), 10000L * 9999 / 2);
+}
+
+TEST(thread_pool_task_group_test)
+{
+	mystl::thread_pool pool;
+	// 递归嵌套的 fork/join
+	EXPECT_EQ(fib_task(pool, 25), 75025L);
+
+	// 超出帧内缓冲区的可调用对象保存在堆上
+	struct big_callable
+	{
+		std::atomic<int>* counter;
+		char payload[MYSTL_TASK_INLINE_SIZE * 2];
+		void operator()() const { counter->fetch_add(payload[0]); }
+	};
+	std::atomic<int> counter(0);
+	{
+		mystl::task_group group(pool);
+		for (int i = 0; i < 100; ++i)
+		{
+			big_callable c;
+			c.counter = &counter;
+			c.payload[0] = 1;
+			group.run(c);
+		}
+		group.wait();
+	}
+	EXPECT_EQ(counter.load(), 100);
+
+	// 大量的小任务组反复取用、归还任务帧
+	std::atomic<long> total(0);
+	for (int r = 0; r < 20000; ++r)
+		pool.parallel_for(0, 64, 4, [&](size_t b, size_t e) { total += static_cast<long>(e - b); });
+	EXPECT_EQ(total.load(), 20000L * 64);
+}
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+TEST(thread_pool_exception_test)
+{
+	mystl::thread_pool pool;
+	// 任务抛出的异常在 wait 中重新抛出, 之后任务组仍可继续使用
+	mystl::task_group group(pool);
+	for (int i = 0; i < 50; ++i)
+		group.run([i] { if (i == 17) throw std::runtime_error("task"); });
+	EXPECT_THROW(group.wait(), std::runtime_error);
+	std::atomic<int> after(0);
+	group.run([&] { ++after; });
+	group.wait();
+	EXPECT_EQ(after.load(), 1);
+
+	// 调用者线程内联执行的块抛出异常时, 其余块仍要执行完才返回
+	for (int r = 0; r < 200; ++r)
+	{
+		std::atomic<size_t> visited(0);
+		EXPECT_THROW(pool.parallel_for(0, 10000, 10, [&](size_t b, size_t e)
+		{
+			visited += e - b;
+			if (b == 0)
+				throw std::runtime_error("chunk");
+		}), std::runtime_error);
+		EXPECT_EQ(visited.load(), 10000u);
+	}
+
+	// 派生任务之后抛出异常而跳过 wait, 任务组析构时要等待任务完成
+	std::atomic<int> finished(0);
+	try
+	{
+		mystl::task_group g(pool);
+		for (int i = 0; i < 64; ++i)
+			g.run([&] { ++finished; });
+		throw std::logic_error("skip wait");
+	}
+	catch (const std::logic_error&)
+	{
+	}
+	EXPECT_EQ(finished.load(), 64);
+}
+#endif // !MYSTL_NO_EXCEPTIONS
+
+TEST(thread_pool_options_test)
+{
+	started_workers().store(0);
+	mystl::thread_pool_options options;
+	options.threads = 3;
+	options.on_worker_start = count_worker_start;
+	options.spin_rounds = 0;
+	options.yield_rounds = 0;
+	{
+		mystl::thread_pool pool(options);
+		EXPECT_EQ(pool.size(), 3u);
+		EXPECT_EQ(pool.concurrency(), 4u);
+		EXPECT_FALSE(pool.in_worker());
+		std::atomic<int> inside(0);
+		pool.parallel_for(0, 1000, 1, [&](size_t, size_t) { inside += pool.in_worker() ? 1 : 0; });
+		EXPECT_LE(inside.load(), 1000);
+	}
+	// 线程池析构时所有工作线程都已启动并退出
+	EXPECT_EQ(started_workers().load(), 3u);
+}
+
+} // namespace thread_pool_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_THREAD_POOL_TEST_H_
@@ -0,0 +1,181 @@
+#ifndef MYTINYSTL_TUPLE_TEST_H_
+#define MYTINYSTL_TUPLE_TEST_H_
+
+// tuple / compressed_pair / unique_ptr 的测试: 空类型的成员不占空间
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "../src/flat_set.h"
+#include "../src/memory.h"
+#include "../src/queue.h"
+#include "../src/tuple.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace tuple_test
+{
+
+struct empty_type {};
+struct final_empty final {};
+
+struct multiplied
+{
+	int x;
+
+	multiplied(int a, int b) :x(a * b) {}
+};
+
+struct twice_holder
+{
+	int v;
+
+	int twice() const { return 2 * v; }
+};
+
+inline int add(int a, int b) { return a + b; }
+
+// 记录删除次数的空删除器
+static int deleted = 0;
+
+struct counting_delete
+{
+	void operator()(int* p) const
+	{
+		++deleted;
+		delete p;
+	}
+};
+
+TEST(tuple_test)
+{
+	mystl::tuple<int, std::string, double> t(1, "ab", 2.5);
+	EXPECT_EQ(mystl::get<0>(t), 1);
+	EXPECT_TRUE(mystl::get<1>(t) == "ab");
+	EXPECT_EQ(mystl::get<2>(t), 2.5);
+	static_assert(mystl::tuple_size<decltype(t)>::value == 3, "");
+	static_assert(std::is_same<mystl::make_index_sequence<5>, mystl::index_sequence<0, 1, 2, 3, 4>>::value, "");
+
+	auto t2 = mystl::make_tuple(3, std::string("x"));
+	static_assert(std::is_same<decltype(t2), mystl::tuple<int, std::string>>::value, "");
+	int a = 0;
+	std::string b;
+	mystl::tie(a, b) = t2;
+	EXPECT_EQ(a, 3);
+	EXPECT_TRUE(b == "x");
+	mystl::tie(a, mystl::ignore) = mystl::make_tuple(7, 8);
+	EXPECT_EQ(a, 7);
+
+	EXPECT_EQ(mystl::apply(add, mystl::make_tuple(2, 5)), 7);
+	twice_holder h{ 4 };
+	EXPECT_EQ(mystl::apply(&twice_holder::twice, mystl::make_tuple(h)), 8);
+
+	// 只能移动的元素
+	mystl::tuple<std::unique_ptr<int>> u(std::unique_ptr<int>(new int(5)));
+	auto u2 = mystl::move(u);
+	EXPECT_EQ(*mystl::get<0>(u2), 5);
+	EXPECT_TRUE(!mystl::get<0>(u));
+	std::unique_ptr<int> out = mystl::get<0>(mystl::move(u2));
+	EXPECT_EQ(*out, 5);
+
+	EXPECT_TRUE(mystl::make_tuple(1, 2) < mystl::make_tuple(1, 3));
+	EXPECT_TRUE(mystl::make_tuple(1, 2) == mystl::make_tuple(1, 2));
+	EXPECT_TRUE(mystl::make_tuple(2, 0) != mystl::make_tuple(1, 9));
+	mystl::tuple<long, double> conv = mystl::make_tuple(1, 2.0f);
+	EXPECT_EQ(mystl::get<0>(conv), 1);
+	mystl::tuple<int, int> fp(mystl::make_pair(1, 2));
+	EXPECT_EQ(mystl::get<1>(fp), 2);
+	mystl::tuple<int, int> d;
+	EXPECT_EQ(mystl::get<0>(d), 0);
+	mystl::tuple<> empty;
+	(void)empty;
+
+	int r = 1;
+	auto wr = mystl::make_tuple(std::ref(r));
+	mystl::get<0>(wr) = 9;
+	EXPECT_EQ(r, 9);
+
+	static_assert(sizeof(mystl::tuple<empty_type, int>) == sizeof(int), "");
+	static_assert(sizeof(mystl::tuple<empty_type, mystl::less<int>, int*>) == sizeof(int*), "");
+}
+
+TEST(compressed_pair_test)
+{
+	mystl::compressed_pair<empty_type, int*> cp(empty_type(), nullptr);
+	static_assert(sizeof(cp) == sizeof(int*), "");
+	EXPECT_TRUE(cp.second() == nullptr);
+	// final 类不能作为基类, 只能作为成员保存
+	mystl::compressed_pair<final_empty, int*> cf;
+	static_assert(sizeof(cf) == 2 * sizeof(int*), "");
+	EXPECT_TRUE(cf.second() == nullptr);
+
+	mystl::compressed_pair<multiplied, std::string> pc(mystl::piecewise_construct,
+	                                                   mystl::forward_as_tuple(3, 4),
+	                                                   mystl::forward_as_tuple(3, 'z'));
+	EXPECT_EQ(pc.first().x, 12);
+	EXPECT_TRUE(pc.second() == "zzz");
+
+	mystl::compressed_pair<std::less<int>, int> x1(std::less<int>(), 1), x2(std::less<int>(), 2);
+	x1.swap(x2);
+	EXPECT_EQ(x1.second(), 2);
+	x1 = x2;
+	EXPECT_EQ(x1.second(), 1);
+
+	// 空的比较函数不增加容器的大小
+	static_assert(sizeof(mystl::vector<int>) == 3 * sizeof(void*), "");
+	static_assert(sizeof(mystl::priority_queue<int>) == sizeof(mystl::vector<int>), "");
+	static_assert(sizeof(mystl::flat_set<int>) == sizeof(mystl::vector<int>), "");
+}
+
+TEST(unique_ptr_test)
+{
+	static_assert(sizeof(mystl::unique_ptr<int>) == sizeof(int*), "");
+	static_assert(sizeof(mystl::unique_ptr<int, counting_delete>) == sizeof(int*), "");
+	static_assert(!std::is_copy_constructible<mystl::unique_ptr<int>>::value, "");
+
+	deleted = 0;
+	{
+		mystl::unique_ptr<int, counting_delete> p(new int(3));
+		EXPECT_EQ(*p, 3);
+		mystl::unique_ptr<int, counting_delete> q(mystl::move(p));
+		EXPECT_FALSE(static_cast<bool>(p));
+		EXPECT_EQ(*q, 3);
+		q.reset(new int(4));
+		EXPECT_EQ(deleted, 1);
+		int* raw = q.release();
+		EXPECT_FALSE(static_cast<bool>(q));
+		delete raw;
+		p.reset(new int(5));
+		p.swap(q);
+		EXPECT_EQ(*q, 5);
+		EXPECT_TRUE(p == nullptr);
+	}
+	EXPECT_EQ(deleted, 2);
+
+	auto m = mystl::make_unique<std::string>(3, 'k');
+	EXPECT_TRUE(*m == "kkk");
+	EXPECT_EQ(m->size(), 3u);
+	auto arr = mystl::make_unique<int[]>(10);
+	EXPECT_EQ(arr[9], 0);
+	arr[3] = 7;
+	EXPECT_EQ(arr[3], 7);
+
+	// 在 vector 中移动
+	mystl::vector<mystl::unique_ptr<int>> v;
+	for (int i = 0; i < 100; ++i)
+		v.push_back(mystl::make_unique<int>(i));
+	v.erase(v.begin(), v.begin() + 50);
+	EXPECT_EQ(*v[0], 50);
+	EXPECT_EQ(*v.back(), 99);
+}
+
+} // namespace tuple_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_TUPLE_TEST_H_
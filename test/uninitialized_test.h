@@ -0,0 +1,226 @@
+#ifndef MYTINYSTL_UNINITIALIZED_TEST_H_
+#define MYTINYSTL_UNINITIALIZED_TEST_H_
+
+// move_iterator 与未初始化空间上的算法的测试: vector 按元素类型在移动与复制之间选择,
+// 复制中途抛出异常时已构造的元素被销毁, 不可赋值的平凡类型也能放进 vector
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "../src/basic_string.h"
+#include "../src/uninitialized.h"
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace uninitialized_test
+{
+
+// 构造、复制、移动的计数, throw_at 为 0 时的那次复制抛出异常
+struct counters
+{
+	static int live;
+	static int copies;
+	static int moves;
+	static int throw_at;
+
+	static void reset()
+	{
+		copies = 0;
+		moves = 0;
+		throw_at = -1;
+	}
+};
+
+int counters::live = 0;
+int counters::copies = 0;
+int counters::moves = 0;
+int counters::throw_at = -1;
+
+// 移动构造可能抛出异常: vector 扩容时应当复制
+struct throwing_move
+{
+	int v;
+
+	throwing_move(int x = 0) :v(x) { ++counters::live; }
+	throwing_move(const throwing_move& rhs) :v(rhs.v)
+	{
+#if !defined(MYSTL_NO_EXCEPTIONS)
+		if (counters::throw_at == 0)
+			throw 1;
+#endif
+		if (counters::throw_at > 0)
+			--counters::throw_at;
+		++counters::copies;
+		++counters::live;
+	}
+	throwing_move(throwing_move&& rhs) :v(rhs.v) { ++counters::moves; ++counters::live; }
+	throwing_move& operator=(const throwing_move&) = default;
+	~throwing_move() { --counters::live; }
+};
+
+// 移动构造不抛出异常: vector 扩容时应当移动
+struct nothrow_move
+{
+	int v;
+
+	nothrow_move(int x = 0) :v(x) { ++counters::live; }
+	nothrow_move(const nothrow_move& rhs) :v(rhs.v) { ++counters::copies; ++counters::live; }
+	nothrow_move(nothrow_move&& rhs) noexcept :v(rhs.v) { ++counters::moves; ++counters::live; }
+	nothrow_move& operator=(const nothrow_move&) = default;
+	~nothrow_move() { --counters::live; }
+};
+
+// 只能移动
+struct move_only
+{
+	std::unique_ptr<int> p;
+
+	move_only(int x) :p(new int(x)) {}
+};
+
+// 可平凡复制但不能赋值
+struct const_member
+{
+	const int x;
+};
+
+TEST(move_if_noexcept_test)
+{
+	counters::reset();
+	{
+		mystl::vector<throwing_move> v;
+		for (int i = 0; i < 100; ++i)
+			v.push_back(throwing_move(i));
+		EXPECT_GT(counters::copies, 0);
+		counters::copies = 0;
+		counters::moves = 0;
+		v.reserve(1000);
+		EXPECT_EQ(counters::copies, 100);
+		EXPECT_EQ(counters::moves, 0);
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+		// 扩容时复制到一半抛出异常, 原内容不变
+		v.shrink_to_fit();
+		counters::throw_at = 50;
+		EXPECT_THROW(v.push_back(throwing_move(7)), int);
+		counters::throw_at = -1;
+		bool intact = v.size() == 100;
+		for (int i = 0; i < 100 && intact; ++i)
+			intact = v[i].v == i;
+		EXPECT_TRUE(intact);
+		counters::throw_at = 30;
+		EXPECT_THROW(v.insert(v.begin() + 10, 50, throwing_move(5)), int);
+		counters::throw_at = -1;
+		for (int i = 0; i < 100 && intact; ++i)
+			intact = v[i].v == i;
+		EXPECT_TRUE(intact && v.size() == 100);
+#endif
+	}
+	EXPECT_EQ(counters::live, 0);
+
+	counters::reset();
+	{
+		mystl::vector<nothrow_move> v;
+		for (int i = 0; i < 100; ++i)
+			v.emplace_back(i);
+		EXPECT_EQ(counters::copies, 0);
+		v.insert(v.begin() + 3, 200, nothrow_move(1));
+		EXPECT_EQ(v.size(), 300u);
+		EXPECT_TRUE(v[2].v == 2 && v[3].v == 1 && v[203].v == 3);
+	}
+	EXPECT_EQ(counters::live, 0);
+
+	mystl::vector<move_only> mo;
+	for (int i = 0; i < 50; ++i)
+		mo.emplace_back(i);
+	mo.reserve(500);
+	EXPECT_EQ(*mo[10].p, 10);
+	EXPECT_EQ(*mo[49].p, 49);
+
+	mystl::vector<mystl::string> vs;
+	for (int i = 0; i < 1000; ++i)
+		vs.push_back(mystl::string(static_cast<size_t>(i % 40), static_cast<char>('a' + i % 26)));
+	vs.insert(vs.begin() + 5, vs.begin(), vs.begin() + 600);
+	EXPECT_EQ(vs.size(), 1600u);
+	EXPECT_EQ(vs[5].size(), 0u);
+	EXPECT_EQ(vs[605].size(), 5u);
+}
+
+TEST(move_iterator_test)
+{
+	std::string a[3] = { "x", "y", "z" }, b[3];
+	mystl::copy(mystl::make_move_iterator(a), mystl::make_move_iterator(a + 3), b);
+	EXPECT_TRUE(b[2] == "z" && a[2].empty());
+
+	// 经过 move_iterator 的 uninitialized_copy 移动而不是复制
+	alignas(std::string) unsigned char raw[sizeof(std::string) * 3];
+	std::string* r = reinterpret_cast<std::string*>(raw);
+	mystl::uninitialized_copy(mystl::make_move_iterator(b), mystl::make_move_iterator(b + 3), r);
+	EXPECT_TRUE(r[1] == "y" && b[1].empty());
+	mystl::destroy(r, r + 3);
+
+	int x[4] = { 1, 2, 3, 4 }, y[4];
+	auto e = mystl::copy(mystl::make_move_iterator(x), mystl::make_move_iterator(x + 4), y);
+	EXPECT_TRUE(e == y + 4 && y[3] == 4);
+	auto mi = mystl::make_move_iterator(x);
+	static_assert(std::is_same<decltype(*mi), int&&>::value, "");
+	EXPECT_EQ(mi[2], 3);
+	EXPECT_EQ((mi + 4) - mi, 4);
+	EXPECT_TRUE(mi < mi + 1);
+
+	counters::reset();
+	{
+		mystl::vector<nothrow_move> src(10);
+		counters::copies = 0;
+		mystl::vector<nothrow_move> dst(mystl::make_move_iterator(src.begin()), mystl::make_move_iterator(src.end()));
+		EXPECT_EQ(counters::copies, 0);
+		EXPECT_EQ(counters::moves, 10);
+	}
+
+#if !defined(MYSTL_NO_EXCEPTIONS)
+	// 复制中途抛出异常, 已构造的元素全部销毁
+	{
+		throwing_move src[5] = { 1, 2, 3, 4, 5 };
+		alignas(throwing_move) unsigned char buf[sizeof(throwing_move) * 5];
+		const int before = counters::live;
+		counters::throw_at = 2;
+		EXPECT_THROW(mystl::uninitialized_copy(src, src + 5, reinterpret_cast<throwing_move*>(buf)), int);
+		counters::throw_at = -1;
+		EXPECT_EQ(counters::live, before);
+	}
+#endif
+	EXPECT_EQ(counters::live, 0);
+}
+
+TEST(uninitialized_non_assignable_test)
+{
+	// 可平凡复制但不能赋值的类型不能走赋值的快速路径
+	static_assert(std::is_trivially_copyable<const_member>::value, "");
+	static_assert(!mystl::uninit_copy_by_assign<const_member>::value, "");
+	mystl::vector<const_member> v;
+	for (int i = 0; i < 100; ++i)
+		v.push_back(const_member{ i });
+	mystl::vector<const_member> w(v);
+	mystl::vector<const_member> f(10, const_member{ 7 });
+	EXPECT_EQ(w[99].x, 99);
+	EXPECT_EQ(f[9].x, 7);
+
+	alignas(const_member) unsigned char raw[sizeof(const_member) * 4];
+	const_member* p = reinterpret_cast<const_member*>(raw);
+	mystl::uninitialized_fill_n(p, 4, const_member{ 3 });
+	EXPECT_EQ(p[3].x, 3);
+	mystl::uninitialized_move(v.begin(), v.begin() + 4, p);
+	EXPECT_EQ(p[3].x, 3);
+	mystl::uninitialized_copy_n(v.begin() + 10, 4, p);
+	EXPECT_EQ(p[0].x, 10);
+}
+
+} // namespace uninitialized_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_UNINITIALIZED_TEST_H_
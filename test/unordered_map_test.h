@@ -0,0 +1,271 @@
+#ifndef MYTINYSTL_UNORDERED_MAP_TEST_H_
+#define MYTINYSTL_UNORDERED_MAP_TEST_H_
+
+// unordered_map / node_hash_map / unordered_set 的测试
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../src/unordered_map.h"
+#include "../src/unordered_set.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace unordered_map_test
+{
+
+// 支持以 const char* 直接查找 std::string 键的透明哈希
+struct transparent_string_hash
+{
+	typedef void is_transparent;
+	size_t operator()(const std::string& s) const { return std::hash<std::string>()(s); }
+	size_t operator()(const char* s) const { return std::hash<std::string>()(s); }
+};
+
+template <class Map, class StdMap>
+bool same_map(const Map& m, const StdMap& s)
+{
+	if (m.size() != s.size())
+		return false;
+	size_t visited = 0;
+	for (auto it = m.begin(); it != m.end(); ++it, ++visited)
+	{
+		auto other = s.find(it->first);
+		if (other == s.end() || !(other->second == it->second))
+			return false;
+	}
+	return visited == s.size();
+}
+
+TEST(unordered_map_random_ops_test)
+{
+	test_rng rng(5);
+	mystl::unordered_map<std::string, int> m;
+	std::unordered_map<std::string, int> s;
+	bool ok = true;
+	for (int it = 0; it < 200000 && ok; ++it)
+	{
+		const std::string key = std::to_string(rng.below(5000));
+		switch (rng.below(6))
+		{
+		case 0:
+			m[key] += it;
+			s[key] += it;
+			break;
+		case 1:
+			ok = m.erase(key) == s.erase(key);
+			break;
+		case 2:
+		{
+			auto a = m.try_emplace(key, 7);
+			auto b = s.emplace(key, 7);
+			ok = a.second == b.second && a.first->second == b.first->second;
+			break;
+		}
+		case 3:
+		{
+			auto a = m.insert(mystl::make_pair(key, it));
+			auto b = s.insert(std::make_pair(key, it));
+			ok = a.second == b.second && a.first->first == key;
+			break;
+		}
+		case 4:
+			m.insert_or_assign(key, -it);
+			s[key] = -it;
+			break;
+		default:
+		{
+			auto f = m.find(key);
+			auto g = s.find(key);
+			ok = (f == m.end()) == (g == s.end()) && (f == m.end() || f->second == g->second);
+			if (ok && f != m.end() && rng.below(2) == 0)
+			{
+				m.erase(f);
+				s.erase(g);
+			}
+			break;
+		}
+		}
+		ok = ok && m.size() == s.size() && m.count(key) == s.count(key);
+	}
+	EXPECT_TRUE(ok);
+	EXPECT_TRUE(same_map(m, s));
+	EXPECT_LE(m.load_factor(), m.max_load_factor());
+
+	auto copy = m;
+	EXPECT_TRUE(copy == m);
+	copy.rehash(0);
+	copy.reserve(100000);
+	EXPECT_TRUE(copy == m);
+	copy.erase(copy.begin(), copy.end());
+	EXPECT_TRUE(copy.empty());
+	EXPECT_TRUE(copy != m);
+
+	mystl::unordered_map<int, std::unique_ptr<int>> owners;
+	owners.emplace(1, std::unique_ptr<int>(new int(3)));
+	owners.insert_or_assign(1, std::unique_ptr<int>(new int(4)));
+	EXPECT_EQ(*owners[1], 4);
+	EXPECT_THROW(owners.at(2), std::out_of_range);
+}
+
+TEST(unordered_map_max_load_factor_test)
+{
+	// 先调低再调高最大负载因子, 中间夹杂删除, 表不能因可用槽位计数下溢而写满
+	mystl::unordered_map<int, int> m;
+	std::unordered_map<int, int> s;
+	for (int i = 0; i < 100; ++i)
+	{
+		m[i] = i;
+		s[i] = i;
+	}
+	m.max_load_factor(0.1f);
+	EXPECT_LE(m.load_factor(), 0.1f);
+	for (int i = 100; i < 2000; ++i)
+	{
+		m[i] = i;
+		s[i] = i;
+	}
+	EXPECT_LE(m.load_factor(), 0.1f);
+	for (int i = 0; i < 2000; i += 3)
+	{
+		m.erase(i);
+		s.erase(i);
+	}
+	m.max_load_factor(0.9f);
+	for (int i = 2000; i < 5000; ++i)
+	{
+		m[i] = i;
+		s[i] = i;
+	}
+	EXPECT_TRUE(same_map(m, s));
+	EXPECT_TRUE(m.find(-1) == m.end());
+	EXPECT_LE(m.load_factor(), 0.9f);
+}
+
+TEST(node_hash_map_test)
+{
+	test_rng rng(6);
+	mystl::node_hash_map<int, std::string> m;
+	std::unordered_map<int, std::string> s;
+	for (int it = 0; it < 100000; ++it)
+	{
+		const int key = static_cast<int>(rng.below(3000));
+		m.emplace(key, std::to_string(it));
+		s.emplace(key, std::to_string(it));
+		if (rng.below(3) == 0)
+		{
+			m.erase(key);
+			s.erase(key);
+		}
+	}
+	EXPECT_TRUE(same_map(m, s));
+
+	// 插入与重新哈希不改变元素的地址
+	mystl::node_hash_map<int, int> stable;
+	stable[1] = 1;
+	const int* p = &stable[1];
+	for (int i = 2; i < 100000; ++i)
+		stable[i] = i;
+	EXPECT_EQ(p, &stable[1]);
+}
+
+TEST(unordered_map_heterogeneous_test)
+{
+	mystl::unordered_map<std::string, int, transparent_string_hash, mystl::equal_to<void>> m;
+	m["abc"] = 1;
+	m["defghijklmnopqrstuvwxyz"] = 2;
+	EXPECT_TRUE(m.find("abc") != m.end());
+	EXPECT_TRUE(m.contains("defghijklmnopqrstuvwxyz"));
+	EXPECT_EQ(m.count("x"), 0u);
+	EXPECT_EQ(m.erase("abc"), 1u);
+	EXPECT_EQ(m.size(), 1u);
+}
+
+TEST(unordered_set_test)
+{
+	test_rng rng(7);
+	mystl::unordered_set<long> m;
+	std::unordered_set<long> s;
+	bool ok = true;
+	for (int it = 0; it < 200000 && ok; ++it)
+	{
+		const long key = static_cast<long>(rng.below(5000)) * 1000003L;
+		if (rng.below(2) == 0)
+			ok = m.insert(key).second == s.insert(key).second;
+		else
+			ok = m.erase(key) == s.erase(key);
+		ok = ok && m.size() == s.size();
+	}
+	EXPECT_TRUE(ok);
+	size_t visited = 0;
+	for (long x : m)
+		visited += s.count(x);
+	EXPECT_EQ(visited, s.size());
+
+	// 插入与删除交替进行时, 删除标记不会让表无限增长
+	mystl::unordered_set<int> churn;
+	for (int i = 0; i < 1000000; ++i)
+	{
+		churn.insert(i);
+		if (i >= 100)
+			churn.erase(i - 100);
+	}
+	EXPECT_EQ(churn.size(), 100u);
+	EXPECT_LE(churn.bucket_count(), 1024u);
+
+	mystl::unordered_set<int> il = { 1, 2, 3, 2 };
+	EXPECT_EQ(il.size(), 3u);
+}
+
+// insert / 命中查找 / 未命中查找三类负载, 对比 std::unordered_map
+template <class Key, class MakeKey>
+void hash_map_perf_rows(const char* name, size_t n, MakeKey make_key)
+{
+	std::vector<Key> keys(n), misses(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		keys[i] = make_key(2 * i);
+		misses[i] = make_key(2 * i + 1);
+	}
+	test_rng rng(3);
+	for (size_t i = n; i > 1; --i)
+		std::swap(keys[i - 1], keys[rng.below(i)]);
+
+	mystl::unordered_map<Key, size_t> m;
+	std::unordered_map<Key, size_t> s;
+	const double m_insert = time_ms([&] { for (size_t i = 0; i < n; ++i) m.emplace(keys[i], i); });
+	const double s_insert = time_ms([&] { for (size_t i = 0; i < n; ++i) s.emplace(keys[i], i); });
+	size_t sum = 0;
+	const double m_hit = time_ms([&] { for (auto& k : keys) sum += m.find(k)->second; });
+	const double s_hit = time_ms([&] { for (auto& k : keys) sum += s.find(k)->second; });
+	const double m_miss = time_ms([&] { for (auto& k : misses) sum += m.count(k); });
+	const double s_miss = time_ms([&] { for (auto& k : misses) sum += s.count(k); });
+	do_not_optimize(sum);
+	perf_row(std::string(name) + " insert", m_insert, s_insert);
+	perf_row(std::string(name) + " hit", m_hit, s_hit);
+	perf_row(std::string(name) + " miss", m_miss, s_miss);
+}
+
+inline void unordered_map_perf()
+{
+#if LARGER_TEST_DATA_ON
+	const size_t n = 10000000;
+#else
+	const size_t n = 1000000;
+#endif
+	perf_header("unordered_map vs std::unordered_map");
+	hash_map_perf_rows<uint64_t>("uint64", n, [](size_t i) { return static_cast<uint64_t>(i) * 0x9e3779b97f4a7c15ull; });
+	hash_map_perf_rows<std::string>("string", n / 4, [](size_t i) { return "key-" + std::to_string(i); });
+	perf_footer();
+}
+
+} // namespace unordered_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_UNORDERED_MAP_TEST_H_
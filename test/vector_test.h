@@ -0,0 +1,170 @@
+#ifndef MYTINYSTL_VECTOR_TEST_H_
+#define MYTINYSTL_VECTOR_TEST_H_
+
+// vector 的测试: 用 std::string 作为元素(非平凡的拷贝与析构), 对同一组随机操作与 std::vector 比较
+
+#include <string>
+#include <vector>
+
+#include "../src/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace vector_test
+{
+
+// 长度超过 SSO 上限, 泄漏或重复析构都会被 sanitizer 发现
+inline std::string long_string(size_t i)
+{
+	return std::string(24 + i % 7, static_cast<char>('a' + i % 26));
+}
+
+TEST(vector_range_insert_test)
+{
+	// 在容量足够时把一段区间插入到各个位置, 覆盖插入点之后元素多于 / 少于插入个数两种情况
+	bool ok = true;
+	for (size_t pos = 0; pos <= 20; ++pos)
+	{
+		for (size_t n = 0; n <= 25; ++n)
+		{
+			mystl::vector<std::string> v;
+			std::vector<std::string> s;
+			v.reserve(64);
+			for (size_t i = 0; i < 20; ++i)
+			{
+				v.push_back(long_string(i));
+				s.push_back(long_string(i));
+			}
+			std::vector<std::string> src;
+			for (size_t i = 0; i < n; ++i)
+				src.push_back(std::string(25, static_cast<char>('A' + i)));
+			v.insert(v.begin() + pos, src.data(), src.data() + src.size());
+			s.insert(s.begin() + pos, src.begin(), src.end());
+			ok = ok && container_equal(v, s);
+		}
+	}
+	EXPECT_TRUE(ok);
+}
+
+TEST(vector_assign_test)
+{
+	// 容量足够时赋值不改变容量
+	mystl::vector<std::string> a;
+	mystl::vector<std::string> b(50, long_string(1));
+	a.reserve(121);
+	a.push_back("q");
+	a = b;
+	EXPECT_EQ(a.capacity(), 121u);
+	EXPECT_CON_EQ(a, b);
+	a.push_back(long_string(2));
+	EXPECT_EQ(a.size(), 51u);
+
+	mystl::vector<std::string> c(80, long_string(3));
+	a = c;
+	EXPECT_CON_EQ(a, c);
+	a = mystl::vector<std::string>(3, long_string(4));
+	EXPECT_EQ(a.size(), 3u);
+	EXPECT_GE(a.capacity(), 3u);
+
+	a.assign(10, long_string(5));
+	EXPECT_CON_EQ(a, std::vector<std::string>(10, long_string(5)));
+	a.assign({ "x", "y" });
+	EXPECT_CON_EQ(a, std::vector<std::string>({ "x", "y" }));
+}
+
+TEST(vector_erase_test)
+{
+	mystl::vector<std::string> v;
+	for (size_t i = 0; i < 10; ++i)
+		v.push_back(long_string(i));
+	// 删除空区间不改变容器, 返回的迭代器指向原位置
+	auto it = v.erase(v.begin() + 3, v.begin() + 3);
+	EXPECT_EQ(it - v.begin(), 3);
+	EXPECT_EQ(v.size(), 10u);
+	mystl::vector<std::string> empty;
+	EXPECT_TRUE(empty.erase(empty.begin(), empty.end()) == empty.end());
+
+	it = v.erase(v.begin() + 2, v.begin() + 5);
+	EXPECT_EQ(*it, long_string(5));
+	it = v.erase(v.end() - 1);
+	EXPECT_TRUE(it == v.end());
+	EXPECT_EQ(v.size(), 6u);
+}
+
+TEST(vector_random_ops_test)
+{
+	test_rng rng(2024);
+	mystl::vector<std::string> v;
+	std::vector<std::string> s;
+	bool ok = true;
+	for (size_t step = 0; step < 20000 && ok; ++step)
+	{
+		const size_t pos = rng.below(s.size() + 1);
+		const size_t n = rng.below(6);
+		const std::string x = long_string(step);
+		switch (rng.below(9))
+		{
+		case 0:
+			v.push_back(x);
+			s.push_back(x);
+			break;
+		case 1:
+			v.emplace(v.begin() + pos, x);
+			s.emplace(s.begin() + pos, x);
+			break;
+		case 2:
+			v.insert(v.begin() + pos, n, x);
+			s.insert(s.begin() + pos, n, x);
+			break;
+		case 3:
+		{
+			// 插入自身的一段元素
+			const size_t first = rng.below(s.size() + 1);
+			const size_t len = rng.below(s.size() - first + 1);
+			std::vector<std::string> copy(s.begin() + first, s.begin() + first + len);
+			v.insert(v.begin() + pos, copy.data(), copy.data() + copy.size());
+			s.insert(s.begin() + pos, copy.begin(), copy.end());
+			break;
+		}
+		case 4:
+			if (!s.empty())
+			{
+				const size_t first = rng.below(s.size());
+				const size_t last = first + rng.below(s.size() - first + 1);
+				v.erase(v.begin() + first, v.begin() + last);
+				s.erase(s.begin() + first, s.begin() + last);
+			}
+			break;
+		case 5:
+			if (!s.empty())
+			{
+				v.pop_back();
+				s.pop_back();
+			}
+			break;
+		case 6:
+			v.resize(rng.below(60), x);
+			s.resize(v.size(), x);
+			break;
+		case 7:
+			v.shrink_to_fit();
+			break;
+		default:
+		{
+			mystl::vector<std::string> copy(v);
+			v = copy;
+			break;
+		}
+		}
+		ok = container_equal(v, s) && v.size() <= v.capacity();
+	}
+	EXPECT_TRUE(ok);
+}
+
+} // namespace vector_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_VECTOR_TEST_H_